@@ -0,0 +1,506 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                       Pegasus                                        */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file   AotGenerator.cpp
+//! \author agent
+//! \date   16th October 2026
+//! \brief  Translates the bytecode of compiled scripts into c++
+
+#include "Pegasus/BlockScript/AotGenerator.h"
+#include "Pegasus/BlockScript/Canonizer.h"
+#include "Pegasus/Allocator/IAllocator.h"
+#include "Pegasus/Allocator/Alloc.h"
+#include "Pegasus/Core/Assertion.h"
+
+#include <stdarg.h>
+
+using namespace Pegasus;
+using namespace Pegasus::BlockScript;
+using namespace Pegasus::BlockScript::Bytecode;
+
+//size of the text buffered before it is passed to the print callback
+#define AOT_EMIT_BUFFER_SIZE 256
+
+//! \return the c++ operator of a binary alu command, null if the command is not a scalar one
+static const char* GetScalarOperator(int opcode)
+{
+    switch (opcode)
+    {
+    case OP_ADD_I: case OP_ADD_F: return "+";
+    case OP_SUB_I: case OP_SUB_F: return "-";
+    case OP_MUL_I: case OP_MUL_F: return "*";
+    case OP_DIV_I: case OP_DIV_F: return "/";
+    case OP_MOD_I: return "%";
+    case OP_EQ_I:  case OP_EQ_F:  return "==";
+    case OP_NEQ_I: case OP_NEQ_F: return "!=";
+    case OP_GT_I:  case OP_GT_F:  return ">";
+    case OP_LT_I:  case OP_LT_F:  return "<";
+    case OP_GTE_I: case OP_GTE_F: return ">=";
+    case OP_LTE_I: case OP_LTE_F: return "<=";
+    case OP_LAND_I: case OP_LAND_F: return "&&";
+    case OP_LOR_I: case OP_LOR_F: return "||";
+    default: return nullptr;
+    }
+}
+
+AotGenerator::AotGenerator(Alloc::IAllocator* allocator, PrintStringCallbackType str)
+: mStr(str), mAllocator(allocator), mScripts(allocator)
+{
+}
+
+AotGenerator::~AotGenerator()
+{
+}
+
+void AotGenerator::Emit(const char* format, ...)
+{
+    char buffer[AOT_EMIT_BUFFER_SIZE];
+    int size = 0;
+    va_list args;
+    va_start(args, format);
+    for (const char* c = format; *c != '\0'; ++c)
+    {
+        //worst case is an address, 2 numbers plus the register read
+        if (size > AOT_EMIT_BUFFER_SIZE - 64)
+        {
+            buffer[size] = '\0';
+            mStr(buffer);
+            size = 0;
+        }
+
+        if (*c != '%')
+        {
+            buffer[size++] = *c;
+            continue;
+        }
+
+        ++c;
+        if (*c == 's')
+        {
+            buffer[size] = '\0';
+            mStr(buffer);
+            size = 0;
+            mStr(va_arg(args, const char*));
+        }
+        else if (*c == 'd' || *c == 'x')
+        {
+            unsigned int value = va_arg(args, unsigned int);
+            unsigned int base = *c == 'd' ? 10 : 16;
+            if (*c == 'd' && static_cast<int>(value) < 0)
+            {
+                buffer[size++] = '-';
+                value = 0u - value;
+            }
+            else if (*c == 'x')
+            {
+                buffer[size++] = '0';
+                buffer[size++] = 'x';
+            }
+            char digits[16];
+            int digitCount = 0;
+            do
+            {
+                digits[digitCount++] = "0123456789abcdef"[value % base];
+                value /= base;
+            } while (value != 0);
+            while (digitCount > 0)
+            {
+                buffer[size++] = digits[--digitCount];
+            }
+            if (*c == 'x')
+            {
+                buffer[size++] = 'u';
+            }
+        }
+        else if (*c == 'q')
+        {
+            //string literal, paths keep forward slashes only
+            buffer[size++] = '"';
+            for (const char* q = va_arg(args, const char*); *q != '\0'; ++q)
+            {
+                if (size > AOT_EMIT_BUFFER_SIZE - 4)
+                {
+                    buffer[size] = '\0';
+                    mStr(buffer);
+                    size = 0;
+                }
+                if (*q == '"')
+                {
+                    buffer[size++] = '\\';
+                }
+                buffer[size++] = *q == '\\' ? '/' : *q;
+            }
+            buffer[size++] = '"';
+        }
+        else if (*c == 'a')
+        {
+            const int* operand = va_arg(args, const int*);
+            buffer[size] = '\0';
+            mStr(buffer);
+            size = 0;
+            Emit(operand[0] == BYTECODE_GLOBAL_FRAME ? "state.GetReg(R_G) + %d" : (operand[0] == 0 ? "state.GetReg(R_SBP) + %d" : "Aot::CallerSbp(state) + %d"), operand[1]);
+        }
+        else
+        {
+            PG_ASSERTSTR(*c == '%', "Unknown format of the aot generator.");
+            buffer[size++] = '%';
+        }
+    }
+    va_end(args);
+    buffer[size] = '\0';
+    mStr(buffer);
+}
+
+void AotGenerator::BeginFile()
+{
+    Emit("/****************************************************************************************/\n");
+    Emit("/*                                                                                      */\n");
+    Emit("/*                                       Pegasus                                        */\n");
+    Emit("/*                                                                                      */\n");
+    Emit("/****************************************************************************************/\n\n");
+    Emit("//! \\brief  Scripts translated to c++ by BlockScriptCLI -x. Do not edit, regenerate instead.\n\n");
+    Emit("#include \"Pegasus/BlockScript/BsAot.h\"\n");
+    Emit("#include \"Pegasus/BlockScript/Canonizer.h\"\n");
+    Emit("#include \"Pegasus/BlockScript/BsSimd.h\"\n");
+    Emit("#include \"Pegasus/Utils/Memcpy.h\"\n");
+    Emit("#include \"Pegasus/Math/Vector.h\"\n");
+    Emit("#include \"Pegasus/Math/Matrix.h\"\n\n");
+    Emit("using namespace Pegasus;\n");
+    Emit("using namespace Pegasus::BlockScript;\n");
+    Emit("using namespace Pegasus::BlockScript::Canon;\n");
+    Emit("using Pegasus::BlockScript::Aot::ScratchRegister;\n\n");
+}
+
+bool AotGenerator::Translate(const Assembly& assembly, const char* title)
+{
+    if (assembly.mBytecode == nullptr)
+    {
+        return false;
+    }
+
+    const BytecodeAssembly& bytecode = *assembly.mBytecode;
+    const int* code = bytecode.mCode;
+
+    //find the instructions execution can enter from: function starts, jump targets, return addresses,
+    //and the instructions following a callback, which can suspend the execution (yield)
+    bool* isEntry = PG_NEW_ARRAY(mAllocator, -1, "AotGenerator", Alloc::PG_MEM_TEMP, bool, bytecode.mCodeSize + 1);
+    for (int ip = 0; ip <= bytecode.mCodeSize; ++ip)
+    {
+        isEntry[ip] = false;
+    }
+    isEntry[0] = true;
+    for (int b = 0; b < bytecode.mBlockCount; ++b)
+    {
+        if (bytecode.mBlockOffsets[b] >= 0 && bytecode.mBlockOffsets[b] < bytecode.mCodeSize)
+        {
+            isEntry[bytecode.mBlockOffsets[b]] = true;
+        }
+    }
+    bool hasReturn = false;
+    for (int ip = 0; ip < bytecode.mCodeSize; ip += Aot::GetInstructionSize(code + ip))
+    {
+        const int* pc = code + ip;
+        switch (*pc)
+        {
+        case OP_JMP:
+            isEntry[pc[1]] = true;
+            break;
+        case OP_JMPCOND_I:
+        case OP_JMPCOND_F:
+            isEntry[pc[3]] = true;
+            break;
+        case OP_CALL:
+            isEntry[pc[1]] = true;
+            isEntry[ip + 2] = true;
+            break;
+        case OP_CALLBACK:
+        case OP_NATIVE:
+            isEntry[ip + 3] = true;
+            break;
+        case OP_RET:
+            hasReturn = true;
+            break;
+        }
+    }
+
+    int index = static_cast<int>(mScripts.GetSize());
+    Emit("//translated from %s\n", title);
+    Emit("static bool AotScript%d(const Assembly& assembly, BsVmState& state, int exitStackLevel, int budget)\n{\n", index);
+    Emit("    ScratchRegister s[BYTECODE_SCRATCH_REGISTER_COUNT];\n");
+    Emit("    int ip = state.GetReg(R_IP);\n");
+    if (hasReturn)
+    {
+        Emit("dispatch:\n");
+    }
+    Emit("    switch (ip)\n    {\n");
+    for (int ip = 0; ip < bytecode.mCodeSize; ++ip)
+    {
+        if (isEntry[ip])
+        {
+            Emit("    case %d: goto L%d;\n", ip, ip);
+        }
+    }
+    Emit("    default:\n        PG_FAILSTR(\"Invalid instruction to enter a translated script.\");\n        return false;\n    }\n");
+
+    for (int ip = 0; ip < bytecode.mCodeSize; ip += Aot::GetInstructionSize(code + ip))
+    {
+        if (isEntry[ip])
+        {
+            Emit("L%d:\n", ip);
+        }
+        TranslateInstruction(code, ip);
+    }
+    Emit("    PG_FAILSTR(\"Translated script ran past its last instruction.\");\n    return false;\n}\n\n");
+
+    PG_DELETE_ARRAY(mAllocator, isEntry);
+
+    ScriptEntry& entry = mScripts.PushEmpty();
+    entry.mKey = AotRegistry::ComputeKey(bytecode);
+    entry.mCodeSize = bytecode.mCodeSize;
+    entry.mTitle = title;
+    return true;
+}
+
+void AotGenerator::TranslateInstruction(const int* code, int ip)
+{
+    const int* pc = code + ip;
+    int next = ip + Aot::GetInstructionSize(pc);
+    const char* op = GetScalarOperator(*pc);
+    if (op != nullptr)
+    {
+        if (*pc <= OP_LOR_I)
+        {
+            Emit("    s[%d].i[0] = s[%d].i[0] %s s[%d].i[0];\n", pc[1], pc[2], op, pc[3]);
+        }
+        else if (*pc <= OP_DIV_F)
+        {
+            Emit("    s[%d].f[0] = s[%d].f[0] %s s[%d].f[0];\n", pc[1], pc[2], op, pc[3]);
+        }
+        else
+        {
+            Emit("    s[%d].f[0] = static_cast<float>(s[%d].f[0] %s s[%d].f[0]);\n", pc[1], pc[2], op, pc[3]);
+        }
+        return;
+    }
+
+    //vector and matrix commands, by the number of 4 float groups the type takes
+    if (*pc >= OP_ADD_F2 && *pc <= OP_DIV_M44)
+    {
+        static const char* const sKernels[] = { "Add", "Sub", "Mul", "Div" };
+        static const int sQuads[] = { 1, 1, 1, 1, 3, 4 };
+        int kernel = (*pc - OP_ADD_F2) % 4;
+        int quads = sQuads[(*pc - OP_ADD_F2) / 4];
+        Emit("    Simd::%s<%d>(s[%d].f, s[%d].f, s[%d].f);\n", sKernels[kernel], quads, pc[1], pc[2], pc[3]);
+        return;
+    }
+    if (*pc >= OP_NEG_F2 && *pc <= OP_NEG_M44)
+    {
+        static const int sQuads[] = { 1, 1, 1, 1, 3, 4 };
+        Emit("    Simd::Neg<%d>(s[%d].f, s[%d].f);\n", sQuads[*pc - OP_NEG_F2], pc[1], pc[2]);
+        return;
+    }
+    if (*pc >= OP_FMA_F && *pc <= OP_FMA_M44)
+    {
+        static const int sQuads[] = { 1, 1, 1, 1, 1, 3, 4 };
+        Emit("    Simd::MulAdd<%d>(s[%d].f, s[%d].f, s[%d].f, s[%d].f);\n", sQuads[*pc - OP_FMA_F], pc[1], pc[2], pc[3], pc[4]);
+        return;
+    }
+
+    switch (*pc)
+    {
+    case OP_EXIT:
+        Emit("    state.SetReg(R_IP, %d);\n    Aot::Exit(state);\n    return false;\n", ip);
+        break;
+    case OP_JMP:
+        Emit("    if (--budget <= 0) { state.SetReg(R_IP, %d); return true; }\n    goto L%d;\n", pc[1], pc[1]);
+        break;
+    case OP_JMPCOND_I:
+    case OP_JMPCOND_F:
+        Emit(*pc == OP_JMPCOND_I ? "    if (s[%d].i[0] == %d)\n" : "    if ((s[%d].f[0] != 0.0f ? 1 : 0) == %d)\n", pc[1], pc[2]);
+        Emit("    {\n        if (--budget <= 0) { state.SetReg(R_IP, %d); return true; }\n        goto L%d;\n    }\n", pc[3], pc[3]);
+        break;
+    case OP_PUSHFRAME:
+        Emit("    state.SetReg(R_IP, %d);\n", ip);
+        Emit("    Aot::PushFrame(assembly, state, static_cast<const StackFrameInfo*>(assembly.mBytecode->mConstants[%d]));\n", pc[1]);
+        break;
+    case OP_POPFRAME:
+        Emit("    Aot::PopFrame(state);\n");
+        break;
+    case OP_CALL:
+        Emit("    Aot::SetReturnIp(state, %d);\n", next);
+        Emit("    if (--budget <= 0) { state.SetReg(R_IP, %d); return true; }\n    goto L%d;\n", pc[1], pc[1]);
+        break;
+    case OP_CALLBACK:
+    case OP_NATIVE:
+        Emit("    state.SetReg(R_IP, %d);\n", ip);
+        Emit("    Aot::%s(state, static_cast<const Ast::FunCall*>(assembly.mBytecode->mConstants[%d]), %d);\n", *pc == OP_CALLBACK ? "Callback" : "Native", pc[1], pc[2]);
+        Emit("    if (state.GetExecutionState() != BsVmState::Alive) { state.SetReg(R_IP, %d); return false; }\n", next);
+        break;
+    case OP_RET:
+        Emit("    ip = Aot::Return(state);\n    if (state.GetStackLevels() == exitStackLevel) { return false; }\n    goto dispatch;\n");
+        break;
+    case OP_SAVE:
+        Emit("    *reinterpret_cast<int*>(state.Ram() + %a) = state.GetReg(static_cast<Register>(%d));\n", pc + 1, pc[3]);
+        break;
+    case OP_GETR:
+        Emit("    s[%d].i[0] = state.GetReg(static_cast<Register>(%d));\n", pc[1], pc[2]);
+        break;
+    case OP_SETR:
+        Emit("    state.SetReg(static_cast<Register>(%d), s[%d].i[0]);\n", pc[1], pc[2]);
+        break;
+    case OP_SAVE_TO_ADDR:
+        Emit("    *reinterpret_cast<int*>(state.Ram() + state.GetReg(static_cast<Register>(%d))) = state.GetReg(static_cast<Register>(%d));\n", pc[1], pc[2]);
+        break;
+    case OP_CAST_ITOF:
+        Emit("    { int* r = state.GetRegBuffer() + %d; float f = static_cast<float>(*r); *r = reinterpret_cast<int&>(f); }\n", pc[1]);
+        break;
+    case OP_CAST_FTOI:
+        Emit("    { int* r = state.GetRegBuffer() + %d; *r = static_cast<int>(reinterpret_cast<float&>(*r)); }\n", pc[1]);
+        break;
+    case OP_LEA:
+        Emit("    s[%d].i[0] = %a;\n", pc[1], pc + 2);
+        break;
+    case OP_LEAX:
+        Emit("    if (!Aot::CheckIndex(state, s[%d].i[0], %d)) { state.SetReg(R_IP, %d); return false; }\n", pc[1], pc[4], ip);
+        Emit("    s[%d].i[0] += %a;\n", pc[1], pc + 2);
+        break;
+    case OP_LEAXU:
+        Emit("    s[%d].i[0] += %a;\n", pc[1], pc + 2);
+        break;
+    case OP_LD4:
+        Emit("    s[%d].i[0] = *reinterpret_cast<int*>(state.Ram() + %a);\n", pc[1], pc + 2);
+        break;
+    case OP_LD:
+        Emit("    Simd::LoadValue(s[%d].f, state.Ram() + %a, %d);\n", pc[1], pc + 2, pc[4]);
+        break;
+    case OP_LDX:
+        Emit("    Simd::LoadValue(s[%d].f, state.Ram() + %a + s[%d].i[0], %d);\n", pc[1], pc + 2, pc[1], pc[4]);
+        break;
+    case OP_ST4:
+        Emit("    *reinterpret_cast<int*>(state.Ram() + %a) = s[%d].i[0];\n", pc + 1, pc[3]);
+        break;
+    case OP_ST:
+        Emit("    Simd::StoreValue(state.Ram() + %a, s[%d].f, %d);\n", pc + 1, pc[3], pc[4]);
+        break;
+    case OP_STI:
+        Emit("    Simd::StoreValue(state.Ram() + s[%d].i[0], s[%d].f, %d);\n", pc[1], pc[2], pc[3]);
+        break;
+    case OP_IMM:
+        for (int i = 0; i < pc[2]; ++i)
+        {
+            Emit("    s[%d].i[%d] = static_cast<int>(%x);\n", pc[1], i, pc[3 + i]);
+        }
+        break;
+    case OP_COPY:
+        Emit("    Utils::Memcpy(state.Ram() + %a, state.Ram() + %a, %d);\n", pc + 1, pc + 3, pc[5]);
+        break;
+    case OP_COPY_I:
+        Emit("    Utils::Memcpy(state.Ram() + %a, state.Ram() + s[%d].i[0], %d);\n", pc + 1, pc[3], pc[4]);
+        break;
+    case OP_COPY_II:
+        Emit("    Utils::Memcpy(state.Ram() + s[%d].i[0], state.Ram() + s[%d].i[0], %d);\n", pc[1], pc[2], pc[3]);
+        break;
+    case OP_ISDH:
+        Emit("    *reinterpret_cast<int*>(state.Ram() + %a) = state.PushHeapElement(const_cast<void*>(assembly.mBytecode->mConstants[%d]), static_cast<const TypeDesc*>(assembly.mBytecode->mConstants[%d]));\n", pc + 1, pc[3], pc[4]);
+        break;
+    case OP_READ_PROP:
+    case OP_WRITE_PROP:
+        Emit("    Aot::ObjProp(state, s[%d].i[0], s[%d].i[0], static_cast<const PropertyNode*>(assembly.mBytecode->mConstants[%d]), static_cast<const TypeDesc*>(assembly.mBytecode->mConstants[%d]), %s);\n",
+             pc[1], pc[2], pc[3], pc[4], *pc == OP_READ_PROP ? "true" : "false");
+        break;
+    case OP_NST:
+        Emit("    Utils::Memcpy(state.GetNativeArgs() + %d, &s[%d], %d);\n", pc[1], pc[2], pc[3]);
+        break;
+    case OP_NCOPY:
+        Emit("    Utils::Memcpy(state.GetNativeArgs() + %d, state.Ram() + s[%d].i[0], %d);\n", pc[1], pc[2], pc[3]);
+        break;
+    case OP_NEG_I:
+        Emit("    s[%d].i[0] = -s[%d].i[0];\n", pc[1], pc[2]);
+        break;
+    case OP_NEG_F:
+        Emit("    s[%d].f[0] = -s[%d].f[0];\n", pc[1], pc[2]);
+        break;
+    case OP_ITOF:
+        Emit("    s[%d].f[0] = static_cast<float>(s[%d].i[0]);\n", pc[1], pc[1]);
+        break;
+    case OP_PACK:
+        {
+            //same order as the interpreter, so the destination can be the first source
+            int word = 0;
+            for (int r = 0; r < pc[3]; ++r)
+            {
+                for (int w = 0; w < pc[4 + r]; ++w)
+                {
+                    Emit("    s[%d].i[%d] = s[%d].i[%d];\n", pc[1], word++, pc[2] + r, w);
+                }
+            }
+        }
+        break;
+    case OP_SPLAT:
+        Emit("    {\n        int v = s[%d].i[0];\n", pc[2]);
+        for (int w = 0; w < pc[3]; ++w)
+        {
+            Emit("        s[%d].i[%d] = v;\n", pc[1], w);
+        }
+        Emit("    }\n");
+        break;
+    case OP_DOT_F2:
+    case OP_DOT_F3:
+    case OP_DOT_F4:
+        Emit("    s[%d].f[0] = Simd::Dot<%d>(s[%d].f, s[%d].f);\n", pc[1], 2 + *pc - OP_DOT_F2, pc[2], pc[3]);
+        break;
+    case OP_CROSS_F3:
+        Emit("    Simd::Cross(s[%d].f, s[%d].f, s[%d].f);\n", pc[1], pc[2], pc[3]);
+        break;
+    case OP_LERP_F:
+        Emit("    s[%d].f[0] = Math::Lerp(s[%d].f[0], s[%d].f[0], s[%d].f[0]);\n", pc[1], pc[2], pc[3], pc[4]);
+        break;
+    case OP_LERP_F2:
+    case OP_LERP_F3:
+    case OP_LERP_F4:
+        Emit("    Simd::Lerp(s[%d].f, s[%d].f, s[%d].f, s[%d].f[0]);\n", pc[1], pc[2], pc[3], pc[4]);
+        break;
+    case OP_MUL_M22_F2:
+    case OP_MUL_M33_F3:
+        {
+            const char* vec = *pc == OP_MUL_M22_F2 ? "Vec2" : "Vec3";
+            const char* mat = *pc == OP_MUL_M22_F2 ? "Mat22" : "Mat33";
+            const char* mul = *pc == OP_MUL_M22_F2 ? "Mult22_21" : "Mult33_31";
+            Emit("    { Math::%s r; Math::%s(r, Aot::As<Math::%s>(s[%d]), Aot::As<Math::%s>(s[%d])); Aot::As<Math::%s>(s[%d]) = r; }\n",
+                 vec, mul, mat, pc[2], vec, pc[3], vec, pc[1]);
+        }
+        break;
+    case OP_MUL_M44_F4:
+    case OP_MUL_M44_M44:
+        Emit("    Simd::%s(s[%d].f, s[%d].f, s[%d].f);\n", *pc == OP_MUL_M44_F4 ? "MulMat44Vec4" : "MulMat44Mat44", pc[1], pc[2], pc[3]);
+        break;
+    case OP_SIN:
+    case OP_COS:
+        Emit("    s[%d].f[0] = Math::%s(s[%d].f[0]);\n", pc[1], *pc == OP_SIN ? "Sin" : "Cos", pc[2]);
+        break;
+    default:
+        PG_FAILSTR("Unhandled bytecode instruction!");
+        break;
+    }
+}
+
+void AotGenerator::EndFile(const char* tableName)
+{
+    Emit("extern const AotScript %s[] = {\n", tableName);
+    for (unsigned int i = 0; i < mScripts.GetSize(); ++i)
+    {
+        const ScriptEntry& entry = mScripts[i];
+        Emit("    { %x, %x, %d, %q, AotScript%d }%s\n",
+             static_cast<unsigned int>(entry.mKey), static_cast<unsigned int>(entry.mKey >> 32), entry.mCodeSize,
+             entry.mTitle, static_cast<int>(i), i + 1 < mScripts.GetSize() ? "," : "");
+    }
+    if (mScripts.GetSize() == 0)
+    {
+        Emit("    { 0u, 0u, 0, \"\", nullptr }\n");
+    }
+    Emit("};\n\n");
+    Emit("extern const int %sCount = %d;\n", tableName, static_cast<int>(mScripts.GetSize()));
+}
@@ -0,0 +1,974 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                       Pegasus                                        */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file   AssemblyCache.cpp
+//! \author agent
+//! \date   16th October 2026
+//! \brief  On disk cache of compiled assemblies. The bytecode of a script is stored in a
+//!         position independent blob, so a later compilation of the same source can skip
+//!         the parser, the optimizer, the canonizer and the bytecode generator.
+
+#include "Pegasus/BlockScript/AssemblyCache.h"
+#include "Pegasus/BlockScript/BlockScriptAst.h"
+#include "Pegasus/BlockScript/BlockLib.h"
+#include "Pegasus/BlockScript/SymbolTable.h"
+#include "Pegasus/BlockScript/TypeTable.h"
+#include "Pegasus/BlockScript/TypeDesc.h"
+#include "Pegasus/BlockScript/FunTable.h"
+#include "Pegasus/BlockScript/FunDesc.h"
+#include "Pegasus/Allocator/IAllocator.h"
+#include "Pegasus/Allocator/Alloc.h"
+#include "Pegasus/Core/Assertion.h"
+#include "Pegasus/Core/Log.h"
+#include "Pegasus/Utils/ByteStream.h"
+#include "Pegasus/Utils/Memcpy.h"
+#include "Pegasus/Utils/String.h"
+
+using namespace Pegasus::BlockScript;
+using namespace Pegasus::BlockScript::Bytecode;
+
+#define CACHE_NEW PG_NEW(&output.mNodeAllocator, -1, "BlockScript::AssemblyCache", Pegasus::Alloc::PG_MEM_TEMP)
+#define CACHE_NODE_PAGE_SIZE 1024
+
+#define BLOB_MAGIC   0x4d534142 // "BASM"
+#define BLOB_VERSION 6
+
+//! a reference to a type or a function of a library: library index in the upper 16 bits,
+//! index in the type / function table of the library in the lower 16 bits
+#define BLOB_NULL_REF -1
+#define BLOB_MAKE_REF(lib, index) (((lib) << 16) | (index))
+#define BLOB_REF_LIB(ref) ((ref) >> 16)
+#define BLOB_REF_INDEX(ref) ((ref) & 0xffff)
+
+// Blob layout. Every section is an array of ints, offsets are bytes from the start of the blob.
+// The string table goes last so every other section stays aligned to 4 bytes.
+struct BlobHeader
+{
+    int mMagic;
+    int mVersion;
+    unsigned int mKeyLow;
+    unsigned int mKeyHigh;
+    int mBlobSize;
+    int mCodeOffset;         int mCodeSize;
+    int mBlockOffsetsOffset; int mBlockCount;
+    int mLinesOffset;        int mLineCount;
+    int mConstantKindsOffset;
+    int mConstantsOffset;    int mConstantCount;
+    int mFunctionsOffset;    int mFunctionCount;
+    int mArgsOffset;         int mArgCount;
+    int mGlobalsOffset;      int mGlobalCount;
+    int mAnnotationsOffset;  int mAnnotationCount;
+    int mIncludesOffset;     int mIncludeCount;
+    int mStringsOffset;      int mStringsSize;
+    int mStackByteSize;      int mIsStackBounded;
+    int mCheckedAccessCount; int mProvenAccessCount;
+};
+
+//! K_FRAME: mA frame size. K_FUNCALL: mA function ref, mB type ref. K_HEAP_DATA: mA string.
+//! K_PROPERTY: mA type ref, mB property index. K_TYPE: mA type ref.
+struct BlobConstant
+{
+    int mA;
+    int mB;
+};
+
+struct BlobFunction
+{
+    int mName;
+    int mEntryBlock;
+    int mFrameSize;
+    int mStackByteSize;
+    int mReturnType;
+    int mFirstArg;
+    int mArgCount;
+};
+
+struct BlobArg
+{
+    int mName;
+    int mType;
+};
+
+struct BlobGlobal
+{
+    int mName;
+    int mType;
+    int mOffset;
+    int mIsExtern;
+    int mIsUsedInGlobalScope;
+    int mDefaultType;
+    int mDefault[Ast::gMaxAluDimensions];
+    int mFirstAnnotation;
+    int mAnnotationCount;
+};
+
+struct BlobAnnotation
+{
+    int mName;
+    int mOp;
+    int mType;
+    int mValue[Ast::gMaxAluDimensions];
+};
+
+struct BlobInclude
+{
+    int mPath;
+    unsigned int mHashLow;
+    unsigned int mHashHigh;
+};
+
+//! the libraries a script is linked against. Index 0 is the runtime library.
+struct LibList
+{
+    BlockLib* mRuntimeLib;
+    const Pegasus::Utils::Vector<BlockLib*>* mLibs;
+
+    int Size() const { return 1 + static_cast<int>(mLibs->GetSize()); }
+
+    const SymbolTable* Get(int i) const { return (i == 0 ? mRuntimeLib : (*mLibs)[i - 1])->GetSymbolTable(); }
+};
+
+//----------------------------------------------------------------------------------------
+
+//64 bit FNV-1a
+static void HashBytes(Pegasus::Math::PUInt64& hash, const void* data, int size)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (int i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= PCST_UINT64(1099511628211);
+    }
+}
+
+static Pegasus::Math::PUInt64 HashBegin()
+{
+    return PCST_UINT64(14695981039346656037);
+}
+
+static void HashInt(Pegasus::Math::PUInt64& hash, int value)
+{
+    HashBytes(hash, &value, sizeof(value));
+}
+
+static void HashString(Pegasus::Math::PUInt64& hash, const char* str)
+{
+    if (str == nullptr)
+    {
+        HashInt(hash, -1);
+    }
+    else
+    {
+        HashBytes(hash, str, Pegasus::Utils::Strlen(str) + 1);
+    }
+}
+
+//! hashes everything a blob can reference from a library: its types and its functions, by index
+static void HashLib(Pegasus::Math::PUInt64& hash, const SymbolTable* symbolTable)
+{
+    const TypeTable* types = symbolTable->GetTypeTable();
+    HashInt(hash, types->GetTypeCount());
+    for (int i = 0; i < types->GetTypeCount(); ++i)
+    {
+        const TypeDesc* type = types->GetTypeByIndex(i);
+        HashString(hash, type->GetName());
+        HashInt(hash, type->GetModifier());
+        HashInt(hash, type->GetAluEngine());
+        HashInt(hash, type->GetByteSize());
+        for (const PropertyNode* prop = type->GetPropertyNode(); prop != nullptr; prop = prop->mNext)
+        {
+            HashString(hash, prop->mName);
+        }
+    }
+
+    const FunTable* funs = symbolTable->GetFunTable();
+    HashInt(hash, funs->GetSize());
+    for (int i = 0; i < funs->GetSize(); ++i)
+    {
+        const FunDesc* desc = funs->GetDesc(i);
+        const Ast::StmtFunDec* dec = desc->GetDec();
+        HashInt(hash, desc->IsCallback());
+        HashInt(hash, desc->IsMethod());
+        if (dec != nullptr)
+        {
+            HashString(hash, dec->GetName());
+            HashString(hash, dec->GetReturnType() != nullptr ? dec->GetReturnType()->GetName() : nullptr);
+            for (const Ast::ArgList* args = dec->GetArgList(); args != nullptr && args->GetArgDec() != nullptr; args = args->GetTail())
+            {
+                HashString(hash, args->GetArgDec()->GetType()->GetName());
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------
+
+//! \return the reference of a library type, BLOB_NULL_REF if type is null
+//! \param resolved set to false if the type does not belong to any library
+static int FindTypeRef(const TypeDesc* type, const LibList& libs, bool& resolved)
+{
+    if (type == nullptr)
+    {
+        return BLOB_NULL_REF;
+    }
+
+    for (int l = 0; l < libs.Size(); ++l)
+    {
+        const TypeTable* types = libs.Get(l)->GetTypeTable();
+        for (int i = 0; i < types->GetTypeCount(); ++i)
+        {
+            if (types->GetTypeByIndex(i) == type)
+            {
+                return BLOB_MAKE_REF(l, i);
+            }
+        }
+    }
+
+    resolved = false;
+    return BLOB_NULL_REF;
+}
+
+//! \return the reference of a library function
+//! \param resolved set to false if the function does not belong to any library
+static int FindFunRef(const FunDesc* desc, const LibList& libs, bool& resolved)
+{
+    for (int l = 0; l < libs.Size(); ++l)
+    {
+        const FunTable* funs = libs.Get(l)->GetFunTable();
+        for (int i = 0; i < funs->GetSize(); ++i)
+        {
+            if (funs->GetDesc(i) == desc)
+            {
+                return BLOB_MAKE_REF(l, i);
+            }
+        }
+    }
+
+    resolved = false;
+    return BLOB_NULL_REF;
+}
+
+//! finds the object type a property belongs to
+//! \param resolved set to false if the property does not belong to any library type
+static void FindPropertyRef(const PropertyNode* prop, const LibList& libs, BlobConstant& out, bool& resolved)
+{
+    for (int l = 0; l < libs.Size(); ++l)
+    {
+        const TypeTable* types = libs.Get(l)->GetTypeTable();
+        for (int i = 0; i < types->GetTypeCount(); ++i)
+        {
+            int propIndex = 0;
+            for (const PropertyNode* p = types->GetTypeByIndex(i)->GetPropertyNode(); p != nullptr; p = p->mNext, ++propIndex)
+            {
+                if (p == prop)
+                {
+                    out.mA = BLOB_MAKE_REF(l, i);
+                    out.mB = propIndex;
+                    return;
+                }
+            }
+        }
+    }
+
+    resolved = false;
+}
+
+//! \return true if a reference is valid. Null references are valid if allowNull is true.
+static bool ResolveTypeRef(int ref, const LibList& libs, bool allowNull, const TypeDesc*& outType)
+{
+    outType = nullptr;
+    if (ref == BLOB_NULL_REF)
+    {
+        return allowNull;
+    }
+    int lib = BLOB_REF_LIB(ref);
+    int index = BLOB_REF_INDEX(ref);
+    if (lib < 0 || lib >= libs.Size() || index >= libs.Get(lib)->GetTypeTable()->GetTypeCount())
+    {
+        return false;
+    }
+    outType = libs.Get(lib)->GetTypeTable()->GetTypeByIndex(index);
+    return true;
+}
+
+static int WriteString(Pegasus::Utils::ByteStream& strings, const char* str)
+{
+    int offset = strings.GetSize();
+    strings.Append(str, Pegasus::Utils::Strlen(str) + 1);
+    return offset;
+}
+
+static void WriteVariant(int* dest, const Ast::Variant& v)
+{
+    Pegasus::Utils::Memcpy(dest, &v, sizeof(Ast::Variant));
+}
+
+//! \return a pointer to a section of the blob, null if the section is out of bounds
+template<class T>
+static const T* GetSection(const char* blob, int blobSize, int offset, int count)
+{
+    if (count == 0)
+    {
+        return reinterpret_cast<const T*>(blob);
+    }
+    if (offset < static_cast<int>(sizeof(BlobHeader)) || count < 0 || offset > blobSize || (blobSize - offset) / static_cast<int>(sizeof(T)) < count)
+    {
+        return nullptr;
+    }
+    return reinterpret_cast<const T*>(blob + offset);
+}
+
+//! \return a string of the string table, null if the offset is out of bounds
+static const char* GetString(const char* strings, int stringsSize, int offset)
+{
+    return offset >= 0 && offset < stringsSize ? strings + offset : nullptr;
+}
+
+//----------------------------------------------------------------------------------------
+
+IncludeRecorder::IncludeRecorder(Pegasus::Alloc::IAllocator* allocator)
+: mIncluder(nullptr)
+{
+    mEntries.Initialize(allocator);
+}
+
+IncludeRecorder::~IncludeRecorder()
+{
+}
+
+void IncludeRecorder::Begin(IFileIncluder* includer)
+{
+    mIncluder = includer;
+    mEntries.Reset();
+}
+
+bool IncludeRecorder::Open(const char* filePath, const char** outBuffer, int& outBufferSize)
+{
+    if (mIncluder == nullptr || !mIncluder->Open(filePath, outBuffer, outBufferSize))
+    {
+        return false;
+    }
+
+    Entry& e = mEntries.PushEmpty();
+    int pathLen = Pegasus::Utils::Strlen(filePath);
+    PG_ASSERTSTR(pathLen < Pegasus::Io::IOManager::MAX_FILEPATH_LENGTH, "Include path too long: %s", filePath);
+    pathLen = pathLen < Pegasus::Io::IOManager::MAX_FILEPATH_LENGTH ? pathLen : Pegasus::Io::IOManager::MAX_FILEPATH_LENGTH - 1;
+    Pegasus::Utils::Memcpy(e.mPath, filePath, pathLen);
+    e.mPath[pathLen] = '\0';
+    e.mHash = HashContents(*outBuffer, outBufferSize);
+    return true;
+}
+
+Pegasus::Math::PUInt64 IncludeRecorder::HashContents(const char* buffer, int bufferSize)
+{
+    Pegasus::Math::PUInt64 hash = HashBegin();
+    HashBytes(hash, buffer, bufferSize);
+    return hash;
+}
+
+void IncludeRecorder::Close(const char* buffer)
+{
+    PG_ASSERT(mIncluder != nullptr);
+    mIncluder->Close(buffer);
+}
+
+//----------------------------------------------------------------------------------------
+
+CachedAssembly::CachedAssembly(Pegasus::Alloc::IAllocator* allocator)
+: mAllocator(allocator), mConstants(nullptr), mIsLoaded(false)
+{
+    mNodeAllocator.Initialize(CACHE_NODE_PAGE_SIZE, allocator);
+    mFrames.Initialize(allocator);
+    mFunDescs.Initialize(allocator);
+    mFunBlockMap.Initialize(allocator);
+    mGlobalsMap.Initialize(allocator);
+}
+
+CachedAssembly::~CachedAssembly()
+{
+    Reset();
+}
+
+void CachedAssembly::Reset()
+{
+    if (mBlob.GetBuffer() != nullptr)
+    {
+        mBlob.DestroyBuffer();
+    }
+    if (mConstants != nullptr)
+    {
+        PG_DELETE_ARRAY(mAllocator, mConstants);
+        mConstants = nullptr;
+    }
+    mFrames.Reset();
+    mFunDescs.Reset();
+    mFunBlockMap.Reset();
+    mGlobalsMap.Reset();
+    mNodeAllocator.Reset();
+    mBytecode = BytecodeAssembly();
+    mAsm = Assembly();
+    mIsLoaded = false;
+}
+
+//----------------------------------------------------------------------------------------
+
+AssemblyCache::AssemblyCache(Pegasus::Alloc::IAllocator* allocator, const char* directory)
+:   mAllocator(allocator),
+    mIoManager(directory),
+    mPolicy(POLICY_READ_WRITE),
+    mValidateIncludes(true),
+    mHitCount(0),
+    mMissCount(0),
+    mStoreCount(0)
+{
+}
+
+AssemblyCache::~AssemblyCache()
+{
+}
+
+void AssemblyCache::GetBlobName(const char* title, char* outName) const
+{
+    //blobs are named after the title, so recompiling an edited script replaces its old blob
+    static const char sHexDigits[] = "0123456789abcdef";
+    Pegasus::Math::PUInt64 hash = HashBegin();
+    HashString(hash, title);
+    for (int i = 0; i < 16; ++i)
+    {
+        outName[i] = sHexDigits[(hash >> (60 - 4 * i)) & 0xf];
+    }
+    Pegasus::Utils::Memcpy(outName + 16, ".bsasm", 7);
+}
+
+Pegasus::Math::PUInt64 AssemblyCache::ComputeKey(
+    const Pegasus::Io::FileBuffer* source,
+    const Container<Preprocessor::Definition>& definitions,
+    int optimizationLevel,
+    BlockLib* runtimeLib,
+    const Pegasus::Utils::Vector<BlockLib*>& libs
+)
+{
+    Pegasus::Math::PUInt64 hash = HashBegin();
+    HashInt(hash, BLOB_VERSION);
+    HashInt(hash, source->GetFileSize());
+    HashBytes(hash, source->GetBuffer(), source->GetFileSize());
+
+    HashInt(hash, definitions.Size());
+    for (int i = 0; i < definitions.Size(); ++i)
+    {
+        HashString(hash, definitions[i].mName);
+        HashString(hash, definitions[i].mValue);
+    }
+
+    HashInt(hash, optimizationLevel);
+
+    LibList libList = { runtimeLib, &libs };
+    HashInt(hash, libList.Size());
+    for (int l = 0; l < libList.Size(); ++l)
+    {
+        HashLib(hash, libList.Get(l));
+    }
+    return hash;
+}
+
+bool AssemblyCache::Store(
+    const char* title,
+    Pegasus::Math::PUInt64 key,
+    const Assembly& assembly,
+    const IncludeRecorder& includes,
+    BlockLib* runtimeLib,
+    const Pegasus::Utils::Vector<BlockLib*>& libs
+)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    if (!CanWrite() || assembly.mBytecode == nullptr || assembly.mFunBlockMap == nullptr || assembly.mGlobalsMap == nullptr)
+    {
+        return false;
+    }
+
+    LibList libList = { runtimeLib, &libs };
+    const BytecodeAssembly& bytecode = *assembly.mBytecode;
+    bool resolved = true;
+
+    Pegasus::Utils::ByteStream strings(mAllocator);
+    Pegasus::Utils::ByteStream constants(mAllocator);
+    Pegasus::Utils::ByteStream functions(mAllocator);
+    Pegasus::Utils::ByteStream args(mAllocator);
+    Pegasus::Utils::ByteStream globals(mAllocator);
+    Pegasus::Utils::ByteStream annotations(mAllocator);
+    Pegasus::Utils::ByteStream includeList(mAllocator);
+
+    for (int i = 0; i < bytecode.mConstantCount; ++i)
+    {
+        BlobConstant c;
+        c.mA = BLOB_NULL_REF;
+        c.mB = BLOB_NULL_REF;
+        const void* constant = bytecode.mConstants[i];
+        switch (bytecode.mConstantKinds[i])
+        {
+        case K_FRAME:
+            c.mA = static_cast<const StackFrameInfo*>(constant)->GetTotalFrameSize();
+            break;
+        case K_FUNCALL:
+            {
+                const Ast::FunCall* fc = static_cast<const Ast::FunCall*>(constant);
+                c.mA = FindFunRef(fc->GetDesc(), libList, resolved);
+                c.mB = FindTypeRef(fc->GetTypeDesc(), libList, resolved);
+            }
+            break;
+        case K_HEAP_DATA:
+            c.mA = WriteString(strings, static_cast<const char*>(constant));
+            break;
+        case K_PROPERTY:
+            FindPropertyRef(static_cast<const PropertyNode*>(constant), libList, c, resolved);
+            break;
+        case K_TYPE:
+            c.mA = FindTypeRef(static_cast<const TypeDesc*>(constant), libList, resolved);
+            break;
+        default:
+            PG_FAILSTR("Unknown bytecode constant kind");
+            resolved = false;
+        }
+        constants.Append(&c, sizeof(c));
+    }
+
+    int argCount = 0;
+    for (int i = 0; i < assembly.mFunBlockMap->Size(); ++i)
+    {
+        const FunMapEntry& entry = (*assembly.mFunBlockMap)[i];
+        const Ast::StmtFunDec* dec = entry.mFunDesc->GetDec();
+        BlobFunction f;
+        f.mName = WriteString(strings, dec->GetName());
+        f.mEntryBlock = entry.mAssemblyBlock;
+        f.mFrameSize = dec->GetFrame()->GetTotalFrameSize();
+        f.mStackByteSize = entry.mStackByteSize;
+        f.mReturnType = FindTypeRef(dec->GetReturnType(), libList, resolved);
+        f.mFirstArg = argCount;
+        f.mArgCount = 0;
+        for (const Ast::ArgList* argList = dec->GetArgList(); argList != nullptr && argList->GetArgDec() != nullptr; argList = argList->GetTail())
+        {
+            BlobArg a;
+            a.mName = WriteString(strings, argList->GetArgDec()->GetVar());
+            a.mType = FindTypeRef(argList->GetArgDec()->GetType(), libList, resolved);
+            args.Append(&a, sizeof(a));
+            ++f.mArgCount;
+            ++argCount;
+        }
+        functions.Append(&f, sizeof(f));
+    }
+
+    int annotationCount = 0;
+    for (int i = 0; i < assembly.mGlobalsMap->Size(); ++i)
+    {
+        const GlobalMapEntry& entry = (*assembly.mGlobalsMap)[i];
+        BlobGlobal g;
+        g.mName = WriteString(strings, entry.mVar->GetName());
+        g.mType = FindTypeRef(entry.mVar->GetTypeDesc(), libList, resolved);
+        g.mOffset = entry.mVar->GetOffset();
+        g.mIsExtern = entry.mVar->GetMetaData().isExtern;
+        g.mIsUsedInGlobalScope = entry.mVar->GetMetaData().isUsedInGlobalScope;
+        g.mDefaultType = FindTypeRef(entry.mDefaultVal->GetTypeDesc(), libList, resolved);
+        WriteVariant(g.mDefault, entry.mDefaultVal->GetVariant());
+        g.mFirstAnnotation = annotationCount;
+        g.mAnnotationCount = 0;
+
+        //only annotations of the form name = immediate are kept, which are the only ones the runtime reads
+        const Ast::Annotations* varAnnotations = entry.mVar->GetAnnotations();
+        for (const Ast::ExpList* expList = varAnnotations != nullptr ? varAnnotations->GetExpList() : nullptr; expList != nullptr && expList->GetExp() != nullptr; expList = expList->GetTail())
+        {
+            if (expList->GetExp()->GetExpType() != Ast::Binop::sType)
+            {
+                continue;
+            }
+            const Ast::Binop* binop = static_cast<const Ast::Binop*>(expList->GetExp());
+            if (binop->GetLhs()->GetExpType() == Ast::Idd::sType && binop->GetRhs()->GetExpType() == Ast::Imm::sType)
+            {
+                const Ast::Imm* value = static_cast<const Ast::Imm*>(binop->GetRhs());
+                BlobAnnotation a;
+                a.mName = WriteString(strings, static_cast<const Ast::Idd*>(binop->GetLhs())->GetName());
+                a.mOp = binop->GetOp();
+                a.mType = FindTypeRef(value->GetTypeDesc(), libList, resolved);
+                WriteVariant(a.mValue, value->GetVariant());
+                annotations.Append(&a, sizeof(a));
+                ++g.mAnnotationCount;
+                ++annotationCount;
+            }
+        }
+        globals.Append(&g, sizeof(g));
+    }
+
+    for (int i = 0; i < includes.GetCount(); ++i)
+    {
+        BlobInclude inc;
+        inc.mPath = WriteString(strings, includes.GetPath(i));
+        inc.mHashLow = static_cast<unsigned int>(includes.GetHash(i));
+        inc.mHashHigh = static_cast<unsigned int>(includes.GetHash(i) >> 32);
+        includeList.Append(&inc, sizeof(inc));
+    }
+
+    char blobName[32];
+    GetBlobName(title, blobName);
+
+    if (!resolved)
+    {
+        PG_LOG('FILE', "Assembly of %s references types defined by the script, it can't be cached.", title);
+        return false;
+    }
+
+    BlobHeader header;
+    header.mMagic = BLOB_MAGIC;
+    header.mVersion = BLOB_VERSION;
+    header.mKeyLow = static_cast<unsigned int>(key);
+    header.mKeyHigh = static_cast<unsigned int>(key >> 32);
+    header.mCodeOffset = sizeof(BlobHeader);
+    header.mCodeSize = bytecode.mCodeSize;
+    header.mBlockOffsetsOffset = header.mCodeOffset + bytecode.mCodeSize * sizeof(int);
+    header.mBlockCount = bytecode.mBlockCount;
+    header.mLinesOffset = header.mBlockOffsetsOffset + bytecode.mBlockCount * sizeof(int);
+    header.mLineCount = bytecode.mLineCount;
+    header.mConstantKindsOffset = header.mLinesOffset + bytecode.mLineCount * sizeof(Bytecode::LineEntry);
+    header.mConstantsOffset = header.mConstantKindsOffset + bytecode.mConstantCount * sizeof(int);
+    header.mConstantCount = bytecode.mConstantCount;
+    header.mFunctionsOffset = header.mConstantsOffset + constants.GetSize();
+    header.mFunctionCount = assembly.mFunBlockMap->Size();
+    header.mArgsOffset = header.mFunctionsOffset + functions.GetSize();
+    header.mArgCount = argCount;
+    header.mGlobalsOffset = header.mArgsOffset + args.GetSize();
+    header.mGlobalCount = assembly.mGlobalsMap->Size();
+    header.mAnnotationsOffset = header.mGlobalsOffset + globals.GetSize();
+    header.mAnnotationCount = annotationCount;
+    header.mIncludesOffset = header.mAnnotationsOffset + annotations.GetSize();
+    header.mIncludeCount = includes.GetCount();
+    header.mStringsOffset = header.mIncludesOffset + includeList.GetSize();
+    header.mStringsSize = strings.GetSize();
+    header.mBlobSize = header.mStringsOffset + strings.GetSize();
+    header.mStackByteSize = assembly.mStackByteSize;
+    header.mIsStackBounded = assembly.mIsStackBounded;
+    header.mCheckedAccessCount = assembly.mCheckedAccessCount;
+    header.mProvenAccessCount = assembly.mProvenAccessCount;
+
+    Pegasus::Utils::ByteStream blob(mAllocator);
+    blob.Append(&header, sizeof(header));
+    blob.Append(bytecode.mCode, bytecode.mCodeSize * sizeof(int));
+    blob.Append(bytecode.mBlockOffsets, bytecode.mBlockCount * sizeof(int));
+    blob.Append(bytecode.mLines, bytecode.mLineCount * sizeof(Bytecode::LineEntry));
+    blob.Append(bytecode.mConstantKinds, bytecode.mConstantCount * sizeof(int));
+    blob.Append(&constants);
+    blob.Append(&functions);
+    blob.Append(&args);
+    blob.Append(&globals);
+    blob.Append(&annotations);
+    blob.Append(&includeList);
+    blob.Append(&strings);
+    PG_ASSERT(blob.GetSize() == header.mBlobSize);
+
+    //the file buffer takes ownership of the stream memory
+    Pegasus::Io::FileBuffer fileBuffer;
+    fileBuffer.OwnBuffer(mAllocator, static_cast<char*>(blob.GetBuffer()), blob.GetSize());
+    blob.ForgetBuffer();
+
+    if (mIoManager.SaveFileToBuffer(blobName, fileBuffer) != Pegasus::Io::ERR_NONE)
+    {
+        return false;
+    }
+
+    ++mStoreCount;
+    return true;
+}
+
+bool AssemblyCache::Load(
+    const char* title,
+    Pegasus::Math::PUInt64 key,
+    IFileIncluder* includer,
+    BlockLib* runtimeLib,
+    const Pegasus::Utils::Vector<BlockLib*>& libs,
+    CachedAssembly& output
+)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    output.Reset();
+    if (!CanRead())
+    {
+        return false;
+    }
+
+    char blobName[32];
+    GetBlobName(title, blobName);
+
+    //Core has no file mapping api, so the blob is read in a single buffer. The code, the block
+    //offsets and the strings are then used in place, only the descriptions get rebuilt.
+    if (mIoManager.OpenFileToBuffer(blobName, output.mBlob, true, output.mAllocator) != Pegasus::Io::ERR_NONE)
+    {
+        output.Reset();
+        ++mMissCount;
+        return false;
+    }
+
+    const char* blob = output.mBlob.GetBuffer();
+    int blobSize = output.mBlob.GetFileSize();
+    const BlobHeader* header = blobSize >= static_cast<int>(sizeof(BlobHeader)) ? reinterpret_cast<const BlobHeader*>(blob) : nullptr;
+    if (header == nullptr ||
+        header->mMagic != BLOB_MAGIC ||
+        header->mVersion != BLOB_VERSION ||
+        header->mKeyLow != static_cast<unsigned int>(key) ||
+        header->mKeyHigh != static_cast<unsigned int>(key >> 32) ||
+        header->mBlobSize != blobSize)
+    {
+        output.Reset();
+        ++mMissCount;
+        return false;
+    }
+
+    const int*            code          = GetSection<int>(blob, blobSize, header->mCodeOffset, header->mCodeSize);
+    const int*            blockOffsets  = GetSection<int>(blob, blobSize, header->mBlockOffsetsOffset, header->mBlockCount);
+    const Bytecode::LineEntry* lines    = GetSection<Bytecode::LineEntry>(blob, blobSize, header->mLinesOffset, header->mLineCount);
+    const int*            constantKinds = GetSection<int>(blob, blobSize, header->mConstantKindsOffset, header->mConstantCount);
+    const BlobConstant*   constants     = GetSection<BlobConstant>(blob, blobSize, header->mConstantsOffset, header->mConstantCount);
+    const BlobFunction*   functions     = GetSection<BlobFunction>(blob, blobSize, header->mFunctionsOffset, header->mFunctionCount);
+    const BlobArg*        args          = GetSection<BlobArg>(blob, blobSize, header->mArgsOffset, header->mArgCount);
+    const BlobGlobal*     globals       = GetSection<BlobGlobal>(blob, blobSize, header->mGlobalsOffset, header->mGlobalCount);
+    const BlobAnnotation* annotations   = GetSection<BlobAnnotation>(blob, blobSize, header->mAnnotationsOffset, header->mAnnotationCount);
+    const BlobInclude*    includes      = GetSection<BlobInclude>(blob, blobSize, header->mIncludesOffset, header->mIncludeCount);
+    const char*           strings       = GetSection<char>(blob, blobSize, header->mStringsOffset, header->mStringsSize);
+
+    bool valid = code != nullptr && blockOffsets != nullptr && lines != nullptr && constantKinds != nullptr && constants != nullptr &&
+                 functions != nullptr && args != nullptr && globals != nullptr && annotations != nullptr &&
+                 includes != nullptr && strings != nullptr && (header->mStringsSize == 0 || strings[header->mStringsSize - 1] == '\0');
+
+    //tools walk the line table to map instructions back to the source
+    for (int i = 0; valid && i < header->mLineCount; ++i)
+    {
+        valid = lines[i].mOffset >= 0 && lines[i].mOffset < header->mCodeSize &&
+                lines[i].mFunction >= -1 && lines[i].mFunction < header->mFunctionCount;
+    }
+
+    //the headers this blob was compiled with must not have changed
+    for (int i = 0; valid && mValidateIncludes && i < header->mIncludeCount; ++i)
+    {
+        const char* path = GetString(strings, header->mStringsSize, includes[i].mPath);
+        const char* includeBuffer = nullptr;
+        int includeBufferSize = 0;
+        if (path == nullptr || includer == nullptr || !includer->Open(path, &includeBuffer, includeBufferSize))
+        {
+            valid = false;
+            break;
+        }
+        Pegasus::Math::PUInt64 hash = IncludeRecorder::HashContents(includeBuffer, includeBufferSize);
+        includer->Close(includeBuffer);
+        valid = includes[i].mHashLow == static_cast<unsigned int>(hash) && includes[i].mHashHigh == static_cast<unsigned int>(hash >> 32);
+    }
+
+    LibList libList = { runtimeLib, &libs };
+
+    if (valid && header->mConstantCount > 0)
+    {
+        output.mConstants = PG_NEW_ARRAY(output.mAllocator, -1, "BlockScript::AssemblyCache", Pegasus::Alloc::PG_MEM_TEMP, const void*, header->mConstantCount);
+    }
+
+    for (int i = 0; valid && i < header->mConstantCount; ++i)
+    {
+        const BlobConstant& c = constants[i];
+        const void*& constant = output.mConstants[i];
+        constant = nullptr;
+        switch (constantKinds[i])
+        {
+        case K_FRAME:
+            {
+                StackFrameInfo* frame = &output.mFrames.PushEmpty();
+                frame->Initialize(output.mAllocator);
+                frame->SetCreatorCategory(StackFrameInfo::FUN_BODY);
+                frame->AllocateTemporal(c.mA);
+                constant = frame;
+            }
+            break;
+        case K_FUNCALL:
+            {
+                const TypeDesc* type = nullptr;
+                int lib = BLOB_REF_LIB(c.mA);
+                int index = BLOB_REF_INDEX(c.mA);
+                valid = c.mA != BLOB_NULL_REF && lib < libList.Size() && index < libList.Get(lib)->GetFunTable()->GetSize() &&
+                        ResolveTypeRef(c.mB, libList, false, type);
+                if (valid)
+                {
+                    const FunDesc* desc = libList.Get(lib)->GetFunTable()->GetDesc(index);
+                    valid = desc->IsCallback() && desc->GetDec() != nullptr;
+                    if (valid)
+                    {
+                        //the vm only reads the description and the return type of a callback call
+                        Ast::FunCall* fc = CACHE_NEW Ast::FunCall(nullptr, desc->GetDec()->GetName());
+                        fc->SetDesc(desc);
+                        fc->SetTypeDesc(type);
+                        fc->SetIsMethod(desc->IsMethod());
+                        constant = fc;
+                    }
+                }
+            }
+            break;
+        case K_HEAP_DATA:
+            constant = GetString(strings, header->mStringsSize, c.mA);
+            valid = constant != nullptr;
+            break;
+        case K_PROPERTY:
+            {
+                const TypeDesc* type = nullptr;
+                valid = ResolveTypeRef(c.mA, libList, false, type);
+                const PropertyNode* prop = valid ? type->GetPropertyNode() : nullptr;
+                for (int p = 0; prop != nullptr && p < c.mB; ++p)
+                {
+                    prop = prop->mNext;
+                }
+                constant = prop;
+                valid = prop != nullptr;
+            }
+            break;
+        case K_TYPE:
+            {
+                const TypeDesc* type = nullptr;
+                valid = ResolveTypeRef(c.mA, libList, false, type);
+                constant = type;
+            }
+            break;
+        default:
+            valid = false;
+        }
+    }
+
+    for (int i = 0; valid && i < header->mFunctionCount; ++i)
+    {
+        const BlobFunction& f = functions[i];
+        const char* name = GetString(strings, header->mStringsSize, f.mName);
+        const TypeDesc* returnType = nullptr;
+        valid = name != nullptr &&
+                f.mEntryBlock >= 0 && f.mEntryBlock < header->mBlockCount &&
+                f.mFirstArg >= 0 && f.mArgCount >= 0 && f.mFirstArg + f.mArgCount <= header->mArgCount &&
+                ResolveTypeRef(f.mReturnType, libList, false, returnType);
+
+        //rebuild the argument list backwards, so it links in declaration order
+        Ast::ArgList* argList = nullptr;
+        for (int a = f.mArgCount - 1; valid && a >= 0; --a)
+        {
+            const BlobArg& arg = args[f.mFirstArg + a];
+            const char* argName = GetString(strings, header->mStringsSize, arg.mName);
+            const TypeDesc* argType = nullptr;
+            valid = argName != nullptr && ResolveTypeRef(arg.mType, libList, false, argType);
+            if (valid)
+            {
+                Ast::ArgList* node = CACHE_NEW Ast::ArgList();
+                node->SetArgDec(CACHE_NEW Ast::ArgDec(argName, argType));
+                node->SetTail(argList);
+                argList = node;
+            }
+        }
+
+        if (valid)
+        {
+            StackFrameInfo* frame = &output.mFrames.PushEmpty();
+            frame->Initialize(output.mAllocator);
+            frame->SetCreatorCategory(StackFrameInfo::FUN_BODY);
+            frame->AllocateTemporal(f.mFrameSize);
+
+            Ast::StmtFunDec* funDec = CACHE_NEW Ast::StmtFunDec(argList, returnType, name);
+            funDec->SetFrame(frame);
+            FunDesc* funDesc = &output.mFunDescs.PushEmpty();
+            funDesc->Initialize(funDec);
+            funDec->SetDesc(funDesc);
+
+            FunMapEntry& entry = output.mFunBlockMap.PushEmpty();
+            entry.mFunDesc = funDesc;
+            entry.mAssemblyBlock = f.mEntryBlock;
+            entry.mStackByteSize = f.mStackByteSize;
+        }
+    }
+
+    for (int i = 0; valid && i < header->mGlobalCount; ++i)
+    {
+        const BlobGlobal& g = globals[i];
+        const char* name = GetString(strings, header->mStringsSize, g.mName);
+        const TypeDesc* type = nullptr;
+        const TypeDesc* defaultType = nullptr;
+        valid = name != nullptr &&
+                g.mFirstAnnotation >= 0 && g.mAnnotationCount >= 0 && g.mFirstAnnotation + g.mAnnotationCount <= header->mAnnotationCount &&
+                ResolveTypeRef(g.mType, libList, false, type) &&
+                ResolveTypeRef(g.mDefaultType, libList, false, defaultType);
+
+        //rebuild the annotations backwards, so they link in declaration order
+        Ast::ExpList* annotationList = nullptr;
+        for (int a = g.mAnnotationCount - 1; valid && a >= 0; --a)
+        {
+            const BlobAnnotation& annotation = annotations[g.mFirstAnnotation + a];
+            const char* annotationName = GetString(strings, header->mStringsSize, annotation.mName);
+            const TypeDesc* valueType = nullptr;
+            valid = annotationName != nullptr && ResolveTypeRef(annotation.mType, libList, false, valueType);
+            if (valid)
+            {
+                Ast::Variant v;
+                Pegasus::Utils::Memcpy(&v, annotation.mValue, sizeof(v));
+                Ast::Imm* value = CACHE_NEW Ast::Imm(v);
+                value->SetTypeDesc(valueType);
+                Ast::ExpList* node = CACHE_NEW Ast::ExpList();
+                node->SetExp(CACHE_NEW Ast::Binop(CACHE_NEW Ast::Idd(annotationName), annotation.mOp, value));
+                node->SetTail(annotationList);
+                annotationList = node;
+            }
+        }
+
+        if (valid)
+        {
+            Ast::Idd* var = CACHE_NEW Ast::Idd(name);
+            var->SetTypeDesc(type);
+            var->SetOffset(g.mOffset);
+            var->GetMetaData().isGlobal = true;
+            var->GetMetaData().isExtern = g.mIsExtern != 0;
+            var->GetMetaData().isUsedInGlobalScope = g.mIsUsedInGlobalScope != 0;
+            if (annotationList != nullptr)
+            {
+                Ast::Annotations* varAnnotations = CACHE_NEW Ast::Annotations();
+                varAnnotations->SetExpList(annotationList);
+                var->SetAnnotations(varAnnotations);
+            }
+
+            Ast::Variant v;
+            Pegasus::Utils::Memcpy(&v, g.mDefault, sizeof(v));
+            Ast::Imm* defaultVal = CACHE_NEW Ast::Imm(v);
+            defaultVal->SetTypeDesc(defaultType);
+
+            GlobalMapEntry& entry = output.mGlobalsMap.PushEmpty();
+            entry.mVar = var;
+            entry.mDefaultVal = defaultVal;
+        }
+    }
+
+    if (!valid)
+    {
+        PG_LOG('FILE', "Assembly cache blob of %s is out of date.", title);
+        output.Reset();
+        ++mMissCount;
+        return false;
+    }
+
+    output.mBytecode.mCode = code;
+    output.mBytecode.mCodeSize = header->mCodeSize;
+    output.mBytecode.mConstants = output.mConstants;
+    output.mBytecode.mConstantKinds = constantKinds;
+    output.mBytecode.mConstantCount = header->mConstantCount;
+    output.mBytecode.mBlockOffsets = blockOffsets;
+    output.mBytecode.mBlockCount = header->mBlockCount;
+    output.mBytecode.mLines = lines;
+    output.mBytecode.mLineCount = header->mLineCount;
+
+    output.mAsm.mBlocks = nullptr;
+    output.mAsm.mFunBlockMap = &output.mFunBlockMap;
+    output.mAsm.mGlobalsMap = &output.mGlobalsMap;
+    output.mAsm.mBytecode = &output.mBytecode;
+    output.mAsm.mStackByteSize = header->mStackByteSize;
+    output.mAsm.mIsStackBounded = header->mIsStackBounded != 0;
+    output.mAsm.mCheckedAccessCount = header->mCheckedAccessCount;
+    output.mAsm.mProvenAccessCount = header->mProvenAccessCount;
+    output.mIsLoaded = true;
+
+    ++mHitCount;
+    return true;
+}
@@ -19,8 +19,8 @@ using namespace Pegasus;
 using namespace Pegasus::BlockScript;
 
  //! Constructor in case you did not notice
-BlockLib::BlockLib(Alloc::IAllocator* allocator, const char* name)
-    : BlockScriptCompiler(allocator), mAllocator(allocator), mName(name)
+BlockLib::BlockLib(Alloc::IAllocator* allocator, const char* name, IddStrPool* strPool)
+    : BlockScriptCompiler(allocator, strPool), mAllocator(allocator), mName(name)
 {
 }
 
@@ -49,7 +49,8 @@ void BlockLib::InternalCreateIntrinsicFunctions (const FunctionDeclarationDesc*
             argCount,
             desc.returnType,
             desc.callback,
-            isMethods
+            isMethods,
+            desc.pureIntrinsic
         );
     }
 }
@@ -15,14 +15,24 @@
 #include "Pegasus/Core/Io.h"
 #include "Pegasus/BlockScript/SymbolTable.h"
 #include "Pegasus/BlockScript/BlockLib.h"
+#include "Pegasus/BlockScript/TypeDesc.h"
+#include "Pegasus/Core/Assertion.h"
 #include "Pegasus/Utils/Memcpy.h"
 
 #include <stdio.h>
 
 using namespace Pegasus;
 
-BlockScript::BlockScript::BlockScript(Alloc::IAllocator* allocator, BlockLib* runtimeLib)
-: BlockScript::BlockScriptCompiler(allocator), mRuntimeLib(runtimeLib), mLibs(allocator)
+BlockScript::BlockScript::BlockScript(Alloc::IAllocator* allocator, BlockLib* runtimeLib, IddStrPool* strPool)
+: BlockScript::BlockScriptCompiler(allocator, strPool),
+  mRuntimeLib(runtimeLib),
+  mLibs(allocator),
+  mAssemblyCache(nullptr),
+  mAotRegistry(nullptr),
+  mJit(allocator),
+  mCachedAssembly(allocator),
+  mIncludeRecorder(allocator),
+  mSignature(allocator)
 {
 }
 
@@ -36,6 +46,24 @@ void BlockScript::BlockScript::IncludeLib(BlockLib* lib)
 }
 
 bool BlockScript::BlockScript::Compile(const Io::FileBuffer* fb)
+{
+    bool success = CompileAsm(fb);
+    if (success && mAotRegistry != nullptr && GetAsm().mBytecode != nullptr)
+    {
+        SetAotFunction(mAotRegistry->Find(*GetAsm().mBytecode));
+    }
+    if (success && mJit.Initialize(GetAsm(), &mVm))
+    {
+        SetJit(&mJit);
+    }
+    if (success && GetAst() != nullptr)
+    {
+        mSignature.Build(GetAst());
+    }
+    return success;
+}
+
+bool BlockScript::BlockScript::CompileAsm(const Io::FileBuffer* fb)
 {
     //prepare runtime library
     mBuilder.GetSymbolTable()->RegisterChild(mRuntimeLib->GetSymbolTable());
@@ -44,11 +72,47 @@ bool BlockScript::BlockScript::Compile(const Io::FileBuffer* fb)
         mBuilder.GetSymbolTable()->RegisterChild(mLibs[i]->GetSymbolTable());
     }
 
-    //compile
-    return BlockScriptCompiler::Compile(fb);
+    if (mAssemblyCache == nullptr || mAssemblyCache->GetPolicy() == AssemblyCache::POLICY_DISABLED)
+    {
+        //compile
+        return BlockScriptCompiler::Compile(fb);
+    }
+
+    Math::PUInt64 key = AssemblyCache::ComputeKey(fb, GetDefinitions(), GetOptimizationLevel(), mRuntimeLib, mLibs);
+    if (mAssemblyCache->Load(GetTitle(), key, GetFileIncluder(), mRuntimeLib, mLibs, mCachedAssembly))
+    {
+        SetPrebuiltAsm(mCachedAssembly.GetAsm());
+        mBuilder.NotifyPrebuiltCompilation();
+        return true;
+    }
+
+    if (!mAssemblyCache->CanWrite())
+    {
+        return BlockScriptCompiler::Compile(fb);
+    }
+
+    //compile, recording the headers this script depends on
+    mIncludeRecorder.Begin(GetFileIncluder());
+    SetFileIncluder(&mIncludeRecorder);
+    bool success = BlockScriptCompiler::Compile(fb);
+    SetFileIncluder(mIncludeRecorder.GetIncluder());
+
+    if (success)
+    {
+        mAssemblyCache->Store(GetTitle(), key, GetAsm(), mIncludeRecorder, mRuntimeLib, mLibs);
+    }
+    return success;
+}
+
+void BlockScript::BlockScript::Reset()
+{
+    mJit.Reset();
+    mCachedAssembly.Reset();
+    mSignature.Reset();
+    BlockScriptCompiler::Reset();
 }
 
-void BlockScript::BlockScript::Run(BsVmState* vmState) 
+void BlockScript::BlockScript::Run(BsVmState* vmState, int budget) 
 { 
     if (vmState->GetExecutionState() != BsVmState::Alive)
     {
@@ -56,7 +120,65 @@ void BlockScript::BlockScript::Run(BsVmState* vmState)
     }
 
     // rrrrrrrrun!! boy
-    mVm.Run(GetAsm(), *vmState);
+    mVm.Run(GetAsm(), *vmState, budget);
+}
+
+bool BlockScript::BlockScript::Resume(BsVmState* vmState, int budget, void* outputBuffer, int outputBufferSize)
+{
+    if (!vmState->IsSuspended())
+    {
+        return false;
+    }
+
+    if (vmState->GetResumeStackLevel() < 0)
+    {
+        mVm.Resume(GetAsm(), *vmState, budget);
+        return true;
+    }
+
+    return Pegasus::BlockScript::ResumeFunction(GetAsm(), *vmState, mVm, outputBuffer, outputBufferSize, budget);
+}
+
+void BlockScript::BlockScript::Cancel(BsVmState* vmState)
+{
+    if (!vmState->IsSuspended())
+    {
+        return;
+    }
+
+    if (vmState->GetResumeStackLevel() < 0)
+    {
+        vmState->Reset();
+    }
+    else
+    {
+        Pegasus::BlockScript::CancelFunction(*vmState);
+    }
+}
+
+int BlockScript::BlockScript::RebindState(BsVmState& state, const BlockScript& previous)
+{
+    PG_ASSERTSTR(GetSignature().CountChangedFunctions(previous.GetSignature()) >= 0, "Rebinding a state to a script with a different layout!");
+    int moved = 0;
+    for (int i = 0; i < state.GetHeapElementCount(); ++i)
+    {
+        BsVmState::HeapElement& element = state.GetHeapElement(i);
+
+        //types declared by the script live in its symbol table, library types are found again as they are
+        if (element.mTypeDesc != nullptr)
+        {
+            const TypeDesc* type = mBuilder.GetTypeByName(element.mTypeDesc->GetName());
+            element.mTypeDesc = type != nullptr ? type : element.mTypeDesc;
+        }
+
+        //only string immediates are pushed from the memory of a compilation
+        if (element.mObject != nullptr && previous.mBuilder.OwnsMemory(element.mObject))
+        {
+            element.mObject = const_cast<char*>(mBuilder.AllocStrImm(static_cast<const char*>(element.mObject)));
+            ++moved;
+        }
+    }
+    return moved;
 }
 
 bool BlockScript::BlockScript::ExecuteFunction(
@@ -65,7 +187,8 @@ bool BlockScript::BlockScript::ExecuteFunction(
     const void* inputBuffer,
     int   inputBufferSize,
     void* outputBuffer,
-    int   outputBufferSize
+    int   outputBufferSize,
+    int   budget
 )
 {
     return Pegasus::BlockScript::ExecuteFunction(
@@ -77,7 +200,8 @@ bool BlockScript::BlockScript::ExecuteFunction(
         inputBuffer,
         inputBufferSize,
         outputBuffer,
-        outputBufferSize
+        outputBufferSize,
+        budget
     );
 }
 
@@ -28,6 +28,9 @@
 #define BS_NEW PG_NEW(&mAllocator, -1, "BlockScript::Ast", Pegasus::Alloc::PG_MEM_TEMP)
 #define STRING_PAGE_SIZE 512
 
+//size of the buffer holding the name of a swizzled vector type
+#define SWIZZLE_TYPE_NAME_LENGTH 32
+
 using namespace Pegasus::BlockScript;
 using namespace Pegasus::BlockScript::Ast;
 using namespace Pegasus::Utils;
@@ -46,14 +49,16 @@ const int ArrayConstructor::sType    = 6;
 //function defined in parser generator, bs.y
 extern void BS_ErrorDispatcher(BlockScriptBuilder* builder, const char* message);
 
-void BlockScriptBuilder::Initialize(Pegasus::Alloc::IAllocator* allocator)
+void BlockScriptBuilder::Initialize(Pegasus::Alloc::IAllocator* allocator, IddStrPool* strPool)
 {
     mGeneralAllocator = allocator;
     mAllocator.Initialize(STRING_PAGE_SIZE, allocator);
+    mOptimizer.Initialize(&mAllocator);
     mCanonizer.Initialize(allocator);
-    mStrPool.Initialize(allocator);
+    mBytecodeGenerator.Initialize(allocator);
+    mStrPool = strPool;
     mEventListeners.Initialize(allocator);
-    mSymbolTable.Initialize(allocator);
+    mSymbolTable.Initialize(allocator, strPool);
     mGlobalsMap.Initialize(allocator);
     mGlobalsMetaData.Initialize(allocator);
     Reset();
@@ -148,7 +153,14 @@ void BlockScriptBuilder::EndBuild(BlockScriptBuilder::CompilationResult& result)
     if (mErrorCount == 0)
     {
 
-        //build of AST is done, lets canonize now (canonization process should not error out)
+        //build of AST is done, fold constants and strip dead code before canonizing
+        mOptimizer.Optimize(mActiveResult.mAst, mOptimizationLevel);
+
+        //find the array accesses safe mode does not need to check
+        mRangeAnalysis.Analyze(mActiveResult.mAst);
+
+        //lets canonize now (canonization process should not error out)
+        mCanonizer.SetDropUnusedTemporaries(mOptimizationLevel >= Optimizer::LEVEL_FULL);
         mCanonizer.Canonize(
             mActiveResult.mAst,
             &mSymbolTable
@@ -156,10 +168,19 @@ void BlockScriptBuilder::EndBuild(BlockScriptBuilder::CompilationResult& result)
 
         mActiveResult.mAsm = mCanonizer.GetAssembly();
         mActiveResult.mAsm.mGlobalsMap = &mGlobalsMap;
+        mActiveResult.mAsm.mCheckedAccessCount = mRangeAnalysis.GetCheckedCount();
+        mActiveResult.mAsm.mProvenAccessCount = mRangeAnalysis.GetProvenCount();
+
+        //lower the canonical tree into bytecode. If not possible, the vm runs the canonical tree
+        if (mBytecodeGenerator.Generate(mActiveResult.mAsm))
+        {
+            mActiveResult.mAsm.mBytecode = mBytecodeGenerator.GetBytecode();
+        }
     }
     else
     {
         mActiveResult.mAsm.mBlocks = nullptr;
+        mActiveResult.mAsm.mBytecode = nullptr;
     }
 
     for (int i = 0; i < mEventListeners.Size(); ++i)
@@ -170,12 +191,26 @@ void BlockScriptBuilder::EndBuild(BlockScriptBuilder::CompilationResult& result)
     result = mActiveResult;
 }
 
+void BlockScriptBuilder::NotifyPrebuiltCompilation()
+{
+    for (int i = 0; i < mEventListeners.Size(); ++i)
+    {
+        mEventListeners[i]->OnCompilationBegin();
+    }
+
+    for (int i = 0; i < mEventListeners.Size(); ++i)
+    {
+        mEventListeners[i]->OnCompilationEnd(true);
+    }
+}
+
 void BlockScriptBuilder::Reset()
 {
     //initialize compilation state variables
     mErrorCount = 0;
     mActiveResult.mAst = nullptr;
     mActiveResult.mAsm.mBlocks = nullptr;
+    mActiveResult.mAsm.mBytecode = nullptr;
     mCurrAnnotations = nullptr;
     mInFunBody = false;
     mReturnTypeContext = nullptr;
@@ -188,12 +223,15 @@ void BlockScriptBuilder::Reset()
     mCurrentFrame = mSymbolTable.CreateFrame();
     mCurrentFrame->SetCreatorCategory(StackFrameInfo::GLOBAL);
 
+    mOptimizer.Reset();
+    mRangeAnalysis.Reset();
     mCanonizer.Reset();
+    mBytecodeGenerator.Reset();
     mGlobalsMap.Reset();
     mGlobalsMetaData.Reset();
     mFileStates.Clear();
-
-    mStrPool.Clear();
+    mFrameLines.Clear();
+    mKeywordLine = -1;
 
     //Event listeners must be persistent per builder instance.
 }
@@ -219,6 +257,10 @@ StackFrameInfo* BlockScriptBuilder::StartNewFrame()
     StackFrameInfo* newFrame = mSymbolTable.CreateFrame();
     newFrame->SetParentStackFrame(mCurrentFrame);
     mCurrentFrame = newFrame;
+    FrameLine& frameLine = mFrameLines.PushEmpty();
+    frameLine.mFrame = newFrame;
+    frameLine.mLine = mKeywordLine != -1 ? mKeywordLine : (mFileStates.GetSize() > 0 ? GetCurrentLine() : -1);
+    mKeywordLine = -1;
     return newFrame;
 }
 
@@ -228,6 +270,24 @@ void BlockScriptBuilder::PopFrame()
     mCurrentFrame = mCurrentFrame->GetParentStackFrame();
 }
 
+void BlockScriptBuilder::MarkKeywordLine()
+{
+    mKeywordLine = GetCurrentLine();
+}
+
+int BlockScriptBuilder::GetFrameLine(const StackFrameInfo* frame) const
+{
+    //frames just built are at the back
+    for (unsigned int i = mFrameLines.GetSize(); i-- > 0;)
+    {
+        if (mFrameLines[i].mFrame == frame)
+        {
+            return mFrameLines[i].mLine;
+        }
+    }
+    return GetCurrentLine();
+}
+
 void BlockScriptBuilder::BindIntrinsic(Ast::StmtFunDec* funDec, FunCallback callback)
 {
     PG_ASSERT(mInFunBody);
@@ -452,7 +512,7 @@ Exp* BlockScriptBuilder::BuildSetBinop(Exp* lhs, Exp* rhs, bool isExtern)
 
             if (isExtern)
             { 
-                if (!idd->GetMetaData().isGlobal)
+                if (!idd->GetMetaData().isGlobal || mCurrentFrame->GetParentStackFrame() != nullptr)
                 {
                     BS_ErrorDispatcher(this, "Can only use extern keyword on global variables.");
                     return nullptr;
@@ -567,7 +627,7 @@ Exp* BlockScriptBuilder::BuildBinop (Ast::Exp* lhs, int op, Ast::Exp* rhs)
             int offset = 0;
             while (argList != nullptr && argList->GetArgDec() != nullptr)
             {
-                if (!Pegasus::Utils::Strcmp(argList->GetArgDec()->GetVar(), accessOffset->GetName()))
+                if (argList->GetArgDec()->GetVar() == accessOffset->GetName())
                 {
                     tid2 = argList->GetArgDec()->GetType();
                     PG_ASSERT(tid2 != nullptr);
@@ -628,8 +688,10 @@ Exp* BlockScriptBuilder::BuildBinop (Ast::Exp* lhs, int op, Ast::Exp* rhs)
                 return nullptr;
             }
 
-            char* newName = mStrPool.AllocateString();
+            //the name of a scalar type with a digit appended, looked up without interning
+            char newName[SWIZZLE_TYPE_NAME_LENGTH];
             newName[0] = '\0';
+            PG_ASSERT(Utils::Strlen(tid1->GetChild()->GetName()) + 2 < SWIZZLE_TYPE_NAME_LENGTH);
             Utils::Strcat(newName, tid1->GetChild()->GetName());
             if (swizzleLen >= 2)
             {
@@ -665,7 +727,7 @@ Exp* BlockScriptBuilder::BuildBinop (Ast::Exp* lhs, int op, Ast::Exp* rhs)
             
             while (propertyList != nullptr)
             {
-                if (!Utils::Strcmp(propertyList->mName, propertyName))
+                if (propertyList->mName == propertyName)
                 {
                     //found the property! lets fill in the type of this expression
                     const TypeDesc* expType = propertyList->mType;
@@ -904,25 +966,27 @@ Exp*   BlockScriptBuilder::BuildIdd   (const char * name)
 
         //find type
         StackFrameInfo* currentFrame = mCurrentFrame; 
-        int frameOffset = 0;
         while (currentFrame != nullptr)
         {
             StackFrameInfo::Entry* found = currentFrame->FindDeclaration(name);
             if (found != nullptr) {
+                // block frames are flattened into their storage frame, so a variable is either
+                // a global or lives in the frame of the current function
+                const StackFrameInfo* storage = currentFrame->GetStorageFrame();
                 idd->SetOffset(found->mOffset);
-                idd->SetFrameOffset(frameOffset);
+                idd->SetFrameOffset(0);
                 idd->SetTypeDesc(found->mType);
-                idd->GetMetaData().isGlobal = (currentFrame->GetParentStackFrame() == nullptr);
+                idd->GetMetaData().isGlobal = (storage->GetParentStackFrame() == nullptr);
+                PG_ASSERT(idd->GetMetaData().isGlobal || storage == mCurrentFrame->GetStorageFrame());
                 break;
             }
             currentFrame = currentFrame->GetParentStackFrame();
-            frameOffset++;
         }
 
         //is this an undeclared idd/not found? see if its a global
         if (idd->GetOffset() == -1)
         {
-            idd->GetMetaData().isGlobal = (mCurrentFrame->GetParentStackFrame() == nullptr);
+            idd->GetMetaData().isGlobal = (mCurrentFrame->GetStorageFrame()->GetParentStackFrame() == nullptr);
         }
         else
         {
@@ -1118,7 +1182,9 @@ StmtExp* BlockScriptBuilder::BuildStmtExp(Exp* exp)
         BS_ErrorDispatcher(this, "Empty expressions not allowed! expression must be a function call, did you forget passing parameters ?");
         return nullptr;
     }
-    return BS_NEW StmtExp(exp);
+    StmtExp* stmtExp = BS_NEW StmtExp(exp);
+    stmtExp->SetLine(GetCurrentLine());
+    return stmtExp;
 }
 
 StmtReturn* BlockScriptBuilder::BuildStmtReturn(Exp* exp)
@@ -1140,7 +1206,18 @@ StmtReturn* BlockScriptBuilder::BuildStmtReturn(Exp* exp)
         BS_ErrorDispatcher(this, "return type must match that of the current function context.");
         return nullptr;
     }
-    return BS_NEW StmtReturn(exp);
+    StmtReturn* stmtReturn = BS_NEW StmtReturn(exp);
+    stmtReturn->SetLine(GetCurrentLine());
+    return stmtReturn;
+}
+
+StmtExp* BlockScriptBuilder::BuildStmtYield()
+{
+    //lowered to a call to the yield intrinsic, which suspends the vm once it returns. Every backend
+    //already resumes after a callback, so the statement needs no node of its own.
+    //The intrinsic cannot be called by name, yield is a keyword.
+    Exp* call = BuildFunCall(CreateExpList(), mStrPool->Intern("yield"));
+    return call != nullptr ? BuildStmtExp(call) : nullptr;
 }
 
 FunDesc* BlockScriptBuilder::RegisterFunctionDeclaration(Ast::StmtFunDec* funDec)
@@ -1154,6 +1231,7 @@ StmtFunDec* BlockScriptBuilder::BuildStmtFunDec(Ast::ArgList* argList, const Typ
 
 
     StmtFunDec* funDec = BS_NEW StmtFunDec(argList, returnType, nameIdd);
+    funDec->SetLine(GetFrameLine(mCurrentFrame));
 
     // record the frame for this function
     funDec->SetFrame(mCurrentFrame);
@@ -1199,6 +1277,7 @@ StmtWhile* BlockScriptBuilder::BuildStmtWhile(Exp* exp, StmtList* stmtList)
     PG_ASSERT(exp != nullptr);
 
     StmtWhile* stmtWhile = BS_NEW StmtWhile(exp, stmtList);
+    stmtWhile->SetLine(GetFrameLine(mCurrentFrame));
 
     stmtWhile->SetFrame(mCurrentFrame);
 
@@ -1219,6 +1298,7 @@ StmtFor* BlockScriptBuilder::BuildStmtFor(Exp* init, Exp* cond, Exp* update, Stm
     }
 
     StmtFor* stmtFor = BS_NEW StmtFor(init, cond, update, stmtList);
+    stmtFor->SetLine(GetFrameLine(mCurrentFrame));
     stmtFor->SetFrame(mCurrentFrame);
 
     //pop the previous frame
@@ -1235,41 +1315,24 @@ StmtIfElse* BlockScriptBuilder::BuildStmtIfElse(Exp* exp, StmtList* ifBlock, Stm
         return nullptr;
     }
     StmtIfElse* stmtIfElse = BS_NEW StmtIfElse(exp, ifBlock, tail, frame);
+    stmtIfElse->SetLine(GetFrameLine(frame));
 
     mCurrentFrame->SetCreatorCategory(StackFrameInfo::IF_STMT);
 
     return stmtIfElse;
 }
 
-static bool TestStringLength(const char * str)
-{
-    if (Strlen(str) + 1 > IddStrPool::sCharsPerString)
-    {
-        return false;
-    }
-    return true;
-}
-
-char* BlockScriptBuilder::CopyString(const char* strIn)
+const char* BlockScriptBuilder::CopyString(const char* strIn)
 {
-    PG_ASSERT (Strlen(strIn)  < IddStrPool::sCharsPerString)
-    char* newStr = GetStringPool().AllocateString();
-    newStr[0] = '\0';
-    return Utils::Strcat(newStr, strIn);
+    return mStrPool->Intern(strIn);
 }
 
-void BlockScriptBuilder::CreateIntrinsicFunction(const char* funName, const char* const* argTypes, const char* const* argNames, int argCount, const char* returnType, FunCallback callback, bool isMethod)
+void BlockScriptBuilder::CreateIntrinsicFunction(const char* funName, const char* const* argTypes, const char* const* argNames, int argCount, const char* returnType, FunCallback callback, bool isMethod, PureIntrinsic pureIntrinsic)
 {
     //step 1, check that strings and types exist.
     for (int i = 0; i < argCount; ++i)
     {
         const char* argType = argTypes[i];
-        const char* argName = argNames[i];
-        if (!TestStringLength(argType) || !TestStringLength(argName))
-        {
-            PG_FAILSTR("length of argument type %s or name %s is too big.", argType, argName);
-            return;
-        }
 
         //test types exist
         if (GetTypeByName(argType) == nullptr)
@@ -1279,11 +1342,6 @@ void BlockScriptBuilder::CreateIntrinsicFunction(const char* funName, const char
         }
     }
 
-    if (!TestStringLength(returnType) || !TestStringLength(funName))
-    {
-        PG_FAILSTR("The length of the return type is too big.");
-        return;
-    }
     const TypeDesc* returnTypeDesc = GetTypeByName(returnType);
     if (returnTypeDesc == nullptr)
     {
@@ -1296,8 +1354,8 @@ void BlockScriptBuilder::CreateIntrinsicFunction(const char* funName, const char
     Ast::ArgList* currNode = nullptr;
     for (int i = 0; i < argCount; ++i)
     {
-        char* argTypeCpy = CopyString(argTypes[i]);
-        char* argNameCpy = CopyString(argNames[i]);
+        const char* argTypeCpy = CopyString(argTypes[i]);
+        const char* argNameCpy = CopyString(argNames[i]);
         const TypeDesc* currType = GetTypeByName(argTypeCpy);
         PG_ASSERT(currType != nullptr);
         if (argList == nullptr)
@@ -1316,7 +1374,7 @@ void BlockScriptBuilder::CreateIntrinsicFunction(const char* funName, const char
         currNode->SetArgDec(argDec);
     }
 
-    char* funNameCpy = CopyString(funName);
+    const char* funNameCpy = CopyString(funName);
 
 
     //step 3, build the statement
@@ -1328,6 +1386,7 @@ void BlockScriptBuilder::CreateIntrinsicFunction(const char* funName, const char
     }
     
     funDec->GetDesc()->SetIsMethod(isMethod);
+    funDec->GetDesc()->SetPureIntrinsic(pureIntrinsic);
     BindIntrinsic(funDec, callback);
 }
 
@@ -1402,8 +1461,9 @@ StmtStructDef* BlockScriptBuilder::BuildStmtStructDef(const char* name, ArgList*
     
     static const int MAX_CHILD_MEMBERS = 255;
 
-    static const char* sMassiveCharTypeContainer[MAX_CHILD_MEMBERS];
-    static const char* sMassiveCharNameContainer[MAX_CHILD_MEMBERS];
+    //on the stack, scripts can be compiled concurrently
+    const char* massiveCharTypeContainer[MAX_CHILD_MEMBERS];
+    const char* massiveCharNameContainer[MAX_CHILD_MEMBERS];
 
     int count = 0;
     ArgList* argList = definitions;
@@ -1415,8 +1475,8 @@ StmtStructDef* BlockScriptBuilder::BuildStmtStructDef(const char* name, ArgList*
             return nullptr;
         }
 
-        sMassiveCharNameContainer[count] = argList->GetArgDec()->GetVar();
-        sMassiveCharTypeContainer[count] = argList->GetArgDec()->GetType()->GetName();
+        massiveCharNameContainer[count] = argList->GetArgDec()->GetVar();
+        massiveCharTypeContainer[count] = argList->GetArgDec()->GetType()->GetName();
         ++count;
         argList = argList->GetTail();
     }
@@ -1424,11 +1484,13 @@ StmtStructDef* BlockScriptBuilder::BuildStmtStructDef(const char* name, ArgList*
     //Create constructor
     CreateIntrinsicFunction(
         name,
-        sMassiveCharTypeContainer, //no argins types
-        sMassiveCharNameContainer, //no argins names
+        massiveCharTypeContainer, //no argins types
+        massiveCharNameContainer, //no argins names
         count, //no argcounts
         name,
-        StructGenericConstructor
+        StructGenericConstructor,
+        false,
+        PURE_CONSTRUCT
     );
 
     //copy all the declaration info
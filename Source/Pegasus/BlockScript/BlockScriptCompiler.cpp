@@ -22,13 +22,13 @@ using namespace Pegasus::BlockScript;
 
 #define BLOCKSCRIPT_MAX_DEFINE_STR_LEN 64
 
-extern void Bison_BlockScriptParse(const Io::FileBuffer* fileBuffer, BlockScript::BlockScriptBuilder* builder, BlockScript::IFileIncluder* fileIncluder, BlockScript::Container<BlockScript::Preprocessor::Definition>* definitionList);
+extern void Bison_BlockScriptParse(const Io::FileBuffer* fileBuffer, BlockScript::BlockScriptBuilder* builder, BlockScript::IFileIncluder* fileIncluder, BlockScript::Container<BlockScript::Preprocessor::Definition>* definitionList, BlockScript::PrecompiledHeaderCache* headerCache, BlockScript::Container<BlockScript::Preprocessor::Definition>* outDefinitionList);
 
-BlockScriptCompiler::BlockScriptCompiler(Alloc::IAllocator* allocator)
-: mAllocator(allocator), mAst(nullptr), mFileIncluder(nullptr), mTitle("<No-Title>")
+BlockScriptCompiler::BlockScriptCompiler(Alloc::IAllocator* allocator, IddStrPool* strPool)
+: mAllocator(allocator), mAst(nullptr), mFileIncluder(nullptr), mHeaderCache(nullptr), mTitle("<No-Title>")
 {
     mDefinitionList.Initialize(allocator);
-    mBuilder.Initialize(mAllocator);
+    mBuilder.Initialize(mAllocator, strPool);
     mStrAllocator.Initialize(BLOCKSCRIPT_MAX_DEFINE_STR_LEN, mAllocator);
 }
 
@@ -39,7 +39,7 @@ BlockScriptCompiler::~BlockScriptCompiler()
 bool BlockScriptCompiler::Compile(const Io::FileBuffer* fb)
 {
     mBuilder.BeginBuild(mTitle); 
-    Bison_BlockScriptParse(fb, &mBuilder, mFileIncluder, &mDefinitionList);
+    Bison_BlockScriptParse(fb, &mBuilder, mFileIncluder, &mDefinitionList, mHeaderCache, nullptr);
     BlockScriptBuilder::CompilationResult cr;
 	mBuilder.EndBuild(cr);
     mAst = cr.mAst;
@@ -19,7 +19,7 @@ using namespace Pegasus::Alloc;
 using namespace Pegasus::BlockScript;
 
 BlockScriptManager::BlockScriptManager(IAllocator* allocator)
-: mAllocator(nullptr), mInternalRuntimeLib(nullptr)
+: mAllocator(nullptr), mInternalRuntimeLib(nullptr), mAssemblyCache(nullptr), mAotRegistry(allocator), mHeaderCache(allocator), mPrecompiledHeadersEnabled(false)
 {
     Initialize(allocator);
 }
@@ -35,21 +35,25 @@ BlockScriptManager::~BlockScriptManager()
 void BlockScriptManager::Initialize(IAllocator* allocator)
 {
     mAllocator = allocator;
-    mInternalRuntimeLib = PG_NEW(mAllocator, -1, "Block Script Lib Module", Alloc::PG_MEM_PERM) BlockLib(mAllocator, "BS-Runtime-Lib");
+    mStrPool.Initialize(allocator);
+    mInternalRuntimeLib = PG_NEW(mAllocator, -1, "Block Script Lib Module", Alloc::PG_MEM_PERM) BlockLib(mAllocator, "BS-Runtime-Lib", &mStrPool);
     RegisterIntrinsics(mInternalRuntimeLib);
 }
 
 BlockScript* BlockScriptManager::CreateBlockScript()
 {
     PG_ASSERTSTR(mInternalRuntimeLib != nullptr, "Internal runtime library cannot be null");
-    BlockScript* bs = PG_NEW(mAllocator, -1, "Block Script", Alloc::PG_MEM_PERM) BlockScript(mAllocator, mInternalRuntimeLib);
+    BlockScript* bs = PG_NEW(mAllocator, -1, "Block Script", Alloc::PG_MEM_PERM) BlockScript(mAllocator, mInternalRuntimeLib, &mStrPool);
     bs->AddCompilerEventListener(GetIntrinsicCompilerListener());
+    bs->SetAssemblyCache(mAssemblyCache);
+    bs->SetAotRegistry(&mAotRegistry);
+    bs->SetHeaderCache(mPrecompiledHeadersEnabled ? &mHeaderCache : nullptr);
     return bs;
 }
 
 BlockLib*    BlockScriptManager::CreateBlockLib(const char* name)
 {
-    BlockLib* lib = PG_NEW(mAllocator, -1, "Block Script Lib Module", Alloc::PG_MEM_PERM) BlockLib(mAllocator, name);
+    BlockLib* lib = PG_NEW(mAllocator, -1, "Block Script Lib Module", Alloc::PG_MEM_PERM) BlockLib(mAllocator, name, &mStrPool);
     lib->GetSymbolTable()->RegisterChild(mInternalRuntimeLib->GetSymbolTable());
     return lib;
 }
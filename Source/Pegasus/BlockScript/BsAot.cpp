@@ -0,0 +1,210 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                       Pegasus                                        */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file   BsAot.cpp
+//! \author agent
+//! \date   16th October 2026
+//! \brief  Ahead of time compiled scripts: registry of the translated scripts, and runtime
+//!         shared by the bytecode interpreter and the translated code
+
+#include "Pegasus/BlockScript/BsAot.h"
+#include "Pegasus/BlockScript/Canonizer.h"
+#include "Pegasus/BlockScript/BlockScriptAst.h"
+#include "Pegasus/BlockScript/StackFrameInfo.h"
+#include "Pegasus/BlockScript/FunDesc.h"
+#include "Pegasus/BlockScript/TypeDesc.h"
+#include "Pegasus/BlockScript/FunCallback.h"
+#include "Pegasus/BlockScript/EventListeners.h"
+#include "Pegasus/Core/Assertion.h"
+#include "Pegasus/Core/Log.h"
+
+using namespace Pegasus;
+using namespace Pegasus::BlockScript;
+using namespace Pegasus::BlockScript::Canon;
+using namespace Pegasus::BlockScript::Bytecode;
+
+//commands shared with the canonical tree interpreter
+extern void PushFrameCommand(const StackFrameInfo* info, BsVmState& state, const Container<GlobalMapEntry>* globalsInitData);
+extern void PopFrameCommand(BsVmState& state);
+extern void NativeCallCommand(const Ast::FunCall* fc, int argumentBytes, BsVmState& state);
+
+//64 bit FNV-1a, on the words of a table
+static void HashWords(Math::PUInt64& hash, const int* words, int count)
+{
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(words);
+    for (int i = 0; i < count * static_cast<int>(sizeof(int)); ++i)
+    {
+        hash ^= bytes[i];
+        hash *= PCST_UINT64(1099511628211);
+    }
+}
+
+AotRegistry::AotRegistry(Alloc::IAllocator* allocator)
+: mScripts(allocator)
+{
+}
+
+AotRegistry::~AotRegistry()
+{
+}
+
+void AotRegistry::Register(const AotScript* scripts, int count)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        PG_ASSERT(scripts[i].mRun != nullptr);
+        mScripts.PushEmpty() = &scripts[i];
+    }
+}
+
+AotRunFunction AotRegistry::Find(const BytecodeAssembly& bytecode) const
+{
+    if (mScripts.GetSize() == 0)
+    {
+        return nullptr;
+    }
+
+    Math::PUInt64 key = ComputeKey(bytecode);
+    unsigned int keyLow = static_cast<unsigned int>(key);
+    unsigned int keyHigh = static_cast<unsigned int>(key >> 32);
+    for (unsigned int i = 0; i < mScripts.GetSize(); ++i)
+    {
+        const AotScript* script = mScripts[i];
+        if (script->mKeyLow == keyLow && script->mKeyHigh == keyHigh && script->mCodeSize == bytecode.mCodeSize)
+        {
+            return script->mRun;
+        }
+    }
+    return nullptr;
+}
+
+Math::PUInt64 AotRegistry::ComputeKey(const BytecodeAssembly& bytecode)
+{
+    Math::PUInt64 hash = PCST_UINT64(14695981039346656037);
+    int sizes[] = { bytecode.mCodeSize, bytecode.mConstantCount, bytecode.mBlockCount };
+    HashWords(hash, sizes, sizeof(sizes) / sizeof(sizes[0]));
+    HashWords(hash, bytecode.mCode, bytecode.mCodeSize);
+    HashWords(hash, bytecode.mConstantKinds, bytecode.mConstantCount);
+    HashWords(hash, bytecode.mBlockOffsets, bytecode.mBlockCount);
+    return hash;
+}
+
+void Aot::Exit(BsVmState& state)
+{
+    if (state.GetRuntimeListener() != nullptr)
+    {
+        state.GetRuntimeListener()->OnRuntimeExit(state);
+    }
+}
+
+void Aot::PushFrame(const Assembly& assembly, BsVmState& state, const StackFrameInfo* info)
+{
+    PushFrameCommand(info, state, assembly.mGlobalsMap);
+}
+
+void Aot::PopFrame(BsVmState& state)
+{
+    PopFrameCommand(state);
+}
+
+int Aot::Return(BsVmState& state)
+{
+    FrameInformation* fi = reinterpret_cast<FrameInformation*>(state.Ram() + state.GetReg(R_SBP) - sizeof(FrameInformation));
+    PG_ASSERT(fi->mSentinel == SENTINEL);
+    int returnIp = fi->mIp;
+    PopFrameCommand(state);
+    return returnIp;
+}
+
+void Aot::Callback(BsVmState& state, const Ast::FunCall* fc, int argumentBytes)
+{
+    const FunDesc* funDesc = fc->GetDesc();
+    int functionStack = state.GetReg(R_SBP);
+    int outputBufferSize = fc->GetTypeDesc()->GetByteSize();
+    void* outputBuffer = outputBufferSize > CANON_REGISTER_BYTESIZE
+            ? static_cast<void*>(state.Ram() + state.GetReg(R_RET))
+            : static_cast<void*>(state.GetRegBuffer() + R_RET);
+
+    FunCallbackContext ctx(
+        &state,
+        funDesc,
+        fc->GetArgs(),
+        state.Ram() + functionStack,
+        argumentBytes,
+        outputBuffer,
+        outputBufferSize
+    );
+    funDesc->GetCallback()(ctx);
+    PopFrameCommand(state);
+}
+
+void Aot::Native(BsVmState& state, const Ast::FunCall* fc, int argumentBytes)
+{
+    NativeCallCommand(fc, argumentBytes, state);
+}
+
+void Aot::ObjProp(BsVmState& state, int locationAddress, int objectAddress, const PropertyNode* propertyNode, const TypeDesc* objType, bool isRead)
+{
+    void* locationPointer = state.Ram() + locationAddress;
+    int objectHandle = *reinterpret_cast<int*>(state.Ram() + objectAddress);
+
+    PropertyCallbackContext ctx;
+    ctx.state = &state;
+    ctx.objectHandle = objectHandle;
+    ctx.propertyDesc = propertyNode;
+    ctx.destBuffer = isRead ? locationPointer : nullptr;
+    ctx.srcBuffer  = isRead ? nullptr : locationPointer;
+    ctx.isRead = isRead;
+
+    ObjectPropertyAccessorCallback cb = objType->GetPropertyCallback();
+    PG_ASSERTSTR(cb != nullptr, "The property callback cannot be null for this type %s.");
+    bool res = cb(ctx);
+    if (!res)
+    {
+        PG_LOG('ERR_', "[BLOCKSCRIPT VIRUAL MACHINE ERROR]: No property %s exists for such object.", propertyNode->mName);
+    }
+}
+
+int Aot::GetInstructionSize(const int* pc)
+{
+    switch (*pc)
+    {
+    case OP_EXIT: case OP_POPFRAME: case OP_RET:
+        return 1;
+    case OP_JMP: case OP_PUSHFRAME: case OP_CALL: case OP_CAST_ITOF: case OP_CAST_FTOI: case OP_ITOF:
+        return 2;
+    case OP_CALLBACK: case OP_NATIVE: case OP_GETR: case OP_SETR: case OP_SAVE_TO_ADDR:
+    case OP_NEG_I: case OP_NEG_F: case OP_NEG_F2: case OP_NEG_F3: case OP_NEG_F4: case OP_NEG_M22: case OP_NEG_M33: case OP_NEG_M44:
+    case OP_SIN: case OP_COS:
+        return 3;
+    case OP_JMPCOND_I: case OP_JMPCOND_F: case OP_SAVE: case OP_LEA: case OP_LEAXU: case OP_LD4: case OP_ST4: case OP_STI:
+    case OP_COPY_II: case OP_NST: case OP_NCOPY: case OP_SPLAT:
+    case OP_DOT_F2: case OP_DOT_F3: case OP_DOT_F4: case OP_CROSS_F3:
+    case OP_MUL_M22_F2: case OP_MUL_M33_F3: case OP_MUL_M44_F4: case OP_MUL_M44_M44:
+        return 4;
+    case OP_LEAX: case OP_LD: case OP_LDX: case OP_ST: case OP_COPY_I: case OP_ISDH: case OP_READ_PROP: case OP_WRITE_PROP:
+    case OP_FMA_F: case OP_FMA_F2: case OP_FMA_F3: case OP_FMA_F4: case OP_FMA_M22: case OP_FMA_M33: case OP_FMA_M44:
+    case OP_LERP_F: case OP_LERP_F2: case OP_LERP_F3: case OP_LERP_F4:
+        return 5;
+    case OP_COPY:
+        return 6;
+    case OP_IMM:
+        return 3 + pc[2];
+    case OP_PACK:
+        return 4 + pc[3];
+    default:
+        //binary alu commands
+        PG_ASSERT(*pc >= OP_ADD_I && *pc <= OP_DIV_M44);
+        return 4;
+    }
+}
+
+void Aot::Crash(BsVmState& state)
+{
+    CrashInfo crashInfo;
+    state.GetRuntimeListener()->OnCrash(state, crashInfo);
+    state.SetExecutionState(BsVmState::Crashed);
+}
@@ -265,6 +265,14 @@ void Echo_Float(FunCallbackContext& context)
     } 
 }
 
+void Yield_Script(FunCallbackContext& context)
+{
+    //the script stops right after this call, until the host resumes it
+    context.GetVmState()->Suspend();
+    PG_ASSERT(context.GetOutputBufferSize() == sizeof(int));
+    *static_cast<int*>(context.GetRawOutputBuffer()) = 0;
+}
+
 }
 
 namespace Private_Math
@@ -441,30 +449,33 @@ void Pegasus::BlockScript::RegisterIntrinsics(BlockLib* lib)
 
     const Pegasus::BlockScript::FunctionDeclarationDesc funConstructors[] =
     {
-        //*funName | retType | argsTypes                                   |  argNames                    | callback
+        //*funName | retType | argsTypes                                   |  argNames                    | callback | pure intrinsic
         ///////////////////////////////////////////float4///////////////////////////////////////////////////////////////
-        { "float4", "float4", {"float", "float", "float", "float", nullptr}, {"x", "y", "z", "w", nullptr}, Private_VectorConstructors::ConstructFloat4_float_float_float_float },
-        { "float4", "float4", {"float3", "float", nullptr},                  {"xyz", "w", nullptr},         Private_VectorConstructors::ConstructFloat4_float_float_float_float },
-        { "float4", "float4", {"int", "int", "int", "int", nullptr},         {"x", "y", "z", "w", nullptr}, Private_VectorConstructors::ConstructFloat4_int_int_int_int },
-        { "float4", "float4", {"float", nullptr},                            {"xyzw", nullptr},             Private_VectorConstructors::ConstructFloat4_float },
-        { "float4", "float4", {"int", nullptr},                              {"xyzw", nullptr},             Private_VectorConstructors::ConstructFloat4_int },
+        { "float4", "float4", {"float", "float", "float", "float", nullptr}, {"x", "y", "z", "w", nullptr}, Private_VectorConstructors::ConstructFloat4_float_float_float_float, PURE_CONSTRUCT },
+        { "float4", "float4", {"float3", "float", nullptr},                  {"xyz", "w", nullptr},         Private_VectorConstructors::ConstructFloat4_float_float_float_float, PURE_CONSTRUCT },
+        { "float4", "float4", {"int", "int", "int", "int", nullptr},         {"x", "y", "z", "w", nullptr}, Private_VectorConstructors::ConstructFloat4_int_int_int_int, PURE_CONSTRUCT },
+        { "float4", "float4", {"float", nullptr},                            {"xyzw", nullptr},             Private_VectorConstructors::ConstructFloat4_float, PURE_SPLAT },
+        { "float4", "float4", {"int", nullptr},                              {"xyzw", nullptr},             Private_VectorConstructors::ConstructFloat4_int, PURE_SPLAT },
         ///////////////////////////////////////////float3///////////////////////////////////////////////////////////////
-        { "float3", "float3", {"float" , "float", "float", nullptr},         {"x", "y", "z", nullptr},      Private_VectorConstructors::ConstructFloat3_float_float_float },
-        { "float3", "float3", {"float2", "float", nullptr},                  {"x", "y", "z", nullptr},      Private_VectorConstructors::ConstructFloat3_float_float_float },
-        { "float3", "float3", {"int", "int", "int", nullptr},                {"x", "y", "z", nullptr},      Private_VectorConstructors::ConstructFloat3_int_int_int },
-        { "float3", "float3", {"float", nullptr},                            {"xyz", nullptr},              Private_VectorConstructors::ConstructFloat3_float },
-        { "float3", "float3", {"int", nullptr},                              {"xyz", nullptr},              Private_VectorConstructors::ConstructFloat3_int },
+        { "float3", "float3", {"float" , "float", "float", nullptr},         {"x", "y", "z", nullptr},      Private_VectorConstructors::ConstructFloat3_float_float_float, PURE_CONSTRUCT },
+        { "float3", "float3", {"float2", "float", nullptr},                  {"x", "y", "z", nullptr},      Private_VectorConstructors::ConstructFloat3_float_float_float, PURE_CONSTRUCT },
+        { "float3", "float3", {"int", "int", "int", nullptr},                {"x", "y", "z", nullptr},      Private_VectorConstructors::ConstructFloat3_int_int_int, PURE_CONSTRUCT },
+        { "float3", "float3", {"float", nullptr},                            {"xyz", nullptr},              Private_VectorConstructors::ConstructFloat3_float, PURE_SPLAT },
+        { "float3", "float3", {"int", nullptr},                              {"xyz", nullptr},              Private_VectorConstructors::ConstructFloat3_int, PURE_SPLAT },
         ///////////////////////////////////////////float2///////////////////////////////////////////////////////////////
-        {"float2", "float2",  {"float", "float", nullptr},                   {"x", "y", nullptr},           Private_VectorConstructors::ConstructFloat2_float_float },
-        {"float2", "float2",  {"int", "int", nullptr},                       {"x", "y", nullptr},           Private_VectorConstructors::ConstructFloat2_int_int },
-        {"float2", "float2",  {"float", nullptr},                            {"xy", nullptr},               Private_VectorConstructors::ConstructFloat2_float },
-        {"float2", "float2",  {"int", nullptr},                              {"xy", nullptr},               Private_VectorConstructors::ConstructFloat2_int },
+        {"float2", "float2",  {"float", "float", nullptr},                   {"x", "y", nullptr},           Private_VectorConstructors::ConstructFloat2_float_float, PURE_CONSTRUCT },
+        {"float2", "float2",  {"int", "int", nullptr},                       {"x", "y", nullptr},           Private_VectorConstructors::ConstructFloat2_int_int, PURE_CONSTRUCT },
+        {"float2", "float2",  {"float", nullptr},                            {"xy", nullptr},               Private_VectorConstructors::ConstructFloat2_float, PURE_SPLAT },
+        {"float2", "float2",  {"int", nullptr},                              {"xy", nullptr},               Private_VectorConstructors::ConstructFloat2_int, PURE_SPLAT },
         ///////////////////////////////////////////echo///////////////////////////////////////////////////////////////
         {"echo",   "int",     {"string", nullptr},                           {"input", nullptr},            Private_Utilities::Echo_String },
         {"echo",   "int",     {"int", nullptr},                              {"input", nullptr},            Private_Utilities::Echo_Int },
         {"echo",   "int",     {"float", nullptr},                            {"input", nullptr},            Private_Utilities::Echo_Float },
+        ///////////////////////////////////////////yield///////////////////////////////////////////////////////////////
+        //called by the yield statement only, yield is a keyword (see BlockScriptBuilder::BuildStmtYield)
+        {"yield",  "int",     {nullptr},                                     {nullptr},                     Private_Utilities::Yield_Script },
         ///////////////////////////////////////////float4x4///////////////////////////////////////////////////////////////
-        { "float4x4", "float4x4", {"float4", "float4", "float4", "float4", nullptr}, {"col_x", "col_y", "col_z", "col_w", nullptr}, Private_VectorConstructors::ConstructMatrixN_by_N<16>},
+        { "float4x4", "float4x4", {"float4", "float4", "float4", "float4", nullptr}, {"col_x", "col_y", "col_z", "col_w", nullptr}, Private_VectorConstructors::ConstructMatrixN_by_N<16>, PURE_CONSTRUCT },
         { "float4x4", "float4x4", {"float", "float", "float", "float", 
                                "float", "float", "float", "float", 
                                "float", "float", "float", "float", 
@@ -472,21 +483,21 @@ void Pegasus::BlockScript::RegisterIntrinsics(BlockLib* lib)
                               {"m11", "m12", "m13", "m14",
                                "m21", "m22", "m23", "m24",
                                "m31", "m32", "m33", "m34",
-                               "m41", "m42", "m43", "m44",  nullptr}, Private_VectorConstructors::ConstructMatrixN_by_N<16> },
+                               "m41", "m42", "m43", "m44",  nullptr}, Private_VectorConstructors::ConstructMatrixN_by_N<16>, PURE_CONSTRUCT },
         ///////////////////////////////////////////float3x3///////////////////////////////////////////////////////////////
-        { "float3x3", "float3x3", {"float3", "float3", "float3", nullptr}, {"col_x", "col_y", "col_z", nullptr}, Private_VectorConstructors::ConstructMatrixN_by_N<9> },
+        { "float3x3", "float3x3", {"float3", "float3", "float3", nullptr}, {"col_x", "col_y", "col_z", nullptr}, Private_VectorConstructors::ConstructMatrixN_by_N<9>, PURE_CONSTRUCT },
         { "float3x3", "float3x3", {"float", "float", "float", 
                                "float", "float", "float", 
                                "float", "float", "float", nullptr}, 
                               {"m11", "m12", "m13",
                                "m21", "m22", "m23",
-                               "m41", "m42", "m43", nullptr}, Private_VectorConstructors::ConstructMatrixN_by_N<9> },
+                               "m41", "m42", "m43", nullptr}, Private_VectorConstructors::ConstructMatrixN_by_N<9>, PURE_CONSTRUCT },
         ///////////////////////////////////////////float2x2///////////////////////////////////////////////////////////////
-        { "float2x2", "float2x2", {"float2", "float2", nullptr}, {"x", "y", nullptr}, Private_VectorConstructors::ConstructMatrixN_by_N<4> },
+        { "float2x2", "float2x2", {"float2", "float2", nullptr}, {"x", "y", nullptr}, Private_VectorConstructors::ConstructMatrixN_by_N<4>, PURE_CONSTRUCT },
         { "float2x2", "float2x2", {"float", "float", 
                                "float", "float", nullptr}, 
                               {"m11", "m12",
-                               "m41", "m42", nullptr}, Private_VectorConstructors::ConstructMatrixN_by_N<4> },
+                               "m41", "m42", nullptr}, Private_VectorConstructors::ConstructMatrixN_by_N<4>, PURE_CONSTRUCT },
     };
 
     lib->CreateIntrinsicFunctions(funConstructors, sizeof(funConstructors) / sizeof(funConstructors[0])); 
@@ -494,26 +505,26 @@ void Pegasus::BlockScript::RegisterIntrinsics(BlockLib* lib)
     //Register Math intrinsics
     const Pegasus::BlockScript::FunctionDeclarationDesc mathFuncs[] =
     {
-        //*funName | retType | argsTypes                                   |  argNames                    | callback
+        //*funName | retType | argsTypes                                   |  argNames                    | callback | pure intrinsic
         ///////////////////////////////////////////DOT///////////////////////////////////////////////////////////////
-        { "dot", "float",  { "float4",  "float4", nullptr}, {"x", "y", nullptr}, Private_Math::Dot<Math::Vec4>},
-        { "dot", "float",  { "float3",  "float3", nullptr}, {"x", "y", nullptr}, Private_Math::Dot<Math::Vec3>},
-        { "dot", "float",  { "float2",  "float2", nullptr}, {"x", "y", nullptr}, Private_Math::Dot<Math::Vec2>},
+        { "dot", "float",  { "float4",  "float4", nullptr}, {"x", "y", nullptr}, Private_Math::Dot<Math::Vec4>, PURE_DOT},
+        { "dot", "float",  { "float3",  "float3", nullptr}, {"x", "y", nullptr}, Private_Math::Dot<Math::Vec3>, PURE_DOT},
+        { "dot", "float",  { "float2",  "float2", nullptr}, {"x", "y", nullptr}, Private_Math::Dot<Math::Vec2>, PURE_DOT},
         ///////////////////////////////////////////LERP///////////////////////////////////////////////////////////////
-        { "lerp", "float",  { "float",  "float",  "float",  nullptr}, {"x", "y", "t", nullptr}, Private_Math::Lerp<float>},
-        { "lerp", "float4", { "float4", "float4", "float",  nullptr}, {"x", "y", "t", nullptr}, Private_Math::Lerp<Math::Vec4>},
-        { "lerp", "float3", { "float3", "float3", "float",  nullptr}, {"x", "y", "t", nullptr}, Private_Math::Lerp<Math::Vec3>},
-        { "lerp", "float2", { "float2", "float2", "float",  nullptr}, {"x", "y", "t", nullptr}, Private_Math::Lerp<Math::Vec2>},
+        { "lerp", "float",  { "float",  "float",  "float",  nullptr}, {"x", "y", "t", nullptr}, Private_Math::Lerp<float>, PURE_LERP},
+        { "lerp", "float4", { "float4", "float4", "float",  nullptr}, {"x", "y", "t", nullptr}, Private_Math::Lerp<Math::Vec4>, PURE_LERP},
+        { "lerp", "float3", { "float3", "float3", "float",  nullptr}, {"x", "y", "t", nullptr}, Private_Math::Lerp<Math::Vec3>, PURE_LERP},
+        { "lerp", "float2", { "float2", "float2", "float",  nullptr}, {"x", "y", "t", nullptr}, Private_Math::Lerp<Math::Vec2>, PURE_LERP},
         ///////////////////////////////////////////MUL///////////////////////////////////////////////////////////////
-        { "mul", "float4x4", { "float4x4", "float4x4", nullptr}, {"x", "y", nullptr}, Private_Math::Mul<Math::Mat44, Math::Mat44, Math::Mult44_44>},
-        { "mul", "float4", { "float4x4", "float4", nullptr}, {"x", "y", nullptr},   Private_Math::Mul<Math::Vec4, Math::Mat44, Math::Mult44_41>},
-        { "mul", "float3", { "float3x3", "float3", nullptr}, {"x", "y", nullptr},   Private_Math::Mul<Math::Vec3, Math::Mat33, Math::Mult33_31>},
-        { "mul", "float2", { "float2x2", "float2", nullptr}, {"x", "y", nullptr},   Private_Math::Mul<Math::Vec2, Math::Mat22, Math::Mult22_21>},
+        { "mul", "float4x4", { "float4x4", "float4x4", nullptr}, {"x", "y", nullptr}, Private_Math::Mul<Math::Mat44, Math::Mat44, Math::Mult44_44>, PURE_MUL},
+        { "mul", "float4", { "float4x4", "float4", nullptr}, {"x", "y", nullptr},   Private_Math::Mul<Math::Vec4, Math::Mat44, Math::Mult44_41>, PURE_MUL},
+        { "mul", "float3", { "float3x3", "float3", nullptr}, {"x", "y", nullptr},   Private_Math::Mul<Math::Vec3, Math::Mat33, Math::Mult33_31>, PURE_MUL},
+        { "mul", "float2", { "float2x2", "float2", nullptr}, {"x", "y", nullptr},   Private_Math::Mul<Math::Vec2, Math::Mat22, Math::Mult22_21>, PURE_MUL},
         ///////////////////////////////////////////CROSS///////////////////////////////////////////////////////////////
-        { "cross", "float3", { "float3", "float3", nullptr}, {"x", "y", nullptr}, Private_Math::Cross<Math::Vec3>},
+        { "cross", "float3", { "float3", "float3", nullptr}, {"x", "y", nullptr}, Private_Math::Cross<Math::Vec3>, PURE_CROSS},
         ///////////////////////////////////////////TRIG///////////////////////////////////////////////////////////////
-        { "sin", "float", { "float", nullptr}, {"v", nullptr}, Private_Math::Sin},
-        { "cos", "float", { "float", nullptr}, {"v", nullptr}, Private_Math::Cos},
+        { "sin", "float", { "float", nullptr}, {"v", nullptr}, Private_Math::Sin, PURE_SIN},
+        { "cos", "float", { "float", nullptr}, {"v", nullptr}, Private_Math::Cos, PURE_COS},
         { "divUp", "int", { "int", "int", nullptr}, {"a", "b", nullptr}, Private_Math::DivUp},
         { "GetRotation",   "float4x4", { "float3", "float", nullptr}, {"axis", "amount", nullptr}, Private_Math::Mat44_Rotation},
         { "GetProjection", "float4x4", { "float", "float", "float", "float", "float", "float", nullptr}, { "l", "r", "t", "b", "n", "f", nullptr}, Private_Math::Mat44_Proj1},
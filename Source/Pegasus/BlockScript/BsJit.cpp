@@ -0,0 +1,1332 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                       Pegasus                                        */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file   BsJit.cpp
+//! \author agent
+//! \date   16th October 2026
+//! \brief  Just in time compiler of hot script functions, x86-64 code emitter
+
+#include "Pegasus/BlockScript/BsJit.h"
+#include "Pegasus/BlockScript/BsVm.h"
+#include "Pegasus/Core/Assertion.h"
+
+#if BLOCKSCRIPT_JIT_X64
+
+#include "Pegasus/BlockScript/BsAot.h"
+#include "Pegasus/BlockScript/BsSimd.h"
+#include "Pegasus/Allocator/Alloc.h"
+#include "Pegasus/Utils/Memcpy.h"
+#include "Pegasus/Utils/Vector.h"
+#include "Pegasus/Math/Vector.h"
+#include "Pegasus/Math/Matrix.h"
+
+#include <atomic>
+#include <stddef.h>
+#include <limits.h>
+
+#if PEGASUS_PLATFORM_WINDOWS
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+using namespace Pegasus;
+using namespace Pegasus::BlockScript;
+using namespace Pegasus::BlockScript::Bytecode;
+using namespace Pegasus::BlockScript::Canon;
+
+using Aot::ScratchRegister;
+using Aot::As;
+
+//biggest value the jit copies inline. Functions moving bigger values stay on the interpreter
+#define JIT_MAX_INLINE_COPY 4096
+
+namespace
+{
+
+//! state shared between a compiled function and the helpers it calls
+struct JitContext
+{
+    BsVmState*      mState;
+    const Assembly* mAssembly;
+    const BsVm*     mVm;
+    int*            mRegs; //! registers of the state
+    char*           mRam;  //! ram of the state, reloaded by the compiled code after every helper call
+};
+
+//! a compiled function. \return the instruction stored on the frame of the function, -1 if the vm stopped
+typedef int (*JitCode)(JitContext* ctx);
+
+enum JitStatus
+{
+    JIT_INTERPRETED, //still counting calls
+    JIT_COMPILING,   //a thread is compiling it, the others keep interpreting
+    JIT_COMPILED,
+    JIT_REJECTED     //contains an instruction the jit does not translate
+};
+
+} //namespace
+
+namespace Pegasus
+{
+namespace BlockScript
+{
+
+//! promotion state of a function
+struct JitFunction
+{
+    int               mEntryIp;
+    std::atomic<int>  mCalls;
+    std::atomic<int>  mStatus;
+    JitCode           mCode;      //! valid once mStatus is JIT_COMPILED
+    void*             mPages;     //! executable memory holding mCode
+    size_t            mPageBytes;
+};
+
+}
+}
+
+namespace
+{
+
+//---------------------------------------------------------------------------------------
+// helpers called by the compiled code. They refresh the ram of the context, the stack can move
+//---------------------------------------------------------------------------------------
+
+int JitPushFrame(JitContext* ctx, const StackFrameInfo* info, int ip)
+{
+    ctx->mState->SetReg(R_IP, ip);
+    Aot::PushFrame(*ctx->mAssembly, *ctx->mState, info);
+    ctx->mRam = ctx->mState->Ram();
+    return 0;
+}
+
+int JitPopFrame(JitContext* ctx)
+{
+    Aot::PopFrame(*ctx->mState);
+    ctx->mRam = ctx->mState->Ram();
+    return 0;
+}
+
+int JitCall(JitContext* ctx, int targetIp, int returnIp)
+{
+    //the callee runs until it returns to the level of this function, compiled if it is hot
+    BsVmState& state = *ctx->mState;
+    Aot::SetReturnIp(state, returnIp);
+    state.SetReg(R_IP, targetIp);
+    int exitStackLevel = state.GetStackLevels() - 1;
+    while (ctx->mVm->RunBytecode(*ctx->mAssembly, state, exitStackLevel, INT_MAX))
+    {
+    }
+    ctx->mRam = state.Ram();
+    return state.GetExecutionState() == BsVmState::Alive ? 0 : -1;
+}
+
+int JitReturn(JitContext* ctx)
+{
+    int returnIp = Aot::Return(*ctx->mState);
+    ctx->mRam = ctx->mState->Ram();
+    return returnIp;
+}
+
+int JitCallback(JitContext* ctx, const Ast::FunCall* fc, int argumentBytes, int ip)
+{
+    BsVmState& state = *ctx->mState;
+    state.SetReg(R_IP, ip);
+    Aot::Callback(state, fc, argumentBytes);
+    state.SetReg(R_IP, ip + 3);
+    ctx->mRam = state.Ram();
+    return state.GetExecutionState() == BsVmState::Alive ? 0 : -1;
+}
+
+int JitNative(JitContext* ctx, const Ast::FunCall* fc, int argumentBytes, int ip)
+{
+    BsVmState& state = *ctx->mState;
+    state.SetReg(R_IP, ip);
+    Aot::Native(state, fc, argumentBytes);
+    state.SetReg(R_IP, ip + 3);
+    ctx->mRam = state.Ram();
+    return state.GetExecutionState() == BsVmState::Alive ? 0 : -1;
+}
+
+int JitCheckIndex(JitContext* ctx, int offset, int arrayByteSize, int ip)
+{
+    //only called on an access out of bounds
+    BsVmState& state = *ctx->mState;
+    if (!Aot::CheckIndex(state, offset, arrayByteSize))
+    {
+        state.SetReg(R_IP, ip);
+        return -1;
+    }
+    return 0;
+}
+
+void JitNativeStore(JitContext* ctx, int offset, const ScratchRegister* src, int bytes)
+{
+    Utils::Memcpy(ctx->mState->GetNativeArgs() + offset, src, bytes);
+}
+
+void JitNativeCopy(JitContext* ctx, int offset, int address, int bytes)
+{
+    Utils::Memcpy(ctx->mState->GetNativeArgs() + offset, ctx->mState->Ram() + address, bytes);
+}
+
+//! runs the intrinsics kept out of line, with the kernels of the interpreter so results match bit for bit
+void JitIntrinsic(ScratchRegister* s, const int* pc)
+{
+    switch (*pc)
+    {
+    case OP_FMA_F: case OP_FMA_F2: case OP_FMA_F3: case OP_FMA_F4: case OP_FMA_M22:
+                     Simd::MulAdd<1>(s[pc[1]].f, s[pc[2]].f, s[pc[3]].f, s[pc[4]].f); break;
+    case OP_FMA_M33: Simd::MulAdd<3>(s[pc[1]].f, s[pc[2]].f, s[pc[3]].f, s[pc[4]].f); break;
+    case OP_FMA_M44: Simd::MulAdd<4>(s[pc[1]].f, s[pc[2]].f, s[pc[3]].f, s[pc[4]].f); break;
+    case OP_DOT_F2:  s[pc[1]].f[0] = Simd::Dot<2>(s[pc[2]].f, s[pc[3]].f); break;
+    case OP_DOT_F3:  s[pc[1]].f[0] = Simd::Dot<3>(s[pc[2]].f, s[pc[3]].f); break;
+    case OP_DOT_F4:  s[pc[1]].f[0] = Simd::Dot<4>(s[pc[2]].f, s[pc[3]].f); break;
+    case OP_CROSS_F3: Simd::Cross(s[pc[1]].f, s[pc[2]].f, s[pc[3]].f); break;
+    case OP_LERP_F:
+        {
+            float r = Math::Lerp(s[pc[2]].f[0], s[pc[3]].f[0], s[pc[4]].f[0]);
+            s[pc[1]].f[0] = r;
+        }
+        break;
+    case OP_LERP_F2: case OP_LERP_F3: case OP_LERP_F4:
+        Simd::Lerp(s[pc[1]].f, s[pc[2]].f, s[pc[3]].f, s[pc[4]].f[0]);
+        break;
+    case OP_MUL_M22_F2:
+        {
+            Math::Vec2 r;
+            Math::Mult22_21(r, As<Math::Mat22>(s[pc[2]]), As<Math::Vec2>(s[pc[3]]));
+            As<Math::Vec2>(s[pc[1]]) = r;
+        }
+        break;
+    case OP_MUL_M33_F3:
+        {
+            Math::Vec3 r;
+            Math::Mult33_31(r, As<Math::Mat33>(s[pc[2]]), As<Math::Vec3>(s[pc[3]]));
+            As<Math::Vec3>(s[pc[1]]) = r;
+        }
+        break;
+    case OP_MUL_M44_F4:  Simd::MulMat44Vec4(s[pc[1]].f, s[pc[2]].f, s[pc[3]].f); break;
+    case OP_MUL_M44_M44: Simd::MulMat44Mat44(s[pc[1]].f, s[pc[2]].f, s[pc[3]].f); break;
+    case OP_SIN: s[pc[1]].f[0] = Math::Sin(s[pc[2]].f[0]); break;
+    case OP_COS: s[pc[1]].f[0] = Math::Cos(s[pc[2]].f[0]); break;
+    default:
+        PG_FAILSTR("Unhandled jit intrinsic!");
+    }
+}
+
+//---------------------------------------------------------------------------------------
+// x86-64 encoding
+//---------------------------------------------------------------------------------------
+
+enum X64Reg
+{
+    RAX, RCX, RDX, RBX, RSP, RBP, RSI, RDI,
+    R8, R9, R10, R11, R12, R13, R14, R15,
+    NO_REG = -1
+};
+
+//registers of the compiled code. All are callee saved, on both calling conventions
+const int REG_S   = RBX; //scratch registers of the bytecode, on the native stack
+const int REG_RAM = R12; //ram of the state
+const int REG_R   = R13; //canonical registers of the state
+const int REG_CTX = R14; //the JitContext
+
+#if PEGASUS_PLATFORM_WINDOWS
+const int gArgRegs[4] = { RCX, RDX, R8, R9 };
+#else
+const int gArgRegs[4] = { RDI, RSI, RDX, RCX };
+#endif
+
+//native frame: shadow space for the helpers, then the scratch registers. The 4 registers saved
+//and the return address leave the stack 16 byte aligned
+const int SHADOW_SPACE_BYTES = 32;
+const int SCRATCH_BYTES = BYTECODE_SCRATCH_REGISTER_COUNT * sizeof(ScratchRegister);
+const int NATIVE_FRAME_BYTES = SHADOW_SPACE_BYTES + SCRATCH_BYTES + 8;
+
+//! memory operand, base + index + displacement
+struct Mem
+{
+    int mBase;
+    int mIndex;
+    int mDisp;
+    Mem(int base, int index, int disp) : mBase(base), mIndex(index), mDisp(disp) {}
+};
+
+//! \return a word of a scratch register
+Mem S(int reg, int word = 0)
+{
+    return Mem(REG_S, NO_REG, reg * static_cast<int>(sizeof(ScratchRegister)) + word * 4);
+}
+
+//! \return a canonical register
+Mem R(int reg)
+{
+    return Mem(REG_R, NO_REG, reg * 4);
+}
+
+//! Writes the machine code of a function
+class Emitter
+{
+public:
+    explicit Emitter(Alloc::IAllocator* allocator) : mCode(allocator), mFixups(allocator) {}
+
+    int GetSize() const { return static_cast<int>(mCode.GetSize()); }
+    const unsigned char* GetCode() { return mCode.GetSize() > 0 ? &mCode[0] : nullptr; }
+
+    void Byte(int b) { mCode.PushEmpty() = static_cast<unsigned char>(b); }
+
+    void Int(int v)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            Byte((v >> (8 * i)) & 0xff);
+        }
+    }
+
+    void Patch(int at, int v)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            mCode[at + i] = static_cast<unsigned char>((v >> (8 * i)) & 0xff);
+        }
+    }
+
+    //! instruction with a memory operand: [prefix] [rex] opcode modrm [sib] disp32
+    void Op(int prefix, bool w, int opcode, int reg, const Mem& m)
+    {
+        if (prefix != 0)
+        {
+            Byte(prefix);
+        }
+        int rex = (w ? 8 : 0) | ((reg & 8) ? 4 : 0) | ((m.mIndex != NO_REG && (m.mIndex & 8)) ? 2 : 0) | ((m.mBase & 8) ? 1 : 0);
+        if (rex != 0)
+        {
+            Byte(0x40 | rex);
+        }
+        Opcode(opcode);
+        //always a 32 bit displacement, which avoids the special encodings of rbp and r13
+        if (m.mIndex != NO_REG || (m.mBase & 7) == RSP)
+        {
+            Byte(0x80 | ((reg & 7) << 3) | 4);
+            Byte(((m.mIndex != NO_REG ? (m.mIndex & 7) : 4) << 3) | (m.mBase & 7));
+        }
+        else
+        {
+            Byte(0x80 | ((reg & 7) << 3) | (m.mBase & 7));
+        }
+        Int(m.mDisp);
+    }
+
+    //! instruction with a register operand: [prefix] [rex] opcode modrm
+    void OpR(int prefix, bool w, int opcode, int reg, int rm)
+    {
+        if (prefix != 0)
+        {
+            Byte(prefix);
+        }
+        int rex = (w ? 8 : 0) | ((reg & 8) ? 4 : 0) | ((rm & 8) ? 1 : 0);
+        if (rex != 0)
+        {
+            Byte(0x40 | rex);
+        }
+        Opcode(opcode);
+        Byte(0xc0 | ((reg & 7) << 3) | (rm & 7));
+    }
+
+    // general purpose instructions
+    void MovLoad(int reg, const Mem& m)     { Op(0, false, 0x8b, reg, m); }
+    void MovStore(const Mem& m, int reg)    { Op(0, false, 0x89, reg, m); }
+    void MovLoad64(int reg, const Mem& m)   { Op(0, true, 0x8b, reg, m); }
+    void Movsxd(int reg, const Mem& m)      { Op(0, true, 0x63, reg, m); }
+    void Lea64(int reg, const Mem& m)       { Op(0, true, 0x8d, reg, m); }
+    void MovStoreImm(const Mem& m, int v)   { Op(0, false, 0xc7, 0, m); Int(v); }
+    void CmpMemImm(const Mem& m, int v)     { Op(0, false, 0x81, 7, m); Int(v); }
+    void AluLoad(int opcode, int reg, const Mem& m) { Op(0, false, opcode, reg, m); }
+    void AluReg(int opcode, int reg, int rm)        { OpR(0, false, opcode, reg, rm); }
+    void AluImm(int ext, int rm, int v)     { OpR(0, false, 0x81, ext, rm); Int(v); }
+    void AluImm64(int ext, int rm, int v)   { OpR(0, true, 0x81, ext, rm); Int(v); }
+    void MovReg64(int dst, int src)         { OpR(0, true, 0x8b, dst, src); }
+    void AddReg64(int dst, int src)         { OpR(0, true, 0x03, dst, src); }
+    void IdivMem(const Mem& m)              { Op(0, false, 0xf7, 7, m); }
+    void Neg(int rm)                        { OpR(0, false, 0xf7, 3, rm); }
+    void Test(int reg, int rm)              { OpR(0, false, 0x85, reg, rm); }
+    void Setcc(int cc, int rm)              { OpR(0, false, 0x0f90 | cc, 0, rm); }
+    void MovzxByte(int reg, int rm)         { OpR(0, false, 0x0fb6, reg, rm); }
+    void Cdq()                              { Byte(0x99); }
+    void Ret()                              { Byte(0xc3); }
+
+    void MovImm(int reg, int v)
+    {
+        if (reg & 8)
+        {
+            Byte(0x41);
+        }
+        Byte(0xb8 | (reg & 7));
+        Int(v);
+    }
+
+    void MovImm64(int reg, const void* p)
+    {
+        Byte(0x48 | ((reg & 8) ? 1 : 0));
+        Byte(0xb8 | (reg & 7));
+        Math::PUInt64 v = static_cast<Math::PUInt64>(reinterpret_cast<size_t>(p));
+        Int(static_cast<int>(v));
+        Int(static_cast<int>(v >> 32));
+    }
+
+    void Push(int reg)
+    {
+        if (reg & 8)
+        {
+            Byte(0x41);
+        }
+        Byte(0x50 | (reg & 7));
+    }
+
+    void Pop(int reg)
+    {
+        if (reg & 8)
+        {
+            Byte(0x41);
+        }
+        Byte(0x58 | (reg & 7));
+    }
+
+    //! calls a c++ function, whose address is loaded in rax
+    void Call(const void* function)
+    {
+        MovImm64(RAX, function);
+        Byte(0xff);
+        Byte(0xd0);
+    }
+
+    // sse instructions. Prefix 0 is the packed single form
+    void Sse(int prefix, int opcode, int xmm, const Mem& m) { Op(prefix, false, 0x0f00 | opcode, xmm, m); }
+    void SseR(int prefix, int opcode, int xmm, int rm)      { OpR(prefix, false, 0x0f00 | opcode, xmm, rm); }
+    void Cmpss(int xmm, int rm, int predicate)              { SseR(0xf3, 0xc2, xmm, rm); Byte(predicate); }
+    void Shufps(int xmm, int rm, int mask)                  { SseR(0, 0xc6, xmm, rm); Byte(mask); }
+
+    //! jump to an instruction of the bytecode, resolved by ResolveJumps
+    void JmpTo(int ip)          { Byte(0xe9); AddFixup(ip); }
+    void JccTo(int cc, int ip)  { Byte(0x0f); Byte(0x80 | cc); AddFixup(ip); }
+
+    //! forward jump within the code of an instruction. \return the position to pass to Bind
+    int JccForward(int cc)      { Byte(0x0f); Byte(0x80 | cc); Int(0); return GetSize() - 4; }
+    int JmpForward()            { Byte(0xe9); Int(0); return GetSize() - 4; }
+    void Bind(int at)           { Patch(at, GetSize() - (at + 4)); }
+
+    //! patches the jumps to the bytecode
+    //! \param nativeOffsets native offset of every instruction offset
+    void ResolveJumps(const int* nativeOffsets)
+    {
+        for (unsigned int i = 0; i < mFixups.GetSize(); ++i)
+        {
+            const Fixup& f = mFixups[i];
+            PG_ASSERT(nativeOffsets[f.mIp] >= 0);
+            Patch(f.mAt, nativeOffsets[f.mIp] - (f.mAt + 4));
+        }
+    }
+
+private:
+    struct Fixup
+    {
+        int mAt; //! position of the 32 bit displacement
+        int mIp; //! instruction jumped to
+    };
+
+    void Opcode(int opcode)
+    {
+        if (opcode > 0xff)
+        {
+            Byte(opcode >> 8);
+        }
+        Byte(opcode & 0xff);
+    }
+
+    void AddFixup(int ip)
+    {
+        Fixup& f = mFixups.PushEmpty();
+        f.mAt = GetSize();
+        f.mIp = ip;
+        Int(0);
+    }
+
+    Utils::Vector<unsigned char> mCode;
+    Utils::Vector<Fixup> mFixups;
+};
+
+//opcodes and condition codes used
+const int ALU_ADD = 0x03, ALU_SUB = 0x2b, ALU_AND = 0x23, ALU_OR = 0x0b, ALU_CMP = 0x3b, ALU_IMUL = 0x0faf;
+const int EXT_ADD = 0, EXT_AND = 4, EXT_XOR = 6, EXT_CMP = 7;
+const int CC_E = 0x4, CC_NE = 0x5, CC_S = 0x8, CC_L = 0xc, CC_GE = 0xd, CC_LE = 0xe, CC_G = 0xf;
+const int SSE_MOVU_LOAD = 0x10, SSE_MOVU_STORE = 0x11, SSE_MOVA_LOAD = 0x28, SSE_MOVA_STORE = 0x29;
+const int SSE_CVTSI2SS = 0x2a, SSE_CVTTSS2SI = 0x2c, SSE_AND = 0x54, SSE_OR = 0x56, SSE_XOR = 0x57;
+const int SSE_ADD = 0x58, SSE_MUL = 0x59, SSE_SUB = 0x5c, SSE_DIV = 0x5e, SSE_MOVD_TO_XMM = 0x6e, SSE_MOVD_FROM_XMM = 0x7e;
+const int CMP_EQ = 0, CMP_LT = 1, CMP_LE = 2, CMP_NEQ = 4;
+
+//! \return the instruction following the instruction at ip, -1 if control never falls through
+int GetFallthrough(const int* code, int ip)
+{
+    switch (code[ip])
+    {
+    case OP_JMP: case OP_RET: case OP_EXIT:
+        return -1;
+    default:
+        return ip + Aot::GetInstructionSize(code + ip);
+    }
+}
+
+//! \return true if a value of this size is copied inline
+bool IsInlineCopy(int bytes)
+{
+    return bytes % 4 == 0 && bytes <= JIT_MAX_INLINE_COPY;
+}
+
+//! \return true if the jit translates an instruction
+bool IsSupported(const int* pc)
+{
+    switch (*pc)
+    {
+    case OP_EXIT: case OP_ISDH: case OP_READ_PROP: case OP_WRITE_PROP:
+        return false;
+    case OP_LD: case OP_LDX: case OP_ST: case OP_COPY_I:
+        return IsInlineCopy(pc[4]);
+    case OP_STI: case OP_COPY_II:
+        return IsInlineCopy(pc[3]);
+    case OP_COPY:
+        return IsInlineCopy(pc[5]);
+    default:
+        return true;
+    }
+}
+
+//! Translates the instructions of a function
+class FunctionCompiler
+{
+public:
+    FunctionCompiler(Alloc::IAllocator* allocator, const BytecodeAssembly& bytecode)
+    : mE(allocator), mCode(bytecode.mCode), mConstants(bytecode.mConstants), mStopAt(0), mReturnAt(0), mStops(allocator), mReturns(allocator)
+    {
+    }
+
+    Emitter& GetEmitter() { return mE; }
+
+    void Prologue()
+    {
+        mE.Push(RBX);
+        mE.Push(R12);
+        mE.Push(R13);
+        mE.Push(R14);
+        mE.AluImm64(5, RSP, NATIVE_FRAME_BYTES); //sub
+        mE.MovReg64(REG_CTX, gArgRegs[0]);
+        mE.Lea64(REG_S, Mem(RSP, NO_REG, SHADOW_SPACE_BYTES));
+        mE.MovLoad64(REG_R, Mem(REG_CTX, NO_REG, offsetof(JitContext, mRegs)));
+        ReloadRam();
+    }
+
+    //! writes the exit paths: the vm stopped (eax = -1), and the return (eax = instruction to return to)
+    void Epilogue()
+    {
+        mStopAt = mE.GetSize();
+        mE.MovImm(RAX, -1);
+        mReturnAt = mE.GetSize();
+        mE.AluImm64(EXT_ADD, RSP, NATIVE_FRAME_BYTES);
+        mE.Pop(R14);
+        mE.Pop(R13);
+        mE.Pop(R12);
+        mE.Pop(RBX);
+        mE.Ret();
+    }
+
+    //! patches the jumps to the exit paths
+    void ResolveExits()
+    {
+        for (unsigned int i = 0; i < mStops.GetSize(); ++i)
+        {
+            mE.Patch(mStops[i], mStopAt - (mStops[i] + 4));
+        }
+        for (unsigned int i = 0; i < mReturns.GetSize(); ++i)
+        {
+            mE.Patch(mReturns[i], mReturnAt - (mReturns[i] + 4));
+        }
+    }
+
+    void Translate(int ip);
+
+private:
+    void ReloadRam() { mE.MovLoad64(REG_RAM, Mem(REG_CTX, NO_REG, offsetof(JitContext, mRam))); }
+
+    //! after a helper returning a status: reloads the ram and stops if the vm stopped
+    void CheckHelper()
+    {
+        ReloadRam();
+        mE.Test(RAX, RAX);
+        mStops.PushEmpty() = mE.JccForward(CC_S);
+    }
+
+    //! resolves an address operand into rax. \return the memory operand in ram
+    Mem Addr(const int* operand)
+    {
+        if (operand[0] == BYTECODE_GLOBAL_FRAME)
+        {
+            mE.Movsxd(RAX, R(R_G));
+        }
+        else
+        {
+            PG_ASSERT(operand[0] == 0 || operand[0] == 1);
+            mE.Movsxd(RAX, R(R_SBP));
+            if (operand[0] == 1)
+            {
+                //stack base of the caller, stored on the frame information
+                mE.Movsxd(RAX, Mem(REG_RAM, RAX, offsetof(FrameInformation, mPreviousSbp) - static_cast<int>(sizeof(FrameInformation))));
+            }
+        }
+        return Mem(REG_RAM, RAX, operand[1]);
+    }
+
+    //! \return the memory operand in ram at the address held by a scratch register, loaded in index
+    Mem AddrIn(int s, int index)
+    {
+        mE.Movsxd(index, S(s));
+        return Mem(REG_RAM, index, 0);
+    }
+
+    //! copies bytes between memory operands, through xmm0 and ecx
+    void Copy(Mem dst, Mem src, int bytes, bool dstAligned, bool srcAligned)
+    {
+        int q = 0;
+        for (; q + 16 <= bytes; q += 16)
+        {
+            mE.Sse(0, srcAligned ? SSE_MOVA_LOAD : SSE_MOVU_LOAD, 0, Mem(src.mBase, src.mIndex, src.mDisp + q));
+            mE.Sse(0, dstAligned ? SSE_MOVA_STORE : SSE_MOVU_STORE, 0, Mem(dst.mBase, dst.mIndex, dst.mDisp + q));
+        }
+        for (; q < bytes; q += 4)
+        {
+            mE.MovLoad(RCX, Mem(src.mBase, src.mIndex, src.mDisp + q));
+            mE.MovStore(Mem(dst.mBase, dst.mIndex, dst.mDisp + q), RCX);
+        }
+    }
+
+    //! sets the arguments of a helper: the context, then up to 3 immediates
+    void Args(int a1, int a2, int a3)
+    {
+        mE.MovReg64(gArgRegs[0], REG_CTX);
+        mE.MovImm(gArgRegs[1], a1);
+        mE.MovImm(gArgRegs[2], a2);
+        mE.MovImm(gArgRegs[3], a3);
+    }
+
+    void IntAlu(const int* pc, int opcode)
+    {
+        mE.MovLoad(RAX, S(pc[2]));
+        mE.AluLoad(opcode, RAX, S(pc[3]));
+        mE.MovStore(S(pc[1]), RAX);
+    }
+
+    void IntDiv(const int* pc, int resultReg)
+    {
+        mE.MovLoad(RAX, S(pc[2]));
+        mE.Cdq();
+        mE.IdivMem(S(pc[3]));
+        mE.MovStore(S(pc[1]), resultReg);
+    }
+
+    void IntCmp(const int* pc, int cc)
+    {
+        mE.MovLoad(RAX, S(pc[2]));
+        mE.AluLoad(ALU_CMP, RAX, S(pc[3]));
+        mE.Setcc(cc, RAX);
+        mE.MovzxByte(RAX, RAX);
+        mE.MovStore(S(pc[1]), RAX);
+    }
+
+    void IntLogic(const int* pc, int opcode)
+    {
+        mE.MovLoad(RAX, S(pc[2]));
+        mE.Test(RAX, RAX);
+        mE.Setcc(CC_NE, RAX);
+        mE.MovLoad(RCX, S(pc[3]));
+        mE.Test(RCX, RCX);
+        mE.Setcc(CC_NE, RCX);
+        mE.AluReg(opcode, RAX, RCX);
+        mE.MovzxByte(RAX, RAX);
+        mE.MovStore(S(pc[1]), RAX);
+    }
+
+    void FloatAlu(const int* pc, int opcode)
+    {
+        mE.Sse(0xf3, SSE_MOVU_LOAD, 0, S(pc[2]));
+        mE.Sse(0xf3, opcode, 0, S(pc[3]));
+        mE.Sse(0xf3, SSE_MOVU_STORE, 0, S(pc[1]));
+    }
+
+    //! writes 1.0 if xmm0 holds a true mask, 0.0 otherwise
+    void StoreMask(int s)
+    {
+        mE.MovImm(RAX, 0x3f800000);
+        mE.SseR(0x66, SSE_MOVD_TO_XMM, 2, RAX);
+        mE.SseR(0, SSE_AND, 0, 2);
+        mE.Sse(0xf3, SSE_MOVU_STORE, 0, S(s));
+    }
+
+    //! float comparison, lhs and rhs are swapped for the greater than comparisons
+    void FloatCmp(int dst, int lhs, int rhs, int predicate)
+    {
+        mE.Sse(0xf3, SSE_MOVU_LOAD, 0, S(lhs));
+        mE.Sse(0xf3, SSE_MOVU_LOAD, 1, S(rhs));
+        mE.Cmpss(0, 1, predicate);
+        StoreMask(dst);
+    }
+
+    void FloatLogic(const int* pc, int opcode)
+    {
+        mE.SseR(0, SSE_XOR, 1, 1);
+        mE.Sse(0xf3, SSE_MOVU_LOAD, 0, S(pc[2]));
+        mE.Cmpss(0, 1, CMP_NEQ);
+        mE.Sse(0xf3, SSE_MOVU_LOAD, 2, S(pc[3]));
+        mE.Cmpss(2, 1, CMP_NEQ);
+        mE.SseR(0, opcode, 0, 2);
+        StoreMask(pc[1]);
+    }
+
+    void VecAlu(const int* pc, int opcode, int quads)
+    {
+        for (int q = 0; q < quads; ++q)
+        {
+            mE.Sse(0, SSE_MOVA_LOAD, 0, S(pc[2], 4 * q));
+            mE.Sse(0, opcode, 0, S(pc[3], 4 * q));
+            mE.Sse(0, SSE_MOVA_STORE, 0, S(pc[1], 4 * q));
+        }
+    }
+
+    void VecNeg(const int* pc, int quads)
+    {
+        mE.MovImm(RAX, static_cast<int>(0x80000000u));
+        mE.SseR(0x66, SSE_MOVD_TO_XMM, 1, RAX);
+        mE.Shufps(1, 1, 0);
+        for (int q = 0; q < quads; ++q)
+        {
+            mE.Sse(0, SSE_MOVA_LOAD, 0, S(pc[2], 4 * q));
+            mE.SseR(0, SSE_XOR, 0, 1);
+            mE.Sse(0, SSE_MOVA_STORE, 0, S(pc[1], 4 * q));
+        }
+    }
+
+    void Intrinsic(const int* pc)
+    {
+        mE.MovReg64(gArgRegs[0], REG_S);
+        mE.MovImm64(gArgRegs[1], pc);
+        mE.Call(reinterpret_cast<const void*>(&JitIntrinsic));
+    }
+
+    Emitter mE;
+    const int* mCode;
+    const void* const* mConstants;
+    int mStopAt;   //! native offset of the stop path
+    int mReturnAt; //! native offset of the return path
+    Utils::Vector<int> mStops;   //! jumps to the stop path
+    Utils::Vector<int> mReturns; //! jumps to the return path
+};
+
+void FunctionCompiler::Translate(int ip)
+{
+    const int* pc = mCode + ip;
+    switch (*pc)
+    {
+    case OP_JMP:
+        mE.JmpTo(pc[1]);
+        break;
+    case OP_JMPCOND_I:
+        mE.CmpMemImm(S(pc[1]), pc[2]);
+        mE.JccTo(CC_E, pc[3]);
+        break;
+    case OP_JMPCOND_F:
+        mE.SseR(0, SSE_XOR, 1, 1);
+        mE.Sse(0xf3, SSE_MOVU_LOAD, 0, S(pc[1]));
+        mE.Cmpss(0, 1, CMP_NEQ);
+        mE.SseR(0x66, SSE_MOVD_FROM_XMM, 0, RAX);
+        mE.AluImm(EXT_AND, RAX, 1);
+        mE.AluImm(EXT_CMP, RAX, pc[2]);
+        mE.JccTo(CC_E, pc[3]);
+        break;
+    case OP_PUSHFRAME:
+        mE.MovReg64(gArgRegs[0], REG_CTX);
+        mE.MovImm64(gArgRegs[1], mConstants[pc[1]]);
+        mE.MovImm(gArgRegs[2], ip);
+        mE.Call(reinterpret_cast<const void*>(&JitPushFrame));
+        ReloadRam();
+        break;
+    case OP_POPFRAME:
+        mE.MovReg64(gArgRegs[0], REG_CTX);
+        mE.Call(reinterpret_cast<const void*>(&JitPopFrame));
+        ReloadRam();
+        break;
+    case OP_CALL:
+        Args(pc[1], ip + 2, 0);
+        mE.Call(reinterpret_cast<const void*>(&JitCall));
+        CheckHelper();
+        break;
+    case OP_CALLBACK:
+    case OP_NATIVE:
+        mE.MovReg64(gArgRegs[0], REG_CTX);
+        mE.MovImm64(gArgRegs[1], mConstants[pc[1]]);
+        mE.MovImm(gArgRegs[2], pc[2]);
+        mE.MovImm(gArgRegs[3], ip);
+        mE.Call(*pc == OP_CALLBACK ? reinterpret_cast<const void*>(&JitCallback) : reinterpret_cast<const void*>(&JitNative));
+        CheckHelper();
+        break;
+    case OP_RET:
+        mE.MovReg64(gArgRegs[0], REG_CTX);
+        mE.Call(reinterpret_cast<const void*>(&JitReturn));
+        mReturns.PushEmpty() = mE.JmpForward();
+        break;
+    case OP_SAVE:
+        {
+            Mem m = Addr(pc + 1);
+            mE.MovLoad(RCX, R(pc[3]));
+            mE.MovStore(m, RCX);
+        }
+        break;
+    case OP_GETR:
+        mE.MovLoad(RAX, R(pc[2]));
+        mE.MovStore(S(pc[1]), RAX);
+        break;
+    case OP_SETR:
+        mE.MovLoad(RAX, S(pc[2]));
+        mE.MovStore(R(pc[1]), RAX);
+        break;
+    case OP_SAVE_TO_ADDR:
+        mE.Movsxd(RAX, R(pc[1]));
+        mE.MovLoad(RCX, R(pc[2]));
+        mE.MovStore(Mem(REG_RAM, RAX, 0), RCX);
+        break;
+    case OP_CAST_ITOF:
+        mE.Sse(0xf3, SSE_CVTSI2SS, 0, R(pc[1]));
+        mE.Sse(0xf3, SSE_MOVU_STORE, 0, R(pc[1]));
+        break;
+    case OP_CAST_FTOI:
+        mE.Sse(0xf3, SSE_CVTTSS2SI, RAX, R(pc[1]));
+        mE.MovStore(R(pc[1]), RAX);
+        break;
+    case OP_LEA:
+        {
+            Mem m = Addr(pc + 2);
+            mE.AluImm(EXT_ADD, RAX, m.mDisp);
+            mE.MovStore(S(pc[1]), RAX);
+        }
+        break;
+    case OP_LEAX:
+        {
+#if BLOCKSCRIPT_SAFEMODE
+            //in safe mode, check if we are trying to access an array out of bounds
+            mE.CmpMemImm(S(pc[1]), pc[4]);
+            int inBounds = mE.JccForward(CC_L);
+            mE.MovReg64(gArgRegs[0], REG_CTX);
+            mE.MovLoad(gArgRegs[1], S(pc[1]));
+            mE.MovImm(gArgRegs[2], pc[4]);
+            mE.MovImm(gArgRegs[3], ip);
+            mE.Call(reinterpret_cast<const void*>(&JitCheckIndex));
+            CheckHelper();
+            mE.Bind(inBounds);
+#endif
+            Mem m = Addr(pc + 2);
+            mE.AluLoad(ALU_ADD, RAX, S(pc[1]));
+            mE.AluImm(EXT_ADD, RAX, m.mDisp);
+            mE.MovStore(S(pc[1]), RAX);
+        }
+        break;
+    case OP_LEAXU:
+        {
+            Mem m = Addr(pc + 2);
+            mE.AluLoad(ALU_ADD, RAX, S(pc[1]));
+            mE.AluImm(EXT_ADD, RAX, m.mDisp);
+            mE.MovStore(S(pc[1]), RAX);
+        }
+        break;
+    case OP_LD4:
+        {
+            Mem m = Addr(pc + 2);
+            mE.MovLoad(RCX, m);
+            mE.MovStore(S(pc[1]), RCX);
+        }
+        break;
+    case OP_LD:
+        Copy(S(pc[1]), Addr(pc + 2), pc[4], true, false);
+        break;
+    case OP_LDX:
+        {
+            Mem m = Addr(pc + 2);
+            mE.Movsxd(RDX, S(pc[1]));
+            mE.AddReg64(RAX, RDX);
+            Copy(S(pc[1]), m, pc[4], true, false);
+        }
+        break;
+    case OP_ST4:
+        {
+            Mem m = Addr(pc + 1);
+            mE.MovLoad(RCX, S(pc[3]));
+            mE.MovStore(m, RCX);
+        }
+        break;
+    case OP_ST:
+        Copy(Addr(pc + 1), S(pc[3]), pc[4], false, true);
+        break;
+    case OP_STI:
+        Copy(AddrIn(pc[1], RAX), S(pc[2]), pc[3], false, true);
+        break;
+    case OP_IMM:
+        for (int i = 0; i < pc[2]; ++i)
+        {
+            mE.MovStoreImm(S(pc[1], i), pc[3 + i]);
+        }
+        break;
+    case OP_COPY:
+        {
+            Mem src = Addr(pc + 3);
+            mE.MovReg64(RDX, RAX);
+            src.mIndex = RDX;
+            Mem dst = Addr(pc + 1);
+            Copy(dst, src, pc[5], false, false);
+        }
+        break;
+    case OP_COPY_I:
+        {
+            Mem src = AddrIn(pc[3], RDX);
+            Mem dst = Addr(pc + 1);
+            Copy(dst, src, pc[4], false, false);
+        }
+        break;
+    case OP_COPY_II:
+        {
+            Mem src = AddrIn(pc[2], RDX);
+            Mem dst = AddrIn(pc[1], RAX);
+            Copy(dst, src, pc[3], false, false);
+        }
+        break;
+    case OP_NST:
+        mE.MovReg64(gArgRegs[0], REG_CTX);
+        mE.MovImm(gArgRegs[1], pc[1]);
+        mE.Lea64(gArgRegs[2], S(pc[2]));
+        mE.MovImm(gArgRegs[3], pc[3]);
+        mE.Call(reinterpret_cast<const void*>(&JitNativeStore));
+        break;
+    case OP_NCOPY:
+        mE.MovReg64(gArgRegs[0], REG_CTX);
+        mE.MovImm(gArgRegs[1], pc[1]);
+        mE.MovLoad(gArgRegs[2], S(pc[2]));
+        mE.MovImm(gArgRegs[3], pc[3]);
+        mE.Call(reinterpret_cast<const void*>(&JitNativeCopy));
+        break;
+
+    case OP_ADD_I:  IntAlu(pc, ALU_ADD); break;
+    case OP_SUB_I:  IntAlu(pc, ALU_SUB); break;
+    case OP_MUL_I:  IntAlu(pc, ALU_IMUL); break;
+    case OP_DIV_I:  IntDiv(pc, RAX); break;
+    case OP_MOD_I:  IntDiv(pc, RDX); break;
+    case OP_EQ_I:   IntCmp(pc, CC_E); break;
+    case OP_NEQ_I:  IntCmp(pc, CC_NE); break;
+    case OP_GT_I:   IntCmp(pc, CC_G); break;
+    case OP_LT_I:   IntCmp(pc, CC_L); break;
+    case OP_GTE_I:  IntCmp(pc, CC_GE); break;
+    case OP_LTE_I:  IntCmp(pc, CC_LE); break;
+    case OP_LAND_I: IntLogic(pc, 0x22); break; //and r8
+    case OP_LOR_I:  IntLogic(pc, 0x0a); break; //or r8
+    case OP_NEG_I:
+        mE.MovLoad(RAX, S(pc[2]));
+        mE.Neg(RAX);
+        mE.MovStore(S(pc[1]), RAX);
+        break;
+
+    case OP_ADD_F:  FloatAlu(pc, SSE_ADD); break;
+    case OP_SUB_F:  FloatAlu(pc, SSE_SUB); break;
+    case OP_MUL_F:  FloatAlu(pc, SSE_MUL); break;
+    case OP_DIV_F:  FloatAlu(pc, SSE_DIV); break;
+    case OP_EQ_F:   FloatCmp(pc[1], pc[2], pc[3], CMP_EQ); break;
+    case OP_NEQ_F:  FloatCmp(pc[1], pc[2], pc[3], CMP_NEQ); break;
+    case OP_GT_F:   FloatCmp(pc[1], pc[3], pc[2], CMP_LT); break;
+    case OP_LT_F:   FloatCmp(pc[1], pc[2], pc[3], CMP_LT); break;
+    case OP_GTE_F:  FloatCmp(pc[1], pc[3], pc[2], CMP_LE); break;
+    case OP_LTE_F:  FloatCmp(pc[1], pc[2], pc[3], CMP_LE); break;
+    case OP_LAND_F: FloatLogic(pc, SSE_AND); break;
+    case OP_LOR_F:  FloatLogic(pc, SSE_OR); break;
+    case OP_NEG_F:
+        mE.MovLoad(RAX, S(pc[2]));
+        mE.AluImm(EXT_XOR, RAX, static_cast<int>(0x80000000u));
+        mE.MovStore(S(pc[1]), RAX);
+        break;
+
+    case OP_ADD_F2: case OP_ADD_F3: case OP_ADD_F4: case OP_ADD_M22: VecAlu(pc, SSE_ADD, 1); break;
+    case OP_SUB_F2: case OP_SUB_F3: case OP_SUB_F4: case OP_SUB_M22: VecAlu(pc, SSE_SUB, 1); break;
+    case OP_MUL_F2: case OP_MUL_F3: case OP_MUL_F4: case OP_MUL_M22: VecAlu(pc, SSE_MUL, 1); break;
+    case OP_DIV_F2: case OP_DIV_F3: case OP_DIV_F4: case OP_DIV_M22: VecAlu(pc, SSE_DIV, 1); break;
+    case OP_ADD_M33: VecAlu(pc, SSE_ADD, 3); break;
+    case OP_SUB_M33: VecAlu(pc, SSE_SUB, 3); break;
+    case OP_MUL_M33: VecAlu(pc, SSE_MUL, 3); break;
+    case OP_DIV_M33: VecAlu(pc, SSE_DIV, 3); break;
+    case OP_ADD_M44: VecAlu(pc, SSE_ADD, 4); break;
+    case OP_SUB_M44: VecAlu(pc, SSE_SUB, 4); break;
+    case OP_MUL_M44: VecAlu(pc, SSE_MUL, 4); break;
+    case OP_DIV_M44: VecAlu(pc, SSE_DIV, 4); break;
+    case OP_NEG_F2: case OP_NEG_F3: case OP_NEG_F4: case OP_NEG_M22: VecNeg(pc, 1); break;
+    case OP_NEG_M33: VecNeg(pc, 3); break;
+    case OP_NEG_M44: VecNeg(pc, 4); break;
+
+    case OP_ITOF:
+        mE.Sse(0xf3, SSE_CVTSI2SS, 0, S(pc[1]));
+        mE.Sse(0xf3, SSE_MOVU_STORE, 0, S(pc[1]));
+        break;
+    case OP_PACK:
+        {
+            //registers are read in order, so the destination can be the first source
+            int word = 0;
+            for (int r = 0; r < pc[3]; ++r)
+            {
+                for (int w = 0; w < pc[4 + r]; ++w)
+                {
+                    mE.MovLoad(RCX, S(pc[2] + r, w));
+                    mE.MovStore(S(pc[1], word++), RCX);
+                }
+            }
+        }
+        break;
+    case OP_SPLAT:
+        mE.MovLoad(RCX, S(pc[2]));
+        for (int w = 0; w < pc[3]; ++w)
+        {
+            mE.MovStore(S(pc[1], w), RCX);
+        }
+        break;
+
+    default:
+        //fused multiply-adds, dot and cross products, lerps, matrix products and trigonometry
+        Intrinsic(pc);
+        break;
+    }
+}
+
+//! copies machine code into executable memory
+//! \param pageBytes output, the size of the memory allocated
+//! \return the memory, null on failure
+void* AllocateCode(const unsigned char* code, int size, size_t& pageBytes)
+{
+    pageBytes = (static_cast<size_t>(size) + 4095) & ~static_cast<size_t>(4095);
+#if PEGASUS_PLATFORM_WINDOWS
+    void* pages = VirtualAlloc(nullptr, pageBytes, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+    if (pages == nullptr)
+    {
+        return nullptr;
+    }
+    Utils::Memcpy(pages, code, size);
+    DWORD oldProtection;
+    if (!VirtualProtect(pages, pageBytes, PAGE_EXECUTE_READ, &oldProtection))
+    {
+        VirtualFree(pages, 0, MEM_RELEASE);
+        return nullptr;
+    }
+    FlushInstructionCache(GetCurrentProcess(), pages, pageBytes);
+#else
+    void* pages = mmap(nullptr, pageBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (pages == MAP_FAILED)
+    {
+        return nullptr;
+    }
+    Utils::Memcpy(pages, code, size);
+    if (mprotect(pages, pageBytes, PROT_READ | PROT_EXEC) != 0)
+    {
+        munmap(pages, pageBytes);
+        return nullptr;
+    }
+#endif
+    return pages;
+}
+
+void FreeCode(void* pages, size_t pageBytes)
+{
+#if PEGASUS_PLATFORM_WINDOWS
+    VirtualFree(pages, 0, MEM_RELEASE);
+#else
+    munmap(pages, pageBytes);
+#endif
+}
+
+} //namespace
+
+BsJit::BsJit(Alloc::IAllocator* allocator)
+: mAllocator(allocator),
+  mVm(nullptr),
+  mCallThreshold(BS_JIT_DEFAULT_CALL_THRESHOLD),
+  mFunctions(nullptr),
+  mFunctionCount(0),
+  mEntryToFunction(nullptr)
+{
+}
+
+BsJit::~BsJit()
+{
+    Reset();
+}
+
+bool BsJit::IsAvailable()
+{
+    return true;
+}
+
+bool BsJit::Initialize(const Assembly& assembly, const BsVm* vm)
+{
+    Reset();
+    if (assembly.mBytecode == nullptr || assembly.mFunBlockMap == nullptr)
+    {
+        return false;
+    }
+
+    const BytecodeAssembly& bytecode = *assembly.mBytecode;
+    //the assembly is copied, the compiler only hands out temporaries. Calls from compiled code
+    //run the callee on the vm with this copy, so they come back through the jit
+    mAssembly = assembly;
+    mAssembly.mJit = this;
+    mVm = vm;
+    mEntryToFunction = PG_NEW_ARRAY(mAllocator, -1, "BsJit", Alloc::PG_MEM_TEMP, int, bytecode.mCodeSize);
+    for (int ip = 0; ip < bytecode.mCodeSize; ++ip)
+    {
+        mEntryToFunction[ip] = -1;
+    }
+
+    mFunctionCount = assembly.mFunBlockMap->Size();
+    if (mFunctionCount > 0)
+    {
+        mFunctions = PG_NEW_ARRAY(mAllocator, -1, "BsJit", Alloc::PG_MEM_TEMP, JitFunction, mFunctionCount);
+    }
+    for (int f = 0; f < mFunctionCount; ++f)
+    {
+        JitFunction& function = mFunctions[f];
+        int block = (*assembly.mFunBlockMap)[f].mAssemblyBlock;
+        function.mEntryIp = block >= 0 && block < bytecode.mBlockCount ? bytecode.mBlockOffsets[block] : -1;
+        function.mCalls.store(0);
+        function.mStatus.store(JIT_INTERPRETED);
+        function.mCode = nullptr;
+        function.mPages = nullptr;
+        function.mPageBytes = 0;
+        if (function.mEntryIp >= 0 && function.mEntryIp < bytecode.mCodeSize)
+        {
+            mEntryToFunction[function.mEntryIp] = f;
+        }
+    }
+    return true;
+}
+
+void BsJit::Reset()
+{
+    for (int f = 0; f < mFunctionCount; ++f)
+    {
+        if (mFunctions[f].mPages != nullptr)
+        {
+            FreeCode(mFunctions[f].mPages, mFunctions[f].mPageBytes);
+        }
+    }
+    if (mFunctions != nullptr)
+    {
+        PG_DELETE_ARRAY(mAllocator, mFunctions);
+        mFunctions = nullptr;
+    }
+    if (mEntryToFunction != nullptr)
+    {
+        PG_DELETE_ARRAY(mAllocator, mEntryToFunction);
+        mEntryToFunction = nullptr;
+    }
+    mFunctionCount = 0;
+    mAssembly = Assembly();
+    mVm = nullptr;
+}
+
+bool BsJit::Run(BsVmState& state, int entryIp, int& returnIp)
+{
+    PG_ASSERT(mAssembly.mBytecode != nullptr && entryIp >= 0 && entryIp < mAssembly.mBytecode->mCodeSize);
+    int f = mEntryToFunction[entryIp];
+    if (f < 0)
+    {
+        return false;
+    }
+
+    JitFunction& function = mFunctions[f];
+    int status = function.mStatus.load(std::memory_order_acquire);
+    if (status == JIT_INTERPRETED && function.mCalls.fetch_add(1, std::memory_order_relaxed) + 1 >= mCallThreshold)
+    {
+        //a single thread compiles, the others keep interpreting until the code is published
+        int expected = JIT_INTERPRETED;
+        if (function.mStatus.compare_exchange_strong(expected, JIT_COMPILING))
+        {
+            status = Compile(function) ? JIT_COMPILED : JIT_REJECTED;
+            function.mStatus.store(status, std::memory_order_release);
+        }
+    }
+    if (status != JIT_COMPILED)
+    {
+        return false;
+    }
+
+    JitContext ctx;
+    ctx.mState = &state;
+    ctx.mAssembly = &mAssembly;
+    ctx.mVm = mVm;
+    ctx.mRegs = state.GetRegBuffer();
+    ctx.mRam = state.Ram();
+    returnIp = function.mCode(&ctx);
+    return true;
+}
+
+int BsJit::GetCompiledCount() const
+{
+    int count = 0;
+    for (int f = 0; f < mFunctionCount; ++f)
+    {
+        count += mFunctions[f].mStatus.load() == JIT_COMPILED ? 1 : 0;
+    }
+    return count;
+}
+
+int BsJit::GetRejectedCount() const
+{
+    int count = 0;
+    for (int f = 0; f < mFunctionCount; ++f)
+    {
+        count += mFunctions[f].mStatus.load() == JIT_REJECTED ? 1 : 0;
+    }
+    return count;
+}
+
+bool BsJit::Compile(JitFunction& function)
+{
+    const BytecodeAssembly& bytecode = *mAssembly.mBytecode;
+    const int* code = bytecode.mCode;
+    int codeSize = bytecode.mCodeSize;
+
+    //the body of a function is what its entry reaches, up to its returns
+    bool* reached = PG_NEW_ARRAY(mAllocator, -1, "BsJit", Alloc::PG_MEM_TEMP, bool, codeSize);
+    int* nativeOffsets = PG_NEW_ARRAY(mAllocator, -1, "BsJit", Alloc::PG_MEM_TEMP, int, codeSize);
+    for (int ip = 0; ip < codeSize; ++ip)
+    {
+        reached[ip] = false;
+        nativeOffsets[ip] = -1;
+    }
+
+    Utils::Vector<int> pending(mAllocator);
+    pending.PushEmpty() = function.mEntryIp;
+    bool supported = true;
+    while (supported && pending.GetSize() > 0)
+    {
+        int ip = pending.Pop();
+        if (ip < 0 || ip >= codeSize)
+        {
+            supported = false;
+        }
+        else if (!reached[ip])
+        {
+            reached[ip] = true;
+            const int* pc = code + ip;
+            supported = IsSupported(pc);
+            if (*pc == OP_JMP)
+            {
+                pending.PushEmpty() = pc[1];
+            }
+            else if (*pc == OP_JMPCOND_I || *pc == OP_JMPCOND_F)
+            {
+                pending.PushEmpty() = pc[3];
+            }
+            int next = GetFallthrough(code, ip);
+            if (next >= 0)
+            {
+                pending.PushEmpty() = next;
+            }
+        }
+    }
+
+    bool compiled = false;
+    if (supported)
+    {
+        //instructions are written in bytecode order, so an instruction falls through to the next one written
+        FunctionCompiler compiler(mAllocator, bytecode);
+        Emitter& e = compiler.GetEmitter();
+        compiler.Prologue();
+        for (int ip = 0; ip < codeSize; ++ip)
+        {
+            if (reached[ip])
+            {
+                nativeOffsets[ip] = e.GetSize();
+                compiler.Translate(ip);
+            }
+        }
+        compiler.Epilogue();
+        compiler.ResolveExits();
+        e.ResolveJumps(nativeOffsets);
+
+        function.mPages = AllocateCode(e.GetCode(), e.GetSize(), function.mPageBytes);
+        function.mCode = reinterpret_cast<JitCode>(function.mPages);
+        compiled = function.mPages != nullptr;
+    }
+
+    PG_DELETE_ARRAY(mAllocator, reached);
+    PG_DELETE_ARRAY(mAllocator, nativeOffsets);
+    return compiled;
+}
+
+#else
+
+using namespace Pegasus;
+using namespace Pegasus::BlockScript;
+
+//without the jit, every function is interpreted
+
+BsJit::BsJit(Alloc::IAllocator* allocator)
+: mAllocator(allocator),
+  mVm(nullptr),
+  mCallThreshold(BS_JIT_DEFAULT_CALL_THRESHOLD),
+  mFunctions(nullptr),
+  mFunctionCount(0),
+  mEntryToFunction(nullptr)
+{
+}
+
+BsJit::~BsJit()
+{
+}
+
+bool BsJit::IsAvailable()
+{
+    return false;
+}
+
+bool BsJit::Initialize(const Assembly& assembly, const BsVm* vm)
+{
+    return false;
+}
+
+void BsJit::Reset()
+{
+}
+
+bool BsJit::Run(BsVmState& state, int entryIp, int& returnIp)
+{
+    return false;
+}
+
+int BsJit::GetCompiledCount() const
+{
+    return 0;
+}
+
+int BsJit::GetRejectedCount() const
+{
+    return 0;
+}
+
+bool BsJit::Compile(JitFunction& function)
+{
+    return false;
+}
+
+#endif
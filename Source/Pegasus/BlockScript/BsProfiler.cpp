@@ -0,0 +1,359 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                       Pegasus                                        */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file   BsProfiler.cpp
+//! \author agent
+//! \date   16th October 2026
+//! \brief  Profiler of the blockscript virtual machine. Counts every bytecode instruction executed,
+//!         and samples the call stack every few instructions to attribute wall time to script
+//!         functions and source lines.
+
+#include "Pegasus/BlockScript/BsProfiler.h"
+#include "Pegasus/BlockScript/BsVm.h"
+#include "Pegasus/BlockScript/BlockScriptAst.h"
+#include "Pegasus/BlockScript/FunDesc.h"
+#include "Pegasus/Allocator/IAllocator.h"
+#include "Pegasus/Allocator/Alloc.h"
+#include "Pegasus/Core/Assertion.h"
+#include "Pegasus/Core/Time.h"
+#include "Pegasus/Utils/Memset.h"
+
+using namespace Pegasus;
+using namespace Pegasus::BlockScript;
+
+static const char* sGlobalName = "<global>";
+
+BsProfiler::BsProfiler(Alloc::IAllocator* allocator)
+:   mAllocator(allocator),
+    mBytecode(nullptr),
+    mCode(nullptr),
+    mCodeSize(0),
+    mFunBlockMap(nullptr),
+    mCounts(nullptr),
+    mTimes(nullptr),
+    mSampleInterval(BS_PROFILER_DEFAULT_SAMPLE_INTERVAL),
+    mCountdown(BS_PROFILER_DEFAULT_SAMPLE_INTERVAL),
+    mSampleCount(0),
+    mRunStart(0.0),
+    mPendingTime(0.0),
+    mSampledTime(0.0),
+    mRunDepth(0),
+    mInstructionCount(0),
+    mStacks(allocator),
+    mFunctions(allocator),
+    mLines(allocator)
+{
+}
+
+BsProfiler::~BsProfiler()
+{
+    FreeCounters();
+}
+
+void BsProfiler::SetSampleInterval(int instructions)
+{
+    PG_ASSERT(instructions > 0);
+    mSampleInterval = instructions;
+    mCountdown = instructions;
+}
+
+void BsProfiler::FreeCounters()
+{
+    if (mCounts != nullptr)
+    {
+        PG_DELETE_ARRAY(mAllocator, mCounts);
+        PG_DELETE_ARRAY(mAllocator, mTimes);
+        mCounts = nullptr;
+        mTimes = nullptr;
+    }
+}
+
+void BsProfiler::Clear()
+{
+    if (mCounts != nullptr)
+    {
+        Utils::Memset8(mCounts, 0, mCodeSize * sizeof(Math::PUInt64));
+        Utils::Memset8(mTimes, 0, mCodeSize * sizeof(double));
+    }
+    mCountdown = mSampleInterval;
+    mSampleCount = 0;
+    mPendingTime = 0.0;
+    mSampledTime = 0.0;
+    mInstructionCount = 0;
+    mStacks.Clear();
+    mFunctions.Clear();
+    mLines.Clear();
+}
+
+void BsProfiler::Reset()
+{
+    PG_ASSERTSTR(mRunDepth == 0, "Cannot reset a profiler while it is recording.");
+    FreeCounters();
+    mBytecode = nullptr;
+    mCode = nullptr;
+    mCodeSize = 0;
+    mFunBlockMap = nullptr;
+    Clear();
+}
+
+void BsProfiler::BeginRun(const Assembly& assembly)
+{
+    PG_ASSERT(assembly.mBytecode != nullptr);
+    const BytecodeAssembly* bytecode = assembly.mBytecode;
+    if (bytecode != mBytecode || bytecode->mCode != mCode || bytecode->mCodeSize != mCodeSize)
+    {
+        PG_ASSERTSTR(mRunDepth == 0, "A profiler can only record one assembly at a time.");
+        //a different assembly, the counters of the previous one are meaningless now
+        FreeCounters();
+        mBytecode = bytecode;
+        mCode = bytecode->mCode;
+        mCodeSize = bytecode->mCodeSize;
+        mCounts = PG_NEW_ARRAY(mAllocator, -1, "BsProfiler", Alloc::PG_MEM_TEMP, Math::PUInt64, mCodeSize);
+        mTimes = PG_NEW_ARRAY(mAllocator, -1, "BsProfiler", Alloc::PG_MEM_TEMP, double, mCodeSize);
+        Clear();
+    }
+    mFunBlockMap = assembly.mFunBlockMap;
+
+    //the clock only runs for the outermost slice, reentrant slices are already being timed
+    if (mRunDepth++ == 0)
+    {
+        Core::UpdatePegasusTime();
+        mRunStart = Core::GetPegasusTime();
+    }
+}
+
+void BsProfiler::EndRun()
+{
+    PG_ASSERT(mRunDepth > 0);
+    if (--mRunDepth == 0)
+    {
+        Core::UpdatePegasusTime();
+        mPendingTime += Core::GetPegasusTime() - mRunStart;
+    }
+}
+
+int BsProfiler::GetFunctionAt(int ip) const
+{
+    //last line entry starting at or before ip
+    const Bytecode::LineEntry* lines = mBytecode->mLines;
+    int lo = 0;
+    int hi = mBytecode->mLineCount - 1;
+    int found = -1;
+    while (lo <= hi)
+    {
+        int mid = (lo + hi) / 2;
+        if (lines[mid].mOffset <= ip)
+        {
+            found = mid;
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid - 1;
+        }
+    }
+    return found == -1 ? -1 : lines[found].mFunction;
+}
+
+void BsProfiler::Sample(int ip, BsVmState& state)
+{
+    mCountdown = mSampleInterval;
+    ++mSampleCount;
+
+    //every sample gets the time run since the previous one
+    Core::UpdatePegasusTime();
+    double now = Core::GetPegasusTime();
+    double elapsed = mPendingTime + (now - mRunStart);
+    mRunStart = now;
+    mPendingTime = 0.0;
+    mSampledTime += elapsed;
+    mTimes[ip] += elapsed;
+
+    //walk the frames, innermost first. Frames entered through OP_CALL hold the return address of
+    //the caller. Other frames (arguments being evaluated, functions called from c++) are skipped.
+    int frames[BS_PROFILER_MAX_STACK_DEPTH];
+    int depth = 0;
+    frames[depth++] = GetFunctionAt(ip);
+    int sbp = state.GetReg(Canon::R_SBP);
+    while (depth < BS_PROFILER_MAX_STACK_DEPTH && sbp >= static_cast<int>(sizeof(FrameInformation)))
+    {
+        const FrameInformation* fi = reinterpret_cast<const FrameInformation*>(state.Ram() + sbp - sizeof(FrameInformation));
+        int returnIp = fi->mIp;
+        if (returnIp >= 2 && returnIp <= mCodeSize && mCode[returnIp - 2] == Bytecode::OP_CALL)
+        {
+            frames[depth++] = GetFunctionAt(returnIp - 2);
+        }
+        sbp = fi->mPreviousSbp;
+    }
+
+    unsigned int hash = 2166136261u;
+    for (int i = 0; i < depth; ++i)
+    {
+        hash = (hash ^ static_cast<unsigned int>(frames[i])) * 16777619u;
+    }
+
+    StackEntry* entry = nullptr;
+    for (unsigned int s = 0; s < mStacks.GetSize() && entry == nullptr; ++s)
+    {
+        StackEntry& candidate = mStacks[s];
+        if (candidate.mHash == hash && candidate.mDepth == depth)
+        {
+            bool equal = true;
+            for (int i = 0; i < depth && equal; ++i)
+            {
+                equal = candidate.mFrames[i] == frames[depth - 1 - i];
+            }
+            entry = equal ? &candidate : nullptr;
+        }
+    }
+
+    if (entry == nullptr)
+    {
+        entry = &mStacks.PushEmpty();
+        entry->mDepth = depth;
+        for (int i = 0; i < depth; ++i)
+        {
+            entry->mFrames[i] = frames[depth - 1 - i];
+        }
+        entry->mSamples = 0;
+        entry->mTime = 0.0;
+        entry->mHash = hash;
+    }
+    ++entry->mSamples;
+    entry->mTime += elapsed;
+}
+
+const char* BsProfiler::GetFunctionName(int function) const
+{
+    if (function < 0 || mFunBlockMap == nullptr || function >= mFunBlockMap->Size())
+    {
+        return sGlobalName;
+    }
+    return (*mFunBlockMap)[function].mFunDesc->GetDec()->GetName();
+}
+
+void BsProfiler::BuildReport()
+{
+    mFunctions.Clear();
+    mLines.Clear();
+    mInstructionCount = 0;
+    if (mBytecode == nullptr)
+    {
+        return;
+    }
+
+    //one entry per function, the global code first
+    int functionCount = mFunBlockMap != nullptr ? mFunBlockMap->Size() : 0;
+    for (int f = -1; f < functionCount; ++f)
+    {
+        FunctionEntry& entry = mFunctions.PushEmpty();
+        entry.mName = GetFunctionName(f);
+        entry.mFunction = f;
+        entry.mCalls = 0;
+        entry.mInstructions = 0;
+        entry.mSelfTime = 0.0;
+        entry.mTotalTime = 0.0;
+    }
+
+    //instructions and self time, walking the runs of the line table
+    const Bytecode::LineEntry* lines = mBytecode->mLines;
+    for (int l = 0; l < mBytecode->mLineCount; ++l)
+    {
+        int end = l + 1 < mBytecode->mLineCount ? lines[l + 1].mOffset : mCodeSize;
+        Math::PUInt64 instructions = 0;
+        double time = 0.0;
+        for (int ip = lines[l].mOffset; ip < end; ++ip)
+        {
+            instructions += mCounts[ip];
+            time += mTimes[ip];
+
+            //only instruction starts have counts, so the opcode can be read safely
+            if (mCounts[ip] != 0 && mCode[ip] == Bytecode::OP_CALL)
+            {
+                mFunctions[GetFunctionAt(mCode[ip + 1]) + 1].mCalls += mCounts[ip];
+            }
+        }
+        if (instructions == 0 && time == 0.0)
+        {
+            continue;
+        }
+
+        FunctionEntry& function = mFunctions[lines[l].mFunction + 1];
+        function.mInstructions += instructions;
+        function.mSelfTime += time;
+        mInstructionCount += instructions;
+
+        //runs of the same line are merged, a line can be split by the blocks of a loop
+        LineEntry* lineEntry = nullptr;
+        for (unsigned int i = 0; i < mLines.GetSize() && lineEntry == nullptr; ++i)
+        {
+            if (mLines[i].mFunction == lines[l].mFunction && mLines[i].mLine == lines[l].mLine + 1)
+            {
+                lineEntry = &mLines[i];
+            }
+        }
+        if (lineEntry == nullptr)
+        {
+            lineEntry = &mLines.PushEmpty();
+            lineEntry->mName = function.mName;
+            lineEntry->mFunction = lines[l].mFunction;
+            lineEntry->mLine = lines[l].mLine + 1;
+            lineEntry->mInstructions = 0;
+            lineEntry->mTime = 0.0;
+        }
+        lineEntry->mInstructions += instructions;
+        lineEntry->mTime += time;
+    }
+
+    //inclusive time, a recursive function is only counted once per stack
+    for (unsigned int s = 0; s < mStacks.GetSize(); ++s)
+    {
+        const StackEntry& stack = mStacks[s];
+        for (int i = 0; i < stack.mDepth; ++i)
+        {
+            bool seen = false;
+            for (int j = 0; j < i && !seen; ++j)
+            {
+                seen = stack.mFrames[j] == stack.mFrames[i];
+            }
+            if (!seen)
+            {
+                mFunctions[stack.mFrames[i] + 1].mTotalTime += stack.mTime;
+            }
+        }
+    }
+
+    //drop the functions never run, then sort both tables by time, then by instructions
+    for (unsigned int f = mFunctions.GetSize(); f-- > 0;)
+    {
+        if (mFunctions[f].mInstructions == 0 && mFunctions[f].mTotalTime == 0.0)
+        {
+            mFunctions.Delete(f);
+        }
+    }
+
+    for (unsigned int i = 1; i < mFunctions.GetSize(); ++i)
+    {
+        FunctionEntry e = mFunctions[i];
+        unsigned int j = i;
+        for (; j > 0 && (mFunctions[j - 1].mSelfTime < e.mSelfTime || (mFunctions[j - 1].mSelfTime == e.mSelfTime && mFunctions[j - 1].mInstructions < e.mInstructions)); --j)
+        {
+            mFunctions[j] = mFunctions[j - 1];
+        }
+        mFunctions[j] = e;
+    }
+
+    for (unsigned int i = 1; i < mLines.GetSize(); ++i)
+    {
+        LineEntry e = mLines[i];
+        unsigned int j = i;
+        for (; j > 0 && (mLines[j - 1].mTime < e.mTime || (mLines[j - 1].mTime == e.mTime && mLines[j - 1].mInstructions < e.mInstructions)); --j)
+        {
+            mLines[j] = mLines[j - 1];
+        }
+        mLines[j] = e;
+    }
+}
@@ -26,26 +26,28 @@
 #include "Pegasus/BlockScript/ExpressionEngine.h"
 #include "Pegasus/Math/Vector.h"
 
+#if PEGASUS_PLATFORM_LINUX
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 #ifndef BLOCKSCRIPT_SAFEMODE
 #define BLOCKSCRIPT_SAFEMODE 0
 #endif
 
 #define BS_VM_PAGE_SIZE 512
 
+//address space reserved for the stack of a state on linux. Only the bytes in use are accessible,
+//the rest of the range is kept as guard pages, so any access past the end of the stack faults
+#define BS_VM_RAM_RESERVE_BYTESIZE (16 * 1024 * 1024)
+
+//number of jumps executed by the bytecode interpreter between execution state checks
+#define BS_VM_BYTECODE_SLICE 4096
+
 using namespace Pegasus;
 using namespace Pegasus::BlockScript;
 using namespace Pegasus::BlockScript::Canon;
 
-#define SENTINEL 3939
-
-struct FrameInformation
-{
-    int mPreviousSbp;
-    int mIp; //current ip saved
-    int mB; //current b saved
-    int mSentinel;
-};
-
 //******************************************************//
 // **************     the commands      ****************//
 //******************************************************//
@@ -59,16 +61,9 @@ int GetIddOffset(Ast::Idd* idd, BsVmState& state)
     }
     else
     {
-        int frames = idd->GetFrameOffset();
-        int sbp = state.GetReg(R_SBP);
-        while (frames-- > 0)
-        {
-            FrameInformation * fi = reinterpret_cast<FrameInformation*>(state.Ram() + sbp - sizeof(FrameInformation));
-            PG_ASSERTSTR(fi->mSentinel == SENTINEL,"Memory corruption in stack!!");
-
-            sbp = fi->mPreviousSbp;
-        }
-        return sbp + idd->GetOffset();
+        //block frames are flattened by the compiler, locals always live in the current frame
+        PG_ASSERTSTR(idd->GetFrameOffset() == 0, "Frame offsets must be resolved at compile time!");
+        return state.GetReg(R_SBP) + idd->GetOffset();
     }
 }
 
@@ -89,10 +84,10 @@ int GetMemoryOffset(Ast::Exp* mem, BsVmState& state)
         );
 
         Ast::Binop* binop = static_cast<Ast::Binop*>(mem);
-        offset = gIntExpEngine.Eval(binop->GetRhs(), state);
+        offset = ExpressionEngine_Int::Eval(binop->GetRhs(), state);
 #if BLOCKSCRIPT_SAFEMODE
         //in safe mode, check if we are trying to access an array out of bounds
-        if (offset >= binop->GetLhs()->GetTypeDesc()->GetByteSize())
+        if (!binop->IsIndexInRange() && offset >= binop->GetLhs()->GetTypeDesc()->GetByteSize())
         {
             if (state.GetRuntimeListener() != nullptr)
             {
@@ -123,10 +118,13 @@ void SaveExpression(void* location, Ast::Exp* exp, BsVmState& state)
         switch(expType->GetAluEngine())
         {
         case TypeDesc::E_INT:
-            *mem = gIntExpEngine.Eval(exp, state);
+            *mem = ExpressionEngine_Int::Eval(exp, state);
             break;
         case TypeDesc::E_FLOAT:
-            *mem = reinterpret_cast<int&>(gFloatExpEngine.Eval(exp, state));
+            {
+                float f = ExpressionEngine_Float::Eval(exp, state);
+                *mem = reinterpret_cast<int&>(f);
+            }
             break;
         default:
             PG_FAILSTR("unknown ALU engine for expression.");
@@ -137,22 +135,22 @@ void SaveExpression(void* location, Ast::Exp* exp, BsVmState& state)
         switch(expType->GetAluEngine())
         {
         case TypeDesc::E_MATRIX4x4:
-            *reinterpret_cast<Math::Mat44*>(location) = gMat44ExpEngine.Eval(exp, state);
+            *reinterpret_cast<Math::Mat44*>(location) = ExpressionEngine_Mat44::Eval(exp, state);
             break;
         case TypeDesc::E_MATRIX3x3:
-            *reinterpret_cast<Math::Mat33*>(location) = gMat33ExpEngine.Eval(exp, state);
+            *reinterpret_cast<Math::Mat33*>(location) = ExpressionEngine_Mat33::Eval(exp, state);
             break;
         case TypeDesc::E_MATRIX2x2:
-            *reinterpret_cast<Math::Mat22*>(location) = gMat22ExpEngine.Eval(exp, state);
+            *reinterpret_cast<Math::Mat22*>(location) = ExpressionEngine_Mat22::Eval(exp, state);
             break;
         case TypeDesc::E_FLOAT4:
-            *reinterpret_cast<Math::Vec4*>(location) = gFloat4ExpEngine.Eval(exp, state);
+            *reinterpret_cast<Math::Vec4*>(location) = ExpressionEngine_Float4::Eval(exp, state);
             break;
         case TypeDesc::E_FLOAT3:
-            *reinterpret_cast<Math::Vec3*>(location) = gFloat3ExpEngine.Eval(exp, state);
+            *reinterpret_cast<Math::Vec3*>(location) = ExpressionEngine_Float3::Eval(exp, state);
             break;
         case TypeDesc::E_FLOAT2:
-            *reinterpret_cast<Math::Vec2*>(location) = gFloat2ExpEngine.Eval(exp, state);
+            *reinterpret_cast<Math::Vec2*>(location) = ExpressionEngine_Float2::Eval(exp, state);
             break;
         default:
             PG_FAILSTR("unknown ALU engine for expression.");
@@ -178,14 +176,14 @@ void SaveExpression(void* location, Ast::Exp* exp, BsVmState& state)
 
             Ast::Binop* rhs = static_cast<Ast::Binop*>(exp);
             Ast::Idd* arrayIdd = static_cast<Ast::Idd*>(rhs->GetLhs());
-            int offset = gIntExpEngine.Eval(rhs->GetRhs(), state);
+            int offset = ExpressionEngine_Int::Eval(rhs->GetRhs(), state);
             target = reinterpret_cast<int*>(reinterpret_cast<char*>(GetIddMem(arrayIdd, state)) + offset);
         }
         Pegasus::Utils::Memcpy(location, target, exp->GetTypeDesc()->GetByteSize());
     }
     else if (expType->GetModifier() == TypeDesc::M_REFERECE || expType->GetModifier() == TypeDesc::M_ENUM || expType->GetModifier() == TypeDesc::M_STAR)
     {
-        int val = gIntExpEngine.Eval(exp, state);
+        int val = ExpressionEngine_Int::Eval(exp, state);
         *(reinterpret_cast<int*>(location)) = val;
     }
     else
@@ -200,13 +198,13 @@ int EvalJmpCond(Ast::Exp* exp, BsVmState& state)
     {
     case TypeDesc::E_INT:
         {
-            int v = gIntExpEngine.Eval(exp, state);
+            int v = ExpressionEngine_Int::Eval(exp, state);
             return v;
         }
         break;
     case TypeDesc::E_FLOAT:
         {
-            float f = gFloatExpEngine.Eval(exp, state);
+            float f = ExpressionEngine_Float::Eval(exp, state);
             return f != 0.0 ? 1 : 0;
         }
     }
@@ -321,7 +319,13 @@ void PushFrameCommand(const StackFrameInfo* info, BsVmState& state, const Contai
 {
     if (state.GetStackLevels() >= 0)
     {
-        FrameInformation fi = { state.GetReg(R_SBP), state.GetReg(R_IP), state.GetReg(R_B),  SENTINEL};
+        FrameInformation fi;
+        fi.mPreviousSbp = state.GetReg(R_SBP);
+        fi.mIp = state.GetReg(R_IP);
+        fi.mB = state.GetReg(R_B);
+#if PEGASUS_ENABLE_ASSERT
+        fi.mSentinel = SENTINEL;
+#endif
         state.Grow(info->GetTotalFrameSize() + sizeof(FrameInformation));        
         FrameInformation* currFrameInfo = reinterpret_cast<FrameInformation*>(state.Ram() + state.GetReg(R_ESP));
         *currFrameInfo = fi;
@@ -355,12 +359,64 @@ void FunRetCommand(BsVmState& state)
     PopFrameCommand(state);
 }
 
+void NativeCallCommand(const Ast::FunCall* fc, int argumentBytes, BsVmState& state)
+{
+    //the arguments have been written to the native argument buffer, no frame is pushed
+    const FunDesc* funDesc = fc->GetDesc();
+    char* args = state.PushNativeArgs(argumentBytes);
+    if (args == nullptr)
+    {
+        PG_LOG('ERR_', "[BLOCKSCRIPT VIRUAL MACHINE ERROR]: Native calls nested too deep.");
+        if (state.GetRuntimeListener() != nullptr)
+        {
+            CrashInfo crashInfo;
+            state.GetRuntimeListener()->OnCrash(state, crashInfo);
+        }
+        state.SetExecutionState(Pegasus::BlockScript::BsVmState::Crashed);
+        return;
+    }
+
+    int outputBufferSize = fc->GetTypeDesc()->GetByteSize();
+    void* outputBuffer = outputBufferSize > CANON_REGISTER_BYTESIZE
+            ? static_cast<void*>(state.Ram() + state.GetReg(R_RET))
+            : static_cast<void*>(state.GetRegBuffer() + R_RET);
+
+    FunCallbackContext ctx(
+        &state,
+        funDesc,
+        fc->GetArgs(),
+        args,
+        argumentBytes,
+        outputBuffer,
+        outputBufferSize
+    );
+    funDesc->GetCallback()(ctx);
+    state.PopNativeArgs(argumentBytes);
+}
+
 void FunGoCommand(Canon::FunGo* fungo, BsVmState& state)
 {
     Ast::FunCall* fc = fungo->GetFunCall(); 
     const FunDesc* funDesc = fc->GetDesc();
     const Ast::StmtFunDec* funDec = funDesc->GetDec();
 
+    if (funDesc->IsCallback() && funDesc->GetInputArgumentsByteSize() <= BS_VM_NATIVE_CALL_MAX_ARGS_BYTESIZE)
+    {
+        //native fast path: arguments are evaluated in the callers frame straight into the native argument buffer
+        char* args = state.GetNativeArgs();
+        int byteOffset = 0;
+        Ast::ExpList * tail = fc->GetArgs();
+        while (tail != nullptr && tail->GetExp() != nullptr)
+        {
+            SaveExpression(args + byteOffset, tail->GetExp(), state);
+            byteOffset += tail->GetExp()->GetTypeDesc()->GetByteSize();
+            tail = tail->GetTail();
+        }
+        NativeCallCommand(fc, byteOffset, state);
+        state.SetReg(R_IP, state.GetReg(R_IP) + 1);
+        return;
+    }
+
     //all expressions run relative to the callers stack, so lets save this stack pointer
     int expressionStack = state.GetReg(R_SBP);
     
@@ -461,22 +517,37 @@ void CastCmd(Canon::Cast* cast, BsVmState& state)
 BsVmState::BsVmState()
 :
     mRam(nullptr),
+    mRamBlock(nullptr),
     mRamSize(0),
     mRamCount(0),
+    mRamReservedCount(0),
+    mStackGrowCount(0),
+    mNativeArgs(nullptr),
+    mNativeArgsTop(0),
     mAllocator(nullptr),
     mStackLevels(-1),
     mUserContext(nullptr),
     mRuntimeListener(nullptr),
-    mExecutionState(BsVmState::Alive)
+    mProfiler(nullptr),
+    mExecutionState(BsVmState::Alive),
+    mIsSuspendedByCallback(false),
+    mResumeStackLevel(-1),
+    mResumeIp(0),
+    mResumeOutputByteSize(0)
 {
     Reset();
 }
 
-void BsVmState::Initialize(Alloc::IAllocator* allocator)
+void BsVmState::Initialize(Alloc::IAllocator* allocator, int stackByteSize)
 {
     mAllocator = allocator;
     mHeapContainer.Initialize(allocator);
-    Grow(BS_VM_PAGE_SIZE); // try to grow 512 bytes initially
+    if (mNativeArgs == nullptr)
+    {
+        //the slack lets the deepest native call write a full argument list
+        mNativeArgs = PG_NEW_ARRAY(mAllocator, -1, "BS VM NATIVE ARGS", Alloc::PG_MEM_TEMP, char, BS_VM_NATIVE_ARGS_BYTESIZE + BS_VM_NATIVE_CALL_MAX_ARGS_BYTESIZE);
+    }
+    Reserve(stackByteSize > BS_VM_PAGE_SIZE ? stackByteSize : BS_VM_PAGE_SIZE);
     mRamSize = 0; //reset ram, and keep the page open.
     mStackLevels = -1; //-1 means no stack has been set
     mExecutionState = BsVmState::Alive;
@@ -485,7 +556,12 @@ void BsVmState::Initialize(Alloc::IAllocator* allocator)
 void BsVmState::Reset()
 {
     mExecutionState = BsVmState::Alive;
+    mIsSuspendedByCallback = false;
+    mResumeStackLevel = -1;
+    mResumeIp = 0;
+    mResumeOutputByteSize = 0;
     mRamSize = 0;
+    mNativeArgsTop = 0;
     mStackLevels = -1; //-1 means no stack has been set
     for (int i = 0; i < static_cast<int>(Canon::R_COUNT); ++i)
     {
@@ -494,20 +570,23 @@ void BsVmState::Reset()
     mHeapContainer.Reset();
 }
 
+void BsVmState::Reserve(int byteCount)
+{
+    if (byteCount > mRamCount)
+    {
+        CommitRam(byteCount);
+    }
+}
+
 void BsVmState::Grow(int byteCount)
 {
     int newRamSize = mRamSize + byteCount;
-    if (newRamSize >= mRamCount)
+    if (newRamSize > mRamCount)
     {
-        char* oldRam = mRam;
-        int newCount = mRamSize + (1 + (byteCount / BS_VM_PAGE_SIZE)) * BS_VM_PAGE_SIZE;
-        mRam = PG_NEW_ARRAY(mAllocator, -1, "BS VM RAM", Alloc::PG_MEM_TEMP, char, newCount);
-        if (oldRam != nullptr)
-        {
-            Utils::Memcpy(mRam, oldRam, mRamCount);
-            PG_DELETE_ARRAY(mAllocator, oldRam);
-        }
-        mRamCount = newCount;
+        //past the reserved size: only recursion gets here once the stack size of the assembly is reserved.
+        //Grow geometrically, so deep recursion does not move the stack on every call
+        ++mStackGrowCount;
+        CommitRam(newRamSize > 2 * mRamCount ? newRamSize : 2 * mRamCount);
     }
     mRamSize = newRamSize;
 }
@@ -518,23 +597,192 @@ void BsVmState::Shrink(int byteCount)
     PG_ASSERT(mRamSize >= 0);
 }
 
-BsVmState::~BsVmState()
+#if PEGASUS_PLATFORM_LINUX
+
+//! Reserves a range of address space for the stack, and makes its first bytes accessible
+//! \param reservedCount the size of the range
+//! \param committedCount the bytes made accessible, a multiple of the page size
+//! \return the range, page aligned, null if it could not be mapped
+static char* MapRam(int reservedCount, int committedCount)
+{
+    void* range = mmap(nullptr, reservedCount, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (range == MAP_FAILED)
+    {
+        return nullptr;
+    }
+    if (mprotect(range, committedCount, PROT_READ | PROT_WRITE) != 0)
+    {
+        munmap(range, reservedCount);
+        return nullptr;
+    }
+    return static_cast<char*>(range);
+}
+
+#endif
+
+void BsVmState::CommitRam(int byteCount)
 {
+#if PEGASUS_PLATFORM_LINUX
+    //a stack already moved to the allocator (mRamReservedCount is 0) stays there
+    if (mRamBlock == nullptr || mRamReservedCount > 0)
+    {
+        const int pageSize = static_cast<int>(sysconf(_SC_PAGESIZE));
+        int newCount = (byteCount + pageSize - 1) & ~(pageSize - 1);
+
+        //extend in place, keeping at least one inaccessible page past the end of the stack
+        if (mRamBlock != nullptr && newCount + pageSize <= mRamReservedCount &&
+            mprotect(mRamBlock + mRamCount, newCount - mRamCount, PROT_READ | PROT_WRITE) == 0)
+        {
+            mRamCount = newCount;
+            return;
+        }
+
+        //the reserved range is exhausted, move the stack to a bigger one
+        int reservedCount = newCount * 2 > BS_VM_RAM_RESERVE_BYTESIZE ? newCount * 2 : BS_VM_RAM_RESERVE_BYTESIZE;
+        char* newRam = MapRam(reservedCount, newCount); //page aligned, so aligned to the frame slots
+        if (newRam != nullptr)
+        {
+            if (mRam != nullptr)
+            {
+                Utils::Memcpy(newRam, mRam, mRamCount);
+                FreeRam();
+            }
+            mRamBlock = newRam;
+            mRam = newRam;
+            mRamReservedCount = reservedCount;
+            mRamCount = newCount;
+            return;
+        }
+
+        PG_LOG('ERR_', "[BLOCKSCRIPT VIRUAL MACHINE ERROR]: Could not map %d bytes for the stack, allocating it instead.", reservedCount);
+    }
+#endif
+
+    int newCount = (byteCount + BS_VM_PAGE_SIZE - 1) & ~(BS_VM_PAGE_SIZE - 1);
+
+    //align the base by hand, so the aligned stack slots are aligned in memory with any allocator
+    const size_t alignMask = StackFrameInfo::sSlotAlignment - 1;
+    char* newBlock = PG_NEW_ARRAY(mAllocator, -1, "BS VM RAM", Alloc::PG_MEM_TEMP, char, newCount + StackFrameInfo::sSlotAlignment - 1);
+    char* newRam = reinterpret_cast<char*>((reinterpret_cast<size_t>(newBlock) + alignMask) & ~alignMask);
     if (mRam != nullptr)
     {
-        PG_DELETE_ARRAY(mAllocator, mRam);
+        Utils::Memcpy(newRam, mRam, mRamCount);
+        FreeRam();
+    }
+    mRamBlock = newBlock;
+    mRam = newRam;
+    mRamCount = newCount;
+}
+
+void BsVmState::FreeRam()
+{
+    if (mRamBlock == nullptr)
+    {
+        return;
+    }
+
+#if PEGASUS_PLATFORM_LINUX
+    if (mRamReservedCount > 0)
+    {
+        munmap(mRamBlock, mRamReservedCount);
+    }
+    else
+#endif
+    {
+        PG_DELETE_ARRAY(mAllocator, mRamBlock);
+    }
+    mRamBlock = nullptr;
+    mRam = nullptr;
+    mRamReservedCount = 0;
+}
+
+char* BsVmState::PushNativeArgs(int byteCount)
+{
+    PG_ASSERT(byteCount <= BS_VM_NATIVE_CALL_MAX_ARGS_BYTESIZE);
+    if (mNativeArgsTop + byteCount > BS_VM_NATIVE_ARGS_BYTESIZE)
+    {
+        return nullptr;
     }
+    char* args = mNativeArgs + mNativeArgsTop;
+    mNativeArgsTop += byteCount;
+    return args;
 }
 
-void BsVm::Run(const Assembly& assembly, BsVmState& state) const
+BsVmState::~BsVmState()
+{
+    FreeRam();
+    if (mNativeArgs != nullptr)
+    {
+        PG_DELETE_ARRAY(mAllocator, mNativeArgs);
+    }
+}
+
+bool BsVm::UsesBytecode(const Assembly& assembly) const
+{
+    //assemblies loaded from the cache have no canonical tree, so they always run the bytecode
+    return assembly.mBytecode != nullptr && (mBackend != BACKEND_CANON || assembly.mBlocks == nullptr);
+}
+
+void BsVm::Run(const Assembly& assembly, BsVmState& state, int budget) const
 {
     PG_ASSERT(state.GetExecutionState() == BsVmState::Alive);
     state.Reset();
+    state.Reserve(assembly.mStackByteSize);
     if (state.GetRuntimeListener() != nullptr)
     {
         state.GetRuntimeListener()->OnRuntimeBegin(state);
     }
-    while (StepExecution(assembly, state) && state.GetExecutionState() == BsVmState::Alive);
+
+    state.SetResumeInfo(-1, 0, 0);
+    Continue(assembly, state, budget);
+}
+
+void BsVm::Resume(const Assembly& assembly, BsVmState& state, int budget) const
+{
+    PG_ASSERT(state.GetExecutionState() == BsVmState::Suspended);
+    state.SetExecutionState(BsVmState::Alive);
+    Continue(assembly, state, budget);
+}
+
+void BsVm::Continue(const Assembly& assembly, BsVmState& state, int budget) const
+{
+    int exitStackLevel = state.GetResumeStackLevel();
+    while (state.GetExecutionState() == BsVmState::Alive)
+    {
+        int slice = budget < 0 || budget > BS_VM_BYTECODE_SLICE ? BS_VM_BYTECODE_SLICE : budget;
+        if (!RunSlice(assembly, state, exitStackLevel, slice))
+        {
+            return;
+        }
+        if (budget >= 0 && (budget -= slice) <= 0)
+        {
+            //the registers point to the next instruction, resuming picks it up from there
+            state.SetExecutionState(BsVmState::Suspended);
+        }
+    }
+}
+
+bool BsVm::RunSlice(const Assembly& assembly, BsVmState& state, int exitStackLevel, int budget) const
+{
+    if (UsesBytecode(assembly))
+    {
+        return RunBytecode(assembly, state, exitStackLevel, budget);
+    }
+
+    //the canonical tree counts the changes of block as jumps / calls. A run of the global scope stops on its exit
+    while (state.GetExecutionState() == BsVmState::Alive)
+    {
+        int block = state.mR[R_B];
+        if (!StepExecution(assembly, state) || (exitStackLevel >= 0 && state.GetStackLevels() == exitStackLevel))
+        {
+            return false;
+        }
+        if (state.mR[R_B] != block && --budget <= 0)
+        {
+            return true;
+        }
+    }
+    return false;
 }
 
 bool BsVm::StepExecution(const Assembly& assembly, BsVmState& state) const
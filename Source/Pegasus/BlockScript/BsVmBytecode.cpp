@@ -0,0 +1,570 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                       Pegasus                                        */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file   BsVmBytecode.cpp
+//! \author agent
+//! \date   16th October 2026
+//! \brief  Pegasus blockscript virtual machine, bytecode interpreter loop
+
+#include "Pegasus/BlockScript/Canonizer.h"
+#include "Pegasus/BlockScript/BsVm.h"
+#include "Pegasus/BlockScript/BsAot.h"
+#include "Pegasus/BlockScript/BsJit.h"
+#include "Pegasus/BlockScript/BsProfiler.h"
+#include "Pegasus/BlockScript/BlockScriptAst.h"
+#include "Pegasus/BlockScript/StackFrameInfo.h"
+#include "Pegasus/BlockScript/FunDesc.h"
+#include "Pegasus/BlockScript/TypeDesc.h"
+#include "Pegasus/BlockScript/FunCallback.h"
+#include "Pegasus/BlockScript/EventListeners.h"
+#include "Pegasus/BlockScript/BsSimd.h"
+#include "Pegasus/Core/Assertion.h"
+#include "Pegasus/Core/Log.h"
+#include "Pegasus/Utils/Memcpy.h"
+#include "Pegasus/Math/Vector.h"
+#include "Pegasus/Math/Matrix.h"
+
+//when set, every instruction handler jumps straight to the handler of the next instruction through a
+//table of label addresses (computed goto, a gcc / clang extension). Otherwise the interpreter loops on a switch
+#ifndef BLOCKSCRIPT_COMPUTED_GOTO
+#if defined(__GNUC__) || defined(__clang__)
+#define BLOCKSCRIPT_COMPUTED_GOTO 1
+#else
+#define BLOCKSCRIPT_COMPUTED_GOTO 0
+#endif
+#endif
+
+using namespace Pegasus;
+using namespace Pegasus::BlockScript;
+using namespace Pegasus::BlockScript::Bytecode;
+using namespace Pegasus::BlockScript::Canon;
+
+using Aot::ScratchRegister;
+using Aot::ResolveAddr;
+using Aot::As;
+
+//instruction checks done before every dispatch
+#define BC_CHECK_INSTRUCTION \
+    PG_ASSERT(pc >= code && pc < code + bytecode.mCodeSize && *pc >= 0 && *pc < OP_COUNT); \
+    if (PROFILE && profiler->Count(static_cast<int>(pc - code))) \
+    { \
+        profiler->Sample(static_cast<int>(pc - code), state); \
+    }
+
+#if BLOCKSCRIPT_COMPUTED_GOTO
+#define BC_CASE(OPCODE) L_##OPCODE:
+#define BC_NEXT BC_CHECK_INSTRUCTION goto *sHandlers[*pc]
+#else
+#define BC_CASE(OPCODE) case OPCODE:
+#define BC_NEXT break
+#endif
+
+#define BC_ALU_OP(OPCODE, TYPE, EXPR) \
+    BC_CASE(OPCODE) \
+        { \
+            TYPE r1 = As<TYPE>(s[pc[2]]); \
+            TYPE r2 = As<TYPE>(s[pc[3]]); \
+            As<TYPE>(s[pc[1]]) = EXPR; \
+            pc += 4; \
+        } \
+        BC_NEXT;
+
+#define BC_CMP_OP(OPCODE, TYPE, EXPR) \
+    BC_CASE(OPCODE) \
+        { \
+            TYPE r1 = As<TYPE>(s[pc[2]]); \
+            TYPE r2 = As<TYPE>(s[pc[3]]); \
+            As<TYPE>(s[pc[1]]) = static_cast<TYPE>(EXPR); \
+            pc += 4; \
+        } \
+        BC_NEXT;
+
+#define BC_DOT_OP(OPCODE, LANES) \
+    BC_CASE(OPCODE) \
+        s[pc[1]].f[0] = Simd::Dot<LANES>(s[pc[2]].f, s[pc[3]].f); \
+        pc += 4; \
+        BC_NEXT;
+
+#define BC_LERP_OP(OPCODE, TYPE) \
+    BC_CASE(OPCODE) \
+        { \
+            TYPE r = Math::Lerp(As<TYPE>(s[pc[2]]), As<TYPE>(s[pc[3]]), s[pc[4]].f[0]); \
+            As<TYPE>(s[pc[1]]) = r; \
+            pc += 5; \
+        } \
+        BC_NEXT;
+
+#define BC_SIMD_OP(OPCODE, KERNEL) \
+    BC_CASE(OPCODE) \
+        KERNEL(s[pc[1]].f, s[pc[2]].f, s[pc[3]].f); \
+        pc += 4; \
+        BC_NEXT;
+
+#define BC_MUL_OP(OPCODE, TYPE, MAT, MULF) \
+    BC_CASE(OPCODE) \
+        { \
+            TYPE r; \
+            MULF(r, As<MAT>(s[pc[2]]), As<TYPE>(s[pc[3]])); \
+            As<TYPE>(s[pc[1]]) = r; \
+            pc += 4; \
+        } \
+        BC_NEXT;
+
+//vector and matrix operations, QUADS is the number of 4 float groups the type takes
+#define BC_VEC_OPS(SUFFIX, QUADS) \
+    BC_SIMD_OP(OP_ADD_##SUFFIX, Simd::Add<QUADS>) \
+    BC_SIMD_OP(OP_SUB_##SUFFIX, Simd::Sub<QUADS>) \
+    BC_SIMD_OP(OP_MUL_##SUFFIX, Simd::Mul<QUADS>) \
+    BC_SIMD_OP(OP_DIV_##SUFFIX, Simd::Div<QUADS>) \
+    BC_CASE(OP_NEG_##SUFFIX) \
+        Simd::Neg<QUADS>(s[pc[1]].f, s[pc[2]].f); \
+        pc += 3; \
+        BC_NEXT; \
+    BC_CASE(OP_FMA_##SUFFIX) \
+        Simd::MulAdd<QUADS>(s[pc[1]].f, s[pc[2]].f, s[pc[3]].f, s[pc[4]].f); \
+        pc += 5; \
+        BC_NEXT;
+
+namespace
+{
+
+//! the interpreter loop. Profiling is a template argument, so the loop run without a profiler has no extra work.
+//! Calls run compiled through the jit if one is passed.
+template<bool PROFILE>
+bool RunBytecodeLoop(const Assembly& assembly, BsVmState& state, int exitStackLevel, int budget, BsProfiler* profiler, BsJit* jit)
+{
+    PG_ASSERT(assembly.mBytecode != nullptr);
+    PG_ASSERT(state.GetExecutionState() == BsVmState::Alive);
+
+    const BytecodeAssembly& bytecode = *assembly.mBytecode;
+    const int* code = bytecode.mCode;
+    const void* const* constants = bytecode.mConstants;
+    const int* pc = code + state.GetReg(R_IP);
+    ScratchRegister s[BYTECODE_SCRATCH_REGISTER_COUNT];
+
+#if BLOCKSCRIPT_COMPUTED_GOTO
+    //handler of every opcode, in the order of the OpCode enumeration
+    static const void* const sHandlers[OP_COUNT] = {
+        &&L_OP_EXIT, &&L_OP_JMP, &&L_OP_JMPCOND_I, &&L_OP_JMPCOND_F,
+        &&L_OP_PUSHFRAME, &&L_OP_POPFRAME, &&L_OP_CALL, &&L_OP_CALLBACK,
+        &&L_OP_NATIVE, &&L_OP_RET, &&L_OP_SAVE, &&L_OP_GETR,
+        &&L_OP_SETR, &&L_OP_SAVE_TO_ADDR, &&L_OP_CAST_ITOF, &&L_OP_CAST_FTOI,
+        &&L_OP_LEA, &&L_OP_LEAX, &&L_OP_LEAXU, &&L_OP_LD4, &&L_OP_LD,
+        &&L_OP_LDX, &&L_OP_ST4, &&L_OP_ST, &&L_OP_STI,
+        &&L_OP_IMM, &&L_OP_COPY, &&L_OP_COPY_I, &&L_OP_COPY_II,
+        &&L_OP_ISDH, &&L_OP_READ_PROP, &&L_OP_WRITE_PROP, &&L_OP_NST,
+        &&L_OP_NCOPY, &&L_OP_ADD_I, &&L_OP_SUB_I, &&L_OP_MUL_I,
+        &&L_OP_DIV_I, &&L_OP_MOD_I, &&L_OP_EQ_I, &&L_OP_NEQ_I,
+        &&L_OP_GT_I, &&L_OP_LT_I, &&L_OP_GTE_I, &&L_OP_LTE_I,
+        &&L_OP_LAND_I, &&L_OP_LOR_I, &&L_OP_ADD_F, &&L_OP_SUB_F,
+        &&L_OP_MUL_F, &&L_OP_DIV_F, &&L_OP_EQ_F, &&L_OP_NEQ_F,
+        &&L_OP_GT_F, &&L_OP_LT_F, &&L_OP_GTE_F, &&L_OP_LTE_F,
+        &&L_OP_LAND_F, &&L_OP_LOR_F, &&L_OP_ADD_F2, &&L_OP_SUB_F2,
+        &&L_OP_MUL_F2, &&L_OP_DIV_F2, &&L_OP_ADD_F3, &&L_OP_SUB_F3,
+        &&L_OP_MUL_F3, &&L_OP_DIV_F3, &&L_OP_ADD_F4, &&L_OP_SUB_F4,
+        &&L_OP_MUL_F4, &&L_OP_DIV_F4, &&L_OP_ADD_M22, &&L_OP_SUB_M22,
+        &&L_OP_MUL_M22, &&L_OP_DIV_M22, &&L_OP_ADD_M33, &&L_OP_SUB_M33,
+        &&L_OP_MUL_M33, &&L_OP_DIV_M33, &&L_OP_ADD_M44, &&L_OP_SUB_M44,
+        &&L_OP_MUL_M44, &&L_OP_DIV_M44, &&L_OP_NEG_I, &&L_OP_NEG_F,
+        &&L_OP_NEG_F2, &&L_OP_NEG_F3, &&L_OP_NEG_F4, &&L_OP_NEG_M22,
+        &&L_OP_NEG_M33, &&L_OP_NEG_M44, &&L_OP_FMA_F, &&L_OP_FMA_F2,
+        &&L_OP_FMA_F3, &&L_OP_FMA_F4, &&L_OP_FMA_M22, &&L_OP_FMA_M33,
+        &&L_OP_FMA_M44, &&L_OP_ITOF, &&L_OP_PACK, &&L_OP_SPLAT,
+        &&L_OP_DOT_F2, &&L_OP_DOT_F3, &&L_OP_DOT_F4, &&L_OP_CROSS_F3,
+        &&L_OP_LERP_F, &&L_OP_LERP_F2, &&L_OP_LERP_F3, &&L_OP_LERP_F4,
+        &&L_OP_MUL_M22_F2, &&L_OP_MUL_M33_F3, &&L_OP_MUL_M44_F4, &&L_OP_MUL_M44_M44,
+        &&L_OP_SIN, &&L_OP_COS
+    };
+
+    BC_NEXT;
+    {
+        {
+#else
+    for (;;)
+    {
+        BC_CHECK_INSTRUCTION
+        switch (*pc)
+        {
+#endif
+        BC_CASE(OP_EXIT)
+            state.SetReg(R_IP, static_cast<int>(pc - code));
+            Aot::Exit(state);
+            return false;
+        BC_CASE(OP_JMP)
+            pc = code + pc[1];
+            if (--budget <= 0)
+            {
+                state.SetReg(R_IP, static_cast<int>(pc - code));
+                return true;
+            }
+            BC_NEXT;
+        BC_CASE(OP_JMPCOND_I)
+        BC_CASE(OP_JMPCOND_F)
+            {
+                int v = *pc == OP_JMPCOND_I ? s[pc[1]].i[0] : (s[pc[1]].f[0] != 0.0 ? 1 : 0);
+                if (v == pc[2])
+                {
+                    pc = code + pc[3];
+                    if (--budget <= 0)
+                    {
+                        state.SetReg(R_IP, static_cast<int>(pc - code));
+                        return true;
+                    }
+                }
+                else
+                {
+                    pc += 4;
+                }
+            }
+            BC_NEXT;
+        BC_CASE(OP_PUSHFRAME)
+            state.SetReg(R_IP, static_cast<int>(pc - code));
+            Aot::PushFrame(assembly, state, static_cast<const StackFrameInfo*>(constants[pc[1]]));
+            pc += 2;
+            BC_NEXT;
+        BC_CASE(OP_POPFRAME)
+            Aot::PopFrame(state);
+            pc += 1;
+            BC_NEXT;
+        BC_CASE(OP_CALL)
+            {
+                //the frame has been pushed already, store the return address on it
+                Aot::SetReturnIp(state, static_cast<int>(pc - code) + 2);
+#if BLOCKSCRIPT_JIT_X64
+                int returnIp = 0;
+                if (jit != nullptr && jit->Run(state, pc[1], returnIp))
+                {
+                    if (state.GetExecutionState() != BsVmState::Alive || state.GetStackLevels() == exitStackLevel)
+                    {
+                        return false;
+                    }
+                    pc = code + returnIp;
+                    BC_NEXT;
+                }
+#endif
+                pc = code + pc[1];
+                if (--budget <= 0)
+                {
+                    state.SetReg(R_IP, static_cast<int>(pc - code));
+                    return true;
+                }
+            }
+            BC_NEXT;
+        BC_CASE(OP_CALLBACK)
+            state.SetReg(R_IP, static_cast<int>(pc - code));
+            Aot::Callback(state, static_cast<const Ast::FunCall*>(constants[pc[1]]), pc[2]);
+            pc += 3;
+            if (state.GetExecutionState() != BsVmState::Alive)
+            {
+                state.SetReg(R_IP, static_cast<int>(pc - code));
+                return false;
+            }
+            BC_NEXT;
+        BC_CASE(OP_NATIVE)
+            state.SetReg(R_IP, static_cast<int>(pc - code));
+            Aot::Native(state, static_cast<const Ast::FunCall*>(constants[pc[1]]), pc[2]);
+            pc += 3;
+            if (state.GetExecutionState() != BsVmState::Alive)
+            {
+                state.SetReg(R_IP, static_cast<int>(pc - code));
+                return false;
+            }
+            BC_NEXT;
+        BC_CASE(OP_RET)
+            {
+                int returnIp = Aot::Return(state);
+                if (state.GetStackLevels() == exitStackLevel)
+                {
+                    return false;
+                }
+                pc = code + returnIp;
+            }
+            BC_NEXT;
+        BC_CASE(OP_SAVE)
+            *reinterpret_cast<int*>(state.Ram() + ResolveAddr(pc + 1, state)) = state.GetReg(static_cast<Register>(pc[3]));
+            pc += 4;
+            BC_NEXT;
+        BC_CASE(OP_GETR)
+            s[pc[1]].i[0] = state.GetReg(static_cast<Register>(pc[2]));
+            pc += 3;
+            BC_NEXT;
+        BC_CASE(OP_SETR)
+            state.SetReg(static_cast<Register>(pc[1]), s[pc[2]].i[0]);
+            pc += 3;
+            BC_NEXT;
+        BC_CASE(OP_SAVE_TO_ADDR)
+            *reinterpret_cast<int*>(state.Ram() + state.GetReg(static_cast<Register>(pc[1]))) = state.GetReg(static_cast<Register>(pc[2]));
+            pc += 3;
+            BC_NEXT;
+        BC_CASE(OP_CAST_ITOF)
+            {
+                int* r = state.GetRegBuffer() + pc[1];
+                float f = static_cast<float>(*r);
+                *r = reinterpret_cast<int&>(f);
+                pc += 2;
+            }
+            BC_NEXT;
+        BC_CASE(OP_CAST_FTOI)
+            {
+                int* r = state.GetRegBuffer() + pc[1];
+                *r = static_cast<int>(reinterpret_cast<float&>(*r));
+                pc += 2;
+            }
+            BC_NEXT;
+        BC_CASE(OP_LEA)
+            s[pc[1]].i[0] = ResolveAddr(pc + 2, state);
+            pc += 4;
+            BC_NEXT;
+        BC_CASE(OP_LEAX)
+            {
+                int offset = s[pc[1]].i[0];
+                //in safe mode, check if we are trying to access an array out of bounds
+                if (!Aot::CheckIndex(state, offset, pc[4]))
+                {
+                    state.SetReg(R_IP, static_cast<int>(pc - code));
+                    return false;
+                }
+                s[pc[1]].i[0] = offset + ResolveAddr(pc + 2, state);
+                pc += 5;
+            }
+            BC_NEXT;
+        BC_CASE(OP_LEAXU)
+            s[pc[1]].i[0] += ResolveAddr(pc + 2, state);
+            pc += 4;
+            BC_NEXT;
+        BC_CASE(OP_LD4)
+            s[pc[1]].i[0] = *reinterpret_cast<int*>(state.Ram() + ResolveAddr(pc + 2, state));
+            pc += 4;
+            BC_NEXT;
+        BC_CASE(OP_LD)
+            Simd::LoadValue(s[pc[1]].f, state.Ram() + ResolveAddr(pc + 2, state), pc[4]);
+            pc += 5;
+            BC_NEXT;
+        BC_CASE(OP_LDX)
+            Simd::LoadValue(s[pc[1]].f, state.Ram() + ResolveAddr(pc + 2, state) + s[pc[1]].i[0], pc[4]);
+            pc += 5;
+            BC_NEXT;
+        BC_CASE(OP_ST4)
+            *reinterpret_cast<int*>(state.Ram() + ResolveAddr(pc + 1, state)) = s[pc[3]].i[0];
+            pc += 4;
+            BC_NEXT;
+        BC_CASE(OP_ST)
+            Simd::StoreValue(state.Ram() + ResolveAddr(pc + 1, state), s[pc[3]].f, pc[4]);
+            pc += 5;
+            BC_NEXT;
+        BC_CASE(OP_STI)
+            Simd::StoreValue(state.Ram() + s[pc[1]].i[0], s[pc[2]].f, pc[3]);
+            pc += 4;
+            BC_NEXT;
+        BC_CASE(OP_IMM)
+            {
+                int* dest = s[pc[1]].i;
+                int count = pc[2];
+                for (int i = 0; i < count; ++i)
+                {
+                    dest[i] = pc[3 + i];
+                }
+                pc += 3 + count;
+            }
+            BC_NEXT;
+        BC_CASE(OP_COPY)
+            Utils::Memcpy(state.Ram() + ResolveAddr(pc + 1, state), state.Ram() + ResolveAddr(pc + 3, state), pc[5]);
+            pc += 6;
+            BC_NEXT;
+        BC_CASE(OP_COPY_I)
+            Utils::Memcpy(state.Ram() + ResolveAddr(pc + 1, state), state.Ram() + s[pc[3]].i[0], pc[4]);
+            pc += 5;
+            BC_NEXT;
+        BC_CASE(OP_COPY_II)
+            Utils::Memcpy(state.Ram() + s[pc[1]].i[0], state.Ram() + s[pc[2]].i[0], pc[3]);
+            pc += 4;
+            BC_NEXT;
+        BC_CASE(OP_ISDH)
+            {
+                int handle = state.PushHeapElement(const_cast<void*>(constants[pc[3]]), static_cast<const TypeDesc*>(constants[pc[4]]));
+                *reinterpret_cast<int*>(state.Ram() + ResolveAddr(pc + 1, state)) = handle;
+                pc += 5;
+            }
+            BC_NEXT;
+        BC_CASE(OP_READ_PROP)
+        BC_CASE(OP_WRITE_PROP)
+            Aot::ObjProp(state, s[pc[1]].i[0], s[pc[2]].i[0], static_cast<const PropertyNode*>(constants[pc[3]]), static_cast<const TypeDesc*>(constants[pc[4]]), *pc == OP_READ_PROP);
+            pc += 5;
+            BC_NEXT;
+        BC_CASE(OP_NST)
+            Utils::Memcpy(state.GetNativeArgs() + pc[1], &s[pc[2]], pc[3]);
+            pc += 4;
+            BC_NEXT;
+        BC_CASE(OP_NCOPY)
+            Utils::Memcpy(state.GetNativeArgs() + pc[1], state.Ram() + s[pc[2]].i[0], pc[3]);
+            pc += 4;
+            BC_NEXT;
+
+        BC_ALU_OP(OP_ADD_I,  int, r1 + r2)
+        BC_ALU_OP(OP_SUB_I,  int, r1 - r2)
+        BC_ALU_OP(OP_MUL_I,  int, r1 * r2)
+        BC_ALU_OP(OP_DIV_I,  int, r1 / r2)
+        BC_ALU_OP(OP_MOD_I,  int, r1 % r2)
+        BC_ALU_OP(OP_EQ_I,   int, r1 == r2)
+        BC_ALU_OP(OP_NEQ_I,  int, r1 != r2)
+        BC_ALU_OP(OP_GT_I,   int, r1 > r2)
+        BC_ALU_OP(OP_LT_I,   int, r1 < r2)
+        BC_ALU_OP(OP_GTE_I,  int, r1 >= r2)
+        BC_ALU_OP(OP_LTE_I,  int, r1 <= r2)
+        BC_ALU_OP(OP_LAND_I, int, r1 && r2)
+        BC_ALU_OP(OP_LOR_I,  int, r1 || r2)
+        BC_CASE(OP_NEG_I)
+            s[pc[1]].i[0] = -s[pc[2]].i[0];
+            pc += 3;
+            BC_NEXT;
+
+        BC_ALU_OP(OP_ADD_F,  float, r1 + r2)
+        BC_ALU_OP(OP_SUB_F,  float, r1 - r2)
+        BC_ALU_OP(OP_MUL_F,  float, r1 * r2)
+        BC_ALU_OP(OP_DIV_F,  float, r1 / r2)
+        BC_CMP_OP(OP_EQ_F,   float, r1 == r2)
+        BC_CMP_OP(OP_NEQ_F,  float, r1 != r2)
+        BC_CMP_OP(OP_GT_F,   float, r1 > r2)
+        BC_CMP_OP(OP_LT_F,   float, r1 < r2)
+        BC_CMP_OP(OP_GTE_F,  float, r1 >= r2)
+        BC_CMP_OP(OP_LTE_F,  float, r1 <= r2)
+        BC_CMP_OP(OP_LAND_F, float, r1 && r2)
+        BC_CMP_OP(OP_LOR_F,  float, r1 || r2)
+        BC_CASE(OP_NEG_F)
+            s[pc[1]].f[0] = -s[pc[2]].f[0];
+            pc += 3;
+            BC_NEXT;
+        BC_CASE(OP_FMA_F)
+            Simd::MulAdd<1>(s[pc[1]].f, s[pc[2]].f, s[pc[3]].f, s[pc[4]].f);
+            pc += 5;
+            BC_NEXT;
+
+        BC_VEC_OPS(F2,  1)
+        BC_VEC_OPS(F3,  1)
+        BC_VEC_OPS(F4,  1)
+        BC_VEC_OPS(M22, 1)
+        BC_VEC_OPS(M33, 3)
+        BC_VEC_OPS(M44, 4)
+
+        BC_CASE(OP_ITOF)
+            s[pc[1]].f[0] = static_cast<float>(s[pc[1]].i[0]);
+            pc += 2;
+            BC_NEXT;
+        BC_CASE(OP_PACK)
+            {
+                //registers are read in order, so the destination can be the first source
+                int* dest = s[pc[1]].i;
+                int count = pc[3];
+                int word = 0;
+                for (int r = 0; r < count; ++r)
+                {
+                    const int* src = s[pc[2] + r].i;
+                    int words = pc[4 + r];
+                    for (int w = 0; w < words; ++w)
+                    {
+                        dest[word++] = src[w];
+                    }
+                }
+                pc += 4 + count;
+            }
+            BC_NEXT;
+        BC_CASE(OP_SPLAT)
+            {
+                int v = s[pc[2]].i[0];
+                int* dest = s[pc[1]].i;
+                for (int w = 0; w < pc[3]; ++w)
+                {
+                    dest[w] = v;
+                }
+                pc += 4;
+            }
+            BC_NEXT;
+        BC_DOT_OP(OP_DOT_F2, 2)
+        BC_DOT_OP(OP_DOT_F3, 3)
+        BC_DOT_OP(OP_DOT_F4, 4)
+        BC_SIMD_OP(OP_CROSS_F3, Simd::Cross)
+        BC_LERP_OP(OP_LERP_F,  float)
+        BC_CASE(OP_LERP_F2)
+        BC_CASE(OP_LERP_F3)
+        BC_CASE(OP_LERP_F4)
+            Simd::Lerp(s[pc[1]].f, s[pc[2]].f, s[pc[3]].f, s[pc[4]].f[0]);
+            pc += 5;
+            BC_NEXT;
+        BC_MUL_OP(OP_MUL_M22_F2,  Math::Vec2,  Math::Mat22, Math::Mult22_21)
+        BC_MUL_OP(OP_MUL_M33_F3,  Math::Vec3,  Math::Mat33, Math::Mult33_31)
+        BC_SIMD_OP(OP_MUL_M44_F4,  Simd::MulMat44Vec4)
+        BC_SIMD_OP(OP_MUL_M44_M44, Simd::MulMat44Mat44)
+        BC_CASE(OP_SIN)
+            s[pc[1]].f[0] = Math::Sin(s[pc[2]].f[0]);
+            pc += 3;
+            BC_NEXT;
+        BC_CASE(OP_COS)
+            s[pc[1]].f[0] = Math::Cos(s[pc[2]].f[0]);
+            pc += 3;
+            BC_NEXT;
+
+#if !BLOCKSCRIPT_COMPUTED_GOTO
+        default:
+            PG_FAILSTR("Unhandled bytecode instruction!");
+            state.SetReg(R_IP, static_cast<int>(pc - code));
+            return false;
+#endif
+        }
+    }
+}
+
+}
+
+bool BsVm::RunBytecode(const Assembly& assembly, BsVmState& state, int exitStackLevel, int budget) const
+{
+    BsProfiler* profiler = state.GetProfiler();
+    if (profiler == nullptr)
+    {
+        //translated scripts run the same instructions, the profiler needs the interpreter though
+        if (mBackend == BACKEND_AOT && assembly.mAot != nullptr)
+        {
+            return assembly.mAot(assembly, state, exitStackLevel, budget);
+        }
+#if BLOCKSCRIPT_JIT_X64
+        if (mBackend == BACKEND_JIT && assembly.mJit != nullptr)
+        {
+            //calls from c++ start on the entry of the function
+            int returnIp = 0;
+            if (assembly.mJit->Run(state, state.GetReg(R_IP), returnIp))
+            {
+                if (state.GetExecutionState() != BsVmState::Alive || state.GetStackLevels() == exitStackLevel)
+                {
+                    return false;
+                }
+                state.SetReg(R_IP, returnIp);
+            }
+            return RunBytecodeLoop<false>(assembly, state, exitStackLevel, budget, nullptr, assembly.mJit);
+        }
+#endif
+        return RunBytecodeLoop<false>(assembly, state, exitStackLevel, budget, nullptr, nullptr);
+    }
+
+    profiler->BeginRun(assembly);
+    bool paused = RunBytecodeLoop<true>(assembly, state, exitStackLevel, budget, profiler, nullptr);
+    profiler->EndRun();
+    return paused;
+}
+
+bool BsVm::UsesComputedGoto()
+{
+    return BLOCKSCRIPT_COMPUTED_GOTO != 0;
+}
+
+#undef BC_ALU_OP
+#undef BC_CMP_OP
+#undef BC_VEC_OPS
+#undef BC_DOT_OP
+#undef BC_SIMD_OP
+#undef BC_LERP_OP
+#undef BC_MUL_OP
+#undef BC_CHECK_INSTRUCTION
+#undef BC_CASE
+#undef BC_NEXT
@@ -0,0 +1,161 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                       Pegasus                                        */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file   BsVmSnapshot.cpp
+//! \author agent
+//! \date   16th October 2026
+//! \brief  Snapshot of a virtual machine state, restored to rewind the state.
+
+#include "Pegasus/BlockScript/BsVmSnapshot.h"
+#include "Pegasus/Allocator/Alloc.h"
+#include "Pegasus/Allocator/IAllocator.h"
+#include "Pegasus/Core/Assertion.h"
+#include "Pegasus/Math/Types.h"
+#include "Pegasus/Utils/Memcpy.h"
+
+using namespace Pegasus;
+using namespace Pegasus::BlockScript;
+
+//! \return true if two pages of stack hold the same bytes. Pages are aligned to the frame slots.
+static bool PagesMatch(const char* a, const char* b)
+{
+    const Math::PUInt64* wordsA = reinterpret_cast<const Math::PUInt64*>(a);
+    const Math::PUInt64* wordsB = reinterpret_cast<const Math::PUInt64*>(b);
+    for (int w = 0; w < BS_VM_SNAPSHOT_PAGE_BYTESIZE / static_cast<int>(sizeof(Math::PUInt64)); ++w)
+    {
+        if (wordsA[w] != wordsB[w])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+BsVmSnapshot::BsVmSnapshot(Alloc::IAllocator* allocator)
+: mAllocator(allocator),
+  mRamSize(0),
+  mStackLevels(-1),
+  mExecutionState(BsVmState::Alive),
+  mIsSuspendedByCallback(false),
+  mResumeStackLevel(-1),
+  mResumeIp(0),
+  mResumeOutputByteSize(0),
+  mSharedPageCount(0),
+  mIsValid(false)
+{
+    mPages.Initialize(allocator);
+    mHeap.Initialize(allocator);
+}
+
+BsVmSnapshot::~BsVmSnapshot()
+{
+    Release();
+}
+
+void BsVmSnapshot::Release()
+{
+    for (int i = 0; i < mPages.Size(); ++i)
+    {
+        if (--mPages[i]->mRefCount == 0)
+        {
+            PG_DELETE(mAllocator, mPages[i]);
+        }
+    }
+    mPages.Reset();
+    mHeap.Reset();
+    mSharedPageCount = 0;
+    mIsValid = false;
+}
+
+void BsVmSnapshot::Capture(const BsVmState& state, const BsVmSnapshot* previous)
+{
+    PG_ASSERTSTR(state.mNativeArgsTop == 0, "Can't snapshot a blockscript state in the middle of a callback.");
+    PG_ASSERT(previous != this);
+    Release();
+
+    //the stack is committed in multiples of the page size, so the last page can be read whole
+    PG_ASSERT(state.mRamCount % BS_VM_SNAPSHOT_PAGE_BYTESIZE == 0);
+    const int pageCount = (state.mRamSize + BS_VM_SNAPSHOT_PAGE_BYTESIZE - 1) / BS_VM_SNAPSHOT_PAGE_BYTESIZE;
+    for (int p = 0; p < pageCount; ++p)
+    {
+        const char* data = state.mRam + p * BS_VM_SNAPSHOT_PAGE_BYTESIZE;
+        Page* page = nullptr;
+        if (previous != nullptr && p < previous->mPages.Size() && PagesMatch(previous->mPages[p]->mData, data))
+        {
+            page = previous->mPages[p];
+            ++mSharedPageCount;
+        }
+        else
+        {
+            page = PG_NEW(mAllocator, -1, "BS VM SNAPSHOT PAGE", Alloc::PG_MEM_TEMP) Page;
+            page->mRefCount = 0;
+            Utils::Memcpy(page->mData, data, BS_VM_SNAPSHOT_PAGE_BYTESIZE);
+        }
+        ++page->mRefCount;
+        mPages.PushEmpty() = page;
+    }
+
+    for (int i = 0; i < state.mHeapContainer.Size(); ++i)
+    {
+        mHeap.PushEmpty() = state.mHeapContainer[i];
+    }
+
+    for (int r = 0; r < static_cast<int>(Canon::R_COUNT); ++r)
+    {
+        mR[r] = state.mR[r];
+    }
+    mRamSize = state.mRamSize;
+    mStackLevels = state.mStackLevels;
+    mExecutionState = state.mExecutionState;
+    mIsSuspendedByCallback = state.mIsSuspendedByCallback;
+    mResumeStackLevel = state.mResumeStackLevel;
+    mResumeIp = state.mResumeIp;
+    mResumeOutputByteSize = state.mResumeOutputByteSize;
+    mIsValid = true;
+}
+
+void BsVmSnapshot::Restore(BsVmState& state) const
+{
+    PG_ASSERT(mIsValid);
+    PG_ASSERTSTR(state.mNativeArgsTop == 0, "Can't restore a blockscript state in the middle of a callback.");
+
+    //reserving never shrinks the stack, and keeps its content
+    state.Reserve(mRamSize);
+    for (int p = 0; p < mPages.Size(); ++p)
+    {
+        int offset = p * BS_VM_SNAPSHOT_PAGE_BYTESIZE;
+        int byteCount = mRamSize - offset < BS_VM_SNAPSHOT_PAGE_BYTESIZE ? mRamSize - offset : BS_VM_SNAPSHOT_PAGE_BYTESIZE;
+        Utils::Memcpy(state.mRam + offset, mPages[p]->mData, byteCount);
+    }
+
+    state.mHeapContainer.Reset();
+    for (int i = 0; i < mHeap.Size(); ++i)
+    {
+        state.mHeapContainer.PushEmpty() = mHeap[i];
+    }
+
+    for (int r = 0; r < static_cast<int>(Canon::R_COUNT); ++r)
+    {
+        state.mR[r] = mR[r];
+    }
+    state.mRamSize = mRamSize;
+    state.mStackLevels = mStackLevels;
+    state.mExecutionState = mExecutionState;
+    state.mIsSuspendedByCallback = mIsSuspendedByCallback;
+    state.mResumeStackLevel = mResumeStackLevel;
+    state.mResumeIp = mResumeIp;
+    state.mResumeOutputByteSize = mResumeOutputByteSize;
+}
+
+int BsVmSnapshot::GetByteSize() const
+{
+    int byteSize = static_cast<int>(sizeof(*this)) + mHeap.Size() * static_cast<int>(sizeof(BsVmState::HeapElement));
+    for (int p = 0; p < mPages.Size(); ++p)
+    {
+        byteSize += static_cast<int>(sizeof(Page)) / mPages[p]->mRefCount;
+    }
+    return byteSize;
+}
@@ -0,0 +1,1000 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                       Pegasus                                        */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file   BytecodeGenerator.cpp
+//! \author agent
+//! \date   16th October 2026
+//! \brief  Lowers the canonical assembly into a flat bytecode stream. Implementation
+
+#include "Pegasus/BlockScript/BytecodeGenerator.h"
+#include "Pegasus/BlockScript/Canonizer.h"
+#include "Pegasus/BlockScript/BlockScriptAst.h"
+#include "Pegasus/BlockScript/bs.parser.hpp"
+#include "Pegasus/BlockScript/StackFrameInfo.h"
+#include "Pegasus/BlockScript/FunDesc.h"
+#include "Pegasus/BlockScript/BsVm.h"
+#include "Pegasus/Allocator/IAllocator.h"
+#include "Pegasus/Allocator/Alloc.h"
+#include "Pegasus/Memory/MemoryManager.h"
+#include "Pegasus/Core/Assertion.h"
+#include "Pegasus/Utils/Memcpy.h"
+
+using namespace Pegasus;
+using namespace Pegasus::BlockScript;
+using namespace Pegasus::BlockScript::Bytecode;
+
+#define BYTECODE_INITIAL_CAPACITY 256
+
+template<class T>
+T& BytecodeGenerator::Buffer<T>::Push(Alloc::IAllocator* alloc)
+{
+    if (mSize == mCapacity)
+    {
+        int newCapacity = mCapacity == 0 ? BYTECODE_INITIAL_CAPACITY : mCapacity * 2;
+        T* newData = PG_NEW_ARRAY(alloc, -1, "Bytecode", Alloc::PG_MEM_TEMP, T, newCapacity);
+        if (mData != nullptr)
+        {
+            Utils::Memcpy(newData, mData, mSize * sizeof(T));
+            PG_DELETE_ARRAY(alloc, mData);
+        }
+        mData = newData;
+        mCapacity = newCapacity;
+    }
+    return mData[mSize++];
+}
+
+template<class T>
+void BytecodeGenerator::Buffer<T>::Free(Alloc::IAllocator* alloc)
+{
+    if (mData != nullptr)
+    {
+        PG_DELETE_ARRAY(alloc, mData);
+    }
+    mData = nullptr;
+    mSize = 0;
+    mCapacity = 0;
+}
+
+//! \return the size in bytes of the intrinsic type the expression engine uses for this alu engine
+static int GetEngineByteSize(TypeDesc::AluEngine engine)
+{
+    switch (engine)
+    {
+    case TypeDesc::E_INT:
+    case TypeDesc::E_FLOAT:
+        return 4;
+    case TypeDesc::E_FLOAT2:
+        return 8;
+    case TypeDesc::E_FLOAT3:
+        return 12;
+    case TypeDesc::E_FLOAT4:
+    case TypeDesc::E_MATRIX2x2:
+        return 16;
+    case TypeDesc::E_MATRIX3x3:
+        return 36;
+    case TypeDesc::E_MATRIX4x4:
+        return 64;
+    default:
+        return -1;
+    }
+}
+
+//! \return the opcode of a binary operator for a specific alu engine, -1 if not supported
+static int GetBinopOpCode(TypeDesc::AluEngine engine, int op)
+{
+    if (engine == TypeDesc::E_INT)
+    {
+        switch (op)
+        {
+        case O_PLUS:  return OP_ADD_I;
+        case O_MINUS: return OP_SUB_I;
+        case O_MUL:   return OP_MUL_I;
+        case O_DIV:   return OP_DIV_I;
+        case O_MOD:   return OP_MOD_I;
+        case O_EQ:    return OP_EQ_I;
+        case O_NEQ:   return OP_NEQ_I;
+        case O_GT:    return OP_GT_I;
+        case O_LT:    return OP_LT_I;
+        case O_GTE:   return OP_GTE_I;
+        case O_LTE:   return OP_LTE_I;
+        case O_LAND:  return OP_LAND_I;
+        case O_LOR:   return OP_LOR_I;
+        default:      return -1;
+        }
+    }
+    else if (engine == TypeDesc::E_FLOAT)
+    {
+        switch (op)
+        {
+        case O_PLUS:  return OP_ADD_F;
+        case O_MINUS: return OP_SUB_F;
+        case O_MUL:   return OP_MUL_F;
+        case O_DIV:   return OP_DIV_F;
+        case O_EQ:    return OP_EQ_F;
+        case O_NEQ:   return OP_NEQ_F;
+        case O_GT:    return OP_GT_F;
+        case O_LT:    return OP_LT_F;
+        case O_GTE:   return OP_GTE_F;
+        case O_LTE:   return OP_LTE_F;
+        case O_LAND:  return OP_LAND_F;
+        case O_LOR:   return OP_LOR_F;
+        default:      return -1;
+        }
+    }
+    else
+    {
+        int base = -1;
+        switch (engine)
+        {
+        case TypeDesc::E_FLOAT2:    base = OP_ADD_F2; break;
+        case TypeDesc::E_FLOAT3:    base = OP_ADD_F3; break;
+        case TypeDesc::E_FLOAT4:    base = OP_ADD_F4; break;
+        case TypeDesc::E_MATRIX2x2: base = OP_ADD_M22; break;
+        case TypeDesc::E_MATRIX3x3: base = OP_ADD_M33; break;
+        case TypeDesc::E_MATRIX4x4: base = OP_ADD_M44; break;
+        default: return -1;
+        }
+
+        // all vector opcodes are laid out as ADD, SUB, MUL, DIV
+        switch (op)
+        {
+        case O_PLUS:  return base;
+        case O_MINUS: return base + 1;
+        case O_MUL:   return base + 2;
+        case O_DIV:   return base + 3;
+        default:      return -1;
+        }
+    }
+}
+
+//! \return the opcode of a negation for a specific alu engine, -1 if not supported
+static int GetNegOpCode(TypeDesc::AluEngine engine)
+{
+    if (engine < TypeDesc::E_INT || engine > TypeDesc::E_MATRIX4x4)
+    {
+        return -1;
+    }
+    return OP_NEG_I + (engine - TypeDesc::E_INT);
+}
+
+//! \return the opcode of a fused multiply-add for a specific alu engine, -1 if not supported
+static int GetFmaOpCode(TypeDesc::AluEngine engine)
+{
+    if (engine < TypeDesc::E_FLOAT || engine > TypeDesc::E_MATRIX4x4)
+    {
+        return -1;
+    }
+    return OP_FMA_F + (engine - TypeDesc::E_FLOAT);
+}
+
+//! \return true if the expression is a multiplication
+static bool IsProduct(const Ast::Exp* exp)
+{
+    return exp->GetExpType() == Ast::Binop::sType && static_cast<const Ast::Binop*>(exp)->GetOp() == O_MUL;
+}
+
+BytecodeGenerator::BytecodeGenerator()
+: mAllocator(nullptr), mFrameBias(0)
+{
+}
+
+BytecodeGenerator::~BytecodeGenerator()
+{
+    if (mAllocator != nullptr)
+    {
+        mCode.Free(mAllocator);
+        mConstants.Free(mAllocator);
+        mConstantKinds.Free(mAllocator);
+        mBlockOffsets.Free(mAllocator);
+        mLabelPatches.Free(mAllocator);
+        mLines.Free(mAllocator);
+    }
+}
+
+void BytecodeGenerator::Initialize(Alloc::IAllocator* alloc)
+{
+    mAllocator = alloc;
+    Reset();
+}
+
+void BytecodeGenerator::Reset()
+{
+    mCode.mSize = 0;
+    mConstants.mSize = 0;
+    mConstantKinds.mSize = 0;
+    mBlockOffsets.mSize = 0;
+    mLabelPatches.mSize = 0;
+    mLines.mSize = 0;
+    mFrameBias = 0;
+    mBytecode = BytecodeAssembly();
+}
+
+void BytecodeGenerator::EmitAddr(const Ast::Idd* idd)
+{
+    if (idd->GetMetaData().isGlobal)
+    {
+        EmitWord(BYTECODE_GLOBAL_FRAME);
+    }
+    else
+    {
+        EmitWord(idd->GetFrameOffset() + mFrameBias);
+    }
+    EmitWord(idd->GetOffset());
+}
+
+void BytecodeGenerator::EmitLabel(int label)
+{
+    //labels are patched to code offsets once all the blocks have been laid out
+    mLabelPatches.Push(mAllocator) = mCode.mSize;
+    EmitWord(label);
+}
+
+int BytecodeGenerator::EmitConstant(const void* constant, ConstantKind kind)
+{
+    for (int i = 0; i < mConstants.mSize; ++i)
+    {
+        if (mConstants.mData[i] == constant)
+        {
+            PG_ASSERT(mConstantKinds.mData[i] == kind);
+            return i;
+        }
+    }
+    mConstants.Push(mAllocator) = constant;
+    mConstantKinds.Push(mAllocator) = kind;
+    return mConstants.mSize - 1;
+}
+
+void BytecodeGenerator::MakeDestination(Destination& dest, const Ast::Idd* idd)
+{
+    dest.mKind = Destination::D_ADDR;
+    dest.mFrame = idd->GetMetaData().isGlobal ? BYTECODE_GLOBAL_FRAME : idd->GetFrameOffset() + mFrameBias;
+    dest.mOffset = idd->GetOffset();
+    dest.mReg = -1;
+}
+
+bool BytecodeGenerator::EmitValue(Ast::Exp* exp, TypeDesc::AluEngine engine, int reg)
+{
+    // mirrors ExpressionEngine<T>::Eval, the whole tree is evaluated with the engine of its root
+    if (reg >= BYTECODE_SCRATCH_REGISTER_COUNT)
+    {
+        return false;
+    }
+
+    int engineSize = GetEngineByteSize(engine);
+    if (engineSize == -1)
+    {
+        return false;
+    }
+
+    if (exp->GetExpType() == Ast::Idd::sType)
+    {
+        Ast::Idd* idd = static_cast<Ast::Idd*>(exp);
+        if (engineSize == 4)
+        {
+            EmitWord(OP_LD4);
+            EmitWord(reg);
+            EmitAddr(idd);
+        }
+        else
+        {
+            EmitWord(OP_LD);
+            EmitWord(reg);
+            EmitAddr(idd);
+            EmitWord(engineSize);
+        }
+        return true;
+    }
+    else if (exp->GetExpType() == Ast::Imm::sType)
+    {
+        //only scalar and vector immediates are supported by the expression engines
+        if (engine > TypeDesc::E_FLOAT4)
+        {
+            return false;
+        }
+        const Ast::Variant& v = static_cast<Ast::Imm*>(exp)->GetVariant();
+        int wordCount = engineSize / 4;
+        EmitWord(OP_IMM);
+        EmitWord(reg);
+        EmitWord(wordCount);
+        for (int i = 0; i < wordCount; ++i)
+        {
+            EmitWord(v.i[i]);
+        }
+        return true;
+    }
+    else if (exp->GetExpType() == Ast::Binop::sType)
+    {
+        Ast::Binop* binop = static_cast<Ast::Binop*>(exp);
+        if (binop->GetOp() == O_ACCESS)
+        {
+            if (binop->GetLhs()->GetExpType() != Ast::Idd::sType ||
+                !EmitValue(binop->GetRhs(), TypeDesc::E_INT, reg))
+            {
+                return false;
+            }
+            EmitWord(OP_LDX);
+            EmitWord(reg);
+            EmitAddr(static_cast<Ast::Idd*>(binop->GetLhs()));
+            EmitWord(engineSize);
+            return true;
+        }
+
+        //a * b + c and c + a * b are fused into a single multiply-add, operands are evaluated in source order
+        int fmaOpCode = GetFmaOpCode(engine);
+        if (binop->GetOp() == O_PLUS && fmaOpCode != -1 && reg + 2 < BYTECODE_SCRATCH_REGISTER_COUNT &&
+            (IsProduct(binop->GetLhs()) || IsProduct(binop->GetRhs())))
+        {
+            bool productFirst = IsProduct(binop->GetLhs());
+            Ast::Binop* product = static_cast<Ast::Binop*>(productFirst ? binop->GetLhs() : binop->GetRhs());
+            Ast::Exp* addend = productFirst ? binop->GetRhs() : binop->GetLhs();
+            int productReg = productFirst ? reg : reg + 1;
+            int addendReg = productFirst ? reg + 2 : reg;
+            if ((!productFirst && !EmitValue(addend, engine, addendReg)) ||
+                !EmitValue(product->GetLhs(), engine, productReg) ||
+                !EmitValue(product->GetRhs(), engine, productReg + 1) ||
+                (productFirst && !EmitValue(addend, engine, addendReg)))
+            {
+                return false;
+            }
+            EmitWord(fmaOpCode);
+            EmitWord(reg);
+            EmitWord(productReg);
+            EmitWord(productReg + 1);
+            EmitWord(addendReg);
+            return true;
+        }
+
+        int opCode = GetBinopOpCode(engine, binop->GetOp());
+        if (opCode == -1 ||
+            !EmitValue(binop->GetLhs(), engine, reg) ||
+            !EmitValue(binop->GetRhs(), engine, reg + 1))
+        {
+            return false;
+        }
+        EmitWord(opCode);
+        EmitWord(reg);
+        EmitWord(reg);
+        EmitWord(reg + 1);
+        return true;
+    }
+    else if (exp->GetExpType() == Ast::Unop::sType)
+    {
+        Ast::Unop* unop = static_cast<Ast::Unop*>(exp);
+        int opCode = GetNegOpCode(engine);
+        if (unop->GetOp() != O_MINUS || opCode == -1 || !EmitValue(unop->GetExp(), engine, reg))
+        {
+            return false;
+        }
+        EmitWord(opCode);
+        EmitWord(reg);
+        EmitWord(reg);
+        return true;
+    }
+
+    return false;
+}
+
+bool BytecodeGenerator::EmitAddress(Ast::Exp* exp, int reg)
+{
+    // mirrors GetMemoryOffset
+    if (reg >= BYTECODE_SCRATCH_REGISTER_COUNT)
+    {
+        return false;
+    }
+
+    if (exp->GetExpType() == Ast::Idd::sType)
+    {
+        EmitWord(OP_LEA);
+        EmitWord(reg);
+        EmitAddr(static_cast<Ast::Idd*>(exp));
+        return true;
+    }
+    else if (exp->GetExpType() == Ast::Binop::sType)
+    {
+        Ast::Binop* binop = static_cast<Ast::Binop*>(exp);
+        if (binop->GetOp() != O_ACCESS ||
+            binop->GetLhs()->GetExpType() != Ast::Idd::sType ||
+            !EmitValue(binop->GetRhs(), TypeDesc::E_INT, reg))
+        {
+            return false;
+        }
+        if (binop->IsIndexInRange())
+        {
+            EmitWord(OP_LEAXU);
+            EmitWord(reg);
+            EmitAddr(static_cast<Ast::Idd*>(binop->GetLhs()));
+        }
+        else
+        {
+            EmitWord(OP_LEAX);
+            EmitWord(reg);
+            EmitAddr(static_cast<Ast::Idd*>(binop->GetLhs()));
+            EmitWord(binop->GetLhs()->GetTypeDesc()->GetByteSize());
+        }
+        return true;
+    }
+    return false;
+}
+
+bool BytecodeGenerator::EmitStore(const Destination& dest, int reg, int byteSize)
+{
+    switch (dest.mKind)
+    {
+    case Destination::D_ADDR:
+        if (byteSize == 4)
+        {
+            EmitWord(OP_ST4);
+            EmitWord(dest.mFrame);
+            EmitWord(dest.mOffset);
+            EmitWord(reg);
+        }
+        else
+        {
+            EmitWord(OP_ST);
+            EmitWord(dest.mFrame);
+            EmitWord(dest.mOffset);
+            EmitWord(reg);
+            EmitWord(byteSize);
+        }
+        return true;
+    case Destination::D_SCRATCH:
+        EmitWord(OP_STI);
+        EmitWord(dest.mReg);
+        EmitWord(reg);
+        EmitWord(byteSize);
+        return true;
+    case Destination::D_REGISTER:
+        if (byteSize > CANON_REGISTER_BYTESIZE)
+        {
+            return false;
+        }
+        EmitWord(OP_SETR);
+        EmitWord(dest.mReg);
+        EmitWord(reg);
+        return true;
+    case Destination::D_NATIVE:
+        EmitWord(OP_NST);
+        EmitWord(dest.mOffset);
+        EmitWord(reg);
+        EmitWord(byteSize);
+        return true;
+    }
+    return false;
+}
+
+bool BytecodeGenerator::EmitCopy(const Destination& dest, int addrReg, int byteSize)
+{
+    switch (dest.mKind)
+    {
+    case Destination::D_ADDR:
+        EmitWord(OP_COPY_I);
+        EmitWord(dest.mFrame);
+        EmitWord(dest.mOffset);
+        EmitWord(addrReg);
+        EmitWord(byteSize);
+        return true;
+    case Destination::D_SCRATCH:
+        EmitWord(OP_COPY_II);
+        EmitWord(dest.mReg);
+        EmitWord(addrReg);
+        EmitWord(byteSize);
+        return true;
+    case Destination::D_NATIVE:
+        EmitWord(OP_NCOPY);
+        EmitWord(dest.mOffset);
+        EmitWord(addrReg);
+        EmitWord(byteSize);
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool BytecodeGenerator::EmitSaveExpression(const Destination& dest, Ast::Exp* exp, int reg)
+{
+    // mirrors SaveExpression
+    const TypeDesc* expType = exp->GetTypeDesc();
+    switch (expType->GetModifier())
+    {
+    case TypeDesc::M_SCALAR:
+    case TypeDesc::M_VECTOR:
+        {
+            TypeDesc::AluEngine engine = expType->GetAluEngine();
+            return EmitValue(exp, engine, reg) && EmitStore(dest, reg, GetEngineByteSize(engine));
+        }
+    case TypeDesc::M_STRUCT:
+    case TypeDesc::M_ARRAY:
+        return EmitAddress(exp, reg) && EmitCopy(dest, reg, expType->GetByteSize());
+    case TypeDesc::M_REFERECE:
+    case TypeDesc::M_ENUM:
+    case TypeDesc::M_STAR:
+        return EmitValue(exp, TypeDesc::E_INT, reg) && EmitStore(dest, reg, 4);
+    default:
+        return false;
+    }
+}
+
+bool BytecodeGenerator::EmitPureIntrinsic(Ast::FunCall* fc)
+{
+    // the arguments are evaluated on consecutive scratch registers starting at 0, the result goes to register 0
+    const TypeDesc* retType = fc->GetTypeDesc();
+    TypeDesc::AluEngine retEngine = retType->GetAluEngine();
+    int retSize = retType->GetByteSize();
+    if (retSize > BYTECODE_SCRATCH_REGISTER_INTS * 4 || (retSize % 4) != 0)
+    {
+        return false;
+    }
+
+    TypeDesc::AluEngine argEngines[BYTECODE_SCRATCH_REGISTER_COUNT];
+    int argCount = 0;
+    for (Ast::ExpList* tail = fc->GetArgs(); tail != nullptr && tail->GetExp() != nullptr; tail = tail->GetTail())
+    {
+        const TypeDesc* argType = tail->GetExp()->GetTypeDesc();
+        TypeDesc::AluEngine engine;
+        switch (argType->GetModifier())
+        {
+        case TypeDesc::M_SCALAR:
+        case TypeDesc::M_VECTOR:
+            engine = argType->GetAluEngine();
+            break;
+        case TypeDesc::M_REFERECE:
+        case TypeDesc::M_ENUM:
+        case TypeDesc::M_STAR:
+            engine = TypeDesc::E_INT;
+            break;
+        default:
+            return false;
+        }
+
+        if (argCount == BYTECODE_SCRATCH_REGISTER_COUNT || !EmitValue(tail->GetExp(), engine, argCount))
+        {
+            return false;
+        }
+        argEngines[argCount++] = engine;
+    }
+
+    bool isFloatResult = retEngine >= TypeDesc::E_FLOAT && retEngine <= TypeDesc::E_MATRIX4x4;
+    switch (fc->GetDesc()->GetPureIntrinsic())
+    {
+    case PURE_CONSTRUCT:
+        {
+            int totalSize = 0;
+            for (int i = 0; i < argCount; ++i)
+            {
+                totalSize += GetEngineByteSize(argEngines[i]);
+                if (isFloatResult && argEngines[i] == TypeDesc::E_INT)
+                {
+                    EmitWord(OP_ITOF);
+                    EmitWord(i);
+                }
+            }
+            if (argCount == 0 || totalSize != retSize)
+            {
+                return false;
+            }
+            EmitWord(OP_PACK);
+            EmitWord(0);
+            EmitWord(0);
+            EmitWord(argCount);
+            for (int i = 0; i < argCount; ++i)
+            {
+                EmitWord(GetEngineByteSize(argEngines[i]) / 4);
+            }
+        }
+        break;
+    case PURE_SPLAT:
+        if (argCount != 1 || !isFloatResult || (argEngines[0] != TypeDesc::E_INT && argEngines[0] != TypeDesc::E_FLOAT))
+        {
+            return false;
+        }
+        if (argEngines[0] == TypeDesc::E_INT)
+        {
+            EmitWord(OP_ITOF);
+            EmitWord(0);
+        }
+        EmitWord(OP_SPLAT);
+        EmitWord(0);
+        EmitWord(0);
+        EmitWord(retSize / 4);
+        break;
+    case PURE_DOT:
+        if (argCount != 2 || argEngines[0] != argEngines[1] || argEngines[0] < TypeDesc::E_FLOAT2 || argEngines[0] > TypeDesc::E_FLOAT4)
+        {
+            return false;
+        }
+        EmitWord(OP_DOT_F2 + (argEngines[0] - TypeDesc::E_FLOAT2));
+        EmitWord(0);
+        EmitWord(0);
+        EmitWord(1);
+        break;
+    case PURE_CROSS:
+        if (argCount != 2 || argEngines[0] != TypeDesc::E_FLOAT3 || argEngines[1] != TypeDesc::E_FLOAT3)
+        {
+            return false;
+        }
+        EmitWord(OP_CROSS_F3);
+        EmitWord(0);
+        EmitWord(0);
+        EmitWord(1);
+        break;
+    case PURE_LERP:
+        if (argCount != 3 || argEngines[0] != argEngines[1] || argEngines[2] != TypeDesc::E_FLOAT ||
+            argEngines[0] < TypeDesc::E_FLOAT || argEngines[0] > TypeDesc::E_FLOAT4)
+        {
+            return false;
+        }
+        EmitWord(OP_LERP_F + (argEngines[0] - TypeDesc::E_FLOAT));
+        EmitWord(0);
+        EmitWord(0);
+        EmitWord(1);
+        EmitWord(2);
+        break;
+    case PURE_MUL:
+        {
+            if (argCount != 2)
+            {
+                return false;
+            }
+            int opCode = -1;
+            if (argEngines[0] == TypeDesc::E_MATRIX2x2 && argEngines[1] == TypeDesc::E_FLOAT2) opCode = OP_MUL_M22_F2;
+            else if (argEngines[0] == TypeDesc::E_MATRIX3x3 && argEngines[1] == TypeDesc::E_FLOAT3) opCode = OP_MUL_M33_F3;
+            else if (argEngines[0] == TypeDesc::E_MATRIX4x4 && argEngines[1] == TypeDesc::E_FLOAT4) opCode = OP_MUL_M44_F4;
+            else if (argEngines[0] == TypeDesc::E_MATRIX4x4 && argEngines[1] == TypeDesc::E_MATRIX4x4) opCode = OP_MUL_M44_M44;
+            if (opCode == -1)
+            {
+                return false;
+            }
+            EmitWord(opCode);
+            EmitWord(0);
+            EmitWord(0);
+            EmitWord(1);
+        }
+        break;
+    case PURE_SIN:
+    case PURE_COS:
+        if (argCount != 1 || argEngines[0] != TypeDesc::E_FLOAT)
+        {
+            return false;
+        }
+        EmitWord(fc->GetDesc()->GetPureIntrinsic() == PURE_SIN ? OP_SIN : OP_COS);
+        EmitWord(0);
+        EmitWord(0);
+        break;
+    default:
+        return false;
+    }
+
+    // return the value the same way a callback does: in R_RET, or at the address stored in R_RET
+    if (retSize <= CANON_REGISTER_BYTESIZE)
+    {
+        EmitWord(OP_SETR);
+        EmitWord(Canon::R_RET);
+        EmitWord(0);
+    }
+    else
+    {
+        EmitWord(OP_GETR);
+        EmitWord(1);
+        EmitWord(Canon::R_RET);
+        EmitWord(OP_STI);
+        EmitWord(1);
+        EmitWord(0);
+        EmitWord(retSize);
+    }
+    return true;
+}
+
+bool BytecodeGenerator::EmitFunGo(const Canon::CanonNode* node)
+{
+    // mirrors FunGoCommand
+    const Canon::FunGo* fungo = static_cast<const Canon::FunGo*>(node);
+    Ast::FunCall* fc = fungo->GetFunCall();
+    const FunDesc* funDesc = fc->GetDesc();
+
+    if (funDesc->IsCallback() && funDesc->GetPureIntrinsic() != PURE_NONE)
+    {
+        //inline the intrinsic. If it can't be inlined, discard what was emitted and call it
+        int codeSize = mCode.mSize;
+        if (EmitPureIntrinsic(fc))
+        {
+            return true;
+        }
+        mCode.mSize = codeSize;
+    }
+
+    if (funDesc->IsCallback() && funDesc->GetInputArgumentsByteSize() <= BS_VM_NATIVE_CALL_MAX_ARGS_BYTESIZE)
+    {
+        //native calls write their arguments straight into the native argument buffer, evaluated in the current frame
+        int byteOffset = 0;
+        Ast::ExpList* tail = fc->GetArgs();
+        while (tail != nullptr && tail->GetExp() != nullptr)
+        {
+            Destination dest;
+            dest.mKind = Destination::D_NATIVE;
+            dest.mFrame = 0;
+            dest.mOffset = byteOffset;
+            dest.mReg = -1;
+            if (!EmitSaveExpression(dest, tail->GetExp(), 0))
+            {
+                return false;
+            }
+            byteOffset += tail->GetExp()->GetTypeDesc()->GetByteSize();
+            tail = tail->GetTail();
+        }
+        EmitWord(OP_NATIVE);
+        EmitWord(EmitConstant(fc, K_FUNCALL));
+        EmitWord(byteOffset);
+        return true;
+    }
+
+    EmitWord(OP_PUSHFRAME);
+    EmitWord(EmitConstant(funDesc->GetDec()->GetFrame(), K_FRAME));
+
+    //arguments are evaluated relative to the caller frame, which is now one frame above
+    mFrameBias = 1;
+    int byteOffset = 0;
+    Ast::ExpList* tail = fc->GetArgs();
+    while (tail != nullptr && tail->GetExp() != nullptr)
+    {
+        Destination dest;
+        dest.mKind = Destination::D_ADDR;
+        dest.mFrame = 0;
+        dest.mOffset = byteOffset;
+        dest.mReg = -1;
+        if (!EmitSaveExpression(dest, tail->GetExp(), 0))
+        {
+            mFrameBias = 0;
+            return false;
+        }
+        byteOffset += tail->GetExp()->GetTypeDesc()->GetByteSize();
+        tail = tail->GetTail();
+    }
+    mFrameBias = 0;
+
+    if (funDesc->IsCallback())
+    {
+        EmitWord(OP_CALLBACK);
+        EmitWord(EmitConstant(fc, K_FUNCALL));
+        EmitWord(byteOffset);
+    }
+    else
+    {
+        EmitWord(OP_CALL);
+        EmitLabel(fungo->GetLabel());
+    }
+    return true;
+}
+
+bool BytecodeGenerator::EmitNode(const Canon::CanonNode* n)
+{
+    switch (n->GetType())
+    {
+    case Canon::T_MOVE:
+        {
+            // mirrors MoveCommand
+            const Canon::Move* mov = static_cast<const Canon::Move*>(n);
+            Ast::Idd* lhs = mov->GetLhs();
+            Ast::Exp* rhs = mov->GetRhs();
+            int byteSize = lhs->GetTypeDesc()->GetByteSize();
+            Destination dest;
+            MakeDestination(dest, lhs);
+            if (rhs->GetExpType() == Ast::Idd::sType)
+            {
+                EmitWord(OP_COPY);
+                EmitAddr(lhs);
+                EmitAddr(static_cast<Ast::Idd*>(rhs));
+                EmitWord(byteSize);
+                return true;
+            }
+            else if (rhs->GetExpType() == Ast::Imm::sType)
+            {
+                if (byteSize > static_cast<int>(sizeof(Ast::Variant)))
+                {
+                    return false;
+                }
+                const Ast::Variant& v = static_cast<Ast::Imm*>(rhs)->GetVariant();
+                int wordCount = byteSize <= 4 ? 1 : (byteSize + 3) / 4;
+                EmitWord(OP_IMM);
+                EmitWord(0);
+                EmitWord(wordCount);
+                for (int i = 0; i < wordCount; ++i)
+                {
+                    EmitWord(v.i[i]);
+                }
+                return EmitStore(dest, 0, byteSize <= 4 ? 4 : byteSize);
+            }
+            return EmitSaveExpression(dest, rhs, 0);
+        }
+    case Canon::T_INSERT_DATA_TO_HEAP:
+        {
+            const Canon::InsertDataToHeap* isdh = static_cast<const Canon::InsertDataToHeap*>(n);
+            EmitWord(OP_ISDH);
+            EmitAddr(isdh->GetTmp());
+            EmitWord(EmitConstant(isdh->GetPointer(), K_HEAP_DATA));
+            EmitWord(EmitConstant(isdh->GetTmp()->GetTypeDesc(), K_TYPE));
+            return true;
+        }
+    case Canon::T_SAVE:
+        {
+            const Canon::Save* sav = static_cast<const Canon::Save*>(n);
+            EmitWord(OP_SAVE);
+            EmitAddr(sav->GetTmp());
+            EmitWord(sav->GetRegister());
+            return true;
+        }
+    case Canon::T_LOAD:
+        {
+            const Canon::Load* load = static_cast<const Canon::Load*>(n);
+            Destination dest;
+            dest.mKind = Destination::D_REGISTER;
+            dest.mFrame = 0;
+            dest.mOffset = 0;
+            dest.mReg = load->GetRegister();
+            return EmitSaveExpression(dest, load->GetExp(), 0);
+        }
+    case Canon::T_EXIT:
+        EmitWord(OP_EXIT);
+        return true;
+    case Canon::T_FUNGO:
+        return EmitFunGo(n);
+    case Canon::T_JMP:
+        EmitWord(OP_JMP);
+        EmitLabel(static_cast<const Canon::Jmp*>(n)->GetLabel());
+        return true;
+    case Canon::T_JMPCOND:
+        {
+            // mirrors EvalJmpCond
+            const Canon::JmpCond* jmpCond = static_cast<const Canon::JmpCond*>(n);
+            TypeDesc::AluEngine engine = jmpCond->GetExp()->GetTypeDesc()->GetAluEngine();
+            if (engine != TypeDesc::E_INT && engine != TypeDesc::E_FLOAT)
+            {
+                return false;
+            }
+            if (!EmitValue(jmpCond->GetExp(), engine, 0))
+            {
+                return false;
+            }
+            EmitWord(engine == TypeDesc::E_INT ? OP_JMPCOND_I : OP_JMPCOND_F);
+            EmitWord(0);
+            EmitWord(jmpCond->GetComparison());
+            EmitLabel(jmpCond->GetLabel());
+            return true;
+        }
+    case Canon::T_RET:
+        EmitWord(OP_RET);
+        return true;
+    case Canon::T_PUSHFRAME:
+        EmitWord(OP_PUSHFRAME);
+        EmitWord(EmitConstant(static_cast<const Canon::PushFrame*>(n)->GetInfo(), K_FRAME));
+        return true;
+    case Canon::T_POPFRAME:
+        EmitWord(OP_POPFRAME);
+        return true;
+    case Canon::T_LOAD_ADDR:
+        {
+            const Canon::LoadAddr* ladr = static_cast<const Canon::LoadAddr*>(n);
+            if (!EmitAddress(ladr->GetExp(), 0))
+            {
+                return false;
+            }
+            EmitWord(OP_SETR);
+            EmitWord(ladr->GetRegister());
+            EmitWord(0);
+            return true;
+        }
+    case Canon::T_SAVE_TO_ADDR:
+        {
+            const Canon::SaveToAddr* savdr = static_cast<const Canon::SaveToAddr*>(n);
+            EmitWord(OP_SAVE_TO_ADDR);
+            EmitWord(savdr->GetLhs());
+            EmitWord(savdr->GetRhs());
+            return true;
+        }
+    case Canon::T_COPY_TO_ADDR:
+        {
+            const Canon::CopyToAddr* cadr = static_cast<const Canon::CopyToAddr*>(n);
+            EmitWord(OP_GETR);
+            EmitWord(0);
+            EmitWord(cadr->GetRegister());
+            Destination dest;
+            dest.mKind = Destination::D_SCRATCH;
+            dest.mFrame = 0;
+            dest.mOffset = 0;
+            dest.mReg = 0;
+            return EmitSaveExpression(dest, cadr->GetExp(), 1);
+        }
+    case Canon::T_CAST:
+        {
+            const Canon::Cast* cast = static_cast<const Canon::Cast*>(n);
+            EmitWord(cast->IsIntToFloat() ? OP_CAST_ITOF : OP_CAST_FTOI);
+            EmitWord(cast->GetRegister());
+            return true;
+        }
+    case Canon::T_READ_OBJ_PROP:
+    case Canon::T_WRITE_OBJ_PROP:
+        {
+            bool isRead = n->GetType() == Canon::T_READ_OBJ_PROP;
+            Ast::Exp* loc = isRead ? static_cast<const Canon::ReadObjProp*>(n)->GetLoc() : static_cast<const Canon::WriteObjProp*>(n)->GetLoc();
+            Ast::Exp* obj = isRead ? static_cast<const Canon::ReadObjProp*>(n)->GetObj() : static_cast<const Canon::WriteObjProp*>(n)->GetObj();
+            const PropertyNode* prop = isRead ? static_cast<const Canon::ReadObjProp*>(n)->GetProp() : static_cast<const Canon::WriteObjProp*>(n)->GetProp();
+            if (!EmitAddress(loc, 0) || !EmitAddress(obj, 1))
+            {
+                return false;
+            }
+            EmitWord(isRead ? OP_READ_PROP : OP_WRITE_PROP);
+            EmitWord(0);
+            EmitWord(1);
+            EmitWord(EmitConstant(prop, K_PROPERTY));
+            EmitWord(EmitConstant(obj->GetTypeDesc(), K_TYPE));
+            return true;
+        }
+    default:
+        return false;
+    }
+}
+
+bool BytecodeGenerator::Generate(const Assembly& assembly)
+{
+    PG_ASSERTSTR(mCode.mSize == 0, "Must call reset if planning to regenerate!");
+    const Container<Canon::Block>& blocks = *assembly.mBlocks;
+    int blockCount = blocks.Size();
+
+    for (int b = 0; b < blockCount; ++b)
+    {
+        const Canon::Block& block = blocks[b];
+        PG_ASSERT(block.GetLabel() == b);
+        mBlockOffsets.Push(mAllocator) = mCode.mSize;
+
+        const Container<Canon::CanonNode*>& stmts = block.GetStmts();
+        int stmtCount = stmts.Size();
+        for (int s = 0; s < stmtCount; ++s)
+        {
+            //open a new line entry when the source location changes. Nodes without a line keep the previous one
+            const Bytecode::LineEntry* last = mLines.mSize > 0 ? &mLines.mData[mLines.mSize - 1] : nullptr;
+            int line = stmts[s]->GetLine() != -1 || last == nullptr ? stmts[s]->GetLine() : last->mLine;
+            if (last == nullptr || last->mLine != line || last->mFunction != block.GetFunction())
+            {
+                Bytecode::LineEntry& entry = last != nullptr && last->mOffset == mCode.mSize ? mLines.mData[mLines.mSize - 1] : mLines.Push(mAllocator);
+                entry.mOffset = mCode.mSize;
+                entry.mLine = line;
+                entry.mFunction = block.GetFunction();
+            }
+
+            if (!EmitNode(stmts[s]))
+            {
+                Reset();
+                return false;
+            }
+        }
+
+        //blocks fall through to their next block. Make that explicit if the next block is not laid out next.
+        int next = block.NextBlock();
+        if (next != -1 && next != b + 1)
+        {
+            EmitWord(OP_JMP);
+            EmitLabel(next);
+        }
+    }
+
+    //patch all the labels to instruction offsets
+    for (int i = 0; i < mLabelPatches.mSize; ++i)
+    {
+        int& word = mCode.mData[mLabelPatches.mData[i]];
+        PG_ASSERT(word >= 0 && word < blockCount);
+        word = mBlockOffsets.mData[word];
+    }
+
+    mBytecode.mCode = mCode.mData;
+    mBytecode.mCodeSize = mCode.mSize;
+    mBytecode.mConstants = mConstants.mData;
+    mBytecode.mConstantKinds = mConstantKinds.mData;
+    mBytecode.mConstantCount = mConstants.mSize;
+    mBytecode.mBlockOffsets = mBlockOffsets.mData;
+    mBytecode.mBlockCount = mBlockOffsets.mSize;
+    mBytecode.mLines = mLines.mData;
+    mBytecode.mLineCount = mLines.mSize;
+    return true;
+}
@@ -14,6 +14,7 @@
 #include "Pegasus/BlockScript/BlockScriptAst.h"
 #include "Pegasus/BlockScript/bs.parser.hpp"
 #include "Pegasus/BlockScript/SymbolTable.h"
+#include "Pegasus/BlockScript/BsVm.h"
 #include "Pegasus/Allocator/IAllocator.h"
 #include "Pegasus/Allocator/Alloc.h"
 #include "Pegasus/Core/Assertion.h"
@@ -34,10 +35,11 @@ void Canonizer::Initialize(Alloc::IAllocator* alloc)
     mAllocator.Initialize(CANON_PAGE_SIZE, alloc);
     mBlocks.Initialize(mInternalAllocator);
     mFunBlockMap.Initialize(mInternalAllocator);
-    mStrPool.Initialize(alloc);
     mLabelMap.Initialize(alloc);
 
     mCurrentBlock = -1;
+    mCurrentFunction = -1;
+    mCurrentLine = -1;
     mRebuiltExpression = nullptr;
     mRebuiltExpList = nullptr;
 
@@ -46,6 +48,8 @@ void Canonizer::Initialize(Alloc::IAllocator* alloc)
     mSymbolTable = nullptr;
     mCurrentTempAllocationSize = 0;
     mNextLabel = 0;
+    mStackByteSize = 0;
+    mIsStackBounded = true;
 }
 
 
@@ -54,9 +58,10 @@ void Canonizer::Reset()
     mAllocator.Reset();
     mBlocks.Reset();
     mFunBlockMap.Reset();
-    mStrPool.Clear();
     mLabelMap.Reset();
     mCurrentBlock = -1;
+    mCurrentFunction = -1;
+    mCurrentLine = -1;
     mRebuiltExpression = nullptr;
     mCurrentFunDesc = nullptr;
     mRebuiltExpList = nullptr;
@@ -64,6 +69,8 @@ void Canonizer::Reset()
     mSymbolTable = nullptr;
     mCurrentTempAllocationSize = 0;
     mNextLabel = 0;
+    mStackByteSize = 0;
+    mIsStackBounded = true;
 }
 
 int Canonizer::CreateBlock()
@@ -81,32 +88,35 @@ void Canonizer::AddBlock(int id)
         curr.SetNextBlock(id);
     }
     mCurrentBlock = id;
+    mBlocks[id].SetFunction(mCurrentFunction);
 }
 
 void Canonizer::PushCanon(CanonNode* n)
 {
     Block& currBlock = mBlocks[mCurrentBlock];
     CanonNode*& newCanon = currBlock.GetStmts().PushEmpty();
+    n->SetLine(mCurrentLine);
     newCanon = n;
 }
 
 Idd* Canonizer::AllocateTemporal(const TypeDesc* typeDesc)
 {
     int requestSize = typeDesc->GetByteSize();
-    if (requestSize + mCurrentTempAllocationSize > mCurrentStackFrame->GetTempSize())
+    int offset = mCurrentTempAllocationSize;
+    if (StackFrameInfo::IsAlignedSlot(typeDesc))
     {
-        mCurrentStackFrame->AllocateTemporal(requestSize);
+        offset = StackFrameInfo::AlignSlot(offset);
     }
 
-    int offset = mCurrentTempAllocationSize;
-    mCurrentTempAllocationSize += requestSize;
-
-    char* idd = mStrPool.AllocateString();
-    idd[0] = '$';
-    idd[1] = 't';
-    idd[2] = '\0';
-    Idd* iddTree = CANON_NEW Idd(idd);
-    iddTree->SetOffset(mCurrentStackFrame->GetSize() + offset);
+    if (offset + requestSize > mCurrentStackFrame->GetTempSize())
+    {
+        mCurrentStackFrame->AllocateTemporal(offset + requestSize - mCurrentStackFrame->GetTempSize());
+    }
+
+    mCurrentTempAllocationSize = offset + requestSize;
+
+    Idd* iddTree = CANON_NEW Idd(mSymbolTable->GetStringPool()->Intern("$t"));
+    iddTree->SetOffset(mCurrentStackFrame->GetTempBase() + offset);
     iddTree->SetFrameOffset(0);
     iddTree->SetTypeDesc(typeDesc);
 
@@ -164,6 +174,9 @@ void Canonizer::BuildFunctionAsm()
         FunMapEntry& funBlockEntry = mFunBlockMap.PushEmpty();
         funBlockEntry.mFunDesc = fd;
         funBlockEntry.mAssemblyBlock = label;
+        funBlockEntry.mStackByteSize = 0;
+        mCurrentFunction = mFunBlockMap.Size() - 1;
+        mCurrentLine = fd->GetDec()->GetLine();
        
         AddBlock(label);
         mCurrentBlock = label;
@@ -175,6 +188,107 @@ void Canonizer::BuildFunctionAsm()
     }
 }
 
+void Canonizer::ComputeStackSizes()
+{
+    Container<int> marks;
+    marks.Initialize(mInternalAllocator);
+    for (int f = 0; f < mFunBlockMap.Size(); ++f)
+    {
+        marks.PushEmpty() = 0;
+    }
+
+    //the global frame is pushed first, without a frame record. Run then calls from the global code
+    int globalCalls = 0;
+    for (int b = 0; b < mBlocks.Size(); ++b)
+    {
+        const Block& block = mBlocks[b];
+        if (block.GetFunction() != -1)
+        {
+            continue;
+        }
+        const Container<CanonNode*>& stmts = block.GetStmts();
+        for (int s = 0; s < stmts.Size(); ++s)
+        {
+            if (stmts[s]->GetType() == T_FUNGO)
+            {
+                int callSize = ComputeFunGoStackSize(static_cast<const FunGo*>(stmts[s]), marks);
+                globalCalls = callSize > globalCalls ? callSize : globalCalls;
+            }
+        }
+    }
+
+    //once the globals are set, any function can be called on top of the global frame (see ExecuteFunction).
+    //Returned values that do not fit on a register are stored on the stack, right before the call
+    int deepestEntry = globalCalls;
+    for (int f = 0; f < mFunBlockMap.Size(); ++f)
+    {
+        const FunMapEntry& entry = mFunBlockMap[f];
+        int callSize = ComputeCallStackSize(f, marks);
+        int returnSize = entry.mFunDesc->GetDec()->GetReturnType()->GetByteSize();
+        int entrySize = callSize + (returnSize > CANON_REGISTER_BYTESIZE ? returnSize : 0);
+        deepestEntry = entrySize > deepestEntry ? entrySize : deepestEntry;
+    }
+
+    mStackByteSize = mSymbolTable->GetRootGlobalFrame()->GetTotalFrameSize() + deepestEntry;
+}
+
+int Canonizer::ComputeCallStackSize(int function, Container<int>& marks)
+{
+    FunMapEntry& entry = mFunBlockMap[function];
+    if (marks[function] == 2)
+    {
+        return entry.mStackByteSize;
+    }
+
+    int frameSize = static_cast<int>(sizeof(FrameInformation)) + entry.mFunDesc->GetDec()->GetFrame()->GetTotalFrameSize();
+    if (marks[function] == 1)
+    {
+        //recursion, the depth depends on runtime values. Only the frame is accounted for
+        mIsStackBounded = false;
+        return frameSize;
+    }
+
+    marks[function] = 1;
+    int deepestCall = 0;
+    bool isBounded = true;
+    for (int b = 0; b < mBlocks.Size(); ++b)
+    {
+        const Block& block = mBlocks[b];
+        if (block.GetFunction() != function)
+        {
+            continue;
+        }
+        const Container<CanonNode*>& stmts = block.GetStmts();
+        for (int s = 0; s < stmts.Size(); ++s)
+        {
+            if (stmts[s]->GetType() == T_FUNGO)
+            {
+                const FunGo* funGo = static_cast<const FunGo*>(stmts[s]);
+                int callSize = ComputeFunGoStackSize(funGo, marks);
+                deepestCall = callSize > deepestCall ? callSize : deepestCall;
+                int callee = funGo->GetLabel() == -1 ? -1 : mBlocks[funGo->GetLabel()].GetFunction();
+                isBounded = isBounded && (callee == -1 || (marks[callee] == 2 && mFunBlockMap[callee].mStackByteSize != -1));
+            }
+        }
+    }
+    marks[function] = 2;
+
+    //the reservation keeps counting the bounded part of recursive functions, the entry flags them
+    entry.mStackByteSize = isBounded ? frameSize + deepestCall : -1;
+    return frameSize + deepestCall;
+}
+
+int Canonizer::ComputeFunGoStackSize(const FunGo* funGo, Container<int>& marks)
+{
+    const FunDesc* funDesc = funGo->GetFunCall()->GetDesc();
+    if (funDesc->IsCallback())
+    {
+        //callbacks get a frame for their arguments, unless the vm passes them through the native argument buffer
+        return static_cast<int>(sizeof(FrameInformation)) + funDesc->GetDec()->GetFrame()->GetTotalFrameSize();
+    }
+    return ComputeCallStackSize(mBlocks[funGo->GetLabel()].GetFunction(), marks);
+}
+
 void Canonizer::Canonize(
         Program* program,
         SymbolTable* symbolTable
@@ -197,6 +311,7 @@ void Canonizer::Visit(Program* n)
     }
     PushCanon( CANON_NEW Exit());
     BuildFunctionAsm();
+    ComputeStackSizes();
 }
 
 void Canonizer::Visit(Exp* n)
@@ -227,6 +342,10 @@ void Canonizer::Visit(StmtList* n)
         ResetTemporals();
         if (head->GetStmt() != nullptr)
         {
+            if (head->GetStmt()->GetLine() != -1)
+            {
+                mCurrentLine = head->GetStmt()->GetLine();
+            }
             head->GetStmt()->Access(this);
             ResetTemporals();
         }
@@ -256,7 +375,7 @@ static const PropertyNode* FindPropertyNode(const TypeDesc* type, const char* na
     const PropertyNode* propNode = type->GetPropertyNode();
     while (propNode != nullptr)
     {
-        if (!Utils::Strcmp(propNode->mName, name))
+        if (propNode->mName == name)
         {
             return propNode;
         }
@@ -329,6 +448,7 @@ void Canonizer::HandleArrayAccessOperator(Binop* n)
 
         Binop* finalReference = CANON_NEW Binop(lhsBinop->GetLhs(), O_ACCESS,offsetExp);
         finalReference->SetTypeDesc(arrayType);
+        finalReference->SetIndexInRange(n->IsIndexInRange() && lhsBinop->IsIndexInRange());
         mRebuiltExpression = finalReference;
     }
     else
@@ -346,6 +466,7 @@ void Canonizer::HandleArrayAccessOperator(Binop* n)
         offsetExp->SetTypeDesc(rhs->GetTypeDesc());
         Binop* finalReference = CANON_NEW Binop(lhs, O_ACCESS, offsetExp);
         finalReference->SetTypeDesc(arrayType);
+        finalReference->SetIndexInRange(n->IsIndexInRange());
         mRebuiltExpression = finalReference;
     }
 }
@@ -511,6 +632,7 @@ void Canonizer::HandleSetOperator(Binop* n)
                 destOffsetNode->SetTypeDesc(finalDestinationArrIndex->GetTypeDesc());
                 Binop* destBinop = CANON_NEW Binop(finalDestinationArr,O_ACCESS,destOffsetNode);
                 destBinop->SetTypeDesc(child);
+                destBinop->SetIndexInRange(static_cast<Binop*>(finalDestination)->IsIndexInRange());
 
                 Idd* srcIdd = CANON_NEW Idd(nullptr);
                 srcIdd->SetOffset(resultTemp->GetOffset() + i * child->GetByteSize());
@@ -604,6 +726,7 @@ void Canonizer::HandleNonContinuousSwizzle(Exp* targetExp, Idd* swizzle, const T
 
             Binop* targetOffsetted = CANON_NEW Binop(binopLhs->GetLhs(),O_ACCESS,newOffset);
             targetOffsetted->SetTypeDesc(child);
+            targetOffsetted->SetIndexInRange(binopLhs->IsIndexInRange());
 
             PushCanon( CANON_NEW Move(tempOffsetted, targetOffsetted) );
         }
@@ -682,6 +805,7 @@ void Canonizer::HandleDotOperator(Binop* n)
 
             Binop* newBinop = CANON_NEW Binop(lhsBinop->GetLhs(), O_ACCESS, newOffsetExp);
             newBinop->SetTypeDesc(n->GetTypeDesc());
+            newBinop->SetIndexInRange(lhsBinop->IsIndexInRange());
             
             mRebuiltExpression = newBinop;
         }
@@ -701,6 +825,7 @@ void Canonizer::HandleDotOperator(Binop* n)
 
                 Binop* newBinop = CANON_NEW Binop(lhsBinop->GetLhs(), O_ACCESS, newOffsetExp);
                 newBinop->SetTypeDesc(n->GetTypeDesc());
+                newBinop->SetIndexInRange(lhsBinop->IsIndexInRange());
                 
                 mRebuiltExpression = newBinop;
             }
@@ -784,11 +909,10 @@ void Canonizer::Visit(Unop* unop)
             else if (targetType->GetAluEngine() >= TypeDesc::E_FLOAT2 && targetType->GetAluEngine() <= TypeDesc::E_FLOAT4)
             {
                 //no need to process the internal expression since the visitor will take care of this for us.
-                char* funName = mStrPool.AllocateString();
-                funName[0] = '\0';
-                Utils::Strcat(funName, "float");
-                funName[5] = '0' + targetType->GetAluEngine() - TypeDesc::E_FLOAT2 + 2;
-                funName[6] = '\0';
+                char funNameStr[7] = "float";
+                funNameStr[5] = '0' + targetType->GetAluEngine() - TypeDesc::E_FLOAT2 + 2;
+                funNameStr[6] = '\0';
+                const char* funName = mSymbolTable->GetStringPool()->Intern(funNameStr);
                 //create the argument
                 ExpList* arguments = CANON_NEW ExpList();
                 arguments->SetExp(unop->GetExp());
@@ -975,8 +1099,22 @@ void Canonizer::Visit(StrImm* n)
 
 void Canonizer::Visit(StmtExp* n)
 {
-    //process the expression, that is remove all fun calls embedded
-    n->GetExp()->Access(this);
+    Exp* exp = n->GetExp();
+    if (mDropUnusedTemporaries && exp->GetExpType() == FunCall::sType && exp->GetTypeDesc()->GetByteSize() <= CANON_REGISTER_BYTESIZE)
+    {
+        //the return value is discarded, no need for a temporal to save it
+        FunCall* funCall = static_cast<FunCall*>(exp);
+        ProcessFunctionExpressionList(funCall);
+        Idd* retTemp = BeginSaveRet();
+        ProcessFunCall(funCall);
+        EndSaveRet(retTemp);
+        mRebuiltExpression = nullptr;
+    }
+    else
+    {
+        //process the expression, that is remove all fun calls embedded
+        exp->Access(this);
+    }
 }
 
 void Canonizer::Visit(StmtFunDec* n)
@@ -996,12 +1134,8 @@ void Canonizer::Visit(StmtIfElse* n)
     n->GetExp()->Access(this);
     JmpCond* lastJmp = CANON_NEW JmpCond(mRebuiltExpression, 0);
     PushCanon(lastJmp);
-    StackFrameInfo* prevFrame = mCurrentStackFrame;
-    mCurrentStackFrame = n->GetFrame();
-    PushCanon( CANON_NEW PushFrame(n->GetFrame()) );
+    //block frames are flattened into the storage frame, no frames are pushed for if statements
     n->GetStmtList()->Access(this);
-    PushCanon( CANON_NEW PopFrame() );
-    mCurrentStackFrame = prevFrame;
     
     int endBlock = CreateBlock();
     StmtIfElse* tail = n->GetTail();
@@ -1018,6 +1152,7 @@ void Canonizer::Visit(StmtIfElse* n)
             int currentBlock = CreateBlock();
             lastJmp->SetLabel(currentBlock);
             AddBlock( currentBlock );
+            mCurrentLine = tail->GetLine();
             if (tail->GetExp() != nullptr)
             {
                 tail->GetExp()->Access(this);
@@ -1028,12 +1163,7 @@ void Canonizer::Visit(StmtIfElse* n)
             {
                 lastJmp = nullptr;
             }
-            prevFrame = mCurrentStackFrame;
-            mCurrentStackFrame = tail->GetFrame();
-            PushCanon( CANON_NEW PushFrame(tail->GetFrame()) );
             tail->GetStmtList()->Access(this);
-            PushCanon( CANON_NEW PopFrame() );
-            mCurrentStackFrame = prevFrame;
             tail = tail->GetTail();
             if (tail != nullptr)
             {
@@ -1052,28 +1182,22 @@ void Canonizer::Visit(StmtWhile* n)
     int topLabel = CreateBlock();
     int endLabel = CreateBlock();
 
-    StackFrameInfo* prevFrame = mCurrentStackFrame;
-    mCurrentStackFrame = n->GetFrame();
-    PushCanon( CANON_NEW PushFrame( n->GetFrame() ) );
+    //block frames are flattened into the storage frame, no frames are pushed for loops
     AddBlock(topLabel);
     n->GetExp()->Access(this);
     JmpCond* jmp = CANON_NEW JmpCond(mRebuiltExpression, 0);
     PushCanon( jmp );
     n->GetStmtList()->Access(this);
+    mCurrentLine = n->GetLine();
     PushCanon( CANON_NEW Jmp( topLabel ) );
     jmp->SetLabel(endLabel);
     AddBlock(endLabel);
-    mCurrentStackFrame = prevFrame;
-    PushCanon( CANON_NEW PopFrame() );
 }
 
 void Canonizer::Visit(StmtFor* forLoop)
 {
     int topLabel = CreateBlock();
     int endLabel = CreateBlock();
-    StackFrameInfo* prevFrame = mCurrentStackFrame;
-    mCurrentStackFrame = forLoop->GetFrame();
-    PushCanon( CANON_NEW PushFrame( forLoop->GetFrame() ) );
 
     if (forLoop->GetInit() != nullptr)
     {
@@ -1090,6 +1214,7 @@ void Canonizer::Visit(StmtFor* forLoop)
 
     forLoop->GetStmtList()->Access(this);
 
+    mCurrentLine = forLoop->GetLine();
     if (forLoop->GetUpdate() != nullptr)
     {
         forLoop->GetUpdate()->Access(this);
@@ -1097,8 +1222,6 @@ void Canonizer::Visit(StmtFor* forLoop)
 
     PushCanon( CANON_NEW Jmp(topLabel) );
     AddBlock(endLabel);
-    mCurrentStackFrame = prevFrame;
-    PushCanon( CANON_NEW PopFrame() );
 }
 
 void Canonizer::Visit(StmtStructDef* n)
@@ -1124,12 +1247,7 @@ void Canonizer::Visit(StmtReturn* n)
         PushCanon( CANON_NEW CopyToAddr(R_RET, mRebuiltExpression, typeDesc->GetByteSize()));
     }
 
-    //TODO: ugh improve this!!
-    StackFrameInfo* theFrame = mCurrentStackFrame;
-    while (theFrame->GetCreatorCategory() != StackFrameInfo::FUN_BODY)
-    {
-        theFrame = theFrame->GetParentStackFrame();
-        PushCanon( CANON_NEW PopFrame );
-    }
+    //block frames are flattened, so the function frame is the only frame to pop
+    PG_ASSERT(mCurrentStackFrame->GetCreatorCategory() == StackFrameInfo::FUN_BODY);
     PushCanon( CANON_NEW Ret );
 }
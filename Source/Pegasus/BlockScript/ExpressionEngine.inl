@@ -15,9 +15,14 @@ namespace Pegasus
 namespace BlockScript
 {
 
-template<class IntrinsicType> IntrinsicType& ExpressionEngine<IntrinsicType>::Eval(Ast::Exp* exp, BsVmState& state)
+template<class IntrinsicType> IntrinsicType ExpressionEngine<IntrinsicType>::Eval(Ast::Exp* exp, BsVmState& state)
+{
+    ExpressionEngine<IntrinsicType> engine(state);
+    return engine.Run(exp);
+}
+
+template<class IntrinsicType> IntrinsicType& ExpressionEngine<IntrinsicType>::Run(Ast::Exp* exp)
 {
-    mState = &state;
     exp->Access(this);
     return mResult;
 }
@@ -50,7 +55,7 @@ template<class IntrinsicType> IntrinsicType* ExpressionEngine<IntrinsicType>::Ge
     PG_ASSERT(lhs->GetTypeDesc()->GetModifier() == TypeDesc::M_ARRAY || lhs->GetTypeDesc()->GetModifier() == TypeDesc::M_VECTOR);
 
     Ast::Idd* lhsIdd = static_cast<Ast::Idd*>(lhs);
-    int rhsOffset = gIntExpEngine.Eval(rhs, *mState);
+    int rhsOffset = ExpressionEngine_Int::Eval(rhs, *mState);
 
     char* memLoc = reinterpret_cast<char*>(GetIddMem(lhsIdd, *mState)) + rhsOffset; 
 
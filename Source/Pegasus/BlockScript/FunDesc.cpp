@@ -21,7 +21,7 @@ using namespace Pegasus::BlockScript;
 using namespace Pegasus::BlockScript::Ast;
 
 FunDesc::FunDesc()
-: mGuid(-1), mFunDec(nullptr), mCallback(nullptr), mInputArgumentByteSize(0), mIsMethod(false)
+: mGuid(-1), mFunDec(nullptr), mCallback(nullptr), mPureIntrinsic(PURE_NONE), mInputArgumentByteSize(0), mIsMethod(false)
 {
 }
 
@@ -51,7 +51,7 @@ bool FunDesc::Equals(const FunDesc* other) const
 
 bool FunDesc::AreSignaturesEqual(const char* name, Ast::ArgList* argList) const
 {
-    if (Utils::Strcmp(name, mFunDec->GetName()))
+    if (name != mFunDec->GetName())
     {
         return false;
     }
@@ -83,7 +83,7 @@ bool FunDesc::AreSignaturesEqual(const char* name, Ast::ArgList* argList) const
 
 bool FunDesc::AreSignaturesEqual(const char* name, Ast::ExpList* argList) const
 {
-    if (Utils::Strcmp(name, mFunDec->GetName()))
+    if (name != mFunDec->GetName())
     {
         return false;
     }
@@ -30,23 +30,28 @@ FunTable::~FunTable()
 void FunTable::Initialize(Alloc::IAllocator* alloc)
 {
     mContainer.Initialize(alloc);
+    mIndex.Initialize(alloc);
 }
 
 void FunTable::Reset()
 {
     mContainer.Reset();
+    mIndex.Reset();
 }
 
 FunDesc* FunTable::Find(Ast::FunCall* funCall)
 {
-    int sz = mContainer.Size();
+    return Find(funCall, IddStrPool::GetHash(funCall->GetName()));
+}
 
-    for (int i = 0; i < sz; ++i)
+FunDesc* FunTable::Find(Ast::FunCall* funCall, unsigned int hash)
+{
+    for (int c = mIndex.Find(hash); c != -1; c = mIndex.Next(c))
     {
-        FunDesc& candidate = mContainer[i];
+        FunDesc& candidate = mContainer[mIndex.GetValue(c)];
         if (candidate.IsCompatible(funCall))
         {
-            PG_ASSERT(candidate.GetGuid() == i);
+            PG_ASSERT(candidate.GetGuid() == mIndex.GetValue(c));
             return &candidate;
         }
     }
@@ -57,10 +62,11 @@ FunDesc* FunTable::Find(Ast::FunCall* funCall)
 FunDesc* FunTable::Insert(StmtFunDec* funDec)
 {
     int sz = mContainer.Size();
+    unsigned int hash = IddStrPool::GetHash(funDec->GetName());
     FunDesc* foundDeclaration = nullptr;
-    for (int i = 0; i < sz; ++i)
+    for (int c = mIndex.Find(hash); c != -1; c = mIndex.Next(c))
     {
-        FunDesc& candidate = mContainer[i];
+        FunDesc& candidate = mContainer[mIndex.GetValue(c)];
         if (
             candidate.IsCompatible(funDec) 
         )
@@ -72,7 +78,7 @@ FunDesc* FunTable::Insert(StmtFunDec* funDec)
             }
             else
             {
-                PG_ASSERT(candidate.GetGuid() == i);
+                PG_ASSERT(candidate.GetGuid() == mIndex.GetValue(c));
                 foundDeclaration = &candidate;
             }
         }
@@ -83,9 +89,9 @@ FunDesc* FunTable::Insert(StmtFunDec* funDec)
     {
         foundDeclaration = &(mContainer.PushEmpty());
         foundDeclaration->SetGuid(sz);
+        mIndex.Insert(hash, sz);
     }
 
     foundDeclaration->Initialize(funDec);
 	return foundDeclaration;
 }
-
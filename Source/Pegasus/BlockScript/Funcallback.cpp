@@ -114,10 +114,82 @@ FunBindPoint Pegasus::BlockScript::GetFunctionBindPoint(
     return FUN_INVALID_BIND_POINT;
 }
 
+//number of jumps the bytecode interpreter runs before giving control back to ExecuteFunction
+#define BYTECODE_EXECUTION_SLICE 64
+
 //ideally we want to keep these hidden.. but this is an exception... as we will reuse some state code
 extern void PushFrameCommand(const StackFrameInfo* info, BsVmState& state, const Container<GlobalMapEntry>* globalsInitData);
 extern void PopFrameCommand(BsVmState& state);
 
+//! runs the function call started on a state until it returns, is suspended or runs out of budget.
+//! Once it returns, copies its result to the output buffer and releases it.
+//! \return false if the execution was broken because it took too long
+static bool RunFunction(const Assembly& assembly, BsVmState& state, BsVm& vm, void* outputBuffer, int outputBufferSize, int budget)
+{
+    //run until we are done
+#if PEGASUS_ENABLE_PROXIES
+    int loopCount = 0;
+    const int CheckTimeLoopCount = 100;
+    Pegasus::Core::UpdatePegasusTime();
+    double capturedTime = Pegasus::Core::GetPegasusTime();
+#endif
+    while (state.GetStackLevels() != 0 && state.GetExecutionState() == BsVmState::Alive)
+    {
+        //the execution runs in slices of jumps, the time check below happens in between
+        int slice = budget < 0 || budget > BYTECODE_EXECUTION_SLICE ? BYTECODE_EXECUTION_SLICE : budget;
+        if (!vm.RunSlice(assembly, state, 0, slice))
+        {
+            break;
+        }
+        if (budget >= 0 && (budget -= slice) <= 0)
+        {
+            state.SetExecutionState(BsVmState::Suspended);
+            return true;
+        }
+#if PEGASUS_ENABLE_PROXIES
+        bool checkTime = loopCount == CheckTimeLoopCount;
+        if (checkTime)
+        {
+            loopCount = 0;
+            Pegasus::Core::UpdatePegasusTime();
+            double newTime = Pegasus::Core::GetPegasusTime();
+            if (newTime - capturedTime > 4.0)
+            {
+                state.SetReg(Canon::R_IP, state.GetResumeIp());
+                PG_FAILSTR("Blockscript is taking too long to execute. Infinite loop? breaking execution. Warning: this can leave the VM in a devastated state.");
+                return false;
+            }
+        }
+        ++loopCount;
+        
+#endif
+    }
+
+    if (state.GetExecutionState() == BsVmState::Suspended)
+    {
+        //the frames stay on the stack until the call is resumed
+        return true;
+    }
+
+    //copy the result to the output buffer
+    if (outputBufferSize <= CANON_REGISTER_BYTESIZE)
+    {
+        int* retPtr = state.GetRegBuffer() + Canon::R_RET;
+        Utils::Memcpy(outputBuffer, retPtr, outputBufferSize);
+    }
+    else
+    {
+        char* retPtr = state.Ram() + state.GetReg(Canon::R_RET);
+        Utils::Memcpy(outputBuffer, retPtr, outputBufferSize);
+        state.Shrink(outputBufferSize);
+        state.SetReg(Canon::R_ESP, state.GetReg(Canon::R_ESP) - outputBufferSize);
+    }
+
+    //save ip
+    state.SetReg(Canon::R_IP, state.GetResumeIp());
+    return true;
+}
+
 bool Pegasus::BlockScript::ExecuteFunction(
     FunBindPoint bindPoint,
     BlockScriptBuilder* builder, 
@@ -127,7 +199,8 @@ bool Pegasus::BlockScript::ExecuteFunction(
     const void* inputBuffer,
     int   inputBufferSize,
     void* outputBuffer,
-    int   outputBufferSize
+    int   outputBufferSize,
+    int   budget
 )
 {
     if (bindPoint == FUN_INVALID_BIND_POINT || state.GetExecutionState() != BsVmState::Alive)
@@ -148,6 +221,9 @@ bool Pegasus::BlockScript::ExecuteFunction(
         if (funDec->GetReturnType()->GetByteSize() == outputBufferSize &&
             funDesc->GetInputArgumentsByteSize() == inputBufferSize)
         {
+            //the stack of the assembly is normally reserved by its run already
+            state.Reserve(assembly.mStackByteSize);
+
             //we allocte a temporal buffer if the result is big.
             if (outputBufferSize > CANON_REGISTER_BYTESIZE)
             {
@@ -159,8 +235,8 @@ bool Pegasus::BlockScript::ExecuteFunction(
             //first push the new stack
             PushFrameCommand(funDec->GetFrame(), state, nullptr);
 
-            //save ip
-            int savedIp = state.GetReg(Canon::R_IP);
+            //save ip, restored once the call returns
+            state.SetResumeInfo(0, state.GetReg(Canon::R_IP), outputBufferSize);
 
             //registers have been saved, lets now set the address of this function
             state.SetReg(Canon::R_B,  funMapEntry.mAssemblyBlock);
@@ -172,53 +248,12 @@ bool Pegasus::BlockScript::ExecuteFunction(
             //copy the inputs to the stack
             Utils::Memcpy(stackBase, inputBuffer, inputBufferSize);
 
-            //run until we are done
-#if PEGASUS_ENABLE_PROXIES
-            int loopCount = 0;
-            const int CheckTimeLoopCount = 100;
-            Pegasus::Core::UpdatePegasusTime();
-            double capturedTime = Pegasus::Core::GetPegasusTime();
-#endif
-            while (state.GetStackLevels() != 0)
-            {
-                vm.StepExecution(assembly, state);
-#if PEGASUS_ENABLE_PROXIES
-                bool checkTime = loopCount == CheckTimeLoopCount;
-                if (checkTime)
-                {
-                    loopCount = 0;
-                    Pegasus::Core::UpdatePegasusTime();
-                    double newTime = Pegasus::Core::GetPegasusTime();
-                    if (newTime - capturedTime > 4.0)
-                    {
-                        state.SetReg(Canon::R_IP, savedIp);
-                        PG_FAILSTR("Blockscript is taking too long to execute. Infinite loop? breaking execution. Warning: this can leave the VM in a devastated state.");
-                        return false;
-                    }
-                }
-                ++loopCount;
-                
-#endif
-            }
-
-            //copy the result to the output buffer
-            if (outputBufferSize <= CANON_REGISTER_BYTESIZE)
+            if (vm.UsesBytecode(assembly))
             {
-                int* retPtr = state.GetRegBuffer() + Canon::R_RET;
-                Utils::Memcpy(outputBuffer, retPtr, outputBufferSize);
-            }
-            else
-            {
-                char* retPtr = state.Ram() + state.GetReg(Canon::R_RET);
-                Utils::Memcpy(outputBuffer, retPtr, outputBufferSize);
-                state.Shrink(outputBufferSize);
-                state.SetReg(Canon::R_ESP, state.GetReg(Canon::R_ESP) - outputBufferSize);
+                state.SetReg(Canon::R_IP, assembly.mBytecode->mBlockOffsets[funMapEntry.mAssemblyBlock]);
             }
 
-            //save ip
-            state.SetReg(Canon::R_IP, savedIp);
-
-            return true;
+            return RunFunction(assembly, state, vm, outputBuffer, outputBufferSize, budget);
             
         }
         else
@@ -233,6 +268,42 @@ bool Pegasus::BlockScript::ExecuteFunction(
     }
 }
 
+bool Pegasus::BlockScript::ResumeFunction(
+    const Assembly& assembly,
+    BsVmState& state,
+    BsVm& vm,
+    void* outputBuffer,
+    int   outputBufferSize,
+    int   budget
+)
+{
+    if (state.GetExecutionState() != BsVmState::Suspended || state.GetResumeStackLevel() != 0 || state.GetResumeOutputByteSize() != outputBufferSize)
+    {
+        return false;
+    }
+
+    state.SetExecutionState(BsVmState::Alive);
+    return RunFunction(assembly, state, vm, outputBuffer, outputBufferSize, budget);
+}
+
+void Pegasus::BlockScript::CancelFunction(BsVmState& state)
+{
+    PG_ASSERT(state.GetExecutionState() == BsVmState::Suspended && state.GetResumeStackLevel() == 0);
+
+    //unwind the frames of the call, then the buffer of its result
+    while (state.GetStackLevels() > 0)
+    {
+        PopFrameCommand(state);
+    }
+    if (state.GetResumeOutputByteSize() > CANON_REGISTER_BYTESIZE)
+    {
+        state.Shrink(state.GetResumeOutputByteSize());
+        state.SetReg(Canon::R_ESP, state.GetReg(Canon::R_ESP) - state.GetResumeOutputByteSize());
+    }
+    state.SetReg(Canon::R_IP, state.GetResumeIp());
+    state.SetExecutionState(BsVmState::Alive);
+}
+
 int Pegasus::BlockScript::ReadGlobalValue(
     GlobalBindPoint bindPoint,
     const Assembly& assembly,
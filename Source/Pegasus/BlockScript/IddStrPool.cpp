@@ -7,19 +7,21 @@
 //! \file   IddStrPool.cpp
 //! \author Kleber Garcia
 //! \date   31th August 2014
-//! \brief  String pool allocator class implementation
+//! \brief  String interner class implementation
 
 #include "Pegasus/Core/Assertion.h"
 #include "Pegasus/BlockScript/IddStrPool.h"
 #include "Pegasus/Allocator/IAllocator.h"
 #include "Pegasus/Memory/MemoryManager.h"
+#include "Pegasus/Utils/Memcpy.h"
+#include "Pegasus/Utils/String.h"
 
 using namespace Pegasus;
 using namespace Pegasus::BlockScript;
 
 IddStrPool::IddStrPool()
 : mAllocator(nullptr),
-  mStringCount(0)
+  mPageUsed(sPageByteSize)
 {
 }
 
@@ -30,53 +32,98 @@ IddStrPool::~IddStrPool()
 
 void IddStrPool::Initialize(Alloc::IAllocator* allocator)
 {
-    PG_ASSERT(mStringCount == 0);
+    PG_ASSERT(GetStringCount() == 0);
     mAllocator = allocator;
+    mPages.Initialize(allocator);
+    mStrings.Initialize(allocator);
+    mIndex.Initialize(allocator);
 }
 
 void IddStrPool::Clear()
 {
-	int pageSize = GetPageCount();
-    for (int i = 0; i < pageSize; ++i)
+    std::lock_guard<std::mutex> lock(mLock);
+    for (int i = 0; i < mPages.Size(); ++i)
     {
         mAllocator->Delete(mPages[i]);
     }
-    mStringCount = 0;
+    mPages.Reset();
+    mStrings.Reset();
+    mIndex.Reset();
+    mPageUsed = sPageByteSize;
 }
 
-//lazily allocate a page (a set of strings) when required.
-char* IddStrPool::AllocateString()
+const char* IddStrPool::Intern(const char* str)
 {
-    if (GetStringCount() < sMaxStrings)
+    unsigned int hash = NameIndex::Hash(str);
+    std::lock_guard<std::mutex> lock(mLock);
+    const char* handle = Find(str, hash);
+    if (handle != nullptr)
     {
-        int newStringCount = mStringCount + 1;
-        int targetPage = newStringCount / sMaxStringsPerPages;
+        return handle;
+    }
+
+    //a record is the hash followed by the characters, padded so the next hash is aligned
+    int length = Utils::Strlen(str) + 1;
+    int recordSize = (static_cast<int>(sizeof(unsigned int)) + length + 3) & ~3;
+    char* record = AllocateRecord(recordSize);
+    *reinterpret_cast<unsigned int*>(record) = hash;
+    char* newStr = record + sizeof(unsigned int);
+    Utils::Memcpy(newStr, str, length);
+
+    mIndex.Insert(hash, mStrings.Size());
+    mStrings.PushEmpty() = newStr;
+    return newStr;
+}
 
-        if (targetPage >= GetPageCount())
+const char* IddStrPool::Find(const char* str) const
+{
+    unsigned int hash = NameIndex::Hash(str);
+    std::lock_guard<std::mutex> lock(mLock);
+    return Find(str, hash);
+}
+
+const char* IddStrPool::Find(const char* str, unsigned int hash) const
+{
+    for (int c = mIndex.Find(hash); c != -1; c = mIndex.Next(c))
+    {
+        const char* candidate = mStrings[mIndex.GetValue(c)];
+        if (!Utils::Strcmp(candidate, str))
         {
-            PG_ASSERT(targetPage == GetPageCount());
-            AllocatePage();    
+            return candidate;
         }
-        
-        char* mem = mPages[targetPage] + ((mStringCount*sCharsPerString) % sPageByteSize);
-        mStringCount = newStringCount;
-        return mem;
-    }
-    else
-    {
-        return nullptr;
     }
+    return nullptr;
 }
 
-void IddStrPool::AllocatePage()
+//lazily allocate a page (a set of strings) when required.
+char* IddStrPool::AllocateRecord(int byteSize)
 {
-    if (GetPageCount() < sMaxPages)
+    if (byteSize > sPageByteSize)
     {
-        int newPage = GetPageCount();
-        mPages[newPage] = static_cast<char*>(mAllocator->Alloc(sPageByteSize, Alloc::PG_MEM_TEMP, -1, "IddStringPool::mPage", __FILE__, __LINE__));
+        //long strings get a page of their own. The current page keeps being filled
+        char* page = static_cast<char*>(mAllocator->Alloc(byteSize, Alloc::PG_MEM_TEMP, -1, "IddStringPool::mPage", __FILE__, __LINE__));
+        if (mPages.Size() > 0)
+        {
+            //keep the partially filled page last
+            char* last = mPages[mPages.Size() - 1];
+            mPages[mPages.Size() - 1] = page;
+            mPages.PushEmpty() = last;
+        }
+        else
+        {
+            mPages.PushEmpty() = page;
+            mPageUsed = sPageByteSize;
+        }
+        return page;
     }
-    else
+
+    if (mPageUsed + byteSize > sPageByteSize)
     {
-        PG_FAILSTR("Attempting to allocate too many pages for strings.");
+        mPages.PushEmpty() = static_cast<char*>(mAllocator->Alloc(sPageByteSize, Alloc::PG_MEM_TEMP, -1, "IddStringPool::mPage", __FILE__, __LINE__));
+        mPageUsed = 0;
     }
+
+    char* mem = mPages[mPages.Size() - 1] + mPageUsed;
+    mPageUsed += byteSize;
+    return mem;
 }
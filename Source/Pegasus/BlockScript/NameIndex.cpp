@@ -0,0 +1,145 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                       Pegasus                                        */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file   NameIndex.cpp
+//! \author agent
+//! \date   16th October 2026
+//! \brief  Hash index of names, used by the symbol tables to look up types, enums and functions.
+
+#include "Pegasus/BlockScript/NameIndex.h"
+#include "Pegasus/Allocator/IAllocator.h"
+#include "Pegasus/Allocator/Alloc.h"
+#include "Pegasus/Core/Assertion.h"
+#include "Pegasus/Utils/Memcpy.h"
+
+using namespace Pegasus;
+using namespace Pegasus::BlockScript;
+
+#define NAME_INDEX_INITIAL_CAPACITY 32
+
+NameIndex::NameIndex()
+:   mAllocator(nullptr),
+    mBuckets(nullptr),
+    mEntries(nullptr),
+    mBucketCount(0),
+    mCapacity(0),
+    mCount(0)
+{
+}
+
+NameIndex::~NameIndex()
+{
+    Reset();
+}
+
+void NameIndex::Initialize(Alloc::IAllocator* alloc)
+{
+    mAllocator = alloc;
+}
+
+void NameIndex::Reset()
+{
+    if (mBuckets != nullptr)
+    {
+        PG_DELETE_ARRAY(mAllocator, mBuckets);
+        PG_DELETE_ARRAY(mAllocator, mEntries);
+        mBuckets = nullptr;
+        mEntries = nullptr;
+    }
+    mBucketCount = 0;
+    mCapacity = 0;
+    mCount = 0;
+}
+
+unsigned int NameIndex::Hash(const char* name)
+{
+    PG_ASSERT(name != nullptr);
+    //fnv-1a
+    unsigned int hash = 2166136261u;
+    for (const char* c = name; *c != '\0'; ++c)
+    {
+        hash = (hash ^ static_cast<unsigned char>(*c)) * 16777619u;
+    }
+    return hash;
+}
+
+void NameIndex::Link(int entry)
+{
+    mEntries[entry].mNext = -1;
+    int* slot = &mBuckets[mEntries[entry].mHash & (mBucketCount - 1)];
+    while (*slot != -1)
+    {
+        slot = &mEntries[*slot].mNext;
+    }
+    *slot = entry;
+}
+
+void NameIndex::Grow()
+{
+    PG_ASSERTSTR(mAllocator != nullptr, "NameIndex must be initialized before inserting.");
+    int newCapacity = mCapacity == 0 ? NAME_INDEX_INITIAL_CAPACITY : 2 * mCapacity;
+    Entry* newEntries = PG_NEW_ARRAY(mAllocator, -1, "BlockScript NameIndex", Alloc::PG_MEM_TEMP, Entry, newCapacity);
+    if (mEntries != nullptr)
+    {
+        Utils::Memcpy(newEntries, mEntries, mCount * sizeof(Entry));
+        PG_DELETE_ARRAY(mAllocator, mEntries);
+        PG_DELETE_ARRAY(mAllocator, mBuckets);
+    }
+    mEntries = newEntries;
+    mCapacity = newCapacity;
+
+    //as many buckets as entries, so chains stay short
+    mBucketCount = newCapacity;
+    mBuckets = PG_NEW_ARRAY(mAllocator, -1, "BlockScript NameIndex", Alloc::PG_MEM_TEMP, int, mBucketCount);
+    for (int b = 0; b < mBucketCount; ++b)
+    {
+        mBuckets[b] = -1;
+    }
+
+    //relink in insertion order, so each chain keeps its order
+    for (int e = 0; e < mCount; ++e)
+    {
+        Link(e);
+    }
+}
+
+void NameIndex::Insert(unsigned int hash, int value)
+{
+    if (mCount == mCapacity)
+    {
+        Grow();
+    }
+    int entry = mCount++;
+    mEntries[entry].mHash = hash;
+    mEntries[entry].mValue = value;
+    Link(entry);
+}
+
+int NameIndex::Find(unsigned int hash) const
+{
+    if (mCount == 0)
+    {
+        return -1;
+    }
+    int cursor = mBuckets[hash & (mBucketCount - 1)];
+    while (cursor != -1 && mEntries[cursor].mHash != hash)
+    {
+        cursor = mEntries[cursor].mNext;
+    }
+    return cursor;
+}
+
+int NameIndex::Next(int cursor) const
+{
+    PG_ASSERT(cursor >= 0 && cursor < mCount);
+    unsigned int hash = mEntries[cursor].mHash;
+    cursor = mEntries[cursor].mNext;
+    while (cursor != -1 && mEntries[cursor].mHash != hash)
+    {
+        cursor = mEntries[cursor].mNext;
+    }
+    return cursor;
+}
@@ -0,0 +1,738 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                       Pegasus                                        */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file   Optimizer.cpp
+//! \author agent
+//! \date   16th October 2026
+//! \brief  AST optimization pass, runs between the builder and the canonizer.
+//!         Folds constant expressions and removes dead code, rewriting the AST in place.
+
+#include "Pegasus/BlockScript/Optimizer.h"
+#include "Pegasus/BlockScript/BlockScriptAst.h"
+#include "Pegasus/BlockScript/TypeDesc.h"
+#include "Pegasus/BlockScript/FunDesc.h"
+#include "Pegasus/BlockScript/bs.parser.hpp"
+#include "Pegasus/Allocator/IAllocator.h"
+#include "Pegasus/Allocator/Alloc.h"
+#include "Pegasus/Core/Assertion.h"
+#include "Pegasus/Utils/String.h"
+#include "Pegasus/Utils/Memset.h"
+
+using namespace Pegasus;
+using namespace Pegasus::BlockScript;
+using namespace Pegasus::BlockScript::Ast;
+
+#define OPT_NEW PG_NEW(mAllocator, -1, "BlockScript::Ast", Pegasus::Alloc::PG_MEM_TEMP)
+
+//! \return the number of float components of a vector alu engine, 0 if not a vector
+static int GetVectorComponents(TypeDesc::AluEngine engine)
+{
+    return engine >= TypeDesc::E_FLOAT2 && engine <= TypeDesc::E_FLOAT4 ? engine - TypeDesc::E_FLOAT2 + 2 : 0;
+}
+
+//! integer arithmetic wraps around, the same way the vm does in practice
+static int WrapAdd(int a, int b) { return static_cast<int>(static_cast<unsigned int>(a) + static_cast<unsigned int>(b)); }
+static int WrapSub(int a, int b) { return static_cast<int>(static_cast<unsigned int>(a) - static_cast<unsigned int>(b)); }
+static int WrapMul(int a, int b) { return static_cast<int>(static_cast<unsigned int>(a) * static_cast<unsigned int>(b)); }
+
+Optimizer::Optimizer()
+:   mAllocator(nullptr),
+    mLevel(LEVEL_NONE),
+    mRebuiltExpression(nullptr),
+    mStmtAction(STMT_KEEP),
+    mReplacementStmt(nullptr),
+    mReplacementList(nullptr),
+    mIsTerminal(false),
+    mListTerminates(false)
+{
+}
+
+void Optimizer::Initialize(Alloc::IAllocator* astAllocator)
+{
+    mAllocator = astAllocator;
+    Reset();
+}
+
+void Optimizer::Reset()
+{
+    mLevel = LEVEL_NONE;
+    mRebuiltExpression = nullptr;
+    mStmtAction = STMT_KEEP;
+    mReplacementStmt = nullptr;
+    mReplacementList = nullptr;
+    mIsTerminal = false;
+    mListTerminates = false;
+}
+
+void Optimizer::Optimize(Program* program, Optimizer::Level level)
+{
+    PG_ASSERTSTR(mAllocator != nullptr, "Optimizer must be initialized!");
+    if (program == nullptr || level == LEVEL_NONE)
+    {
+        return;
+    }
+
+    mLevel = level;
+    program->Access(this);
+    Reset();
+}
+
+Imm* Optimizer::CreateImm(const Variant& v, const TypeDesc* type)
+{
+    Imm* imm = OPT_NEW Imm(v);
+    imm->SetTypeDesc(type);
+    return imm;
+}
+
+bool Optimizer::IsConstantCondition(const Exp* exp, bool& value)
+{
+    if (exp->GetExpType() == Imm::sType)
+    {
+        const Variant& v = static_cast<const Imm*>(exp)->GetVariant();
+        switch (exp->GetTypeDesc()->GetAluEngine())
+        {
+        case TypeDesc::E_INT:
+            value = v.i[0] != 0;
+            return true;
+        case TypeDesc::E_FLOAT:
+            value = v.f[0] != 0.0f;
+            return true;
+        default:
+            break;
+        }
+    }
+    return false;
+}
+
+void Optimizer::DiscardValue(Exp* exp)
+{
+    //a post increment saves the old value into a temporal, nobody reads it when the value is discarded
+    if (exp->GetExpType() == Unop::sType)
+    {
+        Unop* unop = static_cast<Unop*>(exp);
+        if ((unop->GetOp() == O_INC || unop->GetOp() == O_DEC) && unop->IsPost())
+        {
+            unop->SetIsPost(false);
+        }
+    }
+}
+
+Exp* Optimizer::Fold(Exp* exp)
+{
+    mRebuiltExpression = exp;
+    exp->Access(this);
+    PG_ASSERT(mRebuiltExpression != nullptr);
+    return mRebuiltExpression;
+}
+
+StmtList* Optimizer::OptimizeStmtList(StmtList* stmtList)
+{
+    StmtList* head = nullptr;
+    StmtList* last = nullptr;
+    bool terminates = false;
+
+    StmtList* node = stmtList;
+    while (node != nullptr && !terminates)
+    {
+        StmtList* next = node->GetTail();
+        if (node->GetStmt() != nullptr)
+        {
+            node->GetStmt()->Access(this);
+
+            StmtList* first = nullptr;
+            StmtList* end = nullptr;
+            switch (mStmtAction)
+            {
+            case STMT_KEEP:
+                first = end = node;
+                break;
+            case STMT_REPLACE:
+                node->SetStmt(mReplacementStmt);
+                first = end = node;
+                break;
+            case STMT_SPLICE:
+                //the block to splice is already optimized, skip its empty nodes
+                for (StmtList* s = mReplacementList; s != nullptr; s = s->GetTail())
+                {
+                    if (s->GetStmt() != nullptr)
+                    {
+                        if (first == nullptr)
+                        {
+                            first = s;
+                        }
+                        else
+                        {
+                            end->SetTail(s);
+                        }
+                        end = s;
+                    }
+                }
+                break;
+            case STMT_REMOVE:
+                break;
+            }
+
+            if (first != nullptr)
+            {
+                if (head == nullptr)
+                {
+                    head = first;
+                }
+                else
+                {
+                    last->SetTail(first);
+                }
+                last = end;
+            }
+
+            //statements after a return are unreachable
+            terminates = mLevel >= LEVEL_FULL && mIsTerminal;
+        }
+        node = next;
+    }
+
+    if (head == nullptr)
+    {
+        //the canonizer expects a list on every block, keep an empty one around
+        head = stmtList;
+        head->SetStmt(nullptr);
+        last = head;
+    }
+    last->SetTail(nullptr);
+
+    mListTerminates = terminates;
+    mStmtAction = STMT_KEEP;
+    mIsTerminal = false;
+    return head;
+}
+
+Exp* Optimizer::FoldBinop(Binop* binop, const Imm* lhs, const Imm* rhs)
+{
+    TypeDesc::AluEngine engine = binop->GetTypeDesc()->GetAluEngine();
+    if (lhs->GetTypeDesc()->GetAluEngine() != engine || rhs->GetTypeDesc()->GetAluEngine() != engine)
+    {
+        return nullptr;
+    }
+
+    const Variant& a = lhs->GetVariant();
+    const Variant& b = rhs->GetVariant();
+    Variant r;
+    Utils::Memset8(&r, 0, sizeof(r));
+
+    if (engine == TypeDesc::E_INT)
+    {
+        const int x = a.i[0];
+        const int y = b.i[0];
+        switch (binop->GetOp())
+        {
+        case O_PLUS:  r.i[0] = WrapAdd(x, y); break;
+        case O_MINUS: r.i[0] = WrapSub(x, y); break;
+        case O_MUL:   r.i[0] = WrapMul(x, y); break;
+        case O_DIV:
+        case O_MOD:
+            //leave invalid divisions for the vm to find
+            if (y == 0 || (x == (-2147483647 - 1) && y == -1))
+            {
+                return nullptr;
+            }
+            r.i[0] = binop->GetOp() == O_DIV ? x / y : x % y;
+            break;
+        case O_EQ:    r.i[0] = x == y; break;
+        case O_NEQ:   r.i[0] = x != y; break;
+        case O_GT:    r.i[0] = x > y; break;
+        case O_LT:    r.i[0] = x < y; break;
+        case O_GTE:   r.i[0] = x >= y; break;
+        case O_LTE:   r.i[0] = x <= y; break;
+        case O_LAND:  r.i[0] = x && y; break;
+        case O_LOR:   r.i[0] = x || y; break;
+        default:
+            return nullptr;
+        }
+    }
+    else if (engine == TypeDesc::E_FLOAT)
+    {
+        //comparisons on floats evaluate to 1.0 or 0.0, same as the expression engine
+        const float x = a.f[0];
+        const float y = b.f[0];
+        switch (binop->GetOp())
+        {
+        case O_PLUS:  r.f[0] = x + y; break;
+        case O_MINUS: r.f[0] = x - y; break;
+        case O_MUL:   r.f[0] = x * y; break;
+        case O_DIV:   r.f[0] = x / y; break;
+        case O_EQ:    r.f[0] = x == y ? 1.0f : 0.0f; break;
+        case O_NEQ:   r.f[0] = x != y ? 1.0f : 0.0f; break;
+        case O_GT:    r.f[0] = x > y ? 1.0f : 0.0f; break;
+        case O_LT:    r.f[0] = x < y ? 1.0f : 0.0f; break;
+        case O_GTE:   r.f[0] = x >= y ? 1.0f : 0.0f; break;
+        case O_LTE:   r.f[0] = x <= y ? 1.0f : 0.0f; break;
+        case O_LAND:  r.f[0] = x && y ? 1.0f : 0.0f; break;
+        case O_LOR:   r.f[0] = x || y ? 1.0f : 0.0f; break;
+        default:
+            return nullptr;
+        }
+    }
+    else if (GetVectorComponents(engine) > 0)
+    {
+        //vector operators are component wise
+        for (int c = 0; c < GetVectorComponents(engine); ++c)
+        {
+            switch (binop->GetOp())
+            {
+            case O_PLUS:  r.f[c] = a.f[c] + b.f[c]; break;
+            case O_MINUS: r.f[c] = a.f[c] - b.f[c]; break;
+            case O_MUL:   r.f[c] = a.f[c] * b.f[c]; break;
+            case O_DIV:   r.f[c] = a.f[c] / b.f[c]; break;
+            default:
+                return nullptr;
+            }
+        }
+    }
+    else
+    {
+        return nullptr;
+    }
+
+    return CreateImm(r, binop->GetTypeDesc());
+}
+
+Exp* Optimizer::FoldCast(Unop* cast, const Imm* imm)
+{
+    const TypeDesc* sourceType = imm->GetTypeDesc();
+    const TypeDesc* targetType = cast->GetTypeDesc();
+    const Variant& v = imm->GetVariant();
+    Variant r;
+    Utils::Memset8(&r, 0, sizeof(r));
+
+    if (sourceType->GetAluEngine() == TypeDesc::E_INT && targetType->GetAluEngine() == TypeDesc::E_FLOAT)
+    {
+        r.f[0] = static_cast<float>(v.i[0]);
+    }
+    else if (sourceType->GetAluEngine() == TypeDesc::E_FLOAT && targetType->GetAluEngine() == TypeDesc::E_INT)
+    {
+        //out of range conversions are left to the vm
+        if (!(v.f[0] > -2147483648.0f && v.f[0] < 2147483648.0f))
+        {
+            return nullptr;
+        }
+        r.i[0] = static_cast<int>(v.f[0]);
+    }
+    else if (GetVectorComponents(targetType->GetAluEngine()) > 0
+             && (sourceType->GetAluEngine() == TypeDesc::E_INT || sourceType->GetAluEngine() == TypeDesc::E_FLOAT))
+    {
+        //scalar to vector casts splat the scalar, same as the floatN(scalar) constructors
+        const float f = sourceType->GetAluEngine() == TypeDesc::E_INT ? static_cast<float>(v.i[0]) : v.f[0];
+        for (int c = 0; c < GetVectorComponents(targetType->GetAluEngine()); ++c)
+        {
+            r.f[c] = f;
+        }
+    }
+    else if (sourceType->GetAluEngine() == targetType->GetAluEngine())
+    {
+        //enumerations and same engine casts only change the type
+        r = v;
+    }
+    else
+    {
+        return nullptr;
+    }
+
+    return CreateImm(r, targetType);
+}
+
+Exp* Optimizer::FoldVectorConstructor(FunCall* funCall)
+{
+    const FunDesc* funDesc = funCall->GetDesc();
+    if (funCall->IsMethod() || funDesc == nullptr || !funDesc->IsCallback())
+    {
+        return nullptr;
+    }
+
+    const char* name = funCall->GetName();
+    if (Utils::Strcmp(name, "float2") && Utils::Strcmp(name, "float3") && Utils::Strcmp(name, "float4"))
+    {
+        return nullptr;
+    }
+
+    const int dimensions = GetVectorComponents(funCall->GetTypeDesc()->GetAluEngine());
+    if (dimensions == 0)
+    {
+        return nullptr;
+    }
+
+    Variant r;
+    Utils::Memset8(&r, 0, sizeof(r));
+    int components = 0;
+    int argCount = 0;
+    for (ExpList* args = funCall->GetArgs(); args != nullptr && args->GetExp() != nullptr; args = args->GetTail())
+    {
+        const Exp* arg = args->GetExp();
+        if (arg->GetExpType() != Imm::sType)
+        {
+            return nullptr;
+        }
+
+        const Variant& v = static_cast<const Imm*>(arg)->GetVariant();
+        TypeDesc::AluEngine engine = arg->GetTypeDesc()->GetAluEngine();
+        int argComponents = engine == TypeDesc::E_INT || engine == TypeDesc::E_FLOAT ? 1 : GetVectorComponents(engine);
+        if (argComponents == 0 || components + argComponents > dimensions)
+        {
+            return nullptr;
+        }
+
+        for (int c = 0; c < argComponents; ++c)
+        {
+            r.f[components++] = engine == TypeDesc::E_INT ? static_cast<float>(v.i[c]) : v.f[c];
+        }
+        ++argCount;
+    }
+
+    if (argCount == 1 && components == 1)
+    {
+        //single scalar constructor, splat it
+        for (int c = 1; c < dimensions; ++c)
+        {
+            r.f[c] = r.f[0];
+        }
+        components = dimensions;
+    }
+
+    return components == dimensions ? CreateImm(r, funCall->GetTypeDesc()) : nullptr;
+}
+
+void Optimizer::Visit(Program* n)
+{
+    if (n->GetStmtList() != nullptr)
+    {
+        n->SetStmtList(OptimizeStmtList(n->GetStmtList()));
+    }
+}
+
+void Optimizer::Visit(Exp* n)
+{
+    PG_FAILSTR("[Optimizer::Visit(Exp*)] This node should not be visited!");
+}
+
+void Optimizer::Visit(ExpList* n)
+{
+    PG_FAILSTR("[Optimizer::Visit(ExpList*)] This node should not be visited!");
+}
+
+void Optimizer::Visit(Stmt* n)
+{
+    PG_FAILSTR("[Optimizer::Visit(Stmt*)] This node should not be visited!");
+}
+
+void Optimizer::Visit(StmtList* n)
+{
+    PG_FAILSTR("[Optimizer::Visit(StmtList*)] This node should not be visited!");
+}
+
+void Optimizer::Visit(Annotations* n)
+{
+    PG_FAILSTR("[Optimizer::Visit(Annotations*)] This node should not be visited!");
+}
+
+void Optimizer::Visit(ArgDec* n)
+{
+    PG_FAILSTR("[Optimizer::Visit(ArgDec*)] This node should not be visited!");
+}
+
+void Optimizer::Visit(ArgList* n)
+{
+    PG_FAILSTR("[Optimizer::Visit(ArgList*)] This node should not be visited!");
+}
+
+void Optimizer::Visit(Idd* n)
+{
+    mRebuiltExpression = n;
+}
+
+void Optimizer::Visit(Imm* n)
+{
+    mRebuiltExpression = n;
+}
+
+void Optimizer::Visit(StrImm* n)
+{
+    mRebuiltExpression = n;
+}
+
+void Optimizer::Visit(ArrayConstructor* n)
+{
+    mRebuiltExpression = n;
+}
+
+void Optimizer::Visit(Binop* n)
+{
+    if (n->GetOp() == O_SET || n->GetOp() == O_DOT)
+    {
+        //the left side must stay addressable and the right side of a dot is a member name.
+        //Fold their children only.
+        Exp* lhs = Fold(n->GetLhs());
+        if (lhs->GetExpType() != Imm::sType)
+        {
+            n->SetLhs(lhs);
+        }
+        if (n->GetOp() == O_SET)
+        {
+            n->SetRhs(Fold(n->GetRhs()));
+        }
+        mRebuiltExpression = n;
+        return;
+    }
+
+    n->SetLhs(Fold(n->GetLhs()));
+    n->SetRhs(Fold(n->GetRhs()));
+
+    Exp* folded = nullptr;
+    if (n->GetOp() != O_ACCESS && n->GetLhs()->GetExpType() == Imm::sType && n->GetRhs()->GetExpType() == Imm::sType)
+    {
+        folded = FoldBinop(n, static_cast<Imm*>(n->GetLhs()), static_cast<Imm*>(n->GetRhs()));
+    }
+    mRebuiltExpression = folded != nullptr ? folded : n;
+}
+
+void Optimizer::Visit(Unop* n)
+{
+    if (n->GetOp() == O_INC || n->GetOp() == O_DEC)
+    {
+        //operand must stay a variable
+        mRebuiltExpression = n;
+        return;
+    }
+
+    n->SetExp(Fold(n->GetExp()));
+
+    Exp* folded = nullptr;
+    if (n->GetExp()->GetExpType() == Imm::sType)
+    {
+        Imm* imm = static_cast<Imm*>(n->GetExp());
+        if (n->GetOp() == O_IMPLICIT_CAST || n->GetOp() == O_EXPLICIT_CAST)
+        {
+            folded = FoldCast(n, imm);
+        }
+        else if (n->GetOp() == O_MINUS && imm->GetTypeDesc()->GetAluEngine() == n->GetTypeDesc()->GetAluEngine())
+        {
+            const Variant& v = imm->GetVariant();
+            Variant r;
+            Utils::Memset8(&r, 0, sizeof(r));
+            TypeDesc::AluEngine engine = n->GetTypeDesc()->GetAluEngine();
+            if (engine == TypeDesc::E_INT)
+            {
+                r.i[0] = WrapSub(0, v.i[0]);
+                folded = CreateImm(r, n->GetTypeDesc());
+            }
+            else if (engine == TypeDesc::E_FLOAT || GetVectorComponents(engine) > 0)
+            {
+                int components = engine == TypeDesc::E_FLOAT ? 1 : GetVectorComponents(engine);
+                for (int c = 0; c < components; ++c)
+                {
+                    r.f[c] = -v.f[c];
+                }
+                folded = CreateImm(r, n->GetTypeDesc());
+            }
+        }
+    }
+    mRebuiltExpression = folded != nullptr ? folded : n;
+}
+
+void Optimizer::Visit(FunCall* n)
+{
+    const StmtFunDec* funDec = n->GetDesc() != nullptr ? n->GetDesc()->GetDec() : nullptr;
+    ArgList* argList = funDec != nullptr ? funDec->GetArgList() : nullptr;
+    for (ExpList* args = n->GetArgs(); args != nullptr && args->GetExp() != nullptr; args = args->GetTail())
+    {
+        Exp* arg = Fold(args->GetExp());
+
+        //arguments passed by reference need an address, don't turn them into immediates
+        bool isReference = argList != nullptr && argList->GetArgDec() != nullptr
+                        && argList->GetArgDec()->GetType()->GetModifier() == TypeDesc::M_STAR;
+        if (!isReference || arg->GetExpType() != Imm::sType)
+        {
+            args->SetExp(arg);
+        }
+
+        argList = argList != nullptr ? argList->GetTail() : nullptr;
+    }
+
+    Exp* folded = FoldVectorConstructor(n);
+    mRebuiltExpression = folded != nullptr ? folded : n;
+}
+
+void Optimizer::Visit(StmtExp* n)
+{
+    n->SetExp(Fold(n->GetExp()));
+    if (mLevel >= LEVEL_FULL)
+    {
+        DiscardValue(n->GetExp());
+    }
+    mStmtAction = STMT_KEEP;
+    mIsTerminal = false;
+}
+
+void Optimizer::Visit(StmtFunDec* n)
+{
+    //callbacks have no body
+    if (n->GetStmtList() != nullptr)
+    {
+        n->SetStmtList(OptimizeStmtList(n->GetStmtList()));
+    }
+    mStmtAction = STMT_KEEP;
+    mIsTerminal = false;
+}
+
+void Optimizer::Visit(StmtIfElse* n)
+{
+    StmtIfElse* head = nullptr;
+    StmtIfElse* last = nullptr;
+    bool allBranchesReturn = true;
+    StmtIfElse* link = n;
+    while (link != nullptr)
+    {
+        StmtIfElse* next = link->GetTail();
+        bool keep = true;
+        if (link->GetExp() != nullptr)
+        {
+            link->SetExp(Fold(link->GetExp()));
+            bool value = false;
+            if (mLevel >= LEVEL_FULL && IsConstantCondition(link->GetExp(), value))
+            {
+                if (value)
+                {
+                    //always taken, turn this branch into the final else
+                    link->SetExp(nullptr);
+                    next = nullptr;
+                }
+                else
+                {
+                    keep = false;
+                }
+            }
+        }
+        else
+        {
+            next = nullptr;
+        }
+
+        if (keep)
+        {
+            link->SetStmtList(OptimizeStmtList(link->GetStmtList()));
+            allBranchesReturn = allBranchesReturn && mListTerminates;
+            if (head == nullptr)
+            {
+                head = link;
+            }
+            else
+            {
+                last->SetTail(link);
+            }
+            last = link;
+        }
+        link = next;
+    }
+
+    mIsTerminal = false;
+    if (head == nullptr)
+    {
+        //no branch is ever taken
+        mStmtAction = STMT_REMOVE;
+    }
+    else
+    {
+        last->SetTail(nullptr);
+        if (head->GetExp() == nullptr)
+        {
+            //a single branch always taken, inline its block. Block frames are flattened already.
+            mStmtAction = STMT_SPLICE;
+            mReplacementList = head->GetStmtList();
+            mIsTerminal = mListTerminates;
+        }
+        else
+        {
+            mStmtAction = head != n ? STMT_REPLACE : STMT_KEEP;
+            mReplacementStmt = head;
+
+            //with an else block, the statement returns if all of its branches do
+            mIsTerminal = last->GetExp() == nullptr && allBranchesReturn;
+        }
+    }
+}
+
+void Optimizer::Visit(StmtWhile* n)
+{
+    n->SetExp(Fold(n->GetExp()));
+    n->SetStmtList(OptimizeStmtList(n->GetStmtList()));
+
+    bool value = false;
+    bool neverRuns = mLevel >= LEVEL_FULL && IsConstantCondition(n->GetExp(), value) && !value;
+    mStmtAction = neverRuns ? STMT_REMOVE : STMT_KEEP;
+    mIsTerminal = false;
+}
+
+void Optimizer::Visit(StmtFor* n)
+{
+    if (n->GetInit() != nullptr)
+    {
+        n->SetInit(Fold(n->GetInit()));
+    }
+    if (n->GetCond() != nullptr)
+    {
+        n->SetCond(Fold(n->GetCond()));
+    }
+    if (n->GetUpdate() != nullptr)
+    {
+        n->SetUpdate(Fold(n->GetUpdate()));
+        if (mLevel >= LEVEL_FULL)
+        {
+            DiscardValue(n->GetUpdate());
+        }
+    }
+    n->SetStmtList(OptimizeStmtList(n->GetStmtList()));
+
+    mStmtAction = STMT_KEEP;
+    mIsTerminal = false;
+
+    bool value = false;
+    if (mLevel >= LEVEL_FULL && n->GetCond() != nullptr && IsConstantCondition(n->GetCond(), value))
+    {
+        if (value)
+        {
+            //no need to evaluate the condition on every iteration
+            n->SetCond(nullptr);
+        }
+        else if (n->GetInit() != nullptr)
+        {
+            //the loop never runs, only the initializer remains
+            mStmtAction = STMT_REPLACE;
+            mReplacementStmt = OPT_NEW StmtExp(n->GetInit());
+            mReplacementStmt->SetLine(n->GetLine());
+        }
+        else
+        {
+            mStmtAction = STMT_REMOVE;
+        }
+    }
+}
+
+void Optimizer::Visit(StmtReturn* n)
+{
+    n->SetExp(Fold(n->GetExp()));
+    mStmtAction = STMT_KEEP;
+    mIsTerminal = true;
+}
+
+void Optimizer::Visit(StmtStructDef* n)
+{
+    mStmtAction = STMT_KEEP;
+    mIsTerminal = false;
+}
+
+void Optimizer::Visit(StmtEnumTypeDef* n)
+{
+    mStmtAction = STMT_KEEP;
+    mIsTerminal = false;
+}
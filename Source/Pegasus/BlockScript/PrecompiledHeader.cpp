@@ -0,0 +1,269 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                       Pegasus                                        */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file   PrecompiledHeader.cpp
+//! \author agent
+//! \date   16th October 2026
+//! \brief  Precompiled blockscript headers. A header holding only type declarations (structs
+//!         and enums) is compiled once into its own symbol table, which every script including
+//!         it afterwards registers as a read only child instead of parsing the header again.
+
+#include "Pegasus/BlockScript/PrecompiledHeader.h"
+#include "Pegasus/BlockScript/BlockScriptAst.h"
+#include "Pegasus/BlockScript/IVisitor.h"
+#include "Pegasus/BlockScript/SymbolTable.h"
+#include "Pegasus/Allocator/IAllocator.h"
+#include "Pegasus/Allocator/Alloc.h"
+#include "Pegasus/Core/Assertion.h"
+#include "Pegasus/Utils/Memcpy.h"
+#include "Pegasus/Utils/String.h"
+
+using namespace Pegasus::BlockScript;
+
+extern void Bison_BlockScriptParse(const Pegasus::Io::FileBuffer* fileBuffer, BlockScriptBuilder* builder, IFileIncluder* fileIncluder, Container<Preprocessor::Definition>* definitionList, PrecompiledHeaderCache* headerCache, Container<Preprocessor::Definition>* outDefinitionList);
+
+//64 bit FNV-1a
+static void HashBytes(Pegasus::Math::PUInt64& hash, const void* data, int size)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (int i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= PCST_UINT64(1099511628211);
+    }
+}
+
+static void HashString(Pegasus::Math::PUInt64& hash, const char* str)
+{
+    if (str == nullptr)
+    {
+        int nullMark = -1;
+        HashBytes(hash, &nullMark, sizeof(nullMark));
+    }
+    else
+    {
+        HashBytes(hash, str, Pegasus::Utils::Strlen(str) + 1);
+    }
+}
+
+//! Visits the top level statements of a header. Anything other than a type declaration
+//! produces code or globals, which belong to the assembly of the including script.
+class DeclarationVisitor : public IVisitor
+{
+public:
+    DeclarationVisitor() : mIsDeclaration(false) {}
+    virtual ~DeclarationVisitor() {}
+
+    //! \return true if the last statement visited only declares a type
+    bool IsDeclaration() const { return mIsDeclaration; }
+
+    #define BS_PROCESS(N) virtual void Visit(Ast::N* n) { mIsDeclaration = false; }
+    #include "Pegasus/BlockScript/Ast.inl"
+    #undef BS_PROCESS
+
+protected:
+    bool mIsDeclaration;
+};
+
+class HeaderVisitor : public DeclarationVisitor
+{
+public:
+    virtual void Visit(Ast::StmtStructDef* n) { mIsDeclaration = true; }
+    virtual void Visit(Ast::StmtEnumTypeDef* n) { mIsDeclaration = true; }
+    using DeclarationVisitor::Visit;
+};
+
+//! \return true if every top level statement of a program declares a type
+static bool IsDeclarationOnly(const Ast::Program* program)
+{
+    HeaderVisitor visitor;
+    for (Ast::StmtList* list = program->GetStmtList(); list != nullptr; list = list->GetTail())
+    {
+        if (list->GetStmt() != nullptr)
+        {
+            list->GetStmt()->Access(&visitor);
+            if (!visitor.IsDeclaration())
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+//----------------------------------------------------------------------------------------
+
+PrecompiledHeader::PrecompiledHeader(Pegasus::Alloc::IAllocator* allocator, IddStrPool* strPool, Pegasus::Math::PUInt64 key, const char* path)
+: mIncludes(allocator), mKey(key), mIsValid(false)
+{
+    mBuilder.Initialize(allocator, strPool);
+    mDefinitions.Initialize(allocator);
+
+    int pathLen = path == nullptr ? 0 : Pegasus::Utils::Strlen(path);
+    pathLen = pathLen < Pegasus::Io::IOManager::MAX_FILEPATH_LENGTH ? pathLen : Pegasus::Io::IOManager::MAX_FILEPATH_LENGTH - 1;
+    Pegasus::Utils::Memcpy(mPath, path, pathLen);
+    mPath[pathLen] = '\0';
+}
+
+PrecompiledHeader::~PrecompiledHeader()
+{
+}
+
+void PrecompiledHeader::Build(const Pegasus::Io::FileBuffer* source, const Preprocessor& preprocessor, const SymbolTable* includingTable, PrecompiledHeaderCache* cache)
+{
+    //the header sees what the including script sees at the include: its libraries and the headers attached before
+    SymbolTable* symbolTable = mBuilder.GetSymbolTable();
+    int inheritedCount = includingTable->GetChildCount();
+    for (int i = 0; i < inheritedCount; ++i)
+    {
+        symbolTable->RegisterChild(includingTable->GetChild(i));
+    }
+
+    Container<Preprocessor::Definition> definitions;
+    definitions.Initialize(mBuilder.GetAllocator());
+    for (int i = 0; i < preprocessor.GetDefinitionCount(); ++i)
+    {
+        definitions.PushEmpty() = preprocessor.GetDefinition(i);
+    }
+
+    //the statements are checked as they were written
+    mBuilder.SetOptimizationLevel(Optimizer::LEVEL_NONE);
+    mBuilder.BeginBuild(mPath);
+    mIncludes.Begin(preprocessor.GetFileIncluder());
+    Bison_BlockScriptParse(source, &mBuilder, &mIncludes, &definitions, cache, &mDefinitions);
+    BlockScriptBuilder::CompilationResult cr;
+    mBuilder.EndBuild(cr);
+
+    mIsValid = cr.mAst != nullptr && mBuilder.GetErrorCount() == 0 && IsDeclarationOnly(cr.mAst);
+
+    //the types keep pointers to the library types they use, the lookups of the including
+    //script go through its own libraries. Only the headers this header included stay attached.
+    for (int i = 0; i < inheritedCount; ++i)
+    {
+        symbolTable->UnregisterChild(includingTable->GetChild(i));
+    }
+}
+
+//----------------------------------------------------------------------------------------
+
+PrecompiledHeaderCache::PrecompiledHeaderCache(Pegasus::Alloc::IAllocator* allocator)
+: mAllocator(allocator), mHitCount(0), mMissCount(0)
+{
+    mHeaders.Initialize(allocator);
+}
+
+PrecompiledHeaderCache::~PrecompiledHeaderCache()
+{
+    Clear();
+}
+
+void PrecompiledHeaderCache::Clear()
+{
+    std::lock_guard<std::recursive_mutex> lock(mLock);
+    for (int i = 0; i < mHeaders.Size(); ++i)
+    {
+        PG_DELETE(mAllocator, mHeaders[i]);
+    }
+    mHeaders.Reset();
+    mHitCount = 0;
+    mMissCount = 0;
+}
+
+Pegasus::Math::PUInt64 PrecompiledHeaderCache::ComputeKey(const char* source, int sourceSize, const Preprocessor& preprocessor, const SymbolTable* includingTable)
+{
+    Pegasus::Math::PUInt64 hash = PCST_UINT64(14695981039346656037);
+    HashBytes(hash, &sourceSize, sizeof(sourceSize));
+    HashBytes(hash, source, sourceSize);
+
+    //the definitions select the conditional blocks of the header, and get expanded in it
+    int definitionCount = preprocessor.GetDefinitionCount();
+    HashBytes(hash, &definitionCount, sizeof(definitionCount));
+    for (int i = 0; i < definitionCount; ++i)
+    {
+        const Preprocessor::Definition& def = preprocessor.GetDefinition(i);
+        HashString(hash, def.mName);
+        HashString(hash, def.mValue);
+    }
+
+    //the types the header can reference
+    int childCount = includingTable->GetChildCount();
+    HashBytes(hash, &childCount, sizeof(childCount));
+    for (int i = 0; i < childCount; ++i)
+    {
+        const SymbolTable* child = includingTable->GetChild(i);
+        HashBytes(hash, &child, sizeof(child));
+    }
+    return hash;
+}
+
+PrecompiledHeader* PrecompiledHeaderCache::Find(Pegasus::Math::PUInt64 key, IFileIncluder* includer)
+{
+    for (int i = 0; i < mHeaders.Size(); ++i)
+    {
+        PrecompiledHeader* header = mHeaders[i];
+        if (header->GetKey() != key)
+        {
+            continue;
+        }
+
+        //the key only covers the header itself, the headers it included can have changed since
+        const IncludeRecorder& includes = header->GetIncludes();
+        bool upToDate = true;
+        for (int inc = 0; inc < includes.GetCount() && upToDate; ++inc)
+        {
+            const char* buffer = nullptr;
+            int bufferSize = 0;
+            upToDate = includer != nullptr && includer->Open(includes.GetPath(inc), &buffer, bufferSize);
+            if (upToDate)
+            {
+                upToDate = IncludeRecorder::HashContents(buffer, bufferSize) == includes.GetHash(inc);
+                includer->Close(buffer);
+            }
+        }
+
+        if (upToDate)
+        {
+            return header;
+        }
+    }
+    return nullptr;
+}
+
+bool PrecompiledHeaderCache::Attach(const char* path, const char* source, int sourceSize, Preprocessor& preprocessor, SymbolTable* includingTable)
+{
+    Pegasus::Math::PUInt64 key = ComputeKey(source, sourceSize, preprocessor, includingTable);
+
+    std::lock_guard<std::recursive_mutex> lock(mLock);
+    PrecompiledHeader* header = Find(key, preprocessor.GetFileIncluder());
+    if (header != nullptr)
+    {
+        ++mHitCount;
+    }
+    else
+    {
+        ++mMissCount;
+        header = PG_NEW(mAllocator, -1, "BlockScript::PrecompiledHeader", Pegasus::Alloc::PG_MEM_PERM) PrecompiledHeader(mAllocator, includingTable->GetStringPool(), key, path);
+        mHeaders.PushEmpty() = header;
+
+        Pegasus::Io::FileBuffer fb;
+        fb.OwnBuffer(nullptr, const_cast<char*>(source), sourceSize);
+        header->Build(&fb, preprocessor, includingTable, this);
+        fb.ForgetBuffer(); //the includer owns the buffer
+    }
+
+    if (!header->IsValid())
+    {
+        return false;
+    }
+
+    includingTable->RegisterChild(header->GetSymbolTable());
+    const Container<Preprocessor::Definition>& definitions = header->GetDefinitions();
+    for (int i = 0; i < definitions.Size(); ++i)
+    {
+        preprocessor.InsertDefinition(definitions[i]);
+    }
+    return true;
+}
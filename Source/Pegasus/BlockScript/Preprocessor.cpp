@@ -11,6 +11,7 @@
 
 #include "Pegasus/BlockScript/Preprocessor.h"
 #include "Pegasus/BlockScript/IFileIncluder.h"
+#include "Pegasus/BlockScript/PrecompiledHeader.h"
 #include "Pegasus/Allocator/IAllocator.h"
 #include "Pegasus/Utils/String.h"
 
@@ -24,7 +25,9 @@ Preprocessor::Preprocessor(Alloc::IAllocator* allocator)
      mStateStack(allocator),
      mHasInclude(false),
      mNextIncludeDefinition(nullptr),
-     mFileIncluder(nullptr)
+     mFileIncluder(nullptr),
+     mHeaderCache(nullptr),
+     mSymbolTable(nullptr)
 {
     NewState();
     Top().mIsChosePath = true;
@@ -171,7 +174,15 @@ bool Preprocessor::FlushCommand(const char** errString)
                     result = mFileIncluder->Open(Top().mCodeArg, &mNextIncludeDefinition->mValue, mNextIncludeDefinition->mBufferSize);
                     if (result)
                     {
-                        mHasInclude = true;
+                        //a precompiled header gets attached to the symbol table, its text is skipped
+                        if (mHeaderCache != nullptr && mHeaderCache->Attach(Top().mCodeArg, mNextIncludeDefinition->mValue, mNextIncludeDefinition->mBufferSize, *this, mSymbolTable))
+                        {
+                            mFileIncluder->Close(mNextIncludeDefinition->mValue);
+                        }
+                        else
+                        {
+                            mHasInclude = true;
+                        }
                     }
                     else
                     {
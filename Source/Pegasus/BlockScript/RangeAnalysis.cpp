@@ -0,0 +1,565 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                       Pegasus                                        */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file   RangeAnalysis.cpp
+//! \author agent
+//! \date   16th October 2026
+//! \brief  Range analysis of array indices, runs between the optimizer and the canonizer.
+//!         Marks the array accesses whose index is proven in range, so safe mode does not
+//!         check them at runtime.
+
+#include "Pegasus/BlockScript/RangeAnalysis.h"
+#include "Pegasus/BlockScript/BlockScriptAst.h"
+#include "Pegasus/BlockScript/TypeDesc.h"
+#include "Pegasus/BlockScript/FunDesc.h"
+#include "Pegasus/BlockScript/bs.parser.hpp"
+#include "Pegasus/Core/Assertion.h"
+#include "Pegasus/Math/Types.h"
+
+using namespace Pegasus;
+using namespace Pegasus::BlockScript;
+using namespace Pegasus::BlockScript::Ast;
+
+//! ranges are kept far from the int limits, so the arithmetic on them never wraps around
+static const Math::PInt64 RANGE_LIMIT = 1 << 24;
+
+//! \return true if both nodes name the same variable
+static bool IsSameVariable(const Idd* a, const Idd* b)
+{
+    return a->GetMetaData().isGlobal == b->GetMetaData().isGlobal && a->GetOffset() == b->GetOffset() && a->GetFrameOffset() == b->GetFrameOffset();
+}
+
+//! \return true if the expression is an integer scalar variable
+static bool IsIntVariable(const Exp* exp)
+{
+    return exp != nullptr && exp->GetExpType() == Idd::sType &&
+           exp->GetTypeDesc()->GetModifier() == TypeDesc::M_SCALAR &&
+           exp->GetTypeDesc()->GetAluEngine() == TypeDesc::E_INT;
+}
+
+//! \return true if the expression is an integer constant
+static bool GetIntConstant(const Exp* exp, int& value)
+{
+    if (exp->GetExpType() == Imm::sType && exp->GetTypeDesc()->GetAluEngine() == TypeDesc::E_INT)
+    {
+        value = static_cast<const Imm*>(exp)->GetVariant().i[0];
+        return true;
+    }
+    return false;
+}
+
+//! Looks for a statement or an expression that can write a variable
+class WriteFinder : public IVisitor
+{
+public:
+    explicit WriteFinder(const Idd* var) : mVar(var), mFound(false) {}
+    virtual ~WriteFinder() {}
+
+    //! \return true if a write was found in the nodes visited
+    bool Found() const { return mFound; }
+
+    virtual void Visit(Program* n) {}
+    virtual void Visit(Exp* n) {}
+    virtual void Visit(Stmt* n) {}
+    virtual void Visit(ArgDec* n) {}
+    virtual void Visit(ArgList* n) {}
+    virtual void Visit(Idd* n) {}
+    virtual void Visit(Imm* n) {}
+    virtual void Visit(StrImm* n) {}
+    virtual void Visit(ArrayConstructor* n) {}
+    virtual void Visit(StmtFunDec* n) {}
+    virtual void Visit(StmtStructDef* n) {}
+    virtual void Visit(StmtEnumTypeDef* n) {}
+    virtual void Visit(Annotations* n) {}
+
+    virtual void Visit(ExpList* n)
+    {
+        for (ExpList* list = n; list != nullptr && list->GetExp() != nullptr; list = list->GetTail())
+        {
+            list->GetExp()->Access(this);
+        }
+    }
+
+    virtual void Visit(StmtList* n)
+    {
+        for (StmtList* list = n; list != nullptr; list = list->GetTail())
+        {
+            if (list->GetStmt() != nullptr)
+            {
+                list->GetStmt()->Access(this);
+            }
+        }
+    }
+
+    virtual void Visit(Binop* n)
+    {
+        mFound = mFound || (n->GetOp() == O_SET && IsVar(n->GetLhs()));
+        n->GetLhs()->Access(this);
+        if (n->GetOp() != O_DOT)
+        {
+            n->GetRhs()->Access(this);
+        }
+    }
+
+    virtual void Visit(Unop* n)
+    {
+        mFound = mFound || ((n->GetOp() == O_INC || n->GetOp() == O_DEC) && IsVar(n->GetExp()));
+        n->GetExp()->Access(this);
+    }
+
+    virtual void Visit(FunCall* n)
+    {
+        const FunDesc* desc = n->GetDesc();
+        if (desc == nullptr || mVar->GetMetaData().isGlobal)
+        {
+            //script functions can write globals. So can callbacks: they get the vm state, and the ones
+            //suspending the script (yield) hand it to the host, which can write globals before resuming
+            mFound = true;
+        }
+
+        //callbacks write the arguments they take by pointer
+        ArgList* argList = desc != nullptr && desc->GetDec() != nullptr ? desc->GetDec()->GetArgList() : nullptr;
+        for (ExpList* args = n->GetArgs(); args != nullptr && args->GetExp() != nullptr; args = args->GetTail())
+        {
+            bool isReference = argList != nullptr && argList->GetArgDec() != nullptr
+                            && argList->GetArgDec()->GetType()->GetModifier() == TypeDesc::M_STAR;
+            mFound = mFound || (isReference && IsVar(args->GetExp()));
+            args->GetExp()->Access(this);
+            argList = argList != nullptr ? argList->GetTail() : nullptr;
+        }
+    }
+
+    virtual void Visit(StmtExp* n) { n->GetExp()->Access(this); }
+
+    virtual void Visit(StmtReturn* n) { n->GetExp()->Access(this); }
+
+    virtual void Visit(StmtIfElse* n)
+    {
+        for (StmtIfElse* link = n; link != nullptr; link = link->GetTail())
+        {
+            if (link->GetExp() != nullptr)
+            {
+                link->GetExp()->Access(this);
+            }
+            link->GetStmtList()->Access(this);
+        }
+    }
+
+    virtual void Visit(StmtWhile* n)
+    {
+        n->GetExp()->Access(this);
+        n->GetStmtList()->Access(this);
+    }
+
+    virtual void Visit(StmtFor* n)
+    {
+        Exp* exps[] = { n->GetInit(), n->GetCond(), n->GetUpdate() };
+        for (int i = 0; i < sizeof(exps) / sizeof(exps[0]); ++i)
+        {
+            if (exps[i] != nullptr)
+            {
+                exps[i]->Access(this);
+            }
+        }
+        n->GetStmtList()->Access(this);
+    }
+
+private:
+    bool IsVar(const Exp* exp) const
+    {
+        return exp->GetExpType() == Idd::sType && IsSameVariable(static_cast<const Idd*>(exp), mVar);
+    }
+
+    const Idd* mVar;
+    bool mFound;
+};
+
+//----------------------------------------------------------------------------------------
+
+RangeAnalysis::RangeAnalysis()
+: mCheckedCount(0), mProvenCount(0)
+{
+}
+
+void RangeAnalysis::Reset()
+{
+    mInductions.Clear();
+    mCheckedCount = 0;
+    mProvenCount = 0;
+}
+
+void RangeAnalysis::Analyze(Program* program)
+{
+    Reset();
+    program->Access(this);
+    PG_ASSERT(mInductions.GetSize() == 0);
+}
+
+bool RangeAnalysis::GetRange(const Exp* exp, int& outMin, int& outMax) const
+{
+    int value = 0;
+    if (GetIntConstant(exp, value))
+    {
+        outMin = value;
+        outMax = value;
+        return value >= -RANGE_LIMIT && value <= RANGE_LIMIT;
+    }
+    else if (IsIntVariable(exp))
+    {
+        //the innermost loop counting the variable
+        for (int i = static_cast<int>(mInductions.GetSize()) - 1; i >= 0; --i)
+        {
+            if (IsSameVariable(mInductions[i].mVar, static_cast<const Idd*>(exp)))
+            {
+                outMin = mInductions[i].mMin;
+                outMax = mInductions[i].mMax;
+                return true;
+            }
+        }
+        return false;
+    }
+    else if (exp->GetExpType() != Binop::sType || exp->GetTypeDesc()->GetAluEngine() != TypeDesc::E_INT)
+    {
+        return false;
+    }
+
+    const Binop* binop = static_cast<const Binop*>(exp);
+    int lhsMin = 0, lhsMax = 0, rhsMin = 0, rhsMax = 0;
+    if (!GetRange(binop->GetLhs(), lhsMin, lhsMax) || !GetRange(binop->GetRhs(), rhsMin, rhsMax))
+    {
+        return false;
+    }
+
+    Math::PInt64 resultMin = 0;
+    Math::PInt64 resultMax = 0;
+    switch (binop->GetOp())
+    {
+    case O_PLUS:
+        resultMin = static_cast<Math::PInt64>(lhsMin) + rhsMin;
+        resultMax = static_cast<Math::PInt64>(lhsMax) + rhsMax;
+        break;
+    case O_MINUS:
+        resultMin = static_cast<Math::PInt64>(lhsMin) - rhsMax;
+        resultMax = static_cast<Math::PInt64>(lhsMax) - rhsMin;
+        break;
+    case O_MUL:
+        {
+            Math::PInt64 products[] = {
+                static_cast<Math::PInt64>(lhsMin) * rhsMin, static_cast<Math::PInt64>(lhsMin) * rhsMax,
+                static_cast<Math::PInt64>(lhsMax) * rhsMin, static_cast<Math::PInt64>(lhsMax) * rhsMax
+            };
+            resultMin = products[0];
+            resultMax = products[0];
+            for (int i = 1; i < 4; ++i)
+            {
+                resultMin = products[i] < resultMin ? products[i] : resultMin;
+                resultMax = products[i] > resultMax ? products[i] : resultMax;
+            }
+        }
+        break;
+    case O_DIV:
+        //only non negative numbers by a positive constant, rounding is the same either way
+        if (lhsMin < 0 || rhsMin != rhsMax || rhsMin <= 0)
+        {
+            return false;
+        }
+        resultMin = lhsMin / rhsMin;
+        resultMax = lhsMax / rhsMin;
+        break;
+    case O_MOD:
+        if (lhsMin < 0 || rhsMin != rhsMax || rhsMin <= 0)
+        {
+            return false;
+        }
+        resultMin = lhsMax < rhsMin ? lhsMin : 0;
+        resultMax = lhsMax < rhsMin ? lhsMax : rhsMin - 1;
+        break;
+    default:
+        return false;
+    }
+
+    if (resultMin < -RANGE_LIMIT || resultMax > RANGE_LIMIT)
+    {
+        return false;
+    }
+    outMin = static_cast<int>(resultMin);
+    outMax = static_cast<int>(resultMax);
+    return true;
+}
+
+bool RangeAnalysis::MatchInduction(const StmtFor* loop, Induction& induction) const
+{
+    //i = start
+    const Exp* init = loop->GetInit();
+    if (init == nullptr || init->GetExpType() != Binop::sType ||
+        static_cast<const Binop*>(init)->GetOp() != O_SET || !IsIntVariable(static_cast<const Binop*>(init)->GetLhs()))
+    {
+        return false;
+    }
+    const Idd* var = static_cast<const Idd*>(static_cast<const Binop*>(init)->GetLhs());
+    int startMin = 0, startMax = 0;
+    if (!GetRange(static_cast<const Binop*>(init)->GetRhs(), startMin, startMax) || startMin < 0)
+    {
+        return false;
+    }
+
+    //i < end, i <= end, end > i or end >= i
+    const Exp* cond = loop->GetCond();
+    if (cond == nullptr || cond->GetExpType() != Binop::sType)
+    {
+        return false;
+    }
+    const Binop* compare = static_cast<const Binop*>(cond);
+    const Exp* bound = nullptr;
+    bool inclusive = false;
+    if (IsIntVariable(compare->GetLhs()) && IsSameVariable(static_cast<const Idd*>(compare->GetLhs()), var) &&
+        (compare->GetOp() == O_LT || compare->GetOp() == O_LTE))
+    {
+        bound = compare->GetRhs();
+        inclusive = compare->GetOp() == O_LTE;
+    }
+    else if (IsIntVariable(compare->GetRhs()) && IsSameVariable(static_cast<const Idd*>(compare->GetRhs()), var) &&
+        (compare->GetOp() == O_GT || compare->GetOp() == O_GTE))
+    {
+        bound = compare->GetLhs();
+        inclusive = compare->GetOp() == O_GTE;
+    }
+    int endMin = 0, endMax = 0;
+    if (bound == nullptr || !GetRange(bound, endMin, endMax))
+    {
+        return false;
+    }
+
+    //++i, i++ or i = i + step
+    const Exp* update = loop->GetUpdate();
+    int step = 0;
+    if (update != nullptr && update->GetExpType() == Unop::sType)
+    {
+        const Unop* unop = static_cast<const Unop*>(update);
+        if (unop->GetOp() == O_INC && IsIntVariable(unop->GetExp()) && IsSameVariable(static_cast<const Idd*>(unop->GetExp()), var))
+        {
+            step = 1;
+        }
+    }
+    else if (update != nullptr && update->GetExpType() == Binop::sType && static_cast<const Binop*>(update)->GetOp() == O_SET)
+    {
+        const Binop* set = static_cast<const Binop*>(update);
+        const Exp* sum = set->GetRhs();
+        if (IsIntVariable(set->GetLhs()) && IsSameVariable(static_cast<const Idd*>(set->GetLhs()), var) &&
+            sum->GetExpType() == Binop::sType && static_cast<const Binop*>(sum)->GetOp() == O_PLUS)
+        {
+            const Exp* lhs = static_cast<const Binop*>(sum)->GetLhs();
+            const Exp* rhs = static_cast<const Binop*>(sum)->GetRhs();
+            int constant = 0;
+            if (IsIntVariable(lhs) && IsSameVariable(static_cast<const Idd*>(lhs), var) && GetIntConstant(rhs, constant))
+            {
+                step = constant;
+            }
+            else if (IsIntVariable(rhs) && IsSameVariable(static_cast<const Idd*>(rhs), var) && GetIntConstant(lhs, constant))
+            {
+                step = constant;
+            }
+        }
+    }
+
+    //counting up. With the step and the bound under RANGE_LIMIT, the last value plus the step never wraps around
+    if (step <= 0 || step > RANGE_LIMIT)
+    {
+        return false;
+    }
+
+    //nothing else in the loop can write the variable
+    WriteFinder finder(var);
+    loop->GetStmtList()->Access(&finder);
+    if (finder.Found())
+    {
+        return false;
+    }
+
+    //from a constant start, the variable only takes the values start + n * step
+    int last = inclusive ? endMax : endMax - 1;
+    if (startMin == startMax && last > startMin)
+    {
+        last = startMin + (last - startMin) / step * step;
+    }
+
+    induction.mVar = var;
+    induction.mMin = startMin;
+    induction.mMax = last;
+    return true;
+}
+
+void RangeAnalysis::Visit(Program* n)
+{
+    if (n->GetStmtList() != nullptr)
+    {
+        n->GetStmtList()->Access(this);
+    }
+}
+
+void RangeAnalysis::Visit(Exp* n)
+{
+    PG_FAILSTR("[RangeAnalysis::Visit(Exp*)] This node should not be visited!");
+}
+
+void RangeAnalysis::Visit(ExpList* n)
+{
+    for (ExpList* list = n; list != nullptr && list->GetExp() != nullptr; list = list->GetTail())
+    {
+        list->GetExp()->Access(this);
+    }
+}
+
+void RangeAnalysis::Visit(Stmt* n)
+{
+    PG_FAILSTR("[RangeAnalysis::Visit(Stmt*)] This node should not be visited!");
+}
+
+void RangeAnalysis::Visit(StmtList* n)
+{
+    for (StmtList* list = n; list != nullptr; list = list->GetTail())
+    {
+        if (list->GetStmt() != nullptr)
+        {
+            list->GetStmt()->Access(this);
+        }
+    }
+}
+
+void RangeAnalysis::Visit(ArgDec* n)
+{
+    PG_FAILSTR("[RangeAnalysis::Visit(ArgDec*)] This node should not be visited!");
+}
+
+void RangeAnalysis::Visit(ArgList* n)
+{
+    PG_FAILSTR("[RangeAnalysis::Visit(ArgList*)] This node should not be visited!");
+}
+
+void RangeAnalysis::Visit(Idd* n)
+{
+}
+
+void RangeAnalysis::Visit(Imm* n)
+{
+}
+
+void RangeAnalysis::Visit(StrImm* n)
+{
+}
+
+void RangeAnalysis::Visit(ArrayConstructor* n)
+{
+}
+
+void RangeAnalysis::Visit(Annotations* n)
+{
+}
+
+void RangeAnalysis::Visit(Binop* n)
+{
+    n->GetLhs()->Access(this);
+    if (n->GetOp() != O_DOT)
+    {
+        //the right side of a dot is a member name
+        n->GetRhs()->Access(this);
+    }
+
+    if (n->GetOp() == O_ACCESS)
+    {
+        const TypeDesc* arrayType = n->GetLhs()->GetTypeDesc();
+        const TypeDesc::ModifierProperty& prop = arrayType->GetModifierProperty();
+        int count = arrayType->GetModifier() == TypeDesc::M_VECTOR ? prop.VectorSize : prop.ArraySize;
+        int indexMin = 0, indexMax = 0;
+        bool inRange = GetRange(n->GetRhs(), indexMin, indexMax) && indexMin >= 0 && indexMax < count;
+        n->SetIndexInRange(inRange);
+        mProvenCount += inRange ? 1 : 0;
+        mCheckedCount += inRange ? 0 : 1;
+    }
+}
+
+void RangeAnalysis::Visit(Unop* n)
+{
+    n->GetExp()->Access(this);
+}
+
+void RangeAnalysis::Visit(FunCall* n)
+{
+    if (n->GetArgs() != nullptr)
+    {
+        n->GetArgs()->Access(this);
+    }
+}
+
+void RangeAnalysis::Visit(StmtExp* n)
+{
+    n->GetExp()->Access(this);
+}
+
+void RangeAnalysis::Visit(StmtFunDec* n)
+{
+    //callbacks have no body
+    if (n->GetStmtList() != nullptr)
+    {
+        n->GetStmtList()->Access(this);
+    }
+}
+
+void RangeAnalysis::Visit(StmtIfElse* n)
+{
+    for (StmtIfElse* link = n; link != nullptr; link = link->GetTail())
+    {
+        if (link->GetExp() != nullptr)
+        {
+            link->GetExp()->Access(this);
+        }
+        link->GetStmtList()->Access(this);
+    }
+}
+
+void RangeAnalysis::Visit(StmtWhile* n)
+{
+    n->GetExp()->Access(this);
+    n->GetStmtList()->Access(this);
+}
+
+void RangeAnalysis::Visit(StmtFor* n)
+{
+    //the header runs with the variable out of the range of the body
+    Exp* exps[] = { n->GetInit(), n->GetCond(), n->GetUpdate() };
+    for (int i = 0; i < sizeof(exps) / sizeof(exps[0]); ++i)
+    {
+        if (exps[i] != nullptr)
+        {
+            exps[i]->Access(this);
+        }
+    }
+
+    Induction induction;
+    bool isCounted = MatchInduction(n, induction);
+    if (isCounted)
+    {
+        mInductions.PushEmpty() = induction;
+    }
+    n->GetStmtList()->Access(this);
+    if (isCounted)
+    {
+        mInductions.Pop();
+    }
+}
+
+void RangeAnalysis::Visit(StmtReturn* n)
+{
+    n->GetExp()->Access(this);
+}
+
+void RangeAnalysis::Visit(StmtStructDef* n)
+{
+}
+
+void RangeAnalysis::Visit(StmtEnumTypeDef* n)
+{
+}
@@ -0,0 +1,165 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                       Pegasus                                        */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file   ScriptSignature.cpp
+//! \author agent
+//! \date   16th October 2026
+//! \brief  Fingerprint of a compiled script, compared across recompilations of a script
+//!         being edited to find out whether its running states survive the edit.
+
+#include "Pegasus/BlockScript/ScriptSignature.h"
+#include "Pegasus/BlockScript/BlockScriptAst.h"
+#include "Pegasus/BlockScript/IVisitor.h"
+#include "Pegasus/BlockScript/PrettyPrint.h"
+#include "Pegasus/BlockScript/TypeDesc.h"
+#include "Pegasus/Core/Assertion.h"
+#include "Pegasus/Utils/String.h"
+
+using namespace Pegasus::BlockScript;
+
+//64 bit FNV-1a
+static void HashBytes(Pegasus::Math::PUInt64& hash, const void* data, int size)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (int i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= PCST_UINT64(1099511628211);
+    }
+}
+
+static const Pegasus::Math::PUInt64 HASH_SEED = PCST_UINT64(14695981039346656037);
+
+//! hash the pretty printer writes into. Scripts compile concurrently, so there is one per thread
+static thread_local Pegasus::Math::PUInt64* sPrintHash = nullptr;
+
+static int HashPrintedString(const char* str)
+{
+    HashBytes(*sPrintHash, str, Pegasus::Utils::Strlen(str));
+    return 0;
+}
+
+static int HashPrintedInt(int i)
+{
+    HashBytes(*sPrintHash, &i, sizeof(i));
+    return 0;
+}
+
+static int HashPrintedFloat(float f)
+{
+    HashBytes(*sPrintHash, &f, sizeof(f));
+    return 0;
+}
+
+//! hashes a statement as the pretty printer writes it
+static void HashStmt(Pegasus::Math::PUInt64& hash, Ast::Stmt* stmt)
+{
+    PrettyPrint printer(HashPrintedString, HashPrintedInt, HashPrintedFloat);
+    sPrintHash = &hash;
+    stmt->Access(static_cast<IVisitor*>(&printer));
+    sPrintHash = nullptr;
+}
+
+//! Visits the top level statements of a program, remembering the function declarations
+class StmtVisitor : public IVisitor
+{
+public:
+    StmtVisitor() : mFunction(nullptr) {}
+    virtual ~StmtVisitor() {}
+
+    //! \return the function declared by the last statement visited, null if it is not a function
+    Ast::StmtFunDec* GetFunction() const { return mFunction; }
+
+    #define BS_PROCESS(N) virtual void Visit(Ast::N* n) { mFunction = nullptr; }
+    #include "Pegasus/BlockScript/Ast.inl"
+    #undef BS_PROCESS
+
+protected:
+    Ast::StmtFunDec* mFunction;
+};
+
+class FunctionVisitor : public StmtVisitor
+{
+public:
+    virtual void Visit(Ast::StmtFunDec* n) { mFunction = n; }
+    using StmtVisitor::Visit;
+};
+
+//----------------------------------------------------------------------------------------
+
+ScriptSignature::ScriptSignature(Pegasus::Alloc::IAllocator* allocator)
+: mLayoutKey(0), mIsValid(false)
+{
+    mFunctions.Initialize(allocator);
+}
+
+ScriptSignature::~ScriptSignature()
+{
+}
+
+void ScriptSignature::Reset()
+{
+    mFunctions.Reset();
+    mLayoutKey = 0;
+    mIsValid = false;
+}
+
+void ScriptSignature::Build(Ast::Program* program)
+{
+    Reset();
+    mLayoutKey = HASH_SEED;
+    FunctionVisitor visitor;
+    for (Ast::StmtList* list = program->GetStmtList(); list != nullptr; list = list->GetTail())
+    {
+        Ast::Stmt* stmt = list->GetStmt();
+        if (stmt == nullptr)
+        {
+            continue;
+        }
+
+        stmt->Access(&visitor);
+        Ast::StmtFunDec* funDec = visitor.GetFunction();
+        if (funDec == nullptr)
+        {
+            //globals, types and global scope code
+            HashStmt(mLayoutKey, stmt);
+            continue;
+        }
+
+        FunctionEntry& entry = mFunctions.PushEmpty();
+        entry.mName = HASH_SEED;
+        HashBytes(entry.mName, funDec->GetName(), Pegasus::Utils::Strlen(funDec->GetName()));
+        for (Ast::ArgList* args = funDec->GetArgList(); args != nullptr && args->GetArgDec() != nullptr; args = args->GetTail())
+        {
+            const char* typeName = args->GetArgDec()->GetType()->GetName();
+            HashBytes(entry.mName, typeName, Pegasus::Utils::Strlen(typeName) + 1);
+        }
+        entry.mBody = HASH_SEED;
+        HashStmt(entry.mBody, stmt);
+    }
+    mIsValid = true;
+}
+
+int ScriptSignature::CountChangedFunctions(const ScriptSignature& previous) const
+{
+    if (!mIsValid || !previous.mIsValid || mLayoutKey != previous.mLayoutKey)
+    {
+        return -1;
+    }
+
+    int changed = 0;
+    for (int f = 0; f < mFunctions.Size(); ++f)
+    {
+        const FunctionEntry& entry = mFunctions[f];
+        bool found = false;
+        for (int p = 0; p < previous.mFunctions.Size() && !found; ++p)
+        {
+            found = previous.mFunctions[p].mName == entry.mName && previous.mFunctions[p].mBody == entry.mBody;
+        }
+        changed += found ? 0 : 1;
+    }
+    return changed;
+}
@@ -46,16 +46,48 @@ void StackFrameInfo::Reset()
 int StackFrameInfo::Allocate(const char* name, const TypeDesc* type, bool isFunArg)
 {
     StackFrameInfo::Entry& e = mEntries.PushEmpty();
-    PG_ASSERT(Utils::Strlen(name) + 1 < IddStrPool::sCharsPerString);
-    Utils::Strcat(e.mName, name);
+    e.mName = name;
     int sz = type->GetByteSize();    
-    e.mOffset = mSize;
+
+    //arguments and struct members are laid out in this frame, anything else goes to the storage frame
+    StackFrameInfo* storage = isFunArg ? this : GetStorageFrame();
+
+    //arguments and struct members are packed, since c++ callbacks read them in sequence
+    if (!isFunArg && IsAlignedSlot(type))
+    {
+        storage->mSize = AlignSlot(storage->mSize);
+    }
+    e.mOffset = storage->mSize;
     e.mType = type;
     e.mIsArg = isFunArg;
-    mSize += sz;
+    storage->mSize += sz;
     return e.mOffset;
 }
 
+bool StackFrameInfo::IsAlignedSlot(const TypeDesc* type)
+{
+    TypeDesc::AluEngine engine = type->GetAluEngine();
+    return engine == TypeDesc::E_FLOAT4 || engine == TypeDesc::E_MATRIX2x2 || 
+           engine == TypeDesc::E_MATRIX3x3 || engine == TypeDesc::E_MATRIX4x4;
+}
+
+bool StackFrameInfo::IsStorageFrame() const
+{
+    // block frames get their category once they are closed, so anything that is not
+    // a function body or the global frame is treated as a block frame
+    return mParent == nullptr || mCreatorCategory == FUN_BODY || mCreatorCategory == STRUCT_DEF;
+}
+
+StackFrameInfo* StackFrameInfo::GetStorageFrame()
+{
+    StackFrameInfo* frame = this;
+    while (!frame->IsStorageFrame())
+    {
+        frame = frame->GetParentStackFrame();
+    }
+    return frame;
+}
+
 int StackFrameInfo::AllocateTemporal(int newSize)
 {
     int targetOffset = mTempSize;
@@ -69,7 +101,7 @@ StackFrameInfo::Entry* StackFrameInfo::FindDeclaration(const char* name)
     for (int i = 0; i < total; ++i)
     {
         StackFrameInfo::Entry& e = mEntries[i];
-        if (!Utils::Strcmp(name, e.mName))
+        if (name == e.mName)
         {
             return &e;
         }
@@ -17,7 +17,7 @@ using namespace Pegasus;
 using namespace Pegasus::BlockScript;
 
 SymbolTable::SymbolTable()
-    : mAllocator(nullptr)
+    : mAllocator(nullptr), mStrPool(nullptr)
 {
 }
 
@@ -25,17 +25,19 @@ SymbolTable::~SymbolTable()
 {
 }
 
-void SymbolTable::Initialize(Pegasus::Alloc::IAllocator* allocator)
+void SymbolTable::Initialize(Pegasus::Alloc::IAllocator* allocator, IddStrPool* strPool)
 {
     mAllocator = allocator;
+    mStrPool = strPool;
     mFunTable.Initialize(allocator);
-    mTypeTable.Initialize(allocator);
+    mTypeTable.Initialize(allocator, strPool);
     mFrames.Initialize(allocator);
     mChildren.Initialize(allocator);
 }
 
 void SymbolTable::RegisterChild(SymbolTable* symbolTable)
 {
+    PG_ASSERTSTR(symbolTable->mStrPool == mStrPool, "Child symbol tables must share the identifier pool");
     SymbolTable** newSpace = &mChildren.PushEmpty();
     *newSpace = symbolTable;
 }
@@ -72,33 +74,46 @@ void SymbolTable::Reset()
 }
 
 const TypeDesc* SymbolTable::GetTypeByName(const char* typeName) const
+{
+    //a name never interned cannot be the name of a type
+    const char* handle = mStrPool->Find(typeName);
+    return handle == nullptr ? nullptr : GetTypeByName(handle, IddStrPool::GetHash(handle));
+}
+
+const TypeDesc* SymbolTable::GetTypeByName(const char* typeName, unsigned int hash) const
 {
     //first find it recursively on the children symbol tables
     int childCount = mChildren.Size();
     for (int i = 0; i < childCount; ++i)
     {
-        const TypeDesc* type = mChildren[i]->GetTypeByName(typeName);
+        const TypeDesc* type = mChildren[i]->GetTypeByName(typeName, hash);
         if (type != nullptr)
         {
             return type;
         }
     }
-    return mTypeTable.GetTypeByName(typeName);
+    return mTypeTable.GetTypeByName(typeName, hash);
 }
 
 TypeDesc* SymbolTable::GetTypeForPatching(const char* typeName)
+{
+    const char* handle = mStrPool->Find(typeName);
+    return handle == nullptr ? nullptr : GetTypeForPatching(handle, IddStrPool::GetHash(handle));
+}
+
+TypeDesc* SymbolTable::GetTypeForPatching(const char* typeName, unsigned int hash)
 {
     //first find it recursively on the children symbol tables
     int childCount = mChildren.Size();
     for (int i = 0; i < childCount; ++i)
     {
-        TypeDesc* type = mChildren[i]->GetTypeForPatching(typeName);
+        TypeDesc* type = mChildren[i]->GetTypeForPatching(typeName, hash);
         if (type != nullptr)
         {
             return type;
         }
     }
-    return mTypeTable.GetTypeForPatching(typeName);
+    return mTypeTable.GetTypeForPatching(typeName, hash);
 }
 
 TypeDesc* SymbolTable::InternalCreateType(
@@ -204,17 +219,23 @@ TypeDesc* SymbolTable::CreateArrayType(const char* name, TypeDesc* childType, in
 }
 
 bool SymbolTable::FindEnumByName(const char* name, const EnumNode** outEnumNode, const TypeDesc** outEnumType) const
+{
+    const char* handle = mStrPool->Find(name);
+    return handle != nullptr && FindEnumByName(handle, IddStrPool::GetHash(handle), outEnumNode, outEnumType);
+}
+
+bool SymbolTable::FindEnumByName(const char* name, unsigned int hash, const EnumNode** outEnumNode, const TypeDesc** outEnumType) const
 {
     int childCount = mChildren.Size();
     for (int i = 0; i < childCount; ++i)
     {
-        if (mChildren[i]->FindEnumByName(name, outEnumNode, outEnumType))
+        if (mChildren[i]->FindEnumByName(name, hash, outEnumNode, outEnumType))
         {
             return true;
         }
     }
 
-    return mTypeTable.FindEnumByName(name, outEnumNode, outEnumType);
+    return mTypeTable.FindEnumByName(name, hash, outEnumNode, outEnumType);
 }
 
 EnumNode* SymbolTable::NewEnumNode()
@@ -228,17 +249,22 @@ PropertyNode* SymbolTable::NewPropertyNode()
 }
 
 FunDesc* SymbolTable::FindFunctionDescription(BlockScript::Ast::FunCall* functionCall)
+{
+    return FindFunctionDescription(functionCall, IddStrPool::GetHash(functionCall->GetName()));
+}
+
+FunDesc* SymbolTable::FindFunctionDescription(BlockScript::Ast::FunCall* functionCall, unsigned int hash)
 {
     int childCount = mChildren.Size();
     for (int i = 0; i < childCount; ++i)
     {
-        FunDesc* foundDesc = mChildren[i]->FindFunctionDescription(functionCall);
+        FunDesc* foundDesc = mChildren[i]->FindFunctionDescription(functionCall, hash);
         if (foundDesc != nullptr)
         {
             return foundDesc;
         }
     }
-    return mFunTable.Find(functionCall);
+    return mFunTable.Find(functionCall, hash);
 }
 
 FunDesc* SymbolTable::CreateFunctionDescription(BlockScript::Ast::StmtFunDec* funDec)
@@ -23,6 +23,7 @@ using namespace Pegasus::BlockScript::Ast;
 
 TypeDesc::TypeDesc()
 :
+mName(nullptr),
 mModifier(M_INVALID),
 mAluEngine(E_NONE),
 mChild(nullptr),
@@ -32,28 +33,17 @@ mPropertyNode(nullptr),
 mPropertyCallback(nullptr),
 mByteSize(0)
 {
-    mName[0] = '\0';
 }
 
 TypeDesc::~TypeDesc()
 {
 }
 
-void TypeDesc::SetName(const char * typeName)
-{
-#if PEGASUS_ENABLE_ASSERT
-    int strlen = Utils::Strlen(typeName) + 1;
-    PG_ASSERTSTR(strlen < TypeDesc::sMaxTypeName, "Maximum type name description registered");
-#endif
-    mName[0] = '\0';
-    Utils::Strcat(mName, typeName);
-}
-
 bool TypeDesc::Equals(const TypeDesc* other) const
 {
     return  other->mModifier == TypeDesc::M_STAR || mModifier == TypeDesc::M_STAR ||  //star means any type, so accept it
             (
-                !Utils::Strcmp(mName, other->mName) &&
+                mName == other->mName && //names are interned
                 CmpStructProperty(other) &&
                 CmpEnumProperty(other) &&
                 mModifier == other->mModifier &&
@@ -77,7 +67,7 @@ bool TypeDesc::CmpEnumProperty(const TypeDesc* other) const
     
         while (node1 != nullptr && node2 != nullptr)
         {
-            if (Utils::Strcmp(node1->mIdd, node2->mIdd))
+            if (node1->mIdd != node2->mIdd)
             {
                 return false;
             }
@@ -99,7 +89,7 @@ bool TypeDesc::CmpStructProperty(const TypeDesc* other) const
     }
     else
     {
-        if (Utils::Strcmp(mStructDef->GetName(), other->mStructDef->GetName()))
+        if (mStructDef->GetName() != other->mStructDef->GetName())
         {
             return false;
         }
@@ -134,23 +124,24 @@ bool TypeDesc::CmpStructProperty(const TypeDesc* other) const
 
 bool TypeDesc::ComputeSize()
 {
+    int byteSize = 0;
     switch (GetModifier())
     {
     case TypeDesc::M_STAR:
     case TypeDesc::M_SCALAR:
     case TypeDesc::M_ENUM:
     case TypeDesc::M_REFERECE:
-        mByteSize = CANON_REGISTER_BYTESIZE; //4 bytes for scalars, enums, object refs and imms
-        return true;
+        byteSize = CANON_REGISTER_BYTESIZE; //4 bytes for scalars, enums, object refs and imms
+        break;
     case TypeDesc::M_VECTOR:
-        mByteSize = GetChild()->GetByteSize() * GetModifierProperty().VectorSize;
-        return true;
+        byteSize = GetChild()->GetByteSize() * GetModifierProperty().VectorSize;
+        break;
     case TypeDesc::M_ARRAY:
         {
             if (GetChild() != nullptr) GetChild()->ComputeSize();
-            mByteSize = GetModifierProperty().ArraySize * GetChild()->GetByteSize(); //4 bytes for reference.
-            return true;
+            byteSize = GetModifierProperty().ArraySize * GetChild()->GetByteSize(); //4 bytes for reference.
         }
+        break;
     case TypeDesc::M_STRUCT:
         {
             const Ast::StmtStructDef* structDef = GetStructDef();
@@ -167,12 +158,19 @@ bool TypeDesc::ComputeSize()
                 }
                 argList = argList->GetTail();                    
             }
-            mByteSize = totalSize;
+            byteSize = totalSize;
         }
-        return true;
+        break;
     default:
         PG_FAILSTR("Unhandled modifier while computing file size :(");
         return false;
     }
-    return false;
+
+    //library types are shared by scripts compiling concurrently, and their size never changes after
+    //creation. Only writing a different size keeps recomputing it a read.
+    if (mByteSize != byteSize)
+    {
+        mByteSize = byteSize;
+    }
+    return true;
 }
@@ -14,6 +14,7 @@ using namespace Pegasus::BlockScript;
 #define POOL_INCREMENT 16
 
 TypeTable::TypeTable()
+: mStrPool(nullptr)
 {
 }
 
@@ -22,12 +23,15 @@ TypeTable::~TypeTable()
     Shutdown();
 }
 
-void TypeTable::Initialize(Alloc::IAllocator* alloc)
+void TypeTable::Initialize(Alloc::IAllocator* alloc, IddStrPool* strPool)
 {
     PG_ASSERT(mTypeDescPool.Size() == 0);
+    mStrPool = strPool;
     mTypeDescPool.Initialize(alloc);
     mEnumNodePool.Initialize(alloc);
     mPropertyNodePool.Initialize(alloc);
+    mTypeIndex.Initialize(alloc);
+    mEnumIndex.Initialize(alloc);
 }
 
 void TypeTable::Shutdown()
@@ -35,6 +39,8 @@ void TypeTable::Shutdown()
     mTypeDescPool.Reset();
     mEnumNodePool.Reset();
     mPropertyNodePool.Reset();
+    mTypeIndex.Reset();
+    mEnumIndex.Reset();
 }
 
 TypeDesc* TypeTable::CreateType(
@@ -50,15 +56,16 @@ TypeDesc* TypeTable::CreateType(
 )
 {
     PG_ASSERT(modifier != TypeDesc::M_INVALID);
-    int s = mTypeDescPool.Size();
+    name = mStrPool->Intern(name);
+    unsigned int hash = IddStrPool::GetHash(name);
     if (modifier != TypeDesc::M_ARRAY)
     {
-        for (int i = 0; i < s; ++i)
+        for (int c = mTypeIndex.Find(hash); c != -1; c = mTypeIndex.Next(c))
         {
-            TypeDesc* t = &mTypeDescPool[i];
+            TypeDesc* t = &mTypeDescPool[mTypeIndex.GetValue(c)];
             PG_ASSERT(t->GetModifier() != TypeDesc::M_INVALID);
             if (
-                !Utils::Strcmp(name, t->GetName())
+                name == t->GetName()
                )
             {
                 if (
@@ -89,56 +96,76 @@ TypeDesc* TypeTable::CreateType(
     bool success = newDesc.ComputeSize();
     PG_ASSERTSTR(success, "Fail computing size for type!");
 
+    if (modifier != TypeDesc::M_ARRAY)
+    {
+        mTypeIndex.Insert(hash, idx);
+    }
+
+    //enumeration values are looked up by name too
+    for (EnumNode* node = enumNode; modifier == TypeDesc::M_ENUM && node != nullptr; node = node->mNext)
+    {
+        node->mIdd = mStrPool->Intern(node->mIdd);
+        mEnumIndex.Insert(IddStrPool::GetHash(node->mIdd), idx);
+    }
+
+    for (PropertyNode* node = propertyNode; node != nullptr; node = node->mNext)
+    {
+        node->mName = mStrPool->Intern(node->mName);
+    }
 
     return &newDesc;
 }
 
 const TypeDesc* TypeTable::GetTypeByName(const char* name) const
 {
-    int s = mTypeDescPool.Size();
-    for (int i = 0; i < s; ++i)
+    const char* handle = mStrPool->Find(name);
+    return handle == nullptr ? nullptr : GetTypeByName(handle, IddStrPool::GetHash(handle));
+}
+
+const TypeDesc* TypeTable::GetTypeByName(const char* name, unsigned int hash) const
+{
+    for (int c = mTypeIndex.Find(hash); c != -1; c = mTypeIndex.Next(c))
     {
-        if(!Utils::Strcmp(name, mTypeDescPool[i].GetName()) && mTypeDescPool[i].GetModifier() != TypeDesc::M_ARRAY)
+        const TypeDesc& t = mTypeDescPool[mTypeIndex.GetValue(c)];
+        if(name == t.GetName())
         {
-            return &(mTypeDescPool[i]);
+            return &t;
         }
     }
     return nullptr;
 }
 
-//!TODO: figure out how to recycle this code, and respect const correctness
 TypeDesc* TypeTable::GetTypeForPatching(const char* name)
 {
-    int s = mTypeDescPool.Size();
-    for (int i = 0; i < s; ++i)
-    {
-        if(!Utils::Strcmp(name, mTypeDescPool[i].GetName()) && mTypeDescPool[i].GetModifier() != TypeDesc::M_ARRAY)
-        {
-            return &(mTypeDescPool[i]);
-        }
-    }
-    return nullptr;
+    return const_cast<TypeDesc*>(GetTypeByName(name));
+}
+
+TypeDesc* TypeTable::GetTypeForPatching(const char* name, unsigned int hash)
+{
+    return const_cast<TypeDesc*>(GetTypeByName(name, hash));
 }
 
 bool TypeTable::FindEnumByName(const char* name, const EnumNode** outEnumNode, const TypeDesc** outEnumType) const
 {
-    int s = mTypeDescPool.Size();
-    for (int i = 0; i < s; ++i)
+    const char* handle = mStrPool->Find(name);
+    return handle != nullptr && FindEnumByName(handle, IddStrPool::GetHash(handle), outEnumNode, outEnumType);
+}
+
+bool TypeTable::FindEnumByName(const char* name, unsigned int hash, const EnumNode** outEnumNode, const TypeDesc** outEnumType) const
+{
+    for (int c = mEnumIndex.Find(hash); c != -1; c = mEnumIndex.Next(c))
     {
-        const TypeDesc& typeDesc = mTypeDescPool[i];
-        if(typeDesc.GetModifier() == TypeDesc::M_ENUM)
+        const TypeDesc& typeDesc = mTypeDescPool[mEnumIndex.GetValue(c)];
+        const EnumNode* node = typeDesc.GetEnumNode();
+        while (node != nullptr)
         {
-            const EnumNode* node = typeDesc.GetEnumNode();
-            while (node != nullptr)
+            if (node->mIdd == name)
             {
-                if (!Utils::Strcmp(node->mIdd, name))
-                {
-                    *outEnumNode = node;    
-                    *outEnumType = &typeDesc;
-                    return true;
-                }
-                node = node->mNext;
+                *outEnumNode = node;    
+                *outEnumType = &typeDesc;
+                return true;
             }
+            node = node->mNext;
         }
     }
     return false;
@@ -350,8 +350,8 @@ static void yy_fatal_error (yyconst char msg[] ,yyscan_t yyscanner );
 	*yy_cp = '\0'; \
 	yyg->yy_c_buf_p = yy_cp;
 
-#define YY_NUM_RULES 75
-#define YY_END_OF_BUFFER 76
+#define YY_NUM_RULES 76
+#define YY_END_OF_BUFFER 77
 /* This struct is not used in this scanner,
    but its presence is necessary. */
 struct yy_trans_info
@@ -359,26 +359,26 @@ struct yy_trans_info
 	flex_int32_t yy_verify;
 	flex_int32_t yy_nxt;
 	};
-static yyconst flex_int16_t yy_accept[164] =
+static yyconst flex_int16_t yy_accept[169] =
     {   0,
         0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
-        0,    0,    0,    0,   76,   74,   30,   31,   74,   29,
-       26,   53,   74,   66,   67,   51,   49,   72,   50,   64,
-       52,   46,   73,   47,   57,   62,   56,   74,   48,   70,
-       71,   48,   48,   48,   48,   48,   48,   68,   74,   69,
-        2,    1,    5,    4,    5,    7,   75,    6,   25,   23,
-       22,   21,   25,   24,   24,   24,   24,   12,   11,   10,
-        9,    8,   55,   60,   40,   41,   63,   28,   27,    0,
-       46,   48,   59,   54,   58,   65,   48,   48,   48,   48,
-       32,   48,   48,   48,   48,   61,    3,   20,   19,   24,
-
-       24,   24,   24,   24,   24,   45,   48,   48,   48,   48,
-       39,   48,   48,   48,   48,   48,   24,   24,   24,   24,
-       24,   24,   24,   33,   34,   37,   48,   48,   48,   48,
-       48,   48,   24,   17,   16,   24,   24,   24,   48,   48,
-       48,   48,   48,   38,   24,   18,   15,   24,   44,   35,
-       43,   48,   36,   14,   24,   48,   13,   48,   48,   48,
-       48,   42,    0
+        0,    0,    0,    0,   77,   75,   30,   31,   75,   29,
+       26,   54,   75,   67,   68,   52,   50,   73,   51,   65,
+       53,   47,   74,   48,   58,   63,   57,   75,   49,   71,
+       72,   49,   49,   49,   49,   49,   49,   49,   69,   75,
+       70,    2,    1,    5,    4,    5,    7,   76,    6,   25,
+       23,   22,   21,   25,   24,   24,   24,   24,   12,   11,
+       10,    9,    8,   56,   61,   41,   42,   64,   28,   27,
+        0,   47,   49,   60,   55,   59,   66,   49,   49,   49,
+       49,   32,   49,   49,   49,   49,   49,   62,    3,   20,
+
+       19,   24,   24,   24,   24,   24,   24,   46,   49,   49,
+       49,   49,   39,   49,   49,   49,   49,   49,   49,   24,
+       24,   24,   24,   24,   24,   24,   33,   34,   37,   49,
+       49,   49,   49,   49,   49,   49,   24,   17,   16,   24,
+       24,   24,   49,   49,   49,   49,   49,   38,   40,   24,
+       18,   15,   24,   45,   35,   44,   49,   36,   14,   24,
+       49,   13,   49,   49,   49,   49,   43,    0
     } ;
 
 static yyconst flex_int32_t yy_ec[256] =
@@ -422,99 +422,101 @@ static yyconst flex_int32_t yy_meta[51] =
         3,    3,    3,    3,    3,    3,    3,    1,    1,    1
     } ;
 
-static yyconst flex_int16_t yy_base[171] =
+static yyconst flex_int16_t yy_base[176] =
     {   0,
-        0,    0,  277,  276,   48,   49,   50,   51,   61,    0,
-      275,  274,   52,  109,  276,  281,  281,  281,  253,  281,
-      281,  281,  265,  281,  281,  281,  260,  281,   98,  281,
-      102,   99,  281,  281,  250,  249,  248,  259,  252,  281,
-      281,  102,  104,  106,  109,  107,  110,  281,  218,  281,
-      281,  281,  281,  281,  249,  281,  281,  281,  281,  281,
-      281,  281,  112,    0,  233,   92,   94,  281,  281,  281,
-      281,  281,  281,  281,  281,  281,  281,  281,  281,  246,
-      115,  247,  281,  281,  281,  281,  118,  119,  121,  120,
-      246,  129,  130,  132,  134,  281,  281,  281,  281,    0,
-
-      228,  116,  229,  127,  229,  240,  140,  136,  138,  148,
-      241,  139,  151,  150,  154,  158,  221,  222,  222,  218,
-      220,  220,  214,  233,  232,  231,  160,  162,  165,  163,
-      169,  171,  208,    0,    0,  212,  211,  200,  168,  170,
-      172,  177,  173,  226,  209,    0,    0,  191,  204,  202,
-      201,  185,  200,    0,  180,  180,    0,  174,  179,  194,
-      175,  195,  281,  223,  226,  229,  232,  235,  237,   55
+        0,    0,  286,  285,   48,   49,   50,   51,   61,    0,
+      284,  283,   52,  109,  285,  290,  290,  290,  262,  290,
+      290,  290,  274,  290,  290,  290,  269,  290,   98,  290,
+      102,   99,  290,  290,  259,  258,  257,  268,  261,  290,
+      290,  102,  104,  106,  109,  107,  110,  111,  290,  227,
+      290,  290,  290,  290,  290,  258,  290,  290,  290,  290,
+      290,  290,  290,  112,    0,  242,   92,   98,  290,  290,
+      290,  290,  290,  290,  290,  290,  290,  290,  290,  290,
+      255,  116,  256,  290,  290,  290,  290,  117,  119,  121,
+      129,  255,  132,  134,  135,  137,  138,  290,  290,  290,
+
+      290,    0,  237,  120,  238,  128,  238,  249,  140,  144,
+      141,  151,  250,  149,  152,  155,  161,  163,  164,  212,
+      213,  213,  209,  211,  211,  205,  224,  223,  222,  166,
+      169,  171,  170,  172,  175,  177,  199,    0,    0,  203,
+      202,  191,  173,  174,  180,  185,  178,  217,  216,  199,
+        0,    0,  198,  212,  211,  209,  198,  208,    0,  191,
+      187,    0,  179,  182,  201,  202,  205,  290,  248,  251,
+      254,  257,  260,  262,   55
     } ;
 
-static yyconst flex_int16_t yy_def[171] =
+static yyconst flex_int16_t yy_def[176] =
     {   0,
-      163,    1,  164,  164,  165,  165,  166,  166,  163,    9,
-      167,  167,  168,  168,  163,  163,  163,  163,  163,  163,
-      163,  163,  163,  163,  163,  163,  163,  163,  163,  163,
-      163,  169,  163,  163,  163,  163,  163,  163,  169,  163,
-      163,  169,  169,  169,  169,  169,  169,  163,  163,  163,
-      163,  163,  163,  163,  163,  163,  163,  163,  163,  163,
-      163,  163,  163,  170,  170,  170,  170,  163,  163,  163,
-      163,  163,  163,  163,  163,  163,  163,  163,  163,  163,
-      169,  169,  163,  163,  163,  163,  169,  169,  169,  169,
-      169,  169,  169,  169,  169,  163,  163,  163,  163,  170,
-
-      170,  170,  170,  170,  170,  163,  169,  169,  169,  169,
-      169,  169,  169,  169,  169,  169,  170,  170,  170,  170,
-      170,  170,  170,  169,  169,  169,  169,  169,  169,  169,
-      169,  169,  170,  170,  170,  170,  170,  170,  169,  169,
-      169,  169,  169,  169,  170,  170,  170,  170,  169,  169,
-      169,  169,  169,  170,  170,  169,  170,  169,  169,  169,
-      169,  169,    0,  163,  163,  163,  163,  163,  163,  163
+      168,    1,  169,  169,  170,  170,  171,  171,  168,    9,
+      172,  172,  173,  173,  168,  168,  168,  168,  168,  168,
+      168,  168,  168,  168,  168,  168,  168,  168,  168,  168,
+      168,  174,  168,  168,  168,  168,  168,  168,  174,  168,
+      168,  174,  174,  174,  174,  174,  174,  174,  168,  168,
+      168,  168,  168,  168,  168,  168,  168,  168,  168,  168,
+      168,  168,  168,  168,  175,  175,  175,  175,  168,  168,
+      168,  168,  168,  168,  168,  168,  168,  168,  168,  168,
+      168,  174,  174,  168,  168,  168,  168,  174,  174,  174,
+      174,  174,  174,  174,  174,  174,  174,  168,  168,  168,
+
+      168,  175,  175,  175,  175,  175,  175,  168,  174,  174,
+      174,  174,  174,  174,  174,  174,  174,  174,  174,  175,
+      175,  175,  175,  175,  175,  175,  174,  174,  174,  174,
+      174,  174,  174,  174,  174,  174,  175,  175,  175,  175,
+      175,  175,  174,  174,  174,  174,  174,  174,  174,  175,
+      175,  175,  175,  174,  174,  174,  174,  174,  175,  175,
+      174,  175,  174,  174,  174,  174,  174,    0,  168,  168,
+      168,  168,  168,  168,  168
     } ;
 
-static yyconst flex_int16_t yy_nxt[332] =
+static yyconst flex_int16_t yy_nxt[341] =
     {   0,
        16,   17,   18,   16,   19,   20,   21,   22,   23,   24,
        25,   26,   27,   28,   29,   30,   31,   32,   33,   34,
        35,   36,   37,   38,   39,   40,   41,   39,   39,   39,
        39,   42,   43,   39,   44,   39,   39,   39,   39,   45,
-       46,   39,   39,   47,   39,   39,   39,   48,   49,   50,
-       54,   54,   57,   57,   71,   58,   58,  100,   72,   55,
-       55,   59,   60,   61,   60,   59,   62,   59,   59,   59,
-       59,   59,   59,   59,   59,   59,   59,   63,   64,   59,
-       59,   59,   59,   59,   59,   64,   59,   59,   64,   64,
-       64,   65,   66,   64,   64,   67,   64,   64,   64,   64,
-
-       64,   64,   64,   64,   64,   64,   64,   64,   59,   59,
-       59,   71,   76,   78,   80,   72,   81,  163,   79,  163,
-       77,  163,  163,   98,  163,  163,  104,  102,   99,  103,
-       80,  105,   81,  163,  163,  163,  163,   87,   91,   88,
-       92,   93,   90,   95,  163,  163,   89,  163,   94,  163,
-      118,  163,  107,  163,  163,  163,  119,  121,  108,  111,
-      114,  109,  110,  163,  122,  163,  163,  125,  116,  163,
-      112,  115,  124,  163,  126,  163,  113,  163,  163,  127,
-      163,  128,  129,  163,  163,  163,  163,  163,  163,  163,
-      163,  130,  163,  132,  163,  163,  131,  142,  143,  139,
-
-      163,  140,  144,  141,  151,  149,  152,  150,  158,  163,
-      163,  157,  156,  159,  153,  163,  163,  163,  160,  163,
-      162,  155,  161,   51,   51,   51,   53,   53,   53,   56,
-       56,   56,   68,   68,   68,   70,   70,   70,   82,   82,
-      154,  163,  148,  147,  146,  145,  163,  163,  163,  138,
-      121,  137,  136,  135,  134,  133,  163,  106,  123,  120,
-      117,  163,  163,  106,  101,   97,   96,  163,   86,   85,
-       84,   83,   75,   74,   73,  163,   69,   69,   52,   52,
-       15,  163,  163,  163,  163,  163,  163,  163,  163,  163,
-      163,  163,  163,  163,  163,  163,  163,  163,  163,  163,
-
-      163,  163,  163,  163,  163,  163,  163,  163,  163,  163,
-      163,  163,  163,  163,  163,  163,  163,  163,  163,  163,
-      163,  163,  163,  163,  163,  163,  163,  163,  163,  163,
-      163
+       46,   39,   39,   47,   39,   48,   39,   49,   50,   51,
+       55,   55,   58,   58,   72,   59,   59,  102,   73,   56,
+       56,   60,   61,   62,   61,   60,   63,   60,   60,   60,
+       60,   60,   60,   60,   60,   60,   60,   64,   65,   60,
+       60,   60,   60,   60,   60,   65,   60,   60,   65,   65,
+       65,   66,   67,   65,   65,   68,   65,   65,   65,   65,
+
+       65,   65,   65,   65,   65,   65,   65,   65,   60,   60,
+       60,   72,   77,   79,   81,   73,   82,  168,   80,  168,
+       78,  168,  168,  100,  168,  168,  168,  104,  101,  105,
+      106,   81,  168,   82,  168,  107,  168,   88,   92,   89,
+       93,   94,   91,   96,  168,   97,   90,  168,   95,  168,
+      168,  109,  168,  168,  121,  168,  168,  110,  124,  168,
+      122,  111,  112,  116,  168,  125,  168,  168,  113,  119,
+      168,  118,  127,  114,  117,  128,  168,  129,  168,  168,
+      115,  168,  130,  132,  168,  168,  168,  168,  168,  168,
+      168,  131,  168,  168,  168,  168,  133,  168,  135,  136,
+
+      168,  147,  168,  134,  146,  143,  148,  149,  144,  145,
+      154,  155,  156,  168,  157,  163,  168,  168,  164,  158,
+      168,  165,  162,  168,  168,  161,  168,  168,  160,  166,
+      159,  168,  168,  153,  152,  151,  150,  168,  168,  168,
+      142,  124,  141,  140,  139,  138,  137,  167,   52,   52,
+       52,   54,   54,   54,   57,   57,   57,   69,   69,   69,
+       71,   71,   71,   83,   83,  168,  108,  126,  123,  120,
+      168,  168,  108,  103,   99,   98,  168,   87,   86,   85,
+       84,   76,   75,   74,  168,   70,   70,   53,   53,   15,
+      168,  168,  168,  168,  168,  168,  168,  168,  168,  168,
+
+      168,  168,  168,  168,  168,  168,  168,  168,  168,  168,
+      168,  168,  168,  168,  168,  168,  168,  168,  168,  168,
+      168,  168,  168,  168,  168,  168,  168,  168,  168,  168,
+      168,  168,  168,  168,  168,  168,  168,  168,  168,  168
     } ;
 
-static yyconst flex_int16_t yy_chk[332] =
+static yyconst flex_int16_t yy_chk[341] =
     {   0,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        5,    6,    7,    8,   13,    7,    8,  170,   13,    5,
+        5,    6,    7,    8,   13,    7,    8,  175,   13,    5,
         6,    9,    9,    9,    9,    9,    9,    9,    9,    9,
         9,    9,    9,    9,    9,    9,    9,    9,    9,    9,
         9,    9,    9,    9,    9,    9,    9,    9,    9,    9,
@@ -522,30 +524,30 @@ static yyconst flex_int16_t yy_chk[332] =
 
         9,    9,    9,    9,    9,    9,    9,    9,    9,    9,
         9,   14,   29,   31,   32,   14,   32,   42,   31,   43,
-       29,   44,   46,   63,   45,   47,   67,   66,   63,   66,
-       81,   67,   81,   87,   88,   90,   89,   42,   44,   42,
-       45,   46,   43,   47,   92,   93,   42,   94,   46,   95,
-      102,  108,   87,  109,  112,  107,  102,  104,   87,   90,
-       94,   88,   89,  110,  104,  114,  113,  108,   95,  115,
-       92,   94,  107,  116,  109,  127,   93,  128,  130,  110,
-      129,  112,  113,  139,  131,  140,  132,  141,  143,  158,
-      161,  114,  142,  116,  159,  156,  115,  130,  131,  127,
-
-      152,  128,  132,  129,  141,  139,  142,  140,  156,  160,
-      162,  155,  152,  158,  143,  153,  151,  150,  159,  149,
-      161,  148,  160,  164,  164,  164,  165,  165,  165,  166,
-      166,  166,  167,  167,  167,  168,  168,  168,  169,  169,
-      145,  144,  138,  137,  136,  133,  126,  125,  124,  123,
-      122,  121,  120,  119,  118,  117,  111,  106,  105,  103,
-      101,   91,   82,   80,   65,   55,   49,   39,   38,   37,
-       36,   35,   27,   23,   19,   15,   12,   11,    4,    3,
-      163,  163,  163,  163,  163,  163,  163,  163,  163,  163,
-      163,  163,  163,  163,  163,  163,  163,  163,  163,  163,
-
-      163,  163,  163,  163,  163,  163,  163,  163,  163,  163,
-      163,  163,  163,  163,  163,  163,  163,  163,  163,  163,
-      163,  163,  163,  163,  163,  163,  163,  163,  163,  163,
-      163
+       29,   44,   46,   64,   45,   47,   48,   67,   64,   67,
+       68,   82,   88,   82,   89,   68,   90,   42,   44,   42,
+       45,   46,   43,   47,   91,   48,   42,   93,   46,   94,
+       95,   88,   96,   97,  104,  109,  111,   88,  106,  110,
+      104,   89,   90,   95,  114,  106,  112,  115,   91,   97,
+      116,   96,  109,   93,   95,  110,  117,  111,  118,  119,
+       94,  130,  112,  115,  131,  133,  132,  134,  143,  144,
+      135,  114,  136,  147,  163,  145,  116,  164,  118,  119,
+
+      146,  134,  161,  117,  133,  130,  135,  136,  131,  132,
+      143,  144,  145,  157,  146,  161,  165,  166,  163,  147,
+      167,  164,  160,  158,  156,  157,  155,  154,  153,  165,
+      150,  149,  148,  142,  141,  140,  137,  129,  128,  127,
+      126,  125,  124,  123,  122,  121,  120,  166,  169,  169,
+      169,  170,  170,  170,  171,  171,  171,  172,  172,  172,
+      173,  173,  173,  174,  174,  113,  108,  107,  105,  103,
+       92,   83,   81,   66,   56,   50,   39,   38,   37,   36,
+       35,   27,   23,   19,   15,   12,   11,    4,    3,  168,
+      168,  168,  168,  168,  168,  168,  168,  168,  168,  168,
+
+      168,  168,  168,  168,  168,  168,  168,  168,  168,  168,
+      168,  168,  168,  168,  168,  168,  168,  168,  168,  168,
+      168,  168,  168,  168,  168,  168,  168,  168,  168,  168,
+      168,  168,  168,  168,  168,  168,  168,  168,  168,  168
     } ;
 
 /* The intent behind this definition is that it'll catch
@@ -615,7 +617,7 @@ static yyconst flex_int16_t yy_chk[332] =
 
 
 
-#line 619 "bs.lexer.cpp"
+#line 621 "bs.lexer.cpp"
 
 #define INITIAL 0
 #define IN_LINE_COMMENT 1
@@ -857,7 +859,7 @@ YY_DECL
 
 #line 69 "bs.l"
 
-#line 861 "bs.lexer.cpp"
+#line 863 "bs.lexer.cpp"
 
     yylval = yylval_param;
 
@@ -912,13 +914,13 @@ yy_match:
 			while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 				{
 				yy_current_state = (int) yy_def[yy_current_state];
-				if ( yy_current_state >= 164 )
+				if ( yy_current_state >= 169 )
 					yy_c = yy_meta[(unsigned int) yy_c];
 				}
 			yy_current_state = yy_nxt[yy_base[yy_current_state] + (unsigned int) yy_c];
 			++yy_cp;
 			}
-		while ( yy_base[yy_current_state] != 281 );
+		while ( yy_base[yy_current_state] != 290 );
 
 yy_find_action:
 		yy_act = yy_accept[yy_current_state];
@@ -1376,10 +1378,6 @@ YY_RULE_SETUP
                     }
                     else
                     {
-                        char * str = yyextra->mBuilder->GetStringPool().AllocateString();
-                        if (str == nullptr) { BS_ErrorDispatcher( yyextra->mBuilder, "Out of identifier memory!"); yyterminate(); }
-						str[0] = '\0';
-                        Pegasus::Utils::Strcat(str, yytext);
                         pp.PushString(yyextra->mBuilder->AllocStrImm(yytext));
                         
                         if (pp.GetCmd() == Pegasus::BlockScript::Preprocessor::PP_CMD_DEFINE)
@@ -1394,7 +1392,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 25:
 YY_RULE_SETUP
-#line 425 "bs.l"
+#line 421 "bs.l"
 { BS_ErrorDispatcher( yyextra->mBuilder, "Invalid token for preprocessor."); yyterminate(); }
 	YY_BREAK
 
@@ -1402,273 +1400,269 @@ YY_RULE_SETUP
 
 case 26:
 YY_RULE_SETUP
-#line 430 "bs.l"
+#line 426 "bs.l"
 { yyextra->PushLexerState(YYSTATE); BEGIN(PREPROCESSOR);}
 	YY_BREAK
 case 27:
 YY_RULE_SETUP
-#line 431 "bs.l"
+#line 427 "bs.l"
 { yyextra->PushLexerState(YYSTATE);BEGIN(IN_LINE_COMMENT);}
 	YY_BREAK
 case 28:
 YY_RULE_SETUP
-#line 432 "bs.l"
+#line 428 "bs.l"
 { yyextra->PushLexerState(YYSTATE);BEGIN(MULTI_COMMENT);  }
 	YY_BREAK
 case 29:
 YY_RULE_SETUP
-#line 433 "bs.l"
+#line 429 "bs.l"
 { yyextra->mStringAccumulatorPos = 0; yyextra->PushLexerState(YYSTATE);BEGIN(STRING_BLOCK); }
 	YY_BREAK
 case 30:
 YY_RULE_SETUP
-#line 434 "bs.l"
+#line 430 "bs.l"
 ;
 	YY_BREAK
 case 31:
 /* rule 31 can match eol */
 YY_RULE_SETUP
-#line 435 "bs.l"
+#line 431 "bs.l"
 { yyextra->mBuilder->IncrementLine();       }
 	YY_BREAK
 case 32:
 YY_RULE_SETUP
-#line 436 "bs.l"
-{ return K_IF;     }
+#line 432 "bs.l"
+{ yyextra->mBuilder->MarkKeywordLine(); return K_IF; }
 	YY_BREAK
 case 33:
 YY_RULE_SETUP
-#line 437 "bs.l"
-{ return K_ELSE_IF;}
+#line 433 "bs.l"
+{ yyextra->mBuilder->MarkKeywordLine(); return K_ELSE_IF; }
 	YY_BREAK
 case 34:
 YY_RULE_SETUP
-#line 438 "bs.l"
+#line 434 "bs.l"
 { return K_ELSE;   }
 	YY_BREAK
 case 35:
 YY_RULE_SETUP
-#line 439 "bs.l"
+#line 435 "bs.l"
 { return K_RETURN; }
 	YY_BREAK
 case 36:
 YY_RULE_SETUP
-#line 440 "bs.l"
+#line 436 "bs.l"
 { return K_STRUCT; }
 	YY_BREAK
 case 37:
 YY_RULE_SETUP
-#line 441 "bs.l"
+#line 437 "bs.l"
 { return K_ENUM;   }
 	YY_BREAK
 case 38:
 YY_RULE_SETUP
-#line 442 "bs.l"
-{ return K_WHILE;  }
+#line 438 "bs.l"
+{ yyextra->mBuilder->MarkKeywordLine(); return K_WHILE; }
 	YY_BREAK
 case 39:
 YY_RULE_SETUP
-#line 443 "bs.l"
-{ return K_FOR;    }
+#line 439 "bs.l"
+{ yyextra->mBuilder->MarkKeywordLine(); return K_FOR; }
 	YY_BREAK
 case 40:
 YY_RULE_SETUP
-#line 444 "bs.l"
-{ BS_TOKEN(O_INC); }
+#line 440 "bs.l"
+{ yyextra->mBuilder->MarkKeywordLine(); return K_YIELD; }
 	YY_BREAK
 case 41:
 YY_RULE_SETUP
-#line 445 "bs.l"
-{ BS_TOKEN(O_DEC); }
+#line 441 "bs.l"
+{ BS_TOKEN(O_INC); }
 	YY_BREAK
 case 42:
 YY_RULE_SETUP
-#line 446 "bs.l"
-{ return K_STATIC_ARRAY; }
+#line 442 "bs.l"
+{ BS_TOKEN(O_DEC); }
 	YY_BREAK
 case 43:
 YY_RULE_SETUP
-#line 447 "bs.l"
-{ return K_SIZE_OF;      }
+#line 443 "bs.l"
+{ return K_STATIC_ARRAY; }
 	YY_BREAK
 case 44:
 YY_RULE_SETUP
-#line 448 "bs.l"
-{ return K_EXTERN;       }
+#line 444 "bs.l"
+{ return K_SIZE_OF;      }
 	YY_BREAK
 case 45:
 YY_RULE_SETUP
-#line 449 "bs.l"
-{ BS_FLOAT(I_FLOAT);     }
+#line 445 "bs.l"
+{ return K_EXTERN;       }
 	YY_BREAK
 case 46:
 YY_RULE_SETUP
-#line 450 "bs.l"
-{ BS_INT(I_INT);         }
+#line 446 "bs.l"
+{ BS_FLOAT(I_FLOAT);     }
 	YY_BREAK
 case 47:
 YY_RULE_SETUP
-#line 451 "bs.l"
-{ BS_TOKEN(K_SEMICOLON); }
+#line 447 "bs.l"
+{ BS_INT(I_INT);         }
 	YY_BREAK
 case 48:
 YY_RULE_SETUP
-#line 452 "bs.l"
+#line 448 "bs.l"
+{ BS_TOKEN(K_SEMICOLON); }
+	YY_BREAK
+case 49:
+YY_RULE_SETUP
+#line 449 "bs.l"
 { 
                     bool isTypeString = false;
-                    int strLen = Pegasus::Utils::Strlen(yytext) + 1;
-                    if (strLen >=  Pegasus::BlockScript::IddStrPool::sCharsPerString){
-                        BS_ErrorDispatcher(yyextra->mBuilder, "Identifier string too long!\n");
-                        yyterminate();
-                    }else{
-                        char * str = yyextra->mBuilder->GetStringPool().AllocateString();
-                        if (str == nullptr) { BS_ErrorDispatcher( yyextra->mBuilder, "Out of identifier memory!"); yyterminate(); }
-                        yylval->identifierText = str;
-                        str[0] = '\0';
-                        Pegasus::Utils::Strcat(str, yytext);
-                        
-                        const Pegasus::BlockScript::Preprocessor::Definition* preprocessorDefinition = yyextra->GetPreprocessor().FindDefinitionByName(str);
-                        if (preprocessorDefinition != nullptr)
-                        {
-                            yyextra->PushDefineStack(YY_CURRENT_BUFFER, preprocessorDefinition);
-                            BS_push_buffer_state(BS__create_buffer(NULL,YY_BUF_SIZE,yyscanner),yyscanner);
-                        }
-                        else
-                        {
-                            isTypeString = yyextra->mBuilder->GetSymbolTable()->GetTypeByName(str) != nullptr;
-                            return isTypeString ? TYPE_IDENTIFIER : IDENTIFIER;
-                        }
+                    const char* str = yyextra->mBuilder->GetStringPool().Intern(yytext);
+                    yylval->identifierText = str;
+                    
+                    const Pegasus::BlockScript::Preprocessor::Definition* preprocessorDefinition = yyextra->GetPreprocessor().FindDefinitionByName(str);
+                    if (preprocessorDefinition != nullptr)
+                    {
+                        yyextra->PushDefineStack(YY_CURRENT_BUFFER, preprocessorDefinition);
+                        BS_push_buffer_state(BS__create_buffer(NULL,YY_BUF_SIZE,yyscanner),yyscanner);
+                    }
+                    else
+                    {
+                        isTypeString = yyextra->mBuilder->GetSymbolTable()->GetTypeByName(str, Pegasus::BlockScript::IddStrPool::GetHash(str)) != nullptr;
+                        return isTypeString ? TYPE_IDENTIFIER : IDENTIFIER;
                     }
                 }
 	YY_BREAK
-case 49:
+case 50:
 YY_RULE_SETUP
-#line 478 "bs.l"
+#line 466 "bs.l"
 { BS_TOKEN(O_PLUS);  }
 	YY_BREAK
-case 50:
+case 51:
 YY_RULE_SETUP
-#line 479 "bs.l"
+#line 467 "bs.l"
 { BS_TOKEN(O_MINUS); }
 	YY_BREAK
-case 51:
+case 52:
 YY_RULE_SETUP
-#line 480 "bs.l"
+#line 468 "bs.l"
 { BS_TOKEN(O_MUL);   }
 	YY_BREAK
-case 52:
+case 53:
 YY_RULE_SETUP
-#line 481 "bs.l"
+#line 469 "bs.l"
 { BS_TOKEN(O_DIV);   }
 	YY_BREAK
-case 53:
+case 54:
 YY_RULE_SETUP
-#line 482 "bs.l"
+#line 470 "bs.l"
 { BS_TOKEN(O_MOD);   }
 	YY_BREAK
-case 54:
+case 55:
 YY_RULE_SETUP
-#line 483 "bs.l"
+#line 471 "bs.l"
 { BS_TOKEN(O_EQ);    }
 	YY_BREAK
-case 55:
+case 56:
 YY_RULE_SETUP
-#line 484 "bs.l"
+#line 472 "bs.l"
 { BS_TOKEN(O_NEQ);    }
 	YY_BREAK
-case 56:
+case 57:
 YY_RULE_SETUP
-#line 485 "bs.l"
+#line 473 "bs.l"
 { BS_TOKEN(O_GT);    }
 	YY_BREAK
-case 57:
+case 58:
 YY_RULE_SETUP
-#line 486 "bs.l"
+#line 474 "bs.l"
 { BS_TOKEN(O_LT);    }
 	YY_BREAK
-case 58:
+case 59:
 YY_RULE_SETUP
-#line 487 "bs.l"
+#line 475 "bs.l"
 { BS_TOKEN(O_GTE);   }
 	YY_BREAK
-case 59:
+case 60:
 YY_RULE_SETUP
-#line 488 "bs.l"
+#line 476 "bs.l"
 { BS_TOKEN(O_LTE);   }
 	YY_BREAK
-case 60:
+case 61:
 YY_RULE_SETUP
-#line 489 "bs.l"
+#line 477 "bs.l"
 { BS_TOKEN(O_LAND); }
 	YY_BREAK
-case 61:
+case 62:
 YY_RULE_SETUP
-#line 490 "bs.l"
+#line 478 "bs.l"
 { BS_TOKEN(O_LOR);  }
 	YY_BREAK
-case 62:
+case 63:
 YY_RULE_SETUP
-#line 491 "bs.l"
+#line 479 "bs.l"
 { BS_TOKEN(O_SET);  }
 	YY_BREAK
-case 63:
+case 64:
 YY_RULE_SETUP
-#line 492 "bs.l"
+#line 480 "bs.l"
 { BS_TOKEN(O_METHOD_CALL); }
 	YY_BREAK
-case 64:
+case 65:
 YY_RULE_SETUP
-#line 493 "bs.l"
+#line 481 "bs.l"
 { BS_TOKEN(O_DOT); }
 	YY_BREAK
-case 65:
+case 66:
 YY_RULE_SETUP
-#line 494 "bs.l"
+#line 482 "bs.l"
 { return K_A_PAREN;  }
 	YY_BREAK
-case 66:
+case 67:
 YY_RULE_SETUP
-#line 495 "bs.l"
+#line 483 "bs.l"
 { return K_L_PAREN; }
 	YY_BREAK
-case 67:
+case 68:
 YY_RULE_SETUP
-#line 496 "bs.l"
+#line 484 "bs.l"
 { return K_R_PAREN; }
 	YY_BREAK
-case 68:
+case 69:
 YY_RULE_SETUP
-#line 497 "bs.l"
+#line 485 "bs.l"
 { return K_L_BRAC;  }
 	YY_BREAK
-case 69:
+case 70:
 YY_RULE_SETUP
-#line 498 "bs.l"
+#line 486 "bs.l"
 { return K_R_BRAC;  }
 	YY_BREAK
-case 70:
+case 71:
 YY_RULE_SETUP
-#line 499 "bs.l"
+#line 487 "bs.l"
 { return K_L_LACE;  }
 	YY_BREAK
-case 71:
+case 72:
 YY_RULE_SETUP
-#line 500 "bs.l"
+#line 488 "bs.l"
 { return K_R_LACE;  }
 	YY_BREAK
-case 72:
+case 73:
 YY_RULE_SETUP
-#line 501 "bs.l"
+#line 489 "bs.l"
 { return K_COMMA;   }
 	YY_BREAK
-case 73:
+case 74:
 YY_RULE_SETUP
-#line 502 "bs.l"
+#line 490 "bs.l"
 { return K_COL;     }
 	YY_BREAK
-case 74:
+case 75:
 YY_RULE_SETUP
-#line 503 "bs.l"
+#line 491 "bs.l"
 ;
 	YY_BREAK
 
@@ -1679,7 +1673,7 @@ case YY_STATE_EOF(STRING_BLOCK):
 case YY_STATE_EOF(PREPROCESSOR):
 case YY_STATE_EOF(PREPROCESSOR_DEFINE_CAPTURE):
 case YY_STATE_EOF(PREPROCESSOR_IGNORE_CODE):
-#line 506 "bs.l"
+#line 494 "bs.l"
 {
                     if (yyextra->GetDefineStackCount() > 0)
                     {
@@ -1697,12 +1691,12 @@ case YY_STATE_EOF(PREPROCESSOR_IGNORE_CODE):
 					}
                 }
 	YY_BREAK
-case 75:
+case 76:
 YY_RULE_SETUP
-#line 522 "bs.l"
+#line 510 "bs.l"
 ECHO;
 	YY_BREAK
-#line 1706 "bs.lexer.cpp"
+#line 1700 "bs.lexer.cpp"
 
 	case YY_END_OF_BUFFER:
 		{
@@ -1994,7 +1988,7 @@ static int yy_get_next_buffer (yyscan_t yyscanner)
 		while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 			{
 			yy_current_state = (int) yy_def[yy_current_state];
-			if ( yy_current_state >= 164 )
+			if ( yy_current_state >= 169 )
 				yy_c = yy_meta[(unsigned int) yy_c];
 			}
 		yy_current_state = yy_nxt[yy_base[yy_current_state] + (unsigned int) yy_c];
@@ -2023,11 +2017,11 @@ static int yy_get_next_buffer (yyscan_t yyscanner)
 	while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 		{
 		yy_current_state = (int) yy_def[yy_current_state];
-		if ( yy_current_state >= 164 )
+		if ( yy_current_state >= 169 )
 			yy_c = yy_meta[(unsigned int) yy_c];
 		}
 	yy_current_state = yy_nxt[yy_base[yy_current_state] + (unsigned int) yy_c];
-	yy_is_jam = (yy_current_state == 163);
+	yy_is_jam = (yy_current_state == 168);
 
 	(void)yyg;
 	return yy_is_jam ? 0 : yy_current_state;
@@ -2864,7 +2858,7 @@ void BS_free (void * ptr , yyscan_t yyscanner)
 
 #define YYTABLES_NAME "yytables"
 
-#line 521 "bs.l"
+#line 509 "bs.l"
 
 
 
@@ -1,21 +1,22 @@
-/* A Bison parser, made by GNU Bison 2.7.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
-   
-      Copyright (C) 1984, 1989-1990, 2000-2012 Free Software Foundation, Inc.
-   
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
    the Free Software Foundation, either version 3 of the License, or
    (at your option) any later version.
-   
+
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
    GNU General Public License for more details.
-   
+
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -26,13 +27,17 @@
    special exception, which will cause the skeleton and the resulting
    Bison output files to be licensed under the GNU General Public
    License without this special exception.
-   
+
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -40,11 +45,11 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "2.7"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
@@ -63,13 +68,10 @@
 #define yyparse         BS_parse
 #define yylex           BS_lex
 #define yyerror         BS_error
-#define yylval          BS_lval
-#define yychar          BS_char
 #define yydebug         BS_debug
 #define yynerrs         BS_nerrs
 
-/* Copy the first part of user declarations.  */
-/* Line 371 of yacc.c  */
+/* First part of user prologue.  */
 #line 16 "bs.y"
 
     /****************************************************************************************/
@@ -137,30 +139,31 @@
     //              Let the insanity begin               //
     //***************************************************//
 
-/* Line 371 of yacc.c  */
-#line 142 "bs.parser.cpp"
+#line 143 "bs.parser.cpp"
 
-# ifndef YY_NULL
-#  if defined __cplusplus && 201103L <= __cplusplus
-#   define YY_NULL nullptr
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
 #  else
-#   define YY_NULL 0
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
 #  endif
 # endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 0
-#endif
 
-/* In a future release of Bison, this section will be replaced
-   by #include "bs.parser.hpp".  */
-#ifndef YY_BS_BS_PARSER_HPP_INCLUDED
-# define YY_BS_BS_PARSER_HPP_INCLUDED
-/* Enabling traces.  */
+/* Debug traces.  */
 #ifndef YYDEBUG
 # define YYDEBUG 0
 #endif
@@ -168,76 +171,80 @@
 extern int BS_debug;
 #endif
 
-/* Tokens.  */
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     I_FLOAT = 258,
-     I_INT = 259,
-     IDENTIFIER = 260,
-     TYPE_IDENTIFIER = 261,
-     I_STRING = 262,
-     K_IF = 263,
-     K_ELSE_IF = 264,
-     K_ELSE = 265,
-     K_SEMICOLON = 266,
-     K_L_PAREN = 267,
-     K_R_PAREN = 268,
-     K_L_BRAC = 269,
-     K_R_BRAC = 270,
-     K_L_LACE = 271,
-     K_R_LACE = 272,
-     K_COMMA = 273,
-     K_COL = 274,
-     K_RETURN = 275,
-     K_WHILE = 276,
-     K_FOR = 277,
-     K_STRUCT = 278,
-     K_ENUM = 279,
-     K_STATIC_ARRAY = 280,
-     K_SIZE_OF = 281,
-     K_EXTERN = 282,
-     K_A_PAREN = 283,
-     O_PLUS = 284,
-     O_MINUS = 285,
-     O_MUL = 286,
-     O_DIV = 287,
-     O_MOD = 288,
-     O_EQ = 289,
-     O_NEQ = 290,
-     O_GT = 291,
-     O_LT = 292,
-     O_GTE = 293,
-     O_LTE = 294,
-     O_LAND = 295,
-     O_LOR = 296,
-     O_SET = 297,
-     O_DOT = 298,
-     O_ACCESS = 299,
-     O_INC = 300,
-     O_DEC = 301,
-     O_METHOD_CALL = 302,
-     O_IMPLICIT_CAST = 303,
-     O_EXPLICIT_CAST = 304,
-     ACCESS_PREC = 305,
-     CAST = 306,
-     NEG = 307
-   };
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    I_FLOAT = 258,                 /* I_FLOAT  */
+    I_INT = 259,                   /* I_INT  */
+    IDENTIFIER = 260,              /* IDENTIFIER  */
+    TYPE_IDENTIFIER = 261,         /* TYPE_IDENTIFIER  */
+    I_STRING = 262,                /* I_STRING  */
+    K_IF = 263,                    /* K_IF  */
+    K_ELSE_IF = 264,               /* K_ELSE_IF  */
+    K_ELSE = 265,                  /* K_ELSE  */
+    K_SEMICOLON = 266,             /* K_SEMICOLON  */
+    K_L_PAREN = 267,               /* K_L_PAREN  */
+    K_R_PAREN = 268,               /* K_R_PAREN  */
+    K_L_BRAC = 269,                /* K_L_BRAC  */
+    K_R_BRAC = 270,                /* K_R_BRAC  */
+    K_L_LACE = 271,                /* K_L_LACE  */
+    K_R_LACE = 272,                /* K_R_LACE  */
+    K_COMMA = 273,                 /* K_COMMA  */
+    K_COL = 274,                   /* K_COL  */
+    K_RETURN = 275,                /* K_RETURN  */
+    K_WHILE = 276,                 /* K_WHILE  */
+    K_FOR = 277,                   /* K_FOR  */
+    K_STRUCT = 278,                /* K_STRUCT  */
+    K_ENUM = 279,                  /* K_ENUM  */
+    K_STATIC_ARRAY = 280,          /* K_STATIC_ARRAY  */
+    K_SIZE_OF = 281,               /* K_SIZE_OF  */
+    K_EXTERN = 282,                /* K_EXTERN  */
+    K_A_PAREN = 283,               /* K_A_PAREN  */
+    O_PLUS = 284,                  /* O_PLUS  */
+    O_MINUS = 285,                 /* O_MINUS  */
+    O_MUL = 286,                   /* O_MUL  */
+    O_DIV = 287,                   /* O_DIV  */
+    O_MOD = 288,                   /* O_MOD  */
+    O_EQ = 289,                    /* O_EQ  */
+    O_NEQ = 290,                   /* O_NEQ  */
+    O_GT = 291,                    /* O_GT  */
+    O_LT = 292,                    /* O_LT  */
+    O_GTE = 293,                   /* O_GTE  */
+    O_LTE = 294,                   /* O_LTE  */
+    O_LAND = 295,                  /* O_LAND  */
+    O_LOR = 296,                   /* O_LOR  */
+    O_SET = 297,                   /* O_SET  */
+    O_DOT = 298,                   /* O_DOT  */
+    O_ACCESS = 299,                /* O_ACCESS  */
+    O_INC = 300,                   /* O_INC  */
+    O_DEC = 301,                   /* O_DEC  */
+    O_METHOD_CALL = 302,           /* O_METHOD_CALL  */
+    O_IMPLICIT_CAST = 303,         /* O_IMPLICIT_CAST  */
+    O_EXPLICIT_CAST = 304,         /* O_EXPLICIT_CAST  */
+    K_YIELD = 305,                 /* K_YIELD  */
+    ACCESS_PREC = 306,             /* ACCESS_PREC  */
+    NEG = 307,                     /* NEG  */
+    CAST = 308                     /* CAST  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
 
-
+/* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE
+union YYSTYPE
 {
-/* Line 387 of yacc.c  */
 #line 86 "bs.y"
 
     int    token;
     int    integerValue;
     float  floatValue;
-    char*  identifierText;
+    const char*  identifierText;
     Pegasus::BlockScript::StackFrameInfo*      vFrameInfo;
     Pegasus::BlockScript::TypeDesc*            vTypeDesc;
     Pegasus::BlockScript::EnumNode*            vEnumNode;
@@ -245,66 +252,197 @@ typedef union YYSTYPE
     #include "Pegasus/BlockScript/Ast.inl"
     #undef BS_PROCESS
 
+#line 256 "bs.parser.cpp"
 
-/* Line 387 of yacc.c  */
-#line 251 "bs.parser.cpp"
-} YYSTYPE;
+};
+typedef union YYSTYPE YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
 # define YYSTYPE_IS_DECLARED 1
 #endif
 
 
-#ifdef YYPARSE_PARAM
-#if defined __STDC__ || defined __cplusplus
-int BS_parse (void *YYPARSE_PARAM);
-#else
-int BS_parse ();
-#endif
-#else /* ! YYPARSE_PARAM */
-#if defined __STDC__ || defined __cplusplus
+
+
 int BS_parse (void* scanner);
-#else
-int BS_parse ();
-#endif
-#endif /* ! YYPARSE_PARAM */
 
-#endif /* !YY_BS_BS_PARSER_HPP_INCLUDED  */
 
-/* Copy the second part of user declarations.  */
 
-/* Line 390 of yacc.c  */
-#line 278 "bs.parser.cpp"
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_I_FLOAT = 3,                    /* I_FLOAT  */
+  YYSYMBOL_I_INT = 4,                      /* I_INT  */
+  YYSYMBOL_IDENTIFIER = 5,                 /* IDENTIFIER  */
+  YYSYMBOL_TYPE_IDENTIFIER = 6,            /* TYPE_IDENTIFIER  */
+  YYSYMBOL_I_STRING = 7,                   /* I_STRING  */
+  YYSYMBOL_K_IF = 8,                       /* K_IF  */
+  YYSYMBOL_K_ELSE_IF = 9,                  /* K_ELSE_IF  */
+  YYSYMBOL_K_ELSE = 10,                    /* K_ELSE  */
+  YYSYMBOL_K_SEMICOLON = 11,               /* K_SEMICOLON  */
+  YYSYMBOL_K_L_PAREN = 12,                 /* K_L_PAREN  */
+  YYSYMBOL_K_R_PAREN = 13,                 /* K_R_PAREN  */
+  YYSYMBOL_K_L_BRAC = 14,                  /* K_L_BRAC  */
+  YYSYMBOL_K_R_BRAC = 15,                  /* K_R_BRAC  */
+  YYSYMBOL_K_L_LACE = 16,                  /* K_L_LACE  */
+  YYSYMBOL_K_R_LACE = 17,                  /* K_R_LACE  */
+  YYSYMBOL_K_COMMA = 18,                   /* K_COMMA  */
+  YYSYMBOL_K_COL = 19,                     /* K_COL  */
+  YYSYMBOL_K_RETURN = 20,                  /* K_RETURN  */
+  YYSYMBOL_K_WHILE = 21,                   /* K_WHILE  */
+  YYSYMBOL_K_FOR = 22,                     /* K_FOR  */
+  YYSYMBOL_K_STRUCT = 23,                  /* K_STRUCT  */
+  YYSYMBOL_K_ENUM = 24,                    /* K_ENUM  */
+  YYSYMBOL_K_STATIC_ARRAY = 25,            /* K_STATIC_ARRAY  */
+  YYSYMBOL_K_SIZE_OF = 26,                 /* K_SIZE_OF  */
+  YYSYMBOL_K_EXTERN = 27,                  /* K_EXTERN  */
+  YYSYMBOL_K_A_PAREN = 28,                 /* K_A_PAREN  */
+  YYSYMBOL_O_PLUS = 29,                    /* O_PLUS  */
+  YYSYMBOL_O_MINUS = 30,                   /* O_MINUS  */
+  YYSYMBOL_O_MUL = 31,                     /* O_MUL  */
+  YYSYMBOL_O_DIV = 32,                     /* O_DIV  */
+  YYSYMBOL_O_MOD = 33,                     /* O_MOD  */
+  YYSYMBOL_O_EQ = 34,                      /* O_EQ  */
+  YYSYMBOL_O_NEQ = 35,                     /* O_NEQ  */
+  YYSYMBOL_O_GT = 36,                      /* O_GT  */
+  YYSYMBOL_O_LT = 37,                      /* O_LT  */
+  YYSYMBOL_O_GTE = 38,                     /* O_GTE  */
+  YYSYMBOL_O_LTE = 39,                     /* O_LTE  */
+  YYSYMBOL_O_LAND = 40,                    /* O_LAND  */
+  YYSYMBOL_O_LOR = 41,                     /* O_LOR  */
+  YYSYMBOL_O_SET = 42,                     /* O_SET  */
+  YYSYMBOL_O_DOT = 43,                     /* O_DOT  */
+  YYSYMBOL_O_ACCESS = 44,                  /* O_ACCESS  */
+  YYSYMBOL_O_INC = 45,                     /* O_INC  */
+  YYSYMBOL_O_DEC = 46,                     /* O_DEC  */
+  YYSYMBOL_O_METHOD_CALL = 47,             /* O_METHOD_CALL  */
+  YYSYMBOL_O_IMPLICIT_CAST = 48,           /* O_IMPLICIT_CAST  */
+  YYSYMBOL_O_EXPLICIT_CAST = 49,           /* O_EXPLICIT_CAST  */
+  YYSYMBOL_K_YIELD = 50,                   /* K_YIELD  */
+  YYSYMBOL_ACCESS_PREC = 51,               /* ACCESS_PREC  */
+  YYSYMBOL_NEG = 52,                       /* NEG  */
+  YYSYMBOL_CAST = 53,                      /* CAST  */
+  YYSYMBOL_YYACCEPT = 54,                  /* $accept  */
+  YYSYMBOL_program = 55,                   /* program  */
+  YYSYMBOL_stmt_list = 56,                 /* stmt_list  */
+  YYSYMBOL_stmt = 57,                      /* stmt  */
+  YYSYMBOL_struct_keyword = 58,            /* struct_keyword  */
+  YYSYMBOL_annotation_list = 59,           /* annotation_list  */
+  YYSYMBOL_annotation_begin = 60,          /* annotation_begin  */
+  YYSYMBOL_if_begin_scope = 61,            /* if_begin_scope  */
+  YYSYMBOL_fun_type = 62,                  /* fun_type  */
+  YYSYMBOL_while_keyword = 63,             /* while_keyword  */
+  YYSYMBOL_for_keyword = 64,               /* for_keyword  */
+  YYSYMBOL_stmt_else_if_tail = 65,         /* stmt_else_if_tail  */
+  YYSYMBOL_else_if_keyword = 66,           /* else_if_keyword  */
+  YYSYMBOL_fun_declaration = 67,           /* fun_declaration  */
+  YYSYMBOL_stmt_else_tail = 68,            /* stmt_else_tail  */
+  YYSYMBOL_else_keyword = 69,              /* else_keyword  */
+  YYSYMBOL_enum_list = 70,                 /* enum_list  */
+  YYSYMBOL_fun_stmt_list = 71,             /* fun_stmt_list  */
+  YYSYMBOL_immediate = 72,                 /* immediate  */
+  YYSYMBOL_exp_list = 73,                  /* exp_list  */
+  YYSYMBOL_ident = 74,                     /* ident  */
+  YYSYMBOL_exp = 75,                       /* exp  */
+  YYSYMBOL_optional_exp = 76,              /* optional_exp  */
+  YYSYMBOL_arg_list = 77,                  /* arg_list  */
+  YYSYMBOL_type_desc = 78,                 /* type_desc  */
+  YYSYMBOL_struct_def_list = 79,           /* struct_def_list  */
+  YYSYMBOL_arg_dec = 80                    /* arg_dec  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
+
+
+
 
 #ifdef short
 # undef short
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
-#else
-typedef unsigned char yytype_uint8;
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
 #endif
 
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
-#elif (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
 typedef signed char yytype_int8;
+#endif
+
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
 #else
-typedef short int yytype_int8;
+typedef short yytype_int16;
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
 #else
-typedef unsigned short int yytype_uint16;
+typedef short yytype_uint8;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
 #else
-typedef short int yytype_int16;
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -312,16 +450,28 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_uint8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
 # if defined YYENABLE_NLS && YYENABLE_NLS
@@ -335,32 +485,71 @@ typedef short int yytype_int16;
 # endif
 #endif
 
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
+# endif
+#endif
+
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-/* Identity function, used to suppress warnings about constant conditions.  */
-#ifndef lint
-# define YYID(N) (N)
-#else
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static int
-YYID (int yyi)
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
 #else
-static int
-YYID (yyi)
-    int yyi;
+# define YY_INITIAL_VALUE(Value) Value
 #endif
-{
-  return yyi;
-}
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
 #endif
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if !defined yyoverflow
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -377,8 +566,7 @@ YYID (yyi)
 #    define alloca _alloca
 #   else
 #    define YYSTACK_ALLOC alloca
-#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
 #     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
       /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
 #     ifndef EXIT_SUCCESS
@@ -390,8 +578,8 @@ YYID (yyi)
 # endif
 
 # ifdef YYSTACK_ALLOC
-   /* Pacify GCC's `empty if-body' warning.  */
-#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (YYID (0))
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
 #  ifndef YYSTACK_ALLOC_MAXIMUM
     /* The OS might guarantee only one guard page at the bottom of the stack,
        and a page size can be as small as 4096 bytes.  So we cannot safely
@@ -407,7 +595,7 @@ YYID (yyi)
 #  endif
 #  if (defined __cplusplus && ! defined EXIT_SUCCESS \
        && ! ((defined YYMALLOC || defined malloc) \
-	     && (defined YYFREE || defined free)))
+             && (defined YYFREE || defined free)))
 #   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
 #   ifndef EXIT_SUCCESS
 #    define EXIT_SUCCESS 0
@@ -415,40 +603,37 @@ YYID (yyi)
 #  endif
 #  ifndef YYMALLOC
 #   define YYMALLOC malloc
-#   if ! defined malloc && ! defined EXIT_SUCCESS && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined malloc && ! defined EXIT_SUCCESS
 void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 #  ifndef YYFREE
 #   define YYFREE free
-#   if ! defined free && ! defined EXIT_SUCCESS && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined free && ! defined EXIT_SUCCESS
 void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* !defined yyoverflow */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
-	 || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+         || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
 
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss_alloc;
+  yy_state_t yyss_alloc;
   YYSTYPE yyvs_alloc;
 };
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
       + YYSTACK_GAP_MAXIMUM)
 
 # define YYCOPY_NEEDED 1
@@ -458,16 +643,16 @@ union yyalloc
    elements in the stack, and YYPTR gives the new location of the
    stack.  Advance YYPTR to a properly aligned location for the next
    stack.  */
-# define YYSTACK_RELOCATE(Stack_alloc, Stack)				\
-    do									\
-      {									\
-	YYSIZE_T yynewbytes;						\
-	YYCOPY (&yyptr->Stack_alloc, Stack, yysize);			\
-	Stack = &yyptr->Stack_alloc;					\
-	yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-	yyptr += yynewbytes / sizeof (*yyptr);				\
-      }									\
-    while (YYID (0))
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
 
 #endif
 
@@ -477,43 +662,48 @@ union yyalloc
 # ifndef YYCOPY
 #  if defined __GNUC__ && 1 < __GNUC__
 #   define YYCOPY(Dst, Src, Count) \
-      __builtin_memcpy (Dst, Src, (Count) * sizeof (*(Src)))
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
 #  else
 #   define YYCOPY(Dst, Src, Count)              \
       do                                        \
         {                                       \
-          YYSIZE_T yyi;                         \
+          YYPTRDIFF_T yyi;                      \
           for (yyi = 0; yyi < (Count); yyi++)   \
             (Dst)[yyi] = (Src)[yyi];            \
         }                                       \
-      while (YYID (0))
+      while (0)
 #  endif
 # endif
 #endif /* !YYCOPY_NEEDED */
 
 /* YYFINAL -- State number of the termination state.  */
-#define YYFINAL  49
+#define YYFINAL  51
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   835
+#define YYLAST   902
 
 /* YYNTOKENS -- Number of terminals.  */
-#define YYNTOKENS  53
+#define YYNTOKENS  54
 /* YYNNTS -- Number of nonterminals.  */
 #define YYNNTS  27
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  84
-/* YYNRULES -- Number of states.  */
-#define YYNSTATES  201
+#define YYNRULES  85
+/* YYNSTATES -- Number of states.  */
+#define YYNSTATES  203
+
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   308
 
-/* YYTRANSLATE(YYLEX) -- Bison symbol number corresponding to YYLEX.  */
-#define YYUNDEFTOK  2
-#define YYMAXUTOK   307
 
-#define YYTRANSLATE(YYX)						\
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
 
-/* YYTRANSLATE[YYLEX] -- Bison symbol number corresponding to YYLEX.  */
-static const yytype_uint8 yytranslate[] =
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -545,362 +735,291 @@ static const yytype_uint8 yytranslate[] =
       15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
       25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
       35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
-      45,    46,    47,    48,    49,    50,    51,    52
+      45,    46,    47,    48,    49,    50,    51,    52,    53
 };
 
 #if YYDEBUG
-/* YYPRHS[YYN] -- Index of the first RHS symbol of rule number YYN in
-   YYRHS.  */
-static const yytype_uint16 yyprhs[] =
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
 {
-       0,     0,     3,     5,     8,    10,    11,    14,    20,    24,
-      31,    35,    38,    46,    58,    65,    72,    81,    83,    87,
-      89,    92,    94,    96,    98,   106,   113,   114,   116,   122,
-     127,   128,   130,   134,   136,   140,   142,   144,   146,   151,
-     155,   157,   158,   160,   162,   167,   172,   177,   179,   181,
-     184,   187,   194,   201,   205,   209,   213,   217,   221,   225,
-     229,   233,   237,   241,   245,   249,   253,   257,   261,   266,
-     269,   274,   278,   281,   284,   285,   287,   291,   293,   294,
-     299,   301,   305,   308,   309
+       0,   190,   190,   193,   202,   203,   206,   207,   208,   209,
+     224,   225,   226,   227,   231,   235,   236,   253,   274,   277,
+     280,   284,   287,   290,   293,   296,   310,   314,   317,   322,
+     325,   326,   329,   332,   341,   348,   349,   352,   353,   354,
+     361,   370,   371,   374,   377,   378,   379,   380,   381,   382,
+     383,   384,   385,   386,   387,   388,   389,   390,   391,   392,
+     393,   394,   395,   396,   397,   398,   399,   400,   401,   402,
+     403,   404,   405,   406,   407,   410,   411,   414,   423,   424,
+     427,   466,   481,   490,   491,   494
 };
+#endif
 
-/* YYRHS -- A `-1'-separated list of the rules' RHS.  */
-static const yytype_int8 yyrhs[] =
-{
-      54,     0,    -1,    55,    -1,    55,    56,    -1,    56,    -1,
-      -1,    74,    11,    -1,    27,    73,    42,    74,    11,    -1,
-      58,    74,    11,    -1,    58,    27,    73,    42,    74,    11,
-      -1,    20,    74,    11,    -1,    66,    70,    -1,    62,    12,
-      74,    13,    14,    55,    15,    -1,    63,    12,    75,    11,
-      75,    11,    75,    13,    14,    55,    15,    -1,    57,     5,
-      14,    78,    15,    11,    -1,    24,     5,    14,    69,    15,
-      11,    -1,     8,    12,    74,    60,    55,    15,    64,    67,
-      -1,    23,    -1,    59,    72,    13,    -1,    28,    -1,    13,
-      14,    -1,    77,    -1,    21,    -1,    22,    -1,    64,    65,
-      12,    74,    60,    55,    15,    -1,    65,    12,    74,    60,
-      55,    15,    -1,    -1,     9,    -1,    61,     5,    12,    76,
-      13,    -1,    68,    14,    55,    15,    -1,    -1,    10,    -1,
-      69,    18,     5,    -1,     5,    -1,    14,    55,    15,    -1,
-      11,    -1,     4,    -1,     3,    -1,    26,    12,    77,    13,
-      -1,    72,    18,    74,    -1,    74,    -1,    -1,     5,    -1,
-      73,    -1,     5,    12,    72,    13,    -1,     6,    12,    72,
-      13,    -1,    25,    37,    77,    36,    -1,     7,    -1,    71,
-      -1,    45,    74,    -1,    46,    74,    -1,    74,    47,     5,
-      12,    72,    13,    -1,    74,    47,     6,    12,    72,    13,
-      -1,    74,    42,    74,    -1,    74,    29,    74,    -1,    74,
-      30,    74,    -1,    74,    31,    74,    -1,    74,    32,    74,
-      -1,    74,    33,    74,    -1,    74,    34,    74,    -1,    74,
-      35,    74,    -1,    74,    40,    74,    -1,    74,    41,    74,
-      -1,    74,    37,    74,    -1,    74,    36,    74,    -1,    74,
-      39,    74,    -1,    74,    38,    74,    -1,    74,    43,    73,
-      -1,    74,    16,    74,    17,    -1,    30,    74,    -1,    12,
-      77,    13,    74,    -1,    12,    74,    13,    -1,    74,    45,
-      -1,    74,    46,    -1,    -1,    74,    -1,    76,    18,    79,
-      -1,    79,    -1,    -1,    77,    16,     4,    17,    -1,     6,
-      -1,    78,    79,    11,    -1,    79,    11,    -1,    -1,     5,
-      19,    77,    -1
-};
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
 
-/* YYRLINE[YYN] -- source line where rule number YYN was defined.  */
-static const yytype_uint16 yyrline[] =
-{
-       0,   189,   189,   192,   201,   202,   205,   206,   207,   208,
-     223,   224,   225,   229,   233,   234,   251,   272,   275,   278,
-     282,   285,   288,   291,   294,   308,   312,   315,   320,   323,
-     324,   327,   330,   339,   346,   347,   350,   351,   352,   359,
-     368,   369,   372,   375,   376,   377,   378,   379,   380,   381,
-     382,   383,   384,   385,   386,   387,   388,   389,   390,   391,
-     392,   393,   394,   395,   396,   397,   398,   399,   400,   401,
-     402,   403,   404,   405,   408,   409,   412,   421,   422,   425,
-     464,   479,   488,   489,   492
-};
-#endif
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
 
-#if YYDEBUG || YYERROR_VERBOSE || 0
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "I_FLOAT", "I_INT", "IDENTIFIER",
-  "TYPE_IDENTIFIER", "I_STRING", "K_IF", "K_ELSE_IF", "K_ELSE",
-  "K_SEMICOLON", "K_L_PAREN", "K_R_PAREN", "K_L_BRAC", "K_R_BRAC",
-  "K_L_LACE", "K_R_LACE", "K_COMMA", "K_COL", "K_RETURN", "K_WHILE",
-  "K_FOR", "K_STRUCT", "K_ENUM", "K_STATIC_ARRAY", "K_SIZE_OF", "K_EXTERN",
-  "K_A_PAREN", "O_PLUS", "O_MINUS", "O_MUL", "O_DIV", "O_MOD", "O_EQ",
-  "O_NEQ", "O_GT", "O_LT", "O_GTE", "O_LTE", "O_LAND", "O_LOR", "O_SET",
-  "O_DOT", "O_ACCESS", "O_INC", "O_DEC", "O_METHOD_CALL",
-  "O_IMPLICIT_CAST", "O_EXPLICIT_CAST", "ACCESS_PREC", "CAST", "NEG",
-  "$accept", "program", "stmt_list", "stmt", "struct_keyword",
+  "\"end of file\"", "error", "\"invalid token\"", "I_FLOAT", "I_INT",
+  "IDENTIFIER", "TYPE_IDENTIFIER", "I_STRING", "K_IF", "K_ELSE_IF",
+  "K_ELSE", "K_SEMICOLON", "K_L_PAREN", "K_R_PAREN", "K_L_BRAC",
+  "K_R_BRAC", "K_L_LACE", "K_R_LACE", "K_COMMA", "K_COL", "K_RETURN",
+  "K_WHILE", "K_FOR", "K_STRUCT", "K_ENUM", "K_STATIC_ARRAY", "K_SIZE_OF",
+  "K_EXTERN", "K_A_PAREN", "O_PLUS", "O_MINUS", "O_MUL", "O_DIV", "O_MOD",
+  "O_EQ", "O_NEQ", "O_GT", "O_LT", "O_GTE", "O_LTE", "O_LAND", "O_LOR",
+  "O_SET", "O_DOT", "O_ACCESS", "O_INC", "O_DEC", "O_METHOD_CALL",
+  "O_IMPLICIT_CAST", "O_EXPLICIT_CAST", "K_YIELD", "ACCESS_PREC", "NEG",
+  "CAST", "$accept", "program", "stmt_list", "stmt", "struct_keyword",
   "annotation_list", "annotation_begin", "if_begin_scope", "fun_type",
   "while_keyword", "for_keyword", "stmt_else_if_tail", "else_if_keyword",
   "fun_declaration", "stmt_else_tail", "else_keyword", "enum_list",
   "fun_stmt_list", "immediate", "exp_list", "ident", "exp", "optional_exp",
-  "arg_list", "type_desc", "struct_def_list", "arg_dec", YY_NULL
+  "arg_list", "type_desc", "struct_def_list", "arg_dec", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[YYLEX-NUM] -- Internal token number corresponding to
-   token YYLEX-NUM.  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
-     285,   286,   287,   288,   289,   290,   291,   292,   293,   294,
-     295,   296,   297,   298,   299,   300,   301,   302,   303,   304,
-     305,   306,   307
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-/* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
-{
-       0,    53,    54,    55,    55,    55,    56,    56,    56,    56,
-      56,    56,    56,    56,    56,    56,    56,    57,    58,    59,
-      60,    61,    62,    63,    64,    64,    64,    65,    66,    67,
-      67,    68,    69,    69,    70,    70,    71,    71,    71,    72,
-      72,    72,    73,    74,    74,    74,    74,    74,    74,    74,
-      74,    74,    74,    74,    74,    74,    74,    74,    74,    74,
-      74,    74,    74,    74,    74,    74,    74,    74,    74,    74,
-      74,    74,    74,    74,    75,    75,    76,    76,    76,    77,
-      77,    78,    78,    78,    79
-};
+#define YYPACT_NINF (-150)
 
-/* YYR2[YYN] -- Number of symbols composing right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
-{
-       0,     2,     1,     2,     1,     0,     2,     5,     3,     6,
-       3,     2,     7,    11,     6,     6,     8,     1,     3,     1,
-       2,     1,     1,     1,     7,     6,     0,     1,     5,     4,
-       0,     1,     3,     1,     3,     1,     1,     1,     4,     3,
-       1,     0,     1,     1,     4,     4,     4,     1,     1,     2,
-       2,     6,     6,     3,     3,     3,     3,     3,     3,     3,
-       3,     3,     3,     3,     3,     3,     3,     3,     4,     2,
-       4,     3,     2,     2,     0,     1,     3,     1,     0,     4,
-       1,     3,     2,     0,     3
-};
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
 
-/* YYDEFACT[STATE-NAME] -- Default reduction number in state STATE-NUM.
-   Performed when YYTABLE doesn't specify something else to do.  Zero
-   means the default is an error.  */
-static const yytype_uint8 yydefact[] =
-{
-       5,    37,    36,    42,    80,    47,     0,     0,     0,    22,
-      23,    17,     0,     0,     0,     0,    19,     0,     0,     0,
-       0,     2,     4,     0,     0,    41,     0,     0,     0,     0,
-      48,    43,     0,    21,    41,    41,     0,     0,     0,     0,
-       0,     0,     0,     0,    42,     0,    69,    49,    50,     1,
-       3,     0,     0,     0,     0,    40,     0,     0,    74,    35,
-       5,    11,     6,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,    72,
-      73,     0,     0,     0,     0,     0,    71,     0,    10,     0,
-      80,     0,     0,     0,    83,     0,     8,    18,     0,    78,
-       0,    75,     0,     0,     0,    54,    55,    56,    57,    58,
-      59,    60,    64,    63,    66,    65,    61,    62,    53,    67,
-       0,     0,     0,    44,    45,     0,     5,    70,    33,     0,
-      46,    38,     0,     0,     0,     0,     0,    39,     0,    77,
-       0,    74,    34,    68,    41,    41,    79,    20,     0,     0,
-       0,     7,     0,     0,     0,    82,     0,    28,     0,     5,
-       0,     0,     0,    26,    15,    32,    84,    14,    81,     9,
-      76,     0,    74,    51,    52,    27,    30,     0,    12,     0,
-      31,     0,    16,     0,     0,     0,     0,     5,     0,     5,
-       0,     0,     5,     0,     5,    29,     0,    13,     0,    25,
-      24
-};
+#define YYTABLE_NINF (-1)
 
-/* YYDEFGOTO[NTERM-NUM].  */
-static const yytype_int16 yydefgoto[] =
-{
-      -1,    20,    21,    22,    23,    24,    25,   126,    26,    27,
-      28,   176,   177,    29,   182,   183,   129,    61,    30,    54,
-      31,    32,   102,   138,    33,   134,   135
-};
+#define yytable_value_is_error(Yyn) \
+  0
 
 /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
    STATE-NUM.  */
-#define YYPACT_NINF -150
 static const yytype_int16 yypact[] =
 {
-     374,  -150,  -150,    -4,     3,  -150,    18,   106,   402,  -150,
-    -150,  -150,    19,    38,    43,    72,  -150,   402,   402,   402,
-      81,   374,  -150,    83,    94,   402,    91,    92,    95,    12,
-    -150,  -150,   420,    87,   402,   402,   402,   587,    77,     3,
-     453,   100,   102,   102,  -150,    84,     5,     5,     5,  -150,
-    -150,   109,    72,   486,    34,   717,   115,   402,   402,  -150,
-     374,  -150,  -150,   402,   402,   402,   402,   402,   402,   402,
-     402,   402,   402,   402,   402,   402,   402,   402,    72,  -150,
-    -150,    48,   124,    58,    61,   622,  -150,   402,  -150,   128,
-    -150,     9,    89,   402,   130,   104,  -150,  -150,   402,   130,
-     657,   717,   131,   178,   689,   -12,   -12,   564,    -3,   394,
-     769,   769,   788,   788,   788,   788,   125,   125,   745,  -150,
-     132,   137,   149,  -150,  -150,   155,   374,     5,  -150,   107,
-    -150,  -150,   519,   157,    17,   163,   402,   717,    65,  -150,
-     173,   402,  -150,  -150,   402,   402,  -150,  -150,   206,   177,
-     184,  -150,   102,   180,   181,  -150,   552,  -150,   130,   374,
-     183,    71,    74,   186,  -150,  -150,    87,  -150,  -150,  -150,
-    -150,   234,   402,  -150,  -150,  -150,    85,   185,  -150,   194,
-    -150,   203,  -150,   182,   402,   202,   402,   374,   622,   374,
-     622,   262,   374,   290,   374,  -150,   318,  -150,   346,  -150,
-    -150
+     370,  -150,  -150,     5,    14,  -150,    45,   426,   443,  -150,
+    -150,  -150,    93,    62,    88,    96,  -150,   443,   443,   443,
+      97,   109,   370,  -150,   105,   398,   443,   107,   106,   120,
+      21,  -150,  -150,   463,   101,   443,   443,   443,   630,    74,
+      14,   496,   119,   128,   128,  -150,    95,   -10,   -10,   -10,
+    -150,  -150,  -150,   121,    96,   529,    -5,   760,   126,   443,
+     443,  -150,   370,  -150,  -150,   443,   443,   443,   443,   443,
+     443,   443,   443,   443,   443,   443,   443,   443,   443,   443,
+      96,  -150,  -150,    72,   138,    36,    37,   665,  -150,   443,
+    -150,   142,  -150,    11,    76,   443,   146,   110,  -150,  -150,
+     443,   146,   700,   760,   143,    99,   732,   845,   845,    -1,
+     112,   855,   836,   836,    -9,    -9,    -9,    -9,   788,   788,
+     812,  -150,   144,   148,   145,  -150,  -150,   147,   370,   -10,
+    -150,    79,  -150,  -150,   562,   149,    68,   152,   443,   760,
+      63,  -150,   150,   443,  -150,  -150,   443,   443,  -150,  -150,
+     179,   154,   161,  -150,   128,   158,   159,  -150,   595,  -150,
+     146,   370,   160,    66,    73,   163,  -150,  -150,   101,  -150,
+    -150,  -150,  -150,   211,   443,  -150,  -150,  -150,    86,   162,
+    -150,   164,  -150,   176,  -150,   175,   443,   178,   443,   370,
+     665,   370,   665,   243,   370,   275,   370,  -150,   307,  -150,
+     339,  -150,  -150
+};
+
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int8 yydefact[] =
+{
+       5,    38,    37,    43,    81,    48,     0,     0,     0,    23,
+      24,    18,     0,     0,     0,     0,    20,     0,     0,     0,
+       0,     0,     2,     4,     0,     0,    42,     0,     0,     0,
+       0,    49,    44,     0,    22,    42,    42,     0,     0,     0,
+       0,     0,     0,     0,     0,    43,     0,    70,    50,    51,
+      11,     1,     3,     0,     0,     0,     0,    41,     0,     0,
+      75,    36,     5,    12,     6,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,    73,    74,     0,     0,     0,     0,     0,    72,     0,
+      10,     0,    81,     0,     0,     0,    84,     0,     8,    19,
+       0,    79,     0,    76,     0,     0,     0,    55,    56,    57,
+      58,    59,    60,    61,    65,    64,    67,    66,    62,    63,
+      54,    68,     0,     0,     0,    45,    46,     0,     5,    71,
+      34,     0,    47,    39,     0,     0,     0,     0,     0,    40,
+       0,    78,     0,    75,    35,    69,    42,    42,    80,    21,
+       0,     0,     0,     7,     0,     0,     0,    83,     0,    29,
+       0,     5,     0,     0,     0,    27,    16,    33,    85,    15,
+      82,     9,    77,     0,    75,    52,    53,    28,    31,     0,
+      13,     0,    32,     0,    17,     0,     0,     0,     0,     5,
+       0,     5,     0,     0,     5,     0,     5,    30,     0,    14,
+       0,    26,    25
 };
 
 /* YYPGOTO[NTERM-NUM].  */
 static const yytype_int16 yypgoto[] =
 {
-    -150,  -150,   -44,   -18,  -150,  -150,  -150,  -149,  -150,  -150,
-    -150,  -150,    41,  -150,  -150,  -150,  -150,  -150,  -150,   -28,
-      -6,    -7,  -136,  -150,    -5,  -150,   -85
+    -150,  -150,   -48,   -20,  -150,  -150,  -150,  -149,  -150,  -150,
+    -150,  -150,    -2,  -150,  -150,  -150,  -150,  -150,  -150,   -31,
+      -6,    -7,  -118,  -150,    -4,  -150,   -85
+};
+
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_uint8 yydefgoto[] =
+{
+       0,    21,    22,    23,    24,    25,    26,   128,    27,    28,
+      29,   178,   179,    30,   184,   185,   131,    63,    31,    56,
+      32,    33,   104,   140,    34,   136,   137
 };
 
-/* YYTABLE[YYPACT[STATE-NUM]].  What to do in state STATE-NUM.  If
-   positive, shift that token.  If negative, reduce the rule which
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
    number is the opposite.  If YYTABLE_NINF, syntax error.  */
-#define YYTABLE_NINF -1
 static const yytype_uint8 yytable[] =
 {
-      37,    40,    38,    50,    63,   160,    83,    84,    34,    45,
-      46,    47,    48,    63,   139,    35,   103,    53,    55,    66,
-      67,    63,   133,    59,    41,    82,    60,    55,    55,    85,
-      36,    78,   153,    79,    80,    81,   179,    91,    92,   192,
-      78,   194,    79,    80,    81,   130,    95,    97,    78,   154,
-     100,   101,    98,   120,   121,    43,   104,   105,   106,   107,
+      38,    41,    52,    39,    85,    86,    65,    65,    99,    46,
+      47,    48,    49,   100,   105,    65,   141,    35,    55,    57,
+      66,    67,    68,    69,    70,   162,    36,    84,    57,    57,
+      87,    69,    61,    80,    80,    62,    81,    82,    83,    93,
+      94,   194,    80,   196,    81,    82,    83,   132,    97,   125,
+     126,   156,   102,   103,   100,   100,   181,    37,   106,   107,
      108,   109,   110,   111,   112,   113,   114,   115,   116,   117,
-     118,   123,   119,   170,   124,    42,    98,    44,   157,    98,
-     127,    49,   148,   158,   173,    50,   132,   174,    51,    98,
-      87,   137,    98,    82,   175,   180,    56,     1,     2,     3,
-      39,     5,   131,    82,    57,    82,     7,    58,    90,     1,
-       2,     3,     4,     5,    89,   171,   161,   162,     7,    13,
-      14,    52,   149,    94,    17,   150,    93,    99,   122,   156,
-      50,    13,    14,   128,   101,   133,    17,    55,    55,    18,
-      19,    63,   141,   191,   144,   193,   136,   166,   196,   145,
-     198,    18,    19,    50,    64,    65,    66,    67,    68,    69,
-      70,    71,    72,    73,    74,   101,   146,    77,    78,   147,
-      79,    80,    81,    50,   155,    50,   152,   188,    50,   190,
-      50,     1,     2,     3,     4,     5,     6,   159,   164,   165,
-       7,   167,   168,   142,   172,   175,   187,   184,     8,     9,
-      10,    11,    12,    13,    14,    15,    16,   185,    17,     1,
-       2,     3,     4,     5,     6,   186,   189,   181,     7,     0,
-       0,   163,     0,    18,    19,     0,     8,     9,    10,    11,
-      12,    13,    14,    15,    16,     0,    17,     1,     2,     3,
-       4,     5,     6,     0,     0,     0,     7,     0,     0,   178,
-       0,    18,    19,     0,     8,     9,    10,    11,    12,    13,
-      14,    15,    16,     0,    17,     1,     2,     3,     4,     5,
-       6,     0,     0,     0,     7,     0,     0,   195,     0,    18,
-      19,     0,     8,     9,    10,    11,    12,    13,    14,    15,
-      16,     0,    17,     1,     2,     3,     4,     5,     6,     0,
-       0,     0,     7,     0,     0,   197,     0,    18,    19,     0,
+     118,   119,   120,   135,   121,   172,   159,   122,   123,   175,
+     150,   160,   129,   155,   100,    52,   176,    89,   134,   133,
+      84,   100,    84,   139,   151,   177,   182,   152,    42,    43,
+      44,    45,     1,     2,     3,     4,     5,     6,    50,    51,
+      53,     7,    58,   173,   144,   163,   164,    84,    59,     8,
+       9,    10,    11,    12,    13,    14,    15,    16,    65,    17,
+      52,   158,    60,    91,    92,    96,   103,    95,   101,    57,
+      57,   193,   124,   195,    18,    19,   198,   130,   200,    20,
+     168,   135,   138,    52,   143,    80,   146,    81,    82,    83,
+     147,   149,   148,   157,   161,   166,   167,   103,   154,   169,
+     170,   174,   177,    52,   186,    52,   183,   187,    52,   190,
+      52,   192,     1,     2,     3,     4,     5,     6,   188,   189,
+       0,     7,   191,     0,   165,     0,     0,     0,     0,     8,
+       9,    10,    11,    12,    13,    14,    15,    16,     0,    17,
+       0,     0,     0,     0,     1,     2,     3,     4,     5,     6,
+       0,     0,     0,     7,    18,    19,   180,     0,     0,    20,
+       0,     8,     9,    10,    11,    12,    13,    14,    15,    16,
+       0,    17,     0,     0,     0,     0,     1,     2,     3,     4,
+       5,     6,     0,     0,     0,     7,    18,    19,   197,     0,
+       0,    20,     0,     8,     9,    10,    11,    12,    13,    14,
+      15,    16,     0,    17,     0,     0,     0,     0,     1,     2,
+       3,     4,     5,     6,     0,     0,     0,     7,    18,    19,
+     199,     0,     0,    20,     0,     8,     9,    10,    11,    12,
+      13,    14,    15,    16,     0,    17,     0,     0,     0,     0,
+       1,     2,     3,     4,     5,     6,     0,     0,     0,     7,
+      18,    19,   201,     0,     0,    20,     0,     8,     9,    10,
+      11,    12,    13,    14,    15,    16,     0,    17,     0,     0,
+       0,     0,     1,     2,     3,     4,     5,     6,     0,     0,
+       0,     7,    18,    19,   202,     0,     0,    20,     0,     8,
+       9,    10,    11,    12,    13,    14,    15,    16,     0,    17,
+       0,     0,     0,     1,     2,     3,     4,     5,     6,     0,
+       0,     0,     7,     0,    18,    19,     0,     0,     0,    20,
        8,     9,    10,    11,    12,    13,    14,    15,    16,     0,
-      17,     1,     2,     3,     4,     5,     6,     0,     0,     0,
-       7,     0,     0,   199,     0,    18,    19,     0,     8,     9,
-      10,    11,    12,    13,    14,    15,    16,     0,    17,     1,
-       2,     3,     4,     5,     6,     0,     0,     0,     7,     0,
-       0,   200,     0,    18,    19,     0,     8,     9,    10,    11,
-      12,    13,    14,    15,    16,     0,    17,     1,     2,     3,
-       4,     5,     6,     0,     0,     0,     7,     0,     0,     0,
-       0,    18,    19,     0,     8,     9,    10,    11,    12,    13,
-      14,    15,    16,     0,    17,     1,     2,     3,    39,     5,
-      63,     0,     0,     0,     7,     0,     0,     0,     0,    18,
-      19,     0,     0,    64,    65,    66,    67,    13,    14,     0,
-       0,    62,    17,     0,     0,     0,    63,    78,     0,    79,
-      80,    81,     0,     0,     0,     0,     0,    18,    19,    64,
-      65,    66,    67,    68,    69,    70,    71,    72,    73,    74,
-      75,    76,    77,    78,    88,    79,    80,    81,     0,    63,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,    64,    65,    66,    67,    68,    69,    70,    71,
-      72,    73,    74,    75,    76,    77,    78,    96,    79,    80,
-      81,     0,    63,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,    64,    65,    66,    67,    68,
-      69,    70,    71,    72,    73,    74,    75,    76,    77,    78,
-     151,    79,    80,    81,     0,    63,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,    64,    65,
-      66,    67,    68,    69,    70,    71,    72,    73,    74,    75,
-      76,    77,    78,   169,    79,    80,    81,     0,    63,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-      63,    64,    65,    66,    67,    68,    69,    70,    71,    72,
-      73,    74,    75,    76,    77,    78,    67,    79,    80,    81,
-      86,     0,     0,    63,     0,     0,     0,    78,     0,    79,
-      80,    81,     0,     0,     0,     0,    64,    65,    66,    67,
+      17,     1,     2,     3,    40,     5,     0,     0,     0,     0,
+       7,     0,     0,     0,     0,    18,    19,     0,     0,     0,
+      20,     0,     0,    13,    14,    54,     0,     0,    17,     1,
+       2,     3,     4,     5,     0,     0,     0,     0,     7,     0,
+       0,     0,     0,    18,    19,     0,     1,     2,     3,    40,
+       5,    13,    14,     0,     0,     7,    17,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,    13,    14,
+       0,    18,    19,    17,    64,     0,     0,     0,     0,    65,
+       0,     0,     0,     0,     0,     0,     0,     0,    18,    19,
+       0,     0,    66,    67,    68,    69,    70,    71,    72,    73,
+      74,    75,    76,    77,    78,    79,    80,    90,    81,    82,
+      83,     0,    65,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,    66,    67,    68,    69,    70,
+      71,    72,    73,    74,    75,    76,    77,    78,    79,    80,
+      98,    81,    82,    83,     0,    65,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,    66,    67,
       68,    69,    70,    71,    72,    73,    74,    75,    76,    77,
-      78,     0,    79,    80,    81,   125,     0,     0,    63,     0,
+      78,    79,    80,   153,    81,    82,    83,     0,    65,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,    64,    65,    66,    67,    68,    69,    70,    71,    72,
-      73,    74,    75,    76,    77,    78,     0,    79,    80,    81,
-     140,     0,     0,    63,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,    64,    65,    66,    67,
-      68,    69,    70,    71,    72,    73,    74,    75,    76,    77,
-      78,     0,    79,    80,    81,    63,   143,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,    64,    65,
-      66,    67,    68,    69,    70,    71,    72,    73,    74,    75,
-      76,    77,    78,    63,    79,    80,    81,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,    64,    65,    66,    67,
-      68,    69,    70,    71,    72,    73,    74,    75,    76,    77,
-      78,    63,    79,    80,    81,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,    64,    65,    66,    67,    68,    69,
-      70,    71,    72,    73,    74,    63,     0,     0,    78,     0,
-      79,    80,    81,     0,     0,     0,     0,     0,    64,    65,
-      66,    67,    68,     0,    63,    71,    72,    73,    74,     0,
-       0,     0,    78,     0,    79,    80,    81,    64,    65,    66,
-      67,    68,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,    78,     0,    79,    80,    81
+       0,    66,    67,    68,    69,    70,    71,    72,    73,    74,
+      75,    76,    77,    78,    79,    80,   171,    81,    82,    83,
+       0,    65,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,    66,    67,    68,    69,    70,    71,
+      72,    73,    74,    75,    76,    77,    78,    79,    80,     0,
+      81,    82,    83,    88,     0,     0,    65,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,    66,
+      67,    68,    69,    70,    71,    72,    73,    74,    75,    76,
+      77,    78,    79,    80,     0,    81,    82,    83,   127,     0,
+       0,    65,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,    66,    67,    68,    69,    70,    71,
+      72,    73,    74,    75,    76,    77,    78,    79,    80,     0,
+      81,    82,    83,   142,     0,     0,    65,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,    66,
+      67,    68,    69,    70,    71,    72,    73,    74,    75,    76,
+      77,    78,    79,    80,     0,    81,    82,    83,    65,   145,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,    66,    67,    68,    69,    70,    71,    72,    73,    74,
+      75,    76,    77,    78,    79,    80,    65,    81,    82,    83,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,    66,
+      67,    68,    69,    70,    71,    72,    73,    74,    75,    76,
+      77,    78,    79,    80,    65,    81,    82,    83,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,    66,    67,    68,
+      69,    70,    71,    72,    73,    74,    75,    76,    65,     0,
+      79,    80,     0,    81,    82,    83,     0,     0,     0,     0,
+       0,    66,    67,    68,    69,    70,    71,    72,    73,    74,
+      75,    76,    65,     0,     0,    80,     0,    81,    82,    83,
+       0,    65,     0,     0,     0,    66,    67,    68,    69,    70,
+       0,    65,    73,    74,    75,    76,    68,    69,     0,    80,
+       0,    81,    82,    83,    66,    67,    68,    69,    80,     0,
+      81,    82,    83,     0,     0,     0,     0,     0,    80,     0,
+      81,    82,    83
 };
 
-#define yypact_value_is_default(Yystate) \
-  (!!((Yystate) == (-150)))
-
-#define yytable_value_is_error(Yytable_value) \
-  YYID (0)
-
 static const yytype_int16 yycheck[] =
 {
-       7,     8,     7,    21,    16,   141,    34,    35,    12,    15,
-      17,    18,    19,    16,    99,    12,    60,    24,    25,    31,
-      32,    16,     5,    11,     5,    16,    14,    34,    35,    36,
-      12,    43,    15,    45,    46,    47,   172,    42,    43,   188,
-      43,   190,    45,    46,    47,    36,    52,    13,    43,   134,
-      57,    58,    18,     5,     6,    12,    63,    64,    65,    66,
+       7,     8,    22,     7,    35,    36,    16,    16,    13,    15,
+      17,    18,    19,    18,    62,    16,   101,    12,    25,    26,
+      29,    30,    31,    32,    33,   143,    12,    16,    35,    36,
+      37,    32,    11,    43,    43,    14,    45,    46,    47,    43,
+      44,   190,    43,   192,    45,    46,    47,    36,    54,    13,
+      13,   136,    59,    60,    18,    18,   174,    12,    65,    66,
       67,    68,    69,    70,    71,    72,    73,    74,    75,    76,
-      77,    13,    78,   158,    13,    37,    18,     5,    13,    18,
-      87,     0,   126,    18,    13,   103,    93,    13,     5,    18,
-      13,    98,    18,    16,     9,    10,     5,     3,     4,     5,
-       6,     7,    13,    16,    12,    16,    12,    12,     6,     3,
-       4,     5,     6,     7,    14,   159,   144,   145,    12,    25,
-      26,    27,    15,    14,    30,    18,    42,    12,     4,   136,
-     148,    25,    26,     5,   141,     5,    30,   144,   145,    45,
-      46,    16,    11,   187,    12,   189,    42,   152,   192,    12,
-     194,    45,    46,   171,    29,    30,    31,    32,    33,    34,
-      35,    36,    37,    38,    39,   172,    17,    42,    43,    14,
-      45,    46,    47,   191,    11,   193,    19,   184,   196,   186,
-     198,     3,     4,     5,     6,     7,     8,    14,    11,     5,
-      12,    11,    11,    15,    11,     9,    14,    12,    20,    21,
-      22,    23,    24,    25,    26,    27,    28,    13,    30,     3,
-       4,     5,     6,     7,     8,    12,    14,   176,    12,    -1,
-      -1,    15,    -1,    45,    46,    -1,    20,    21,    22,    23,
-      24,    25,    26,    27,    28,    -1,    30,     3,     4,     5,
-       6,     7,     8,    -1,    -1,    -1,    12,    -1,    -1,    15,
-      -1,    45,    46,    -1,    20,    21,    22,    23,    24,    25,
-      26,    27,    28,    -1,    30,     3,     4,     5,     6,     7,
-       8,    -1,    -1,    -1,    12,    -1,    -1,    15,    -1,    45,
-      46,    -1,    20,    21,    22,    23,    24,    25,    26,    27,
-      28,    -1,    30,     3,     4,     5,     6,     7,     8,    -1,
-      -1,    -1,    12,    -1,    -1,    15,    -1,    45,    46,    -1,
+      77,    78,    79,     5,    80,   160,    13,     5,     6,    13,
+     128,    18,    89,    15,    18,   105,    13,    13,    95,    13,
+      16,    18,    16,   100,    15,     9,    10,    18,     5,    37,
+      12,     5,     3,     4,     5,     6,     7,     8,    11,     0,
+       5,    12,     5,   161,    15,   146,   147,    16,    12,    20,
+      21,    22,    23,    24,    25,    26,    27,    28,    16,    30,
+     150,   138,    12,    14,     6,    14,   143,    42,    12,   146,
+     147,   189,     4,   191,    45,    46,   194,     5,   196,    50,
+     154,     5,    42,   173,    11,    43,    12,    45,    46,    47,
+      12,    14,    17,    11,    14,    11,     5,   174,    19,    11,
+      11,    11,     9,   193,    12,   195,   178,    13,   198,   186,
+     200,   188,     3,     4,     5,     6,     7,     8,    12,    14,
+      -1,    12,    14,    -1,    15,    -1,    -1,    -1,    -1,    20,
+      21,    22,    23,    24,    25,    26,    27,    28,    -1,    30,
+      -1,    -1,    -1,    -1,     3,     4,     5,     6,     7,     8,
+      -1,    -1,    -1,    12,    45,    46,    15,    -1,    -1,    50,
+      -1,    20,    21,    22,    23,    24,    25,    26,    27,    28,
+      -1,    30,    -1,    -1,    -1,    -1,     3,     4,     5,     6,
+       7,     8,    -1,    -1,    -1,    12,    45,    46,    15,    -1,
+      -1,    50,    -1,    20,    21,    22,    23,    24,    25,    26,
+      27,    28,    -1,    30,    -1,    -1,    -1,    -1,     3,     4,
+       5,     6,     7,     8,    -1,    -1,    -1,    12,    45,    46,
+      15,    -1,    -1,    50,    -1,    20,    21,    22,    23,    24,
+      25,    26,    27,    28,    -1,    30,    -1,    -1,    -1,    -1,
+       3,     4,     5,     6,     7,     8,    -1,    -1,    -1,    12,
+      45,    46,    15,    -1,    -1,    50,    -1,    20,    21,    22,
+      23,    24,    25,    26,    27,    28,    -1,    30,    -1,    -1,
+      -1,    -1,     3,     4,     5,     6,     7,     8,    -1,    -1,
+      -1,    12,    45,    46,    15,    -1,    -1,    50,    -1,    20,
+      21,    22,    23,    24,    25,    26,    27,    28,    -1,    30,
+      -1,    -1,    -1,     3,     4,     5,     6,     7,     8,    -1,
+      -1,    -1,    12,    -1,    45,    46,    -1,    -1,    -1,    50,
       20,    21,    22,    23,    24,    25,    26,    27,    28,    -1,
-      30,     3,     4,     5,     6,     7,     8,    -1,    -1,    -1,
-      12,    -1,    -1,    15,    -1,    45,    46,    -1,    20,    21,
-      22,    23,    24,    25,    26,    27,    28,    -1,    30,     3,
-       4,     5,     6,     7,     8,    -1,    -1,    -1,    12,    -1,
-      -1,    15,    -1,    45,    46,    -1,    20,    21,    22,    23,
-      24,    25,    26,    27,    28,    -1,    30,     3,     4,     5,
-       6,     7,     8,    -1,    -1,    -1,    12,    -1,    -1,    -1,
-      -1,    45,    46,    -1,    20,    21,    22,    23,    24,    25,
-      26,    27,    28,    -1,    30,     3,     4,     5,     6,     7,
-      16,    -1,    -1,    -1,    12,    -1,    -1,    -1,    -1,    45,
-      46,    -1,    -1,    29,    30,    31,    32,    25,    26,    -1,
-      -1,    11,    30,    -1,    -1,    -1,    16,    43,    -1,    45,
-      46,    47,    -1,    -1,    -1,    -1,    -1,    45,    46,    29,
-      30,    31,    32,    33,    34,    35,    36,    37,    38,    39,
-      40,    41,    42,    43,    11,    45,    46,    47,    -1,    16,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      30,     3,     4,     5,     6,     7,    -1,    -1,    -1,    -1,
+      12,    -1,    -1,    -1,    -1,    45,    46,    -1,    -1,    -1,
+      50,    -1,    -1,    25,    26,    27,    -1,    -1,    30,     3,
+       4,     5,     6,     7,    -1,    -1,    -1,    -1,    12,    -1,
+      -1,    -1,    -1,    45,    46,    -1,     3,     4,     5,     6,
+       7,    25,    26,    -1,    -1,    12,    30,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    25,    26,
+      -1,    45,    46,    30,    11,    -1,    -1,    -1,    -1,    16,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    45,    46,
       -1,    -1,    29,    30,    31,    32,    33,    34,    35,    36,
       37,    38,    39,    40,    41,    42,    43,    11,    45,    46,
       47,    -1,    16,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
@@ -911,122 +1030,130 @@ static const yytype_int16 yycheck[] =
       31,    32,    33,    34,    35,    36,    37,    38,    39,    40,
       41,    42,    43,    11,    45,    46,    47,    -1,    16,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      16,    29,    30,    31,    32,    33,    34,    35,    36,    37,
-      38,    39,    40,    41,    42,    43,    32,    45,    46,    47,
-      13,    -1,    -1,    16,    -1,    -1,    -1,    43,    -1,    45,
-      46,    47,    -1,    -1,    -1,    -1,    29,    30,    31,    32,
-      33,    34,    35,    36,    37,    38,    39,    40,    41,    42,
-      43,    -1,    45,    46,    47,    13,    -1,    -1,    16,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    29,    30,    31,    32,    33,    34,    35,    36,    37,
-      38,    39,    40,    41,    42,    43,    -1,    45,    46,    47,
-      13,    -1,    -1,    16,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    29,    30,    31,    32,
-      33,    34,    35,    36,    37,    38,    39,    40,    41,    42,
-      43,    -1,    45,    46,    47,    16,    17,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    29,    30,
-      31,    32,    33,    34,    35,    36,    37,    38,    39,    40,
-      41,    42,    43,    16,    45,    46,    47,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    29,    30,    31,    32,
-      33,    34,    35,    36,    37,    38,    39,    40,    41,    42,
-      43,    16,    45,    46,    47,    -1,    -1,    -1,    -1,    -1,
+      38,    39,    40,    41,    42,    43,    11,    45,    46,    47,
+      -1,    16,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    29,    30,    31,    32,    33,    34,
-      35,    36,    37,    38,    39,    16,    -1,    -1,    43,    -1,
-      45,    46,    47,    -1,    -1,    -1,    -1,    -1,    29,    30,
-      31,    32,    33,    -1,    16,    36,    37,    38,    39,    -1,
-      -1,    -1,    43,    -1,    45,    46,    47,    29,    30,    31,
-      32,    33,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    43,    -1,    45,    46,    47
+      35,    36,    37,    38,    39,    40,    41,    42,    43,    -1,
+      45,    46,    47,    13,    -1,    -1,    16,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    29,
+      30,    31,    32,    33,    34,    35,    36,    37,    38,    39,
+      40,    41,    42,    43,    -1,    45,    46,    47,    13,    -1,
+      -1,    16,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    29,    30,    31,    32,    33,    34,
+      35,    36,    37,    38,    39,    40,    41,    42,    43,    -1,
+      45,    46,    47,    13,    -1,    -1,    16,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    29,
+      30,    31,    32,    33,    34,    35,    36,    37,    38,    39,
+      40,    41,    42,    43,    -1,    45,    46,    47,    16,    17,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    29,    30,    31,    32,    33,    34,    35,    36,    37,
+      38,    39,    40,    41,    42,    43,    16,    45,    46,    47,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    29,
+      30,    31,    32,    33,    34,    35,    36,    37,    38,    39,
+      40,    41,    42,    43,    16,    45,    46,    47,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    29,    30,    31,
+      32,    33,    34,    35,    36,    37,    38,    39,    16,    -1,
+      42,    43,    -1,    45,    46,    47,    -1,    -1,    -1,    -1,
+      -1,    29,    30,    31,    32,    33,    34,    35,    36,    37,
+      38,    39,    16,    -1,    -1,    43,    -1,    45,    46,    47,
+      -1,    16,    -1,    -1,    -1,    29,    30,    31,    32,    33,
+      -1,    16,    36,    37,    38,    39,    31,    32,    -1,    43,
+      -1,    45,    46,    47,    29,    30,    31,    32,    43,    -1,
+      45,    46,    47,    -1,    -1,    -1,    -1,    -1,    43,    -1,
+      45,    46,    47
 };
 
-/* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-   symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] =
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
 {
        0,     3,     4,     5,     6,     7,     8,    12,    20,    21,
       22,    23,    24,    25,    26,    27,    28,    30,    45,    46,
-      54,    55,    56,    57,    58,    59,    61,    62,    63,    66,
-      71,    73,    74,    77,    12,    12,    12,    74,    77,     6,
-      74,     5,    37,    12,     5,    73,    74,    74,    74,     0,
-      56,     5,    27,    74,    72,    74,     5,    12,    12,    11,
-      14,    70,    11,    16,    29,    30,    31,    32,    33,    34,
-      35,    36,    37,    38,    39,    40,    41,    42,    43,    45,
-      46,    47,    16,    72,    72,    74,    13,    13,    11,    14,
-       6,    77,    77,    42,    14,    73,    11,    13,    18,    12,
-      74,    74,    75,    55,    74,    74,    74,    74,    74,    74,
-      74,    74,    74,    74,    74,    74,    74,    74,    74,    73,
-       5,     6,     4,    13,    13,    13,    60,    74,     5,    69,
-      36,    13,    74,     5,    78,    79,    42,    74,    76,    79,
-      13,    11,    15,    17,    12,    12,    17,    14,    55,    15,
-      18,    11,    19,    15,    79,    11,    74,    13,    18,    14,
-      75,    72,    72,    15,    11,     5,    77,    11,    11,    11,
-      79,    55,    11,    13,    13,     9,    64,    65,    15,    75,
-      10,    65,    67,    68,    12,    13,    12,    14,    74,    14,
-      74,    55,    60,    55,    60,    15,    55,    15,    55,    15,
-      15
+      50,    55,    56,    57,    58,    59,    60,    62,    63,    64,
+      67,    72,    74,    75,    78,    12,    12,    12,    75,    78,
+       6,    75,     5,    37,    12,     5,    74,    75,    75,    75,
+      11,     0,    57,     5,    27,    75,    73,    75,     5,    12,
+      12,    11,    14,    71,    11,    16,    29,    30,    31,    32,
+      33,    34,    35,    36,    37,    38,    39,    40,    41,    42,
+      43,    45,    46,    47,    16,    73,    73,    75,    13,    13,
+      11,    14,     6,    78,    78,    42,    14,    74,    11,    13,
+      18,    12,    75,    75,    76,    56,    75,    75,    75,    75,
+      75,    75,    75,    75,    75,    75,    75,    75,    75,    75,
+      75,    74,     5,     6,     4,    13,    13,    13,    61,    75,
+       5,    70,    36,    13,    75,     5,    79,    80,    42,    75,
+      77,    80,    13,    11,    15,    17,    12,    12,    17,    14,
+      56,    15,    18,    11,    19,    15,    80,    11,    75,    13,
+      18,    14,    76,    73,    73,    15,    11,     5,    78,    11,
+      11,    11,    80,    56,    11,    13,    13,     9,    65,    66,
+      15,    76,    10,    66,    68,    69,    12,    13,    12,    14,
+      75,    14,    75,    56,    61,    56,    61,    15,    56,    15,
+      56,    15,    15
 };
 
-#define yyerrok		(yyerrstatus = 0)
-#define yyclearin	(yychar = YYEMPTY)
-#define YYEMPTY		(-2)
-#define YYEOF		0
-
-#define YYACCEPT	goto yyacceptlab
-#define YYABORT		goto yyabortlab
-#define YYERROR		goto yyerrorlab
-
-
-/* Like YYERROR except do call yyerror.  This remains here temporarily
-   to ease the transition to the new meaning of YYERROR, for GCC.
-   Once GCC version 2 has supplanted version 1, this can go.  However,
-   YYFAIL appears to be in use.  Nevertheless, it is formally deprecated
-   in Bison 2.4.2's NEWS entry, where a plan to phase it out is
-   discussed.  */
-
-#define YYFAIL		goto yyerrlab
-#if defined YYFAIL
-  /* This is here to suppress warnings from the GCC cpp's
-     -Wunused-macros.  Normally we don't worry about that warning, but
-     some users do, and we want to make it easy for users to remove
-     YYFAIL uses, which will produce warnings from Bison 2.5.  */
-#endif
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
+{
+       0,    54,    55,    56,    56,    56,    57,    57,    57,    57,
+      57,    57,    57,    57,    57,    57,    57,    57,    58,    59,
+      60,    61,    62,    63,    64,    65,    65,    65,    66,    67,
+      68,    68,    69,    70,    70,    71,    71,    72,    72,    72,
+      73,    73,    73,    74,    75,    75,    75,    75,    75,    75,
+      75,    75,    75,    75,    75,    75,    75,    75,    75,    75,
+      75,    75,    75,    75,    75,    75,    75,    75,    75,    75,
+      75,    75,    75,    75,    75,    76,    76,    77,    77,    77,
+      78,    78,    79,    79,    79,    80
+};
 
-#define YYRECOVERING()  (!!yyerrstatus)
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     1,     2,     1,     0,     2,     5,     3,     6,
+       3,     2,     2,     7,    11,     6,     6,     8,     1,     3,
+       1,     2,     1,     1,     1,     7,     6,     0,     1,     5,
+       4,     0,     1,     3,     1,     3,     1,     1,     1,     4,
+       3,     1,     0,     1,     1,     4,     4,     4,     1,     1,
+       2,     2,     6,     6,     3,     3,     3,     3,     3,     3,
+       3,     3,     3,     3,     3,     3,     3,     3,     3,     4,
+       2,     4,     3,     2,     2,     0,     1,     3,     1,     0,
+       4,     1,     3,     2,     0,     3
+};
 
-#define YYBACKUP(Token, Value)                                  \
-do                                                              \
-  if (yychar == YYEMPTY)                                        \
-    {                                                           \
-      yychar = (Token);                                         \
-      yylval = (Value);                                         \
-      YYPOPSTACK (yylen);                                       \
-      yystate = *yyssp;                                         \
-      goto yybackup;                                            \
-    }                                                           \
-  else                                                          \
-    {                                                           \
-      yyerror (scanner, YY_("syntax error: cannot back up")); \
-      YYERROR;							\
-    }								\
-while (YYID (0))
-
-/* Error token number */
-#define YYTERROR	1
-#define YYERRCODE	256
-
-
-/* This macro is provided for backward compatibility. */
-#ifndef YY_LOCATION_PRINT
-# define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-#endif
 
+enum { YYENOMEM = -2 };
+
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
+
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
+
+
+#define YYRECOVERING()  (!!yyerrstatus)
+
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (scanner, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
-/* YYLEX -- calling `yylex' with the right arguments.  */
-#ifdef YYLEX_PARAM
-# define YYLEX yylex (&yylval, YYLEX_PARAM)
-#else
-# define YYLEX yylex (&yylval, scanner)
-#endif
 
 /* Enable debugging if requested.  */
 #if YYDEBUG
@@ -1036,85 +1163,59 @@ while (YYID (0))
 #  define YYFPRINTF fprintf
 # endif
 
-# define YYDPRINTF(Args)			\
-do {						\
-  if (yydebug)					\
-    YYFPRINTF Args;				\
-} while (YYID (0))
-
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)			  \
-do {									  \
-  if (yydebug)								  \
-    {									  \
-      YYFPRINTF (stderr, "%s ", Title);					  \
-      yy_symbol_print (stderr,						  \
-		  Type, Value, scanner); \
-      YYFPRINTF (stderr, "\n");						  \
-    }									  \
-} while (YYID (0))
-
-
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
-
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, void* scanner)
-#else
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value, scanner); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
 static void
-yy_symbol_value_print (yyoutput, yytype, yyvaluep, scanner)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-    void* scanner;
-#endif
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, void* scanner)
 {
-  FILE *yyo = yyoutput;
-  YYUSE (yyo);
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (scanner);
   if (!yyvaluep)
     return;
-  YYUSE (scanner);
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# else
-  YYUSE (yyoutput);
-# endif
-  switch (yytype)
-    {
-      default:
-        break;
-    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, void* scanner)
-#else
-static void
-yy_symbol_print (yyoutput, yytype, yyvaluep, scanner)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-    void* scanner;
-#endif
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, void* scanner)
 {
-  if (yytype < YYNTOKENS)
-    YYFPRINTF (yyoutput, "token %s (", yytname[yytype]);
-  else
-    YYFPRINTF (yyoutput, "nterm %s (", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep, scanner);
-  YYFPRINTF (yyoutput, ")");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, scanner);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -1122,16 +1223,8 @@ yy_symbol_print (yyoutput, yytype, yyvaluep, scanner)
 | TOP (included).                                                   |
 `------------------------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_stack_print (yytype_int16 *yybottom, yytype_int16 *yytop)
-#else
 static void
-yy_stack_print (yybottom, yytop)
-    yytype_int16 *yybottom;
-    yytype_int16 *yytop;
-#endif
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
   for (; yybottom <= yytop; yybottom++)
@@ -1142,64 +1235,56 @@ yy_stack_print (yybottom, yytop)
   YYFPRINTF (stderr, "\n");
 }
 
-# define YY_STACK_PRINT(Bottom, Top)				\
-do {								\
-  if (yydebug)							\
-    yy_stack_print ((Bottom), (Top));				\
-} while (YYID (0))
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
 
 
 /*------------------------------------------------.
 | Report that the YYRULE is going to be reduced.  |
 `------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_reduce_print (YYSTYPE *yyvsp, int yyrule, void* scanner)
-#else
 static void
-yy_reduce_print (yyvsp, yyrule, scanner)
-    YYSTYPE *yyvsp;
-    int yyrule;
-    void* scanner;
-#endif
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule, void* scanner)
 {
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  unsigned long int yylno = yyrline[yyrule];
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
-	     yyrule - 1, yylno);
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
-      yy_symbol_print (stderr, yyrhs[yyprhs[yyrule] + yyi],
-		       &(yyvsp[(yyi + 1) - (yynrhs)])
-		       		       , scanner);
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)], scanner);
       YYFPRINTF (stderr, "\n");
     }
 }
 
-# define YY_REDUCE_PRINT(Rule)		\
-do {					\
-  if (yydebug)				\
-    yy_reduce_print (yyvsp, Rule, scanner); \
-} while (YYID (0))
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, Rule, scanner); \
+} while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
 
 
 /* YYINITDEPTH -- initial size of the parser's stacks.  */
-#ifndef	YYINITDEPTH
+#ifndef YYINITDEPTH
 # define YYINITDEPTH 200
 #endif
 
@@ -1215,378 +1300,84 @@ int yydebug;
 #endif
 
 
-#if YYERROR_VERBOSE
-
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
-/* Return the length of YYSTR.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static YYSIZE_T
-yystrlen (const char *yystr)
-#else
-static YYSIZE_T
-yystrlen (yystr)
-    const char *yystr;
-#endif
-{
-  YYSIZE_T yylen;
-  for (yylen = 0; yystr[yylen]; yylen++)
-    continue;
-  return yylen;
-}
-#  endif
-# endif
-
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
-/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
-   YYDEST.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static char *
-yystpcpy (char *yydest, const char *yysrc)
-#else
-static char *
-yystpcpy (yydest, yysrc)
-    char *yydest;
-    const char *yysrc;
-#endif
-{
-  char *yyd = yydest;
-  const char *yys = yysrc;
-
-  while ((*yyd++ = *yys++) != '\0')
-    continue;
-
-  return yyd - 1;
-}
-#  endif
-# endif
-
-# ifndef yytnamerr
-/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
-   quotes and backslashes, so that it's suitable for yyerror.  The
-   heuristic is that double-quoting is unnecessary unless the string
-   contains an apostrophe, a comma, or backslash (other than
-   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
-   null, do not copy; instead, return the length of what the result
-   would have been.  */
-static YYSIZE_T
-yytnamerr (char *yyres, const char *yystr)
-{
-  if (*yystr == '"')
-    {
-      YYSIZE_T yyn = 0;
-      char const *yyp = yystr;
-
-      for (;;)
-	switch (*++yyp)
-	  {
-	  case '\'':
-	  case ',':
-	    goto do_not_strip_quotes;
-
-	  case '\\':
-	    if (*++yyp != '\\')
-	      goto do_not_strip_quotes;
-	    /* Fall through.  */
-	  default:
-	    if (yyres)
-	      yyres[yyn] = *yyp;
-	    yyn++;
-	    break;
-
-	  case '"':
-	    if (yyres)
-	      yyres[yyn] = '\0';
-	    return yyn;
-	  }
-    do_not_strip_quotes: ;
-    }
-
-  if (! yyres)
-    return yystrlen (yystr);
-
-  return yystpcpy (yyres, yystr) - yyres;
-}
-# endif
-
-/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
-   about the unexpected token YYTOKEN for the state stack whose top is
-   YYSSP.
-
-   Return 0 if *YYMSG was successfully written.  Return 1 if *YYMSG is
-   not large enough to hold the message.  In that case, also set
-   *YYMSG_ALLOC to the required number of bytes.  Return 2 if the
-   required number of bytes is too large to store.  */
-static int
-yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
-                yytype_int16 *yyssp, int yytoken)
-{
-  YYSIZE_T yysize0 = yytnamerr (YY_NULL, yytname[yytoken]);
-  YYSIZE_T yysize = yysize0;
-  enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-  /* Internationalized format string. */
-  const char *yyformat = YY_NULL;
-  /* Arguments of yyformat. */
-  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-  /* Number of reported tokens (one for the "unexpected", one per
-     "expected"). */
-  int yycount = 0;
-
-  /* There are many possibilities here to consider:
-     - Assume YYFAIL is not used.  It's too flawed to consider.  See
-       <http://lists.gnu.org/archive/html/bison-patches/2009-12/msg00024.html>
-       for details.  YYERROR is fine as it does not invoke this
-       function.
-     - If this state is a consistent state with a default action, then
-       the only way this function was invoked is if the default action
-       is an error action.  In that case, don't check for expected
-       tokens because there are none.
-     - The only way there can be no lookahead present (in yychar) is if
-       this state is a consistent state with a default action.  Thus,
-       detecting the absence of a lookahead is sufficient to determine
-       that there is no unexpected or expected token to report.  In that
-       case, just report a simple "syntax error".
-     - Don't assume there isn't a lookahead just because this state is a
-       consistent state with a default action.  There might have been a
-       previous inconsistent state, consistent state with a non-default
-       action, or user semantic action that manipulated yychar.
-     - Of course, the expected token list depends on states to have
-       correct lookahead information, and it depends on the parser not
-       to perform extra reductions after fetching a lookahead from the
-       scanner and before detecting a syntax error.  Thus, state merging
-       (from LALR or IELR) and default reductions corrupt the expected
-       token list.  However, the list is correct for canonical LR with
-       one exception: it will still contain any token that will not be
-       accepted due to an error action in a later state.
-  */
-  if (yytoken != YYEMPTY)
-    {
-      int yyn = yypact[*yyssp];
-      yyarg[yycount++] = yytname[yytoken];
-      if (!yypact_value_is_default (yyn))
-        {
-          /* Start YYX at -YYN if negative to avoid negative indexes in
-             YYCHECK.  In other words, skip the first -YYN actions for
-             this state because they are default actions.  */
-          int yyxbegin = yyn < 0 ? -yyn : 0;
-          /* Stay within bounds of both yycheck and yytname.  */
-          int yychecklim = YYLAST - yyn + 1;
-          int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-          int yyx;
-
-          for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-            if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR
-                && !yytable_value_is_error (yytable[yyx + yyn]))
-              {
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                  {
-                    yycount = 1;
-                    yysize = yysize0;
-                    break;
-                  }
-                yyarg[yycount++] = yytname[yyx];
-                {
-                  YYSIZE_T yysize1 = yysize + yytnamerr (YY_NULL, yytname[yyx]);
-                  if (! (yysize <= yysize1
-                         && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-                    return 2;
-                  yysize = yysize1;
-                }
-              }
-        }
-    }
-
-  switch (yycount)
-    {
-# define YYCASE_(N, S)                      \
-      case N:                               \
-        yyformat = S;                       \
-      break
-      YYCASE_(0, YY_("syntax error"));
-      YYCASE_(1, YY_("syntax error, unexpected %s"));
-      YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
-      YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
-      YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
-      YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
-# undef YYCASE_
-    }
 
-  {
-    YYSIZE_T yysize1 = yysize + yystrlen (yyformat);
-    if (! (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-      return 2;
-    yysize = yysize1;
-  }
 
-  if (*yymsg_alloc < yysize)
-    {
-      *yymsg_alloc = 2 * yysize;
-      if (! (yysize <= *yymsg_alloc
-             && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
-        *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
-      return 1;
-    }
 
-  /* Avoid sprintf, as that infringes on the user's name space.
-     Don't have undefined behavior even if the translation
-     produced a string with the wrong number of "%s"s.  */
-  {
-    char *yyp = *yymsg;
-    int yyi = 0;
-    while ((*yyp = *yyformat) != '\0')
-      if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
-        {
-          yyp += yytnamerr (yyp, yyarg[yyi++]);
-          yyformat += 2;
-        }
-      else
-        {
-          yyp++;
-          yyformat++;
-        }
-  }
-  return 0;
-}
-#endif /* YYERROR_VERBOSE */
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, void* scanner)
-#else
 static void
-yydestruct (yymsg, yytype, yyvaluep, scanner)
-    const char *yymsg;
-    int yytype;
-    YYSTYPE *yyvaluep;
-    void* scanner;
-#endif
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, void* scanner)
 {
-  YYUSE (yyvaluep);
-  YYUSE (scanner);
-
+  YY_USE (yyvaluep);
+  YY_USE (scanner);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
-
-  switch (yytype)
-    {
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
-      default:
-        break;
-    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
 
 
+
+
 /*----------.
 | yyparse.  |
 `----------*/
 
-#ifdef YYPARSE_PARAM
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-int
-yyparse (void *YYPARSE_PARAM)
-#else
-int
-yyparse (YYPARSE_PARAM)
-    void *YYPARSE_PARAM;
-#endif
-#else /* ! YYPARSE_PARAM */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 int
 yyparse (void* scanner)
-#else
-int
-yyparse (scanner)
-    void* scanner;
-#endif
-#endif
 {
-/* The lookahead symbol.  */
+/* Lookahead token kind.  */
 int yychar;
 
 
-#if defined __GNUC__ && 407 <= __GNUC__ * 100 + __GNUC_MINOR__
-/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN \
-    _Pragma ("GCC diagnostic push") \
-    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")\
-    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
-# define YY_IGNORE_MAYBE_UNINITIALIZED_END \
-    _Pragma ("GCC diagnostic pop")
-#else
+/* The semantic value of the lookahead symbol.  */
 /* Default value used for initialization, for pacifying older GCCs
    or non-GCC compilers.  */
-static YYSTYPE yyval_default;
-# define YY_INITIAL_VALUE(Value) = Value
-#endif
-#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-# define YY_IGNORE_MAYBE_UNINITIALIZED_END
-#endif
-#ifndef YY_INITIAL_VALUE
-# define YY_INITIAL_VALUE(Value) /* Nothing. */
-#endif
-
-/* The semantic value of the lookahead symbol.  */
-YYSTYPE yylval YY_INITIAL_VALUE(yyval_default);
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
 
     /* Number of syntax errors so far.  */
-    int yynerrs;
+    int yynerrs = 0;
 
-    int yystate;
+    yy_state_fast_t yystate = 0;
     /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
+    int yyerrstatus = 0;
 
-    /* The stacks and their tools:
-       `yyss': related to states.
-       `yyvs': related to semantic values.
-
-       Refer to the stacks through separate pointers, to allow yyoverflow
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
-    yytype_int16 yyssa[YYINITDEPTH];
-    yytype_int16 *yyss;
-    yytype_int16 *yyssp;
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
 
-    /* The semantic value stack.  */
-    YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-    YYSIZE_T yystacksize;
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken = 0;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
 
-#if YYERROR_VERBOSE
-  /* Buffer for error messages, and its allocated size.  */
-  char yymsgbuf[128];
-  char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
 
@@ -1594,102 +1385,107 @@ YYSTYPE yylval YY_INITIAL_VALUE(yyval_default);
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yyssp = yyss = yyssa;
-  yyvsp = yyvs = yyvsa;
-  yystacksize = YYINITDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
+
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
-	/* Give user a chance to reallocate the stack.  Use copies of
-	   these so that the &'s don't force the real ones into
-	   memory.  */
-	YYSTYPE *yyvs1 = yyvs;
-	yytype_int16 *yyss1 = yyss;
-
-	/* Each stack pointer address is followed by the size of the
-	   data in use in that stack, in bytes.  This used to be a
-	   conditional around just the two extra args, but that might
-	   be undefined if yyoverflow is a macro.  */
-	yyoverflow (YY_("memory exhausted"),
-		    &yyss1, yysize * sizeof (*yyssp),
-		    &yyvs1, yysize * sizeof (*yyvsp),
-		    &yystacksize);
-
-	yyss = yyss1;
-	yyvs = yyvs1;
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-	goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
-	yystacksize = YYMAXDEPTH;
+        yystacksize = YYMAXDEPTH;
 
       {
-	yytype_int16 *yyss1 = yyss;
-	union yyalloc *yyptr =
-	  (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
-	if (! yyptr)
-	  goto yyexhaustedlab;
-	YYSTACK_RELOCATE (yyss_alloc, yyss);
-	YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
 #  undef YYSTACK_RELOCATE
-	if (yyss1 != yyssa)
-	  YYSTACK_FREE (yyss1);
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
 
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-		  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
-	YYABORT;
+        YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
 
   if (yystate == YYFINAL)
     YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
      lookahead token if we need one and don't already have one.  */
 
@@ -1700,18 +1496,29 @@ yybackup:
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
-      yychar = YYLEX;
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval, scanner);
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1739,15 +1546,13 @@ yybackup:
 
   /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token.  */
-  yychar = YYEMPTY;
-
   yystate = yyn;
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -1762,14 +1567,14 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
   yylen = yyr2[yyn];
 
   /* If YYLEN is nonzero, implement the default value of the action:
-     `$$ = $1'.
+     '$$ = $1'.
 
      Otherwise, the following line sets YYVAL to garbage.
      This behavior is undocumented and Bison
@@ -1782,65 +1587,64 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 2:
-/* Line 1792 of yacc.c  */
-#line 189 "bs.y"
-    { BS_BUILD((yyval.vProgram), CreateProgram()); (yyval.vProgram)->SetStmtList((yyvsp[(1) - (1)].vStmtList)); }
-    break;
-
-  case 3:
-/* Line 1792 of yacc.c  */
-#line 192 "bs.y"
-    { 
-                    (yyval.vStmtList) = (yyvsp[(1) - (2)].vStmtList);
-                    BS_CHECKLIST((yyvsp[(1) - (2)].vStmtList));
+  case 2: /* program: stmt_list  */
+#line 190 "bs.y"
+                     { BS_BUILD((yyval.vProgram), CreateProgram()); (yyval.vProgram)->SetStmtList((yyvsp[0].vStmtList)); }
+#line 1594 "bs.parser.cpp"
+    break;
+
+  case 3: /* stmt_list: stmt_list stmt  */
+#line 193 "bs.y"
+                           { 
+                    (yyval.vStmtList) = (yyvsp[-1].vStmtList);
+                    BS_CHECKLIST((yyvsp[-1].vStmtList));
                     StmtList* newTail = BS_GlobalBuilder->CreateStmtList();
-                    newTail->SetStmt((yyvsp[(2) - (2)].vStmt));
-                    StmtList* tailTraversal = (yyvsp[(1) - (2)].vStmtList);
+                    newTail->SetStmt((yyvsp[0].vStmt));
+                    StmtList* tailTraversal = (yyvsp[-1].vStmtList);
                     while(tailTraversal->GetTail() != nullptr) { tailTraversal = tailTraversal->GetTail(); }
                     tailTraversal->SetTail(newTail);
             }
+#line 1608 "bs.parser.cpp"
     break;
 
-  case 4:
-/* Line 1792 of yacc.c  */
-#line 201 "bs.y"
-    { (yyval.vStmtList) = BS_GlobalBuilder->CreateStmtList(); (yyval.vStmtList)->SetStmt((yyvsp[(1) - (1)].vStmt)); }
-    break;
-
-  case 5:
-/* Line 1792 of yacc.c  */
+  case 4: /* stmt_list: stmt  */
 #line 202 "bs.y"
-    { (yyval.vStmtList) = BS_GlobalBuilder->CreateStmtList(); }
+                        { (yyval.vStmtList) = BS_GlobalBuilder->CreateStmtList(); (yyval.vStmtList)->SetStmt((yyvsp[0].vStmt)); }
+#line 1614 "bs.parser.cpp"
     break;
 
-  case 6:
-/* Line 1792 of yacc.c  */
-#line 205 "bs.y"
-    { BS_BUILD((yyval.vStmt), BuildStmtExp((yyvsp[(1) - (2)].vExp))); }
+  case 5: /* stmt_list: %empty  */
+#line 203 "bs.y"
+                        { (yyval.vStmtList) = BS_GlobalBuilder->CreateStmtList(); }
+#line 1620 "bs.parser.cpp"
     break;
 
-  case 7:
-/* Line 1792 of yacc.c  */
+  case 6: /* stmt: exp K_SEMICOLON  */
 #line 206 "bs.y"
-    { BS_BUILD((yyval.vStmt), BuildExternVariable((yyvsp[(2) - (5)].vExp),(yyvsp[(4) - (5)].vExp))); }
+                          { BS_BUILD((yyval.vStmt), BuildStmtExp((yyvsp[-1].vExp))); }
+#line 1626 "bs.parser.cpp"
     break;
 
-  case 8:
-/* Line 1792 of yacc.c  */
+  case 7: /* stmt: K_EXTERN ident O_SET exp K_SEMICOLON  */
 #line 207 "bs.y"
-    { BS_BUILD((yyval.vStmt), BuildDeclarationWithAnnotation((yyvsp[(1) - (3)].vAnnotations), (yyvsp[(2) - (3)].vExp))); }
+                                                { BS_BUILD((yyval.vStmt), BuildExternVariable((yyvsp[-3].vExp),(yyvsp[-1].vExp))); }
+#line 1632 "bs.parser.cpp"
     break;
 
-  case 9:
-/* Line 1792 of yacc.c  */
-#line 209 "bs.y"
-    {
+  case 8: /* stmt: annotation_list exp K_SEMICOLON  */
+#line 208 "bs.y"
+                                          { BS_BUILD((yyval.vStmt), BuildDeclarationWithAnnotation((yyvsp[-2].vAnnotations), (yyvsp[-1].vExp))); }
+#line 1638 "bs.parser.cpp"
+    break;
+
+  case 9: /* stmt: annotation_list K_EXTERN ident O_SET exp K_SEMICOLON  */
+#line 210 "bs.y"
+          {
                 StmtExp* declaration = nullptr;
-                BS_BUILD(declaration, BuildExternVariable((yyvsp[(3) - (6)].vExp), (yyvsp[(5) - (6)].vExp)));
+                BS_BUILD(declaration, BuildExternVariable((yyvsp[-3].vExp), (yyvsp[-1].vExp)));
                 if (declaration != nullptr)
                 {
-                    BS_BUILD((yyval.vStmt), BuildDeclarationWithAnnotation((yyvsp[(1) - (6)].vAnnotations), declaration->GetExp()));
+                    BS_BUILD((yyval.vStmt), BuildDeclarationWithAnnotation((yyvsp[-5].vAnnotations), declaration->GetExp()));
                 }
                 else
                 {
@@ -1849,51 +1653,57 @@ yyreduce:
                     YYERROR; 
                 }
           }
+#line 1657 "bs.parser.cpp"
     break;
 
-  case 10:
-/* Line 1792 of yacc.c  */
-#line 223 "bs.y"
-    { BS_BUILD((yyval.vStmt), BuildStmtReturn((yyvsp[(2) - (3)].vExp))); }
+  case 10: /* stmt: K_RETURN exp K_SEMICOLON  */
+#line 224 "bs.y"
+                                   { BS_BUILD((yyval.vStmt), BuildStmtReturn((yyvsp[-1].vExp))); }
+#line 1663 "bs.parser.cpp"
     break;
 
-  case 11:
-/* Line 1792 of yacc.c  */
-#line 224 "bs.y"
-    {BS_BUILD((yyval.vStmt), BindFunImplementation((yyvsp[(1) - (2)].vStmtFunDec), (yyvsp[(2) - (2)].vStmtList)));}
+  case 11: /* stmt: K_YIELD K_SEMICOLON  */
+#line 225 "bs.y"
+                              { BS_BUILD((yyval.vStmt), BuildStmtYield()); }
+#line 1669 "bs.parser.cpp"
     break;
 
-  case 12:
-/* Line 1792 of yacc.c  */
+  case 12: /* stmt: fun_declaration fun_stmt_list  */
 #line 226 "bs.y"
-    { 
-               BS_BUILD((yyval.vStmt), BuildStmtWhile((yyvsp[(3) - (7)].vExp), (yyvsp[(6) - (7)].vStmtList)));
-        }
+                                         {BS_BUILD((yyval.vStmt), BindFunImplementation((yyvsp[-1].vStmtFunDec), (yyvsp[0].vStmtList)));}
+#line 1675 "bs.parser.cpp"
     break;
 
-  case 13:
-/* Line 1792 of yacc.c  */
-#line 230 "bs.y"
-    {
-               BS_BUILD((yyval.vStmt), BuildStmtFor((yyvsp[(3) - (11)].vExp),(yyvsp[(5) - (11)].vExp),(yyvsp[(7) - (11)].vExp),(yyvsp[(10) - (11)].vStmtList)));
+  case 13: /* stmt: while_keyword K_L_PAREN exp K_R_PAREN K_L_BRAC stmt_list K_R_BRAC  */
+#line 228 "bs.y"
+        { 
+               BS_BUILD((yyval.vStmt), BuildStmtWhile((yyvsp[-4].vExp), (yyvsp[-1].vStmtList)));
         }
+#line 1683 "bs.parser.cpp"
     break;
 
-  case 14:
-/* Line 1792 of yacc.c  */
-#line 233 "bs.y"
-    { BS_BUILD((yyval.vStmt), BuildStmtStructDef((yyvsp[(2) - (6)].identifierText), (yyvsp[(4) - (6)].vArgList))); }
+  case 14: /* stmt: for_keyword K_L_PAREN optional_exp K_SEMICOLON optional_exp K_SEMICOLON optional_exp K_R_PAREN K_L_BRAC stmt_list K_R_BRAC  */
+#line 232 "bs.y"
+        {
+               BS_BUILD((yyval.vStmt), BuildStmtFor((yyvsp[-8].vExp),(yyvsp[-6].vExp),(yyvsp[-4].vExp),(yyvsp[-1].vStmtList)));
+        }
+#line 1691 "bs.parser.cpp"
     break;
 
-  case 15:
-/* Line 1792 of yacc.c  */
+  case 15: /* stmt: struct_keyword IDENTIFIER K_L_BRAC struct_def_list K_R_BRAC K_SEMICOLON  */
 #line 235 "bs.y"
-    { 
-            if (BS_GlobalBuilder->GetSymbolTable()->GetTypeByName((yyvsp[(2) - (6)].identifierText)) == nullptr)
+                                                                                  { BS_BUILD((yyval.vStmt), BuildStmtStructDef((yyvsp[-4].identifierText), (yyvsp[-2].vArgList))); }
+#line 1697 "bs.parser.cpp"
+    break;
+
+  case 16: /* stmt: K_ENUM IDENTIFIER K_L_BRAC enum_list K_R_BRAC K_SEMICOLON  */
+#line 237 "bs.y"
+        { 
+            if (BS_GlobalBuilder->GetSymbolTable()->GetTypeByName((yyvsp[-4].identifierText)) == nullptr)
             {
                 const Pegasus::BlockScript::TypeDesc* enumType = BS_GlobalBuilder->GetSymbolTable()->CreateEnumType(
-                    (yyvsp[(2) - (6)].identifierText),
-                    (yyvsp[(4) - (6)].vEnumNode) //the definition!
+                    (yyvsp[-4].identifierText),
+                    (yyvsp[-2].vEnumNode) //the definition!
                 );
         
                 BS_BUILD((yyval.vStmt), BuildStmtEnumTypeDef(enumType));
@@ -1904,480 +1714,480 @@ yyreduce:
                 YYERROR; 
             }
         }
+#line 1718 "bs.parser.cpp"
     break;
 
-  case 16:
-/* Line 1792 of yacc.c  */
-#line 252 "bs.y"
-    { 
-                    if ((yyvsp[(8) - (8)].vStmtIfElse) != nullptr && (yyvsp[(7) - (8)].vStmtIfElse) != nullptr)
+  case 17: /* stmt: K_IF K_L_PAREN exp if_begin_scope stmt_list K_R_BRAC stmt_else_if_tail stmt_else_tail  */
+#line 254 "bs.y"
+                 { 
+                    if ((yyvsp[0].vStmtIfElse) != nullptr && (yyvsp[-1].vStmtIfElse) != nullptr)
                     {
-                        Pegasus::BlockScript::Ast::StmtIfElse* tail = (yyvsp[(7) - (8)].vStmtIfElse);
+                        Pegasus::BlockScript::Ast::StmtIfElse* tail = (yyvsp[-1].vStmtIfElse);
                         while (tail->GetTail() != nullptr) tail = tail->GetTail();
-                        tail->SetTail((yyvsp[(8) - (8)].vStmtIfElse)); //else is the last statement
+                        tail->SetTail((yyvsp[0].vStmtIfElse)); //else is the last statement
                     }
-                    if ((yyvsp[(8) - (8)].vStmtIfElse) != nullptr && (yyvsp[(7) - (8)].vStmtIfElse) == nullptr)
+                    if ((yyvsp[0].vStmtIfElse) != nullptr && (yyvsp[-1].vStmtIfElse) == nullptr)
                     {
-                        BS_BUILD((yyval.vStmt), BuildStmtIfElse((yyvsp[(3) - (8)].vExp), (yyvsp[(5) - (8)].vStmtList), (yyvsp[(8) - (8)].vStmtIfElse), (yyvsp[(4) - (8)].vFrameInfo)));
+                        BS_BUILD((yyval.vStmt), BuildStmtIfElse((yyvsp[-5].vExp), (yyvsp[-3].vStmtList), (yyvsp[0].vStmtIfElse), (yyvsp[-4].vFrameInfo)));
                     }
                     else
                     {
-                        BS_BUILD((yyval.vStmt), BuildStmtIfElse((yyvsp[(3) - (8)].vExp), (yyvsp[(5) - (8)].vStmtList), (yyvsp[(7) - (8)].vStmtIfElse), (yyvsp[(4) - (8)].vFrameInfo)));
+                        BS_BUILD((yyval.vStmt), BuildStmtIfElse((yyvsp[-5].vExp), (yyvsp[-3].vStmtList), (yyvsp[-1].vStmtIfElse), (yyvsp[-4].vFrameInfo)));
                     }
 
                     BS_GlobalBuilder->PopFrame();
                  }
+#line 1741 "bs.parser.cpp"
     break;
 
-  case 17:
-/* Line 1792 of yacc.c  */
-#line 272 "bs.y"
-    { BS_BUILD((yyval.vFrameInfo), StartNewFrame()); }
+  case 18: /* struct_keyword: K_STRUCT  */
+#line 274 "bs.y"
+                           { BS_BUILD((yyval.vFrameInfo), StartNewFrame()); }
+#line 1747 "bs.parser.cpp"
     break;
 
-  case 18:
-/* Line 1792 of yacc.c  */
-#line 275 "bs.y"
-    {  BS_BUILD((yyval.vAnnotations), EndAnnotations((yyvsp[(1) - (3)].vAnnotations), (yyvsp[(2) - (3)].vExpList))); }
+  case 19: /* annotation_list: annotation_begin exp_list K_R_PAREN  */
+#line 277 "bs.y"
+                                                      {  BS_BUILD((yyval.vAnnotations), EndAnnotations((yyvsp[-2].vAnnotations), (yyvsp[-1].vExpList))); }
+#line 1753 "bs.parser.cpp"
     break;
 
-  case 19:
-/* Line 1792 of yacc.c  */
-#line 278 "bs.y"
-    { BS_BUILD((yyval.vAnnotations), BeginAnnotations()); }
+  case 20: /* annotation_begin: K_A_PAREN  */
+#line 280 "bs.y"
+                             { BS_BUILD((yyval.vAnnotations), BeginAnnotations()); }
+#line 1759 "bs.parser.cpp"
     break;
 
-  case 20:
-/* Line 1792 of yacc.c  */
-#line 282 "bs.y"
-    { BS_BUILD((yyval.vFrameInfo), StartNewFrame()); }
+  case 21: /* if_begin_scope: K_R_PAREN K_L_BRAC  */
+#line 284 "bs.y"
+                                    { BS_BUILD((yyval.vFrameInfo), StartNewFrame()); }
+#line 1765 "bs.parser.cpp"
     break;
 
-  case 21:
-/* Line 1792 of yacc.c  */
-#line 285 "bs.y"
-    { (yyval.vTypeDesc) = (yyvsp[(1) - (1)].vTypeDesc); if ((yyval.vTypeDesc) == nullptr) { BS_parseerror("Syntax error. Invalid function type.");YYERROR; }; if (!BS_GlobalBuilder->StartNewFunction((yyval.vTypeDesc))) {BS_parseerror("cannot declare function within a function"); YYERROR;} }
+  case 22: /* fun_type: type_desc  */
+#line 287 "bs.y"
+                     { (yyval.vTypeDesc) = (yyvsp[0].vTypeDesc); if ((yyval.vTypeDesc) == nullptr) { BS_parseerror("Syntax error. Invalid function type.");YYERROR; }; if (!BS_GlobalBuilder->StartNewFunction((yyval.vTypeDesc))) {BS_parseerror("cannot declare function within a function"); YYERROR;} }
+#line 1771 "bs.parser.cpp"
     break;
 
-  case 22:
-/* Line 1792 of yacc.c  */
-#line 288 "bs.y"
-    { BS_GlobalBuilder->StartNewFrame(); }
+  case 23: /* while_keyword: K_WHILE  */
+#line 290 "bs.y"
+                        { BS_GlobalBuilder->StartNewFrame(); }
+#line 1777 "bs.parser.cpp"
     break;
 
-  case 23:
-/* Line 1792 of yacc.c  */
-#line 291 "bs.y"
-    { BS_GlobalBuilder->StartNewFrame(); }
+  case 24: /* for_keyword: K_FOR  */
+#line 293 "bs.y"
+                    { BS_GlobalBuilder->StartNewFrame(); }
+#line 1783 "bs.parser.cpp"
     break;
 
-  case 24:
-/* Line 1792 of yacc.c  */
-#line 295 "bs.y"
-    {
-                        (yyval.vStmtIfElse) = (yyvsp[(1) - (7)].vStmtIfElse);
-                        BS_CHECKLIST((yyvsp[(1) - (7)].vStmtIfElse));
-                        Pegasus::BlockScript::Ast::StmtIfElse* tail = (yyvsp[(1) - (7)].vStmtIfElse);
+  case 25: /* stmt_else_if_tail: stmt_else_if_tail else_if_keyword K_L_PAREN exp if_begin_scope stmt_list K_R_BRAC  */
+#line 297 "bs.y"
+                    {
+                        (yyval.vStmtIfElse) = (yyvsp[-6].vStmtIfElse);
+                        BS_CHECKLIST((yyvsp[-6].vStmtIfElse));
+                        Pegasus::BlockScript::Ast::StmtIfElse* tail = (yyvsp[-6].vStmtIfElse);
                         while (tail->GetTail() != nullptr)
                         {
                             tail = tail->GetTail();
                         }
                         
                         tail->SetTail(
-                            BS_GlobalBuilder->BuildStmtIfElse((yyvsp[(4) - (7)].vExp), (yyvsp[(6) - (7)].vStmtList), nullptr, (yyvsp[(5) - (7)].vFrameInfo))
+                            BS_GlobalBuilder->BuildStmtIfElse((yyvsp[-3].vExp), (yyvsp[-1].vStmtList), nullptr, (yyvsp[-2].vFrameInfo))
                         ); 
                     }
+#line 1801 "bs.parser.cpp"
     break;
 
-  case 25:
-/* Line 1792 of yacc.c  */
-#line 309 "bs.y"
-    {
-                        (yyval.vStmtIfElse) = BS_GlobalBuilder->BuildStmtIfElse((yyvsp[(3) - (6)].vExp), (yyvsp[(5) - (6)].vStmtList), nullptr, (yyvsp[(4) - (6)].vFrameInfo));
+  case 26: /* stmt_else_if_tail: else_if_keyword K_L_PAREN exp if_begin_scope stmt_list K_R_BRAC  */
+#line 311 "bs.y"
+                   {
+                        (yyval.vStmtIfElse) = BS_GlobalBuilder->BuildStmtIfElse((yyvsp[-3].vExp), (yyvsp[-1].vStmtList), nullptr, (yyvsp[-2].vFrameInfo));
                    }
+#line 1809 "bs.parser.cpp"
     break;
 
-  case 26:
-/* Line 1792 of yacc.c  */
-#line 312 "bs.y"
-    { (yyval.vStmtIfElse) = nullptr; }
+  case 27: /* stmt_else_if_tail: %empty  */
+#line 314 "bs.y"
+                              { (yyval.vStmtIfElse) = nullptr; }
+#line 1815 "bs.parser.cpp"
     break;
 
-  case 27:
-/* Line 1792 of yacc.c  */
-#line 315 "bs.y"
-    { //pop previous frame
+  case 28: /* else_if_keyword: K_ELSE_IF  */
+#line 317 "bs.y"
+                            { //pop previous frame
                               BS_GlobalBuilder->PopFrame();  
                             }
+#line 1823 "bs.parser.cpp"
     break;
 
-  case 28:
-/* Line 1792 of yacc.c  */
-#line 320 "bs.y"
-    {BS_BUILD((yyval.vStmtFunDec), BuildStmtFunDec((yyvsp[(4) - (5)].vArgList), (yyvsp[(1) - (5)].vTypeDesc), (yyvsp[(2) - (5)].identifierText)));}
+  case 29: /* fun_declaration: fun_type IDENTIFIER K_L_PAREN arg_list K_R_PAREN  */
+#line 322 "bs.y"
+                                                                    {BS_BUILD((yyval.vStmtFunDec), BuildStmtFunDec((yyvsp[-1].vArgList), (yyvsp[-4].vTypeDesc), (yyvsp[-3].identifierText)));}
+#line 1829 "bs.parser.cpp"
     break;
 
-  case 29:
-/* Line 1792 of yacc.c  */
-#line 323 "bs.y"
-    { BS_BUILD((yyval.vStmtIfElse), BuildStmtIfElse(nullptr, (yyvsp[(3) - (4)].vStmtList), nullptr, (yyvsp[(1) - (4)].vFrameInfo))); }
+  case 30: /* stmt_else_tail: else_keyword K_L_BRAC stmt_list K_R_BRAC  */
+#line 325 "bs.y"
+                                                          { BS_BUILD((yyval.vStmtIfElse), BuildStmtIfElse(nullptr, (yyvsp[-1].vStmtList), nullptr, (yyvsp[-3].vFrameInfo))); }
+#line 1835 "bs.parser.cpp"
     break;
 
-  case 30:
-/* Line 1792 of yacc.c  */
-#line 324 "bs.y"
-    { (yyval.vStmtIfElse) = nullptr; }
+  case 31: /* stmt_else_tail: %empty  */
+#line 326 "bs.y"
+                              { (yyval.vStmtIfElse) = nullptr; }
+#line 1841 "bs.parser.cpp"
     break;
 
-  case 31:
-/* Line 1792 of yacc.c  */
-#line 327 "bs.y"
-    { BS_GlobalBuilder->PopFrame(); BS_BUILD((yyval.vFrameInfo), StartNewFrame()); }
+  case 32: /* else_keyword: K_ELSE  */
+#line 329 "bs.y"
+                       { BS_GlobalBuilder->PopFrame(); BS_BUILD((yyval.vFrameInfo), StartNewFrame()); }
+#line 1847 "bs.parser.cpp"
     break;
 
-  case 32:
-/* Line 1792 of yacc.c  */
-#line 330 "bs.y"
-    {
+  case 33: /* enum_list: enum_list K_COMMA IDENTIFIER  */
+#line 332 "bs.y"
+                                         {
                 Pegasus::BlockScript::EnumNode* enumNode = BS_GlobalBuilder->GetSymbolTable()->NewEnumNode(); 
-                enumNode->mIdd = (yyvsp[(3) - (3)].identifierText);
-                Pegasus::BlockScript::EnumNode* tailList = (yyvsp[(1) - (3)].vEnumNode);
+                enumNode->mIdd = (yyvsp[0].identifierText);
+                Pegasus::BlockScript::EnumNode* tailList = (yyvsp[-2].vEnumNode);
                 while (tailList->mNext != nullptr) { tailList = tailList->mNext; }
                 tailList->mNext = enumNode;
                 enumNode->mGuid = tailList->mGuid + 1; 
-                (yyval.vEnumNode) = (yyvsp[(1) - (3)].vEnumNode);
+                (yyval.vEnumNode) = (yyvsp[-2].vEnumNode);
           }
+#line 1861 "bs.parser.cpp"
     break;
 
-  case 33:
-/* Line 1792 of yacc.c  */
-#line 339 "bs.y"
-    {
+  case 34: /* enum_list: IDENTIFIER  */
+#line 341 "bs.y"
+                       {
                 Pegasus::BlockScript::EnumNode* enumNode = BS_GlobalBuilder->GetSymbolTable()->NewEnumNode(); 
-                enumNode->mIdd = (yyvsp[(1) - (1)].identifierText);
+                enumNode->mIdd = (yyvsp[0].identifierText);
                 (yyval.vEnumNode) = enumNode;
           }
+#line 1871 "bs.parser.cpp"
     break;
 
-  case 34:
-/* Line 1792 of yacc.c  */
-#line 346 "bs.y"
-    { (yyval.vStmtList) = (yyvsp[(2) - (3)].vStmtList); }
+  case 35: /* fun_stmt_list: K_L_BRAC stmt_list K_R_BRAC  */
+#line 348 "bs.y"
+                                            { (yyval.vStmtList) = (yyvsp[-1].vStmtList); }
+#line 1877 "bs.parser.cpp"
     break;
 
-  case 35:
-/* Line 1792 of yacc.c  */
-#line 347 "bs.y"
-    { (yyval.vStmtList) = nullptr; }
+  case 36: /* fun_stmt_list: K_SEMICOLON  */
+#line 349 "bs.y"
+                            { (yyval.vStmtList) = nullptr; }
+#line 1883 "bs.parser.cpp"
     break;
 
-  case 36:
-/* Line 1792 of yacc.c  */
-#line 350 "bs.y"
-    { BS_BUILD((yyval.vExp), BuildImmInt((yyvsp[(1) - (1)].integerValue))); }
+  case 37: /* immediate: I_INT  */
+#line 352 "bs.y"
+                    { BS_BUILD((yyval.vExp), BuildImmInt((yyvsp[0].integerValue))); }
+#line 1889 "bs.parser.cpp"
     break;
 
-  case 37:
-/* Line 1792 of yacc.c  */
-#line 351 "bs.y"
-    { BS_BUILD((yyval.vExp), BuildImmFloat((yyvsp[(1) - (1)].floatValue))); }
+  case 38: /* immediate: I_FLOAT  */
+#line 353 "bs.y"
+                    { BS_BUILD((yyval.vExp), BuildImmFloat((yyvsp[0].floatValue))); }
+#line 1895 "bs.parser.cpp"
     break;
 
-  case 38:
-/* Line 1792 of yacc.c  */
-#line 353 "bs.y"
-    {
+  case 39: /* immediate: K_SIZE_OF K_L_PAREN type_desc K_R_PAREN  */
+#line 355 "bs.y"
+          {
             //figure out size at compile time!
-            BS_BUILD((yyval.vExp), BuildImmInt((yyvsp[(3) - (4)].vTypeDesc)->GetByteSize()));
+            BS_BUILD((yyval.vExp), BuildImmInt((yyvsp[-1].vTypeDesc)->GetByteSize()));
           }
+#line 1904 "bs.parser.cpp"
     break;
 
-  case 39:
-/* Line 1792 of yacc.c  */
-#line 359 "bs.y"
-    {
-                (yyval.vExpList) = (yyvsp[(1) - (3)].vExpList);
-                BS_CHECKLIST((yyvsp[(1) - (3)].vExpList));
+  case 40: /* exp_list: exp_list K_COMMA exp  */
+#line 361 "bs.y"
+                                {
+                (yyval.vExpList) = (yyvsp[-2].vExpList);
+                BS_CHECKLIST((yyvsp[-2].vExpList));
                 ExpList* newList = BS_GlobalBuilder->CreateExpList(); 
-                newList->SetExp((yyvsp[(3) - (3)].vExp));
-                ExpList* tailTraversal = (yyvsp[(1) - (3)].vExpList);
+                newList->SetExp((yyvsp[0].vExp));
+                ExpList* tailTraversal = (yyvsp[-2].vExpList);
                 while (tailTraversal->GetTail() != nullptr) { tailTraversal = tailTraversal->GetTail(); }
                 tailTraversal->SetTail(newList);
          }
+#line 1918 "bs.parser.cpp"
     break;
 
-  case 40:
-/* Line 1792 of yacc.c  */
-#line 368 "bs.y"
-    { (yyval.vExpList) = BS_GlobalBuilder->CreateExpList(); (yyval.vExpList)->SetExp((yyvsp[(1) - (1)].vExp)); }
-    break;
-
-  case 41:
-/* Line 1792 of yacc.c  */
-#line 369 "bs.y"
-    { (yyval.vExpList) = BS_GlobalBuilder->CreateExpList(); }
+  case 41: /* exp_list: exp  */
+#line 370 "bs.y"
+               { (yyval.vExpList) = BS_GlobalBuilder->CreateExpList(); (yyval.vExpList)->SetExp((yyvsp[0].vExp)); }
+#line 1924 "bs.parser.cpp"
     break;
 
-  case 42:
-/* Line 1792 of yacc.c  */
-#line 372 "bs.y"
-    { BS_BUILD((yyval.vExp), BuildIdd((yyvsp[(1) - (1)].identifierText))); }
+  case 42: /* exp_list: %empty  */
+#line 371 "bs.y"
+                      { (yyval.vExpList) = BS_GlobalBuilder->CreateExpList(); }
+#line 1930 "bs.parser.cpp"
     break;
 
-  case 43:
-/* Line 1792 of yacc.c  */
-#line 375 "bs.y"
-    { (yyval.vExp) = (yyvsp[(1) - (1)].vExp); }
+  case 43: /* ident: IDENTIFIER  */
+#line 374 "bs.y"
+                     { BS_BUILD((yyval.vExp), BuildIdd((yyvsp[0].identifierText))); }
+#line 1936 "bs.parser.cpp"
     break;
 
-  case 44:
-/* Line 1792 of yacc.c  */
-#line 376 "bs.y"
-    { BS_BUILD((yyval.vExp), BuildFunCall((yyvsp[(3) - (4)].vExpList), (yyvsp[(1) - (4)].identifierText))); }
-    break;
-
-  case 45:
-/* Line 1792 of yacc.c  */
+  case 44: /* exp: ident  */
 #line 377 "bs.y"
-    { BS_BUILD((yyval.vExp), BuildFunCall((yyvsp[(3) - (4)].vExpList), (yyvsp[(1) - (4)].identifierText))); }
+                 { (yyval.vExp) = (yyvsp[0].vExp); }
+#line 1942 "bs.parser.cpp"
     break;
 
-  case 46:
-/* Line 1792 of yacc.c  */
+  case 45: /* exp: IDENTIFIER K_L_PAREN exp_list K_R_PAREN  */
 #line 378 "bs.y"
-    { BS_BUILD((yyval.vExp), BuildStaticArrayDec((yyvsp[(3) - (4)].vTypeDesc))); }
+                                                       { BS_BUILD((yyval.vExp), BuildFunCall((yyvsp[-1].vExpList), (yyvsp[-3].identifierText))); }
+#line 1948 "bs.parser.cpp"
     break;
 
-  case 47:
-/* Line 1792 of yacc.c  */
+  case 46: /* exp: TYPE_IDENTIFIER K_L_PAREN exp_list K_R_PAREN  */
 #line 379 "bs.y"
-    { BS_BUILD((yyval.vExp), BuildStrImm((yyvsp[(1) - (1)].identifierText))); }
+                                                       { BS_BUILD((yyval.vExp), BuildFunCall((yyvsp[-1].vExpList), (yyvsp[-3].identifierText))); }
+#line 1954 "bs.parser.cpp"
     break;
 
-  case 48:
-/* Line 1792 of yacc.c  */
+  case 47: /* exp: K_STATIC_ARRAY O_LT type_desc O_GT  */
 #line 380 "bs.y"
-    { (yyval.vExp) = (yyvsp[(1) - (1)].vExp); }
+                                              { BS_BUILD((yyval.vExp), BuildStaticArrayDec((yyvsp[-1].vTypeDesc))); }
+#line 1960 "bs.parser.cpp"
     break;
 
-  case 49:
-/* Line 1792 of yacc.c  */
+  case 48: /* exp: I_STRING  */
 #line 381 "bs.y"
-    { BS_BUILD((yyval.vExp), BuildUnop((yyvsp[(1) - (2)].token), (yyvsp[(2) - (2)].vExp))); }
+                   { BS_BUILD((yyval.vExp), BuildStrImm((yyvsp[0].identifierText))); }
+#line 1966 "bs.parser.cpp"
     break;
 
-  case 50:
-/* Line 1792 of yacc.c  */
+  case 49: /* exp: immediate  */
 #line 382 "bs.y"
-    { BS_BUILD((yyval.vExp), BuildUnop((yyvsp[(1) - (2)].token), (yyvsp[(2) - (2)].vExp))); }
+                    { (yyval.vExp) = (yyvsp[0].vExp); }
+#line 1972 "bs.parser.cpp"
     break;
 
-  case 51:
-/* Line 1792 of yacc.c  */
+  case 50: /* exp: O_INC exp  */
 #line 383 "bs.y"
-    { BS_BUILD((yyval.vExp), BuildMethodCall((yyvsp[(1) - (6)].vExp), (yyvsp[(3) - (6)].identifierText), (yyvsp[(5) - (6)].vExpList))); }
+                    { BS_BUILD((yyval.vExp), BuildUnop((yyvsp[-1].token), (yyvsp[0].vExp))); }
+#line 1978 "bs.parser.cpp"
     break;
 
-  case 52:
-/* Line 1792 of yacc.c  */
+  case 51: /* exp: O_DEC exp  */
 #line 384 "bs.y"
-    { BS_BUILD((yyval.vExp), BuildMethodCall((yyvsp[(1) - (6)].vExp), (yyvsp[(3) - (6)].identifierText), (yyvsp[(5) - (6)].vExpList))); }
+                    { BS_BUILD((yyval.vExp), BuildUnop((yyvsp[-1].token), (yyvsp[0].vExp))); }
+#line 1984 "bs.parser.cpp"
     break;
 
-  case 53:
-/* Line 1792 of yacc.c  */
+  case 52: /* exp: exp O_METHOD_CALL IDENTIFIER K_L_PAREN exp_list K_R_PAREN  */
 #line 385 "bs.y"
-    { BS_BUILD((yyval.vExp), BuildBinop((yyvsp[(1) - (3)].vExp), (yyvsp[(2) - (3)].token), (yyvsp[(3) - (3)].vExp))); }
+                                                                    { BS_BUILD((yyval.vExp), BuildMethodCall((yyvsp[-5].vExp), (yyvsp[-3].identifierText), (yyvsp[-1].vExpList))); }
+#line 1990 "bs.parser.cpp"
     break;
 
-  case 54:
-/* Line 1792 of yacc.c  */
+  case 53: /* exp: exp O_METHOD_CALL TYPE_IDENTIFIER K_L_PAREN exp_list K_R_PAREN  */
 #line 386 "bs.y"
-    { BS_BUILD((yyval.vExp), BuildBinop((yyvsp[(1) - (3)].vExp), (yyvsp[(2) - (3)].token), (yyvsp[(3) - (3)].vExp))); }
+                                                                         { BS_BUILD((yyval.vExp), BuildMethodCall((yyvsp[-5].vExp), (yyvsp[-3].identifierText), (yyvsp[-1].vExpList))); }
+#line 1996 "bs.parser.cpp"
     break;
 
-  case 55:
-/* Line 1792 of yacc.c  */
+  case 54: /* exp: exp O_SET exp  */
 #line 387 "bs.y"
-    { BS_BUILD((yyval.vExp), BuildBinop((yyvsp[(1) - (3)].vExp), (yyvsp[(2) - (3)].token), (yyvsp[(3) - (3)].vExp))); }
+                           { BS_BUILD((yyval.vExp), BuildBinop((yyvsp[-2].vExp), (yyvsp[-1].token), (yyvsp[0].vExp))); }
+#line 2002 "bs.parser.cpp"
     break;
 
-  case 56:
-/* Line 1792 of yacc.c  */
+  case 55: /* exp: exp O_PLUS exp  */
 #line 388 "bs.y"
-    { BS_BUILD((yyval.vExp), BuildBinop((yyvsp[(1) - (3)].vExp), (yyvsp[(2) - (3)].token), (yyvsp[(3) - (3)].vExp))); }
+                           { BS_BUILD((yyval.vExp), BuildBinop((yyvsp[-2].vExp), (yyvsp[-1].token), (yyvsp[0].vExp))); }
+#line 2008 "bs.parser.cpp"
     break;
 
-  case 57:
-/* Line 1792 of yacc.c  */
+  case 56: /* exp: exp O_MINUS exp  */
 #line 389 "bs.y"
-    { BS_BUILD((yyval.vExp), BuildBinop((yyvsp[(1) - (3)].vExp), (yyvsp[(2) - (3)].token), (yyvsp[(3) - (3)].vExp))); }
+                           { BS_BUILD((yyval.vExp), BuildBinop((yyvsp[-2].vExp), (yyvsp[-1].token), (yyvsp[0].vExp))); }
+#line 2014 "bs.parser.cpp"
     break;
 
-  case 58:
-/* Line 1792 of yacc.c  */
+  case 57: /* exp: exp O_MUL exp  */
 #line 390 "bs.y"
-    { BS_BUILD((yyval.vExp), BuildBinop((yyvsp[(1) - (3)].vExp), (yyvsp[(2) - (3)].token), (yyvsp[(3) - (3)].vExp))); }
+                           { BS_BUILD((yyval.vExp), BuildBinop((yyvsp[-2].vExp), (yyvsp[-1].token), (yyvsp[0].vExp))); }
+#line 2020 "bs.parser.cpp"
     break;
 
-  case 59:
-/* Line 1792 of yacc.c  */
+  case 58: /* exp: exp O_DIV exp  */
 #line 391 "bs.y"
-    { BS_BUILD((yyval.vExp), BuildBinop((yyvsp[(1) - (3)].vExp), (yyvsp[(2) - (3)].token), (yyvsp[(3) - (3)].vExp))); }
+                           { BS_BUILD((yyval.vExp), BuildBinop((yyvsp[-2].vExp), (yyvsp[-1].token), (yyvsp[0].vExp))); }
+#line 2026 "bs.parser.cpp"
     break;
 
-  case 60:
-/* Line 1792 of yacc.c  */
+  case 59: /* exp: exp O_MOD exp  */
 #line 392 "bs.y"
-    { BS_BUILD((yyval.vExp), BuildBinop((yyvsp[(1) - (3)].vExp), (yyvsp[(2) - (3)].token), (yyvsp[(3) - (3)].vExp))); }
+                           { BS_BUILD((yyval.vExp), BuildBinop((yyvsp[-2].vExp), (yyvsp[-1].token), (yyvsp[0].vExp))); }
+#line 2032 "bs.parser.cpp"
     break;
 
-  case 61:
-/* Line 1792 of yacc.c  */
+  case 60: /* exp: exp O_EQ exp  */
 #line 393 "bs.y"
-    { BS_BUILD((yyval.vExp), BuildBinop((yyvsp[(1) - (3)].vExp), (yyvsp[(2) - (3)].token), (yyvsp[(3) - (3)].vExp))); }
+                             { BS_BUILD((yyval.vExp), BuildBinop((yyvsp[-2].vExp), (yyvsp[-1].token), (yyvsp[0].vExp))); }
+#line 2038 "bs.parser.cpp"
     break;
 
-  case 62:
-/* Line 1792 of yacc.c  */
+  case 61: /* exp: exp O_NEQ exp  */
 #line 394 "bs.y"
-    { BS_BUILD((yyval.vExp), BuildBinop((yyvsp[(1) - (3)].vExp), (yyvsp[(2) - (3)].token), (yyvsp[(3) - (3)].vExp))); }
+                              { BS_BUILD((yyval.vExp), BuildBinop((yyvsp[-2].vExp), (yyvsp[-1].token), (yyvsp[0].vExp))); }
+#line 2044 "bs.parser.cpp"
     break;
 
-  case 63:
-/* Line 1792 of yacc.c  */
+  case 62: /* exp: exp O_LAND exp  */
 #line 395 "bs.y"
-    { BS_BUILD((yyval.vExp), BuildBinop((yyvsp[(1) - (3)].vExp), (yyvsp[(2) - (3)].token), (yyvsp[(3) - (3)].vExp))); }
+                             { BS_BUILD((yyval.vExp), BuildBinop((yyvsp[-2].vExp), (yyvsp[-1].token), (yyvsp[0].vExp))); }
+#line 2050 "bs.parser.cpp"
     break;
 
-  case 64:
-/* Line 1792 of yacc.c  */
+  case 63: /* exp: exp O_LOR exp  */
 #line 396 "bs.y"
-    { BS_BUILD((yyval.vExp), BuildBinop((yyvsp[(1) - (3)].vExp), (yyvsp[(2) - (3)].token), (yyvsp[(3) - (3)].vExp))); }
+                             { BS_BUILD((yyval.vExp), BuildBinop((yyvsp[-2].vExp), (yyvsp[-1].token), (yyvsp[0].vExp))); }
+#line 2056 "bs.parser.cpp"
     break;
 
-  case 65:
-/* Line 1792 of yacc.c  */
+  case 64: /* exp: exp O_LT exp  */
 #line 397 "bs.y"
-    { BS_BUILD((yyval.vExp), BuildBinop((yyvsp[(1) - (3)].vExp), (yyvsp[(2) - (3)].token), (yyvsp[(3) - (3)].vExp))); }
+                             { BS_BUILD((yyval.vExp), BuildBinop((yyvsp[-2].vExp), (yyvsp[-1].token), (yyvsp[0].vExp))); }
+#line 2062 "bs.parser.cpp"
     break;
 
-  case 66:
-/* Line 1792 of yacc.c  */
+  case 65: /* exp: exp O_GT exp  */
 #line 398 "bs.y"
-    { BS_BUILD((yyval.vExp), BuildBinop((yyvsp[(1) - (3)].vExp), (yyvsp[(2) - (3)].token), (yyvsp[(3) - (3)].vExp))); }
+                             { BS_BUILD((yyval.vExp), BuildBinop((yyvsp[-2].vExp), (yyvsp[-1].token), (yyvsp[0].vExp))); }
+#line 2068 "bs.parser.cpp"
     break;
 
-  case 67:
-/* Line 1792 of yacc.c  */
+  case 66: /* exp: exp O_LTE exp  */
 #line 399 "bs.y"
-    { BS_BUILD((yyval.vExp), BuildBinop((yyvsp[(1) - (3)].vExp), (yyvsp[(2) - (3)].token), (yyvsp[(3) - (3)].vExp))); }
+                           { BS_BUILD((yyval.vExp), BuildBinop((yyvsp[-2].vExp), (yyvsp[-1].token), (yyvsp[0].vExp))); }
+#line 2074 "bs.parser.cpp"
     break;
 
-  case 68:
-/* Line 1792 of yacc.c  */
+  case 67: /* exp: exp O_GTE exp  */
 #line 400 "bs.y"
-    { BS_BUILD((yyval.vExp), BuildBinop((yyvsp[(1) - (4)].vExp), O_ACCESS, (yyvsp[(3) - (4)].vExp))); }
+                           { BS_BUILD((yyval.vExp), BuildBinop((yyvsp[-2].vExp), (yyvsp[-1].token), (yyvsp[0].vExp))); }
+#line 2080 "bs.parser.cpp"
     break;
 
-  case 69:
-/* Line 1792 of yacc.c  */
+  case 68: /* exp: exp O_DOT ident  */
 #line 401 "bs.y"
-    { BS_BUILD((yyval.vExp), BuildUnop((yyvsp[(1) - (2)].token), (yyvsp[(2) - (2)].vExp))); }
+                             { BS_BUILD((yyval.vExp), BuildBinop((yyvsp[-2].vExp), (yyvsp[-1].token), (yyvsp[0].vExp))); }
+#line 2086 "bs.parser.cpp"
     break;
 
-  case 70:
-/* Line 1792 of yacc.c  */
+  case 69: /* exp: exp K_L_LACE exp K_R_LACE  */
 #line 402 "bs.y"
-    { BS_BUILD((yyval.vExp), BuildExplicitCast((yyvsp[(4) - (4)].vExp), (yyvsp[(2) - (4)].vTypeDesc))); }
+                                                      { BS_BUILD((yyval.vExp), BuildBinop((yyvsp[-3].vExp), O_ACCESS, (yyvsp[-1].vExp))); }
+#line 2092 "bs.parser.cpp"
     break;
 
-  case 71:
-/* Line 1792 of yacc.c  */
+  case 70: /* exp: O_MINUS exp  */
 #line 403 "bs.y"
-    { (yyval.vExp) = (yyvsp[(2) - (3)].vExp); }
+                                  { BS_BUILD((yyval.vExp), BuildUnop((yyvsp[-1].token), (yyvsp[0].vExp))); }
+#line 2098 "bs.parser.cpp"
     break;
 
-  case 72:
-/* Line 1792 of yacc.c  */
+  case 71: /* exp: K_L_PAREN type_desc K_R_PAREN exp  */
 #line 404 "bs.y"
-    { BS_BUILD((yyval.vExp), BuildUnopPost((yyvsp[(1) - (2)].vExp), (yyvsp[(2) - (2)].token))); }
+                                                         { BS_BUILD((yyval.vExp), BuildExplicitCast((yyvsp[0].vExp), (yyvsp[-2].vTypeDesc))); }
+#line 2104 "bs.parser.cpp"
     break;
 
-  case 73:
-/* Line 1792 of yacc.c  */
+  case 72: /* exp: K_L_PAREN exp K_R_PAREN  */
 #line 405 "bs.y"
-    { BS_BUILD((yyval.vExp), BuildUnopPost((yyvsp[(1) - (2)].vExp), (yyvsp[(2) - (2)].token))); }
+                                  { (yyval.vExp) = (yyvsp[-1].vExp); }
+#line 2110 "bs.parser.cpp"
     break;
 
-  case 74:
-/* Line 1792 of yacc.c  */
-#line 408 "bs.y"
-    { (yyval.vExp) = nullptr; }
+  case 73: /* exp: exp O_INC  */
+#line 406 "bs.y"
+                    { BS_BUILD((yyval.vExp), BuildUnopPost((yyvsp[-1].vExp), (yyvsp[0].token))); }
+#line 2116 "bs.parser.cpp"
     break;
 
-  case 75:
-/* Line 1792 of yacc.c  */
-#line 409 "bs.y"
-    { (yyval.vExp) = (yyvsp[(1) - (1)].vExp); }
+  case 74: /* exp: exp O_DEC  */
+#line 407 "bs.y"
+                    { BS_BUILD((yyval.vExp), BuildUnopPost((yyvsp[-1].vExp), (yyvsp[0].token))); }
+#line 2122 "bs.parser.cpp"
     break;
 
-  case 76:
-/* Line 1792 of yacc.c  */
-#line 412 "bs.y"
-    {
-                (yyval.vArgList) = (yyvsp[(1) - (3)].vArgList);
-                BS_CHECKLIST((yyvsp[(1) - (3)].vArgList));
+  case 75: /* optional_exp: %empty  */
+#line 410 "bs.y"
+               { (yyval.vExp) = nullptr; }
+#line 2128 "bs.parser.cpp"
+    break;
+
+  case 76: /* optional_exp: exp  */
+#line 411 "bs.y"
+                   { (yyval.vExp) = (yyvsp[0].vExp); }
+#line 2134 "bs.parser.cpp"
+    break;
+
+  case 77: /* arg_list: arg_list K_COMMA arg_dec  */
+#line 414 "bs.y"
+                                    {
+                (yyval.vArgList) = (yyvsp[-2].vArgList);
+                BS_CHECKLIST((yyvsp[-2].vArgList));
                 ArgList* newList = BS_GlobalBuilder->CreateArgList(); 
-                newList->SetArgDec((yyvsp[(3) - (3)].vArgDec));
-                ArgList* tailTraversal = (yyvsp[(1) - (3)].vArgList);
+                newList->SetArgDec((yyvsp[0].vArgDec));
+                ArgList* tailTraversal = (yyvsp[-2].vArgList);
                 while (tailTraversal->GetTail() != nullptr) { tailTraversal = tailTraversal->GetTail(); }
                 tailTraversal->SetTail(newList);
          }
+#line 2148 "bs.parser.cpp"
     break;
 
-  case 77:
-/* Line 1792 of yacc.c  */
-#line 421 "bs.y"
-    { (yyval.vArgList) = BS_GlobalBuilder->CreateArgList(); (yyval.vArgList)->SetArgDec((yyvsp[(1) - (1)].vArgDec)); }
+  case 78: /* arg_list: arg_dec  */
+#line 423 "bs.y"
+                   { (yyval.vArgList) = BS_GlobalBuilder->CreateArgList(); (yyval.vArgList)->SetArgDec((yyvsp[0].vArgDec)); }
+#line 2154 "bs.parser.cpp"
     break;
 
-  case 78:
-/* Line 1792 of yacc.c  */
-#line 422 "bs.y"
-    { (yyval.vArgList) = BS_GlobalBuilder->CreateArgList(); }
+  case 79: /* arg_list: %empty  */
+#line 424 "bs.y"
+                       { (yyval.vArgList) = BS_GlobalBuilder->CreateArgList(); }
+#line 2160 "bs.parser.cpp"
     break;
 
-  case 79:
-/* Line 1792 of yacc.c  */
-#line 425 "bs.y"
-    { 
+  case 80: /* type_desc: type_desc K_L_LACE I_INT K_R_LACE  */
+#line 427 "bs.y"
+                                              { 
 				Pegasus::BlockScript::TypeDesc* resultType = nullptr;
-				if ((yyvsp[(1) - (4)].vTypeDesc)->GetModifier() != Pegasus::BlockScript::TypeDesc::M_ARRAY)
+				if ((yyvsp[-3].vTypeDesc)->GetModifier() != Pegasus::BlockScript::TypeDesc::M_ARRAY)
 				{
-					(yyvsp[(1) - (4)].vTypeDesc)->ComputeSize();
+					(yyvsp[-3].vTypeDesc)->ComputeSize();
 					resultType = BS_GlobalBuilder->GetSymbolTable()->CreateArrayType(
-					    (yyvsp[(1) - (4)].vTypeDesc)->GetName(), //name
-					    (yyvsp[(1) - (4)].vTypeDesc),  // child type
-					    (yyvsp[(3) - (4)].integerValue)   //array count
+					    (yyvsp[-3].vTypeDesc)->GetName(), //name
+					    (yyvsp[-3].vTypeDesc),  // child type
+					    (yyvsp[-1].integerValue)   //array count
 					);
 				}        
 				else
 				{
-					Pegasus::BlockScript::TypeDesc* target = (yyvsp[(1) - (4)].vTypeDesc);
+					Pegasus::BlockScript::TypeDesc* target = (yyvsp[-3].vTypeDesc);
 					while (target->GetChild()->GetModifier() == Pegasus::BlockScript::TypeDesc::M_ARRAY)
 					{
 						target = target->GetChild();
 					}
 					Pegasus::BlockScript::TypeDesc* tmp = target->GetChild();
 					resultType = BS_GlobalBuilder->GetSymbolTable()->CreateArrayType(
-						(yyvsp[(1) - (4)].vTypeDesc)->GetName(),
+						(yyvsp[-3].vTypeDesc)->GetName(),
 						tmp,
-						(yyvsp[(3) - (4)].integerValue)
+						(yyvsp[-1].integerValue)
 					);
 					target->SetChild(resultType);
-                    resultType = (yyvsp[(1) - (4)].vTypeDesc);
-					(yyvsp[(1) - (4)].vTypeDesc)->ComputeSize();
+                    resultType = (yyvsp[-3].vTypeDesc);
+					(yyvsp[-3].vTypeDesc)->ComputeSize();
 				}
                 
                 if (resultType != nullptr)
@@ -2390,13 +2200,13 @@ yyreduce:
                     YYERROR;
                 }
               }
+#line 2204 "bs.parser.cpp"
     break;
 
-  case 80:
-/* Line 1792 of yacc.c  */
-#line 464 "bs.y"
-    {                
-                TypeDesc* typeDesc = BS_GlobalBuilder->GetTypeByName((yyvsp[(1) - (1)].identifierText));
+  case 81: /* type_desc: TYPE_IDENTIFIER  */
+#line 466 "bs.y"
+                              {                
+                TypeDesc* typeDesc = BS_GlobalBuilder->GetTypeByName((yyvsp[0].identifierText));
                 if (typeDesc != nullptr)
                 {
 					typeDesc->ComputeSize();
@@ -2408,43 +2218,44 @@ yyreduce:
                     YYERROR;
                 }
             }
+#line 2222 "bs.parser.cpp"
     break;
 
-  case 81:
-/* Line 1792 of yacc.c  */
-#line 479 "bs.y"
-    {
-                (yyval.vArgList) = (yyvsp[(1) - (3)].vArgList);
-                BS_CHECKLIST((yyvsp[(1) - (3)].vArgList));
+  case 82: /* struct_def_list: struct_def_list arg_dec K_SEMICOLON  */
+#line 481 "bs.y"
+                                                     {
+                (yyval.vArgList) = (yyvsp[-2].vArgList);
+                BS_CHECKLIST((yyvsp[-2].vArgList));
                 ArgList* newList = BS_GlobalBuilder->CreateArgList(); 
-                newList->SetArgDec((yyvsp[(2) - (3)].vArgDec));
-                ArgList* tailTraversal = (yyvsp[(1) - (3)].vArgList);
+                newList->SetArgDec((yyvsp[-1].vArgDec));
+                ArgList* tailTraversal = (yyvsp[-2].vArgList);
                 while (tailTraversal->GetTail() != nullptr) { tailTraversal = tailTraversal->GetTail(); }
                 tailTraversal->SetTail(newList);
          }
+#line 2236 "bs.parser.cpp"
     break;
 
-  case 82:
-/* Line 1792 of yacc.c  */
-#line 488 "bs.y"
-    { (yyval.vArgList) = BS_GlobalBuilder->CreateArgList(); (yyval.vArgList)->SetArgDec((yyvsp[(1) - (2)].vArgDec)); }
+  case 83: /* struct_def_list: arg_dec K_SEMICOLON  */
+#line 490 "bs.y"
+                               { (yyval.vArgList) = BS_GlobalBuilder->CreateArgList(); (yyval.vArgList)->SetArgDec((yyvsp[-1].vArgDec)); }
+#line 2242 "bs.parser.cpp"
     break;
 
-  case 83:
-/* Line 1792 of yacc.c  */
-#line 489 "bs.y"
-    { (yyval.vArgList) = BS_GlobalBuilder->CreateArgList(); }
+  case 84: /* struct_def_list: %empty  */
+#line 491 "bs.y"
+                       { (yyval.vArgList) = BS_GlobalBuilder->CreateArgList(); }
+#line 2248 "bs.parser.cpp"
     break;
 
-  case 84:
-/* Line 1792 of yacc.c  */
-#line 492 "bs.y"
-    { BS_BUILD((yyval.vArgDec), BuildArgDec((yyvsp[(1) - (3)].identifierText), (yyvsp[(3) - (3)].vTypeDesc))); }
+  case 85: /* arg_dec: IDENTIFIER K_COL type_desc  */
+#line 494 "bs.y"
+                                     { BS_BUILD((yyval.vArgDec), BuildArgDec((yyvsp[-2].identifierText), (yyvsp[0].vTypeDesc))); }
+#line 2254 "bs.parser.cpp"
     break;
 
 
-/* Line 1792 of yacc.c  */
-#line 2448 "bs.parser.cpp"
+#line 2258 "bs.parser.cpp"
+
       default: break;
     }
   /* User semantic actions sometimes alter yychar, and that requires
@@ -2458,96 +2269,58 @@ yyreduce:
      case of YYERROR or YYBACKUP, subsequent parser actions might lead
      to an incorrect destructor call or verbose syntax error message
      before the lookahead is translated.  */
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
 
-  /* Now `shift' the result of the reduction.  Determine what state
+  /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
 
-/*------------------------------------.
-| yyerrlab -- here on detecting error |
-`------------------------------------*/
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
 yyerrlab:
   /* Make sure we have latest lookahead translation.  See comments at
      user semantic actions for why this is necessary.  */
-  yytoken = yychar == YYEMPTY ? YYEMPTY : YYTRANSLATE (yychar);
-
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
       yyerror (scanner, YY_("syntax error"));
-#else
-# define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
-                                        yyssp, yytoken)
-      {
-        char const *yymsgp = YY_("syntax error");
-        int yysyntax_error_status;
-        yysyntax_error_status = YYSYNTAX_ERROR;
-        if (yysyntax_error_status == 0)
-          yymsgp = yymsg;
-        else if (yysyntax_error_status == 1)
-          {
-            if (yymsg != yymsgbuf)
-              YYSTACK_FREE (yymsg);
-            yymsg = (char *) YYSTACK_ALLOC (yymsg_alloc);
-            if (!yymsg)
-              {
-                yymsg = yymsgbuf;
-                yymsg_alloc = sizeof yymsgbuf;
-                yysyntax_error_status = 2;
-              }
-            else
-              {
-                yysyntax_error_status = YYSYNTAX_ERROR;
-                yymsgp = yymsg;
-              }
-          }
-        yyerror (scanner, yymsgp);
-        if (yysyntax_error_status == 2)
-          goto yyexhaustedlab;
-      }
-# undef YYSYNTAX_ERROR
-#endif
     }
 
-
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
-	 error, discard it.  */
+         error, discard it.  */
 
       if (yychar <= YYEOF)
-	{
-	  /* Return failure if at end of input.  */
-	  if (yychar == YYEOF)
-	    YYABORT;
-	}
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
       else
-	{
-	  yydestruct ("Error: discarding",
-		      yytoken, &yylval, scanner);
-	  yychar = YYEMPTY;
-	}
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval, scanner);
+          yychar = YYEMPTY;
+        }
     }
 
   /* Else will try to reuse lookahead token after shifting the error
@@ -2559,14 +2332,13 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
-
-  /* Do not reclaim the symbols of the rule which action triggered
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
   YYPOPSTACK (yylen);
   yylen = 0;
@@ -2579,29 +2351,30 @@ yyerrorlab:
 | yyerrlab1 -- common code for both syntax error and YYERROR.  |
 `-------------------------------------------------------------*/
 yyerrlab1:
-  yyerrstatus = 3;	/* Each real token shifted decrements this.  */
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
       if (!yypact_value_is_default (yyn))
-	{
-	  yyn += YYTERROR;
-	  if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
-	    {
-	      yyn = yytable[yyn];
-	      if (0 < yyn)
-		break;
-	    }
-	}
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
 
       /* Pop the current state because it cannot handle the error token.  */
       if (yyssp == yyss)
-	YYABORT;
+        YYABORT;
 
 
       yydestruct ("Error: popping",
-		  yystos[yystate], yyvsp, scanner);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, scanner);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -2613,7 +2386,7 @@ yyerrlab1:
 
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -2624,26 +2397,30 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
-#if !defined yyoverflow || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
   yyerror (scanner, YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
+
 
-yyreturn:
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
@@ -2652,31 +2429,25 @@ yyreturn:
       yydestruct ("Cleanup: discarding lookahead",
                   yytoken, &yylval, scanner);
     }
-  /* Do not reclaim the symbols of the rule which action triggered
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
   YYPOPSTACK (yylen);
   YY_STACK_PRINT (yyss, yyssp);
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-		  yystos[*yyssp], yyvsp, scanner);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, scanner);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
-  if (yymsg != yymsgbuf)
-    YYSTACK_FREE (yymsg);
-#endif
-  /* Make sure YYID is used.  */
-  return YYID (yyresult);
-}
 
+  return yyresult;
+}
 
-/* Line 2055 of yacc.c  */
-#line 495 "bs.y"
+#line 497 "bs.y"
          
 
 //***************************************************//
@@ -2686,12 +2457,13 @@ yyreturn:
 extern void BS_restart(FILE* f);
 
 
-void Bison_BlockScriptParse(const FileBuffer* fileBuffer, BlockScriptBuilder* builder, IFileIncluder* fileIncluder, Container<Preprocessor::Definition>* defList) 
+void Bison_BlockScriptParse(const FileBuffer* fileBuffer, BlockScriptBuilder* builder, IFileIncluder* fileIncluder, Container<Preprocessor::Definition>* defList, PrecompiledHeaderCache* headerCache, Container<Preprocessor::Definition>* outDefList) 
 {          
     CompilerState compilerState(builder->GetAllocator());
     compilerState.mBuilder = builder;
     compilerState.mFileBuffer = fileBuffer;
     compilerState.GetPreprocessor().SetFileIncluder(fileIncluder);
+    compilerState.GetPreprocessor().SetHeaderCache(headerCache, builder->GetSymbolTable());
 
     //add definitions pre-added
     if (defList != nullptr)
@@ -2715,5 +2487,15 @@ void Bison_BlockScriptParse(const FileBuffer* fileBuffer, BlockScriptBuilder* bu
     BS_restart(nullptr, scanner);
     BS_lex_destroy(scanner);
 
+    //return the definitions made by the source
+    if (outDefList != nullptr)
+    {
+        int firstDef = defList != nullptr ? defList->Size() : 0;
+        for (int i = firstDef; i < compilerState.GetPreprocessor().GetDefinitionCount(); ++i)
+        {
+            outDefList->PushEmpty() = compilerState.GetPreprocessor().GetDefinition(i);
+        }
+    }
+
 }
 
@@ -80,14 +80,14 @@
     //***************************************************//
 %}
 
-// expect 172 reduce/shift warnings due to grammar ambiguity
-%expect 172
+// expect 180 reduce/shift warnings due to grammar ambiguity
+%expect 180
 
 %union {
     int    token;
     int    integerValue;
     float  floatValue;
-    char*  identifierText;
+    const char*  identifierText;
     Pegasus::BlockScript::StackFrameInfo*      vFrameInfo;
     Pegasus::BlockScript::TypeDesc*            vTypeDesc;
     Pegasus::BlockScript::EnumNode*            vEnumNode;
@@ -143,6 +143,7 @@
 %token <token> O_METHOD_CALL
 %token <token> O_IMPLICIT_CAST
 %token <token> O_EXPLICIT_CAST
+%token <token> K_YIELD
 %type <vFrameInfo> if_begin_scope
 %type <vFrameInfo> else_keyword
 %type <vFrameInfo> struct_keyword 
@@ -221,6 +222,7 @@ stmt    : exp K_SEMICOLON { BS_BUILD($$, BuildStmtExp($1)); }
                 }
           }
         | K_RETURN exp K_SEMICOLON { BS_BUILD($$, BuildStmtReturn($2)); }
+        | K_YIELD K_SEMICOLON { BS_BUILD($$, BuildStmtYield()); }
         | fun_declaration fun_stmt_list  {BS_BUILD($$, BindFunImplementation($1, $2));}
         | while_keyword K_L_PAREN exp K_R_PAREN K_L_BRAC stmt_list K_R_BRAC 
         { 
@@ -501,12 +503,13 @@ arg_dec : IDENTIFIER K_COL type_desc { BS_BUILD($$, BuildArgDec($1, $3)); }
 extern void BS_restart(FILE* f);
 
 
-void Bison_BlockScriptParse(const FileBuffer* fileBuffer, BlockScriptBuilder* builder, IFileIncluder* fileIncluder, Container<Preprocessor::Definition>* defList) 
+void Bison_BlockScriptParse(const FileBuffer* fileBuffer, BlockScriptBuilder* builder, IFileIncluder* fileIncluder, Container<Preprocessor::Definition>* defList, PrecompiledHeaderCache* headerCache, Container<Preprocessor::Definition>* outDefList) 
 {          
     CompilerState compilerState(builder->GetAllocator());
     compilerState.mBuilder = builder;
     compilerState.mFileBuffer = fileBuffer;
     compilerState.GetPreprocessor().SetFileIncluder(fileIncluder);
+    compilerState.GetPreprocessor().SetHeaderCache(headerCache, builder->GetSymbolTable());
 
     //add definitions pre-added
     if (defList != nullptr)
@@ -530,5 +533,15 @@ void Bison_BlockScriptParse(const FileBuffer* fileBuffer, BlockScriptBuilder* bu
     BS_restart(nullptr, scanner);
     BS_lex_destroy(scanner);
 
+    //return the definitions made by the source
+    if (outDefList != nullptr)
+    {
+        int firstDef = defList != nullptr ? defList->Size() : 0;
+        for (int i = firstDef; i < compilerState.GetPreprocessor().GetDefinitionCount(); ++i)
+        {
+            outDefList->PushEmpty() = compilerState.GetPreprocessor().GetDefinition(i);
+        }
+    }
+
 }
 
@@ -9,6 +9,7 @@
 
 #include "Pegasus/BlockScript/BlockScriptAst.h"
 #include "Pegasus/BlockScript/BlockScript.h"
+#include "Pegasus/BlockScript/AssemblyCache.h"
 #include "Pegasus/BlockScript/FunCallback.h"
 #include "Pegasus/BlockScript/PrettyPrint.h"
 #include "Pegasus/Core/Io.h"
@@ -16,15 +17,21 @@
 #include "Pegasus/Core/Shared/LogChannel.h"
 #include "Pegasus/Core/Log.h"
 #include "Pegasus/Core/Assertion.h"
+#include "Pegasus/Utils/String.h"
 #include "Pegasus/BlockScript/Container.h"
 #include "Pegasus/BlockScript/BlockScriptManager.h"
 #include "Pegasus/BlockScript/EventListeners.h"
+#include "Pegasus/BlockScript/BsProfiler.h"
+#include "Pegasus/BlockScript/AotGenerator.h"
 #include <stdio.h>
 
 using namespace Pegasus::Io;
 using namespace Pegasus::Memory;
 using namespace Pegasus::Core;
 
+//maximum number of scripts translated into one c++ file
+#define CLI_MAX_FILES 256
+
 class CompilerEventListener : public Pegasus::BlockScript::IBlockScriptCompilerListener
 {
 public:
@@ -82,13 +89,26 @@ public:
     bool printAst;
     bool runScript;
     bool requestHelp;
-    char* fileToParse;
+    Pegasus::BlockScript::Optimizer::Level optimizationLevel;
+    Pegasus::BlockScript::AssemblyCache::Policy cachePolicy;
+    char* cacheDirectory;
+    char* profileFile;
+    char* aotFile;
+    char* aotTable;
+    char* filesToParse[CLI_MAX_FILES];
+    int fileCount;
     Options() : 
         printAssembly(false),
         printAst(false),
         runScript(true),
         requestHelp(false),
-        fileToParse(nullptr)
+        optimizationLevel(Pegasus::BlockScript::Optimizer::LEVEL_FULL),
+        cachePolicy(Pegasus::BlockScript::AssemblyCache::POLICY_DISABLED),
+        cacheDirectory(nullptr),
+        profileFile(nullptr),
+        aotFile(nullptr),
+        aotTable(nullptr),
+        fileCount(0)
     {
     }
 };
@@ -121,21 +141,43 @@ bool ParseCommandLineOptions(char** argv, int argc, Options& output)
             {
                 output.requestHelp = true;
             }
+            else if (candidate[1] == 'O' && candidate[2] >= '0' && candidate[2] <= '2' && candidate[3] == '\0')
+            {
+                output.optimizationLevel = static_cast<Pegasus::BlockScript::Optimizer::Level>(candidate[2] - '0');
+            }
+            else if ((candidate[1] == 'c' || candidate[1] == 'l') && i + 1 < argc)
+            {
+                output.cachePolicy = candidate[1] == 'c'
+                                   ? Pegasus::BlockScript::AssemblyCache::POLICY_WRITE_ONLY
+                                   : Pegasus::BlockScript::AssemblyCache::POLICY_READ_ONLY;
+                output.cacheDirectory = argv[++i];
+            }
+            else if (candidate[1] == 'p' && i + 1 < argc)
+            {
+                output.profileFile = argv[++i];
+            }
+            else if (candidate[1] == 'x' && i + 2 < argc)
+            {
+                output.aotFile = argv[++i];
+                output.aotTable = argv[++i];
+            }
             else
             {
                 return false;
             }
         }
-        else if (output.fileToParse == nullptr)
+        else if (output.fileCount < CLI_MAX_FILES)
         {
-            output.fileToParse = candidate;
+            output.filesToParse[output.fileCount++] = candidate;
         }
         else
         {
             return false;
         }
     }
-    return true;
+
+    //only the translation takes several scripts
+    return output.requestHelp || output.fileCount == 1 || (output.aotFile != nullptr && output.fileCount > 0);
 }
 
 void printHelp()
@@ -146,13 +188,110 @@ void printHelp()
     printf("#########  by Kleber Garcia (c) 2014 ##############\n");
     printf("---------------------------------------------------\n\n");
     printf("usage: BlockScriptCLI.exe <bs_script> [<options>]\n");
+    printf("       BlockScriptCLI.exe <bs_script> [<bs_script>...] -x <cpp_file> <table> [-O<level>]\n");
     printf("Available options:\n");
     printf("-h print this help menu.\n");
-    printf("-a print assembly.\n");
+    printf("-a print assembly, before and after optimization.\n");
     printf("-t print the abstract syntax tree.\n");
     printf("-n Do not attempt to run the program.\n");
+    printf("-O<level> optimization level: 0 none, 1 constant folding, 2 full (default).\n");
+    printf("-c <dir> compile and write the assembly blob of the script to the cache directory.\n");
+    printf("-l <dir> load the assembly blob from the cache directory, compiles if the blob is out of date.\n");
+    printf("-p <file> profile the run: prints a flat profile of functions and lines, and writes the collapsed call stacks (flame graph input) to file.\n");
+    printf("-x <cpp_file> <table> translate the scripts to c++ ahead of time, into a table of AotScript to register on the BlockScriptManager.\n");
+}
+
+void printProfile(Pegasus::BlockScript::BsProfiler& profiler, const char* stackFile)
+{
+    profiler.BuildReport();
+    printf("\n----------------- PROFILE -------------------\n");
+    printf("%llu instructions, %d samples, %.3f ms\n\n", profiler.GetInstructionCount(), profiler.GetSampleCount(), 1000.0 * profiler.GetTotalTime());
+
+    printf("%10s %10s %10s %14s  %s\n", "self ms", "total ms", "calls", "instructions", "function");
+    for (int i = 0; i < profiler.GetFunctionCount(); ++i)
+    {
+        const Pegasus::BlockScript::BsProfiler::FunctionEntry& f = profiler.GetFunction(i);
+        printf("%10.3f %10.3f %10llu %14llu  %s\n", 1000.0 * f.mSelfTime, 1000.0 * f.mTotalTime, f.mCalls, f.mInstructions, f.mName);
+    }
+
+    printf("\n%10s %14s %6s  %s\n", "ms", "instructions", "line", "function");
+    for (int i = 0; i < profiler.GetLineCount(); ++i)
+    {
+        const Pegasus::BlockScript::BsProfiler::LineEntry& l = profiler.GetLine(i);
+        printf("%10.3f %14llu %6d  %s\n", 1000.0 * l.mTime, l.mInstructions, l.mLine, l.mName);
+    }
+
+    //one line per stack: frames separated by ';', then the weight in microseconds
+    FILE* file = nullptr;
+    fopen_s(&file, stackFile, "w");
+    if (file == nullptr)
+    {
+        printf("could not write the call stacks to %s\n", stackFile);
+        return;
+    }
+    for (int i = 0; i < profiler.GetStackCount(); ++i)
+    {
+        const Pegasus::BlockScript::BsProfiler::StackEntry& stack = profiler.GetStack(i);
+        for (int f = 0; f < stack.mDepth; ++f)
+        {
+            fprintf(file, f == 0 ? "%s" : ";%s", profiler.GetFunctionName(stack.mFrames[f]));
+        }
+        long long us = static_cast<long long>(1000000.0 * stack.mTime + 0.5);
+        fprintf(file, " %lld\n", us > 0 ? us : 1);
+    }
+    fclose(file);
+    printf("\ncall stacks written to %s\n", stackFile);
 }
 
+//file receiving the c++ of the scripts translated
+FILE* gAotFile = nullptr;
+
+int printaot(const char* s)
+{
+    return fputs(s, gAotFile);
+}
+
+int translateScripts(const Options& opts, IOManager& mgr, Pegasus::BlockScript::BlockScriptManager& bsManager)
+{
+    fopen_s(&gAotFile, opts.aotFile, "w");
+    if (gAotFile == nullptr)
+    {
+        printf("could not write the translated scripts to %s\n", opts.aotFile);
+        return -1;
+    }
+
+    int result = 0;
+    Pegasus::BlockScript::AotGenerator generator(GetGlobalAllocator(), printaot);
+    generator.BeginFile();
+    for (int i = 0; i < opts.fileCount; ++i)
+    {
+        FileBuffer fb;
+        IoError err = mgr.OpenFileToBuffer(opts.filesToParse[i], fb, true, GetGlobalAllocator());
+        if (err != ERR_NONE)
+        {
+            printf("could not open %s\n", opts.filesToParse[i]);
+            result = -1;
+            continue;
+        }
+
+        Pegasus::BlockScript::BlockScript* bs = bsManager.CreateBlockScript();
+        bs->AddCompilerEventListener(&gCompilerEventListener);
+        bs->SetTitle(opts.filesToParse[i]);
+        bs->SetOptimizationLevel(opts.optimizationLevel);
+        if (!bs->Compile(&fb) || !generator.Translate(bs->GetAsm(), opts.filesToParse[i]))
+        {
+            printf("could not translate %s\n", opts.filesToParse[i]);
+            result = -1;
+        }
+        bs->Reset();
+        bsManager.DestroyBlockScript(bs);
+    }
+    generator.EndFile(opts.aotTable);
+    fclose(gAotFile);
+    gAotFile = nullptr;
+    printf("%d scripts translated to %s\n", generator.GetScriptCount(), opts.aotFile);
+    return result;
+}
 
 int main(int argc, char* argv[])
 {
@@ -179,10 +318,14 @@ int main(int argc, char* argv[])
         {
             printHelp();
         }
+        else if (opts.aotFile != nullptr)
+        {
+            return translateScripts(opts, mgr, bsManager);
+        }
         else
         {
             err = mgr.OpenFileToBuffer(
-                argv[1],
+                opts.filesToParse[0],
                 fb,
                 true,
                 GetGlobalAllocator()    
@@ -193,7 +336,49 @@ int main(int argc, char* argv[])
             {
                 Pegasus::BlockScript::BlockScript* bs = bsManager.CreateBlockScript();
                 bs->AddCompilerEventListener(&gCompilerEventListener);
+                bs->SetTitle(opts.filesToParse[0]);
+                Pegasus::BlockScript::PrettyPrint pp(printstr, printint, printfloat);
+
+                if (opts.printAssembly && opts.optimizationLevel != Pegasus::BlockScript::Optimizer::LEVEL_NONE)
+                {
+                    //compile once without optimizations to show what the optimizer removed
+                    bs->SetOptimizationLevel(Pegasus::BlockScript::Optimizer::LEVEL_NONE);
+                    if (bs->Compile(&fb))
+                    {
+                        printf("\n----------------- ASM (unoptimized) -------------------\n");
+                        pp.PrintAsm(bs->GetAsm());
+                        printf("\n");
+                    }
+                    bs->Reset();
+                }
+
+                //the cache directory must end with a path separator
+                char cacheDirectory[IOManager::MAX_FILEPATH_LENGTH];
+                cacheDirectory[0] = '\0';
+                if (opts.cacheDirectory != nullptr && Pegasus::Utils::Strlen(opts.cacheDirectory) + 2 < static_cast<int>(IOManager::MAX_FILEPATH_LENGTH))
+                {
+                    Pegasus::Utils::Strcat(cacheDirectory, opts.cacheDirectory);
+                    char last = cacheDirectory[Pegasus::Utils::Strlen(cacheDirectory) - 1];
+                    if (last != '/' && last != '\\')
+                    {
+                        Pegasus::Utils::Strcat(cacheDirectory, "/");
+                    }
+                }
+                Pegasus::BlockScript::AssemblyCache cache(GetGlobalAllocator(), cacheDirectory);
+                cache.SetPolicy(opts.cachePolicy);
+                bs->SetAssemblyCache(&cache);
+
+                bs->SetOptimizationLevel(opts.optimizationLevel);
                 bool res = bs->Compile(&fb);
+
+                if (opts.cachePolicy == Pegasus::BlockScript::AssemblyCache::POLICY_WRITE_ONLY)
+                {
+                    printf(cache.GetStoreCount() > 0 ? "assembly written to %s\n" : "assembly could not be cached in %s\n", cache.GetDirectory());
+                }
+                else if (opts.cachePolicy == Pegasus::BlockScript::AssemblyCache::POLICY_READ_ONLY)
+                {
+                    printf(bs->IsAsmFromCache() ? "assembly loaded from %s\n" : "assembly compiled, no valid blob in %s\n", cache.GetDirectory());
+                }
 	
                 if (!res)
                 {
@@ -207,24 +392,30 @@ int main(int argc, char* argv[])
                     Pegasus::BlockScript::SystemCallbacks::gPrintIntCallback = printint;
                     Pegasus::BlockScript::SystemCallbacks::gPrintFloatCallback = printfloat;
 
-                    Pegasus::BlockScript::PrettyPrint pp(printstr, printint, printfloat);
-                    if (opts.printAst)
+                    if (opts.printAst && bs->GetAst() != nullptr)
                     {
                         printf("----------------- SRC -------------------\n");
 		    		    pp.Print(bs->GetAst());
                         printf("\n");
                     }
 
-                    if (opts.printAssembly)
+                    if (opts.printAssembly && bs->GetAsm().mBlocks != nullptr)
                     {
-                        printf("\n----------------- ASM -------------------\n");
+                        printf("\n----------------- ASM (optimization level %d) -------------------\n", opts.optimizationLevel);
                         pp.PrintAsm(bs->GetAsm());
                         printf("\n");
                     }
 
                     if (opts.runScript)
                     {
+                        Pegasus::BlockScript::BsProfiler profiler(GetGlobalAllocator());
+                        vmState.SetProfiler(opts.profileFile != nullptr ? &profiler : nullptr);
                         bs->Run(&vmState);
+                        vmState.SetProfiler(nullptr);
+                        if (opts.profileFile != nullptr)
+                        {
+                            printProfile(profiler, opts.profileFile);
+                        }
                     }
                 }
 		    	
@@ -0,0 +1,30 @@
+rem Block Script ahead of time translation of the test scripts
+rem \author agent
+rem \notes custom build step of BlockScriptTests, runs after BlockScriptCLI is built. Translates the test scripts
+rem        into the c++ table gTestAotScripts, compiled with the tests.
+rem        usage: GenAotScripts.bat <BlockScriptCLI executable> <output cpp file> <scripts in the Tests folder...>
+
+@echo off
+echo ###################################################
+echo ###### Block Script Test AOT Generator Script ######
+echo ###################################################
+
+set TESTS=%~dp0Tests
+set CLI=%~1
+set OUTPUT=%~f2
+set SCRIPTS=
+shift
+shift
+
+:nextscript
+if "%~1"=="" goto translate
+set SCRIPTS=%SCRIPTS% %~1
+shift
+goto nextscript
+
+:translate
+pushd "%TESTS%"
+"%CLI%" %SCRIPTS% -O2 -x "%OUTPUT%" gTestAotScripts
+set RESULT=%ERRORLEVEL%
+popd
+exit /b %RESULT%
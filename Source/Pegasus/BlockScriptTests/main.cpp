@@ -13,6 +13,8 @@
 #include "Pegasus/BlockScript/PrettyPrint.h"
 #include "Pegasus/Utils/ByteStream.h"
 #include "Pegasus/Utils/String.h"
+#include "Pegasus/Utils/Memset.h"
+#include "Pegasus/Utils/Memcpy.h"
 #include "Pegasus/Core/Io.h"
 #include "Pegasus/Memory/MemoryManager.h"
 #include "Pegasus/Core/Shared/LogChannel.h"
@@ -20,10 +22,21 @@
 #include "Pegasus/Core/Assertion.h"
 #include "Pegasus/BlockScript/Container.h"
 #include "Pegasus/BlockScript/BlockScriptManager.h"
+#include "Pegasus/BlockScript/BlockLib.h"
+#include "Pegasus/BlockScript/BsProfiler.h"
+#include "Pegasus/BlockScript/BsAot.h"
+#include "Pegasus/BlockScript/BsJit.h"
+#include "Pegasus/BlockScript/BsVmSnapshot.h"
+#include "Pegasus/BlockScript/IFileIncluder.h"
+#include "Pegasus/BlockScript/PrecompiledHeader.h"
+#include "Pegasus/Core/Time.h"
 
+#include <windows.h>
+#include <stdlib.h>
 #include <sstream>
 #include <string>
 #include <iostream>
+#include <atomic>
 
 using namespace std;
 using namespace Pegasus::Io;
@@ -33,17 +46,47 @@ using namespace Pegasus::BlockScript;
 using namespace Pegasus::Utils;
 
 bool gUseCout = false;
-ByteStream* gSs;
+
+//output stream of the print callbacks. Thread local so scripts running concurrently get their own output.
+thread_local ByteStream* gSs;
 
 #define DEFAULT_ROOT "../../../../Source/Pegasus/BlockScriptTests/Tests/"
 
+//number of times each thread runs a script during the concurrency stress test
+#define STRESS_TEST_RUNS_PER_THREAD 16
+
+//maximum number of threads of the stress test, limited by WaitForMultipleObjects
+#define STRESS_TEST_MAX_THREADS 64
+
+//size of the library registered by the compile benchmark, in the order of the render api
+#define COMPILE_BENCH_FUNCTIONS 512
+#define COMPILE_BENCH_CLASSES   64
+#define COMPILE_BENCH_ENUMS     32
+#define COMPILE_BENCH_ENUM_VALUES 8
+#define COMPILE_BENCH_NAME_LENGTH 32
+
+//number of copies of every test script compiled by the parallel compile test, so a batch holds over 50 scripts
+#define PARALLEL_COMPILE_COPIES 5
+
+//number of scripts sharing a manager compiled by the header test, as many as the scripts of TestApp1
+#define HEADER_TEST_SCRIPTS 12
+
+//capacity of the output of a few calls to Tick() compared by the snapshot test
+#define SNAPSHOT_TEST_OUTPUT_SIZE 256
+
 struct CmdLineOptions
 {
     bool mPrintHelp;
     bool mDisableCR;
+    int  mBenchmarkIterations;
+    int  mCompileBenchmarkIterations;
+    int  mStressThreads;
+    int  mCompileThreads;
+    int  mHeaderTestIterations;
+    bool mHotReloadTest;
     const char* mSingleScript;
     const char* mRootFolder;
-    CmdLineOptions() : mPrintHelp(false), mDisableCR(false), mSingleScript(nullptr), mRootFolder(nullptr) 
+    CmdLineOptions() : mPrintHelp(false), mDisableCR(false), mBenchmarkIterations(0), mCompileBenchmarkIterations(0), mStressThreads(0), mCompileThreads(0), mHeaderTestIterations(0), mHotReloadTest(false), mSingleScript(nullptr), mRootFolder(nullptr) 
     {
     }
 
@@ -56,6 +99,12 @@ void PrintHelp()
     cout << "-s Single script test, followed by the target script" << std::endl;
     cout << "-r Root folder to load scripts. Default is hard coded as" << DEFAULT_ROOT << std::endl;
     cout << "-c Disable carriage return, flat new lines." << std::endl;
+    cout << "-b Benchmark, followed by the number of runs per script. Compares the canonical tree, the bytecode and the ahead of time translated backends." << std::endl;
+    cout << "-m Compile benchmark, followed by the number of compilations per script. Compiles with and without a library the size of the render api." << std::endl;
+    cout << "-t Concurrency stress test, followed by the number of threads. Every thread runs the same compiled script on its own vm state." << std::endl;
+    cout << "-p Parallel compile test, followed by the number of threads. Compiles a batch of scripts sharing a manager serially, then concurrently, and checks their outputs." << std::endl;
+    cout << "-i Precompiled header test, followed by the number of batches. Compiles batches of scripts including the same headers, with and without precompiled headers, and checks their outputs." << std::endl;
+    cout << "-l Hot reload test. Recompiles scripts with edited functions or globals, and checks which states keep running on the new code." << std::endl;
     
 }
 
@@ -83,6 +132,46 @@ bool ParseCmdLine(int argc, const char** argv, CmdLineOptions& outCmdLine)
                 ++i;
                 outCmdLine.mDisableCR = true;
             }
+            else if (argv[i][1] == 'b')
+            {
+                if (i == argc - 1) return false;
+                ++i;
+                outCmdLine.mBenchmarkIterations = atoi(argv[i]);
+                ++i;
+            }
+            else if (argv[i][1] == 'm')
+            {
+                if (i == argc - 1) return false;
+                ++i;
+                outCmdLine.mCompileBenchmarkIterations = atoi(argv[i]);
+                ++i;
+            }
+            else if (argv[i][1] == 't')
+            {
+                if (i == argc - 1) return false;
+                ++i;
+                outCmdLine.mStressThreads = atoi(argv[i]);
+                ++i;
+            }
+            else if (argv[i][1] == 'p')
+            {
+                if (i == argc - 1) return false;
+                ++i;
+                outCmdLine.mCompileThreads = atoi(argv[i]);
+                ++i;
+            }
+            else if (argv[i][1] == 'i')
+            {
+                if (i == argc - 1) return false;
+                ++i;
+                outCmdLine.mHeaderTestIterations = atoi(argv[i]);
+                ++i;
+            }
+            else if (argv[i][1] == 'l')
+            {
+                ++i;
+                outCmdLine.mHotReloadTest = true;
+            }
             else if (argv[i][1] == 'r')
             {
                 if (i == argc - 1) return false;
@@ -112,7 +201,56 @@ const struct TestScript { const char* script; const char* output; } gTestScripts
     { "Branching.bs",      "OutputBranching.txt" },    
     { "Loops.bs",          "OutputLoops.txt" },
     { "2dArray.bs",        "Output2dArray.txt" },
-    { "Math.bs",           "OutputMath.txt" }
+    { "Math.bs",           "OutputMath.txt" },
+    { "Scopes.bs",         "OutputScopes.txt" },
+    { "Optimizer.bs",      "OutputOptimizer.txt" },
+    { "Intrinsics.bs",     "OutputIntrinsics.txt" },
+    { "VectorMath.bs",     "OutputVectorMath.txt" },
+    { "Identifiers.bs",    "OutputIdentifiers.txt" },
+    { "RangeChecks.bs",    "OutputRangeChecks.txt" }
+};
+
+//! Test scripts translated ahead of time (O2), generated into AotScripts.cpp by GenAotScripts.bat when building the tests
+extern const AotScript gTestAotScripts[];
+extern const int gTestAotScriptsCount;
+
+//! Scripts including headers, used by the precompiled header test
+const TestScript gHeaderTestScripts[] = {
+    { "Headers.bs",        "OutputHeaders.txt" }
+};
+
+//! Scripts recompiled by the hot reload test: a script, an edit of it, the number of functions
+//! the edit changes (-1 if the globals change) and the output of a call before and after the reload
+const struct HotReloadTest { const char* script; const char* edit; int changedFunctions; const char* output; } gHotReloadTests[] = {
+    { "HotReload.bs",      "HotReloadEdit.bs",   2, "OutputHotReload.txt" },
+    { "HotReload.bs",      "HotReloadLayout.bs", -1, nullptr }
+};
+
+//! Scripts whose array accesses are counted: the number proven in range by the compiler, and the number left with a bounds check
+const struct RangeCheckTest { const char* script; int proven; int checked; } gRangeCheckTests[] = {
+    { "RangeChecks.bs",    15, 3 }
+};
+
+//! Scripts suspended by yield statements: the output, with a | echoed on every resume, and the number of yields of the global scope
+//! The function Generate(int) is then called with a budget, resumed until it returns, and called again to be cancelled
+const struct YieldTest { const char* script; const char* output; int yields; } gYieldTests[] = {
+    { "Yield.bs",          "OutputYield.txt",  3 }
+};
+
+//! Scripts snapshot in between calls to Tick(), then restored and ticked again
+const char* gSnapshotTestScripts[] = {
+    "Snapshot.bs"
+};
+
+//! Scripts only used by the benchmark, their output is not checked
+const char* gBenchmarkScripts[] = {
+    "VectorBench.bs"
+};
+
+//! Scripts whose bytecode dispatch throughput is reported by the benchmark
+const char* gDispatchBenchmarkScripts[] = {
+    "Fibonacci.bs",
+    "Loops.bs"
 };
 //
 
@@ -190,10 +328,39 @@ int printfloat(float f)
     return 0;
 }
 
-bool RunTest(IOManager& ioMgr, const char* script, const char* outputFile, bool dumpOutput = false)
+//! \return true if the output stream (null terminated) matches the answer buffer
+bool MatchesAnswer(const FileBuffer& answerBuffer, const ByteStream& output)
+{
+    bool result = answerBuffer.GetFileSize() == output.GetSize() - 1;
+    for (int i = 0; result && i < answerBuffer.GetFileSize(); ++i)
+    {
+        if (static_cast<const char*>(output.GetBuffer())[i] != answerBuffer.GetBuffer()[i])
+        {
+            result = false;
+        }
+    }
+    return result;
+}
+
+const char* GetBackendName(BsVm::Backend backend)
+{
+    switch (backend)
+    {
+    case BsVm::BACKEND_AOT: return "aot";
+    case BsVm::BACKEND_JIT: return "jit";
+    case BsVm::BACKEND_BYTECODE: return "bytecode";
+    default: return "canon";
+    }
+}
+
+bool RunTest(IOManager& ioMgr, const char* script, const char* outputFile, BsVm::Backend backend, Optimizer::Level optLevel, bool dumpOutput = false)
 {
     Pegasus::BlockScript::BlockScriptManager bsManager(GetGlobalAllocator());
+    bsManager.RegisterAotScripts(gTestAotScripts, gTestAotScriptsCount);
     Pegasus::BlockScript::BlockScript* bs = bsManager.CreateBlockScript();
+    bs->SetOptimizationLevel(optLevel);
+    //compile every function on its first call, so the jit runs all the code the interpreter would
+    bs->SetJitCallThreshold(1);
     FileBuffer filebuffer;
     IoError err = ioMgr.OpenFileToBuffer(script, filebuffer, true, GetGlobalAllocator());
     bool result = false;
@@ -202,10 +369,31 @@ bool RunTest(IOManager& ioMgr, const char* script, const char* outputFile, bool
         Pegasus::BlockScript::BsVmState vmState;
         vmState.Initialize(GetGlobalAllocator());
         bool compilerRes = bs->Compile(&filebuffer);
-        if (compilerRes)
+        if (compilerRes && backend != BsVm::BACKEND_CANON && bs->GetAsm().mBytecode == nullptr)
+        {
+            cout << "Bytecode generation failed." << std::endl;
+        }
+        else if (compilerRes && backend == BsVm::BACKEND_AOT && bs->GetAsm().mAot == nullptr)
+        {
+            cout << "No translated script matches the bytecode, rebuild BlockScriptTests to translate the test scripts again." << std::endl;
+        }
+        else if (compilerRes)
         {       
+            bs->SetVmBackend(backend);
             bs->Run(&vmState);
 
+            if (backend == BsVm::BACKEND_JIT)
+            {
+                cout << " Jit: " << bs->GetJit().GetCompiledCount() << " functions compiled, " << bs->GetJit().GetRejectedCount() << " left on the interpreter." << std::endl;
+            }
+
+            //without recursion, the stack reserved from the size computed by the compiler must be enough
+            bool stackBounded = !bs->GetAsm().mIsStackBounded || vmState.GetStackGrowCount() == 0;
+            if (!stackBounded)
+            {
+                cout << "The stack grew past the size computed by the compiler." << std::endl;
+            }
+
             char z = '\0';
             gSs->Append(&z,1);
             if (dumpOutput)
@@ -219,14 +407,7 @@ bool RunTest(IOManager& ioMgr, const char* script, const char* outputFile, bool
                 err = ioMgr.OpenFileToBuffer(outputFile, answerBuffer, true, GetGlobalAllocator());
                 if (err == Pegasus::Io::ERR_NONE)
                 {
-                    result = answerBuffer.GetFileSize() == gSs->GetSize() - 1;
-                    for (int i = 0; result && i < answerBuffer.GetFileSize(); ++i)
-                    {
-                        if (static_cast<const char*>(gSs->GetBuffer())[i] != answerBuffer.GetBuffer()[i])
-                        {
-                            result = false;
-                        }
-                    }
+                    result = MatchesAnswer(answerBuffer, *gSs) && stackBounded;
                 }
                 else
                 {
@@ -250,6 +431,846 @@ bool RunTest(IOManager& ioMgr, const char* script, const char* outputFile, bool
     
 }
 
+//! Runs a script several times on a specific backend
+//! \return the average time in milliseconds of a run, or -1 if there was an error
+double BenchmarkScript(IOManager& ioMgr, const char* script, BsVm::Backend backend, int iterations)
+{
+    Pegasus::BlockScript::BlockScriptManager bsManager(GetGlobalAllocator());
+    bsManager.RegisterAotScripts(gTestAotScripts, gTestAotScriptsCount);
+    Pegasus::BlockScript::BlockScript* bs = bsManager.CreateBlockScript();
+    FileBuffer filebuffer;
+    double result = -1.0;
+    IoError err = ioMgr.OpenFileToBuffer(script, filebuffer, true, GetGlobalAllocator());
+    if (err == Pegasus::Io::ERR_NONE && bs->Compile(&filebuffer))
+    {
+        bs->SetVmBackend(backend);
+        Pegasus::BlockScript::BsVmState vmState;
+        vmState.Initialize(GetGlobalAllocator());
+
+        UpdatePegasusTime();
+        double startTime = GetPegasusTime();
+        for (int i = 0; i < iterations; ++i)
+        {
+            bs->Run(&vmState);
+            gSs->Reset();
+        }
+        UpdatePegasusTime();
+        result = 1000.0 * (GetPegasusTime() - startTime) / static_cast<double>(iterations);
+    }
+
+    bsManager.DestroyBlockScript(bs);
+    return result;
+}
+
+//! Benchmarks a script on every backend and prints the times. Scripts without a translation run the bytecode on the aot backend.
+void BenchmarkBackends(IOManager& ioMgr, const char* script, int iterations)
+{
+    double canonTime = BenchmarkScript(ioMgr, script, BsVm::BACKEND_CANON, iterations);
+    double bytecodeTime = BenchmarkScript(ioMgr, script, BsVm::BACKEND_BYTECODE, iterations);
+    double aotTime = BenchmarkScript(ioMgr, script, BsVm::BACKEND_AOT, iterations);
+    char buff[256];
+    sprintf_s(buff, 256, " %-16s canon: %10.4f  bytecode: %10.4f  speedup: %6.2fx  aot: %10.4f  speedup: %6.2fx", 
+        script, canonTime, bytecodeTime, bytecodeTime > 0.0 ? canonTime / bytecodeTime : 0.0, aotTime, aotTime > 0.0 ? bytecodeTime / aotTime : 0.0);
+    cout << buff;
+    if (BsJit::IsAvailable())
+    {
+        //the time includes compiling the hot functions
+        double jitTime = BenchmarkScript(ioMgr, script, BsVm::BACKEND_JIT, iterations);
+        sprintf_s(buff, 256, "  jit: %10.4f  speedup: %6.2fx", jitTime, jitTime > 0.0 ? bytecodeTime / jitTime : 0.0);
+        cout << buff;
+    }
+    cout << std::endl;
+}
+
+//! Counts the instructions of a bytecode run with the profiler, then times runs without it
+//! and prints the instructions executed per second
+void BenchmarkDispatch(IOManager& ioMgr, const char* script, int iterations)
+{
+    Pegasus::BlockScript::BlockScriptManager bsManager(GetGlobalAllocator());
+    Pegasus::BlockScript::BlockScript* bs = bsManager.CreateBlockScript();
+    FileBuffer filebuffer;
+    IoError err = ioMgr.OpenFileToBuffer(script, filebuffer, true, GetGlobalAllocator());
+    if (err == Pegasus::Io::ERR_NONE && bs->Compile(&filebuffer) && bs->GetAsm().mBytecode != nullptr)
+    {
+        bs->SetVmBackend(BsVm::BACKEND_BYTECODE);
+        Pegasus::BlockScript::BsVmState vmState;
+        vmState.Initialize(GetGlobalAllocator());
+
+        BsProfiler profiler(GetGlobalAllocator());
+        vmState.SetProfiler(&profiler);
+        bs->Run(&vmState);
+        gSs->Reset();
+        vmState.SetProfiler(nullptr);
+        profiler.BuildReport();
+        double instructions = static_cast<double>(profiler.GetInstructionCount());
+        profiler.Reset();
+
+        UpdatePegasusTime();
+        double startTime = GetPegasusTime();
+        for (int i = 0; i < iterations; ++i)
+        {
+            bs->Run(&vmState);
+            gSs->Reset();
+        }
+        UpdatePegasusTime();
+        double seconds = (GetPegasusTime() - startTime) / static_cast<double>(iterations);
+
+        char buff[256];
+        sprintf_s(buff, 256, " %-16s instructions: %10.0f  per second: %10.2f M",
+            script, instructions, seconds > 0.0 ? instructions / seconds / 1000000.0 : 0.0);
+        cout << buff << std::endl;
+    }
+    else
+    {
+        cout << " " << script << ": compilation to bytecode failed." << std::endl;
+    }
+
+    bsManager.DestroyBlockScript(bs);
+}
+
+void RunBenchmark(IOManager& ioMgr, int iterations)
+{
+    cout << "Benchmark, " << iterations << " runs per script (ms per run)" << std::endl;
+    for (int i = 0; i < sizeof(gTestScripts)/sizeof(gTestScripts[0]); ++i)
+    {
+        BenchmarkBackends(ioMgr, gTestScripts[i].script, iterations);
+    }
+    for (int i = 0; i < sizeof(gBenchmarkScripts)/sizeof(gBenchmarkScripts[0]); ++i)
+    {
+        BenchmarkBackends(ioMgr, gBenchmarkScripts[i], iterations);
+    }
+
+    cout << "Bytecode dispatch, " << (BsVm::UsesComputedGoto() ? "computed goto" : "switch") << std::endl;
+    for (int i = 0; i < sizeof(gDispatchBenchmarkScripts)/sizeof(gDispatchBenchmarkScripts[0]); ++i)
+    {
+        BenchmarkDispatch(ioMgr, gDispatchBenchmarkScripts[i], iterations);
+    }
+}
+
+//! callback of the functions of the compile benchmark library, never called
+void CompileBenchCallback(FunCallbackContext& context)
+{
+}
+
+//! Registers a library in the shape of the render api: hundreds of functions, object types with methods
+//! and enumerations. The names are generated, scripts do not use them: the library is only there so every
+//! lookup of the compiler has to go through it.
+void RegisterCompileBenchLib(BlockLib* lib)
+{
+    static char sFunctionNames[COMPILE_BENCH_FUNCTIONS][COMPILE_BENCH_NAME_LENGTH];
+    static char sClassNames[COMPILE_BENCH_CLASSES][COMPILE_BENCH_NAME_LENGTH];
+    static char sMethodNames[COMPILE_BENCH_CLASSES][COMPILE_BENCH_NAME_LENGTH];
+    static char sEnumNames[COMPILE_BENCH_ENUMS][COMPILE_BENCH_NAME_LENGTH];
+    static char sEnumValueNames[COMPILE_BENCH_ENUMS][COMPILE_BENCH_ENUM_VALUES][COMPILE_BENCH_NAME_LENGTH];
+
+    ClassTypeDesc* classes = PG_NEW_ARRAY(GetGlobalAllocator(), -1, "Compile bench", Pegasus::Alloc::PG_MEM_TEMP, ClassTypeDesc, COMPILE_BENCH_CLASSES);
+    for (int c = 0; c < COMPILE_BENCH_CLASSES; ++c)
+    {
+        sprintf_s(sClassNames[c], COMPILE_BENCH_NAME_LENGTH, "BenchObject%d", c);
+        sprintf_s(sMethodNames[c], COMPILE_BENCH_NAME_LENGTH, "SetBenchInput%d", c);
+        ClassTypeDesc& desc = classes[c];
+        Memset8(&desc, 0, sizeof(desc));
+        desc.classTypeName = sClassNames[c];
+        FunctionDeclarationDesc& method = desc.methodDescriptors[0];
+        method.functionName = sMethodNames[c];
+        method.returnType = "int";
+        method.argumentTypes[0] = sClassNames[c];
+        method.argumentTypes[1] = "int";
+        method.argumentNames[0] = "this";
+        method.argumentNames[1] = "input";
+        method.callback = CompileBenchCallback;
+        desc.methodsCount = 1;
+    }
+    lib->CreateClassTypes(classes, COMPILE_BENCH_CLASSES);
+    PG_DELETE_ARRAY(GetGlobalAllocator(), classes);
+
+    EnumDeclarationDesc* enums = PG_NEW_ARRAY(GetGlobalAllocator(), -1, "Compile bench", Pegasus::Alloc::PG_MEM_TEMP, EnumDeclarationDesc, COMPILE_BENCH_ENUMS);
+    for (int e = 0; e < COMPILE_BENCH_ENUMS; ++e)
+    {
+        sprintf_s(sEnumNames[e], COMPILE_BENCH_NAME_LENGTH, "BenchEnum%d", e);
+        enums[e].typeName = sEnumNames[e];
+        for (int v = 0; v < COMPILE_BENCH_ENUM_VALUES; ++v)
+        {
+            sprintf_s(sEnumValueNames[e][v], COMPILE_BENCH_NAME_LENGTH, "BENCH_ENUM_%d_%d", e, v);
+            enums[e].enumList[v].enumName = sEnumValueNames[e][v];
+            enums[e].enumList[v].enumVal = v;
+        }
+        enums[e].count = COMPILE_BENCH_ENUM_VALUES;
+    }
+    lib->CreateEnumTypes(enums, COMPILE_BENCH_ENUMS);
+    PG_DELETE_ARRAY(GetGlobalAllocator(), enums);
+
+    //functions take the object types, so overload resolution compares signatures too
+    FunctionDeclarationDesc* functions = PG_NEW_ARRAY(GetGlobalAllocator(), -1, "Compile bench", Pegasus::Alloc::PG_MEM_TEMP, FunctionDeclarationDesc, COMPILE_BENCH_FUNCTIONS);
+    for (int f = 0; f < COMPILE_BENCH_FUNCTIONS; ++f)
+    {
+        sprintf_s(sFunctionNames[f], COMPILE_BENCH_NAME_LENGTH, "BenchFunction%d", f);
+        FunctionDeclarationDesc& desc = functions[f];
+        Memset8(&desc, 0, sizeof(desc));
+        desc.functionName = sFunctionNames[f];
+        desc.returnType = sClassNames[f % COMPILE_BENCH_CLASSES];
+        desc.argumentTypes[0] = "float4";
+        desc.argumentTypes[1] = sEnumNames[f % COMPILE_BENCH_ENUMS];
+        desc.argumentNames[0] = "value";
+        desc.argumentNames[1] = "mode";
+        desc.callback = CompileBenchCallback;
+    }
+    lib->CreateIntrinsicFunctions(functions, COMPILE_BENCH_FUNCTIONS);
+    PG_DELETE_ARRAY(GetGlobalAllocator(), functions);
+}
+
+//! Compiles a script several times
+//! \param lib an extra library to compile with, null for none
+//! \return the average time in milliseconds of a compilation, or -1 if there was an error
+double BenchmarkCompilation(IOManager& ioMgr, BlockScriptManager& bsManager, BlockLib* lib, const char* script, int iterations)
+{
+    Pegasus::BlockScript::BlockScript* bs = bsManager.CreateBlockScript();
+    if (lib != nullptr)
+    {
+        bs->IncludeLib(lib);
+    }
+    FileBuffer filebuffer;
+    double result = -1.0;
+    if (ioMgr.OpenFileToBuffer(script, filebuffer, true, GetGlobalAllocator()) == Pegasus::Io::ERR_NONE)
+    {
+        bool success = true;
+        UpdatePegasusTime();
+        double startTime = GetPegasusTime();
+        for (int i = 0; i < iterations && success; ++i)
+        {
+            bs->Reset();
+            success = bs->Compile(&filebuffer);
+        }
+        UpdatePegasusTime();
+        if (success)
+        {
+            result = 1000.0 * (GetPegasusTime() - startTime) / static_cast<double>(iterations);
+        }
+    }
+
+    bsManager.DestroyBlockScript(bs);
+    return result;
+}
+
+//! Benchmarks the compilation of a script with the runtime library only, then with the large library, and prints the times
+void BenchmarkCompilations(IOManager& ioMgr, BlockScriptManager& bsManager, BlockLib* lib, const char* script, int iterations)
+{
+    double runtimeTime = BenchmarkCompilation(ioMgr, bsManager, nullptr, script, iterations);
+    double largeTime = BenchmarkCompilation(ioMgr, bsManager, lib, script, iterations);
+    char buff[256];
+    sprintf_s(buff, 256, " %-16s runtime lib: %10.4f  large lib: %10.4f", script, runtimeTime, largeTime);
+    cout << buff << std::endl;
+}
+
+//! Benchmarks the compilation of every script, with the runtime library only and with a library the size of the render api
+void RunCompileBenchmark(IOManager& ioMgr, int iterations)
+{
+    Pegasus::BlockScript::BlockScriptManager bsManager(GetGlobalAllocator());
+    BlockLib* lib = bsManager.CreateBlockLib("CompileBench");
+    RegisterCompileBenchLib(lib);
+
+    cout << "Compile benchmark, " << iterations << " compilations per script (ms per compilation)" << std::endl;
+    for (int i = 0; i < sizeof(gTestScripts)/sizeof(gTestScripts[0]); ++i)
+    {
+        BenchmarkCompilations(ioMgr, bsManager, lib, gTestScripts[i].script, iterations);
+    }
+    for (int i = 0; i < sizeof(gBenchmarkScripts)/sizeof(gBenchmarkScripts[0]); ++i)
+    {
+        BenchmarkCompilations(ioMgr, bsManager, lib, gBenchmarkScripts[i], iterations);
+    }
+
+    bsManager.DestroyBlockLib(lib);
+}
+
+//! Job of a thread of the stress test
+struct StressTestJob
+{
+    BlockScript* mScript; //compiled script, shared by all the threads
+    const FileBuffer* mAnswer; //expected output
+    int mFailures; //number of runs that did not match the expected output
+};
+
+//! Thread body of the stress test. Runs a compiled script several times on a private vm state.
+DWORD WINAPI StressTestThread(LPVOID param)
+{
+    StressTestJob* job = static_cast<StressTestJob*>(param);
+    ByteStream ss(GetGlobalAllocator());
+    gSs = &ss;
+    for (int i = 0; i < STRESS_TEST_RUNS_PER_THREAD; ++i)
+    {
+        Pegasus::BlockScript::BsVmState vmState;
+        vmState.Initialize(GetGlobalAllocator());
+        job->mScript->Run(&vmState);
+        char z = '\0';
+        ss.Append(&z, 1);
+        job->mFailures += MatchesAnswer(*job->mAnswer, ss) ? 0 : 1;
+        ss.Reset();
+    }
+    gSs = nullptr;
+    return 0;
+}
+
+//! Runs the same compiled script concurrently on several threads, each one with its own vm state.
+//! \return true if every run produced the expected output
+bool RunStressTest(IOManager& ioMgr, const char* script, const char* outputFile, BsVm::Backend backend, int threadCount)
+{
+    Pegasus::BlockScript::BlockScriptManager bsManager(GetGlobalAllocator());
+    Pegasus::BlockScript::BlockScript* bs = bsManager.CreateBlockScript();
+    FileBuffer filebuffer;
+    FileBuffer answerBuffer;
+    bool result = false;
+    if (ioMgr.OpenFileToBuffer(script, filebuffer, true, GetGlobalAllocator()) != Pegasus::Io::ERR_NONE ||
+        ioMgr.OpenFileToBuffer(outputFile, answerBuffer, true, GetGlobalAllocator()) != Pegasus::Io::ERR_NONE)
+    {
+        cout << "Unable to open script or output file: " << script << std::endl;
+    }
+    else if (!bs->Compile(&filebuffer))
+    {
+        cout << "Compilation Error." << std::endl;
+    }
+    else
+    {
+        bs->SetVmBackend(backend);
+        bs->SetJitCallThreshold(1);
+        StressTestJob jobs[STRESS_TEST_MAX_THREADS];
+        HANDLE threads[STRESS_TEST_MAX_THREADS];
+        for (int t = 0; t < threadCount; ++t)
+        {
+            jobs[t].mScript = bs;
+            jobs[t].mAnswer = &answerBuffer;
+            jobs[t].mFailures = 0;
+            threads[t] = CreateThread(nullptr, 0, StressTestThread, &jobs[t], 0, nullptr);
+        }
+
+        WaitForMultipleObjects(threadCount, threads, TRUE, INFINITE);
+
+        int totalFailures = 0;
+        for (int t = 0; t < threadCount; ++t)
+        {
+            CloseHandle(threads[t]);
+            totalFailures += jobs[t].mFailures;
+        }
+
+        if (totalFailures > 0)
+        {
+            cout << " " << totalFailures << " out of " << threadCount * STRESS_TEST_RUNS_PER_THREAD << " runs produced a wrong output." << std::endl;
+        }
+        result = totalFailures == 0;
+    }
+
+    bsManager.DestroyBlockScript(bs);
+    return result;
+}
+
+//! Job of a thread of the parallel compile test
+struct ParallelCompileJob
+{
+    BlockScript** mScripts;  //scripts of the batch, sharing a manager
+    const FileBuffer** mSources; //source of every script
+    bool* mResults;          //compilation result of every script
+    int mCount;              //number of scripts of the batch
+    std::atomic<int>* mNext; //next script to compile
+};
+
+//! Thread body of the parallel compile test. Compiles scripts of the batch until none is left.
+DWORD WINAPI ParallelCompileThread(LPVOID param)
+{
+    ParallelCompileJob* job = static_cast<ParallelCompileJob*>(param);
+    for (int s = job->mNext->fetch_add(1); s < job->mCount; s = job->mNext->fetch_add(1))
+    {
+        job->mResults[s] = job->mScripts[s]->Compile(job->mSources[s]);
+    }
+    return 0;
+}
+
+//! Compiles a batch of scripts, serially if threadCount is 0
+//! \return the time in milliseconds of the compilation of the batch
+double CompileBatch(BlockScript** scripts, const FileBuffer** sources, bool* results, int count, int threadCount)
+{
+    UpdatePegasusTime();
+    double startTime = GetPegasusTime();
+    if (threadCount == 0)
+    {
+        for (int s = 0; s < count; ++s)
+        {
+            results[s] = scripts[s]->Compile(sources[s]);
+        }
+    }
+    else
+    {
+        std::atomic<int> next(0);
+        ParallelCompileJob job = { scripts, sources, results, count, &next };
+        HANDLE threads[STRESS_TEST_MAX_THREADS];
+        for (int t = 0; t < threadCount; ++t)
+        {
+            threads[t] = CreateThread(nullptr, 0, ParallelCompileThread, &job, 0, nullptr);
+        }
+        WaitForMultipleObjects(threadCount, threads, TRUE, INFINITE);
+        for (int t = 0; t < threadCount; ++t)
+        {
+            CloseHandle(threads[t]);
+        }
+    }
+    UpdatePegasusTime();
+    return 1000.0 * (GetPegasusTime() - startTime);
+}
+
+//! Compiles copies of every test script, all sharing a manager and a library the size of the render api,
+//! serially and then concurrently. Every script compiled concurrently is run and its output checked.
+//! \return true if every script compiled and produced the expected output
+bool RunParallelCompileTest(IOManager& ioMgr, int threadCount)
+{
+    const int scriptCount = sizeof(gTestScripts)/sizeof(gTestScripts[0]);
+    const int batchSize = scriptCount * PARALLEL_COMPILE_COPIES;
+    Pegasus::BlockScript::BlockScriptManager bsManager(GetGlobalAllocator());
+    BlockLib* lib = bsManager.CreateBlockLib("CompileBench");
+    RegisterCompileBenchLib(lib);
+
+    FileBuffer sources[sizeof(gTestScripts)/sizeof(gTestScripts[0])];
+    FileBuffer answers[sizeof(gTestScripts)/sizeof(gTestScripts[0])];
+    for (int i = 0; i < scriptCount; ++i)
+    {
+        if (ioMgr.OpenFileToBuffer(gTestScripts[i].script, sources[i], true, GetGlobalAllocator()) != Pegasus::Io::ERR_NONE ||
+            ioMgr.OpenFileToBuffer(gTestScripts[i].output, answers[i], true, GetGlobalAllocator()) != Pegasus::Io::ERR_NONE)
+        {
+            cout << "Unable to open script or output file: " << gTestScripts[i].script << std::endl;
+            bsManager.DestroyBlockLib(lib);
+            return false;
+        }
+    }
+
+    BlockScript* scripts[scriptCount * PARALLEL_COMPILE_COPIES];
+    const FileBuffer* batchSources[scriptCount * PARALLEL_COMPILE_COPIES];
+    bool results[scriptCount * PARALLEL_COMPILE_COPIES];
+    double times[2] = { 0.0, 0.0 };
+    bool result = true;
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        for (int s = 0; s < batchSize; ++s)
+        {
+            scripts[s] = bsManager.CreateBlockScript();
+            scripts[s]->IncludeLib(lib);
+            batchSources[s] = &sources[s % scriptCount];
+        }
+
+        times[pass] = CompileBatch(scripts, batchSources, results, batchSize, pass == 0 ? 0 : threadCount);
+
+        for (int s = 0; s < batchSize; ++s)
+        {
+            if (!results[s])
+            {
+                cout << " Compilation Error: " << gTestScripts[s % scriptCount].script << std::endl;
+                result = false;
+            }
+            else if (pass == 1)
+            {
+                BsVmState vmState;
+                vmState.Initialize(GetGlobalAllocator());
+                scripts[s]->Run(&vmState);
+                char z = '\0';
+                gSs->Append(&z, 1);
+                if (!MatchesAnswer(answers[s % scriptCount], *gSs))
+                {
+                    cout << " Wrong output: " << gTestScripts[s % scriptCount].script << std::endl;
+                    result = false;
+                }
+                gSs->Reset();
+            }
+            bsManager.DestroyBlockScript(scripts[s]);
+        }
+    }
+
+    char buff[256];
+    sprintf_s(buff, 256, " %d scripts, serial: %10.4f ms  %d threads: %10.4f ms  speedup: %6.2fx", batchSize, times[0], threadCount, times[1], times[0] / times[1]);
+    cout << buff << std::endl;
+
+    bsManager.DestroyBlockLib(lib);
+    return result;
+}
+
+//! Includer of the header test, opens the headers relative to the root folder of the tests
+class TestIncluder : public IFileIncluder
+{
+public:
+    explicit TestIncluder(IOManager& ioMgr) : mIoMgr(ioMgr) {}
+    virtual ~TestIncluder() {}
+
+    virtual bool Open(const char* filePath, const char** outBuffer, int& outBufferSize)
+    {
+        FileBuffer fb;
+        if (mIoMgr.OpenFileToBuffer(filePath, fb, true, GetGlobalAllocator()) != Pegasus::Io::ERR_NONE)
+        {
+            return false;
+        }
+        *outBuffer = fb.GetBuffer();
+        outBufferSize = fb.GetFileSize();
+        fb.ForgetBuffer(); //freed on Close
+        return true;
+    }
+
+    virtual void Close(const char* buffer)
+    {
+        if (buffer != nullptr)
+        {
+            PG_DELETE_ARRAY(GetGlobalAllocator(), const_cast<char*>(buffer));
+        }
+    }
+
+private:
+    IOManager& mIoMgr;
+};
+
+//! Compiles batches of scripts including the same headers, sharing a manager and a library the size of the render api.
+//! Every script compiled is run and its output checked.
+//! \param precompiledHeaders true to attach the precompiled headers, false to parse the headers on every include
+//! \return the average time in milliseconds of the compilation of a batch, -1 if a script failed
+double CompileHeaderBatches(IOManager& ioMgr, const TestScript& test, bool precompiledHeaders, int iterations)
+{
+    Pegasus::BlockScript::BlockScriptManager bsManager(GetGlobalAllocator());
+    bsManager.SetPrecompiledHeadersEnabled(precompiledHeaders);
+    BlockLib* lib = bsManager.CreateBlockLib("CompileBench");
+    RegisterCompileBenchLib(lib);
+    TestIncluder includer(ioMgr);
+
+    FileBuffer source;
+    FileBuffer answer;
+    if (ioMgr.OpenFileToBuffer(test.script, source, true, GetGlobalAllocator()) != Pegasus::Io::ERR_NONE ||
+        ioMgr.OpenFileToBuffer(test.output, answer, true, GetGlobalAllocator()) != Pegasus::Io::ERR_NONE)
+    {
+        cout << "Unable to open script or output file: " << test.script << std::endl;
+        bsManager.DestroyBlockLib(lib);
+        return -1.0;
+    }
+
+    BlockScript* scripts[HEADER_TEST_SCRIPTS];
+    bool results[HEADER_TEST_SCRIPTS];
+    const FileBuffer* sources[HEADER_TEST_SCRIPTS];
+    double totalTime = 0.0;
+    bool success = true;
+    for (int it = 0; it < iterations && success; ++it)
+    {
+        for (int s = 0; s < HEADER_TEST_SCRIPTS; ++s)
+        {
+            scripts[s] = bsManager.CreateBlockScript();
+            scripts[s]->IncludeLib(lib);
+            scripts[s]->SetFileIncluder(&includer);
+            sources[s] = &source;
+        }
+
+        totalTime += CompileBatch(scripts, sources, results, HEADER_TEST_SCRIPTS, 0);
+
+        for (int s = 0; s < HEADER_TEST_SCRIPTS; ++s)
+        {
+            if (!results[s])
+            {
+                cout << " Compilation Error: " << test.script << std::endl;
+                success = false;
+            }
+            else
+            {
+                BsVmState vmState;
+                vmState.Initialize(GetGlobalAllocator());
+                scripts[s]->Run(&vmState);
+                char z = '\0';
+                gSs->Append(&z, 1);
+                if (!MatchesAnswer(answer, *gSs))
+                {
+                    cout << " Wrong output: " << test.script << std::endl;
+                    success = false;
+                }
+                gSs->Reset();
+            }
+            bsManager.DestroyBlockScript(scripts[s]);
+        }
+    }
+
+    if (precompiledHeaders)
+    {
+        const PrecompiledHeaderCache* cache = bsManager.GetHeaderCache();
+        cout << " " << cache->GetHeaderCount() << " headers built, " << cache->GetHitCount() << " includes found in the cache" << std::endl;
+    }
+
+    bsManager.DestroyBlockLib(lib);
+    return success ? totalTime / static_cast<double>(iterations) : -1.0;
+}
+
+//! Compiles the scripts including headers with and without precompiled headers, and prints the times
+//! \return true if every script compiled and produced the expected output
+bool RunHeaderTest(IOManager& ioMgr, int iterations)
+{
+    bool result = true;
+    for (int i = 0; i < sizeof(gHeaderTestScripts)/sizeof(gHeaderTestScripts[0]); ++i)
+    {
+        double textTime = CompileHeaderBatches(ioMgr, gHeaderTestScripts[i], false, iterations);
+        double precompiledTime = CompileHeaderBatches(ioMgr, gHeaderTestScripts[i], true, iterations);
+        result = result && textTime >= 0.0 && precompiledTime >= 0.0;
+        char buff[256];
+        sprintf_s(buff, 256, " %-16s %d scripts, text headers: %10.4f ms  precompiled headers: %10.4f ms  speedup: %6.2fx",
+            gHeaderTestScripts[i].script, HEADER_TEST_SCRIPTS, textTime, precompiledTime, precompiledTime > 0.0 ? textTime / precompiledTime : 0.0);
+        cout << buff << std::endl;
+    }
+    return result;
+}
+
+//! Calls the function Tick of a hot reload test script
+bool CallTick(BlockScript* bs, BsVmState& vmState)
+{
+    FunBindPoint bindPoint = bs->GetFunctionBindPoint("Tick", nullptr, 0);
+    int output = 0;
+    return bindPoint != FUN_INVALID_BIND_POINT && bs->ExecuteFunction(&vmState, bindPoint, nullptr, 0, &output, sizeof(output));
+}
+
+//! Runs a script and calls a function, then compiles an edit of the script. If the edit only changes functions
+//! the state is rebound to the edit, the original script destroyed, and the function called again on the edit.
+//! \return true if the edit changed the expected number of functions and the outputs match
+bool RunHotReloadTest(IOManager& ioMgr, const HotReloadTest& test)
+{
+    Pegasus::BlockScript::BlockScriptManager bsManager(GetGlobalAllocator());
+    BlockScript* original = bsManager.CreateBlockScript();
+    BlockScript* edit = bsManager.CreateBlockScript();
+    FileBuffer originalSource;
+    FileBuffer editSource;
+    bool result = false;
+    if (ioMgr.OpenFileToBuffer(test.script, originalSource, true, GetGlobalAllocator()) != Pegasus::Io::ERR_NONE ||
+        ioMgr.OpenFileToBuffer(test.edit, editSource, true, GetGlobalAllocator()) != Pegasus::Io::ERR_NONE)
+    {
+        cout << " Unable to open script file: " << test.script << std::endl;
+    }
+    else if (!original->Compile(&originalSource) || !edit->Compile(&editSource))
+    {
+        cout << " Compilation Error." << std::endl;
+    }
+    else
+    {
+        BsVmState vmState;
+        vmState.Initialize(GetGlobalAllocator());
+        original->Run(&vmState);
+        result = CallTick(original, vmState);
+
+        int changed = edit->GetSignature().CountChangedFunctions(original->GetSignature());
+        cout << " " << test.edit << ": " << changed << " functions changed" << std::endl;
+        result = result && changed == test.changedFunctions;
+        if (result && changed >= 0)
+        {
+            //nothing of the original compilation can be left on the state
+            edit->RebindState(vmState, *original);
+            bsManager.DestroyBlockScript(original);
+            original = nullptr;
+            result = CallTick(edit, vmState);
+        }
+
+        char z = '\0';
+        gSs->Append(&z, 1);
+        if (result && test.output != nullptr)
+        {
+            FileBuffer answerBuffer;
+            result = ioMgr.OpenFileToBuffer(test.output, answerBuffer, true, GetGlobalAllocator()) == Pegasus::Io::ERR_NONE
+                  && MatchesAnswer(answerBuffer, *gSs);
+        }
+        gSs->Reset();
+    }
+
+    if (original != nullptr)
+    {
+        bsManager.DestroyBlockScript(original);
+    }
+    bsManager.DestroyBlockScript(edit);
+    return result;
+}
+
+//! Compiles a script and counts the array accesses the compiler proved in range
+//! \return true if the counts match the test
+bool RunRangeCheckTest(IOManager& ioMgr, const RangeCheckTest& test)
+{
+    Pegasus::BlockScript::BlockScriptManager bsManager(GetGlobalAllocator());
+    BlockScript* bs = bsManager.CreateBlockScript();
+    bs->SetOptimizationLevel(Optimizer::LEVEL_FULL);
+    FileBuffer source;
+    bool result = false;
+    if (ioMgr.OpenFileToBuffer(test.script, source, true, GetGlobalAllocator()) != Pegasus::Io::ERR_NONE)
+    {
+        cout << " Unable to open script file: " << test.script << std::endl;
+    }
+    else if (!bs->Compile(&source))
+    {
+        cout << " Compilation Error." << std::endl;
+    }
+    else
+    {
+        const Assembly assembly = bs->GetAsm();
+        int total = assembly.mProvenAccessCount + assembly.mCheckedAccessCount;
+        cout << " " << assembly.mProvenAccessCount << " of " << total << " array bounds checks removed" << std::endl;
+        result = assembly.mProvenAccessCount == test.proven && assembly.mCheckedAccessCount == test.checked;
+    }
+    bsManager.DestroyBlockScript(bs);
+    return result;
+}
+
+//! Runs a script that yields, resuming it until it is done, then calls and resumes a function with a budget of jumps
+//! \return true if the output matches and the execution got suspended where expected
+bool RunYieldTest(IOManager& ioMgr, const YieldTest& test, BsVm::Backend backend)
+{
+    Pegasus::BlockScript::BlockScriptManager bsManager(GetGlobalAllocator());
+    bsManager.RegisterAotScripts(gTestAotScripts, gTestAotScriptsCount);
+    BlockScript* bs = bsManager.CreateBlockScript();
+    bs->SetOptimizationLevel(Optimizer::LEVEL_FULL);
+    bs->SetJitCallThreshold(1);
+    FileBuffer source;
+    bool result = false;
+    if (ioMgr.OpenFileToBuffer(test.script, source, true, GetGlobalAllocator()) != Pegasus::Io::ERR_NONE)
+    {
+        cout << " Unable to open script file: " << test.script << std::endl;
+    }
+    else if (!bs->Compile(&source))
+    {
+        cout << " Compilation Error." << std::endl;
+    }
+    else if (backend == BsVm::BACKEND_AOT && bs->GetAsm().mAot == nullptr)
+    {
+        cout << " No translated script matches the bytecode, rebuild BlockScriptTests to translate the test scripts again." << std::endl;
+    }
+    else
+    {
+        bs->SetVmBackend(backend);
+        BsVmState vmState;
+        vmState.Initialize(GetGlobalAllocator());
+        const char marker = '|';
+
+        //global scope, only suspended by yield
+        int yields = 0;
+        bs->Run(&vmState);
+        while (vmState.IsSuspended())
+        {
+            yields += vmState.IsSuspendedByCallback() ? 1 : 0;
+            gSs->Append(&marker, 1);
+            bs->Resume(&vmState);
+        }
+
+        //function call on a budget of a few jumps, suspended by yield and by the budget
+        const int budget = 1;
+        const char* argTypes[] = { "int" };
+        FunBindPoint bindPoint = bs->GetFunctionBindPoint("Generate", argTypes, 1);
+        int steps = 4;
+        int total = -1;
+        int budgetSuspensions = 0;
+        bool callRes = bindPoint != FUN_INVALID_BIND_POINT && bs->ExecuteFunction(&vmState, bindPoint, &steps, sizeof(steps), &total, sizeof(total), budget);
+        while (callRes && vmState.IsSuspended())
+        {
+            if (vmState.IsSuspendedByCallback())
+            {
+                gSs->Append(&marker, 1);
+            }
+            else
+            {
+                ++budgetSuspensions;
+            }
+            callRes = bs->Resume(&vmState, budget, &total, sizeof(total));
+        }
+        gSs->Append("=", 1);
+        callRes = callRes && printint(total) == 0;
+
+        //a cancelled call leaves the state ready for the next one
+        int cancelled = -1;
+        callRes = callRes && bs->ExecuteFunction(&vmState, bindPoint, &steps, sizeof(steps), &cancelled, sizeof(cancelled)) && vmState.IsSuspended();
+        bs->Cancel(&vmState);
+        steps = 0;
+        callRes = callRes && !vmState.IsSuspended() && bs->ExecuteFunction(&vmState, bindPoint, &steps, sizeof(steps), &total, sizeof(total)) && total == 0;
+
+        cout << " " << yields << " yields, " << budgetSuspensions << " suspensions on budget" << std::endl;
+
+        char z = '\0';
+        gSs->Append(&z, 1);
+        FileBuffer answerBuffer;
+        result = callRes && yields == test.yields && budgetSuspensions > 0 && vmState.GetStackLevels() == 0
+              && ioMgr.OpenFileToBuffer(test.output, answerBuffer, true, GetGlobalAllocator()) == Pegasus::Io::ERR_NONE
+              && MatchesAnswer(answerBuffer, *gSs);
+        if (!result)
+        {
+            cout << static_cast<const char*>(gSs->GetBuffer());
+        }
+        gSs->Reset();
+    }
+    bsManager.DestroyBlockScript(bs);
+    return result;
+}
+
+//! Calls Tick() a number of times
+//! \param output receives the output of the calls, truncated to SNAPSHOT_TEST_OUTPUT_SIZE
+void TickOutput(BlockScript* bs, BsVmState& vmState, int count, char* output)
+{
+    for (int i = 0; i < count && CallTick(bs, vmState); ++i);
+    int size = gSs->GetSize() < SNAPSHOT_TEST_OUTPUT_SIZE - 1 ? gSs->GetSize() : SNAPSHOT_TEST_OUTPUT_SIZE - 1;
+    Pegasus::Utils::Memcpy(output, gSs->GetBuffer(), size);
+    output[size] = '\0';
+    gSs->Reset();
+}
+
+//! Calls Tick() a number of times
+//! \return true if the output of the calls matches an earlier one
+bool TickOutputMatches(BlockScript* bs, BsVmState& vmState, int count, const char* expected)
+{
+    char output[SNAPSHOT_TEST_OUTPUT_SIZE];
+    TickOutput(bs, vmState, count, output);
+    return Pegasus::Utils::Strcmp(output, expected) == 0;
+}
+
+//! Runs a script and snapshots its state in between calls to Tick(). Restoring a snapshot must
+//! replay the calls made after it, and consecutive snapshots must share the pages left untouched.
+//! Seeking before the first snapshot resets the state and runs the globals again, like the timeline does.
+//! \return true if the replays match
+bool RunSnapshotTest(IOManager& ioMgr, const char* script, BsVm::Backend backend)
+{
+    Pegasus::BlockScript::BlockScriptManager bsManager(GetGlobalAllocator());
+    bsManager.RegisterAotScripts(gTestAotScripts, gTestAotScriptsCount);
+    BlockScript* bs = bsManager.CreateBlockScript();
+    FileBuffer source;
+    bool result = false;
+    if (ioMgr.OpenFileToBuffer(script, source, true, GetGlobalAllocator()) != Pegasus::Io::ERR_NONE)
+    {
+        cout << " Unable to open script file: " << script << std::endl;
+    }
+    else if (!bs->Compile(&source))
+    {
+        cout << " Compilation Error." << std::endl;
+    }
+    else
+    {
+        bs->SetVmBackend(backend);
+        BsVmState vmState;
+        vmState.Initialize(GetGlobalAllocator());
+        bs->Run(&vmState);
+
+        BsVmSnapshot first(GetGlobalAllocator());
+        BsVmSnapshot second(GetGlobalAllocator());
+        char fromStart[SNAPSHOT_TEST_OUTPUT_SIZE];
+        char afterFirst[SNAPSHOT_TEST_OUTPUT_SIZE];
+        char afterSecond[SNAPSHOT_TEST_OUTPUT_SIZE];
+        TickOutput(bs, vmState, 2, fromStart);
+        first.Capture(vmState, nullptr);
+        TickOutput(bs, vmState, 3, afterFirst);
+        second.Capture(vmState, &first);
+        TickOutput(bs, vmState, 3, afterSecond);
+
+        //rewind twice, forward once
+        first.Restore(vmState);
+        result = TickOutputMatches(bs, vmState, 3, afterFirst);
+        second.Restore(vmState);
+        result = result && TickOutputMatches(bs, vmState, 3, afterSecond);
+        first.Restore(vmState);
+        result = result && TickOutputMatches(bs, vmState, 3, afterFirst);
+
+        //seek before the first snapshot
+        vmState.Reset();
+        bs->Run(&vmState);
+        result = result && TickOutputMatches(bs, vmState, 2, fromStart);
+
+        cout << " " << second.GetSharedPageCount() << " of " << second.GetPageCount() << " pages shared, "
+             << first.GetByteSize() + second.GetByteSize() << " bytes" << std::endl;
+        result = result && second.GetSharedPageCount() > 0 && second.GetSharedPageCount() < second.GetPageCount();
+    }
+    bsManager.DestroyBlockScript(bs);
+    return result;
+}
 
 int main(int argc, const char** argv)
 {
@@ -279,6 +1300,77 @@ int main(int argc, const char** argv)
         return 0;
     }
 
+    if (gCmdLineOpts.mBenchmarkIterations > 0)
+    {
+        IOManager benchMgr(gCmdLineOpts.mRootFolder == nullptr ? DEFAULT_ROOT : gCmdLineOpts.mRootFolder);
+        RunBenchmark(benchMgr, gCmdLineOpts.mBenchmarkIterations);
+        return 0;
+    }
+
+    if (gCmdLineOpts.mCompileBenchmarkIterations > 0)
+    {
+        IOManager benchMgr(gCmdLineOpts.mRootFolder == nullptr ? DEFAULT_ROOT : gCmdLineOpts.mRootFolder);
+        RunCompileBenchmark(benchMgr, gCmdLineOpts.mCompileBenchmarkIterations);
+        return 0;
+    }
+
+    if (gCmdLineOpts.mStressThreads > 0)
+    {
+        IOManager stressMgr(gCmdLineOpts.mRootFolder == nullptr ? DEFAULT_ROOT : gCmdLineOpts.mRootFolder);
+        int threadCount = gCmdLineOpts.mStressThreads < STRESS_TEST_MAX_THREADS ? gCmdLineOpts.mStressThreads : STRESS_TEST_MAX_THREADS;
+        const BsVm::Backend backends[] = { BsVm::BACKEND_CANON, BsVm::BACKEND_BYTECODE, BsVm::BACKEND_JIT };
+        int stressPass = 0;
+        int stressTotal = 0;
+        for (int i = 0; i < sizeof(gTestScripts)/sizeof(gTestScripts[0]); ++i)
+        {
+            for (int b = 0; b < sizeof(backends)/sizeof(backends[0]); ++b)
+            {
+                if (backends[b] == BsVm::BACKEND_JIT && !BsJit::IsAvailable())
+                {
+                    continue;
+                }
+                cout << " Stress testing: " << gTestScripts[i].script << " (" << GetBackendName(backends[b]) << ", " << threadCount << " threads)" << std::endl;
+                bool res = RunStressTest(stressMgr, gTestScripts[i].script, gTestScripts[i].output, backends[b], threadCount);
+                stressPass += res ? 1 : 0;
+                ++stressTotal;
+                cout << " Result: " << ( res ? "Pass" : "Fail")  <<  std::endl;
+            }
+        }
+        cout <<  "Passed " <<  stressPass << " out of " << stressTotal << std::endl;
+        return 0;
+    }
+
+    if (gCmdLineOpts.mCompileThreads > 0)
+    {
+        IOManager compileMgr(gCmdLineOpts.mRootFolder == nullptr ? DEFAULT_ROOT : gCmdLineOpts.mRootFolder);
+        int threadCount = gCmdLineOpts.mCompileThreads < STRESS_TEST_MAX_THREADS ? gCmdLineOpts.mCompileThreads : STRESS_TEST_MAX_THREADS;
+        cout << " Parallel compile test (" << threadCount << " threads)" << std::endl;
+        bool res = RunParallelCompileTest(compileMgr, threadCount);
+        cout << " Result: " << ( res ? "Pass" : "Fail")  <<  std::endl;
+        return 0;
+    }
+
+    if (gCmdLineOpts.mHeaderTestIterations > 0)
+    {
+        IOManager headerMgr(gCmdLineOpts.mRootFolder == nullptr ? DEFAULT_ROOT : gCmdLineOpts.mRootFolder);
+        cout << " Precompiled header test (" << gCmdLineOpts.mHeaderTestIterations << " batches)" << std::endl;
+        bool res = RunHeaderTest(headerMgr, gCmdLineOpts.mHeaderTestIterations);
+        cout << " Result: " << ( res ? "Pass" : "Fail")  <<  std::endl;
+        return 0;
+    }
+
+    if (gCmdLineOpts.mHotReloadTest)
+    {
+        IOManager reloadMgr(gCmdLineOpts.mRootFolder == nullptr ? DEFAULT_ROOT : gCmdLineOpts.mRootFolder);
+        for (int i = 0; i < sizeof(gHotReloadTests)/sizeof(gHotReloadTests[0]); ++i)
+        {
+            cout << " Hot reload test: " << gHotReloadTests[i].script << " -> " << gHotReloadTests[i].edit << std::endl;
+            bool res = RunHotReloadTest(reloadMgr, gHotReloadTests[i]);
+            cout << " Result: " << ( res ? "Pass" : "Fail")  <<  std::endl;
+        }
+        return 0;
+    }
+
     if (gCmdLineOpts.mSingleScript == nullptr)
     {
         cout << "###############################################################" << std::endl;
@@ -294,19 +1386,81 @@ int main(int argc, const char** argv)
     int passTests = 0;
     if (gCmdLineOpts.mSingleScript != nullptr)
     {
-        RunTest(mgr, gCmdLineOpts.mSingleScript, nullptr, true);
+        RunTest(mgr, gCmdLineOpts.mSingleScript, nullptr, BsVm::BACKEND_BYTECODE, Optimizer::LEVEL_FULL, true);
     }
     else
     {
+        const BsVm::Backend backends[] = { BsVm::BACKEND_CANON, BsVm::BACKEND_BYTECODE, BsVm::BACKEND_AOT, BsVm::BACKEND_JIT };
+        const Optimizer::Level optLevels[] = { Optimizer::LEVEL_NONE, Optimizer::LEVEL_FULL };
         for (int i = 0; i < sizeof(gTestScripts)/sizeof(gTestScripts[0]); ++i)
         {
-            cout << " Testing: " << gTestScripts[i].script  << std::endl;
-            bool res = RunTest(mgr, gTestScripts[i].script, gTestScripts[i].output);
+            for (int o = 0; o < sizeof(optLevels)/sizeof(optLevels[0]); ++o)
+            {
+                for (int b = 0; b < sizeof(backends)/sizeof(backends[0]); ++b)
+                {
+                    //the scripts are translated with full optimizations only, as a shipping build would
+                    if (backends[b] == BsVm::BACKEND_AOT && optLevels[o] != Optimizer::LEVEL_FULL)
+                    {
+                        continue;
+                    }
+                    //the jit is tested against the interpreter on builds that have it (BLOCKSCRIPT_JIT on x86-64)
+                    if (backends[b] == BsVm::BACKEND_JIT && !BsJit::IsAvailable())
+                    {
+                        continue;
+                    }
+                    cout << " Testing: " << gTestScripts[i].script << " (" << GetBackendName(backends[b]) << ", O" << optLevels[o] << ")" << std::endl;
+                    bool res = RunTest(mgr, gTestScripts[i].script, gTestScripts[i].output, backends[b], optLevels[o]);
+                    passTests += res ? 1 : 0;
+                    ++total;
+                    cout << " Result: " << ( res ? "Pass" : "Fail")  <<  std::endl;
+                    cout << std::endl;
+                }
+            }
+        }
+
+        for (int i = 0; i < sizeof(gRangeCheckTests)/sizeof(gRangeCheckTests[0]); ++i)
+        {
+            cout << " Range check test: " << gRangeCheckTests[i].script << std::endl;
+            bool res = RunRangeCheckTest(mgr, gRangeCheckTests[i]);
             passTests += res ? 1 : 0;
             ++total;
             cout << " Result: " << ( res ? "Pass" : "Fail")  <<  std::endl;
             cout << std::endl;
         }
+
+        for (int i = 0; i < sizeof(gSnapshotTestScripts)/sizeof(gSnapshotTestScripts[0]); ++i)
+        {
+            for (int b = 0; b < sizeof(backends)/sizeof(backends[0]); ++b)
+            {
+                if (backends[b] == BsVm::BACKEND_JIT && !BsJit::IsAvailable())
+                {
+                    continue;
+                }
+                cout << " Snapshot test: " << gSnapshotTestScripts[i] << " (" << GetBackendName(backends[b]) << ")" << std::endl;
+                bool res = RunSnapshotTest(mgr, gSnapshotTestScripts[i], backends[b]);
+                passTests += res ? 1 : 0;
+                ++total;
+                cout << " Result: " << ( res ? "Pass" : "Fail")  <<  std::endl;
+                cout << std::endl;
+            }
+        }
+
+        for (int i = 0; i < sizeof(gYieldTests)/sizeof(gYieldTests[0]); ++i)
+        {
+            for (int b = 0; b < sizeof(backends)/sizeof(backends[0]); ++b)
+            {
+                if (backends[b] == BsVm::BACKEND_JIT && !BsJit::IsAvailable())
+                {
+                    continue;
+                }
+                cout << " Yield test: " << gYieldTests[i].script << " (" << GetBackendName(backends[b]) << ")" << std::endl;
+                bool res = RunYieldTest(mgr, gYieldTests[i], backends[b]);
+                passTests += res ? 1 : 0;
+                ++total;
+                cout << " Result: " << ( res ? "Pass" : "Fail")  <<  std::endl;
+                cout << std::endl;
+            }
+        }
     }
 
     if (gCmdLineOpts.mSingleScript == nullptr)
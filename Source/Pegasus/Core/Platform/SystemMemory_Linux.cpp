@@ -0,0 +1,82 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                       Pegasus                                        */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file	SystemMemory_Linux.cpp
+//! \author	agent
+//! \date	16th October 2026
+//! \brief	Memory taken directly from the operating system (Linux implementation)
+
+#if PEGASUS_PLATFORM_LINUX
+
+#include "Pegasus/Core/SystemMemory.h"
+
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+namespace Pegasus {
+namespace Core {
+
+
+//! \return byteSize rounded up to the system pages
+static size_t RoundToPages(size_t byteSize)
+{
+    const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return (byteSize + pageSize - 1) & ~(pageSize - 1);
+}
+
+//----------------------------------------------------------------------------------------
+
+void* AllocSystemMemory(size_t byteSize)
+{
+    // mmap only aligns to the pages: map the slack needed to align, and unmap what is left on both sides
+    byteSize = RoundToPages(byteSize);
+    const size_t slackByteSize = RoundToPages(PG_SYSTEM_MEMORY_ALIGNMENT) - static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    void* range = mmap(nullptr, byteSize + slackByteSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (range == MAP_FAILED)
+    {
+        return nullptr;
+    }
+
+    char* start = static_cast<char*>(range);
+    char* memory = reinterpret_cast<char*>((reinterpret_cast<size_t>(start) + PG_SYSTEM_MEMORY_ALIGNMENT - 1) & ~static_cast<size_t>(PG_SYSTEM_MEMORY_ALIGNMENT - 1));
+    const size_t headByteSize = static_cast<size_t>(memory - start);
+    if (headByteSize > 0)
+    {
+        munmap(start, headByteSize);
+    }
+    if (slackByteSize > headByteSize)
+    {
+        munmap(memory + byteSize, slackByteSize - headByteSize);
+    }
+    return memory;
+}
+
+//----------------------------------------------------------------------------------------
+
+void FreeSystemMemory(void* memory, size_t byteSize)
+{
+    munmap(memory, RoundToPages(byteSize));
+}
+
+//----------------------------------------------------------------------------------------
+
+size_t GetPeakResidentByteSize()
+{
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+    // Reported in kilobytes
+    return static_cast<size_t>(usage.ru_maxrss) * 1024;
+}
+
+
+}   // namespace Core
+}   // namespace Pegasus
+
+#endif  // PEGASUS_PLATFORM_LINUX
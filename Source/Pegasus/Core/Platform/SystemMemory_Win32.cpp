@@ -0,0 +1,53 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                       Pegasus                                        */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file	SystemMemory_Win32.cpp
+//! \author	agent
+//! \date	16th October 2026
+//! \brief	Memory taken directly from the operating system (Win32 implementation)
+
+#if PEGASUS_PLATFORM_WINDOWS
+
+#include "Pegasus/Core/SystemMemory.h"
+
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <psapi.h>
+
+namespace Pegasus {
+namespace Core {
+
+
+void* AllocSystemMemory(size_t byteSize)
+{
+    // VirtualAlloc places every allocation on the allocation granularity
+    return VirtualAlloc(nullptr, byteSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+}
+
+//----------------------------------------------------------------------------------------
+
+void FreeSystemMemory(void* memory, size_t byteSize)
+{
+    VirtualFree(memory, 0, MEM_RELEASE);
+}
+
+//----------------------------------------------------------------------------------------
+
+size_t GetPeakResidentByteSize()
+{
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return 0;
+    }
+    return counters.PeakWorkingSetSize;
+}
+
+
+}   // namespace Core
+}   // namespace Pegasus
+
+#endif  // PEGASUS_PLATFORM_WINDOWS
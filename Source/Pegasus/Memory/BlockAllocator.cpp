@@ -95,8 +95,26 @@ void* BlockAllocator::AllocAlign(
     unsigned int line
 )
 {
-    PG_FAILSTR("Alloc Align not supported in BlockAllocator!");
-	return nullptr;
+    PG_ASSERTSTR((align & (align - 1)) == 0, "Alignment of %u is not a power of two.", static_cast<unsigned int>(align));
+    PG_ASSERTSTR(size + align <= static_cast<size_t>(mPageSize), "Cannot allocate size greater than the page size! Memory trashing to follow.");
+
+    // Pad the current page up to the alignment when the block fits after the padding
+    const int currentPage = static_cast<int>(mMemorySize) / mPageSize;
+    const int currentOffset = static_cast<int>(mMemorySize) % mPageSize;
+    if (currentPage < mMemoryPageListSize)
+    {
+        const size_t address = reinterpret_cast<size_t>(mMemoryPages[currentPage] + currentOffset);
+        const int padding = static_cast<int>((align - (address & (align - 1))) & (align - 1));
+        if (currentOffset + padding + static_cast<int>(size) <= mPageSize)
+        {
+            mMemorySize += padding;
+            return Alloc(size, flags, category, debugText, file, line);
+        }
+    }
+
+    // Otherwise the block starts a new page, with room for the padding
+    char* block = static_cast<char*>(Alloc(size + align - 1, flags, category, debugText, file, line));
+    return reinterpret_cast<char*>((reinterpret_cast<size_t>(block) + align - 1) & ~(align - 1));
 }
 
 void BlockAllocator::Delete(void* ptr)
@@ -104,6 +122,19 @@ void BlockAllocator::Delete(void* ptr)
     PG_FAILSTR("Atomic deletions not allowed in the greedy Ast Allocator!");
 }
 
+bool BlockAllocator::Owns(const void* ptr) const
+{
+    const char* c = static_cast<const char*>(ptr);
+    for (int p = 0; p < mMemoryPageListSize; ++p)
+    {
+        if (c >= mMemoryPages[p] && c < mMemoryPages[p] + mPageSize)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 void BlockAllocator::Reset()
 {
     mMemorySize = 0;
@@ -11,20 +11,32 @@
 
 #include "Pegasus/Memory/MemoryManager.h"
 #include "Pegasus/Memory/MallocFreeAllocator.h"
+#include "Pegasus/Memory/ThreadCacheAllocator.h"
+
+//! Allocator class of each category, MallocFreeAllocator or ThreadCacheAllocator.
+//! ThreadCacheAllocator suits the categories making many small allocations from several threads.
+#define PG_GLOBAL_ALLOCATOR_CLASS           MallocFreeAllocator
+#define PG_CORE_ALLOCATOR_CLASS             MallocFreeAllocator
+#define PG_RENDER_ALLOCATOR_CLASS           MallocFreeAllocator
+#define PG_NODE_ALLOCATOR_CLASS             MallocFreeAllocator
+#define PG_NODE_DATA_ALLOCATOR_CLASS        MallocFreeAllocator
+#define PG_PROPERTY_POINTER_ALLOCATOR_CLASS MallocFreeAllocator
+#define PG_TIMELINE_ALLOCATOR_CLASS         MallocFreeAllocator
+#define PG_WINDOW_ALLOCATOR_CLASS           MallocFreeAllocator
 
 namespace Pegasus {
 namespace Memory {
 
 // Global allocator
 //! \todo Real allocator / heap management...
-static MallocFreeAllocator sGlobalAllocator(0);
-static MallocFreeAllocator sCoreAllocator(1);
-static MallocFreeAllocator sRenderAllocator(2);
-static MallocFreeAllocator sNodeAllocator(3);
-static MallocFreeAllocator sNodeDataAllocator(4);
-static MallocFreeAllocator sPropertyPointerAllocator(5);
-static MallocFreeAllocator sTimelineAllocator(6);
-static MallocFreeAllocator sWindowAllocator(7);
+static PG_GLOBAL_ALLOCATOR_CLASS sGlobalAllocator(0);
+static PG_CORE_ALLOCATOR_CLASS sCoreAllocator(1);
+static PG_RENDER_ALLOCATOR_CLASS sRenderAllocator(2);
+static PG_NODE_ALLOCATOR_CLASS sNodeAllocator(3);
+static PG_NODE_DATA_ALLOCATOR_CLASS sNodeDataAllocator(4);
+static PG_PROPERTY_POINTER_ALLOCATOR_CLASS sPropertyPointerAllocator(5);
+static PG_TIMELINE_ALLOCATOR_CLASS sTimelineAllocator(6);
+static PG_WINDOW_ALLOCATOR_CLASS sWindowAllocator(7);
 
 //----------------------------------------------------------------------------------------
 
@@ -0,0 +1,589 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                       Pegasus                                        */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file   ThreadCacheAllocator.cpp
+//! \author agent
+//! \date   16th October 2026
+//! \brief  Allocator with a cache per thread, for small allocations made from many threads.
+
+#include "Pegasus/Memory/ThreadCacheAllocator.h"
+#include "Pegasus/Core/SystemMemory.h"
+#include "Pegasus/Math/Types.h"
+#include <stdlib.h>
+#include <new>
+
+namespace Pegasus {
+namespace Memory {
+
+//! bytes at the start of every page holding its header, the blocks follow. Keeps the blocks 16 byte aligned.
+static const size_t PAGE_HEADER_BYTESIZE = 192;
+
+//! pages carved from each malloc call
+static const size_t PAGES_PER_CHUNK = 16;
+
+//! empty pages a heap keeps for itself before giving them to the shared pool
+static const unsigned int HEAP_FREE_PAGE_LIMIT = 4;
+
+//! size class of the blocks allocated directly from the system
+static const unsigned int LARGE_SIZE_CLASS = 0xff;
+
+//! size of the blocks of each size class: steps of 16 bytes up to 128, then 4 classes per power of two
+static const unsigned int sSizeClassByteSizes[] = {
+    16, 32, 48, 64, 80, 96, 112, 128,
+    160, 192, 224, 256,
+    320, 384, 448, 512,
+    640, 768, 896, 1024,
+    1280, 1536, 1792, 2048,
+    2560, 3072, 3584, 4096,
+    5120, 6144, 7168, 8192
+};
+static const unsigned int SIZE_CLASS_COUNT = sizeof(sSizeClassByteSizes) / sizeof(sSizeClassByteSizes[0]);
+
+//----------------------------------------------------------------------------------------
+
+//! Header of a slab page, or of a block allocated from the system.
+//! The fields above mRemoteFree are written by the owner thread only.
+struct ThreadCacheAllocator::Page
+{
+    ThreadCacheAllocator* mAllocator; //!< integrity check of the frees
+    ThreadHeap* mHeap;                //!< heap allocating from this page, null for large blocks
+    Page* mPrev;                      //!< previous page of the same size class in the heap, or previous large block
+    Page* mNext;                      //!< next page of the same size class in the heap, next free page, or next large block
+    void* mLocalFree;                 //!< blocks freed by the owner thread
+    char* mBump;                      //!< first block never allocated
+    char* mEnd;                       //!< end of the last block fitting in the page
+    size_t mLargeByteSize;            //!< size of the memory allocated from the system, for large blocks
+    unsigned int mSizeClass;          //!< size class of the blocks, LARGE_SIZE_CLASS for large blocks
+    unsigned int mBlockByteSize;      //!< size of the blocks
+    unsigned int mBlockReciprocal;    //!< 2^32 / block size rounded up, to divide offsets in the page
+    unsigned int mUsedCount;          //!< blocks allocated, including the ones waiting on the remote list
+
+    //! blocks freed by other threads, pushed without lock. On its own cache line, away from the owner fields.
+    PEGASUS_ALIGN_BEGIN(64) std::atomic<void*> mRemoteFree PEGASUS_ALIGN_END(64);
+};
+
+static_assert(sizeof(ThreadCacheAllocator::Page) <= PAGE_HEADER_BYTESIZE, "The page header overlaps the first block");
+static_assert(PG_SYSTEM_MEMORY_ALIGNMENT % PG_THREAD_CACHE_PAGE_BYTESIZE == 0, "Large blocks do not start on a page boundary");
+
+//! Memory the pages are carved from
+struct ThreadCacheAllocator::Chunk
+{
+    Chunk* mNext;
+    size_t mByteSize;
+};
+
+//! Pages of a thread. Only the owner thread reads and writes a heap, apart from mIsOwned.
+struct ThreadCacheAllocator::ThreadHeap
+{
+    Page* mPages[SIZE_CLASS_COUNT]; //!< pages of each size class, the first one allocates
+    Page* mFreePages;               //!< empty pages kept for the next size class running out
+    unsigned int mFreePageCount;
+    ThreadHeap* mNext;              //!< next heap of the allocator
+    bool mIsOwned;                  //!< false once the thread exits, guarded by the allocator lock
+};
+
+//! Heaps of a thread, one slot per live allocator
+struct ThreadHeapTable
+{
+    struct Entry
+    {
+        ThreadCacheAllocator::ThreadHeap* mHeap;
+        unsigned int mUniqueId; //!< allocator owning the heap, 0 if none
+    };
+
+    //! Gives up the heaps of the thread that exits
+    ~ThreadHeapTable();
+
+    Entry mEntries[PG_THREAD_CACHE_MAX_ALLOCATORS];
+};
+
+static thread_local ThreadHeapTable tHeapTable;
+
+//! Allocators alive, so an exiting thread does not give back a heap to a destroyed allocator
+struct AllocatorRegistry
+{
+    std::mutex mLock;
+    ThreadCacheAllocator* mAllocators[PG_THREAD_CACHE_MAX_ALLOCATORS];
+    unsigned int mLastUniqueId;
+};
+
+//! \return the registry of the allocators. It is never destroyed: static allocators of other files
+//!         are destroyed after the statics of this file.
+static AllocatorRegistry& GetRegistry()
+{
+    static AllocatorRegistry* registry = new (malloc(sizeof(AllocatorRegistry))) AllocatorRegistry();
+    return *registry;
+}
+
+//! Size class of each size, in steps of 16 bytes
+struct SizeClassTable
+{
+    SizeClassTable()
+    {
+        unsigned int sizeClass = 0;
+        for (unsigned int i = 0; i <= PG_THREAD_CACHE_MAX_SMALL_BYTESIZE / 16; ++i)
+        {
+            while (sSizeClassByteSizes[sizeClass] < i * 16)
+            {
+                ++sizeClass;
+            }
+            mClassOfSize[i] = static_cast<unsigned char>(sizeClass);
+        }
+    }
+
+    unsigned char mClassOfSize[PG_THREAD_CACHE_MAX_SMALL_BYTESIZE / 16 + 1];
+};
+
+//! \return the size class table, built on first use so static allocators can use it
+static const unsigned char* GetClassOfSize()
+{
+    static const SizeClassTable table;
+    return table.mClassOfSize;
+}
+
+//----------------------------------------------------------------------------------------
+
+//! \return ptr rounded up to a power of two alignment
+static inline char* AlignUp(void* ptr, size_t align)
+{
+    return reinterpret_cast<char*>((reinterpret_cast<size_t>(ptr) + align - 1) & ~(align - 1));
+}
+
+//! \return the page holding a block, from any address inside it
+static inline ThreadCacheAllocator::Page* GetPage(void* ptr)
+{
+    return reinterpret_cast<ThreadCacheAllocator::Page*>(reinterpret_cast<size_t>(ptr) & ~static_cast<size_t>(PG_THREAD_CACHE_PAGE_BYTESIZE - 1));
+}
+
+//! \return a free block of a page, null if it has none left
+static inline void* PopBlock(ThreadCacheAllocator::Page* page)
+{
+    void* block = page->mLocalFree;
+    if (block != nullptr)
+    {
+        page->mLocalFree = *static_cast<void**>(block);
+    }
+    else if (page->mBump < page->mEnd)
+    {
+        block = page->mBump;
+        page->mBump += page->mBlockByteSize;
+    }
+    else
+    {
+        return nullptr;
+    }
+    ++page->mUsedCount;
+    return block;
+}
+
+//! Moves the blocks freed by other threads to the local list of a page
+static void TakeRemoteFrees(ThreadCacheAllocator::Page* page)
+{
+    void* list = page->mRemoteFree.exchange(nullptr, std::memory_order_acquire);
+    if (list != nullptr)
+    {
+        void* last = list;
+        unsigned int count = 1;
+        while (*static_cast<void**>(last) != nullptr)
+        {
+            last = *static_cast<void**>(last);
+            ++count;
+        }
+        *static_cast<void**>(last) = page->mLocalFree;
+        page->mLocalFree = list;
+        page->mUsedCount -= count;
+    }
+}
+
+//! Removes a page from the size class list of its heap
+static inline void UnlinkPage(ThreadCacheAllocator::Page** list, ThreadCacheAllocator::Page* page)
+{
+    if (page->mPrev != nullptr)
+    {
+        page->mPrev->mNext = page->mNext;
+    }
+    else
+    {
+        *list = page->mNext;
+    }
+    if (page->mNext != nullptr)
+    {
+        page->mNext->mPrev = page->mPrev;
+    }
+}
+
+//! Puts a page first in the size class list of its heap, so it allocates next
+static inline void PushPage(ThreadCacheAllocator::Page** list, ThreadCacheAllocator::Page* page)
+{
+    page->mPrev = nullptr;
+    page->mNext = *list;
+    if (*list != nullptr)
+    {
+        (*list)->mPrev = page;
+    }
+    *list = page;
+}
+
+//----------------------------------------------------------------------------------------
+
+ThreadHeapTable::~ThreadHeapTable()
+{
+    AllocatorRegistry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mLock);
+    for (unsigned int slot = 0; slot < PG_THREAD_CACHE_MAX_ALLOCATORS; ++slot)
+    {
+        ThreadCacheAllocator* allocator = registry.mAllocators[slot];
+        if (mEntries[slot].mHeap != nullptr && allocator != nullptr && allocator->mUniqueId == mEntries[slot].mUniqueId)
+        {
+            allocator->AbandonThreadHeap(mEntries[slot].mHeap);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------
+
+ThreadCacheAllocator::ThreadCacheAllocator(unsigned int allocId)
+    : mAllocId(allocId),
+      mSlot(0),
+      mUniqueId(0),
+      mClassOfSize(GetClassOfSize()),
+      mHeaps(nullptr),
+      mChunks(nullptr),
+      mFreePages(nullptr),
+      mLargePages(nullptr),
+      mReservedByteSize(0),
+      mPeakReservedByteSize(0)
+{
+    AllocatorRegistry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mLock);
+    while (mSlot < PG_THREAD_CACHE_MAX_ALLOCATORS && registry.mAllocators[mSlot] != nullptr)
+    {
+        ++mSlot;
+    }
+    PG_ASSERTSTR(mSlot < PG_THREAD_CACHE_MAX_ALLOCATORS, "Too many thread cache allocators alive, raise PG_THREAD_CACHE_MAX_ALLOCATORS.");
+    registry.mAllocators[mSlot] = this;
+    mUniqueId = ++registry.mLastUniqueId;
+}
+
+//----------------------------------------------------------------------------------------
+
+ThreadCacheAllocator::~ThreadCacheAllocator()
+{
+    {
+        AllocatorRegistry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mLock);
+        registry.mAllocators[mSlot] = nullptr;
+    }
+
+    while (mHeaps != nullptr)
+    {
+        ThreadHeap* heap = mHeaps;
+        mHeaps = heap->mNext;
+        free(heap);
+    }
+    while (mChunks != nullptr)
+    {
+        Chunk* chunk = mChunks;
+        mChunks = chunk->mNext;
+        free(chunk);
+    }
+    while (mLargePages != nullptr)
+    {
+        Page* page = mLargePages;
+        mLargePages = page->mNext;
+        FreeLarge(page);
+    }
+}
+
+//----------------------------------------------------------------------------------------
+
+void* ThreadCacheAllocator::Alloc(size_t size, Alloc::Flags flags, Alloc::Category category, const char* debugText, const char* file, unsigned int line)
+{
+    if (size > PG_THREAD_CACHE_MAX_SMALL_BYTESIZE)
+    {
+        return AllocLarge(size, 16);
+    }
+
+    const unsigned int sizeClass = mClassOfSize[(size + 15) >> 4];
+    ThreadHeap* heap = GetThreadHeap();
+    Page* page = heap->mPages[sizeClass];
+    void* block = page != nullptr ? PopBlock(page) : nullptr;
+    return block != nullptr ? block : AllocSlow(heap, sizeClass);
+}
+
+//----------------------------------------------------------------------------------------
+
+void* ThreadCacheAllocator::AllocAlign(size_t size, Alloc::Alignment align, Alloc::Flags flags, Alloc::Category category, const char* debugText, const char* file, unsigned int line)
+{
+    PG_ASSERTSTR((align & (align - 1)) == 0, "Alignment of %u is not a power of two.", static_cast<unsigned int>(align));
+    if (align <= 16)
+    {
+        return Alloc(size, flags, category, debugText, file, line);
+    }
+    else if (size + align - 16 <= PG_THREAD_CACHE_MAX_SMALL_BYTESIZE)
+    {
+        // Blocks are 16 byte aligned, and Delete finds the block from any address inside it
+        return AlignUp(Alloc(size + align - 16, flags, category, debugText, file, line), align);
+    }
+    else
+    {
+        return AllocLarge(size, align);
+    }
+}
+
+//----------------------------------------------------------------------------------------
+
+void ThreadCacheAllocator::Delete(void* ptr)
+{
+    if (ptr == nullptr)
+    {
+        return;
+    }
+
+    Page* page = GetPage(ptr);
+
+    // Allocator integrity check
+    PG_ASSERTSTR(page->mAllocator == this, "Allocation freed from a different allocator than it was alloced in!  Memory corruption may follow...");
+
+    if (page->mSizeClass == LARGE_SIZE_CLASS)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mLock);
+            UnlinkPage(&mLargePages, page);
+        }
+        FreeLarge(page);
+        return;
+    }
+
+    // Aligned allocations point inside their block
+    char* blocks = reinterpret_cast<char*>(page) + PAGE_HEADER_BYTESIZE;
+    const Math::PUInt64 offset = static_cast<Math::PUInt64>(static_cast<char*>(ptr) - blocks);
+    void* block = blocks + static_cast<size_t>((offset * page->mBlockReciprocal) >> 32) * page->mBlockByteSize;
+
+    ThreadHeap* heap = FindThreadHeap();
+    if (heap == page->mHeap)
+    {
+        *static_cast<void**>(block) = page->mLocalFree;
+        page->mLocalFree = block;
+        if (--page->mUsedCount == 0 && heap->mPages[page->mSizeClass] != page)
+        {
+            UnlinkPage(&heap->mPages[page->mSizeClass], page);
+            ReleasePage(heap, page);
+        }
+    }
+    else
+    {
+        void* head = page->mRemoteFree.load(std::memory_order_relaxed);
+        do
+        {
+            *static_cast<void**>(block) = head;
+        }
+        while (!page->mRemoteFree.compare_exchange_weak(head, block, std::memory_order_release, std::memory_order_relaxed));
+    }
+}
+
+//----------------------------------------------------------------------------------------
+
+ThreadCacheAllocator::ThreadHeap* ThreadCacheAllocator::FindThreadHeap() const
+{
+    const ThreadHeapTable::Entry& entry = tHeapTable.mEntries[mSlot];
+    return entry.mUniqueId == mUniqueId ? entry.mHeap : nullptr;
+}
+
+//----------------------------------------------------------------------------------------
+
+ThreadCacheAllocator::ThreadHeap* ThreadCacheAllocator::GetThreadHeap()
+{
+    ThreadHeap* heap = FindThreadHeap();
+    if (heap != nullptr)
+    {
+        return heap;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        heap = mHeaps;
+        while (heap != nullptr && heap->mIsOwned)
+        {
+            heap = heap->mNext;
+        }
+        if (heap == nullptr)
+        {
+            heap = static_cast<ThreadHeap*>(calloc(1, sizeof(ThreadHeap)));
+            PG_ASSERTSTR(heap != nullptr, "Out of memory for the heap of a thread.");
+            AddReservedByteSize(sizeof(ThreadHeap));
+            heap->mNext = mHeaps;
+            mHeaps = heap;
+        }
+        heap->mIsOwned = true;
+    }
+
+    ThreadHeapTable::Entry& entry = tHeapTable.mEntries[mSlot];
+    entry.mHeap = heap;
+    entry.mUniqueId = mUniqueId;
+    return heap;
+}
+
+//----------------------------------------------------------------------------------------
+
+void ThreadCacheAllocator::AbandonThreadHeap(ThreadHeap* heap)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    while (heap->mFreePages != nullptr)
+    {
+        Page* page = heap->mFreePages;
+        heap->mFreePages = page->mNext;
+        page->mNext = mFreePages;
+        mFreePages = page;
+    }
+    heap->mFreePageCount = 0;
+    heap->mIsOwned = false;
+}
+
+//----------------------------------------------------------------------------------------
+
+void* ThreadCacheAllocator::AllocSlow(ThreadHeap* heap, unsigned int sizeClass)
+{
+    Page** list = &heap->mPages[sizeClass];
+    for (Page* page = *list; page != nullptr; page = page->mNext)
+    {
+        if (page->mRemoteFree.load(std::memory_order_relaxed) != nullptr)
+        {
+            TakeRemoteFrees(page);
+        }
+        void* block = PopBlock(page);
+        if (block != nullptr)
+        {
+            if (page != *list)
+            {
+                UnlinkPage(list, page);
+                PushPage(list, page);
+            }
+            return block;
+        }
+    }
+
+    // Every page of the size class is full
+    Page* page = AcquirePage(heap);
+    const unsigned int blockByteSize = sSizeClassByteSizes[sizeClass];
+    page->mAllocator = this;
+    page->mHeap = heap;
+    page->mLocalFree = nullptr;
+    page->mBump = reinterpret_cast<char*>(page) + PAGE_HEADER_BYTESIZE;
+    page->mEnd = page->mBump + ((PG_THREAD_CACHE_PAGE_BYTESIZE - PAGE_HEADER_BYTESIZE) / blockByteSize) * blockByteSize;
+    page->mSizeClass = sizeClass;
+    page->mBlockByteSize = blockByteSize;
+    page->mBlockReciprocal = static_cast<unsigned int>(((static_cast<Math::PUInt64>(1) << 32) + blockByteSize - 1) / blockByteSize);
+    page->mUsedCount = 0;
+    PushPage(list, page);
+    return PopBlock(page);
+}
+
+//----------------------------------------------------------------------------------------
+
+void* ThreadCacheAllocator::AllocLarge(size_t size, Alloc::Alignment align)
+{
+    PG_ASSERTSTR(align <= PG_THREAD_CACHE_PAGE_BYTESIZE / 2, "Alignment of %u is too large for the thread cache allocator.", static_cast<unsigned int>(align));
+
+    // The system memory is aligned to the pages, the header goes at its start where Delete looks for it
+    const size_t offset = (PAGE_HEADER_BYTESIZE + align - 1) & ~(align - 1);
+    const size_t byteSize = size + offset;
+    void* memory = Core::AllocSystemMemory(byteSize);
+    PG_ASSERTSTR(memory != nullptr, "Out of memory allocating %u bytes.", static_cast<unsigned int>(size));
+
+    Page* page = new (memory) Page();
+    page->mAllocator = this;
+    page->mSizeClass = LARGE_SIZE_CLASS;
+    page->mLargeByteSize = byteSize;
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        PushPage(&mLargePages, page);
+    }
+    AddReservedByteSize(byteSize);
+    return reinterpret_cast<char*>(page) + offset;
+}
+
+//----------------------------------------------------------------------------------------
+
+void ThreadCacheAllocator::FreeLarge(Page* page)
+{
+    const size_t byteSize = page->mLargeByteSize;
+    mReservedByteSize.fetch_sub(byteSize, std::memory_order_relaxed);
+    page->~Page();
+    Core::FreeSystemMemory(page, byteSize);
+}
+
+//----------------------------------------------------------------------------------------
+
+ThreadCacheAllocator::Page* ThreadCacheAllocator::AcquirePage(ThreadHeap* heap)
+{
+    Page* page = heap->mFreePages;
+    if (page != nullptr)
+    {
+        heap->mFreePages = page->mNext;
+        --heap->mFreePageCount;
+        return page;
+    }
+
+    std::lock_guard<std::mutex> lock(mLock);
+    if (mFreePages == nullptr)
+    {
+        // The chunk header goes before the first page boundary
+        const size_t byteSize = sizeof(Chunk) + (PAGES_PER_CHUNK + 1) * PG_THREAD_CACHE_PAGE_BYTESIZE;
+        Chunk* chunk = static_cast<Chunk*>(malloc(byteSize));
+        PG_ASSERTSTR(chunk != nullptr, "Out of memory for the pages of a thread cache allocator.");
+        chunk->mNext = mChunks;
+        chunk->mByteSize = byteSize;
+        mChunks = chunk;
+        AddReservedByteSize(byteSize);
+
+        char* pages = AlignUp(chunk + 1, PG_THREAD_CACHE_PAGE_BYTESIZE);
+        for (size_t p = 0; p < PAGES_PER_CHUNK; ++p)
+        {
+            Page* newPage = new (pages + p * PG_THREAD_CACHE_PAGE_BYTESIZE) Page();
+            newPage->mRemoteFree.store(nullptr, std::memory_order_relaxed);
+            newPage->mNext = mFreePages;
+            mFreePages = newPage;
+        }
+    }
+    page = mFreePages;
+    mFreePages = page->mNext;
+    return page;
+}
+
+//----------------------------------------------------------------------------------------
+
+void ThreadCacheAllocator::ReleasePage(ThreadHeap* heap, Page* page)
+{
+    // No block is left, so no other thread touches the page any more
+    if (heap->mFreePageCount < HEAP_FREE_PAGE_LIMIT)
+    {
+        page->mNext = heap->mFreePages;
+        heap->mFreePages = page;
+        ++heap->mFreePageCount;
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        page->mNext = mFreePages;
+        mFreePages = page;
+    }
+}
+
+//----------------------------------------------------------------------------------------
+
+void ThreadCacheAllocator::AddReservedByteSize(size_t byteSize)
+{
+    const size_t reserved = mReservedByteSize.fetch_add(byteSize, std::memory_order_relaxed) + byteSize;
+    size_t peak = mPeakReservedByteSize.load(std::memory_order_relaxed);
+    while (reserved > peak && !mPeakReservedByteSize.compare_exchange_weak(peak, reserved, std::memory_order_relaxed))
+    {
+    }
+}
+
+
+}   // namespace Memory
+}   // namespace Pegasus
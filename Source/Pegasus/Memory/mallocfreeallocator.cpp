@@ -10,6 +10,7 @@
 //! \brief  Basic allocator using stdC malloc and free from the system heap.
 
 #include "Pegasus/Memory/MallocFreeAllocator.h"
+#include "Pegasus/Allocator/AlignedBlock.h"
 
 namespace Pegasus {
 namespace Memory {
@@ -29,32 +30,24 @@ MallocFreeAllocator::~MallocFreeAllocator()
 
 void* MallocFreeAllocator::Alloc(size_t size, Alloc::Flags flags, Alloc::Category category, const char* debugText, const char* file, unsigned int line)
 {
-    //! \todo Platform-specific allocs
-    // Grab the chunk with an extra int at the front for the allocator ID
-    unsigned int chunkSize = size + sizeof(unsigned int);
-    void* chunk = malloc(chunkSize);
-    void* ret = ((unsigned int*) chunk) + 1;
-
-    // Cache the ID
-    *((unsigned int*) chunk) = mAllocId;
-
-    return ret;
+    return AllocAlign(size, PG_DEFAULT_ALIGNMENT, flags, category, debugText, file, line);
 }
 
 //----------------------------------------------------------------------------------------
 
 void* MallocFreeAllocator::AllocAlign(size_t size, Alloc::Alignment align, Alloc::Flags flags, Alloc::Category category, const char* debugText, const char* file, unsigned int line)
 {
-    //! \todo Platform-specific allocs
-    // Grab the chunk with an extra int at the front for the allocator ID
-    unsigned int chunkSize = size + sizeof(unsigned int);
-    void* chunk = malloc(chunkSize);
-    void* ret = ((unsigned int*) chunk) + 1;
+    PG_ASSERTSTR((align & (align - 1)) == 0, "Alignment of %u is not a power of two.", static_cast<unsigned int>(align));
 
-    // Cache the ID
-    *((unsigned int*) chunk) = mAllocId;
+    //! \todo Platform-specific allocs
+    // Grab the chunk with room to align the block, and a header in front of it for the allocator ID and the offset
+    void* chunk = malloc(Alloc::GetAlignedAllocationSize(size, align));
+    if (chunk == nullptr)
+    {
+        return nullptr;
+    }
 
-    return ret;
+    return Alloc::PlaceAlignedBlock(chunk, align, mAllocId);
 }
 
 //----------------------------------------------------------------------------------------
@@ -63,14 +56,10 @@ void MallocFreeAllocator::Delete(void* ptr)
 {
     if (ptr != nullptr)
     {
-        // Grab the chunk and allocator ID
-        void* chunk = ((unsigned int*) ptr) - 1;
-        const unsigned int chunkId = *((unsigned int*) chunk);
-
         // Allocator integrity check
-        PG_ASSERTSTR(chunkId == mAllocId, "Allocation freed from a different allocator than it was alloced in!  Memory corruption may follow...");
+        PG_ASSERTSTR(Alloc::GetAlignedBlockHeader(ptr)->mTag == mAllocId, "Allocation freed from a different allocator than it was alloced in!  Memory corruption may follow...");
 
-        free(chunk);
+        free(Alloc::GetAlignedBlockMemory(ptr));
     }
 }
 
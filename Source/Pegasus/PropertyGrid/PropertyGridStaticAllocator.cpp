@@ -10,6 +10,7 @@
 //! \brief	Allocator for the static objects used by property grids, such as the manager
 
 #include "Pegasus/PropertyGrid/PropertyGridStaticAllocator.h"
+#include "Pegasus/Allocator/AlignedBlock.h"
 
 namespace Pegasus {
 namespace PropertyGrid {
@@ -38,21 +39,25 @@ PropertyGridStaticAllocator & PropertyGridStaticAllocator::GetInstance()
 
 void * PropertyGridStaticAllocator::Alloc(size_t size, Alloc::Flags flags, Alloc::Category category, const char * debugText, const char * file, unsigned int line)
 {
-    return malloc(size);
+    return AllocAlign(size, PG_DEFAULT_ALIGNMENT, flags, category, debugText, file, line);
 }
 
 //----------------------------------------------------------------------------------------
 
 void * PropertyGridStaticAllocator::AllocAlign(size_t size, Alloc::Alignment align, Alloc::Flags flags, Alloc::Category category, const char * debugText, const char * file, unsigned int line)
 {
-    return malloc(size);
+    void * memory = malloc(Alloc::GetAlignedAllocationSize(size, align));
+    return memory != nullptr ? Alloc::PlaceAlignedBlock(memory, align, 0) : nullptr;
 }
 
 //----------------------------------------------------------------------------------------
 
 void PropertyGridStaticAllocator::Delete(void * ptr)
 {
-    free(ptr);
+    if (ptr != nullptr)
+    {
+        free(Alloc::GetAlignedBlockMemory(ptr));
+    }
 }
 
 
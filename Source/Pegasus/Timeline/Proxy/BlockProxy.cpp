@@ -52,7 +52,8 @@ void PropertyFlusherPropertyGridObjectDecorator::WriteObjectProperty(unsigned in
 
 BlockProxy::BlockProxy(Block * block)
 :   mBlock(block),
-    mPropertyGridDecorator(&block->GetScriptRunner(), block->GetPropertyGridProxy())
+    mPropertyGridDecorator(&block->GetScriptRunner(), block->GetPropertyGridProxy()),
+    mScriptProfilerProxy(&block->GetScriptRunner())
 {
     PG_ASSERTSTR(block != nullptr, "Trying to create a timeline block proxy from an invalid timeline block object");
 }
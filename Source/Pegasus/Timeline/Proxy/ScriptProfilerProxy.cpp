@@ -0,0 +1,168 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                       Pegasus                                        */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file	ScriptProfilerProxy.cpp
+//! \author	agent
+//! \date	16th October 2026
+//! \brief	Proxy object, used by the editor to profile the script of a block or a timeline
+
+PEGASUS_AVOID_EMPTY_FILE_WARNING
+
+#if PEGASUS_ENABLE_PROXIES
+
+#include "Pegasus/Timeline/Proxy/ScriptProfilerProxy.h"
+#include "Pegasus/Timeline/TimelineScriptRunner.h"
+#include "Pegasus/BlockScript/BsProfiler.h"
+#include "Pegasus/Core/Assertion.h"
+
+namespace Pegasus {
+namespace Timeline {
+
+
+ScriptProfilerProxy::ScriptProfilerProxy(TimelineScriptRunner * runner)
+:   mRunner(runner)
+{
+    PG_ASSERTSTR(runner != nullptr, "Trying to create a script profiler proxy from an invalid script runner");
+}
+
+//----------------------------------------------------------------------------------------
+
+ScriptProfilerProxy::~ScriptProfilerProxy()
+{
+}
+
+//----------------------------------------------------------------------------------------
+
+void ScriptProfilerProxy::SetEnabled(bool enabled)
+{
+    mRunner->EnableProfiler(enabled);
+}
+
+//----------------------------------------------------------------------------------------
+
+bool ScriptProfilerProxy::IsEnabled() const
+{
+    return mRunner->IsProfilerEnabled();
+}
+
+//----------------------------------------------------------------------------------------
+
+void ScriptProfilerProxy::Clear()
+{
+    BlockScript::BsProfiler* profiler = mRunner->GetProfiler();
+    if (profiler != nullptr)
+    {
+        profiler->Clear();
+    }
+}
+
+//----------------------------------------------------------------------------------------
+
+void ScriptProfilerProxy::Update()
+{
+    BlockScript::BsProfiler* profiler = mRunner->GetProfiler();
+    if (profiler != nullptr)
+    {
+        profiler->BuildReport();
+    }
+}
+
+//----------------------------------------------------------------------------------------
+
+double ScriptProfilerProxy::GetTotalTime() const
+{
+    const BlockScript::BsProfiler* profiler = mRunner->GetProfiler();
+    return profiler != nullptr ? profiler->GetTotalTime() : 0.0;
+}
+
+//----------------------------------------------------------------------------------------
+
+unsigned long long ScriptProfilerProxy::GetInstructionCount() const
+{
+    const BlockScript::BsProfiler* profiler = mRunner->GetProfiler();
+    return profiler != nullptr ? profiler->GetInstructionCount() : 0;
+}
+
+//----------------------------------------------------------------------------------------
+
+int ScriptProfilerProxy::GetFunctionCount() const
+{
+    const BlockScript::BsProfiler* profiler = mRunner->GetProfiler();
+    return profiler != nullptr ? profiler->GetFunctionCount() : 0;
+}
+
+//----------------------------------------------------------------------------------------
+
+void ScriptProfilerProxy::GetFunction(int index, ScriptProfileFunction& function) const
+{
+    PG_ASSERT(index >= 0 && index < GetFunctionCount());
+    const BlockScript::BsProfiler::FunctionEntry& entry = mRunner->GetProfiler()->GetFunction(index);
+    function.mName = entry.mName;
+    function.mCalls = entry.mCalls;
+    function.mInstructions = entry.mInstructions;
+    function.mSelfTime = entry.mSelfTime;
+    function.mTotalTime = entry.mTotalTime;
+}
+
+//----------------------------------------------------------------------------------------
+
+int ScriptProfilerProxy::GetLineCount() const
+{
+    const BlockScript::BsProfiler* profiler = mRunner->GetProfiler();
+    return profiler != nullptr ? profiler->GetLineCount() : 0;
+}
+
+//----------------------------------------------------------------------------------------
+
+void ScriptProfilerProxy::GetLine(int index, ScriptProfileLine& line) const
+{
+    PG_ASSERT(index >= 0 && index < GetLineCount());
+    const BlockScript::BsProfiler::LineEntry& entry = mRunner->GetProfiler()->GetLine(index);
+    line.mName = entry.mName;
+    line.mLine = entry.mLine;
+    line.mInstructions = entry.mInstructions;
+    line.mTime = entry.mTime;
+}
+
+//----------------------------------------------------------------------------------------
+
+int ScriptProfilerProxy::GetStackCount() const
+{
+    const BlockScript::BsProfiler* profiler = mRunner->GetProfiler();
+    return profiler != nullptr ? profiler->GetStackCount() : 0;
+}
+
+//----------------------------------------------------------------------------------------
+
+double ScriptProfilerProxy::GetStack(int index, char* buffer, int bufferSize) const
+{
+    PG_ASSERT(index >= 0 && index < GetStackCount());
+    PG_ASSERT(buffer != nullptr && bufferSize > 0);
+    const BlockScript::BsProfiler* profiler = mRunner->GetProfiler();
+    const BlockScript::BsProfiler::StackEntry& stack = profiler->GetStack(index);
+
+    //frames joined with ';', truncated to the buffer
+    int length = 0;
+    for (int f = 0; f < stack.mDepth; ++f)
+    {
+        if (f > 0 && length < bufferSize - 1)
+        {
+            buffer[length++] = ';';
+        }
+        for (const char* c = profiler->GetFunctionName(stack.mFrames[f]); *c != '\0' && length < bufferSize - 1; ++c)
+        {
+            buffer[length++] = *c;
+        }
+    }
+    buffer[length] = '\0';
+    return stack.mTime;
+}
+
+
+}   // namespace Timeline
+}   // namespace Pegasus
+
+#endif  // PEGASUS_ENABLE_PROXIES
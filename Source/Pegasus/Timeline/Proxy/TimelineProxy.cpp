@@ -33,7 +33,8 @@ namespace Timeline {
 
 TimelineProxy::TimelineProxy(Timeline * timeline)
     :   mTimeline(timeline),
-        mPropertyGridDecorator(timeline->GetScriptRunner(), timeline->GetPropertyGrid()->GetPropertyGridProxy())
+        mPropertyGridDecorator(timeline->GetScriptRunner(), timeline->GetPropertyGrid()->GetPropertyGridProxy()),
+        mScriptProfilerProxy(timeline->GetScriptRunner())
 {
     PG_ASSERTSTR(timeline != nullptr, "Trying to create a timeline proxy from an invalid timeline object");
 }
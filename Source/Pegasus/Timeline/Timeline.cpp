@@ -588,6 +588,71 @@ void Timeline::DebugEnableSound(bool enableSound)
 }
 #endif
 
+//! Adds a script to the list of scripts to compile, if it is a dirty script not listed yet
+static void GatherDirtyScript(AssetLib::RuntimeAssetObject* asset, Utils::Vector<TimelineScript*>& scripts)
+{
+    if (asset == nullptr || asset->GetOwnerAsset() == nullptr || asset->GetOwnerAsset()->GetTypeDesc()->mTypeGuid != Pegasus::ASSET_TYPE_BLOCKSCRIPT.mTypeGuid)
+    {
+        return;
+    }
+
+    TimelineScript* script = static_cast<TimelineScript*>(asset);
+    if (!script->IsDirty())
+    {
+        return;
+    }
+
+    for (unsigned int i = 0; i < scripts.GetSize(); ++i)
+    {
+        if (scripts[i] == script)
+        {
+            return;
+        }
+    }
+    scripts.PushEmpty() = script;
+}
+
+static void GatherDirtyScripts(const AssetLib::Object* object, Utils::Vector<TimelineScript*>& scripts);
+
+//! Gathers the dirty scripts referenced by an array of a timeline asset
+static void GatherDirtyScripts(const AssetLib::Array* arr, Utils::Vector<TimelineScript*>& scripts)
+{
+    for (int i = 0; i < arr->GetSize(); ++i)
+    {
+        switch (arr->GetType())
+        {
+        case AssetLib::Array::AS_TYPE_OBJECT:
+            GatherDirtyScripts(arr->GetElement(i).o, scripts);
+            break;
+        case AssetLib::Array::AS_TYPE_ARRAY:
+            GatherDirtyScripts(arr->GetElement(i).a, scripts);
+            break;
+        case AssetLib::Array::AS_TYPE_ASSET_PATH_REF:
+            GatherDirtyScript(arr->GetElement(i).asset, scripts);
+            break;
+        default:
+            return;
+        }
+    }
+}
+
+//! Gathers the dirty scripts referenced by an object of a timeline asset (the master script and the scripts of the blocks)
+static void GatherDirtyScripts(const AssetLib::Object* object, Utils::Vector<TimelineScript*>& scripts)
+{
+    for (int i = 0; i < object->GetAssetsCount(); ++i)
+    {
+        GatherDirtyScript(&(*object->GetAsset(i)), scripts);
+    }
+    for (int i = 0; i < object->GetObjectCount(); ++i)
+    {
+        GatherDirtyScripts(object->GetObject(i), scripts);
+    }
+    for (int i = 0; i < object->GetArrayCount(); ++i)
+    {
+        GatherDirtyScripts(object->GetArray(i), scripts);
+    }
+}
+
 bool Timeline::OnReadAsset(Pegasus::AssetLib::AssetLib* lib, const AssetLib::Asset* asset)
 {
     InternalClear();
@@ -635,6 +700,11 @@ bool Timeline::OnReadAsset(Pegasus::AssetLib::AssetLib* lib, const AssetLib::Ass
     fie.i = root->GetInt(pbmId);
     SetBeatsPerMinute(fie.f);
 
+    //the scripts were loaded with the asset. Compile them all concurrently, before the blocks attach them
+    Utils::Vector<TimelineScript*> scripts(mAllocator);
+    GatherDirtyScripts(root, scripts);
+    mAppContext->GetTimelineManager()->CompileScripts(scripts.Data(), scripts.GetSize());
+
     bool createDefaultLane = false;
 
     if (lanesId != -1)
@@ -29,6 +29,8 @@
 
 
 #include <string.h>
+#include <atomic>
+#include <thread>
 
 namespace Pegasus {
 namespace Timeline {
@@ -51,6 +53,7 @@ TimelineManager::TimelineManager(Alloc::IAllocator * allocator, Core::IApplicati
 ,   mEventListener(nullptr)
 #endif
 ,   mCurrentTimeline(nullptr)
+,   mCompileThreadCount(0)
 {
     PG_ASSERTSTR(allocator != nullptr, "Invalid allocator given to the timeline object");
     PG_ASSERTSTR(appContext != nullptr, "Invalid application context given to the timeline object");
@@ -62,6 +65,10 @@ TimelineManager::TimelineManager(Alloc::IAllocator * allocator, Core::IApplicati
     //creating blockscript lib for render/update callbacks type containers
     mTimelineLib = appContext->GetBlockScriptManager()->CreateBlockLib("Timeline");
     TimelineScript::RegisterTypes(mTimelineLib);
+
+    //the headers shared by timeline scripts are compiled once if they only declare types.
+    //Headers defining functions or globals (most of the render system ones) are still parsed per script
+    appContext->GetBlockScriptManager()->SetPrecompiledHeadersEnabled(true);
 }
 
 //----------------------------------------------------------------------------------------
@@ -326,6 +333,61 @@ TimelineScriptReturn TimelineManager::CreateScript()
     return scriptRef;
 }
 
+//! worker of a batch of script compilations. Compiles scripts of the batch until none is left.
+static void CompileScriptsWorker(TimelineScript* const* scripts, unsigned int count, std::atomic<unsigned int>* next, std::mutex* sharedLock)
+{
+    for (unsigned int s = next->fetch_add(1); s < count; s = next->fetch_add(1))
+    {
+        scripts[s]->CompileFromBatch(*sharedLock);
+    }
+}
+
+void TimelineManager::CompileScripts(TimelineScript* const* scripts, unsigned int count)
+{
+    unsigned int dirtyCount = 0;
+    for (unsigned int s = 0; s < count; ++s)
+    {
+        dirtyCount += scripts[s]->IsDirty() ? 1 : 0;
+    }
+
+    unsigned int threadCount = mCompileThreadCount != 0 ? mCompileThreadCount : std::thread::hardware_concurrency();
+    threadCount = threadCount > dirtyCount ? dirtyCount : threadCount;
+    if (threadCount <= 1)
+    {
+        //not worth a thread
+        for (unsigned int s = 0; s < count; ++s)
+        {
+            scripts[s]->Compile();
+        }
+        return;
+    }
+
+    for (unsigned int s = 0; s < count; ++s)
+    {
+        scripts[s]->NotifyCompilationObservers(true);
+    }
+
+    //the calling thread compiles too
+    std::atomic<unsigned int> next(0);
+    Utils::Vector<std::thread> workers(mAllocator);
+    for (unsigned int t = 1; t < threadCount; ++t)
+    {
+        workers.PushEmpty() = std::thread(CompileScriptsWorker, scripts, count, &next, &mCompileLock);
+    }
+    CompileScriptsWorker(scripts, count, &next, &mCompileLock);
+    for (unsigned int t = 0; t < workers.GetSize(); ++t)
+    {
+        workers[t].join();
+    }
+
+    PG_LOG('TMLN', "Compiled %u scripts on %u threads", dirtyCount, threadCount);
+
+    for (unsigned int s = 0; s < count; ++s)
+    {
+        scripts[s]->NotifyCompilationObservers(false);
+    }
+}
+
 TimelineSourceReturn TimelineManager::CreateHeader()
 {
     TimelineSourceRef scriptRef = PG_NEW(mAllocator, -1, "Timeline Script Header", Alloc::PG_MEM_TEMP)
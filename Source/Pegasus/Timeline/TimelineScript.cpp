@@ -19,8 +19,10 @@
 #include "Pegasus/BlockScript/IFileIncluder.h"
 #include "Pegasus/Utils/String.h"
 #include "Pegasus/Utils/Memset.h"
+#include "Pegasus/Utils/Memcpy.h"
 #include "Pegasus/Utils/Vector.h"
 #include "Pegasus/Core/Log.h"
+#include "Pegasus/Core/Time.h"
 #include "Pegasus/AssetLib/Asset.h"
 
 #if PEGASUS_ENABLE_PROXIES
@@ -35,12 +37,23 @@ using namespace Pegasus::BlockScript;
 using namespace Pegasus::Alloc;
 using namespace Pegasus::Core;
 
+//Holds the lock of a compilation batch, when the script is compiled from one
+class BatchLock
+{
+public:
+    explicit BatchLock(std::mutex* lock) : mLock(lock) { if (mLock != nullptr) mLock->lock(); }
+    ~BatchLock() { if (mLock != nullptr) mLock->unlock(); }
+
+private:
+    std::mutex* mLock;
+};
+
 //Helper class to do importing of scripts
 class ScriptIncluder : public IFileIncluder
 {
 public:
-    ScriptIncluder(TimelineScript* timelineScript, Pegasus::Timeline::TimelineManager* timelineManager)
-    : mTimelineScript(timelineScript), mTimelineManager(timelineManager) {}
+    ScriptIncluder(TimelineScript* timelineScript, Pegasus::Timeline::TimelineManager* timelineManager, std::mutex* batchLock)
+    : mTimelineScript(timelineScript), mTimelineManager(timelineManager), mBatchLock(batchLock) {}
 
     virtual ~ScriptIncluder(){}
 
@@ -51,10 +64,13 @@ public:
 private:
     TimelineScript* mTimelineScript;
     Pegasus::Timeline::TimelineManager* mTimelineManager;
+    std::mutex* mBatchLock;
 };
 
 bool ScriptIncluder::Open(const char* filePath, const char** outBuffer, int& outBufferSize)
 {
+    //headers are assets shared by the scripts of a batch
+    BatchLock lock(mBatchLock);
     TimelineSourceRef t = mTimelineManager->LoadHeader(filePath);
     if (t != nullptr)
     {
@@ -120,10 +136,12 @@ TimelineScript::TimelineScript(IAllocator* allocator, Core::IApplicationContext*
     TimelineSource(allocator),
     mSerialVersion(0),
     mScript(nullptr),
+    mReloadScript(nullptr),
     mIsDirty(true),
     mScriptActive(false),
     mAppContext(appContext),
-    mHeaders(allocator)
+    mHeaders(allocator),
+    mBatchLock(nullptr)
 #if PEGASUS_ENABLE_PROXIES
     ,mCompilationObservers(allocator)
 #endif
@@ -148,14 +166,20 @@ TimelineScript::TimelineScript(IAllocator* allocator, Core::IApplicationContext*
     {
         Pegasus::BlockScript::SystemCallbacks::gPrintFloatCallback = Pegasus_PrintFloat;
     }
-    mScript = appContext->GetBlockScriptManager()->CreateBlockScript();
-    Utils::Vector<BlockScript::BlockLib*>& libs = appContext->GetTimelineManager()->GetLibs();
+    mScript = CreateScript();
+}
+
+BlockScript::BlockScript* TimelineScript::CreateScript()
+{
+    BlockScript::BlockScript* script = mAppContext->GetBlockScriptManager()->CreateBlockScript();
+    Utils::Vector<BlockScript::BlockLib*>& libs = mAppContext->GetTimelineManager()->GetLibs();
     for (unsigned int i = 0; i < libs.GetSize(); ++i)
     {
-        mScript->IncludeLib(libs[i]);
+        script->IncludeLib(libs[i]);
     }
-    mScript->IncludeLib(appContext->GetTimelineManager()->GetTimelineLib());
-    mScript->AddCompilerEventListener(this);
+    script->IncludeLib(mAppContext->GetTimelineManager()->GetTimelineLib());
+    script->AddCompilerEventListener(this);
+    return script;
 }
 
 void TimelineScript::ClearBindPoints()
@@ -191,14 +215,28 @@ void TimelineScript::ClearHeaderList()
     mHeaders.Clear();
 }
 
-void TimelineScript::CallGlobalScopeInit(BsVmState* state)
+void TimelineScript::CallGlobalScopeInit(BsVmState* state, int budget)
 {
     if (mScriptActive)
     {
-        mScript->Run(state);
+        mScript->Run(state, budget);
     }
 }
 
+void TimelineScript::Resume(BsVmState* state, int budget)
+{
+    if (mScriptActive)
+    {
+        int output = -1; //the dummy output, same size as the one of the update
+        mScript->Resume(state, budget, &output, sizeof(output));
+    }
+}
+
+void TimelineScript::Cancel(BsVmState* state)
+{
+    mScript->Cancel(state);
+}
+
 void TimelineScript::CallGlobalScopeDestroy(BsVmState* state)
 {
     if (IsValidBindPoint(BIND_POINT_DESTROY))
@@ -218,63 +256,9 @@ bool TimelineScript::CompileInternal()
 {
     if (mScriptActive == false)
     {
-		#define __Q(x) #x
-        #define STRINGIFY(x) __Q(x)
-        static const char* defNames[] = {
-            "MAX_WINDOW_COUNT"
-        };
-        static const char* defValues[] = {
-            STRINGIFY(PEGASUS_MAX_WORLD_WINDOW_COUNT)
-        };
-        #undef STRINGIFY
-		#undef __Q
-
-        //Compilation speed optimization!
-        //So, if we keep a reference of the headers before clearing the header list, it will speed up compilation since it will keep a copy of the file in memory. Otherwise it will have to re-open and parse the file underneath, which slows down compilation significantly.
-        Utils::Vector<TimelineSourceRef> headersCopy = mHeaders;
-        ClearHeaderList();
-        ScriptIncluder includer(this, mAppContext->GetTimelineManager());
-
-#if PEGASUS_ENABLE_PROXIES
-        mScript->SetTitle(
-           GetOwnerAsset() != nullptr ? GetOwnerAsset()->GetName() : "<Untilted>"
-        );
-#endif
-        mScript->SetFileIncluder(&includer);
-        mScript->RegisterDefinitions(defNames, defValues, sizeof(defNames)/sizeof(defNames[0]));
-        mScriptActive = mScript->Compile(&mFileBuffer);
-
-        headersCopy.Clear(); //don't need the copy anymore.
-
-        mScript->SetFileIncluder(nullptr);
-        const char* types[] = { "float" }; //the only type of this functions is the beat
-
-        const struct BindPointDesc {
-            const char* functionName;
-            const char* types[10];
-            int typesCount;
-        } bindPointDescs[BIND_POINT_COUNT] = {
-            /***********************************************************************************/
-            /**/// Function name                |  parameter list     | parameter list count /**/
-            /***********************************************************************************/
-            /**/{ "Timeline_OnWindowCreated",   {"int"        },        1},                  /**/
-            /**/{ "Timeline_OnWindowDestroyed", {"int"        },        1},                  /**/
-            /**/{ "Timeline_Update",            {"UpdateInfo" },        1},                  /**/
-            /**/{ "Timeline_Render",            {"RenderInfo" },        1},                  /**/
-            /**/{ "Timeline_PostRender",        {"RenderInfo" },        1},                  /**/
-            /**/{ "Timeline_Destroy",           {/*empty*/},            0}                   /**/
-            /***********************************************************************************/
-        };
-
+        mScriptActive = CompileScript(mScript, mBindPoints);
         if (mScriptActive)
         {
-            
-            for (unsigned int bp = 0; bp < BIND_POINT_COUNT; ++bp)
-            {
-                const BindPointDesc& desc = bindPointDescs[bp];
-                mBindPoints[bp] = mScript->GetFunctionBindPoint(desc.functionName, desc.types, desc.typesCount);
-           }
-        
             ++mSerialVersion;
         }
         else
@@ -286,36 +270,208 @@ bool TimelineScript::CompileInternal()
     return mScriptActive;
 }
 
+bool TimelineScript::CompileScript(BlockScript::BlockScript* script, BlockScript::FunBindPoint* bindPoints)
+{
+    #define __Q(x) #x
+    #define STRINGIFY(x) __Q(x)
+    static const char* defNames[] = {
+        "MAX_WINDOW_COUNT"
+    };
+    static const char* defValues[] = {
+        STRINGIFY(PEGASUS_MAX_WORLD_WINDOW_COUNT)
+    };
+    #undef STRINGIFY
+    #undef __Q
+
+    //Compilation speed optimization!
+    //So, if we keep a reference of the headers before clearing the header list, it will speed up compilation since it will keep a copy of the file in memory. Otherwise it will have to re-open and parse the file underneath, which slows down compilation significantly.
+    Utils::Vector<TimelineSourceRef> headersCopy(mAllocator);
+    {
+        BatchLock lock(mBatchLock);
+        headersCopy = mHeaders;
+        ClearHeaderList();
+    }
+    ScriptIncluder includer(this, mAppContext->GetTimelineManager(), mBatchLock);
+
+#if PEGASUS_ENABLE_PROXIES
+    script->SetTitle(
+       GetOwnerAsset() != nullptr ? GetOwnerAsset()->GetName() : "<Untilted>"
+    );
+#endif
+    script->SetFileIncluder(&includer);
+    script->RegisterDefinitions(defNames, defValues, sizeof(defNames)/sizeof(defNames[0]));
+    bool success = script->Compile(&mFileBuffer);
+
+    {
+        BatchLock lock(mBatchLock);
+        headersCopy.Clear(); //don't need the copy anymore.
+    }
+
+    script->SetFileIncluder(nullptr);
+    const char* types[] = { "float" }; //the only type of this functions is the beat
+
+    const struct BindPointDesc {
+        const char* functionName;
+        const char* types[10];
+        int typesCount;
+    } bindPointDescs[BIND_POINT_COUNT] = {
+        /***********************************************************************************/
+        /**/// Function name                |  parameter list     | parameter list count /**/
+        /***********************************************************************************/
+        /**/{ "Timeline_OnWindowCreated",   {"int"        },        1},                  /**/
+        /**/{ "Timeline_OnWindowDestroyed", {"int"        },        1},                  /**/
+        /**/{ "Timeline_Update",            {"UpdateInfo" },        1},                  /**/
+        /**/{ "Timeline_Render",            {"RenderInfo" },        1},                  /**/
+        /**/{ "Timeline_PostRender",        {"RenderInfo" },        1},                  /**/
+        /**/{ "Timeline_Destroy",           {/*empty*/},            0}                   /**/
+        /***********************************************************************************/
+    };
+
+    if (success)
+    {
+        for (unsigned int bp = 0; bp < BIND_POINT_COUNT; ++bp)
+        {
+            const BindPointDesc& desc = bindPointDescs[bp];
+            bindPoints[bp] = script->GetFunctionBindPoint(desc.functionName, desc.types, desc.typesCount);
+        }
+
+#if PEGASUS_ENABLE_PROXIES
+        BlockScript::Assembly assembly = script->GetAsm();
+        PG_LOG('TMLN', "%s: %d of %d array bounds checks removed", GetDisplayName(), assembly.mProvenAccessCount, assembly.mProvenAccessCount + assembly.mCheckedAccessCount);
+#endif
+    }
+    return success;
+}
+
 void TimelineScript::Compile()
 {
 #if PEGASUS_ENABLE_PROXIES
-    //Once compilation is done, go ahead and call all observers
-    for (unsigned int i = 0; i < mCompilationObservers.GetSize(); ++i)
+    if (mIsDirty && mScriptActive)
     {
-        mCompilationObservers[i]->OnCompilationBegin();
+        HotReload();
+        return;
     }
 #endif
 
+    NotifyCompilationObservers(true);
+
     if (mIsDirty)
     {
         Shutdown();
         CompileInternal();
     }
 
+    NotifyCompilationObservers(false);
+}
+
+void TimelineScript::CompileFromBatch(std::mutex& sharedLock)
+{
+    if (mIsDirty)
+    {
+        mBatchLock = &sharedLock;
+        Shutdown();
+        CompileInternal();
+        mBatchLock = nullptr;
+    }
+}
+
+#if PEGASUS_ENABLE_PROXIES
+void TimelineScript::HotReload()
+{
+    Core::UpdatePegasusTime();
+    double startTime = Core::GetPegasusTime();
+
+    //the running script stays untouched until the edit is compiled
+    if (mReloadScript == nullptr)
+    {
+        mReloadScript = CreateScript();
+    }
+
+    //blocks can include their own libraries on the running script
+    const Utils::Vector<BlockScript::BlockLib*>& libs = mScript->GetLibs();
+    const Utils::Vector<BlockScript::BlockLib*>& reloadLibs = mReloadScript->GetLibs();
+    for (unsigned int i = 0; i < libs.GetSize(); ++i)
+    {
+        bool included = false;
+        for (unsigned int j = 0; j < reloadLibs.GetSize() && !included; ++j)
+        {
+            included = reloadLibs[j] == libs[i];
+        }
+        if (!included)
+        {
+            mReloadScript->IncludeLib(libs[i]);
+        }
+    }
+    BlockScript::FunBindPoint bindPoints[BIND_POINT_COUNT];
+    bool success = CompileScript(mReloadScript, bindPoints);
+    int changedFunctions = success ? mReloadScript->GetSignature().CountChangedFunctions(mScript->GetSignature()) : -1;
+
+    if (changedFunctions >= 0)
+    {
+        //same globals and types: swap the code under the running states
+        BlockScript::BlockScript* previous = mScript;
+        mScript = mReloadScript;
+        mReloadScript = previous;
+        Utils::Memcpy(mBindPoints, bindPoints, sizeof(mBindPoints));
+        mIsDirty = false;
+        for (unsigned int i = 0; i < mCompilationObservers.GetSize(); ++i)
+        {
+            mCompilationObservers[i]->OnFunctionsReloaded(previous);
+        }
+        mReloadScript->Reset();
+
+        Core::UpdatePegasusTime();
+        PG_LOG('TMLN', "Hot reloaded %d function(s) of %s in %.3f ms, state kept", changedFunctions, GetDisplayName(), 1000.0 * (Core::GetPegasusTime() - startTime));
+        return;
+    }
+
+    //globals or types changed, or the edit does not compile: the states start over
+    NotifyCompilationObservers(true);
+    Shutdown();
+    if (success)
+    {
+        BlockScript::BlockScript* previous = mScript;
+        mScript = mReloadScript;
+        mReloadScript = previous;
+        Utils::Memcpy(mBindPoints, bindPoints, sizeof(mBindPoints));
+        mScriptActive = true;
+        ++mSerialVersion;
+    }
+    else
+    {
+        mReloadScript->Reset();
+    }
+    mIsDirty = false;
+    NotifyCompilationObservers(false);
+
+    Core::UpdatePegasusTime();
+    PG_LOG('TMLN', "Reloaded %s in %.3f ms, %s", GetDisplayName(), 1000.0 * (Core::GetPegasusTime() - startTime), success ? "globals or types changed, state reset" : "compilation failed");
+}
+#endif
+
+void TimelineScript::NotifyCompilationObservers(bool begin)
+{
 #if PEGASUS_ENABLE_PROXIES
-    //Once compilation is done, go ahead and call all observers
     for (unsigned int i = 0; i < mCompilationObservers.GetSize(); ++i)
     {
-        mCompilationObservers[i]->OnCompilationEnd();
+        if (begin)
+        {
+            mCompilationObservers[i]->OnCompilationBegin();
+        }
+        else
+        {
+            //Once compilation is done, go ahead and call all observers
+            mCompilationObservers[i]->OnCompilationEnd();
+        }
     }
 #endif
 }
 
-void TimelineScript::CallFunction(BsVmState* state, TimelineScript::BindPoint funct, const void* inputBuffer, unsigned inputBufferSz, void* outputBuffer, unsigned outputBufferSz)
+void TimelineScript::CallFunction(BsVmState* state, TimelineScript::BindPoint funct, const void* inputBuffer, unsigned inputBufferSz, void* outputBuffer, unsigned outputBufferSz, int budget)
 {
     if (IsValidBindPoint(funct))
     {
-        bool res = mScript->ExecuteFunction(state, mBindPoints[funct], inputBuffer, inputBufferSz, &outputBuffer, outputBufferSz);
+        bool res = mScript->ExecuteFunction(state, mBindPoints[funct], inputBuffer, inputBufferSz, &outputBuffer, outputBufferSz, budget);
         if (!res)
        {
 #if PEGASUS_ENABLE_PROXIES
@@ -325,10 +481,10 @@ void TimelineScript::CallFunction(BsVmState* state, TimelineScript::BindPoint fu
     }
 }
 
-void TimelineScript::CallUpdate(const UpdateInfo& updateInfo, BsVmState* state)
+void TimelineScript::CallUpdate(const UpdateInfo& updateInfo, BsVmState* state, int budget)
 {
     int output = -1;
-    CallFunction(state, BIND_POINT_UPDATE, &updateInfo, sizeof(updateInfo), &output, sizeof(output));
+    CallFunction(state, BIND_POINT_UPDATE, &updateInfo, sizeof(updateInfo), &output, sizeof(output), budget);
 }
 
 void TimelineScript::CallRender(const RenderInfo& renderInfo, BsVmState* state)
@@ -353,10 +509,15 @@ TimelineScript::~TimelineScript()
 {
     ClearHeaderList();
     mAppContext->GetBlockScriptManager()->DestroyBlockScript(mScript);
+    if (mReloadScript != nullptr)
+    {
+        mAppContext->GetBlockScriptManager()->DestroyBlockScript(mReloadScript);
+    }
 }
 
 void TimelineScript::OnCompilationBegin()
 {
+    BatchLock lock(mBatchLock);
 #if PEGASUS_ENABLE_PROXIES
     PG_LOG('TMLN', "Compilation started for blockscript: %s", GetDisplayName());    
 #endif
@@ -374,6 +535,7 @@ void TimelineScript::OnCompilationBegin()
 
 void TimelineScript::OnCompilationError(const char* compilationUnitTitle, int line, const char* errorMessage, const char* token)
 {
+    BatchLock lock(mBatchLock);
     PG_LOG('CERR', "[%s:%d]: %s. Around token %s", compilationUnitTitle, line, errorMessage, token);
 
     PEGASUS_EVENT_DISPATCH(
@@ -389,6 +551,7 @@ void TimelineScript::OnCompilationError(const char* compilationUnitTitle, int li
 
 void TimelineScript::OnCompilationEnd(bool success)
 {
+    BatchLock lock(mBatchLock);
     if (success)
     {
 #if PEGASUS_ENABLE_PROXIES
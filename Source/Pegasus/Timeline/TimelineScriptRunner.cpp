@@ -17,6 +17,15 @@
 #include "Pegasus/PropertyGrid/Shared/PropertyEventDefs.h"
 #include "Pegasus/Application/RenderCollection.h"
 #include "Pegasus/Utils/Memset.h"
+#include "Pegasus/Core/Time.h"
+#include "Pegasus/BlockScript/BsVm.h"
+#if PEGASUS_ENABLE_PROXIES
+#include "Pegasus/BlockScript/BsProfiler.h"
+#include "Pegasus/BlockScript/BsVmSnapshot.h"
+
+//! default number of beats in between snapshots of the state of a script
+#define TIMELINE_SCRIPT_SNAPSHOT_INTERVAL 4.0f
+#endif
 
 #if PEGASUS_ASSETLIB_ENABLE_CATEGORIES
 #include "Pegasus/AssetLib/Category.h"
@@ -67,8 +76,18 @@ namespace Timeline
     , mVmState(nullptr)
     , mGlobalCache(nullptr)
     , mControlGlobalCacheReset(false)
+    , mFrameBudget(0.0f)
+    , mFrameStartTime(0.0)
 #if PEGASUS_ASSETLIB_ENABLE_CATEGORIES
     , mCategory(category)
+#endif
+#if PEGASUS_ENABLE_PROXIES
+    , mProfiler(nullptr)
+    , mProfilerEnabled(false)
+    , mSnapshots(allocator)
+    , mSnapshotInterval(TIMELINE_SCRIPT_SNAPSHOT_INTERVAL)
+    , mLastUpdateBeat(0.0f)
+    , mLastRestoreTime(0.0)
 #endif
     {
 #if PEGASUS_ENABLE_PROXIES
@@ -79,8 +98,10 @@ namespace Timeline
     TimelineScriptRunner::~TimelineScriptRunner()
     {
 #if PEGASUS_ENABLE_PROXIES
+        ClearSnapshots();
         if (mTimelineScript != nullptr)
         {
+            CancelExecution();
             mTimelineScript->CallGlobalScopeDestroy(mVmState);
             mTimelineScript->UnregisterObserver(&mBlockScriptObserver);
             mTimelineScript = nullptr;
@@ -94,6 +115,11 @@ namespace Timeline
             PG_DELETE(mAllocator, mVmState);
             mVmState = nullptr;
         }
+        if (mProfiler != nullptr)
+        {
+            PG_DELETE(mAllocator, mProfiler);
+            mProfiler = nullptr;
+        }
 #endif
     }
 
@@ -115,6 +141,9 @@ namespace Timeline
                 mVmState->Initialize(mAllocator);
                 Application::RenderCollection* userContext = mAppContext->GetRenderCollectionFactory()->CreateRenderCollection();
                 mVmState->SetUserContext(userContext);
+#if PEGASUS_ENABLE_PROXIES
+                mVmState->SetProfiler(mProfilerEnabled ? mProfiler : nullptr);
+#endif
             }
         }
         else
@@ -145,6 +174,11 @@ namespace Timeline
         {
 #if PEGASUS_ENABLE_PROXIES
             mTimelineScript->UnregisterObserver(&mBlockScriptObserver);
+            if (mProfiler != nullptr)
+            {
+                mProfiler->Reset();
+            }
+            ClearSnapshots();
 #endif
             if (mVmState != nullptr)
             {
@@ -166,6 +200,9 @@ namespace Timeline
         if (HasScript() && mScriptVersion != mTimelineScript->GetSerialVersion() && mTimelineScript->IsScriptActive())
         {
             mScriptVersion = mTimelineScript->GetSerialVersion();
+#if PEGASUS_ENABLE_PROXIES
+            ClearSnapshots();
+#endif
 
             if (mVmState->GetUserContext() != nullptr)
             {
@@ -176,38 +213,92 @@ namespace Timeline
             }
             mVmState->Reset();
 
-            //just listen for runtime events on the global scope initialization
-            mVmState->SetRuntimeListener(&mRuntimeListener);
-            //re-initialize everything!
+            //A live edit can have replaced the block script
+            mRuntimeListener.Initialize(mPropertyGrid, mTimelineScript->GetBlockScript());
+
+            //re-initialize everything! With a frame budget, the rest of the global scope can run on the next updates
+            RunGlobalScope(useCategories);
+
+            //restart initialization of all windows
+#if PEGASUS_ENABLE_PROXIES
+            Utils::Memset8(mWindowIsInitialized, 0, sizeof(mWindowIsInitialized));
+#endif
+        }
+    }
+
+    void TimelineScriptRunner::RunGlobalScope(bool useCategories)
+    {
+        //just listen for runtime events on the global scope initialization
+        mVmState->SetRuntimeListener(&mRuntimeListener);
 #if PEGASUS_ASSETLIB_ENABLE_CATEGORIES
-            if (useCategories) mAppContext->GetAssetLib()->BeginCategory(mCategory);
+        if (useCategories) mAppContext->GetAssetLib()->BeginCategory(mCategory);
 #endif
 
 #if PEGASUS_ENABLE_SCRIPT_PERMISSIONS
-            
-            static_cast<Application::RenderCollection*>(mVmState->GetUserContext())->SetPermissions(GetGlobalScopePermissions(mControlGlobalCacheReset));
+        static_cast<Application::RenderCollection*>(mVmState->GetUserContext())->SetPermissions(GetGlobalScopePermissions(mControlGlobalCacheReset));
 #endif
-            mTimelineScript->CallGlobalScopeInit(mVmState); 
+        if (mVmState->IsSuspended())
+        {
+            mTimelineScript->Resume(mVmState, GetSliceBudget());
+        }
+        else
+        {
+            mTimelineScript->CallGlobalScopeInit(mVmState, GetSliceBudget());
+        }
+        ResumeOnBudget();
 
 #if PEGASUS_ASSETLIB_ENABLE_CATEGORIES
-            if (useCategories) mAppContext->GetAssetLib()->EndCategory();
+        if (useCategories) mAppContext->GetAssetLib()->EndCategory();
 #endif
 
-            // remove the listener. No need to listen for more events.
-            mVmState->SetRuntimeListener(nullptr);
+        // remove the listener. No need to listen for more events.
+        mVmState->SetRuntimeListener(nullptr);
+    }
 
-            //restart initialization of all windows
-#if PEGASUS_ENABLE_PROXIES
-            Utils::Memset8(mWindowIsInitialized, 0, sizeof(mWindowIsInitialized));
-#endif
+    void TimelineScriptRunner::ResumeOnBudget()
+    {
+        //a yield gives the rest of the frame back, running out of a slice only means it is time to check the clock
+        while (mVmState->IsSuspended() && !mVmState->IsSuspendedByCallback())
+        {
+            Core::UpdatePegasusTime();
+            if (1000.0 * (Core::GetPegasusTime() - mFrameStartTime) >= static_cast<double>(mFrameBudget))
+            {
+                break;
+            }
+            mTimelineScript->Resume(mVmState, GetSliceBudget());
+        }
+    }
+
+    void TimelineScriptRunner::CancelExecution()
+    {
+        if (mVmState != nullptr && mVmState->IsSuspended())
+        {
+            if (mVmState->GetResumeStackLevel() < 0)
+            {
+                mScriptVersion = -1; //the globals are half initialized, run them again
+            }
+            mTimelineScript->Cancel(mVmState);
         }
     }
 
     void TimelineScriptRunner::UninitializeScript()
     {
+#if PEGASUS_ENABLE_PROXIES
+        //the assembly profiled is about to be recompiled or replaced
+        if (mProfiler != nullptr)
+        {
+            mProfiler->Reset();
+        }
+        ClearSnapshots();
+#endif
 #if PEGASUS_ASSETLIB_ENABLE_CATEGORIES        
         mCategory->RemoveAssets();
 #endif
+        if (mTimelineScript != nullptr)
+        {
+            CancelExecution();
+        }
+
         //TODO: remove this global scope destroy stuff
         if (mTimelineScript != nullptr && mTimelineScript->IsDirty())
         {
@@ -241,19 +332,61 @@ namespace Timeline
     {
         if (mTimelineScript != nullptr)
         {
-            InitializeScript(); //in case a dirty compilation has been carried on.
+            if (mFrameBudget > 0.0f)
+            {
+                Core::UpdatePegasusTime();
+                mFrameStartTime = Core::GetPegasusTime();
+            }
+
+#if PEGASUS_ENABLE_PROXIES
+            //seeking backwards rewinds the state to the nearest snapshot, the update replays from there
+            if (updateInfo.beat < mLastUpdateBeat && mScriptVersion == mTimelineScript->GetSerialVersion() && !mVmState->IsSuspended())
+            {
+                RestoreSnapshot(updateInfo.beat);
+            }
+            mLastUpdateBeat = updateInfo.beat;
+#endif
+
             Application::RenderCollection* nodeContainer = static_cast<Application::RenderCollection*>(mVmState->GetUserContext());
+            if (mVmState->IsSuspended() && mScriptVersion == mTimelineScript->GetSerialVersion())
+            {
+                //the execution suspended on an earlier frame goes on, nothing new starts until it is done
+                if (mVmState->GetResumeStackLevel() < 0)
+                {
+                    RunGlobalScope(true);
+                }
+                else
+                {
 #if PEGASUS_ENABLE_SCRIPT_PERMISSIONS
-            nodeContainer->SetPermissions(Application::PERMISSIONS_DEFAULT);
+                    nodeContainer->SetPermissions(Application::PERMISSIONS_DEFAULT);
 #endif
-            mTimelineScript->CallUpdate(updateInfo, mVmState);
+                    mTimelineScript->Resume(mVmState, GetSliceBudget());
+                    ResumeOnBudget();
+                }
+            }
+            else
+            {
+                InitializeScript(); //in case a dirty compilation has been carried on.
+                if (!mVmState->IsSuspended())
+                {
+#if PEGASUS_ENABLE_PROXIES
+                    CaptureSnapshot(updateInfo.beat);
+#endif
+#if PEGASUS_ENABLE_SCRIPT_PERMISSIONS
+                    nodeContainer->SetPermissions(Application::PERMISSIONS_DEFAULT);
+#endif
+                    mTimelineScript->CallUpdate(updateInfo, mVmState, GetSliceBudget());
+                    ResumeOnBudget();
+                }
+            }
             nodeContainer->UpdateAll();
         }
     }
 
     void TimelineScriptRunner::CallRender(const RenderInfo& renderInfo)
     {
-        if (mTimelineScript != nullptr)
+        //a suspended script renders again once it is done
+        if (mTimelineScript != nullptr && !mVmState->IsSuspended())
         {
 #if PEGASUS_ENABLE_PROXIES
             if (!mWindowIsInitialized[renderInfo.windowId])
@@ -274,6 +407,11 @@ namespace Timeline
 
     void TimelineScriptRunner::CallWindowCreated(int windowIndex)
     {
+        //a suspended script creates its windows on the first render once it is done
+        if (IsSuspended())
+        {
+            return;
+        }
 #if PEGASUS_ENABLE_PROXIES
         mWindowIsInitialized[windowIndex] = true;
 #endif
@@ -294,7 +432,7 @@ namespace Timeline
 #if PEGASUS_ENABLE_PROXIES
         mWindowIsInitialized[windowIndex] = false;
 #endif
-        if (mTimelineScript != nullptr)
+        if (mTimelineScript != nullptr && !mVmState->IsSuspended())
         {
 #if PEGASUS_ENABLE_SCRIPT_PERMISSIONS
             Application::RenderCollection* nodeContainer = static_cast<Application::RenderCollection*>(mVmState->GetUserContext());
@@ -311,6 +449,89 @@ namespace Timeline
 
 
 #if PEGASUS_ENABLE_PROXIES
+    void TimelineScriptRunner::EnableProfiler(bool enable)
+    {
+        if (enable && mProfiler == nullptr)
+        {
+            mProfiler = PG_NEW(mAllocator, -1, "Script Profiler", Pegasus::Alloc::PG_MEM_PERM) BlockScript::BsProfiler(mAllocator);
+        }
+        mProfilerEnabled = enable;
+        if (mVmState != nullptr)
+        {
+            mVmState->SetProfiler(enable ? mProfiler : nullptr);
+        }
+    }
+
+    void TimelineScriptRunner::SetSnapshotInterval(float beats)
+    {
+        mSnapshotInterval = beats > 0.0f ? beats : 0.0f;
+        ClearSnapshots();
+    }
+
+    int TimelineScriptRunner::GetSnapshotByteSize() const
+    {
+        int byteSize = 0;
+        for (unsigned int i = 0; i < mSnapshots.GetSize(); ++i)
+        {
+            byteSize += mSnapshots[i].mSnapshot->GetByteSize();
+        }
+        return byteSize;
+    }
+
+    void TimelineScriptRunner::CaptureSnapshot(float beat)
+    {
+        if (mSnapshotInterval <= 0.0f || !mTimelineScript->IsScriptActive())
+        {
+            return;
+        }
+
+        //only the timeline playing past the last snapshot takes new ones, so they stay sorted
+        const BlockScript::BsVmSnapshot* previous = nullptr;
+        if (mSnapshots.GetSize() > 0)
+        {
+            const StateSnapshot& last = mSnapshots[mSnapshots.GetSize() - 1];
+            if (beat < last.mBeat + mSnapshotInterval)
+            {
+                return;
+            }
+            previous = last.mSnapshot;
+        }
+
+        StateSnapshot& snapshot = mSnapshots.PushEmpty();
+        snapshot.mBeat = beat;
+        snapshot.mSnapshot = PG_NEW(mAllocator, -1, "Script Snapshot", Pegasus::Alloc::PG_MEM_TEMP) BlockScript::BsVmSnapshot(mAllocator);
+        snapshot.mSnapshot->Capture(*mVmState, previous);
+    }
+
+    void TimelineScriptRunner::RestoreSnapshot(float beat)
+    {
+        for (int i = static_cast<int>(mSnapshots.GetSize()) - 1; i >= 0; --i)
+        {
+            if (mSnapshots[i].mBeat <= beat)
+            {
+                Core::UpdatePegasusTime();
+                double startTime = Core::GetPegasusTime();
+                mSnapshots[i].mSnapshot->Restore(*mVmState);
+                Core::UpdatePegasusTime();
+                mLastRestoreTime = 1000.0 * (Core::GetPegasusTime() - startTime);
+                return;
+            }
+        }
+
+        //no snapshot that early, the globals get initialized again and the update replays from the start
+        mVmState->Reset();
+        mScriptVersion = -1;
+    }
+
+    void TimelineScriptRunner::ClearSnapshots()
+    {
+        for (unsigned int i = 0; i < mSnapshots.GetSize(); ++i)
+        {
+            PG_DELETE(mAllocator, mSnapshots[i].mSnapshot);
+        }
+        mSnapshots.Clear();
+    }
+
     void TimelineScriptRunner::BlockScriptObserver::OnCompilationBegin()
     {
         //try to initialize the script. Compile wont call this observer stuff again since it is not dirty.
@@ -321,6 +542,28 @@ namespace Timeline
         //try to initialize the script. Compile wont call this observer stuff again since it is not dirty.
         mRunner->InitializeScript();
     }
+
+    void TimelineScriptRunner::BlockScriptObserver::OnFunctionsReloaded(BlockScript::BlockScript* previous)
+    {
+        mRunner->RebindState(previous);
+    }
+
+    void TimelineScriptRunner::RebindState(BlockScript::BlockScript* previous)
+    {
+        //the assembly profiled is replaced
+        if (mProfiler != nullptr)
+        {
+            mProfiler->Reset();
+        }
+
+        //a suspended execution would resume in the middle of the code replaced
+        CancelExecution();
+
+        //globals, heap and render collection stay as they are, only the code underneath changes
+        BlockScript::BlockScript* script = mTimelineScript->GetBlockScript();
+        script->RebindState(*mVmState, *previous);
+        mRuntimeListener.Initialize(mPropertyGrid, script);
+    }
 #endif
 
 }
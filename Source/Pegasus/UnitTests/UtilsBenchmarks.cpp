@@ -0,0 +1,538 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                    Pegasus Unit Tests                                */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file   UtilsBenchmarks.cpp
+//! \author agent
+//! \date   16th October 2026
+//! \brief  Pegasus microbenchmarks for the Utils package, implementation
+
+#include "Pegasus/Memory/MallocFreeAllocator.h"
+#include "Pegasus/Memory/ThreadCacheAllocator.h"
+#include "Pegasus/UnitTests/UtilsBenchmarks.h"
+#include "Pegasus/Allocator/Alloc.h"
+#include "Pegasus/Core/SystemMemory.h"
+#include "Pegasus/Core/Time.h"
+#include "Pegasus/Utils/HashMap.h"
+#include "Pegasus/Utils/Memcpy.h"
+#include "Pegasus/Utils/Memset.h"
+#include "Pegasus/Utils/Simd.h"
+#include "Pegasus/Utils/Vector.h"
+#include <atomic>
+#include <thread>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static Pegasus::Memory::MallocFreeAllocator sBenchmarkAllocator(0);
+
+//! buffer sizes the memory benchmarks run at: in L1, in L2, out of cache and large enough for non temporal stores
+static const unsigned int sMemorySizes[] = { 64, 4 * 1024, 256 * 1024, 16 * 1024 * 1024 };
+static const int MEMORY_SIZE_COUNT = sizeof(sMemorySizes) / sizeof(sMemorySizes[0]);
+
+//! bytes processed per measure, divided in as many calls as the buffer size requires
+static const double MEMORY_BENCHMARK_BYTESIZE = 256.0 * 1024.0 * 1024.0;
+
+//! room for the misaligned and overlapping runs after the largest buffer
+static const unsigned int MEMORY_BUFFER_PADDING = 256;
+
+//! key counts the lookup benchmarks run at
+static const unsigned int sLookupSizes[] = { 16, 256, 4096 };
+static const int LOOKUP_SIZE_COUNT = sizeof(sLookupSizes) / sizeof(sLookupSizes[0]);
+
+//! lookups measured per key count
+static const unsigned int LOOKUP_COUNT = 100000;
+
+//! longest key name of the string lookup benchmarks
+static const int LOOKUP_NAME_LENGTH = 32;
+
+//! element counts the vector benchmarks run at
+static const unsigned int sVectorSizes[] = { 1000, 100000, 10000000 };
+static const int VECTOR_SIZE_COUNT = sizeof(sVectorSizes) / sizeof(sVectorSizes[0]);
+
+//! number of inserts and deletes measured per size. Each one shifts the whole vector, so they are not repeated n times
+static const unsigned int VECTOR_SHIFT_COUNT = 100;
+
+//! thread counts the allocator benchmarks run at
+static const int sAllocatorThreadCounts[] = { 1, 2, 4, 8 };
+static const int ALLOCATOR_THREAD_COUNT_COUNT = sizeof(sAllocatorThreadCounts) / sizeof(sAllocatorThreadCounts[0]);
+
+//! allocations and frees measured per thread
+static const unsigned int ALLOCATOR_OPERATIONS_PER_THREAD = 1000000;
+
+//! blocks each thread of the allocator benchmarks keeps alive, replaced at random
+static const unsigned int ALLOCATOR_LIVE_BLOCKS = 4096;
+
+//! slots a thread hands blocks to the next thread through, for it to free them
+static const unsigned int ALLOCATOR_MAILBOX_SIZE = 256;
+
+//! element that is not plain old data, moved one by one when the vector relocates it
+struct BenchmarkElement
+{
+    BenchmarkElement() : mValue(0), mPadding(0) {}
+    BenchmarkElement(const BenchmarkElement& other) : mValue(other.mValue), mPadding(other.mPadding) {}
+    BenchmarkElement& operator=(const BenchmarkElement& other) { mValue = other.mValue; mPadding = other.mPadding; return *this; }
+    ~BenchmarkElement() {}
+
+    int mValue;
+    int mPadding;
+};
+
+//! \return the current time in milliseconds
+static double GetTimeMs()
+{
+    Pegasus::Core::UpdatePegasusTime();
+    return 1000.0 * Pegasus::Core::GetPegasusTime();
+}
+
+//! prints one line of results
+static void PrintResult(const char* title, const char* typeName, unsigned int size, unsigned int operations, double ms)
+{
+    printf("%-8s %-8s n = %-9u %9.3f ms total %12.3f ns / op\n", title, typeName, size, ms, 1000000.0 * ms / static_cast<double>(operations));
+}
+
+typedef void* (*CopyFunc)(void* destination, const void* source, unsigned int count);
+typedef void* (*SetFunc)(void* destination, char value, unsigned int size);
+
+static void* LibcMemcpy(void* destination, const void* source, unsigned int count) { return memcpy(destination, source, count); }
+static void* LibcMemmove(void* destination, const void* source, unsigned int count) { return memmove(destination, source, count); }
+static void* LibcMemset(void* destination, char value, unsigned int size) { return memset(destination, value, size); }
+
+//! prints the throughput of one memory benchmark
+static void PrintThroughput(const char* title, const char* implementation, unsigned int size, const char* variant, double bytes, double ms)
+{
+    printf("%-8s %-7s %9u bytes %-10s %8.2f GB/s\n", title, implementation, size, variant, bytes / (ms * 1000000.0));
+}
+
+//! Times a copy function over all sizes
+//! \param dstOffset offset of the destination from the start of its buffer
+//! \param srcOffset offset of the source from the start of its buffer, or of the destination buffer to overlap it
+static void BenchmarkCopyFunc(const char* title, const char* implementation, CopyFunc func, char* dst, char* src, unsigned int dstOffset, unsigned int srcOffset, const char* variant)
+{
+    for (int s = 0; s < MEMORY_SIZE_COUNT; ++s)
+    {
+        const unsigned int size = sMemorySizes[s];
+        const int iterations = static_cast<int>(MEMORY_BENCHMARK_BYTESIZE / size);
+        double start = GetTimeMs();
+        for (int i = 0; i < iterations; ++i)
+        {
+            func(dst + dstOffset, src + srcOffset, size);
+        }
+        PrintThroughput(title, implementation, size, variant, static_cast<double>(iterations) * size, GetTimeMs() - start);
+    }
+}
+
+//! Times a set function over all sizes
+static void BenchmarkSetFunc(const char* implementation, SetFunc func, char* dst)
+{
+    for (int s = 0; s < MEMORY_SIZE_COUNT; ++s)
+    {
+        const unsigned int size = sMemorySizes[s];
+        const int iterations = static_cast<int>(MEMORY_BENCHMARK_BYTESIZE / size);
+        double start = GetTimeMs();
+        for (int i = 0; i < iterations; ++i)
+        {
+            func(dst, static_cast<char>(i), size);
+        }
+        PrintThroughput("memset", implementation, size, "", static_cast<double>(iterations) * size, GetTimeMs() - start);
+    }
+}
+
+//! \return a buffer big enough for the largest memory benchmark
+static char* AllocMemoryBuffer()
+{
+    const unsigned int byteSize = sMemorySizes[MEMORY_SIZE_COUNT - 1] + MEMORY_BUFFER_PADDING;
+    char* buffer = PG_NEW_ARRAY(&sBenchmarkAllocator, -1, "Benchmark buffer", Pegasus::Alloc::PG_MEM_TEMP, char, byteSize);
+    memset(buffer, 1, byteSize);
+    return buffer;
+}
+
+//! \return the key looked up by a lookup, every key is hit
+static unsigned int GetLookupKey(unsigned int lookup, unsigned int keyCount)
+{
+    return (lookup * 7919) % keyCount;
+}
+
+static int CompareInts(const void* a, const void* b)
+{
+    const int ia = *static_cast<const int*>(a);
+    const int ib = *static_cast<const int*>(b);
+    return ia < ib ? -1 : (ia > ib ? 1 : 0);
+}
+
+static int CompareStrings(const void* a, const void* b)
+{
+    return Pegasus::Utils::Strcmp(*static_cast<const char* const*>(a), *static_cast<const char* const*>(b));
+}
+
+//! prints the time of one lookup benchmark
+static void PrintLookupResult(const char* title, const char* implementation, unsigned int keyCount, int checksum, double ms)
+{
+    printf("%-8s %-16s %6u keys %10.2f ns / lookup (checksum %d)\n", title, implementation, keyCount, 1000000.0 * ms / LOOKUP_COUNT, checksum);
+}
+
+template<class T>
+static void FillVector(Pegasus::Utils::Vector<T>& v, unsigned int size)
+{
+    for (unsigned int i = 0; i < size; ++i)
+    {
+        v.PushEmpty();
+    }
+}
+
+template<class T>
+static void BenchmarkPush(const char* typeName)
+{
+    for (int s = 0; s < VECTOR_SIZE_COUNT; ++s)
+    {
+        Pegasus::Utils::Vector<T> v(&sBenchmarkAllocator);
+        double start = GetTimeMs();
+        FillVector(v, sVectorSizes[s]);
+        PrintResult("push", typeName, sVectorSizes[s], sVectorSizes[s], GetTimeMs() - start);
+    }
+}
+
+template<class T>
+static void BenchmarkInsert(const char* typeName)
+{
+    for (int s = 0; s < VECTOR_SIZE_COUNT; ++s)
+    {
+        Pegasus::Utils::Vector<T> v(&sBenchmarkAllocator);
+        FillVector(v, sVectorSizes[s]);
+        double start = GetTimeMs();
+        for (unsigned int i = 0; i < VECTOR_SHIFT_COUNT; ++i)
+        {
+            v.Insert(v.GetSize() / 2);
+        }
+        PrintResult("insert", typeName, sVectorSizes[s], VECTOR_SHIFT_COUNT, GetTimeMs() - start);
+    }
+}
+
+template<class T>
+static void BenchmarkDelete(const char* typeName)
+{
+    for (int s = 0; s < VECTOR_SIZE_COUNT; ++s)
+    {
+        Pegasus::Utils::Vector<T> v(&sBenchmarkAllocator);
+        FillVector(v, sVectorSizes[s]);
+        double start = GetTimeMs();
+        for (unsigned int i = 0; i < VECTOR_SHIFT_COUNT; ++i)
+        {
+            v.Delete(v.GetSize() / 2);
+        }
+        PrintResult("delete", typeName, sVectorSizes[s], VECTOR_SHIFT_COUNT, GetTimeMs() - start);
+    }
+}
+
+template<class T>
+static void BenchmarkCopy(const char* typeName)
+{
+    for (int s = 0; s < VECTOR_SIZE_COUNT; ++s)
+    {
+        Pegasus::Utils::Vector<T> v(&sBenchmarkAllocator);
+        FillVector(v, sVectorSizes[s]);
+        double start = GetTimeMs();
+        Pegasus::Utils::Vector<T> copy(v);
+        PrintResult("copy", typeName, sVectorSizes[s], sVectorSizes[s], GetTimeMs() - start);
+    }
+}
+
+//! Job of a thread of the allocator benchmarks
+struct AllocatorBenchmarkJob
+{
+    Pegasus::Alloc::IAllocator* mAllocator;
+    std::atomic<void*>* mMailbox;     //!< blocks of the previous thread, freed by this one
+    std::atomic<void*>* mNextMailbox; //!< blocks given to the next thread
+    unsigned int mSeed;
+};
+
+//! Replaces live blocks of random sizes, mostly small. One block in four is freed by the next thread.
+static void AllocatorBenchmarkThread(AllocatorBenchmarkJob* job)
+{
+    Pegasus::Alloc::IAllocator* allocator = job->mAllocator;
+    void* live[ALLOCATOR_LIVE_BLOCKS] = {};
+    unsigned int random = job->mSeed;
+    for (unsigned int i = 0; i < ALLOCATOR_OPERATIONS_PER_THREAD; ++i)
+    {
+        random ^= random << 13;
+        random ^= random >> 17;
+        random ^= random << 5;
+        const size_t size = (random & 0xf000) == 0 ? 256 + (random >> 20) % 3840 : 16 + (random >> 24);
+        void* block = allocator->Alloc(size, Pegasus::Alloc::PG_MEM_TEMP);
+        *static_cast<char*>(block) = static_cast<char>(i);
+
+        if ((i & 3) == 0)
+        {
+            // The slot still holds the block of the last pass if the next thread did not take it
+            void* previous = job->mNextMailbox[(i >> 2) % ALLOCATOR_MAILBOX_SIZE].exchange(block, std::memory_order_acq_rel);
+            allocator->Delete(previous);
+            allocator->Delete(job->mMailbox[(i >> 2) % ALLOCATOR_MAILBOX_SIZE].exchange(nullptr, std::memory_order_acq_rel));
+        }
+        else
+        {
+            const unsigned int slot = random % ALLOCATOR_LIVE_BLOCKS;
+            allocator->Delete(live[slot]);
+            live[slot] = block;
+        }
+    }
+    for (unsigned int slot = 0; slot < ALLOCATOR_LIVE_BLOCKS; ++slot)
+    {
+        allocator->Delete(live[slot]);
+    }
+}
+
+//! Times concurrent allocations and frees on an allocator, at every thread count
+//! \note The peak resident memory is the one of the process, run a single allocator benchmark with -b <name> to compare them
+static void BenchmarkAllocator(const char* implementation, Pegasus::Alloc::IAllocator* allocator)
+{
+    static const int MAX_THREADS = 8;
+    std::atomic<void*> mailboxes[MAX_THREADS][ALLOCATOR_MAILBOX_SIZE];
+    const size_t startResidentByteSize = Pegasus::Core::GetPeakResidentByteSize();
+    for (int c = 0; c < ALLOCATOR_THREAD_COUNT_COUNT; ++c)
+    {
+        const int threadCount = sAllocatorThreadCounts[c];
+        AllocatorBenchmarkJob jobs[MAX_THREADS];
+        std::thread threads[MAX_THREADS];
+        for (int t = 0; t < threadCount; ++t)
+        {
+            for (unsigned int m = 0; m < ALLOCATOR_MAILBOX_SIZE; ++m)
+            {
+                mailboxes[t][m].store(nullptr);
+            }
+            jobs[t].mAllocator = allocator;
+            jobs[t].mMailbox = mailboxes[t];
+            jobs[t].mNextMailbox = mailboxes[(t + 1) % threadCount];
+            jobs[t].mSeed = 2463534242u + t * 7919u;
+        }
+
+        double start = GetTimeMs();
+        for (int t = 0; t < threadCount; ++t)
+        {
+            threads[t] = std::thread(AllocatorBenchmarkThread, &jobs[t]);
+        }
+        for (int t = 0; t < threadCount; ++t)
+        {
+            threads[t].join();
+        }
+        const double ms = GetTimeMs() - start;
+
+        for (int t = 0; t < threadCount; ++t)
+        {
+            for (unsigned int m = 0; m < ALLOCATOR_MAILBOX_SIZE; ++m)
+            {
+                allocator->Delete(mailboxes[t][m].exchange(nullptr));
+            }
+        }
+
+        const double operations = static_cast<double>(threadCount) * ALLOCATOR_OPERATIONS_PER_THREAD;
+        printf("alloc    %-12s %d threads %9.3f ms total %8.2f M alloc+free / s, peak RSS %7.2f MB (+%.2f MB)\n",
+               implementation, threadCount, ms, operations / (ms * 1000.0),
+               Pegasus::Core::GetPeakResidentByteSize() / (1024.0 * 1024.0), (Pegasus::Core::GetPeakResidentByteSize() - startResidentByteSize) / (1024.0 * 1024.0));
+    }
+}
+
+void BENCHMARK_Memcpy()
+{
+    char* dst = AllocMemoryBuffer();
+    char* src = AllocMemoryBuffer();
+    for (int level = Pegasus::Utils::SIMD_LEVEL_SCALAR; level <= Pegasus::Utils::GetSupportedSimdLevel(); ++level)
+    {
+        Pegasus::Utils::SetSimdLevel(static_cast<Pegasus::Utils::SimdLevel>(level));
+        const char* name = Pegasus::Utils::GetSimdLevelName(static_cast<Pegasus::Utils::SimdLevel>(level));
+        BenchmarkCopyFunc("memcpy", name, Pegasus::Utils::Memcpy, dst, src, 0, 0, "aligned");
+        BenchmarkCopyFunc("memcpy", name, Pegasus::Utils::Memcpy, dst, src, 1, 3, "unaligned");
+    }
+    Pegasus::Utils::SetSimdLevel(Pegasus::Utils::GetSupportedSimdLevel());
+    BenchmarkCopyFunc("memcpy", "libc", LibcMemcpy, dst, src, 0, 0, "aligned");
+    BenchmarkCopyFunc("memcpy", "libc", LibcMemcpy, dst, src, 1, 3, "unaligned");
+    PG_DELETE_ARRAY(&sBenchmarkAllocator, src);
+    PG_DELETE_ARRAY(&sBenchmarkAllocator, dst);
+}
+
+void BENCHMARK_Memmove()
+{
+    //moves a buffer up by a few bytes, which copies backwards
+    char* buffer = AllocMemoryBuffer();
+    for (int level = Pegasus::Utils::SIMD_LEVEL_SCALAR; level <= Pegasus::Utils::GetSupportedSimdLevel(); ++level)
+    {
+        Pegasus::Utils::SetSimdLevel(static_cast<Pegasus::Utils::SimdLevel>(level));
+        const char* name = Pegasus::Utils::GetSimdLevelName(static_cast<Pegasus::Utils::SimdLevel>(level));
+        BenchmarkCopyFunc("memmove", name, Pegasus::Utils::Memmove, buffer, buffer, 67, 0, "overlapped");
+    }
+    Pegasus::Utils::SetSimdLevel(Pegasus::Utils::GetSupportedSimdLevel());
+    BenchmarkCopyFunc("memmove", "libc", LibcMemmove, buffer, buffer, 67, 0, "overlapped");
+    PG_DELETE_ARRAY(&sBenchmarkAllocator, buffer);
+}
+
+void BENCHMARK_Memset()
+{
+    char* dst = AllocMemoryBuffer();
+    for (int level = Pegasus::Utils::SIMD_LEVEL_SCALAR; level <= Pegasus::Utils::GetSupportedSimdLevel(); ++level)
+    {
+        Pegasus::Utils::SetSimdLevel(static_cast<Pegasus::Utils::SimdLevel>(level));
+        BenchmarkSetFunc(Pegasus::Utils::GetSimdLevelName(static_cast<Pegasus::Utils::SimdLevel>(level)), Pegasus::Utils::Memset8, dst);
+    }
+    Pegasus::Utils::SetSimdLevel(Pegasus::Utils::GetSupportedSimdLevel());
+    BenchmarkSetFunc("libc", LibcMemset, dst);
+    PG_DELETE_ARRAY(&sBenchmarkAllocator, dst);
+}
+
+void BENCHMARK_HashMapInts()
+{
+    for (int s = 0; s < LOOKUP_SIZE_COUNT; ++s)
+    {
+        const unsigned int keyCount = sLookupSizes[s];
+        Pegasus::Utils::Vector<int> keys(&sBenchmarkAllocator);
+        Pegasus::Utils::HashMap<int, int> map(&sBenchmarkAllocator);
+        for (unsigned int k = 0; k < keyCount; ++k)
+        {
+            keys.PushEmpty() = static_cast<int>(k * 2654435761u);
+            map.Insert(keys[k], static_cast<int>(k));
+        }
+        Pegasus::Utils::Vector<int> sortedKeys(keys);
+        qsort(sortedKeys.Data(), keyCount, sizeof(int), CompareInts);
+
+        //linear scan, the value is the index of the key
+        int checksum = 0;
+        double start = GetTimeMs();
+        for (unsigned int l = 0; l < LOOKUP_COUNT; ++l)
+        {
+            const int key = keys[GetLookupKey(l, keyCount)];
+            for (unsigned int k = 0; k < keyCount; ++k)
+            {
+                if (keys[k] == key)
+                {
+                    checksum += static_cast<int>(k);
+                    break;
+                }
+            }
+        }
+        PrintLookupResult("int", "linear scan", keyCount, checksum, GetTimeMs() - start);
+
+        //binary search in the sorted keys, the value is the sorted index
+        checksum = 0;
+        start = GetTimeMs();
+        for (unsigned int l = 0; l < LOOKUP_COUNT; ++l)
+        {
+            const int key = keys[GetLookupKey(l, keyCount)];
+            const int* found = static_cast<const int*>(bsearch(&key, sortedKeys.Data(), keyCount, sizeof(int), CompareInts));
+            checksum += static_cast<int>(found - sortedKeys.Data());
+        }
+        PrintLookupResult("int", "sorted array", keyCount, checksum, GetTimeMs() - start);
+
+        checksum = 0;
+        start = GetTimeMs();
+        for (unsigned int l = 0; l < LOOKUP_COUNT; ++l)
+        {
+            checksum += *map.Find(keys[GetLookupKey(l, keyCount)]);
+        }
+        PrintLookupResult("int", "hash map", keyCount, checksum, GetTimeMs() - start);
+    }
+}
+
+void BENCHMARK_HashMapStrings()
+{
+    for (int s = 0; s < LOOKUP_SIZE_COUNT; ++s)
+    {
+        const unsigned int keyCount = sLookupSizes[s];
+        char* names = PG_NEW_ARRAY(&sBenchmarkAllocator, -1, "Benchmark names", Pegasus::Alloc::PG_MEM_TEMP, char, keyCount * LOOKUP_NAME_LENGTH);
+        Pegasus::Utils::Vector<const char*> keys(&sBenchmarkAllocator);
+        Pegasus::Utils::Vector<Pegasus::Utils::HashedString> hashedKeys(&sBenchmarkAllocator);
+        Pegasus::Utils::HashMap<Pegasus::Utils::HashedString, int> map(&sBenchmarkAllocator);
+        for (unsigned int k = 0; k < keyCount; ++k)
+        {
+            char* name = names + k * LOOKUP_NAME_LENGTH;
+            sprintf(name, "PropertyGridClass%u", k * 2654435761u);
+            keys.PushEmpty() = name;
+            hashedKeys.PushEmpty() = Pegasus::Utils::HashedString(name);
+            map.Insert(hashedKeys[k], static_cast<int>(k));
+        }
+        Pegasus::Utils::Vector<const char*> sortedKeys(keys);
+        qsort(sortedKeys.Data(), keyCount, sizeof(const char*), CompareStrings);
+
+        //linear scan with Strcmp, as the engine does
+        int checksum = 0;
+        double start = GetTimeMs();
+        for (unsigned int l = 0; l < LOOKUP_COUNT; ++l)
+        {
+            const char* key = keys[GetLookupKey(l, keyCount)];
+            for (unsigned int k = 0; k < keyCount; ++k)
+            {
+                if (!Pegasus::Utils::Strcmp(keys[k], key))
+                {
+                    checksum += static_cast<int>(k);
+                    break;
+                }
+            }
+        }
+        PrintLookupResult("string", "linear scan", keyCount, checksum, GetTimeMs() - start);
+
+        checksum = 0;
+        start = GetTimeMs();
+        for (unsigned int l = 0; l < LOOKUP_COUNT; ++l)
+        {
+            const char* key = keys[GetLookupKey(l, keyCount)];
+            const char* const* found = static_cast<const char* const*>(bsearch(&key, sortedKeys.Data(), keyCount, sizeof(const char*), CompareStrings));
+            checksum += static_cast<int>(found - sortedKeys.Data());
+        }
+        PrintLookupResult("string", "sorted array", keyCount, checksum, GetTimeMs() - start);
+
+        //the key is hashed by each lookup
+        checksum = 0;
+        start = GetTimeMs();
+        for (unsigned int l = 0; l < LOOKUP_COUNT; ++l)
+        {
+            checksum += *map.Find(keys[GetLookupKey(l, keyCount)]);
+        }
+        PrintLookupResult("string", "hash map", keyCount, checksum, GetTimeMs() - start);
+
+        checksum = 0;
+        start = GetTimeMs();
+        for (unsigned int l = 0; l < LOOKUP_COUNT; ++l)
+        {
+            checksum += *map.Find(hashedKeys[GetLookupKey(l, keyCount)]);
+        }
+        PrintLookupResult("string", "hash map, hashed", keyCount, checksum, GetTimeMs() - start);
+
+        PG_DELETE_ARRAY(&sBenchmarkAllocator, names);
+    }
+}
+
+void BENCHMARK_VectorPush()
+{
+    BenchmarkPush<int>("int");
+    BenchmarkPush<BenchmarkElement>("class");
+}
+
+void BENCHMARK_VectorInsert()
+{
+    BenchmarkInsert<int>("int");
+    BenchmarkInsert<BenchmarkElement>("class");
+}
+
+void BENCHMARK_VectorDelete()
+{
+    BenchmarkDelete<int>("int");
+    BenchmarkDelete<BenchmarkElement>("class");
+}
+
+void BENCHMARK_VectorCopy()
+{
+    BenchmarkCopy<int>("int");
+    BenchmarkCopy<BenchmarkElement>("class");
+}
+
+void BENCHMARK_AllocatorMallocFree()
+{
+    Pegasus::Memory::MallocFreeAllocator allocator(0);
+    BenchmarkAllocator("mallocfree", &allocator);
+}
+
+void BENCHMARK_AllocatorThreadCache()
+{
+    Pegasus::Memory::ThreadCacheAllocator allocator(0);
+    BenchmarkAllocator("threadcache", &allocator);
+    printf("alloc    %-12s peak reserved %.2f MB\n", "threadcache", allocator.GetPeakReservedByteSize() / (1024.0 * 1024.0));
+}
@@ -9,14 +9,22 @@
 //! \date   30th March 2014
 //! \brief  Pegasus Unit tests for the Utils package, implementation
 
+#include "Pegasus/Allocator/AlignedBlock.h"
+#include "Pegasus/Memory/BlockAllocator.h"
 #include "Pegasus/Memory/MallocFreeAllocator.h"
+#include "Pegasus/Memory/ThreadCacheAllocator.h"
 #include "Pegasus/UnitTests/UtilsTests.h"
 #include "Pegasus/Utils/Memset.h"
 #include "Pegasus/Utils/Memcpy.h"
+#include "Pegasus/Utils/Simd.h"
 #include "Pegasus/Utils/String.h"
 #include "Pegasus/Utils/TesselationTable.h"
 #include "Pegasus/Utils/Vector.h"
 #include "Pegasus/Utils/ByteStream.h"
+#include "Pegasus/Utils/HashMap.h"
+#include <atomic>
+#include <thread>
+#include <stdio.h>
 
 static Pegasus::Memory::MallocFreeAllocator sGlobalAllocator(0);
 
@@ -67,6 +75,143 @@ bool UNIT_TEST_Memcpy3()
     return match;
 }
 
+//! sizes the memory tests run at: every size up to a few vectors, then sizes around the loop blocks
+static const unsigned int sMemTestSizes[] = {
+      0,   1,   2,   3,   4,   5,   6,   7,   8,   9,  10,  11,  12,  13,  14,  15,
+     16,  17,  18,  19,  20,  21,  22,  23,  24,  25,  26,  27,  28,  29,  30,  31,
+     32,  33,  34,  35,  36,  39,  40,  47,  48,  49,  63,  64,  65,  66,  79,  80,
+     95,  96,  97, 111, 112, 127, 128, 129, 130, 143, 159, 160, 161, 191, 192, 193,
+    255, 256, 257, 300, 383, 384, 385, 511, 512, 513, 1000, 1023, 1024, 1025
+};
+static const int MEM_TEST_SIZE_COUNT = sizeof(sMemTestSizes) / sizeof(sMemTestSizes[0]);
+
+//! alignments the memory tests run at, covers the widest vector
+static const unsigned int MEM_TEST_ALIGNMENT_COUNT = 32;
+
+//! bytes checked after the end of an output to detect overruns
+static const unsigned int MEM_TEST_GUARD = 64;
+
+static const unsigned int MEM_TEST_BUFFER_SIZE = 2 * MEM_TEST_ALIGNMENT_COUNT + 1025 + 129 + MEM_TEST_GUARD;
+
+//! buffers of the large copies, big enough to use non temporal stores
+static char sLargeSource[PG_SIMD_NON_TEMPORAL_BYTESIZE + 128];
+static char sLargeDestination[PG_SIMD_NON_TEMPORAL_BYTESIZE + 128];
+
+//! \return a byte that differs in between neighbours and from the guard value
+static char MemTestByte(unsigned int i)
+{
+    return static_cast<char>((i * 7 + 3) % 251);
+}
+
+bool UNIT_TEST_Memcpy4()
+{
+    static char src[MEM_TEST_BUFFER_SIZE];
+    static char dst[MEM_TEST_BUFFER_SIZE];
+    for (unsigned int i = 0; i < MEM_TEST_BUFFER_SIZE; ++i) src[i] = MemTestByte(i);
+
+    bool match = true;
+    for (int level = Pegasus::Utils::SIMD_LEVEL_SCALAR; level <= Pegasus::Utils::GetSupportedSimdLevel(); ++level)
+    {
+        Pegasus::Utils::SetSimdLevel(static_cast<Pegasus::Utils::SimdLevel>(level));
+        for (unsigned int srcAlign = 0; srcAlign < MEM_TEST_ALIGNMENT_COUNT; ++srcAlign)
+        {
+            for (unsigned int dstAlign = 0; dstAlign < MEM_TEST_ALIGNMENT_COUNT; ++dstAlign)
+            {
+                for (int s = 0; s < MEM_TEST_SIZE_COUNT; ++s)
+                {
+                    const unsigned int size = sMemTestSizes[s];
+                    for (unsigned int i = 0; i < dstAlign + size + MEM_TEST_GUARD; ++i) dst[i] = -1;
+                    void* result = Pegasus::Utils::Memcpy(dst + dstAlign, src + srcAlign, size);
+
+                    match = match && result == dst + dstAlign;
+                    for (unsigned int i = 0; i < dstAlign; ++i) match = match && dst[i] == -1;
+                    for (unsigned int i = 0; i < size; ++i) match = match && dst[dstAlign + i] == src[srcAlign + i];
+                    for (unsigned int i = 0; i < MEM_TEST_GUARD; ++i) match = match && dst[dstAlign + size + i] == -1;
+                }
+            }
+        }
+
+        //non temporal copy
+        const unsigned int largeSize = PG_SIMD_NON_TEMPORAL_BYTESIZE + 37;
+        for (unsigned int i = 0; i < largeSize + 3; ++i) sLargeSource[i] = MemTestByte(i + level);
+        sLargeDestination[largeSize + 5] = -1;
+        Pegasus::Utils::Memcpy(sLargeDestination + 5, sLargeSource + 3, largeSize);
+        for (unsigned int i = 0; i < largeSize; ++i) match = match && sLargeDestination[5 + i] == sLargeSource[3 + i];
+        match = match && sLargeDestination[largeSize + 5] == -1;
+    }
+    Pegasus::Utils::SetSimdLevel(Pegasus::Utils::GetSupportedSimdLevel());
+
+    return match;
+}
+
+//! moves a range of a buffer by a distance and compares it to a copy made through a separate buffer
+static bool TestMemmove(char* buffer, char* expected, unsigned int bufferSize, unsigned int srcOffset, unsigned int dstOffset, unsigned int size)
+{
+    for (unsigned int i = 0; i < bufferSize; ++i) buffer[i] = expected[i] = MemTestByte(i);
+    for (unsigned int i = 0; i < size; ++i) expected[dstOffset + i] = buffer[srcOffset + i];
+
+    void* result = Pegasus::Utils::Memmove(buffer + dstOffset, buffer + srcOffset, size);
+
+    bool match = result == buffer + dstOffset;
+    for (unsigned int i = 0; i < bufferSize; ++i) match = match && buffer[i] == expected[i];
+    return match;
+}
+
+bool UNIT_TEST_Memmove1()
+{
+    //overlapping moves, up and down, by distances smaller and larger than a vector
+    static char buffer[MEM_TEST_BUFFER_SIZE];
+    static char expected[MEM_TEST_BUFFER_SIZE];
+    static const unsigned int sDistances[] = { 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 127, 128, 129 };
+
+    bool match = true;
+    for (int level = Pegasus::Utils::SIMD_LEVEL_SCALAR; level <= Pegasus::Utils::GetSupportedSimdLevel(); ++level)
+    {
+        Pegasus::Utils::SetSimdLevel(static_cast<Pegasus::Utils::SimdLevel>(level));
+        for (unsigned int align = 0; align < MEM_TEST_ALIGNMENT_COUNT; ++align)
+        {
+            for (int d = 0; d < static_cast<int>(sizeof(sDistances) / sizeof(sDistances[0])); ++d)
+            {
+                for (int s = 0; s < MEM_TEST_SIZE_COUNT; ++s)
+                {
+                    const unsigned int distance = sDistances[d];
+                    const unsigned int size = sMemTestSizes[s];
+                    if (align + distance + size > MEM_TEST_BUFFER_SIZE) continue;
+                    match = match && TestMemmove(buffer, expected, align + distance + size, align, align + distance, size);
+                    match = match && TestMemmove(buffer, expected, align + distance + size, align + distance, align, size);
+                }
+            }
+        }
+    }
+    Pegasus::Utils::SetSimdLevel(Pegasus::Utils::GetSupportedSimdLevel());
+
+    return match;
+}
+
+bool UNIT_TEST_Memmove2()
+{
+    //moves that do not overlap, and large moves
+    static char buffer[MEM_TEST_BUFFER_SIZE];
+    static char expected[MEM_TEST_BUFFER_SIZE];
+
+    bool match = true;
+    for (int level = Pegasus::Utils::SIMD_LEVEL_SCALAR; level <= Pegasus::Utils::GetSupportedSimdLevel(); ++level)
+    {
+        Pegasus::Utils::SetSimdLevel(static_cast<Pegasus::Utils::SimdLevel>(level));
+        match = match && TestMemmove(buffer, expected, 600, 0, 300, 300);
+        match = match && TestMemmove(buffer, expected, 600, 300, 0, 300);
+        match = match && TestMemmove(buffer, expected, 600, 17, 17, 300);
+        match = match && TestMemmove(buffer, expected, 600, 3, 501, 0);
+
+        const unsigned int largeSize = PG_SIMD_NON_TEMPORAL_BYTESIZE + 37;
+        match = match && TestMemmove(sLargeSource, sLargeDestination, largeSize + 91, 0, 91, largeSize);
+        match = match && TestMemmove(sLargeSource, sLargeDestination, largeSize + 91, 91, 0, largeSize);
+    }
+    Pegasus::Utils::SetSimdLevel(Pegasus::Utils::GetSupportedSimdLevel());
+
+    return match;
+}
+
 bool UNIT_TEST_Memset1()
 {
     char p = 100; 
@@ -99,6 +244,76 @@ bool UNIT_TEST_Memset4()
     return true;
 }
 
+bool UNIT_TEST_Memset5()
+{
+    //values with the sign bit set, which must not spread to the other bytes
+    static const char sValues[] = { 0, 1, 0x5A, static_cast<char>(0x80), static_cast<char>(0xFF) };
+    static char dst[MEM_TEST_BUFFER_SIZE];
+
+    bool match = true;
+    for (int level = Pegasus::Utils::SIMD_LEVEL_SCALAR; level <= Pegasus::Utils::GetSupportedSimdLevel(); ++level)
+    {
+        Pegasus::Utils::SetSimdLevel(static_cast<Pegasus::Utils::SimdLevel>(level));
+        for (int v = 0; v < static_cast<int>(sizeof(sValues)); ++v)
+        {
+            for (unsigned int align = 0; align < MEM_TEST_ALIGNMENT_COUNT; ++align)
+            {
+                for (int s = 0; s < MEM_TEST_SIZE_COUNT; ++s)
+                {
+                    const unsigned int size = sMemTestSizes[s];
+                    for (unsigned int i = 0; i < align + size + MEM_TEST_GUARD; ++i) dst[i] = 99;
+                    void* result = Pegasus::Utils::Memset8(dst + align, sValues[v], size);
+
+                    match = match && result == dst + align;
+                    for (unsigned int i = 0; i < align; ++i) match = match && dst[i] == 99;
+                    for (unsigned int i = 0; i < size; ++i) match = match && dst[align + i] == sValues[v];
+                    for (unsigned int i = 0; i < MEM_TEST_GUARD; ++i) match = match && dst[align + size + i] == 99;
+                }
+            }
+        }
+
+        //non temporal fill
+        const unsigned int largeSize = PG_SIMD_NON_TEMPORAL_BYTESIZE + 37;
+        sLargeDestination[largeSize + 1] = 99;
+        Pegasus::Utils::Memset8(sLargeDestination + 1, static_cast<char>(0x80 + level), largeSize);
+        for (unsigned int i = 0; i < largeSize; ++i) match = match && sLargeDestination[1 + i] == static_cast<char>(0x80 + level);
+        match = match && sLargeDestination[largeSize + 1] == 99;
+    }
+    Pegasus::Utils::SetSimdLevel(Pegasus::Utils::GetSupportedSimdLevel());
+
+    return match;
+}
+
+bool UNIT_TEST_Memset6()
+{
+    //the pattern must start at the destination whatever its alignment
+    const unsigned int pattern = 0x89ABCDEF;
+    static char dst[MEM_TEST_BUFFER_SIZE];
+
+    bool match = true;
+    for (int level = Pegasus::Utils::SIMD_LEVEL_SCALAR; level <= Pegasus::Utils::GetSupportedSimdLevel(); ++level)
+    {
+        Pegasus::Utils::SetSimdLevel(static_cast<Pegasus::Utils::SimdLevel>(level));
+        for (unsigned int align = 0; align < MEM_TEST_ALIGNMENT_COUNT; ++align)
+        {
+            for (int s = 0; s < MEM_TEST_SIZE_COUNT; ++s)
+            {
+                const unsigned int size = sMemTestSizes[s] & ~3u;
+                for (unsigned int i = 0; i < align + size + MEM_TEST_GUARD; ++i) dst[i] = 99;
+                void* result = Pegasus::Utils::Memset32(dst + align, pattern, size);
+
+                match = match && result == dst + align;
+                for (unsigned int i = 0; i < align; ++i) match = match && dst[i] == 99;
+                for (unsigned int i = 0; i < size; ++i) match = match && dst[align + i] == static_cast<char>(pattern >> (8 * (i & 3)));
+                for (unsigned int i = 0; i < MEM_TEST_GUARD; ++i) match = match && dst[align + size + i] == 99;
+            }
+        }
+    }
+    Pegasus::Utils::SetSimdLevel(Pegasus::Utils::GetSupportedSimdLevel());
+
+    return match;
+}
+
 bool UNIT_TEST_Strcmp1()
 {
     const char * c1 = "ThisIsAString";
@@ -445,6 +660,504 @@ bool UNIT_TEST_Vector2()
     return true;
 }
 
+bool UNIT_TEST_Vector3()
+{
+    Pegasus::Utils::Vector<int> v(&sGlobalAllocator);
+    v.Reserve(1000);
+    if (v.GetCapacity() < 1000 || v.GetSize() != 0) return false;
+
+    //no reallocation under the reserved capacity
+    const int* data = nullptr;
+    for (int i = 0; i < 1000; ++i)
+    {
+        v.PushEmpty() = i;
+        if (i == 0) data = v.Data();
+    }
+    if (v.Data() != data) return false;
+
+    v.Resize(1500);
+    if (v.GetSize() != 1500 || v[999] != 999) return false;
+    v.Resize(10);
+    if (v.GetSize() != 10 || v[9] != 9) return false;
+
+    v.ShrinkToFit();
+    if (v.GetCapacity() != 10) return false;
+    for (unsigned int i = 0; i < v.GetSize(); ++i)
+    {
+        if (v[i] != static_cast<int>(i)) return false;
+    }
+
+    //geometric growth: pushing n elements reallocates a logarithmic number of times
+    int reallocations = 0;
+    unsigned int capacity = v.GetCapacity();
+    for (int i = 0; i < 100000; ++i)
+    {
+        v.PushEmpty() = i;
+        if (v.GetCapacity() != capacity)
+        {
+            capacity = v.GetCapacity();
+            ++reallocations;
+        }
+    }
+    return reallocations < 20;
+}
+
+bool UNIT_TEST_Vector4()
+{
+    Pegasus::Utils::Vector<int> v(&sGlobalAllocator);
+    for (int i = 0; i < 100; ++i) v.PushEmpty() = 2 * i;
+
+    //insert the odd numbers in between
+    for (int i = 0; i < 100; ++i)
+    {
+        v.Insert(2 * i + 1) = 2 * i + 1;
+    }
+    v.Insert(0) = -1;
+    if (v.GetSize() != 201) return false;
+    for (unsigned int i = 0; i < v.GetSize(); ++i)
+    {
+        if (v[i] != static_cast<int>(i) - 1) return false;
+    }
+
+    v.Delete(0);
+    v.Delete(v.GetSize() - 1);
+    if (v.Pop() != 198 || v.GetSize() != 198) return false;
+    for (unsigned int i = 0; i < v.GetSize(); ++i)
+    {
+        if (v[i] != static_cast<int>(i)) return false;
+    }
+    return true;
+}
+
+//! element that points to itself, so relocating its bytes without moving it is detected
+struct TrackedElement
+{
+    static int sLiveCount;
+
+    TrackedElement() : mSelf(this), mValue(0) { ++sLiveCount; }
+    explicit TrackedElement(int value) : mSelf(this), mValue(value) { ++sLiveCount; }
+    TrackedElement(const TrackedElement& other) : mSelf(this), mValue(other.mValue) { ++sLiveCount; }
+    TrackedElement(TrackedElement&& other) : mSelf(this), mValue(other.mValue) { other.mValue = -1; ++sLiveCount; }
+    ~TrackedElement() { mSelf = nullptr; --sLiveCount; }
+    TrackedElement& operator=(const TrackedElement& other) { mValue = other.mValue; return *this; }
+
+    bool IsValid(int value) const { return mSelf == this && mValue == value; }
+
+    TrackedElement* mSelf;
+    int mValue;
+};
+
+int TrackedElement::sLiveCount = 0;
+
+bool UNIT_TEST_Vector5()
+{
+    bool pass = true;
+    {
+        Pegasus::Utils::Vector<TrackedElement> v(&sGlobalAllocator);
+        for (int i = 0; i < 300; ++i)
+        {
+            v.Emplace(2 * i);
+        }
+        for (int i = 0; i < 300; ++i)
+        {
+            v.Insert(2 * i + 1).mValue = 2 * i + 1;
+        }
+        for (int i = 0; i < 100; ++i)
+        {
+            v.Delete(i);
+        }
+        pass = pass && v.GetSize() == 500 && TrackedElement::sLiveCount == 500;
+        for (unsigned int i = 0; i < v.GetSize(); ++i)
+        {
+            int expected = i < 100 ? 2 * i + 1 : i + 100;
+            pass = pass && v[i].IsValid(expected);
+        }
+
+        v.Resize(50);
+        v.ShrinkToFit();
+        pass = pass && v.GetCapacity() == 50 && TrackedElement::sLiveCount == 50 && v[49].IsValid(99);
+    }
+    return pass && TrackedElement::sLiveCount == 0;
+}
+
+bool UNIT_TEST_Vector6()
+{
+    bool pass = true;
+    {
+        Pegasus::Utils::Vector<TrackedElement> a(&sGlobalAllocator);
+        for (int i = 0; i < 100; ++i) a.Emplace(i);
+
+        Pegasus::Utils::Vector<TrackedElement> b(a);
+        pass = pass && b.GetSize() == 100 && TrackedElement::sLiveCount == 200;
+
+        //moving takes the buffer, the elements are not touched
+        const TrackedElement* data = b.Data();
+        Pegasus::Utils::Vector<TrackedElement> c(std::move(b));
+        pass = pass && c.Data() == data && b.GetSize() == 0 && TrackedElement::sLiveCount == 200;
+
+        a = std::move(c);
+        pass = pass && a.Data() == data && c.GetSize() == 0 && TrackedElement::sLiveCount == 100;
+        for (unsigned int i = 0; i < a.GetSize(); ++i)
+        {
+            pass = pass && a[i].IsValid(i);
+        }
+
+        Pegasus::Utils::Vector<int> ints(&sGlobalAllocator);
+        for (int i = 0; i < 1000; ++i) ints.PushEmpty() = i;
+        Pegasus::Utils::Vector<int> intsCopy(&sGlobalAllocator);
+        intsCopy = ints;
+        pass = pass && intsCopy.GetSize() == 1000 && intsCopy.Data() != ints.Data();
+        for (unsigned int i = 0; i < intsCopy.GetSize(); ++i)
+        {
+            pass = pass && intsCopy[i] == static_cast<int>(i);
+        }
+    }
+    return pass && TrackedElement::sLiveCount == 0;
+}
+
+bool UNIT_TEST_HashMap1()
+{
+    Pegasus::Utils::HashMap<int, int> map(&sGlobalAllocator);
+    bool pass = map.Find(3) == nullptr && map.GetSize() == 0;
+
+    for (int i = 0; i < 10000; ++i) map.Insert(i * 7, i);
+    pass = pass && map.GetSize() == 10000;
+    for (int i = 0; i < 10000; ++i)
+    {
+        const int* v = map.Find(i * 7);
+        pass = pass && v != nullptr && *v == i && !map.Contains(i * 7 + 1);
+    }
+
+    //overwrite, remove half, then add other keys over the deleted slots
+    for (int i = 0; i < 10000; ++i) map[i * 7] += 1;
+    for (int i = 0; i < 10000; i += 2) pass = pass && map.Remove(i * 7);
+    pass = pass && !map.Remove(0) && map.GetSize() == 5000;
+    for (int i = 0; i < 5000; ++i) map.Insert(-i - 1, i);
+    pass = pass && map.GetSize() == 10000;
+    for (int i = 0; i < 10000; ++i)
+    {
+        const int* v = map.Find(i * 7);
+        pass = pass && ((i & 1) == 0 ? v == nullptr : (v != nullptr && *v == i + 1));
+    }
+    for (int i = 0; i < 5000; ++i) pass = pass && *map.Find(-i - 1) == i;
+    return pass;
+}
+
+bool UNIT_TEST_HashMap2()
+{
+    //string keys, the strings live in a buffer that outlives the map
+    static char names[1000][16];
+    Pegasus::Utils::HashMap<Pegasus::Utils::HashedString, int> map(&sGlobalAllocator);
+    for (int i = 0; i < 1000; ++i)
+    {
+        sprintf(names[i], "Property%d", i);
+        map.Insert(names[i], i);
+    }
+
+    //lookups with other pointers to the same strings
+    bool pass = map.GetSize() == 1000;
+    char name[16];
+    for (int i = 0; i < 1000; ++i)
+    {
+        sprintf(name, "Property%d", i);
+        const int* v = map.Find(name);
+        pass = pass && v != nullptr && *v == i;
+
+        Pegasus::Utils::HashedString key(name, Pegasus::Utils::HashStr(name));
+        pass = pass && map.Contains(key);
+    }
+    pass = pass && !map.Contains("Property1000") && !map.Contains("property1") && !map.Contains("");
+    return pass;
+}
+
+bool UNIT_TEST_HashMap3()
+{
+    //values that are not plain old data are moved when the map grows, and destroyed once
+    bool pass = true;
+    {
+        Pegasus::Utils::HashMap<int, TrackedElement> map(&sGlobalAllocator);
+        for (int i = 0; i < 1000; ++i) map[i].mValue = i;
+        pass = pass && TrackedElement::sLiveCount == 1000;
+        for (int i = 0; i < 500; ++i) map.Remove(i);
+        pass = pass && TrackedElement::sLiveCount == 500;
+        for (int i = 500; i < 1000; ++i) pass = pass && map.Find(i)->IsValid(i);
+        map.Clear();
+        pass = pass && TrackedElement::sLiveCount == 0 && map.GetSize() == 0 && map.GetCapacity() > 0;
+        map[1].mValue = 1;
+    }
+    return pass && TrackedElement::sLiveCount == 0;
+}
+
+bool UNIT_TEST_HashMap4()
+{
+    Pegasus::Utils::HashMap<int, int> map(&sGlobalAllocator);
+    map.Reserve(1000);
+    const unsigned int capacity = map.GetCapacity();
+    for (int i = 0; i < 1000; ++i) map.Insert(i, 2 * i);
+    bool pass = map.GetCapacity() == capacity;
+
+    //iteration visits each key once
+    static bool visited[1000];
+    for (int i = 0; i < 1000; ++i) visited[i] = false;
+    int count = 0;
+    for (Pegasus::Utils::HashMap<int, int>::Iterator it = map.begin(); it != map.end(); ++it)
+    {
+        pass = pass && it->mKey >= 0 && it->mKey < 1000 && !visited[it->mKey] && it->mValue == 2 * it->mKey;
+        visited[it->mKey] = true;
+        ++count;
+    }
+    pass = pass && count == 1000;
+
+    //removing and adding keys in a loop reuses the deleted slots instead of growing
+    for (int i = 0; i < 100000; ++i)
+    {
+        map.Remove(i % 1000);
+        map.Insert(i % 1000, i);
+    }
+    pass = pass && map.GetCapacity() == capacity && map.GetSize() == 1000;
+
+    map.Reset();
+    return pass && map.GetCapacity() == 0 && map.Find(1) == nullptr;
+}
+
+bool UNIT_TEST_HashSet1()
+{
+    Pegasus::Utils::HashSet<const void*> set(&sGlobalAllocator);
+    static int objects[500];
+    bool pass = true;
+    for (int i = 0; i < 500; ++i) pass = pass && set.Insert(&objects[i]);
+    for (int i = 0; i < 500; ++i) pass = pass && !set.Insert(&objects[i]);
+    pass = pass && set.GetSize() == 500 && !set.Contains(&pass);
+    for (int i = 0; i < 500; i += 3) pass = pass && set.Remove(&objects[i]);
+    for (int i = 0; i < 500; ++i) pass = pass && set.Contains(&objects[i]) == (i % 3 != 0);
+
+    int count = 0;
+    for (Pegasus::Utils::HashSet<const void*>::ConstIterator it = set.begin(); it != set.end(); ++it) ++count;
+    return pass && count == static_cast<int>(set.GetSize());
+}
+
+bool UNIT_TEST_ThreadCacheAllocator1()
+{
+    Pegasus::Memory::ThreadCacheAllocator allocator(0);
+    static const int COUNT = 600;
+    unsigned char* blocks[COUNT];
+    unsigned int sizes[COUNT];
+    bool pass = true;
+
+    //every size class, the large blocks and some aligned blocks, each one filled with its own value
+    for (int round = 0; round < 2; ++round)
+    {
+        for (int i = 0; i < COUNT; ++i)
+        {
+            sizes[i] = i < 500 ? i * 17 : 8000 + (i - 500) * 300;
+            if (i % 7 == 3)
+            {
+                const Pegasus::Alloc::Alignment align = static_cast<Pegasus::Alloc::Alignment>(32) << (i % 8);
+                blocks[i] = static_cast<unsigned char*>(allocator.AllocAlign(sizes[i], align, Pegasus::Alloc::PG_MEM_TEMP));
+                pass = pass && (reinterpret_cast<size_t>(blocks[i]) & (align - 1)) == 0;
+            }
+            else
+            {
+                blocks[i] = static_cast<unsigned char*>(allocator.Alloc(sizes[i], Pegasus::Alloc::PG_MEM_TEMP));
+                pass = pass && (reinterpret_cast<size_t>(blocks[i]) & 15) == 0;
+            }
+            Pegasus::Utils::Memset8(blocks[i], static_cast<char>(i), sizes[i]);
+        }
+        for (int i = 0; i < COUNT; ++i)
+        {
+            for (unsigned int b = 0; b < sizes[i]; ++b) pass = pass && blocks[i][b] == static_cast<unsigned char>(i);
+        }
+
+        //free every other block first, so freed blocks are reused in the middle of their pages
+        for (int i = 0; i < COUNT; i += 2) allocator.Delete(blocks[i]);
+        for (int i = 1; i < COUNT; i += 2) allocator.Delete(blocks[i]);
+    }
+
+    //the small blocks were given back, only the pages stay reserved
+    pass = pass && allocator.GetPeakReservedByteSize() >= allocator.GetReservedByteSize();
+    allocator.Delete(nullptr);
+
+    //large blocks still allocated are given back by the destructor
+    const size_t reservedByteSize = allocator.GetReservedByteSize();
+    pass = pass && allocator.Alloc(100000, Pegasus::Alloc::PG_MEM_TEMP) != nullptr;
+    pass = pass && allocator.AllocAlign(20000, 4096, Pegasus::Alloc::PG_MEM_TEMP) != nullptr;
+    pass = pass && allocator.GetReservedByteSize() >= reservedByteSize + 120000;
+    return pass;
+}
+
+//! blocks each thread of the cross thread test allocates
+static const int THREAD_CACHE_TEST_BLOCKS = 20000;
+
+//! Job of a thread of the cross thread test
+struct ThreadCacheTestJob
+{
+    Pegasus::Memory::ThreadCacheAllocator* mAllocator;
+    std::atomic<int*>* mMailbox; //!< slots the previous thread puts its blocks in, for this thread to free
+    std::atomic<int*>* mNextMailbox; //!< slots of the next thread
+    int mId;
+    int mPreviousId; //!< id written in the blocks of the previous thread
+    int mFailures;
+};
+
+//! Allocates blocks, hands them to the next thread and frees the ones of the previous thread
+static void ThreadCacheTestThread(ThreadCacheTestJob* job)
+{
+    for (int i = 0; i < THREAD_CACHE_TEST_BLOCKS; ++i)
+    {
+        const int intCount = 2 + (i % 61);
+        int* block = static_cast<int*>(job->mAllocator->Alloc(intCount * sizeof(int), Pegasus::Alloc::PG_MEM_TEMP));
+        block[0] = job->mId;
+        block[1] = intCount;
+        block[intCount - 1] = intCount;
+
+        int* previous = job->mNextMailbox[i % 64].exchange(block);
+        if (previous != nullptr)
+        {
+            job->mAllocator->Delete(previous);
+        }
+
+        //blocks of the previous thread, freed here
+        int* received = job->mMailbox[(i * 7) % 64].exchange(nullptr);
+        if (received != nullptr)
+        {
+            job->mFailures += received[0] == job->mPreviousId && received[received[1] - 1] == received[1] ? 0 : 1;
+            job->mAllocator->Delete(received);
+        }
+    }
+}
+
+bool UNIT_TEST_ThreadCacheAllocator2()
+{
+    static const int THREAD_COUNT = 4;
+    Pegasus::Memory::ThreadCacheAllocator allocator(0);
+    std::atomic<int*> mailboxes[THREAD_COUNT][64];
+    size_t firstRoundByteSize = 0;
+    int failures = 0;
+
+    //the second round adopts the heaps of the threads of the first one, with the blocks freed by other threads
+    for (int round = 0; round < 2; ++round)
+    {
+        for (int t = 0; t < THREAD_COUNT; ++t)
+        {
+            for (int m = 0; m < 64; ++m) mailboxes[t][m].store(nullptr);
+        }
+
+        ThreadCacheTestJob jobs[THREAD_COUNT];
+        std::thread threads[THREAD_COUNT];
+        for (int t = 0; t < THREAD_COUNT; ++t)
+        {
+            jobs[t].mAllocator = &allocator;
+            jobs[t].mMailbox = mailboxes[t];
+            jobs[t].mNextMailbox = mailboxes[(t + 1) % THREAD_COUNT];
+            jobs[t].mId = t;
+            jobs[t].mPreviousId = (t + THREAD_COUNT - 1) % THREAD_COUNT;
+            jobs[t].mFailures = 0;
+            threads[t] = std::thread(ThreadCacheTestThread, &jobs[t]);
+        }
+
+        for (int t = 0; t < THREAD_COUNT; ++t)
+        {
+            threads[t].join();
+            failures += jobs[t].mFailures;
+            for (int m = 0; m < 64; ++m)
+            {
+                int* block = mailboxes[t][m].exchange(nullptr);
+                if (block != nullptr)
+                {
+                    failures += block[0] == (t + THREAD_COUNT - 1) % THREAD_COUNT ? 0 : 1;
+                    allocator.Delete(block);
+                }
+            }
+        }
+
+        if (round == 0)
+        {
+            firstRoundByteSize = allocator.GetReservedByteSize();
+        }
+    }
+
+    //the pages of the first round are reused rather than leaked
+    return failures == 0 && allocator.GetReservedByteSize() <= 2 * firstRoundByteSize;
+}
+
+bool UNIT_TEST_AllocatorAlignment1()
+{
+    Pegasus::Memory::MallocFreeAllocator mallocFreeAllocator(3);
+    Pegasus::Alloc::IAllocator* allocator = &mallocFreeAllocator;
+    Pegasus::Memory::BlockAllocator blockAllocator;
+    blockAllocator.Initialize(1024, allocator);
+    bool pass = true;
+    for (int i = 0; i < 64; ++i)
+    {
+        //blocks of every size keep the default alignment, and any power of two is honoured
+        const size_t size = 1 + i * 13;
+        const Pegasus::Alloc::Alignment align = static_cast<Pegasus::Alloc::Alignment>(1) << (i % 13);
+        char* block = static_cast<char*>(allocator->Alloc(size, Pegasus::Alloc::PG_MEM_TEMP));
+        char* alignedBlock = static_cast<char*>(allocator->AllocAlign(size, align, Pegasus::Alloc::PG_MEM_TEMP));
+        pass = pass && Pegasus::Alloc::IsAligned(block, PG_DEFAULT_ALIGNMENT) && Pegasus::Alloc::IsAligned(alignedBlock, align);
+        Pegasus::Utils::Memset8(block, 1, static_cast<unsigned int>(size));
+        Pegasus::Utils::Memset8(alignedBlock, 2, static_cast<unsigned int>(size));
+        allocator->Delete(block);
+        allocator->Delete(alignedBlock);
+
+        //the block allocator pads its pages, packed blocks in between
+        char* packed = static_cast<char*>(blockAllocator.Alloc(1 + i % 7, Pegasus::Alloc::PG_MEM_TEMP));
+        const Pegasus::Alloc::Alignment blockAlign = static_cast<Pegasus::Alloc::Alignment>(1) << (i % 8);
+        char* padded = static_cast<char*>(blockAllocator.AllocAlign(size % 200, blockAlign, Pegasus::Alloc::PG_MEM_TEMP));
+        pass = pass && Pegasus::Alloc::IsAligned(padded, blockAlign) && padded >= packed + 1 + i % 7 && blockAllocator.Owns(padded);
+    }
+    blockAllocator.FreeMemory();
+    return pass;
+}
+
+//! element aligned more than the allocators by default
+struct PEGASUS_ALIGN_BEGIN(32) AlignedElement
+{
+    AlignedElement() : mSelf(this) { ++sLiveCount; }
+    ~AlignedElement() { --sLiveCount; }
+
+    AlignedElement* mSelf;
+    float mValues[5];
+    static int sLiveCount;
+} PEGASUS_ALIGN_END(32);
+
+int AlignedElement::sLiveCount = 0;
+
+bool UNIT_TEST_AllocatorAlignment2()
+{
+    bool pass = true;
+    for (unsigned int count = 0; count < 20; ++count)
+    {
+        //arrays keep their elements aligned to their type, or more when asked
+        AlignedElement* elements = PG_NEW_ARRAY(&sGlobalAllocator, -1, "Aligned array", Pegasus::Alloc::PG_MEM_TEMP, AlignedElement, count);
+        AlignedElement* moreAligned = PG_NEW_ARRAY_ALIGN(&sGlobalAllocator, 256, -1, "Aligned array", Pegasus::Alloc::PG_MEM_TEMP, AlignedElement, count);
+        int* ints = PG_NEW_ARRAY(&sGlobalAllocator, -1, "Int array", Pegasus::Alloc::PG_MEM_TEMP, int, count);
+        pass = pass && Pegasus::Alloc::IsAligned(elements, 32) && Pegasus::Alloc::IsAligned(moreAligned, 256) && Pegasus::Alloc::IsAligned(ints, 4);
+        pass = pass && AlignedElement::sLiveCount == static_cast<int>(2 * count);
+        for (unsigned int i = 0; i < count; ++i) pass = pass && elements[i].mSelf == &elements[i] && moreAligned[i].mSelf == &moreAligned[i];
+        PG_DELETE_ARRAY(&sGlobalAllocator, elements);
+        PG_DELETE_ARRAY(&sGlobalAllocator, moreAligned);
+        PG_DELETE_ARRAY(&sGlobalAllocator, ints);
+    }
+
+    AlignedElement* element = PG_NEW_ALIGNED(&sGlobalAllocator, -1, "Aligned element", Pegasus::Alloc::PG_MEM_TEMP, AlignedElement)();
+    pass = pass && Pegasus::Alloc::IsAligned(element, 32) && element->mSelf == element;
+    PG_DELETE(&sGlobalAllocator, element);
+
+    //the block allocator packs its blocks, arrays in between the packed blocks stay aligned.
+    //Its blocks are only released all at once.
+    Pegasus::Memory::BlockAllocator blockAllocator;
+    blockAllocator.Initialize(1024, &sGlobalAllocator);
+    for (unsigned int count = 1; count < 20; ++count)
+    {
+        blockAllocator.Alloc(count, Pegasus::Alloc::PG_MEM_TEMP);
+        double* doubles = PG_NEW_ARRAY(&blockAllocator, -1, "Double array", Pegasus::Alloc::PG_MEM_TEMP, double, count);
+        pass = pass && Pegasus::Alloc::IsAligned(doubles, alignof(double));
+    }
+    blockAllocator.FreeMemory();
+    return pass && AlignedElement::sLiveCount == 0;
+}
+
 bool UNIT_TEST_ByteStream1()
 {
     Pegasus::Utils::ByteStream bs(&sGlobalAllocator);
@@ -9,11 +9,17 @@
 //! \date   3/30/2014
 //! \brief  Set of unit tests, used to prove soundness of 
 //!         any data structure. To run, edit Utils project to generate an executable, and run
+//!         Pass -b to run the benchmarks after the tests, -b <name> to run one of them
+//!         without the tests
 
 #include "Pegasus/UnitTests/UtilsTests.h"
+#include "Pegasus/UnitTests/UtilsBenchmarks.h"
+#include "Pegasus/Core/Time.h"
 #include <stdio.h>
+#include <string.h>
 
 typedef bool (*TestFunc)(void);
+typedef void (*BenchmarkFunc)(void);
 
 
 //! Utility function, presents and runs unit tests to tty
@@ -30,12 +36,42 @@ bool RunTests(TestFunc func, const char * testTitle, int& outSucceses, int& outT
     return result;
 }
 
-int main()
+//! Utility function, presents and runs benchmarks to tty
+//! \param filter name of the only benchmark to run, null to run all of them
+void RunBenchmark(BenchmarkFunc func, const char * benchmarkTitle, const char * filter)
+{
+    if (filter != nullptr && strcmp(filter, benchmarkTitle))
+    {
+        return;
+    }
+    printf("***********************\n");
+    printf("RUNNING BENCHMARK: %s\n", benchmarkTitle);
+    printf("***********************\n");
+    func();
+    printf("-------------------------\n\n");
+}
+
+int main(int argc, char* argv[])
 {
     int successes = 0;
     int total = 0;
 
-#define RUN_TEST(name) RunTests(UNIT_TEST_##name, #name, successes, total)
+    bool runBenchmarks = false;
+    const char* benchmarkFilter = nullptr;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "-b"))
+        {
+            runBenchmarks = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-')
+            {
+                benchmarkFilter = argv[++i];
+            }
+        }
+    }
+
+    // A single benchmark runs alone, so the memory it reports is its own
+#define RUN_TEST(name) if (benchmarkFilter == nullptr) RunTests(UNIT_TEST_##name, #name, successes, total)
     
     ///////////////////////////////////////////////////////////////////
     // UNIT TESTS - add here your UTILS package unit tests executions//
@@ -45,12 +81,19 @@ int main()
     RUN_TEST(Memcpy1);
     RUN_TEST(Memcpy2);
     RUN_TEST(Memcpy3);
+    RUN_TEST(Memcpy4);
+
+    //memmove
+    RUN_TEST(Memmove1);
+    RUN_TEST(Memmove2);
 
     //memset
     RUN_TEST(Memset1);
     RUN_TEST(Memset2);
     RUN_TEST(Memset3);
     RUN_TEST(Memset4);
+    RUN_TEST(Memset5);
+    RUN_TEST(Memset6);
 
     //strcmp
     RUN_TEST(Strcmp1);
@@ -108,6 +151,25 @@ int main()
     //Vector
     RUN_TEST(Vector1);
     RUN_TEST(Vector2);
+    RUN_TEST(Vector3);
+    RUN_TEST(Vector4);
+    RUN_TEST(Vector5);
+    RUN_TEST(Vector6);
+
+    //HashMap
+    RUN_TEST(HashMap1);
+    RUN_TEST(HashMap2);
+    RUN_TEST(HashMap3);
+    RUN_TEST(HashMap4);
+    RUN_TEST(HashSet1);
+
+    //ThreadCacheAllocator
+    RUN_TEST(ThreadCacheAllocator1);
+    RUN_TEST(ThreadCacheAllocator2);
+
+    //Allocator alignment
+    RUN_TEST(AllocatorAlignment1);
+    RUN_TEST(AllocatorAlignment2);
 
     //ByteStream
     RUN_TEST(ByteStream1);
@@ -116,5 +178,40 @@ int main()
 
     ///////////////////////////////////////////////////////////
 
-    printf("Final Results: %d out of %d succeeded\n", successes, total);
+    if (benchmarkFilter == nullptr)
+    {
+        printf("Final Results: %d out of %d succeeded\n", successes, total);
+    }
+
+    if (runBenchmarks)
+    {
+        Pegasus::Core::InitializePegasusTime();
+
+#define RUN_BENCHMARK(name) RunBenchmark(BENCHMARK_##name, #name, benchmarkFilter)
+
+        ///////////////////////////////////////////////////////////////////
+        // BENCHMARKS - add here your UTILS package benchmark executions //
+        ///////////////////////////////////////////////////////////////////
+
+        //memcpy, memmove, memset
+        RUN_BENCHMARK(Memcpy);
+        RUN_BENCHMARK(Memmove);
+        RUN_BENCHMARK(Memset);
+
+        //HashMap
+        RUN_BENCHMARK(HashMapInts);
+        RUN_BENCHMARK(HashMapStrings);
+
+        //Vector
+        RUN_BENCHMARK(VectorPush);
+        RUN_BENCHMARK(VectorInsert);
+        RUN_BENCHMARK(VectorDelete);
+        RUN_BENCHMARK(VectorCopy);
+
+        //Allocators
+        RUN_BENCHMARK(AllocatorMallocFree);
+        RUN_BENCHMARK(AllocatorThreadCache);
+
+        ///////////////////////////////////////////////////////////
+    }
 }
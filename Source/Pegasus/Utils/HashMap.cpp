@@ -0,0 +1,172 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                       Pegasus                                        */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file   HashMap.cpp
+//! \author agent
+//! \date   16th October 2026
+//! \brief  Open addressing hash map and hash set
+
+#include "Pegasus/Utils/HashMap.h"
+#include "Pegasus/Allocator/IAllocator.h"
+#include "Pegasus/Utils/Memset.h"
+
+using namespace Pegasus;
+using namespace Pegasus::Utils;
+
+//! smallest number of slots, one group
+static const unsigned int MIN_CAPACITY = HASH_TABLE_GROUP_WIDTH;
+
+//! \return the number of keys a table of a capacity holds before it grows, 7/8 of the slots
+static unsigned int GetMaxLoad(unsigned int capacity)
+{
+    return capacity - capacity / 8;
+}
+
+BaseHashTable::BaseHashTable(Alloc::IAllocator* allocator, Alloc::Category category, Alloc::Flags flags, unsigned int slotByteSize)
+: mAlloc(allocator),
+  mCategory(category),
+  mFlags(flags),
+  mSlotByteSize(slotByteSize),
+  mSlots(nullptr),
+  mCtrl(nullptr),
+  mCapacity(0),
+  mSize(0),
+  mGrowthLeft(0)
+{
+}
+
+BaseHashTable::~BaseHashTable()
+{
+    Reset();
+}
+
+void BaseHashTable::Allocate(unsigned int capacity)
+{
+    PG_ASSERT(capacity >= MIN_CAPACITY && (capacity & (capacity - 1)) == 0);
+    const unsigned int byteSize = capacity * mSlotByteSize + capacity + HASH_TABLE_GROUP_WIDTH;
+    mSlots = mAlloc->Alloc(byteSize, mFlags, mCategory, "HashTable::mSlots", __FILE__, __LINE__);
+    mCtrl = static_cast<char*>(mSlots) + capacity * mSlotByteSize;
+    Memset8(mCtrl, HashTableGroup::EMPTY, capacity + HASH_TABLE_GROUP_WIDTH);
+    mCapacity = capacity;
+    mSize = 0;
+    mGrowthLeft = GetMaxLoad(capacity);
+}
+
+void BaseHashTable::Reset()
+{
+    if (mSlots != nullptr)
+    {
+        mAlloc->Delete(mSlots);
+    }
+    mSlots = nullptr;
+    mCtrl = nullptr;
+    mCapacity = 0;
+    mSize = 0;
+    mGrowthLeft = 0;
+}
+
+void BaseHashTable::Clear()
+{
+    if (mCapacity > 0)
+    {
+        Memset8(mCtrl, HashTableGroup::EMPTY, mCapacity + HASH_TABLE_GROUP_WIDTH);
+    }
+    mSize = 0;
+    mGrowthLeft = GetMaxLoad(mCapacity);
+}
+
+void BaseHashTable::SetCtrl(unsigned int slot, char ctrl)
+{
+    mCtrl[slot] = ctrl;
+    if (slot < HASH_TABLE_GROUP_WIDTH)
+    {
+        mCtrl[mCapacity + slot] = ctrl;
+    }
+}
+
+unsigned int BaseHashTable::FindFree(unsigned int hash) const
+{
+    unsigned int pos = GetProbeStart(hash);
+    unsigned int step = 0;
+    while (true)
+    {
+        //the tables are never full, so the probe ends
+        unsigned int freeSlots = GetGroup(pos).MatchFree();
+        if (freeSlots != 0)
+        {
+            return GetGroupSlot(pos, HashTableGroup::GetFirst(freeSlots));
+        }
+        pos = GetProbeNext(pos, step);
+    }
+}
+
+void BaseHashTable::Rehash(unsigned int capacity, HashTableRelocateFunc relocate)
+{
+    void* oldSlots = mSlots;
+    const char* oldCtrl = mCtrl;
+    const unsigned int oldCapacity = mCapacity;
+    Allocate(capacity);
+    if (oldSlots != nullptr)
+    {
+        relocate(*this, oldSlots, oldCtrl, oldCapacity);
+        mAlloc->Delete(oldSlots);
+    }
+}
+
+void BaseHashTable::Reserve(unsigned int count, HashTableRelocateFunc relocate)
+{
+    unsigned int capacity = MIN_CAPACITY;
+    while (GetMaxLoad(capacity) < count)
+    {
+        capacity *= 2;
+    }
+    if (capacity > mCapacity)
+    {
+        Rehash(capacity, relocate);
+    }
+}
+
+unsigned int BaseHashTable::Claim(unsigned int hash, HashTableRelocateFunc relocate)
+{
+    if (mCapacity == 0)
+    {
+        Allocate(MIN_CAPACITY);
+    }
+
+    unsigned int slot = FindFree(hash);
+    if (mGrowthLeft == 0 && mCtrl[slot] == HashTableGroup::EMPTY)
+    {
+        //out of empty slots: grow, unless enough of the used slots are deleted ones a rehash frees
+        Rehash(mSize * 32 > mCapacity * 25 ? 2 * mCapacity : mCapacity, relocate);
+        slot = FindFree(hash);
+    }
+
+    //reusing a deleted slot does not take an empty one
+    if (mCtrl[slot] == HashTableGroup::EMPTY)
+    {
+        --mGrowthLeft;
+    }
+    SetCtrl(slot, GetH2(hash));
+    ++mSize;
+    return slot;
+}
+
+unsigned int BaseHashTable::ClaimForRelocation(unsigned int hash)
+{
+    unsigned int slot = FindFree(hash);
+    PG_ASSERT(mGrowthLeft > 0);
+    --mGrowthLeft;
+    SetCtrl(slot, GetH2(hash));
+    ++mSize;
+    return slot;
+}
+
+void BaseHashTable::Release(unsigned int slot)
+{
+    PG_ASSERT(IsUsed(slot));
+    SetCtrl(slot, HashTableGroup::DELETED);
+    --mSize;
+}
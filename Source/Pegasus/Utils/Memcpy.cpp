@@ -10,22 +10,25 @@
 //! \brief	Memcpy implementation
 
 #include "Pegasus/Utils/Memcpy.h"
+#include "Pegasus/Utils/Simd.h"
+
+#if PEGASUS_SIMD_X86
+#include <emmintrin.h>
+#include <immintrin.h>
+#endif
 
 #if   PEGASUS_POINTERSIZE_64BIT 
     typedef unsigned long long NumPtr;
 #else
-    typedef int NumPtr;
+    typedef unsigned int NumPtr;
 #endif
 
-//! Memcpy
-void * Pegasus::Utils::Memcpy(void* dst, const void* src, unsigned count)
-{
-    PG_ASSERTSTR( 
-        reinterpret_cast<NumPtr>(dst) < reinterpret_cast<NumPtr>(src) ||
-        (reinterpret_cast<NumPtr>(dst) > reinterpret_cast<NumPtr>(src) && (reinterpret_cast<NumPtr>(dst) - reinterpret_cast<NumPtr>(src)) >= static_cast<NumPtr>(count)),
-        "Fatal Memcpy!, memcpy intersection detected. Pegasus only supports fwd copy. this will result in a possible memory stomp."
-    );
+using namespace Pegasus;
+using namespace Pegasus::Utils;
 
+//! Copies in 8/4/2/1 byte steps, from the start. Safe if the destination is below the source.
+static void CopyForwardScalar(void* dst, const void* src, unsigned count)
+{
     unsigned blockSize = 0;
     unsigned i = 0;
 #if  PEGASUS_POINTERSIZE_64BIT 
@@ -65,7 +68,274 @@ void * Pegasus::Utils::Memcpy(void* dst, const void* src, unsigned count)
     {
         *(dst8bit++) = *(src8bit++);
     }
+}
+
+//! Copies the trailing bytes then 8 byte steps, from the end. Safe if the destination is above the source.
+static void CopyBackwardScalar(void* dst, const void* src, unsigned count)
+{
+    char * dst8bit = static_cast<char*>(dst);
+    const char * src8bit = static_cast<const char*>(src);
+    while ((count & 7) != 0)
+    {
+        --count;
+        dst8bit[count] = src8bit[count];
+    }
+
+    long long * dst64bit = static_cast<long long*>(dst);
+    const long long * src64bit = static_cast<const long long*>(src);
+    for (unsigned i = count >> 3; i-- > 0;)
+    {
+        dst64bit[i] = src64bit[i];
+    }
+}
+
+#if PEGASUS_SIMD_X86
+
+// The vector copies need at least one vector of bytes. They load the first and last vector of the
+// source before storing anything and store them last, and copy what is in between with aligned stores.
+// Every block is loaded before it is stored, so the forward copies can move memory down and the
+// backward copies can move memory up.
+
+static void CopyForwardSse2(char* dst, const char* src, unsigned count, bool nonTemporal)
+{
+    const __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    const __m128i tail = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + count - 16));
+
+    const unsigned skip = 16 - static_cast<unsigned>(reinterpret_cast<NumPtr>(dst) & 15);
+    __m128i* d = reinterpret_cast<__m128i*>(dst + skip);
+    const __m128i* s = reinterpret_cast<const __m128i*>(src + skip);
+    unsigned remaining = count - skip;
+    if (nonTemporal)
+    {
+        for (; remaining >= 64; remaining -= 64, d += 4, s += 4)
+        {
+            __m128i v0 = _mm_loadu_si128(s);
+            __m128i v1 = _mm_loadu_si128(s + 1);
+            __m128i v2 = _mm_loadu_si128(s + 2);
+            __m128i v3 = _mm_loadu_si128(s + 3);
+            _mm_stream_si128(d, v0);
+            _mm_stream_si128(d + 1, v1);
+            _mm_stream_si128(d + 2, v2);
+            _mm_stream_si128(d + 3, v3);
+        }
+        _mm_sfence();
+    }
+    else
+    {
+        for (; remaining >= 64; remaining -= 64, d += 4, s += 4)
+        {
+            __m128i v0 = _mm_loadu_si128(s);
+            __m128i v1 = _mm_loadu_si128(s + 1);
+            __m128i v2 = _mm_loadu_si128(s + 2);
+            __m128i v3 = _mm_loadu_si128(s + 3);
+            _mm_store_si128(d, v0);
+            _mm_store_si128(d + 1, v1);
+            _mm_store_si128(d + 2, v2);
+            _mm_store_si128(d + 3, v3);
+        }
+    }
+    for (; remaining >= 16; remaining -= 16, ++d, ++s)
+    {
+        _mm_store_si128(d, _mm_loadu_si128(s));
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), head);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + count - 16), tail);
+}
 
+static void CopyBackwardSse2(char* dst, const char* src, unsigned count)
+{
+    const __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    const __m128i tail = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + count - 16));
+
+    const unsigned skip = static_cast<unsigned>(reinterpret_cast<NumPtr>(dst + count) & 15);
+    __m128i* d = reinterpret_cast<__m128i*>(dst + count - skip);
+    const __m128i* s = reinterpret_cast<const __m128i*>(src + count - skip);
+    unsigned remaining = count - skip;
+    for (; remaining >= 64; remaining -= 64)
+    {
+        d -= 4;
+        s -= 4;
+        __m128i v0 = _mm_loadu_si128(s);
+        __m128i v1 = _mm_loadu_si128(s + 1);
+        __m128i v2 = _mm_loadu_si128(s + 2);
+        __m128i v3 = _mm_loadu_si128(s + 3);
+        _mm_store_si128(d, v0);
+        _mm_store_si128(d + 1, v1);
+        _mm_store_si128(d + 2, v2);
+        _mm_store_si128(d + 3, v3);
+    }
+    for (; remaining >= 16; remaining -= 16)
+    {
+        --d;
+        --s;
+        _mm_store_si128(d, _mm_loadu_si128(s));
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + count - 16), tail);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), head);
+}
+
+PG_TARGET_AVX2 static void CopyForwardAvx2(char* dst, const char* src, unsigned count, bool nonTemporal)
+{
+    const __m256i head = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+    const __m256i tail = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + count - 32));
+
+    const unsigned skip = 32 - static_cast<unsigned>(reinterpret_cast<NumPtr>(dst) & 31);
+    __m256i* d = reinterpret_cast<__m256i*>(dst + skip);
+    const __m256i* s = reinterpret_cast<const __m256i*>(src + skip);
+    unsigned remaining = count - skip;
+    if (nonTemporal)
+    {
+        for (; remaining >= 128; remaining -= 128, d += 4, s += 4)
+        {
+            __m256i v0 = _mm256_loadu_si256(s);
+            __m256i v1 = _mm256_loadu_si256(s + 1);
+            __m256i v2 = _mm256_loadu_si256(s + 2);
+            __m256i v3 = _mm256_loadu_si256(s + 3);
+            _mm256_stream_si256(d, v0);
+            _mm256_stream_si256(d + 1, v1);
+            _mm256_stream_si256(d + 2, v2);
+            _mm256_stream_si256(d + 3, v3);
+        }
+        _mm_sfence();
+    }
+    else
+    {
+        for (; remaining >= 128; remaining -= 128, d += 4, s += 4)
+        {
+            __m256i v0 = _mm256_loadu_si256(s);
+            __m256i v1 = _mm256_loadu_si256(s + 1);
+            __m256i v2 = _mm256_loadu_si256(s + 2);
+            __m256i v3 = _mm256_loadu_si256(s + 3);
+            _mm256_store_si256(d, v0);
+            _mm256_store_si256(d + 1, v1);
+            _mm256_store_si256(d + 2, v2);
+            _mm256_store_si256(d + 3, v3);
+        }
+    }
+    for (; remaining >= 32; remaining -= 32, ++d, ++s)
+    {
+        _mm256_store_si256(d, _mm256_loadu_si256(s));
+    }
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), head);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + count - 32), tail);
+    _mm256_zeroupper();
+}
+
+PG_TARGET_AVX2 static void CopyBackwardAvx2(char* dst, const char* src, unsigned count)
+{
+    const __m256i head = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+    const __m256i tail = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + count - 32));
+
+    const unsigned skip = static_cast<unsigned>(reinterpret_cast<NumPtr>(dst + count) & 31);
+    __m256i* d = reinterpret_cast<__m256i*>(dst + count - skip);
+    const __m256i* s = reinterpret_cast<const __m256i*>(src + count - skip);
+    unsigned remaining = count - skip;
+    for (; remaining >= 128; remaining -= 128)
+    {
+        d -= 4;
+        s -= 4;
+        __m256i v0 = _mm256_loadu_si256(s);
+        __m256i v1 = _mm256_loadu_si256(s + 1);
+        __m256i v2 = _mm256_loadu_si256(s + 2);
+        __m256i v3 = _mm256_loadu_si256(s + 3);
+        _mm256_store_si256(d, v0);
+        _mm256_store_si256(d + 1, v1);
+        _mm256_store_si256(d + 2, v2);
+        _mm256_store_si256(d + 3, v3);
+    }
+    for (; remaining >= 32; remaining -= 32)
+    {
+        --d;
+        --s;
+        _mm256_store_si256(d, _mm256_loadu_si256(s));
+    }
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + count - 32), tail);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), head);
+    _mm256_zeroupper();
+}
+
+#endif
+
+//! Copies from the start with the best implementation. Safe if the destination is below the source.
+//! \param nonTemporal true to bypass the cache, only if the buffers do not overlap
+static void CopyForward(void* dst, const void* src, unsigned count, bool nonTemporal)
+{
+#if PEGASUS_SIMD_X86
+    if (count >= 16)
+    {
+        const SimdLevel level = GetSimdLevel();
+        if (level == SIMD_LEVEL_AVX2 && count >= 32)
+        {
+            CopyForwardAvx2(static_cast<char*>(dst), static_cast<const char*>(src), count, nonTemporal);
+            return;
+        }
+        else if (level >= SIMD_LEVEL_SSE2)
+        {
+            CopyForwardSse2(static_cast<char*>(dst), static_cast<const char*>(src), count, nonTemporal);
+            return;
+        }
+    }
+#endif
+    CopyForwardScalar(dst, src, count);
+}
+
+//! Copies from the end with the best implementation. Safe if the destination is above the source.
+static void CopyBackward(void* dst, const void* src, unsigned count)
+{
+#if PEGASUS_SIMD_X86
+    if (count >= 16)
+    {
+        const SimdLevel level = GetSimdLevel();
+        if (level == SIMD_LEVEL_AVX2 && count >= 32)
+        {
+            CopyBackwardAvx2(static_cast<char*>(dst), static_cast<const char*>(src), count);
+            return;
+        }
+        else if (level >= SIMD_LEVEL_SSE2)
+        {
+            CopyBackwardSse2(static_cast<char*>(dst), static_cast<const char*>(src), count);
+            return;
+        }
+    }
+#endif
+    CopyBackwardScalar(dst, src, count);
+}
+
+//! Memcpy
+void * Pegasus::Utils::Memcpy(void* dst, const void* src, unsigned count)
+{
+    PG_ASSERTSTR( 
+        reinterpret_cast<NumPtr>(dst) < reinterpret_cast<NumPtr>(src) ||
+        (reinterpret_cast<NumPtr>(dst) > reinterpret_cast<NumPtr>(src) && (reinterpret_cast<NumPtr>(dst) - reinterpret_cast<NumPtr>(src)) >= static_cast<NumPtr>(count)),
+        "Fatal Memcpy!, memcpy intersection detected. Pegasus only supports fwd copy. this will result in a possible memory stomp."
+    );
+
+    CopyForward(dst, src, count, count >= PG_SIMD_NON_TEMPORAL_BYTESIZE);
+    return dst;
+}
+
+//! Memmove
+void * Pegasus::Utils::Memmove(void* dst, const void* src, unsigned count)
+{
+    const NumPtr dstAddress = reinterpret_cast<NumPtr>(dst);
+    const NumPtr srcAddress = reinterpret_cast<NumPtr>(src);
+    if (dstAddress == srcAddress)
+    {
+        return dst;
+    }
+
+    const bool overlaps = dstAddress < srcAddress ? srcAddress - dstAddress < static_cast<NumPtr>(count) : dstAddress - srcAddress < static_cast<NumPtr>(count);
+    if (!overlaps || dstAddress < srcAddress)
+    {
+        CopyForward(dst, src, count, !overlaps && count >= PG_SIMD_NON_TEMPORAL_BYTESIZE);
+    }
+    else
+    {
+        CopyBackward(dst, src, count);
+    }
     return dst;
-    
 }
@@ -10,34 +10,166 @@
 //! \brief	Memset implementation (all its flavors)
 
 #include "Pegasus/Utils/Memset.h"
+#include "Pegasus/Utils/Simd.h"
+
+#if PEGASUS_SIMD_X86
+#include <emmintrin.h>
+#include <immintrin.h>
+#endif
+
+#if   PEGASUS_POINTERSIZE_64BIT 
+    typedef unsigned long long NumPtr;
+#else
+    typedef unsigned int NumPtr;
+#endif
 
 namespace Pegasus {
 namespace Utils {
 
+//! \param pattern 32 bit pattern repeated in memory
+//! \param offset offset in bytes from the start of the pattern in memory
+//! \return the pattern starting at the offset
+static unsigned int RotatePattern(unsigned int pattern, NumPtr offset)
+{
+    const unsigned int shift = static_cast<unsigned int>(offset & 3) * 8;
+    return shift == 0 ? pattern : (pattern >> shift) | (pattern << (32 - shift));
+}
 
-void* Memset8(void * destination, char value, unsigned int size)
+//! Fills memory in 32 bit steps, then the leftover bytes
+static void FillScalar(char* destination, unsigned int pattern, unsigned int size)
 {
-    // Copy the major part of the buffer using 32 bit blocks
-    if (size >= 4)
+    unsigned int numBlocks = size >> 2;
+    unsigned int * uintDestination = reinterpret_cast<unsigned int *>(destination);
+    while (numBlocks-- > 0)
     {
-        unsigned long value32 = static_cast<unsigned long>(value);
-        value32 = (value32 << 8) | value32;
-        value32 = (value32 << 16) | value32;
-        Memset32(destination, value32, size & 0xFFFFFFFC);
+        *uintDestination++ = pattern;
     }
 
-    // Copy the leftover bytes if the buffer size is not a multiple of 4
-    if (size & 3)
+    char * byteDestination = reinterpret_cast<char *>(uintDestination);
+    for (unsigned int i = 0; i < (size & 3); ++i)
+    {
+        *byteDestination++ = static_cast<char>(pattern >> (8 * i));
+    }
+}
+
+#if PEGASUS_SIMD_X86
+
+// The vector fills need at least one vector of bytes. They store the first and last vector unaligned,
+// and what is in between with aligned stores of the pattern rotated to the alignment.
+
+static void FillSse2(char* destination, unsigned int pattern, unsigned int size, bool nonTemporal)
+{
+    const unsigned int skip = 16 - static_cast<unsigned int>(reinterpret_cast<NumPtr>(destination) & 15);
+    const __m128i head = _mm_set1_epi32(static_cast<int>(pattern));
+    const __m128i tail = _mm_set1_epi32(static_cast<int>(RotatePattern(pattern, size - 16)));
+    const __m128i body = _mm_set1_epi32(static_cast<int>(RotatePattern(pattern, skip)));
+
+    __m128i* d = reinterpret_cast<__m128i*>(destination + skip);
+    unsigned int remaining = size - skip;
+    if (nonTemporal)
     {
-        char * byteDestination = static_cast<char *>(destination);
-        byteDestination += size & 0xFFFFFFFC;
-        size = size & 3;
-        while (size-- > 0)
+        for (; remaining >= 64; remaining -= 64, d += 4)
         {
-            *byteDestination++ = value;
+            _mm_stream_si128(d, body);
+            _mm_stream_si128(d + 1, body);
+            _mm_stream_si128(d + 2, body);
+            _mm_stream_si128(d + 3, body);
         }
+        _mm_sfence();
     }
+    else
+    {
+        for (; remaining >= 64; remaining -= 64, d += 4)
+        {
+            _mm_store_si128(d, body);
+            _mm_store_si128(d + 1, body);
+            _mm_store_si128(d + 2, body);
+            _mm_store_si128(d + 3, body);
+        }
+    }
+    for (; remaining >= 16; remaining -= 16, ++d)
+    {
+        _mm_store_si128(d, body);
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), head);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + size - 16), tail);
+}
+
+PG_TARGET_AVX2 static void FillAvx2(char* destination, unsigned int pattern, unsigned int size, bool nonTemporal)
+{
+    const unsigned int skip = 32 - static_cast<unsigned int>(reinterpret_cast<NumPtr>(destination) & 31);
+    const __m256i head = _mm256_set1_epi32(static_cast<int>(pattern));
+    const __m256i tail = _mm256_set1_epi32(static_cast<int>(RotatePattern(pattern, size - 32)));
+    const __m256i body = _mm256_set1_epi32(static_cast<int>(RotatePattern(pattern, skip)));
 
+    __m256i* d = reinterpret_cast<__m256i*>(destination + skip);
+    unsigned int remaining = size - skip;
+    if (nonTemporal)
+    {
+        for (; remaining >= 128; remaining -= 128, d += 4)
+        {
+            _mm256_stream_si256(d, body);
+            _mm256_stream_si256(d + 1, body);
+            _mm256_stream_si256(d + 2, body);
+            _mm256_stream_si256(d + 3, body);
+        }
+        _mm_sfence();
+    }
+    else
+    {
+        for (; remaining >= 128; remaining -= 128, d += 4)
+        {
+            _mm256_store_si256(d, body);
+            _mm256_store_si256(d + 1, body);
+            _mm256_store_si256(d + 2, body);
+            _mm256_store_si256(d + 3, body);
+        }
+    }
+    for (; remaining >= 32; remaining -= 32, ++d)
+    {
+        _mm256_store_si256(d, body);
+    }
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination), head);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + size - 32), tail);
+    _mm256_zeroupper();
+}
+
+#endif
+
+//! Fills memory with the best implementation. Byte i of the destination gets byte i % 4 of the pattern.
+static void Fill(void* destination, unsigned int pattern, unsigned int size)
+{
+    char* byteDestination = static_cast<char*>(destination);
+#if PEGASUS_SIMD_X86
+    if (size >= 16)
+    {
+        const SimdLevel level = GetSimdLevel();
+        const bool nonTemporal = size >= PG_SIMD_NON_TEMPORAL_BYTESIZE;
+        if (level == SIMD_LEVEL_AVX2 && size >= 32)
+        {
+            FillAvx2(byteDestination, pattern, size, nonTemporal);
+            return;
+        }
+        else if (level >= SIMD_LEVEL_SSE2)
+        {
+            FillSse2(byteDestination, pattern, size, nonTemporal);
+            return;
+        }
+    }
+#endif
+    FillScalar(byteDestination, pattern, size);
+}
+
+//----------------------------------------------------------------------------------------
+
+void* Memset8(void * destination, char value, unsigned int size)
+{
+    unsigned int value32 = static_cast<unsigned char>(value);
+    value32 = (value32 << 8) | value32;
+    value32 = (value32 << 16) | value32;
+    Fill(destination, value32, size);
     return destination;
 }
 
@@ -46,13 +178,7 @@ void* Memset8(void * destination, char value, unsigned int size)
 void * Memset32(void * destination, unsigned long value, unsigned int size)
 {
     PG_ASSERTSTR((size & 0x3) == 0, "The size of the output buffer must be a multiple of 4");
-    unsigned int numBlocks = size >> 2;
-
-    unsigned long * ulongDestination = static_cast<unsigned long *>(destination);
-    while (numBlocks-- > 0)
-    {
-        *ulongDestination++ = value;
-    }
+    Fill(destination, static_cast<unsigned int>(value), size & 0xFFFFFFFC);
     return destination;
 }
 
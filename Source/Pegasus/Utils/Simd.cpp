@@ -0,0 +1,115 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                       Pegasus                                        */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file   Simd.cpp
+//! \author agent
+//! \date   16th October 2026
+//! \brief  Detection of the SIMD instruction sets the utilities are vectorized with
+
+#include "Pegasus/Utils/Simd.h"
+
+#if PEGASUS_SIMD_X86
+#if PEGASUS_COMPILER_MSVC
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+using namespace Pegasus;
+using namespace Pegasus::Utils;
+
+#if PEGASUS_SIMD_X86
+
+//! runs the cpuid instruction
+//! \param leaf the function of cpuid
+//! \param outRegs output, eax, ebx, ecx and edx
+static void Cpuid(int leaf, unsigned int outRegs[4])
+{
+#if PEGASUS_COMPILER_MSVC
+    int regs[4];
+    __cpuidex(regs, leaf, 0);
+    for (int r = 0; r < 4; ++r)
+    {
+        outRegs[r] = static_cast<unsigned int>(regs[r]);
+    }
+#else
+    __cpuid_count(leaf, 0, outRegs[0], outRegs[1], outRegs[2], outRegs[3]);
+#endif
+}
+
+//! \return the register state the os saves on context switches (XCR0)
+static unsigned long long GetSavedRegisterState()
+{
+#if PEGASUS_COMPILER_MSVC
+    return _xgetbv(0);
+#else
+    unsigned int eax = 0, edx = 0;
+    __asm__ volatile ("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+}
+
+#endif
+
+//! \return the best instruction set of the processor
+static SimdLevel DetectSimdLevel()
+{
+#if PEGASUS_SIMD_X86
+    unsigned int regs[4];
+    Cpuid(0, regs);
+    const unsigned int maxLeaf = regs[0];
+
+    Cpuid(1, regs);
+    const bool hasSse2 = (regs[3] & (1 << 26)) != 0;
+    const bool hasOsXsave = (regs[2] & (1 << 27)) != 0;
+    const bool hasAvx = (regs[2] & (1 << 28)) != 0;
+    if (!hasSse2)
+    {
+        return SIMD_LEVEL_SCALAR;
+    }
+
+    //avx2 also needs the os to save the ymm registers
+    if (hasOsXsave && hasAvx && maxLeaf >= 7 && (GetSavedRegisterState() & 0x6) == 0x6)
+    {
+        Cpuid(7, regs);
+        if ((regs[1] & (1 << 5)) != 0)
+        {
+            return SIMD_LEVEL_AVX2;
+        }
+    }
+    return SIMD_LEVEL_SSE2;
+#else
+    return SIMD_LEVEL_SCALAR;
+#endif
+}
+
+//! both are zero (scalar) until the static initialization runs
+static SimdLevel sSupportedSimdLevel = DetectSimdLevel();
+static SimdLevel sSimdLevel = sSupportedSimdLevel;
+
+SimdLevel Pegasus::Utils::GetSupportedSimdLevel()
+{
+    return sSupportedSimdLevel;
+}
+
+SimdLevel Pegasus::Utils::GetSimdLevel()
+{
+    return sSimdLevel;
+}
+
+void Pegasus::Utils::SetSimdLevel(SimdLevel level)
+{
+    PG_ASSERT(level >= SIMD_LEVEL_SCALAR && level < SIMD_LEVEL_COUNT);
+    sSimdLevel = level < sSupportedSimdLevel ? level : sSupportedSimdLevel;
+}
+
+const char* Pegasus::Utils::GetSimdLevelName(SimdLevel level)
+{
+    static const char* sNames[SIMD_LEVEL_COUNT] = { "scalar", "sse2", "avx2" };
+    PG_ASSERT(level >= SIMD_LEVEL_SCALAR && level < SIMD_LEVEL_COUNT);
+    return sNames[level];
+}
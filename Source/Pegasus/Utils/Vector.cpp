@@ -31,34 +31,99 @@ BaseVector::~BaseVector()
     Clear();
 }
 
-void* BaseVector::PushEmpty()
+//! smallest capacity allocated
+static const unsigned int MIN_CAPACITY = 16;
+
+void BaseVector::Reallocate(unsigned int count, RelocateFunc relocate)
 {
-    if (mDataCount <= mDataSize)
+    PG_ASSERT(count >= mDataSize);
+    void* oldData = mData;
+    mData = count == 0 ? nullptr : PG_NEW_ARRAY(mAlloc, -1, "Vector Page", Alloc::PG_MEM_PERM, char, count * mElementByteSize);
+    if (oldData != nullptr)
     {
-        const unsigned int PAGE_SIZE = 64;
-        void* oldData = mData;
-        
-        mData = PG_NEW_ARRAY(mAlloc, -1, "Vector Page", Alloc::PG_MEM_PERM, char, (mDataCount + PAGE_SIZE)*mElementByteSize);
-
-        if (oldData != nullptr)
+        if (relocate != nullptr)
+        {
+            relocate(mData, oldData, mDataSize);
+        }
+        else
         {
-            Utils::Memcpy(mData, oldData, mDataCount*mElementByteSize);
-            PG_DELETE_ARRAY(mAlloc,  static_cast<char*>(oldData));
+            Utils::Memcpy(mData, oldData, mDataSize * mElementByteSize);
         }
+        PG_DELETE_ARRAY(mAlloc, static_cast<char*>(oldData));
+    }
+    mDataCount = count;
+}
+
+void BaseVector::Reserve(unsigned int count, RelocateFunc relocate)
+{
+    if (count > mDataCount)
+    {
+        //grow geometrically, so n pushes move O(n) elements
+        unsigned int newCount = mDataCount < MIN_CAPACITY ? MIN_CAPACITY : 2 * mDataCount;
+        Reallocate(count > newCount ? count : newCount, relocate);
+    }
+}
+
+void BaseVector::ShrinkToFit(RelocateFunc relocate)
+{
+    if (mDataCount > mDataSize)
+    {
+        Reallocate(mDataSize, relocate);
+    }
+}
 
-        mDataCount += PAGE_SIZE;
+void* BaseVector::PushEmpty(RelocateFunc relocate)
+{
+    if (mDataCount <= mDataSize)
+    {
+        Reserve(mDataSize + 1, relocate);
     }
 
     return static_cast<char*>(mData) + (mDataSize++) * mElementByteSize;
 }
 
-void BaseVector::Delete(unsigned int index)
+void* BaseVector::PushEmpty(unsigned int count, RelocateFunc relocate)
 {
-    PG_ASSERT(index >= 0 && index < mDataSize);
+    Reserve(mDataSize + count, relocate);
+    void* first = static_cast<char*>(mData) + mDataSize * mElementByteSize;
+    mDataSize += count;
+    return first;
+}
+
+void* BaseVector::Insert(unsigned int index, RelocateFunc relocate)
+{
+    PG_ASSERT(index <= mDataSize);
+    Reserve(mDataSize + 1, relocate);
+    char* element = static_cast<char*>(mData) + index * mElementByteSize;
+    if (index < mDataSize)
+    {
+        if (relocate != nullptr)
+        {
+            relocate(element + mElementByteSize, element, mDataSize - index);
+        }
+        else
+        {
+            Utils::Memmove(element + mElementByteSize, element, (mDataSize - index) * mElementByteSize);
+        }
+    }
+    ++mDataSize;
+    return element;
+}
+
+void BaseVector::Delete(unsigned int index, RelocateFunc relocate)
+{
+    PG_ASSERT(index < mDataSize);
     char* memToDelete = static_cast<char*>(mData) + index * mElementByteSize;
     if (index < mDataSize - 1)
     {
-        Utils::Memcpy(memToDelete, memToDelete + mElementByteSize, (mDataSize - index - 1)*mElementByteSize);
+        if (relocate != nullptr)
+        {
+            relocate(memToDelete, memToDelete + mElementByteSize, mDataSize - index - 1);
+        }
+        else
+        {
+            Utils::Memmove(memToDelete, memToDelete + mElementByteSize, (mDataSize - index - 1)*mElementByteSize);
+        }
     }
     --mDataSize;
 }
@@ -73,3 +138,20 @@ void BaseVector::Clear()
     mDataSize = 0;
     mDataCount = 0;
 }
+
+void BaseVector::Swap(BaseVector& other)
+{
+    PG_ASSERT(mElementByteSize == other.mElementByteSize);
+    void* data = mData;
+    unsigned int count = mDataCount;
+    unsigned int size = mDataSize;
+    Alloc::IAllocator* alloc = mAlloc;
+    mData = other.mData;
+    mDataCount = other.mDataCount;
+    mDataSize = other.mDataSize;
+    mAlloc = other.mAlloc;
+    other.mData = data;
+    other.mDataCount = count;
+    other.mDataSize = size;
+    other.mAlloc = alloc;
+}
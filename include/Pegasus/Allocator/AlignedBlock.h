@@ -0,0 +1,84 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                       Pegasus                                        */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file   AlignedBlock.h
+//! \author agent
+//! \date   16th October 2026
+//! \brief  Aligned blocks placed inside a larger allocation, for the allocators built on malloc.
+
+#ifndef PEGASUS_ALLOC_ALIGNEDBLOCK_H
+#define PEGASUS_ALLOC_ALIGNEDBLOCK_H
+
+#include "Pegasus/Allocator/IAllocator.h"
+
+namespace Pegasus {
+namespace Alloc {
+
+//! Header stored right before an aligned block
+struct AlignedBlockHeader
+{
+    unsigned int mTag;    //!< left to the allocator, the allocator ID for instance
+    unsigned int mOffset; //!< bytes from the start of the allocation to the block
+};
+
+//! \param align alignment of the block, a power of two
+//! \return the alignment actually used, never below PG_DEFAULT_ALIGNMENT
+inline Alignment GetBlockAlignment(Alignment align)
+{
+    return align > PG_DEFAULT_ALIGNMENT ? align : PG_DEFAULT_ALIGNMENT;
+}
+
+//! \param size size of the block, in bytes
+//! \param align alignment of the block, a power of two
+//! \return the size of the allocation fitting the block with its header, whatever the address of the allocation
+inline size_t GetAlignedAllocationSize(size_t size, Alignment align)
+{
+    return size + sizeof(AlignedBlockHeader) + GetBlockAlignment(align) - 1;
+}
+
+//! Places an aligned block and its header inside an allocation of GetAlignedAllocationSize bytes
+//! \param memory start of the allocation
+//! \param align alignment of the block, a power of two
+//! \param tag value stored in the header
+//! \return the block
+inline void* PlaceAlignedBlock(void* memory, Alignment align, unsigned int tag)
+{
+    const Alignment blockAlign = GetBlockAlignment(align);
+    const size_t start = reinterpret_cast<size_t>(memory) + sizeof(AlignedBlockHeader);
+    char* block = reinterpret_cast<char*>((start + blockAlign - 1) & ~(blockAlign - 1));
+    AlignedBlockHeader* header = reinterpret_cast<AlignedBlockHeader*>(block) - 1;
+    header->mTag = tag;
+    header->mOffset = static_cast<unsigned int>(block - static_cast<char*>(memory));
+    return block;
+}
+
+//! \param block block returned by PlaceAlignedBlock
+//! \return the header of the block
+inline const AlignedBlockHeader* GetAlignedBlockHeader(const void* block)
+{
+    return static_cast<const AlignedBlockHeader*>(block) - 1;
+}
+
+//! \param block block returned by PlaceAlignedBlock
+//! \return the start of the allocation holding the block
+inline void* GetAlignedBlockMemory(void* block)
+{
+    return static_cast<char*>(block) - GetAlignedBlockHeader(block)->mOffset;
+}
+
+//! \param ptr an address
+//! \param align an alignment, a power of two
+//! \return true if the address is aligned
+inline bool IsAligned(const void* ptr, Alignment align)
+{
+    return (reinterpret_cast<size_t>(ptr) & (align - 1)) == 0;
+}
+
+
+}   // namespace Alloc
+}   // namespace Pegasus
+
+#endif  // PEGASUS_ALLOC_ALIGNEDBLOCK_H
@@ -18,14 +18,17 @@
 //! Macro for allocating memory
 #define PG_NEW(_alloc, _cat, _debug_str, _flags) new(_alloc, _flags, _cat, _debug_str, __FILE__, __LINE__)
 
-//! Macro for allocating memory, aligned
-#define PG_NEW_ALIGN(_alloc, _align, _cat, _debug_str, _flags) new(_alloc, _align, _flags, _cat, _debug_str, __FILE__, __LINE__)
+//! Macro for allocating memory, aligned. PG_NEW aligns to PG_DEFAULT_ALIGNMENT already.
+#define PG_NEW_ALIGN(_alloc, _align, _cat, _debug_str, _flags) new(_alloc, static_cast<Pegasus::Alloc::Alignment>(_align), _flags, _cat, _debug_str, __FILE__, __LINE__)
 
-//! Macro for allocating memory, in an array
+//! Macro for allocating memory, aligned to the alignment of a type
+#define PG_NEW_ALIGNED(_alloc, _cat, _debug_str, _flags, _type) new(_alloc, static_cast<Pegasus::Alloc::Alignment>(alignof(_type)), _flags, _cat, _debug_str, __FILE__, __LINE__) _type
+
+//! Macro for allocating memory, in an array. The elements are aligned to the alignment of their type.
 #define PG_NEW_ARRAY(_alloc, _cat, _debug_str, _flags, _type, _numElements) Pegasus::Alloc::internal::NewArray<_type>(_alloc, _flags, _numElements, _cat, _debug_str, __FILE__, __LINE__)
 
 //! Macro for allocating memory, in an array aligned
-#define PG_NEW_ARRAY_ALIGN(_alloc, _align, _cat, _debug_str, _flags, _type, _numElements) Pegasus::Alloc::internal::NewArrayAligned<_type>(_alloc, _align, _numElements, _cat, _flags, _debug_str, __FILE__, __LINE__)
+#define PG_NEW_ARRAY_ALIGN(_alloc, _align, _cat, _debug_str, _flags, _type, _numElements) Pegasus::Alloc::internal::NewArrayAligned<_type>(_alloc, _align, _flags, _numElements, _cat, _debug_str, __FILE__, __LINE__)
 
 //! Macro for freeing memory (to use with PG_NEW)
 #define PG_DELETE(alloc, ptr) Pegasus::Alloc::internal::Delete(alloc, ptr);
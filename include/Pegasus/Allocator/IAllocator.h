@@ -12,6 +12,9 @@
 #ifndef PEGASUS_ALLOC_IALLOCATOR_H
 #define PEGASUS_ALLOC_IALLOCATOR_H
 
+//! Alignment of every block returned by IAllocator::Alloc, enough for the SSE types
+#define PG_DEFAULT_ALIGNMENT 16
+
 namespace Pegasus {
 namespace Alloc {
 
@@ -39,7 +42,7 @@ public:
     ~IAllocator() {};
 
 
-    //! Allocate a block of memory
+    //! Allocate a block of memory, aligned to GetAlignment()
     //! \param Size of the allocation, in bytes.
     //! \param flags Allocation flags.
     //! \param category Allocation category.
@@ -51,7 +54,7 @@ public:
 
     //! Allocate a block of memory, aligned
     //! \param Size of the allocation, in bytes.
-    //! \param align Allocation alignment, in bytes.
+    //! \param align Allocation alignment, in bytes. A power of two.
     //! \param flags Allocation flags.
     //! \param category Allocation category.
     //! \param debugText Debug name for this allocation.
@@ -64,6 +67,9 @@ public:
     //! Free a block of memory
     //! \param ptr Address of the memory.
     virtual void Delete(void* ptr) = 0;
+
+    //! \return alignment of the blocks returned by Alloc, in bytes. Blocks needing more go through AllocAlign
+    virtual Alignment GetAlignment() const { return PG_DEFAULT_ALIGNMENT; }
 };
 
 
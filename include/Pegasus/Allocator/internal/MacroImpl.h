@@ -19,25 +19,34 @@ namespace Pegasus {
 namespace Alloc {
 namespace internal {
 
-//! Allocates a new array of objects, initializing all of the objects with their default constructor
-//! \param T Type of the objects.
-//! \param alloc Allocator to use when grabbing memory.
-//! \param flags Allocation flags.
+//! Header stored right before the elements of an array
+struct ArrayHeader
+{
+    unsigned int mOffset; //!< bytes from the start of the allocation to the first element
+    unsigned int mCount;  //!< number of elements
+};
+
+//! \param align alignment of the elements, a power of two
+//! \return bytes between the start of the allocation and the first element, keeping the elements aligned
+inline unsigned int GetArrayOffset(Alignment align)
+{
+    return align > sizeof(ArrayHeader) ? static_cast<unsigned int>(align) : static_cast<unsigned int>(sizeof(ArrayHeader));
+}
+
+//! Writes the header of an array and constructs its elements
+//! \param block allocation holding the array
+//! \param offset bytes from the start of the allocation to the first element
 //! \param count Number of elements in the array.
-//! \param category Allocation category.
-//! \param debug_str Debug name for the allocation.
-//! \param file Filename of the allocation.
-//! \param line Line number of the allocation.
+//! \return the first element
 template <typename T>
-inline T* NewArray(IAllocator* alloc, Flags flags, unsigned int count, Category category, const char* debug_str, const char* file, unsigned int line)
+inline T* ConstructArray(void* block, unsigned int offset, unsigned int count)
 {
-    // Grab memory, and request an extra int for the size
-    const unsigned int blockSize = sizeof(T) * count + sizeof(unsigned int);
-    T* block = (T*) alloc->Alloc(blockSize, flags, category, debug_str, file, line);
-    T* arrayPtr = (T*) (((unsigned int*) block) + 1);
+    T* arrayPtr = reinterpret_cast<T*>(static_cast<char*>(block) + offset);
 
-    // Cache the size at the front
-    *((unsigned int*) block) = count;
+    // Cache the offset and the size at the front
+    ArrayHeader* header = reinterpret_cast<ArrayHeader*>(arrayPtr) - 1;
+    header->mOffset = offset;
+    header->mCount = count;
 
     // Init the array with placement new from beginning to end
     for (unsigned int i = 0; i < count; i++)
@@ -51,9 +60,9 @@ inline T* NewArray(IAllocator* alloc, Flags flags, unsigned int count, Category
 //----------------------------------------------------------------------------------------
 
 //! Allocates a new array of objects, initializing all of the objects with their default constructor
+//! The elements are aligned to the alignment of their type.
 //! \param T Type of the objects.
 //! \param alloc Allocator to use when grabbing memory.
-//! \param align Alignment of the allocation, in bytes.
 //! \param flags Allocation flags.
 //! \param count Number of elements in the array.
 //! \param category Allocation category.
@@ -61,23 +70,37 @@ inline T* NewArray(IAllocator* alloc, Flags flags, unsigned int count, Category
 //! \param file Filename of the allocation.
 //! \param line Line number of the allocation.
 template <typename T>
-inline T* NewArrayAligned(IAllocator* alloc, Alignment align, Flags flags, unsigned int count, Category category, const char* debug_str, const char* file, unsigned int line)
+inline T* NewArray(IAllocator* alloc, Flags flags, unsigned int count, Category category, const char* debug_str, const char* file, unsigned int line)
 {
-    // Grab memory, and request an extra int for the size
-    const unsigned int blockSize = sizeof(T) * count + sizeof(unsigned int);
-    T* block = (T*) alloc->AllocAlign(blockSize, align, flags, category, debug_str, file, line);
-    T* arrayPtr = (T*) (((unsigned int*) block) + 1);
-
-    // Cache the size at the front
-    *((unsigned int*) block) = count;
+    // Grab memory, and request room for the header
+    const unsigned int offset = GetArrayOffset(alignof(T));
+    const size_t blockSize = sizeof(T) * count + offset;
+    void* block = alignof(T) > alloc->GetAlignment() ? alloc->AllocAlign(blockSize, alignof(T), flags, category, debug_str, file, line)
+                                                     : alloc->Alloc(blockSize, flags, category, debug_str, file, line);
+    return ConstructArray<T>(block, offset, count);
+}
 
-    // Init the array with placement new from beginning to end
-    for (unsigned int i = 0; i < count, i++)
-    {
-        new(arrayPtr + i) T();
-    }
+//----------------------------------------------------------------------------------------
 
-    return arrayPtr;
+//! Allocates a new array of objects, initializing all of the objects with their default constructor
+//! \param T Type of the objects.
+//! \param alloc Allocator to use when grabbing memory.
+//! \param align Alignment of the elements, in bytes. Raised to the alignment of their type.
+//! \param flags Allocation flags.
+//! \param count Number of elements in the array.
+//! \param category Allocation category.
+//! \param debug_str Debug name for the allocation.
+//! \param file Filename of the allocation.
+//! \param line Line number of the allocation.
+template <typename T>
+inline T* NewArrayAligned(IAllocator* alloc, Alignment align, Flags flags, unsigned int count, Category category, const char* debug_str, const char* file, unsigned int line)
+{
+    // Grab memory, and request room for the header
+    const Alignment elementAlign = align > alignof(T) ? align : alignof(T);
+    const unsigned int offset = GetArrayOffset(elementAlign);
+    const size_t blockSize = sizeof(T) * count + offset;
+    void* block = alloc->AllocAlign(blockSize, elementAlign, flags, category, debug_str, file, line);
+    return ConstructArray<T>(block, offset, count);
 }
 
 //----------------------------------------------------------------------------------------
@@ -108,9 +131,10 @@ inline void DeleteArray(IAllocator* alloc, T* arrayPtr)
     if (arrayPtr != nullptr)
     {
         // Grab block and count
-        // Count is at the front of the block
-        void* block = ((unsigned int*) arrayPtr) - 1;
-        unsigned int count = *((unsigned int*) block);
+        // The header is right before the array
+        const ArrayHeader* header = reinterpret_cast<const ArrayHeader*>(arrayPtr) - 1;
+        void* block = reinterpret_cast<char*>(arrayPtr) - header->mOffset;
+        unsigned int count = header->mCount;
 
         // Destruct from the end of the array to the beginning
         // Then release memory
@@ -0,0 +1,76 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                       Pegasus                                        */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file   AotGenerator.h
+//! \author agent
+//! \date   16th October 2026
+//! \brief  Translates the bytecode of compiled scripts into c++. Every instruction becomes the
+//!         statements its interpreter handler runs, with the operands written as literals. Calls to
+//!         c++ go through the same BlockLib callbacks, and the script keeps the BsVmState layout,
+//!         so ExecuteFunction, globals and pausing behave as in the interpreter.
+
+#ifndef PEGASUS_BLOCKSCRIPT_AOTGENERATOR_H
+#define PEGASUS_BLOCKSCRIPT_AOTGENERATOR_H
+
+#include "Pegasus/BlockScript/BsAot.h"
+#include "Pegasus/BlockScript/FunCallback.h"
+
+namespace Pegasus
+{
+namespace BlockScript
+{
+
+//! Writes a c++ file holding a table of translated scripts (see AotScript)
+class AotGenerator
+{
+public:
+    //! constructor
+    //! \param allocator allocator of the internal tables
+    //! \param str callback receiving the c++ text
+    AotGenerator(Alloc::IAllocator* allocator, PrintStringCallbackType str);
+
+    //! destructor
+    ~AotGenerator();
+
+    //! Writes the header of the file
+    void BeginFile();
+
+    //! Translates the bytecode of an assembly into a function
+    //! \param assembly the assembly compiled
+    //! \param title the title of the script. Pointer is cached until EndFile.
+    //! \return false if the assembly has no bytecode to translate
+    bool Translate(const Assembly& assembly, const char* title);
+
+    //! Writes the table of the scripts translated
+    //! \param tableName the name of the table. An int named tableName followed by Count holds its size.
+    void EndFile(const char* tableName);
+
+    //! \return the number of scripts translated
+    int GetScriptCount() const { return static_cast<int>(mScripts.GetSize()); }
+
+private:
+    struct ScriptEntry
+    {
+        Math::PUInt64 mKey;
+        int mCodeSize;
+        const char* mTitle;
+    };
+
+    //! writes text. Supports %d (int), %x (unsigned int, hexadecimal), %s (string), %q (string literal) and %a (address operand, const int*)
+    void Emit(const char* format, ...);
+
+    //! writes the statements of an instruction
+    void TranslateInstruction(const int* code, int ip);
+
+    PrintStringCallbackType mStr;
+    Alloc::IAllocator* mAllocator;
+    Utils::Vector<ScriptEntry> mScripts;
+};
+
+}
+}
+
+#endif
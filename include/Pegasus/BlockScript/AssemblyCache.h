@@ -0,0 +1,245 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                       Pegasus                                        */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file   AssemblyCache.h
+//! \author agent
+//! \date   16th October 2026
+//! \brief  On disk cache of compiled assemblies. The bytecode of a script is stored in a
+//!         position independent blob, so a later compilation of the same source can skip
+//!         the parser, the optimizer, the canonizer and the bytecode generator.
+
+#ifndef PEGASUS_BLOCKSCRIPT_ASSEMBLY_CACHE_H
+#define PEGASUS_BLOCKSCRIPT_ASSEMBLY_CACHE_H
+
+#include "Pegasus/BlockScript/Canonizer.h"
+#include "Pegasus/BlockScript/Container.h"
+#include "Pegasus/BlockScript/IFileIncluder.h"
+#include "Pegasus/BlockScript/Preprocessor.h"
+#include "Pegasus/Memory/BlockAllocator.h"
+#include "Pegasus/Core/Io.h"
+#include "Pegasus/Math/Types.h"
+#include "Pegasus/Utils/Vector.h"
+#include <mutex>
+
+namespace Pegasus
+{
+
+//fwd declarations
+namespace Alloc
+{
+    class IAllocator;
+}
+
+namespace BlockScript
+{
+
+class BlockLib;
+
+//! File includer that forwards to another includer, and records a hash of every file included.
+//! Used during compilation to know which headers a cached assembly depends on.
+class IncludeRecorder : public IFileIncluder
+{
+public:
+    //! Constructor
+    explicit IncludeRecorder(Alloc::IAllocator* allocator);
+
+    //! Destructor
+    virtual ~IncludeRecorder();
+
+    //! Clears the recorded files and starts forwarding to an includer
+    //! \param includer the includer that opens the files, can be null
+    void Begin(IFileIncluder* includer);
+
+    //! \return the includer files are forwarded to
+    IFileIncluder* GetIncluder() const { return mIncluder; }
+
+    //! IFileIncluder interface
+    virtual bool Open (const char* filePath, const char** outBuffer, int& outBufferSize);
+    virtual void Close(const char* buffer);
+
+    //! \return the number of files included
+    int GetCount() const { return mEntries.Size(); }
+
+    //! \return the path of an included file
+    const char* GetPath(int i) const { return mEntries[i].mPath; }
+
+    //! \return the content hash of an included file
+    Math::PUInt64 GetHash(int i) const { return mEntries[i].mHash; }
+
+    //! \return the hash of the contents of a file, as recorded when it is included
+    static Math::PUInt64 HashContents(const char* buffer, int bufferSize);
+
+private:
+    struct Entry
+    {
+        char mPath[Io::IOManager::MAX_FILEPATH_LENGTH];
+        Math::PUInt64 mHash;
+        Entry() : mHash(0) { mPath[0] = '\0'; }
+    };
+
+    IFileIncluder*   mIncluder;
+    Container<Entry> mEntries;
+};
+
+//! Assembly loaded from a cache blob. Owns the blob and the runtime descriptions
+//! (functions, frames and globals) rebuilt from it.
+class CachedAssembly
+{
+public:
+    //! Constructor
+    explicit CachedAssembly(Alloc::IAllocator* allocator);
+
+    //! Destructor
+    ~CachedAssembly();
+
+    //! Frees the blob and all the descriptions
+    void Reset();
+
+    //! \return true if an assembly has been loaded
+    bool IsLoaded() const { return mIsLoaded; }
+
+    //! \return the loaded assembly. Only contains bytecode, there is no canonical tree.
+    const Assembly& GetAsm() const { return mAsm; }
+
+private:
+    friend class AssemblyCache;
+
+    Alloc::IAllocator*        mAllocator;
+    Io::FileBuffer            mBlob;
+    Memory::BlockAllocator    mNodeAllocator;
+    Container<StackFrameInfo> mFrames;
+    Container<FunDesc>        mFunDescs;
+    Container<FunMapEntry>    mFunBlockMap;
+    Container<GlobalMapEntry> mGlobalsMap;
+    const void**              mConstants;
+    BytecodeAssembly          mBytecode;
+    Assembly                  mAsm;
+    bool                      mIsLoaded;
+};
+
+//! On disk cache of compiled assemblies. One blob is kept per script title. A blob is only used
+//! if its key matches: the key is a hash of the source, the definitions, the optimization level
+//! and the signature of every library registered (types and functions, in registration order).
+//! The headers included are stored with a hash of their contents, and revalidated on load.
+class AssemblyCache
+{
+public:
+    //! How the cache is used
+    enum Policy
+    {
+        POLICY_DISABLED,   //! the cache is never read nor written
+        POLICY_READ_ONLY,  //! valid blobs are loaded, nothing is written. For blobs produced offline
+        POLICY_READ_WRITE, //! valid blobs are loaded, a blob is written after every compilation that missed
+        POLICY_WRITE_ONLY  //! blobs are never loaded, always rewritten. Use to rebuild the cache
+    };
+
+    //! Constructor
+    //! \param allocator the allocator for the blobs written
+    //! \param directory the directory where the blobs live, with its trailing path separator. Must exist.
+    AssemblyCache(Alloc::IAllocator* allocator, const char* directory);
+
+    //! Destructor
+    ~AssemblyCache();
+
+    //! \param policy sets how the cache is used. Defaults to POLICY_READ_WRITE
+    void SetPolicy(Policy policy) { mPolicy = policy; }
+
+    //! \return how the cache is used
+    Policy GetPolicy() const { return mPolicy; }
+
+    //! \param validate if true (default), the headers a blob depends on are opened and hashed on load.
+    //!        Turn off only if the headers are known to be in sync with the blobs (shipping builds).
+    void SetValidateIncludes(bool validate) { mValidateIncludes = validate; }
+
+    //! \return true if included headers are revalidated on load
+    bool GetValidateIncludes() const { return mValidateIncludes; }
+
+    //! \return the directory of the cache
+    const char* GetDirectory() const { return mIoManager.GetRoot(); }
+
+    //! \return true if blobs can be loaded
+    bool CanRead() const { return mPolicy == POLICY_READ_ONLY || mPolicy == POLICY_READ_WRITE; }
+
+    //! \return true if blobs can be written
+    bool CanWrite() const { return mPolicy == POLICY_READ_WRITE || mPolicy == POLICY_WRITE_ONLY; }
+
+    //! \return the number of compilations skipped thanks to a valid blob
+    int GetHitCount() const { return mHitCount; }
+
+    //! \return the number of loads that did not find a valid blob
+    int GetMissCount() const { return mMissCount; }
+
+    //! \return the number of blobs written
+    int GetStoreCount() const { return mStoreCount; }
+
+    //! Computes the key of a compilation
+    //! \param source the script source
+    //! \param definitions the definitions registered to the compiler
+    //! \param optimizationLevel the optimization level
+    //! \param runtimeLib the runtime library
+    //! \param libs the libraries included, in registration order
+    //! \return the key
+    static Math::PUInt64 ComputeKey(
+        const Io::FileBuffer* source,
+        const Container<Preprocessor::Definition>& definitions,
+        int optimizationLevel,
+        BlockLib* runtimeLib,
+        const Utils::Vector<BlockLib*>& libs
+    );
+
+    //! Loads a blob
+    //! \param title the title of the script
+    //! \param key the key computed for this compilation
+    //! \param includer the includer used to revalidate headers
+    //! \param runtimeLib the runtime library
+    //! \param libs the libraries included, in registration order
+    //! \param output the assembly to fill. Reset if the load fails.
+    //! \return true if a valid blob was loaded
+    bool Load(
+        const char* title,
+        Math::PUInt64 key,
+        IFileIncluder* includer,
+        BlockLib* runtimeLib,
+        const Utils::Vector<BlockLib*>& libs,
+        CachedAssembly& output
+    );
+
+    //! Writes a blob. Assemblies that reference types or functions defined by the script
+    //! itself (structs, enums, arrays passed to the api) can't be stored and are skipped.
+    //! \param title the title of the script
+    //! \param key the key computed for this compilation
+    //! \param assembly the compiled assembly, must have bytecode
+    //! \param includes the files included during compilation
+    //! \param runtimeLib the runtime library
+    //! \param libs the libraries included, in registration order
+    //! \return true if the blob was written
+    bool Store(
+        const char* title,
+        Math::PUInt64 key,
+        const Assembly& assembly,
+        const IncludeRecorder& includes,
+        BlockLib* runtimeLib,
+        const Utils::Vector<BlockLib*>& libs
+    );
+
+private:
+    //! builds the file name of the blob of a title
+    void GetBlobName(const char* title, char* outName) const;
+
+    Alloc::IAllocator* mAllocator;
+    Io::IOManager      mIoManager;
+    Policy             mPolicy;
+    bool               mValidateIncludes;
+    int                mHitCount;
+    int                mMissCount;
+    int                mStoreCount;
+    std::mutex         mLock; //! serializes loads and stores, so scripts can be compiled concurrently
+};
+
+}
+}
+
+#endif
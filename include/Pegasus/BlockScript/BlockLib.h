@@ -35,7 +35,8 @@ public:
     //! Constructor in case you did not notice
     //! \param allocator
     //! \param library name, pointer is cached. Make sure is a string imm value
-    BlockLib(Alloc::IAllocator* allocator, const char* libraryName);
+    //! \param strPool the identifier pool, shared with the scripts and libraries this library is used with
+    BlockLib(Alloc::IAllocator* allocator, const char* libraryName, IddStrPool* strPool);
 
     //!  Destructor
     virtual ~BlockLib();
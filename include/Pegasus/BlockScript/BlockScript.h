@@ -13,7 +13,11 @@
 #define PEGASUS_BLOCKSCRIPT_BS_H
 
 #include "Pegasus/BlockScript/BlockScriptCompiler.h"
+#include "Pegasus/BlockScript/AssemblyCache.h"
+#include "Pegasus/BlockScript/BsAot.h"
+#include "Pegasus/BlockScript/BsJit.h"
 #include "Pegasus/BlockScript/BsVm.h"
+#include "Pegasus/BlockScript/ScriptSignature.h"
 #include "Pegasus/Utils/Vector.h"
 
 namespace Pegasus
@@ -32,7 +36,8 @@ public:
     //! BlockScript constructor
     //! \param allocator the master allocator
     //! \param core runtime library containing core definitions for types
-    BlockScript(Alloc::IAllocator* allocator, BlockLib* runtimeLibrary);
+    //! \param strPool the identifier pool, shared with the libraries
+    BlockScript(Alloc::IAllocator* allocator, BlockLib* runtimeLibrary, IddStrPool* strPool);
 
     //! Destructor
     virtual ~BlockScript();
@@ -41,14 +46,78 @@ public:
     //! \param library - the actual library
     void IncludeLib(BlockLib* library);
 
-    //! Runs the block script
-    void Run(BsVmState* vmState); 
+    //! \return the libraries included, the runtime library aside
+    const Utils::Vector<BlockLib*>& GetLibs() const { return mLibs; }
 
-    //! Compiles a file string buffer into block script
+    //! Runs the block script
+    //! \param vmState the state to run on
+    //! \param budget number of jumps / calls allowed before the run is suspended, -1 for no limit.
+    //!        Scripts running a yield statement get suspended too. Check BsVmState::IsSuspended and call Resume to go on.
+    void Run(BsVmState* vmState, int budget = -1); 
+
+    //! Continues the run or the function call suspended on a state
+    //! \param vmState the state, suspended
+    //! \param budget number of jumps / calls allowed before the execution is suspended again, -1 for no limit
+    //! \param outputBuffer where the result of a function call is written once it returns. Unused when resuming a run
+    //! \param outputBufferSize the size of the output buffer, the one passed to ExecuteFunction
+    //! \return false if the state is not suspended, or the output buffer size does not match the suspended call
+    bool Resume(BsVmState* vmState, int budget = -1, void* outputBuffer = nullptr, int outputBufferSize = 0);
+
+    //! Drops the execution suspended on a state. A suspended function call is unwound and the state keeps its globals.
+    //! A suspended run leaves the global scope half initialized, the state is reset.
+    //! \param vmState the state, suspended
+    void Cancel(BsVmState* vmState);
+
+    //! Selects how this script gets executed. The bytecode backend is the default. Select the aot backend where a table
+    //! of translated scripts is registered. The canonical tree backend is kept around for comparison and debugging.
+    //! \param backend the backend of the virtual machine
+    void SetVmBackend(BsVm::Backend backend) { mVm.SetBackend(backend); }
+
+    //! \return the backend used to execute this script
+    BsVm::Backend GetVmBackend() const { return mVm.GetBackend(); }
+
+    //! Compiles a file string buffer into block script. If an assembly cache is set, a valid blob
+    //! of this script skips the compilation, and a successful compilation writes a new blob.
     //! \param fb the file buffer containing the script
     //! \return true if successful, false otherwise
     virtual bool Compile(const Io::FileBuffer* fb);
 
+    //! Resets all memory, including an assembly loaded from the cache. Call this if Compile is going to be called again
+    virtual void Reset();
+
+    //! Sets the assembly cache used by Compile. The title of the script names its blob in the cache.
+    //! \param cache the cache, null to disable caching. Must outlive this script.
+    void SetAssemblyCache(AssemblyCache* cache) { mAssemblyCache = cache; }
+
+    //! \return the assembly cache used by Compile, null if none
+    AssemblyCache* GetAssemblyCache() const { return mAssemblyCache; }
+
+    //! \return true if the last call to Compile loaded the assembly from the cache
+    bool IsAsmFromCache() const { return mCachedAssembly.IsLoaded(); }
+
+    //! Sets the translated scripts searched by Compile. A translation matching the bytecode compiled
+    //! replaces the bytecode interpreter (see BsVm::BACKEND_AOT).
+    //! \param registry the registry, null to always interpret. Must outlive this script.
+    void SetAotRegistry(const AotRegistry* registry) { mAotRegistry = registry; }
+
+    //! Sets the number of calls after which a function is compiled by the jit (see BsVm::BACKEND_JIT)
+    //! \param calls the threshold, 1 compiles a function on its first call
+    void SetJitCallThreshold(int calls) { mJit.SetCallThreshold(calls); }
+
+    //! \return the jit of this script, to query what it compiled
+    const BsJit& GetJit() const { return mJit; }
+
+    //! \return the signature of the last compilation. Invalid if the assembly was loaded from the cache.
+    const ScriptSignature& GetSignature() const { return mSignature; }
+
+    //! Lets a state set up by another compilation of this script run on this one. Only valid if
+    //! the signatures of both compilations share the same layout (see ScriptSignature::CountChangedFunctions).
+    //! The heap elements pointing to memory of the previous compilation (string immediates) are copied to this one.
+    //! \param state the state, whose globals were initialized by the previous compilation
+    //! \param previous the previous compilation, still alive
+    //! \return the number of heap elements moved
+    int RebindState(BsVmState& state, const BlockScript& previous);
+
     //! Executes a function from a specific bind point.
     //! vmState - the state of the VM to run
     //! bindPoint - the function bind point. If an invalid bind point is passed, we return false.
@@ -57,13 +126,16 @@ public:
     //! inputBufferSize - the size of the input argument buffer. If this size does not match the input buffer size of the function then this function returns false.
     //! outputBuffer - the output buffer to be used. 
     //! outputBufferSize - the size of the return buffer. If this size does not match the return value size, then this function returns false.
+    //! budget - number of jumps / calls allowed before the call is suspended, -1 for no limit. A suspended call writes
+    //!          the output buffer passed to the Resume call it returns on.
     bool ExecuteFunction(
         BsVmState*   vmState,
         FunBindPoint functionBindPoint,
         const void* inputBuffer,
         int   inputBufferSize,
         void* outputBuffer,
-        int   outputBufferSize
+        int   outputBufferSize,
+        int   budget = -1
     );
 
     //! Read the global value stored in a handle.
@@ -96,10 +168,19 @@ public:
 
 
 private:
+    //! compiles the script, or loads it from the assembly cache
+    bool CompileAsm(const Io::FileBuffer* fb);
+
     // Virtual machine (state of this vm is pushed by the user through BsVmState class)
     BsVm      mVm;
     BlockLib* mRuntimeLib;
     Utils::Vector<BlockLib*> mLibs;
+    AssemblyCache*  mAssemblyCache;
+    const AotRegistry* mAotRegistry;
+    BsJit           mJit;
+    CachedAssembly  mCachedAssembly;
+    IncludeRecorder mIncludeRecorder;
+    ScriptSignature mSignature;
 };
 
 } //namespace BlockScript
@@ -192,6 +192,8 @@ public:
     virtual ~Unop() {}
 
     Exp* GetExp() const { return mExp; } 
+
+    void SetExp(Exp* exp) { mExp = exp; }
    
     int GetOp() const { return mOp; }
 
@@ -238,7 +240,7 @@ public:
     static const int sType;
 
     Binop(Exp * lhs, int op, Exp * rhs)
-    : mLhs(lhs), mOp(op), mRhs(rhs)
+    : mLhs(lhs), mOp(op), mRhs(rhs), mIsIndexInRange(false)
     {
     }
 
@@ -248,8 +250,17 @@ public:
 
     Exp * GetRhs() const { return mRhs; }
 
+    void SetLhs(Exp* lhs) { mLhs = lhs; }
+
+    void SetRhs(Exp* rhs) { mRhs = rhs; }
+
     int   GetOp()  const { return mOp; }
 
+    //! array accesses only, true if the index is proven in range (see RangeAnalysis). Safe mode does not check it.
+    bool IsIndexInRange() const { return mIsIndexInRange; }
+
+    void SetIndexInRange(bool inRange) { mIsIndexInRange = inRange; }
+
     VISITOR_ACCESS
 
     EXP_RTTI_DECL
@@ -259,6 +270,7 @@ private:
     Exp * mLhs;
     Exp * mRhs;
     int mOp;
+    bool mIsIndexInRange;
 
 };
 
@@ -350,13 +362,19 @@ class Stmt : public Node
 {
 public:
 
-    Stmt(){}
+    Stmt() : mLine(-1) {}
 
     virtual ~Stmt(){}
 
+    //! \return the source line this statement starts at (0 based), -1 if unknown
+    int GetLine() const { return mLine; }
+
+    void SetLine(int line) { mLine = line; }
+
     VISITOR_ACCESS
 
 private:
+    int mLine;
 };
 
 class StmtEnumTypeDef : public Stmt
@@ -430,6 +448,8 @@ public:
 
     Exp * GetExp() const { return mExp; }
 
+    void SetExp(Exp* exp) { mExp = exp; }
+
     VISITOR_ACCESS
 
 private:
@@ -448,6 +468,8 @@ public:
 
     Exp * GetExp() const { return mExp; }
 
+    void SetExp(Exp* exp) { mExp = exp; }
+
     VISITOR_ACCESS
 
 private:
@@ -537,8 +559,12 @@ public:
 
     Exp* GetExp() const { return mExp; }
 
+    void SetExp(Exp* exp) { mExp = exp; }
+
     StmtList* GetStmtList() const { return mStmtList; }
 
+    void SetStmtList(StmtList* stmtList) { mStmtList = stmtList; }
+
     StackFrameInfo* GetFrame() const { return mFrame; }
 
     void SetFrame(StackFrameInfo* frame) { mFrame = frame; }
@@ -569,12 +595,20 @@ public:
 
     Exp* GetUpdate() const { return mUpdate; }
 
+    void SetInit(Exp* init) { mInit = init; }
+
+    void SetCond(Exp* cond) { mCond = cond; }
+
+    void SetUpdate(Exp* update) { mUpdate = update; }
+
     StackFrameInfo* GetFrame() const { return mFrame; }
 
     void SetFrame(StackFrameInfo* frame) { mFrame = frame; }
 
     StmtList* GetStmtList() const { return mStmtList; }
 
+    void SetStmtList(StmtList* stmtList) { mStmtList = stmtList; }
+
     VISITOR_ACCESS
 
 private:
@@ -606,8 +640,13 @@ public:
 
     Exp * GetExp() const { return mExp; }
 
+    //! a null expression marks the trailing else block
+    void SetExp(Exp* exp) { mExp = exp; }
+
     StmtList * GetStmtList() const { return mIf; }
 
+    void SetStmtList(StmtList* stmtList) { mIf = stmtList; }
+
     StmtIfElse* GetTail() const { return mTail; }
 
     void        SetTail(StmtIfElse* tail) { mTail = tail; }
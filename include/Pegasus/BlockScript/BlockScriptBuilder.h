@@ -19,6 +19,9 @@
 #include "Pegasus/BlockScript/StackFrameInfo.h"
 #include "Pegasus/BlockScript/Container.h"
 #include "Pegasus/BlockScript/Canonizer.h"
+#include "Pegasus/BlockScript/Optimizer.h"
+#include "Pegasus/BlockScript/RangeAnalysis.h"
+#include "Pegasus/BlockScript/BytecodeGenerator.h"
 #include "Pegasus/BlockScript/IddStrPool.h"
 #include "Pegasus/BlockScript/BlockScriptCanon.h"
 #include "Pegasus/Memory/BlockAllocator.h"
@@ -61,8 +64,10 @@ class BlockScriptBuilder
 {
 public:
     explicit BlockScriptBuilder() 
-        : mCurrentFrame(nullptr)
+        : mStrPool(nullptr)
+        , mCurrentFrame(nullptr)
         , mErrorCount(0)
+        , mOptimizationLevel(Optimizer::LEVEL_FULL)
         , mInFunBody(false)
         , mReturnTypeContext(nullptr)
         , mCurrAnnotations(nullptr)
@@ -74,7 +79,9 @@ public:
         Assembly         mAsm;
     };
 
-    void Initialize(Pegasus::Alloc::IAllocator* allocator);
+    //! \param allocator the allocator for the compilation
+    //! \param strPool the pool interning the identifiers. Shared with the libraries, it is not cleared on Reset
+    void Initialize(Pegasus::Alloc::IAllocator* allocator, IddStrPool* strPool);
     ~BlockScriptBuilder(){}
 
     //! Begins construction of abstract syntax tree
@@ -83,6 +90,10 @@ public:
     //! Ends construction of abstract syntax tree
     void EndBuild  (CompilationResult& r);
 
+    //! Notifies the listeners of a successful compilation that did not run the front end,
+    //! such as an assembly loaded from the cache
+    void NotifyPrebuiltCompilation();
+
     //! destroys memory of compilation results
     void Reset ();
 
@@ -110,6 +121,7 @@ public:
     Ast::StmtExp* BuildExternVariable(Ast::Exp* lhs, Ast::Exp* rhs);
     Ast::StmtExp* BuildDeclarationWithAnnotation(Ast::Annotations* ann, Ast::Exp* exp);
     Ast::StmtReturn* BuildStmtReturn(Ast::Exp* exp);
+    Ast::StmtExp*    BuildStmtYield();
     Ast::StmtWhile*  BuildStmtWhile(Ast::Exp* exp, Ast::StmtList* stmtList);
     Ast::StmtFor*    BuildStmtFor(Ast::Exp* init, Ast::Exp* cond, Ast::Exp* update, Ast::StmtList* stmtList);
     Ast::StmtFunDec* BuildStmtFunDec(Ast::ArgList* argList, const TypeDesc* returnType, const char * nameIdd);
@@ -133,12 +145,20 @@ public:
 
     void BindIntrinsic(Ast::StmtFunDec* funDec, FunCallback callback);
 
-    IddStrPool& GetStringPool() { return mStrPool; }
+    IddStrPool& GetStringPool() { return *mStrPool; }
 
     char* AllocateBigString(int size);
 
     int GetCurrentLine() const;
 
+    //! Called by the lexer on the keywords opening a frame (if, elif, while, for), so the frame
+    //! gets the line of its keyword instead of the line its parser rule reduces at
+    void MarkKeywordLine();
+
+    //! \param frame a frame built by this builder
+    //! \return the line where the frame was opened
+    int GetFrameLine(const StackFrameInfo* frame) const;
+
     const char* GetCurrentCompilationUnitTitle() const;
 
     void PushFile(const char* newFileTitle);
@@ -169,6 +189,9 @@ public:
 
     const char* AllocStrImm(const char* strToCpy);    
 
+    //! \return true if ptr points to memory of the current compilation (string immediates and tree nodes)
+    bool OwnsMemory(const void* ptr) const { return mAllocator.Owns(ptr); }
+
     void RegisterExternGlobal(Ast::Idd* var, Ast::Imm* defaultVal);
 
     //! creates an intrinsic function that can be called from blockscript
@@ -179,6 +202,7 @@ public:
     //! \param callback the actual c++ callback
     //! \param isMethod - if true, it means that the function definition is a method (first artType must be an object).
     //!                   this means that the -> notation will be used                        
+    //! \param pureIntrinsic - if not PURE_NONE, calls can be inlined as vm instructions
     //! \note  function asserts if it fails
     void CreateIntrinsicFunction(
         const char* funName, 
@@ -187,19 +211,26 @@ public:
         int argCount, 
         const char* returnType, 
         FunCallback callback,
-        bool isMethod = false
+        bool isMethod = false,
+        PureIntrinsic pureIntrinsic = PURE_NONE
     );
 
-    //! copies a foreign string into the blockscripts script pool (memory allocation)
+    //! interns a foreign string into the blockscripts identifier pool
     //! \param the source string
-    //! \return the return parameter
-    char* CopyString(const char* source);
+    //! \return the handle of the string, comparable by pointer with any other identifier
+    const char* CopyString(const char* source);
 
     void  SetScanner(void* scanner) { mScanner = scanner; }
     void* GetScanner() { return mScanner; }
 
     Pegasus::Alloc::IAllocator* GetAllocator() const { return mGeneralAllocator; }
 
+    //! Sets the optimization level applied to the AST before canonization. Persists through Reset.
+    void SetOptimizationLevel(Optimizer::Level level) { mOptimizationLevel = level; }
+
+    //! \return the optimization level applied to the AST before canonization
+    Optimizer::Level GetOptimizationLevel() const { return mOptimizationLevel; }
+
 private:
 
     // registers a member into the stack. Returns the offset of the current stack frame.
@@ -227,7 +258,7 @@ private:
     Memory::BlockAllocator      mAllocator;
     FunTable           mFunTable;
 	CompilationResult  mActiveResult;
-    IddStrPool         mStrPool;
+    IddStrPool*        mStrPool;
     SymbolTable        mSymbolTable;
     const TypeDesc*    mReturnTypeContext;
 
@@ -235,7 +266,11 @@ private:
     StackFrameInfo*    mCurrentFrame;
     int                mErrorCount;
 
+    Optimizer mOptimizer;
+    Optimizer::Level mOptimizationLevel;
+    RangeAnalysis mRangeAnalysis;
     Canonizer mCanonizer;
+    BytecodeGenerator mBytecodeGenerator;
 
     Container<IBlockScriptCompilerListener*> mEventListeners;
     Container<GlobalMapEntry> mGlobalsMap;
@@ -258,6 +293,15 @@ private:
 
     Utils::Vector<FileState> mFileStates;
 
+    //! line where each frame started, so compound statements (loops, ifs) get the line of their keyword
+    struct FrameLine
+    {
+        const StackFrameInfo* mFrame;
+        int mLine;
+    };
+    Utils::Vector<FrameLine> mFrameLines;
+    int mKeywordLine;
+
 
 
 };
@@ -0,0 +1,154 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                       Pegasus                                        */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file   BlockScriptBytecode.h
+//! \author agent
+//! \date   16th October 2026
+//! \brief  Flat bytecode representation of a canonical tree. Every canonical node is lowered
+//!         into a linear stream of integer words (opcode followed by its operands). Memory
+//!         operands are resolved to (frame, offset) pairs and expressions are evaluated
+//!         on a small file of scratch registers, so the interpreter never touches the AST.
+
+#ifndef PEGASUS_BLOCKSCRIPT_BYTECODE_H
+#define PEGASUS_BLOCKSCRIPT_BYTECODE_H
+
+//! number of scratch registers available to the bytecode interpreter
+#define BYTECODE_SCRATCH_REGISTER_COUNT 16
+
+//! size in ints of a scratch register. Big enough to hold a float4x4.
+//! Registers are 16 byte aligned, vector and matrix values are processed by the sse kernels of BsSimd.h
+#define BYTECODE_SCRATCH_REGISTER_INTS 16
+
+//! frame value of an address operand which points to the global frame
+#define BYTECODE_GLOBAL_FRAME -1
+
+namespace Pegasus
+{
+namespace BlockScript
+{
+namespace Bytecode
+{
+
+// Operand legend:
+//   addr  - two words, (frame, offset). frame is the number of frames to walk up from the current
+//           stack base, or BYTECODE_GLOBAL_FRAME for globals
+//   s     - scratch register index
+//   r     - canonical register (Canon::Register)
+//   k     - index into the constant table
+//   pc    - absolute word offset in the code stream
+//   n     - immediate integer
+enum OpCode
+{
+    //control flow
+    OP_EXIT,          //
+    OP_JMP,           // pc
+    OP_JMPCOND_I,     // s, n, pc : jumps if the int in s equals n
+    OP_JMPCOND_F,     // s, n, pc : jumps if (float in s != 0) equals n
+    OP_PUSHFRAME,     // k(StackFrameInfo)
+    OP_POPFRAME,      //
+    OP_CALL,          // pc : frame has been pushed, stores the return address and jumps
+    OP_CALLBACK,      // k(FunCall), n(argument bytes) : calls a c++ function and pops its frame
+    OP_NATIVE,        // k(FunCall), n(argument bytes) : calls a c++ function, arguments are in the native argument buffer
+    OP_RET,           //
+
+    //canonical register commands
+    OP_SAVE,          // addr, r : writes register into memory
+    OP_GETR,          // s, r
+    OP_SETR,          // r, s
+    OP_SAVE_TO_ADDR,  // r, r : writes second register into address stored in first register
+    OP_CAST_ITOF,     // r
+    OP_CAST_FTOI,     // r
+
+    //memory commands
+    OP_LEA,           // s, addr : address of addr into s
+    OP_LEAX,          // s, addr, n(array byte size) : address of addr + int in s into s
+    OP_LEAXU,         // s, addr : OP_LEAX on an index proven in range, never checked
+    OP_LD4,           // s, addr
+    OP_LD,            // s, addr, n(bytes)
+    OP_LDX,           // s, addr, n(bytes) : reads addr + int in s into s
+    OP_ST4,           // addr, s
+    OP_ST,            // addr, s, n(bytes)
+    OP_STI,           // s(address), s, n(bytes)
+    OP_IMM,           // s, n(word count), words...
+    OP_COPY,          // addr, addr, n(bytes) : copies second address into first
+    OP_COPY_I,        // addr, s(address), n(bytes)
+    OP_COPY_II,       // s(address), s(address), n(bytes)
+    OP_ISDH,          // addr, k(pointer), k(TypeDesc) : inserts data to the heap
+    OP_READ_PROP,     // s(location address), s(object address), k(PropertyNode), k(TypeDesc)
+    OP_WRITE_PROP,    // s(location address), s(object address), k(PropertyNode), k(TypeDesc)
+    OP_NST,           // n(offset), s, n(bytes) : writes s into the native argument buffer
+    OP_NCOPY,         // n(offset), s(address), n(bytes) : copies memory into the native argument buffer
+
+    //alu commands. All operate on scratch registers: s(dest), s(lhs), s(rhs)
+    OP_ADD_I, OP_SUB_I, OP_MUL_I, OP_DIV_I, OP_MOD_I,
+    OP_EQ_I, OP_NEQ_I, OP_GT_I, OP_LT_I, OP_GTE_I, OP_LTE_I, OP_LAND_I, OP_LOR_I,
+    OP_ADD_F, OP_SUB_F, OP_MUL_F, OP_DIV_F,
+    OP_EQ_F, OP_NEQ_F, OP_GT_F, OP_LT_F, OP_GTE_F, OP_LTE_F, OP_LAND_F, OP_LOR_F,
+    OP_ADD_F2, OP_SUB_F2, OP_MUL_F2, OP_DIV_F2,
+    OP_ADD_F3, OP_SUB_F3, OP_MUL_F3, OP_DIV_F3,
+    OP_ADD_F4, OP_SUB_F4, OP_MUL_F4, OP_DIV_F4,
+    OP_ADD_M22, OP_SUB_M22, OP_MUL_M22, OP_DIV_M22,
+    OP_ADD_M33, OP_SUB_M33, OP_MUL_M33, OP_DIV_M33,
+    OP_ADD_M44, OP_SUB_M44, OP_MUL_M44, OP_DIV_M44,
+
+    //unary alu commands: s(dest), s(src)
+    OP_NEG_I, OP_NEG_F, OP_NEG_F2, OP_NEG_F3, OP_NEG_F4, OP_NEG_M22, OP_NEG_M33, OP_NEG_M44,
+
+    //fused multiply-add, a * b + c: s(dest), s(a), s(b), s(c)
+    OP_FMA_F, OP_FMA_F2, OP_FMA_F3, OP_FMA_F4, OP_FMA_M22, OP_FMA_M33, OP_FMA_M44,
+
+    //pure intrinsics, inlined calls to c++ functions. The result is written to s(dest)
+    OP_ITOF,          // s : converts the int in s to a float
+    OP_PACK,          // s(dest), s(first), n(count), n(words)... : concatenates the first words of count consecutive registers
+    OP_SPLAT,         // s(dest), s(src), n(words) : replicates the first word of src
+    OP_DOT_F2, OP_DOT_F3, OP_DOT_F4,         // s(dest), s(lhs), s(rhs)
+    OP_CROSS_F3,                             // s(dest), s(lhs), s(rhs)
+    OP_LERP_F, OP_LERP_F2, OP_LERP_F3, OP_LERP_F4, // s(dest), s(a), s(b), s(t)
+    OP_MUL_M22_F2, OP_MUL_M33_F3, OP_MUL_M44_F4, OP_MUL_M44_M44, // s(dest), s(matrix), s(rhs)
+    OP_SIN, OP_COS,                          // s(dest), s(src)
+
+    OP_COUNT
+};
+
+// What a constant table entry points to. Lets tools walk the constants without decoding the code stream.
+enum ConstantKind
+{
+    K_FRAME,     //! const StackFrameInfo*
+    K_FUNCALL,   //! const Ast::FunCall*, the function description is a c++ callback
+    K_HEAP_DATA, //! null terminated string inserted to the heap
+    K_PROPERTY,  //! const PropertyNode*
+    K_TYPE       //! const TypeDesc*
+};
+
+//! Source location of a run of instructions. An entry covers the instructions from its offset up to the offset of the next entry.
+struct LineEntry
+{
+    int mOffset;   //! first instruction of the run
+    int mLine;     //! source line (0 based), -1 if unknown
+    int mFunction; //! index in the function block map of the owning function, -1 for global code
+};
+
+} //namespace Bytecode
+
+// structure holding the bytecode generated from an assembly
+struct BytecodeAssembly
+{
+    const int*          mCode;          //! flat instruction stream
+    int                 mCodeSize;      //! number of words in the instruction stream
+    const void* const*  mConstants;     //! pointer table referenced by instructions
+    const int*          mConstantKinds; //! Bytecode::ConstantKind of each entry of mConstants
+    int                 mConstantCount; //! number of entries in mConstants
+    const int*          mBlockOffsets;  //! canonical block label to instruction offset
+    int                 mBlockCount;    //! number of canonical blocks
+    const Bytecode::LineEntry* mLines;  //! source locations, sorted by instruction offset
+    int                 mLineCount;     //! number of entries in mLines
+    BytecodeAssembly() : mCode(nullptr), mCodeSize(0), mConstants(nullptr), mConstantKinds(nullptr), mConstantCount(0), mBlockOffsets(nullptr), mBlockCount(0), mLines(nullptr), mLineCount(0) {}
+};
+
+} //namespace BlockScript
+} //namespace Pegasus
+
+#endif
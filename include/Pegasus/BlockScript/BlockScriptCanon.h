@@ -79,13 +79,22 @@ class CanonNode
 {
 public:
     //! constructor
-    CanonNode() {}
+    CanonNode() : mLine(-1) {}
     
     //! destructor
     virtual ~CanonNode()  {}
 
     //! \return the type enumeration
     virtual CanonTypes GetType() const = 0;
+
+    //! \return the source line of the statement that produced this node, -1 if unknown
+    int GetLine() const { return mLine; }
+
+    //! sets the source line of this node
+    void SetLine(int line) { mLine = line; }
+
+private:
+    int mLine;
 };
 
 
@@ -418,7 +427,7 @@ public:
     //! constructor
     //! \param alloc the allocator
     //! \param label the label of this block
-    Block() : mLabel(-1), mNextBlock(-1) { }
+    Block() : mLabel(-1), mNextBlock(-1), mFunction(-1) { }
 
     //! destructor
     ~Block() {}
@@ -442,10 +451,17 @@ public:
     //! sets the index of the next block
     void SetNextBlock(int b) { mNextBlock = b; }
 
+    //! \return the index in the function block map of the function owning this block, -1 for global code
+    int GetFunction() const { return mFunction; }
+
+    //! sets the function owning this block
+    void SetFunction(int f) { mFunction = f; }
+
 private:
     Container<CanonNode*> mStmts;
     int mLabel;
     int mNextBlock;
+    int mFunction;
 };
 
 }
@@ -40,6 +40,7 @@ namespace Pegasus {
 		class IddStrPool;
         class IBlockScriptCompilerListener;
         class IFileIncluder;
+        class PrecompiledHeaderCache;
     
         namespace Ast
         {
@@ -62,7 +63,8 @@ class BlockScriptCompiler
 public:
     //! BlockScriptCompiler constructor
     //! \param allocator the master allocator
-    BlockScriptCompiler(Alloc::IAllocator* allocator);
+    //! \param strPool the identifier pool, shared with the libraries
+    BlockScriptCompiler(Alloc::IAllocator* allocator, IddStrPool* strPool);
 
     //! Destructor
     virtual ~BlockScriptCompiler();
@@ -73,7 +75,7 @@ public:
     virtual bool Compile(const Io::FileBuffer* fb);
 
     //! Resets all memory. Call this if Compile is going to be called again
-    void Reset();
+    virtual void Reset();
 
     //! Adds a set of definitions to keep around. These defs act as #defines within blockscript.
     //! The strings in question will get copied.
@@ -126,7 +128,39 @@ public:
     //! \return the includer to get.
     IFileIncluder* GetFileIncluder() const { return mFileIncluder; }
 
+    //! Sets the cache of precompiled headers. Headers only declaring types are compiled once in the cache,
+    //! and attached to the symbol table of every script including them.
+    //! \param headerCache the cache, null to parse every header included. Must outlive the compiled script.
+    void SetHeaderCache(PrecompiledHeaderCache* headerCache) { mHeaderCache = headerCache; }
+
+    //! \return the cache of precompiled headers, null if headers are parsed on every include
+    PrecompiledHeaderCache* GetHeaderCache() const { return mHeaderCache; }
+
+    //! Sets the optimization level used on the next call to Compile. Defaults to Optimizer::LEVEL_FULL.
+    //! \param level the optimization level
+    void SetOptimizationLevel(Optimizer::Level level) { mBuilder.SetOptimizationLevel(level); }
+
+    //! Gets the optimization level used by Compile.
+    //! \return the optimization level
+    Optimizer::Level GetOptimizationLevel() const { return mBuilder.GetOptimizationLevel(); }
+
 protected:
+    //! \return the definitions registered with RegisterDefinitions
+    const Container<Preprocessor::Definition>& GetDefinitions() const { return mDefinitionList; }
+
+    //! Sets an assembly that was not built from an AST (e.g. loaded from the assembly cache).
+    //! GetAst returns null afterwards.
+    //! \param assembly the assembly to use
+    void SetPrebuiltAsm(const Assembly& assembly) { mAst = nullptr; mAsm = assembly; }
+
+    //! Sets the ahead of time translation run instead of the bytecode of the assembly
+    //! \param aot the translated script, null to run the bytecode
+    void SetAotFunction(AotRunFunction aot) { mAsm.mAot = aot; }
+
+    //! Sets the jit of the functions of the assembly
+    //! \param jit the jit, initialized with the assembly. Null to always interpret.
+    void SetJit(BsJit* jit) { mAsm.mJit = jit; }
+
     BlockScriptBuilder       mBuilder;
 
 private:
@@ -135,6 +169,7 @@ private:
     Ast::Program*            mAst;
     Assembly                 mAsm;
     IFileIncluder*           mFileIncluder;
+    PrecompiledHeaderCache*  mHeaderCache;
     Container<Preprocessor::Definition>   mDefinitionList;
     const char* mTitle;
 };
@@ -12,6 +12,9 @@
 #ifndef BLOCKSCRIPT_MANAGER_H
 #define BLOCKSCRIPT_MANAGER_H
 
+#include "Pegasus/BlockScript/IddStrPool.h"
+#include "Pegasus/BlockScript/BsAot.h"
+#include "Pegasus/BlockScript/PrecompiledHeader.h"
 
 // forward declarations
 namespace Pegasus
@@ -25,6 +28,7 @@ namespace Pegasus
     {
         class BlockScript;
         class BlockLib;
+        class AssemblyCache;
     }
 }
 
@@ -59,6 +63,37 @@ public:
     //! gets internal runtime library if we desire to add / modify / remove intrinsic functions
     BlockLib*    GetRuntimeLib();
 
+    //! Sets the assembly cache given to every block script created afterwards
+    //! \param cache the cache, null to disable caching. Must outlive the scripts created.
+    void SetAssemblyCache(AssemblyCache* cache) { mAssemblyCache = cache; }
+
+    //! \return the assembly cache given to the block scripts created
+    AssemblyCache* GetAssemblyCache() const { return mAssemblyCache; }
+
+    //! Registers a table of ahead of time translated scripts, written by BlockScriptCLI -x. Block scripts
+    //! created afterwards and set to BsVm::BACKEND_AOT run the translation matching their bytecode instead of interpreting it.
+    //! \param scripts the table. Pointer is cached, so a static table is expected.
+    //! \param count the number of entries of the table
+    void RegisterAotScripts(const AotScript* scripts, int count) { mAotRegistry.Register(scripts, count); }
+
+    //! \return the translated scripts registered
+    const AotRegistry* GetAotRegistry() const { return &mAotRegistry; }
+
+    //! Enables precompiled headers on every block script created afterwards. Headers that only declare
+    //! types are compiled once, and shared by the scripts including them. Headers declaring functions
+    //! or globals are parsed on every include (see PrecompiledHeader). Disabled by default.
+    //! \param enabled true to precompile headers, false to parse every header included
+    void SetPrecompiledHeadersEnabled(bool enabled) { mPrecompiledHeadersEnabled = enabled; }
+
+    //! \return true if the block scripts created use precompiled headers
+    bool GetPrecompiledHeadersEnabled() const { return mPrecompiledHeadersEnabled; }
+
+    //! \return the precompiled headers shared by the scripts created
+    PrecompiledHeaderCache* GetHeaderCache() { return &mHeaderCache; }
+
+    //! \return the identifier pool shared by the libraries and the scripts created
+    IddStrPool* GetStringPool() { return &mStrPool; }
+
     //! destroys a block script
     //! \param script - the actual script
     void DestroyBlockScript(BlockScript* script);
@@ -73,6 +108,11 @@ private:
 
     BlockLib* mInternalRuntimeLib;
     Alloc::IAllocator*     mAllocator;
+    AssemblyCache*         mAssemblyCache;
+    IddStrPool             mStrPool;
+    AotRegistry            mAotRegistry;
+    PrecompiledHeaderCache mHeaderCache;
+    bool                   mPrecompiledHeadersEnabled;
 
 };
 
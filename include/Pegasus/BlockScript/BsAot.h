@@ -0,0 +1,179 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                       Pegasus                                        */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file   BsAot.h
+//! \author agent
+//! \date   16th October 2026
+//! \brief  Ahead of time compiled scripts. The bytecode of a script can be translated into c++
+//!         (see AotGenerator.h) and linked into a shipping build. The translated functions are
+//!         registered on the BlockScriptManager, and replace the bytecode interpreter on scripts
+//!         whose bytecode matches. Also holds the runtime shared by the interpreter and the translated code.
+
+#ifndef PEGASUS_BLOCKSCRIPT_BSAOT_H
+#define PEGASUS_BLOCKSCRIPT_BSAOT_H
+
+#include "Pegasus/BlockScript/Canonizer.h"
+#include "Pegasus/BlockScript/BsVm.h"
+#include "Pegasus/Utils/Vector.h"
+#include "Pegasus/Math/Types.h"
+
+#ifndef BLOCKSCRIPT_SAFEMODE
+#define BLOCKSCRIPT_SAFEMODE 0
+#endif
+
+namespace Pegasus
+{
+namespace BlockScript
+{
+
+//fwd declarations
+struct PropertyNode;
+class TypeDesc;
+class StackFrameInfo;
+
+namespace Ast
+{
+    class FunCall;
+}
+
+//! Entry of a table of translated scripts, as written by AotGenerator
+struct AotScript
+{
+    unsigned int   mKeyLow;   //! low bits of the bytecode key (see AotRegistry::ComputeKey)
+    unsigned int   mKeyHigh;  //! high bits of the bytecode key
+    int            mCodeSize; //! number of words of the bytecode translated
+    const char*    mTitle;    //! title of the script translated, informative only
+    AotRunFunction mRun;      //! the translated script
+};
+
+//! Set of translated scripts a compiled script is matched against
+class AotRegistry
+{
+public:
+    //! constructor
+    explicit AotRegistry(Alloc::IAllocator* allocator);
+
+    //! destructor
+    ~AotRegistry();
+
+    //! Registers a table of translated scripts
+    //! \param scripts the table. Pointer is cached, so a static table is expected.
+    //! \param count the number of entries of the table
+    void Register(const AotScript* scripts, int count);
+
+    //! \return the number of translated scripts registered
+    int GetScriptCount() const { return static_cast<int>(mScripts.GetSize()); }
+
+    //! Finds the translation of a bytecode
+    //! \param bytecode the bytecode of a compiled script
+    //! \return the translated script, null if none matches the bytecode
+    AotRunFunction Find(const BytecodeAssembly& bytecode) const;
+
+    //! Computes the key identifying a bytecode. Only the instructions, the constant kinds and the block offsets
+    //! are hashed, so the key does not depend on where the constants of a compilation live.
+    //! \param bytecode the bytecode
+    //! \return the 64 bit key
+    static Math::PUInt64 ComputeKey(const BytecodeAssembly& bytecode);
+
+private:
+    Utils::Vector<const AotScript*> mScripts;
+};
+
+//! Runtime of the bytecode, shared by the interpreter and the translated scripts
+namespace Aot
+{
+
+//! scratch register of the bytecode, aligned for the simd kernels
+PEGASUS_ALIGN_BEGIN(16) union ScratchRegister
+{
+    int   i[BYTECODE_SCRATCH_REGISTER_INTS];
+    float f[BYTECODE_SCRATCH_REGISTER_INTS];
+} PEGASUS_ALIGN_END(16);
+
+template<class T>
+inline T& As(ScratchRegister& r)
+{
+    return *reinterpret_cast<T*>(&r);
+}
+
+//! \return the stack base of the caller of the current frame
+inline int CallerSbp(BsVmState& state)
+{
+    FrameInformation * fi = reinterpret_cast<FrameInformation*>(state.Ram() + state.GetReg(Canon::R_SBP) - sizeof(FrameInformation));
+    PG_ASSERTSTR(fi->mSentinel == SENTINEL,"Memory corruption in stack!!");
+    return fi->mPreviousSbp;
+}
+
+//! resolves an address operand (frame, offset) to a ram offset
+inline int ResolveAddr(const int* operand, BsVmState& state)
+{
+    int frames = operand[0];
+    if (frames == BYTECODE_GLOBAL_FRAME)
+    {
+        return state.GetReg(Canon::R_G) + operand[1];
+    }
+
+    //block frames are flattened by the compiler, so an operand lives either in the current frame
+    //or, for function arguments being evaluated, in the frame of the caller
+    PG_ASSERT(frames == 0 || frames == 1);
+    return (frames == 0 ? state.GetReg(Canon::R_SBP) : CallerSbp(state)) + operand[1];
+}
+
+//! stores the return address of a call on the frame pushed for it
+inline void SetReturnIp(BsVmState& state, int ip)
+{
+    FrameInformation* fi = reinterpret_cast<FrameInformation*>(state.Ram() + state.GetReg(Canon::R_SBP) - sizeof(FrameInformation));
+    fi->mIp = ip;
+}
+
+//! notifies the runtime listener the script exited
+void Exit(BsVmState& state);
+
+//! pushes a stack frame
+void PushFrame(const Assembly& assembly, BsVmState& state, const StackFrameInfo* info);
+
+//! pops the current stack frame
+void PopFrame(BsVmState& state);
+
+//! pops the frame of a function returning
+//! \return the instruction to return to
+int Return(BsVmState& state);
+
+//! calls a c++ function whose arguments are on a pushed stack frame, then pops the frame
+void Callback(BsVmState& state, const Ast::FunCall* fc, int argumentBytes);
+
+//! calls a c++ function whose arguments are in the native argument buffer
+void Native(BsVmState& state, const Ast::FunCall* fc, int argumentBytes);
+
+//! reads or writes a property of an object
+void ObjProp(BsVmState& state, int locationAddress, int objectAddress, const PropertyNode* propertyNode, const TypeDesc* objType, bool isRead);
+
+//! \return the number of words of the instruction at pc, opcode included
+int GetInstructionSize(const int* pc);
+
+//! crashes the vm on an out of bounds access
+void Crash(BsVmState& state);
+
+//! in safe mode, checks an array access and crashes the vm if it is out of bounds
+//! \return false if the vm crashed
+inline bool CheckIndex(BsVmState& state, int offset, int arrayByteSize)
+{
+#if BLOCKSCRIPT_SAFEMODE
+    if (offset >= arrayByteSize && state.GetRuntimeListener() != nullptr)
+    {
+        Crash(state);
+        return false;
+    }
+#endif
+    return true;
+}
+
+} //namespace Aot
+
+} //namespace BlockScript
+} //namespace Pegasus
+
+#endif
@@ -0,0 +1,112 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                       Pegasus                                        */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file   BsJit.h
+//! \author agent
+//! \date   16th October 2026
+//! \brief  Just in time compiler of hot script functions. The bytecode interpreter counts the calls
+//!         of every function, and once a function passes a threshold its bytecode is translated
+//!         into x86-64 machine code. Functions using an instruction the jit does not translate
+//!         keep running on the interpreter.
+
+#ifndef PEGASUS_BLOCKSCRIPT_BSJIT_H
+#define PEGASUS_BLOCKSCRIPT_BSJIT_H
+
+#include "Pegasus/BlockScript/Canonizer.h"
+
+#ifndef BLOCKSCRIPT_JIT
+#define BLOCKSCRIPT_JIT 0
+#endif
+
+//! the jit only emits x86-64 code, other targets always interpret
+#if BLOCKSCRIPT_JIT && (defined(_M_X64) || defined(__x86_64__))
+#define BLOCKSCRIPT_JIT_X64 1
+#else
+#define BLOCKSCRIPT_JIT_X64 0
+#endif
+
+//! default number of calls after which a function is compiled
+#define BS_JIT_DEFAULT_CALL_THRESHOLD 32
+
+namespace Pegasus
+{
+namespace Alloc
+{
+    class IAllocator;
+}
+
+namespace BlockScript
+{
+
+class BsVm;
+class BsVmState;
+struct JitFunction;
+
+//! Jit of the functions of an assembly. Used by the vm on the BACKEND_JIT backend.
+//! A compiled function runs from its entry to its return without stopping, so the budget of
+//! a slice (see BsVm::RunBytecode) is not checked while it runs. It is not profiled either:
+//! a state with a profiler always runs on the interpreter.
+//! Calls are counted and functions compiled from any thread running the assembly.
+class BsJit
+{
+public:
+    //! constructor
+    //! \param allocator allocator of the call counters
+    explicit BsJit(Alloc::IAllocator* allocator);
+
+    //! destructor
+    ~BsJit();
+
+    //! \return true if this build can compile functions (BLOCKSCRIPT_JIT set, on x86-64)
+    static bool IsAvailable();
+
+    //! Sets the number of calls after which a function is compiled
+    //! \param calls the threshold, 1 compiles a function on its first call
+    void SetCallThreshold(int calls) { mCallThreshold = calls < 1 ? 1 : calls; }
+
+    //! \return the number of calls after which a function is compiled
+    int GetCallThreshold() const { return mCallThreshold; }
+
+    //! Prepares the call counters of an assembly. Nothing is compiled until a function gets hot.
+    //! \param assembly the assembly, copied until Reset. The blocks and bytecode it points to must outlive the jit.
+    //! \param vm the vm running the functions not compiled, cached until Reset
+    //! \return false if the jit is not available or the assembly has no bytecode
+    bool Initialize(const Assembly& assembly, const BsVm* vm);
+
+    //! Frees the compiled code and the counters. Call it before the assembly is destroyed
+    void Reset();
+
+    //! Called by the vm when it is about to run the instruction at entryIp on a fresh frame.
+    //! If entryIp starts a function, counts the call, compiles the function once it is hot and runs it.
+    //! \param state the state, with the frame of the function pushed
+    //! \param entryIp the instruction about to run
+    //! \param returnIp output, the instruction stored on the frame of the function when it returned
+    //! \return true if the function ran compiled, false if the interpreter has to run it
+    bool Run(BsVmState& state, int entryIp, int& returnIp);
+
+    //! \return the number of functions compiled
+    int GetCompiledCount() const;
+
+    //! \return the number of hot functions left on the interpreter, because of an instruction the jit does not translate
+    int GetRejectedCount() const;
+
+private:
+    //! translates a function, publishes its code on success
+    bool Compile(JitFunction& function);
+
+    Alloc::IAllocator* mAllocator;
+    Assembly           mAssembly;        //! copy of the assembly, with mJit pointing to this jit
+    const BsVm*        mVm;
+    int                mCallThreshold;
+    JitFunction*       mFunctions;       //! promotion state of every function of the function block map
+    int                mFunctionCount;
+    int*               mEntryToFunction; //! function starting at each instruction offset, -1 if none
+};
+
+}
+}
+
+#endif
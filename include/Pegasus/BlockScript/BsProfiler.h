@@ -0,0 +1,186 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                       Pegasus                                        */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file   BsProfiler.h
+//! \author agent
+//! \date   16th October 2026
+//! \brief  Profiler of the blockscript virtual machine. Counts every bytecode instruction executed,
+//!         and samples the call stack every few instructions to attribute wall time to script
+//!         functions and source lines.
+
+#ifndef PEGASUS_BLOCKSCRIPT_BSPROFILER_H
+#define PEGASUS_BLOCKSCRIPT_BSPROFILER_H
+
+#include "Pegasus/BlockScript/Canonizer.h"
+#include "Pegasus/Math/Types.h"
+#include "Pegasus/Utils/Vector.h"
+
+//! deepest call stack recorded by a sample, deeper frames are dropped
+#define BS_PROFILER_MAX_STACK_DEPTH 32
+
+//! default number of instructions executed between two samples
+#define BS_PROFILER_DEFAULT_SAMPLE_INTERVAL 1000
+
+namespace Pegasus
+{
+namespace Alloc
+{
+    class IAllocator;
+}
+
+namespace BlockScript
+{
+
+class BsVmState;
+
+//! Profiler of the bytecode interpreter. Attach it to a vm state with BsVmState::SetProfiler to
+//! start recording, and detach it (null) to stop: the interpreter only checks the profiler once per
+//! slice of execution, so a state without a profiler runs at full speed.
+//! A profiler records a single assembly. Running a different assembly drops what was recorded.
+//! The canonical tree interpreter is not profiled.
+class BsProfiler
+{
+public:
+    //! Flat profile of a function
+    struct FunctionEntry
+    {
+        const char*   mName;         //! name of the function, "<global>" for the global code
+        int           mFunction;     //! index in the function block map, -1 for the global code
+        Math::PUInt64 mCalls;        //! calls from scripts. Calls from c++ are not counted
+        Math::PUInt64 mInstructions; //! instructions executed in the function body
+        double        mSelfTime;     //! seconds sampled in the function body
+        double        mTotalTime;    //! seconds sampled in the function and its callees
+    };
+
+    //! Flat profile of a source line
+    struct LineEntry
+    {
+        const char*   mName;         //! name of the function owning the line
+        int           mFunction;     //! index in the function block map, -1 for the global code
+        int           mLine;         //! source line, 1 based. 0 if unknown
+        Math::PUInt64 mInstructions; //! instructions executed
+        double        mTime;         //! seconds sampled
+    };
+
+    //! Call stack seen by one or more samples
+    struct StackEntry
+    {
+        int    mDepth;                                //! number of frames
+        int    mFrames[BS_PROFILER_MAX_STACK_DEPTH]; //! functions, outermost first (-1 for the global code)
+        int    mSamples;                              //! samples that saw this stack
+        double mTime;                                 //! seconds attributed to this stack
+        unsigned int mHash;                           //! hash of the frames, to speed up the search
+    };
+
+    //! Constructor
+    //! \param allocator the allocator for the counters and the report
+    explicit BsProfiler(Alloc::IAllocator* allocator);
+
+    //! Destructor
+    ~BsProfiler();
+
+    //! \param instructions number of instructions executed between two samples. Lower values give
+    //!        a finer time attribution, at the cost of a clock read per sample.
+    void SetSampleInterval(int instructions);
+
+    //! \return the number of instructions between two samples
+    int GetSampleInterval() const { return mSampleInterval; }
+
+    //! Drops everything recorded
+    void Clear();
+
+    //! Drops everything recorded and forgets the assembly. Call it before the assembly profiled is destroyed
+    void Reset();
+
+    //! Called by the vm before running a slice of bytecode
+    //! \param assembly the assembly about to run, must have bytecode
+    void BeginRun(const Assembly& assembly);
+
+    //! Called by the vm after running a slice of bytecode
+    void EndRun();
+
+    //! Called by the vm before executing an instruction
+    //! \param ip the offset of the instruction
+    //! \return true if a sample is due, in which case the vm calls Sample
+    bool Count(int ip)
+    {
+        ++mCounts[ip];
+        return --mCountdown == 0;
+    }
+
+    //! Takes a sample: reads the clock and walks the call stack
+    //! \param ip the offset of the instruction about to execute
+    //! \param state the state running
+    void Sample(int ip, BsVmState& state);
+
+    //! Aggregates the counters and the samples into the function and line tables, sorted by time.
+    //! The assembly profiled must still be alive.
+    void BuildReport();
+
+    //! \return the number of functions of the last report
+    int GetFunctionCount() const { return static_cast<int>(mFunctions.GetSize()); }
+
+    //! \return a function of the last report
+    const FunctionEntry& GetFunction(int i) const { return mFunctions[i]; }
+
+    //! \return the number of lines of the last report
+    int GetLineCount() const { return static_cast<int>(mLines.GetSize()); }
+
+    //! \return a line of the last report
+    const LineEntry& GetLine(int i) const { return mLines[i]; }
+
+    //! \return the number of distinct call stacks sampled
+    int GetStackCount() const { return static_cast<int>(mStacks.GetSize()); }
+
+    //! \return a call stack sampled
+    const StackEntry& GetStack(int i) const { return mStacks[i]; }
+
+    //! \param function index in the function block map, -1 for the global code
+    //! \return the name of the function
+    const char* GetFunctionName(int function) const;
+
+    //! \return the number of instructions executed, as of the last report
+    Math::PUInt64 GetInstructionCount() const { return mInstructionCount; }
+
+    //! \return the number of samples taken
+    int GetSampleCount() const { return mSampleCount; }
+
+    //! \return the seconds spent running bytecode
+    double GetTotalTime() const { return mSampledTime + mPendingTime; }
+
+private:
+    //! \return the function owning an instruction, -1 for the global code
+    int GetFunctionAt(int ip) const;
+
+    //! frees the counters
+    void FreeCounters();
+
+    Alloc::IAllocator*         mAllocator;
+    const BytecodeAssembly*    mBytecode;
+    const int*                 mCode;
+    int                        mCodeSize;
+    const Container<FunMapEntry>* mFunBlockMap;
+
+    Math::PUInt64* mCounts;   //! instructions executed, per instruction offset
+    double*        mTimes;    //! seconds sampled, per instruction offset
+    int            mSampleInterval;
+    int            mCountdown;
+    int            mSampleCount;
+    double         mRunStart;    //! time of the last sample or of the beginning of the slice
+    double         mPendingTime; //! seconds spent running since the last sample
+    double         mSampledTime; //! seconds attributed to samples
+    int            mRunDepth;    //! slices in flight, native callbacks can reenter the vm
+    Math::PUInt64  mInstructionCount;
+
+    Utils::Vector<StackEntry>    mStacks;
+    Utils::Vector<FunctionEntry> mFunctions;
+    Utils::Vector<LineEntry>     mLines;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,258 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                       Pegasus                                        */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file   BsSimd.h
+//! \author agent
+//! \date   16th October 2026
+//! \brief  SIMD kernels of the blockscript bytecode alu. Vector and matrix values are processed
+//!         in quads (groups of 4 floats): float2, float3, float4 and float2x2 take one quad,
+//!         float3x3 takes three and float4x4 takes four.
+
+#ifndef PEGASUS_BLOCKSCRIPT_BSSIMD_H
+#define PEGASUS_BLOCKSCRIPT_BSSIMD_H
+
+#include "Pegasus/Utils/Memcpy.h"
+
+//! set to 1 to use sse kernels. Defaults to 1 on any target that guarantees sse2
+#ifndef BLOCKSCRIPT_SIMD
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define BLOCKSCRIPT_SIMD 1
+#else
+#define BLOCKSCRIPT_SIMD 0
+#endif
+#endif
+
+//! set to 1 to fuse multiply-adds. Defaults to 1 when compiling for avx2 (/arch:AVX2 or -mfma).
+//! Fused operations round once, so their results can differ in the last bit from the canonical tree interpreter.
+#ifndef BLOCKSCRIPT_SIMD_FMA
+#if BLOCKSCRIPT_SIMD && (defined(__FMA__) || defined(__AVX2__))
+#define BLOCKSCRIPT_SIMD_FMA 1
+#else
+#define BLOCKSCRIPT_SIMD_FMA 0
+#endif
+#endif
+
+#if BLOCKSCRIPT_SIMD
+#include <emmintrin.h>
+#if BLOCKSCRIPT_SIMD_FMA
+#include <immintrin.h>
+#endif
+#endif
+
+namespace Pegasus
+{
+namespace BlockScript
+{
+namespace Simd
+{
+
+// All the kernels work on float pointers aligned to 16 bytes, that can be read and written in
+// whole quads (the lanes past the value are scratch). Destinations can alias the sources.
+
+#if BLOCKSCRIPT_SIMD
+
+typedef __m128 Quad;
+
+inline Quad Load(const float* p)          { return _mm_load_ps(p); }
+inline void Store(float* p, Quad q)       { _mm_store_ps(p, q); }
+inline Quad Splat(float f)                { return _mm_set1_ps(f); }
+inline Quad Add(Quad a, Quad b)           { return _mm_add_ps(a, b); }
+inline Quad Sub(Quad a, Quad b)           { return _mm_sub_ps(a, b); }
+inline Quad Mul(Quad a, Quad b)           { return _mm_mul_ps(a, b); }
+inline Quad Div(Quad a, Quad b)           { return _mm_div_ps(a, b); }
+inline Quad Neg(Quad a)                   { return _mm_xor_ps(a, _mm_set1_ps(-0.0f)); }
+#if BLOCKSCRIPT_SIMD_FMA
+inline Quad MulAdd(Quad a, Quad b, Quad c) { return _mm_fmadd_ps(a, b, c); }
+#else
+inline Quad MulAdd(Quad a, Quad b, Quad c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+#endif
+
+//! lane i of a quad replicated on all the lanes
+#define BS_SIMD_LANE(Q, I) _mm_shuffle_ps(Q, Q, _MM_SHUFFLE(I, I, I, I))
+
+#else
+
+struct Quad { float v[4]; };
+
+inline Quad Load(const float* p)          { Quad q = { { p[0], p[1], p[2], p[3] } }; return q; }
+inline void Store(float* p, Quad q)       { p[0] = q.v[0]; p[1] = q.v[1]; p[2] = q.v[2]; p[3] = q.v[3]; }
+inline Quad Splat(float f)                { Quad q = { { f, f, f, f } }; return q; }
+inline Quad Add(Quad a, Quad b)           { Quad q = { { a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3] } }; return q; }
+inline Quad Sub(Quad a, Quad b)           { Quad q = { { a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3] } }; return q; }
+inline Quad Mul(Quad a, Quad b)           { Quad q = { { a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3] } }; return q; }
+inline Quad Div(Quad a, Quad b)           { Quad q = { { a.v[0] / b.v[0], a.v[1] / b.v[1], a.v[2] / b.v[2], a.v[3] / b.v[3] } }; return q; }
+inline Quad Neg(Quad a)                   { Quad q = { { -a.v[0], -a.v[1], -a.v[2], -a.v[3] } }; return q; }
+inline Quad MulAdd(Quad a, Quad b, Quad c) { return Add(Mul(a, b), c); }
+
+#define BS_SIMD_LANE(Q, I) Splat((Q).v[I])
+
+#endif
+
+//! lane wise binary operation on N quads
+#define BS_SIMD_LANEWISE(NAME) \
+    template<int N> inline void NAME(float* dst, const float* a, const float* b) \
+    { \
+        for (int q = 0; q < 4 * N; q += 4) \
+        { \
+            Store(dst + q, NAME(Load(a + q), Load(b + q))); \
+        } \
+    }
+
+BS_SIMD_LANEWISE(Add)
+BS_SIMD_LANEWISE(Sub)
+BS_SIMD_LANEWISE(Mul)
+BS_SIMD_LANEWISE(Div)
+
+#undef BS_SIMD_LANEWISE
+
+//! dst = -a on N quads
+template<int N> inline void Neg(float* dst, const float* a)
+{
+    for (int q = 0; q < 4 * N; q += 4)
+    {
+        Store(dst + q, Neg(Load(a + q)));
+    }
+}
+
+//! dst = a * b + c on N quads
+template<int N> inline void MulAdd(float* dst, const float* a, const float* b, const float* c)
+{
+    for (int q = 0; q < 4 * N; q += 4)
+    {
+        Store(dst + q, MulAdd(Load(a + q), Load(b + q), Load(c + q)));
+    }
+}
+
+//! dst = a + t * (b - a), on a single quad. Never fused, so it matches Math::Lerp to the bit
+inline void Lerp(float* dst, const float* a, const float* b, float t)
+{
+    Quad qa = Load(a);
+    Store(dst, Add(qa, Mul(Splat(t), Sub(Load(b), qa))));
+}
+
+//! \return the dot product of the first C (2, 3 or 4) lanes of a and b. Lanes are summed in order, like Math::Dot
+template<int C> inline float Dot(const float* a, const float* b)
+{
+    PEGASUS_ALIGN_BEGIN(16) float p[4] PEGASUS_ALIGN_END(16);
+    Store(p, Mul(Load(a), Load(b)));
+    float r = p[0] + p[1];
+    for (int i = 2; i < C; ++i)
+    {
+        r += p[i];
+    }
+    return r;
+}
+
+//! dst = cross(a, b), on the first 3 lanes
+inline void Cross(float* dst, const float* a, const float* b)
+{
+#if BLOCKSCRIPT_SIMD
+    Quad qa = Load(a);
+    Quad qb = Load(b);
+    Quad aYzx = _mm_shuffle_ps(qa, qa, _MM_SHUFFLE(3, 0, 2, 1));
+    Quad bZxy = _mm_shuffle_ps(qb, qb, _MM_SHUFFLE(3, 1, 0, 2));
+    Quad aZxy = _mm_shuffle_ps(qa, qa, _MM_SHUFFLE(3, 1, 0, 2));
+    Quad bYzx = _mm_shuffle_ps(qb, qb, _MM_SHUFFLE(3, 0, 2, 1));
+    Store(dst, Sub(Mul(aYzx, bZxy), Mul(aZxy, bYzx)));
+#else
+    float x = a[1] * b[2] - a[2] * b[1];
+    float y = a[2] * b[0] - a[0] * b[2];
+    float z = a[0] * b[1] - a[1] * b[0];
+    dst[0] = x;
+    dst[1] = y;
+    dst[2] = z;
+#endif
+}
+
+//! dst = mat * vec, mat is a row major float4x4
+inline void MulMat44Vec4(float* dst, const float* mat, const float* vec)
+{
+    Quad v = Load(vec);
+#if BLOCKSCRIPT_SIMD
+    //transpose, so the product is a sum of the columns scaled by each lane of the vector
+    Quad c0 = Load(mat);
+    Quad c1 = Load(mat + 4);
+    Quad c2 = Load(mat + 8);
+    Quad c3 = Load(mat + 12);
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+#else
+    Quad c0 = { { mat[0], mat[4], mat[8],  mat[12] } };
+    Quad c1 = { { mat[1], mat[5], mat[9],  mat[13] } };
+    Quad c2 = { { mat[2], mat[6], mat[10], mat[14] } };
+    Quad c3 = { { mat[3], mat[7], mat[11], mat[15] } };
+#endif
+    Quad r = Mul(c0, BS_SIMD_LANE(v, 0));
+    r = MulAdd(c1, BS_SIMD_LANE(v, 1), r);
+    r = MulAdd(c2, BS_SIMD_LANE(v, 2), r);
+    r = MulAdd(c3, BS_SIMD_LANE(v, 3), r);
+    Store(dst, r);
+}
+
+//! dst = a * b, both row major float4x4 matrices
+inline void MulMat44Mat44(float* dst, const float* a, const float* b)
+{
+    Quad b0 = Load(b);
+    Quad b1 = Load(b + 4);
+    Quad b2 = Load(b + 8);
+    Quad b3 = Load(b + 12);
+    //every row of a is read before its row of dst is written, so dst can alias a
+    for (int i = 0; i < 16; i += 4)
+    {
+        Quad row = Load(a + i);
+        Quad r = Mul(b0, BS_SIMD_LANE(row, 0));
+        r = MulAdd(b1, BS_SIMD_LANE(row, 1), r);
+        r = MulAdd(b2, BS_SIMD_LANE(row, 2), r);
+        r = MulAdd(b3, BS_SIMD_LANE(row, 3), r);
+        Store(dst + i, r);
+    }
+}
+
+//! Copies a value of byteSize bytes from memory to an aligned register. Whole quads are moved
+//! with unaligned loads, which run at full speed on the 16 byte aligned stack slots.
+inline void LoadValue(float* dst, const void* src, int byteSize)
+{
+    const float* f = static_cast<const float*>(src);
+    int q = 0;
+    for (; q + 16 <= byteSize; q += 16)
+    {
+#if BLOCKSCRIPT_SIMD
+        _mm_store_ps(dst + q / 4, _mm_loadu_ps(f + q / 4));
+#else
+        Store(dst + q / 4, Load(f + q / 4));
+#endif
+    }
+    if (q < byteSize)
+    {
+        Utils::Memcpy(dst + q / 4, f + q / 4, byteSize - q);
+    }
+}
+
+//! Copies a value of byteSize bytes from an aligned register to memory. Only byteSize bytes are written.
+inline void StoreValue(void* dst, const float* src, int byteSize)
+{
+    float* f = static_cast<float*>(dst);
+    int q = 0;
+    for (; q + 16 <= byteSize; q += 16)
+    {
+#if BLOCKSCRIPT_SIMD
+        _mm_storeu_ps(f + q / 4, _mm_load_ps(src + q / 4));
+#else
+        Store(f + q / 4, Load(src + q / 4));
+#endif
+    }
+    if (q < byteSize)
+    {
+        Utils::Memcpy(f + q / 4, src + q / 4, byteSize - q);
+    }
+}
+
+#undef BS_SIMD_LANE
+
+} //namespace Simd
+} //namespace BlockScript
+} //namespace Pegasus
+
+#endif
@@ -15,6 +15,13 @@
 #include "Pegasus/BlockScript/BlockScriptCanon.h"
 #include "Pegasus/BlockScript/Container.h"
 
+//! size of the buffer holding the arguments of native (c++) calls, shared by all the nested native calls
+#define BS_VM_NATIVE_ARGS_BYTESIZE 1024
+
+//! biggest argument list passed through the native argument buffer. Callbacks with bigger
+//! argument lists are called through a full stack frame
+#define BS_VM_NATIVE_CALL_MAX_ARGS_BYTESIZE 256
+
 namespace Pegasus
 {
 namespace Alloc
@@ -27,12 +34,33 @@ namespace BlockScript
 
 //! Forward declarations
 class BsVmState;
+class BsProfiler;
 class IRuntimeListener;
 
+#if PEGASUS_ENABLE_ASSERT
+//! value written on every frame record, to detect stack corruption. Not present in release builds.
+#define SENTINEL 3939
+#endif
+
+//! Record stored right below the base of every pushed stack frame.
+//! Its size is the frame slot alignment (16 bytes), so frame bases stay aligned.
+struct FrameInformation
+{
+    int mPreviousSbp;
+    int mIp; //current ip saved
+    int mB; //current b saved
+#if PEGASUS_ENABLE_ASSERT
+    int mSentinel;
+#else
+    int mPadding;
+#endif
+};
+
 // memory and register state of the current virtual machine
 class BsVmState
 {
     friend class BsVm;
+    friend class BsVmSnapshot;
 public:
     
     //all possible execution stages of virtual machine
@@ -40,7 +68,8 @@ public:
     {
         Crashed, //application has terminated due to an error. 
                  //To capture the error add a runtime listener and listen to the function OnCrash. Vm will not perform any operations any further along
-        Alive  //VM is alive, and can receive requests to ExecutionFunction, StepExecution or Run.
+        Alive,  //VM is alive, and can receive requests to ExecutionFunction, StepExecution or Run.
+        Suspended //execution paused by a callback (yield) or because it ran out of budget. Only accepts requests to Resume.
     };
 
     // Constructor
@@ -50,7 +79,9 @@ public:
     ~BsVmState();
 
     //! Initializes the allocator for this state structure
-    void Initialize(Alloc::IAllocator* allocator);
+    //! \param allocator the allocator of the heap and of the stack
+    //! \param stackByteSize stack reserved up front, usually Assembly::mStackByteSize of the script run on this state
+    void Initialize(Alloc::IAllocator* allocator, int stackByteSize = 0);
 
     //! Resets the state of this structure
     void Reset();
@@ -66,6 +97,13 @@ public:
 
     //! Get the runtime event listener
     IRuntimeListener* GetRuntimeListener() const { return mRuntimeListener; }
+
+    //! Sets the profiler recording the bytecode run on this state. Can be changed in between runs.
+    //! \param profiler the profiler, null to stop profiling
+    void SetProfiler(BsProfiler* profiler) { mProfiler = profiler; }
+
+    //! \return the profiler recording this state, null if not profiling
+    BsProfiler* GetProfiler() const { return mProfiler; }
     
     // gets registers
     int  GetReg(Canon::Register reg) const { return mR[reg]; }
@@ -77,11 +115,33 @@ public:
 
     char* Ram() { return mRam; }
 
+    //! \return the bytes of stack usable without growing
+    int GetRamCapacity() const { return mRamCount; }
+
+    //! Reserves stack up front. Runs that stay within the reserved size never move the stack.
+    //! \param bytes the size of the stack to reserve, usually Assembly::mStackByteSize
+    void Reserve(int bytes);
+
+    //! \return the number of times the stack grew past its reserved size. Only recursion grows it once
+    //!         the stack size computed by the compiler is reserved, so it stays constant in steady state.
+    int GetStackGrowCount() const { return mStackGrowCount; }
 
-    // Grows the memory stack. Reallocates memory if not big enough
+    // Grows the memory stack. Falls back to growing the reserved stack if not big enough
     void Grow(int bytes);
     void Shrink(int bytes);
 
+    //! \return where the arguments of the next native call are written.
+    //!         Always has room for BS_VM_NATIVE_CALL_MAX_ARGS_BYTESIZE bytes
+    char* GetNativeArgs() { return mNativeArgs + mNativeArgsTop; }
+
+    //! Reserves the arguments of a native call while its callback runs, so the callback can reenter the vm
+    //! \param bytes the size of the arguments written
+    //! \return the arguments, null if the native calls are nested too deep
+    char* PushNativeArgs(int bytes);
+
+    //! Releases the arguments of a native call
+    void PopNativeArgs(int bytes) { mNativeArgsTop -= bytes; }
+
     struct HeapElement
     {
         void* mObject;
@@ -104,6 +164,8 @@ public:
         return mHeapContainer[indexPointer];
     }
 
+    int GetHeapElementCount() const { return mHeapContainer.Size(); }
+
     int GetStackLevels() const { return mStackLevels; }
 
     void IncStackLevels() { ++mStackLevels; }
@@ -112,22 +174,72 @@ public:
 
     ExecutionState GetExecutionState() const { return mExecutionState; }
 
-    void SetExecutionState(ExecutionState execState) { mExecutionState = execState; }
+    void SetExecutionState(ExecutionState execState) { mExecutionState = execState; mIsSuspendedByCallback = false; }
+
+    //! Suspends the execution once the running callback returns, like the yield statement does.
+    //! The registers and the frames stay on this state until it is resumed (see BlockScript::Resume)
+    void Suspend() { if (mExecutionState == Alive) { mExecutionState = Suspended; mIsSuspendedByCallback = true; } }
+
+    //! \return true if an execution is suspended on this state
+    bool IsSuspended() const { return mExecutionState == Suspended; }
+
+    //! \return true if the execution was suspended by a callback, false if it ran out of budget
+    bool IsSuspendedByCallback() const { return mIsSuspendedByCallback; }
+
+    //! Records where the execution started on this state finishes, so it can be resumed once suspended
+    //! \param exitStackLevel the stack level the execution finishes on, -1 for a run of the global scope, 0 for a function call
+    //! \param savedIp the instruction restored once a function call returns
+    //! \param outputByteSize the size of the value returned by a function call
+    void SetResumeInfo(int exitStackLevel, int savedIp, int outputByteSize)
+    {
+        mResumeStackLevel = exitStackLevel;
+        mResumeIp = savedIp;
+        mResumeOutputByteSize = outputByteSize;
+    }
+
+    //! \return the stack level the suspended execution finishes on, -1 for a run of the global scope, 0 for a function call
+    int GetResumeStackLevel() const { return mResumeStackLevel; }
+
+    //! \return the instruction restored once the suspended function call returns
+    int GetResumeIp() const { return mResumeIp; }
+
+    //! \return the size of the value returned by the suspended function call
+    int GetResumeOutputByteSize() const { return mResumeOutputByteSize; }
+
 private:
 
     ExecutionState mExecutionState;
+    bool mIsSuspendedByCallback;
+
+    //how the execution suspended finishes
+    int mResumeStackLevel;
+    int mResumeIp;
+    int mResumeOutputByteSize;
 
     // the user context
     void* mUserContext;
 
-    // memory ram (stack)
+    //! makes bytes of stack usable, moving the stack if its memory can't be extended in place
+    void CommitRam(int bytes);
+
+    //! releases the stack memory, mapped or allocated
+    void FreeRam();
+
+    // memory ram (stack), aligned to the frame slot alignment inside mRamBlock
     char* mRam;
-    int   mRamCount;
-    int   mRamSize;
+    char* mRamBlock;
+    int   mRamCount; //usable bytes
+    int   mRamSize;  //bytes in use
+    int   mRamReservedCount; //bytes of address space mapped for the stack, 0 if it comes from the allocator (linux only)
+    int   mStackGrowCount;
 
     // registers
     int  mR[Canon::R_COUNT];
 
+    // arguments of the native calls in flight
+    char* mNativeArgs;
+    int   mNativeArgsTop;
+
     //stack metadata
     int mStackLevels;
 
@@ -140,25 +252,79 @@ private:
 
     //! Runtime listener
     IRuntimeListener* mRuntimeListener;
+
+    //! Profiler, null if not profiling
+    BsProfiler* mProfiler;
 };
 
 //actual virtual machine modifying the state
 class BsVm
 {
 public:
+
+    //! execution backends of the virtual machine
+    enum Backend
+    {
+        BACKEND_CANON,    //interprets the canonical tree, walking the expression trees
+        BACKEND_BYTECODE, //interprets the flat bytecode. Falls back to the canonical tree if the assembly has no bytecode
+        BACKEND_AOT,      //runs the ahead of time translation of the bytecode (see BsAot.h). Falls back to the bytecode if the assembly has none
+        BACKEND_JIT       //interprets the bytecode, and compiles the hot functions to machine code (see BsJit.h). Interprets only if the jit is not available
+    };
+
     //! constructor
-    BsVm(){}
+    BsVm() : mBackend(BACKEND_BYTECODE) {}
 
     //! destructor
     ~BsVm(){}
 
+    //! Sets the backend used to run assemblies
+    void SetBackend(Backend backend) { mBackend = backend; }
+
+    //! \return the backend used to run assemblies
+    Backend GetBackend() const { return mBackend; }
+
+    //! \return true if this assembly will be executed through its bytecode
+    bool UsesBytecode(const Assembly& assembly) const;
+
     //! Runs this assembly and modifies the virtual machine state of such
-    void Run(const Assembly& assembly, BsVmState& state) const;
+    //! \param budget number of jumps / calls allowed before the run is suspended, -1 for no limit.
+    //!        A run is also suspended when a callback calls BsVmState::Suspend
+    void Run(const Assembly& assembly, BsVmState& state, int budget = -1) const;
+
+    //! Continues a suspended run, or function call, until it finishes, runs out of budget or is suspended again
+    //! \param budget number of jumps / calls allowed before the execution is suspended again, -1 for no limit
+    void Resume(const Assembly& assembly, BsVmState& state, int budget = -1) const;
+
+    //! Runs a state until the execution returns to a stack level, a callback suspends it or the budget runs out.
+    //! Jumps and calls are counted as changes of block on the canonical tree.
+    //! \param exitStackLevel execution stops when a function returns to this stack level
+    //! \param budget number of jumps / calls allowed before execution is paused
+    //! \return true if execution was paused because the budget ran out, false if it finished or got suspended
+    bool RunSlice(const Assembly& assembly, BsVmState& state, int exitStackLevel, int budget) const;
 
     //! steps execution (one instruction).
     //! \param the actual state
     //! \return true if execution continues, false if exit requested
     bool StepExecution(const Assembly& assembly, BsVmState& state) const;
+
+    //! Runs the bytecode of an assembly, starting at the instruction stored in R_IP.
+    //! \param assembly the assembly, must contain bytecode
+    //! \param state the actual state
+    //! \param exitStackLevel execution stops when a function returns to this stack level
+    //! Runs the translated script instead if the backend is BACKEND_AOT and the assembly has one.
+    //! On BACKEND_JIT, a function starting at R_IP runs compiled once it is hot.
+    //! \param budget number of jumps / calls allowed before execution is paused
+    //! \return true if execution was paused because the budget ran out, false if it finished
+    bool RunBytecode(const Assembly& assembly, BsVmState& state, int exitStackLevel, int budget) const;
+
+    //! \return true if the bytecode interpreter dispatches through computed goto, false if it loops on a switch
+    static bool UsesComputedGoto();
+
+private:
+    //! runs slices until the execution finishes or is suspended, suspends it once the budget runs out
+    void Continue(const Assembly& assembly, BsVmState& state, int budget) const;
+
+    Backend mBackend;
 };
 
 }
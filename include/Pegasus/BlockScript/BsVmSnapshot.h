@@ -0,0 +1,95 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                       Pegasus                                        */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file   BsVmSnapshot.h
+//! \author agent
+//! \date   16th October 2026
+//! \brief  Snapshot of a virtual machine state, restored to rewind the state.
+
+#ifndef PEGASUS_BLOCKSCRIPT_BSVM_SNAPSHOT_H
+#define PEGASUS_BLOCKSCRIPT_BSVM_SNAPSHOT_H
+
+#include "Pegasus/BlockScript/Canonizer.h"
+#include "Pegasus/BlockScript/TypeDesc.h"
+#include "Pegasus/BlockScript/BsVm.h"
+
+//! size of the pages a snapshot copies the stack in. Divides the size of the stack of a state.
+#define BS_VM_SNAPSHOT_PAGE_BYTESIZE 512
+
+namespace Pegasus
+{
+namespace BlockScript
+{
+
+//! Copy of the registers, stack and heap table of a BsVmState.
+//! The stack is copied in pages. A snapshot taken after another one of the same state shares the pages
+//! that did not change in between, so a series of snapshots of a state that writes little of its memory
+//! costs little more than its first snapshot. Shared pages are never written, they are released with the
+//! last snapshot holding them.
+//! Only the memory of the vm is captured: objects the heap table points to, and objects created by callbacks
+//! (the nodes of a render collection for example) are not.
+class BsVmSnapshot
+{
+public:
+    //! Constructor
+    //! \param allocator the allocator of the pages
+    explicit BsVmSnapshot(Alloc::IAllocator* allocator);
+
+    //! Destructor
+    ~BsVmSnapshot();
+
+    //! Copies a state. The state must not be in the middle of a callback.
+    //! \param state the state to copy
+    //! \param previous an earlier snapshot of the same state to share the unchanged pages with, null to copy every page
+    void Capture(const BsVmState& state, const BsVmSnapshot* previous);
+
+    //! Rewinds a state to this snapshot. The state must not be in the middle of a callback.
+    //! \param state the state to overwrite, usually the one captured
+    void Restore(BsVmState& state) const;
+
+    //! Releases the pages of this snapshot, which becomes invalid
+    void Release();
+
+    //! \return true if this snapshot holds a state
+    bool IsValid() const { return mIsValid; }
+
+    //! \return the number of pages of the stack
+    int GetPageCount() const { return mPages.Size(); }
+
+    //! \return the number of pages shared with the previous snapshot at capture time
+    int GetSharedPageCount() const { return mSharedPageCount; }
+
+    //! \return the memory held by this snapshot in bytes. Pages shared by several snapshots count for
+    //!         a part each, so the sum over snapshots is the memory they use.
+    int GetByteSize() const;
+
+private:
+    //! page of stack, shared by the snapshots that captured the same content
+    struct Page
+    {
+        int  mRefCount;
+        char mData[BS_VM_SNAPSHOT_PAGE_BYTESIZE];
+    };
+
+    Alloc::IAllocator* mAllocator;
+    Container<Page*> mPages;
+    Container<BsVmState::HeapElement> mHeap;
+    int  mR[Canon::R_COUNT];
+    int  mRamSize;
+    int  mStackLevels;
+    BsVmState::ExecutionState mExecutionState;
+    bool mIsSuspendedByCallback;
+    int  mResumeStackLevel;
+    int  mResumeIp;
+    int  mResumeOutputByteSize;
+    int  mSharedPageCount;
+    bool mIsValid;
+};
+
+}
+}
+
+#endif
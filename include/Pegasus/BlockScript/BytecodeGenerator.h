@@ -0,0 +1,132 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                       Pegasus                                        */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file   BytecodeGenerator.h
+//! \author agent
+//! \date   16th October 2026
+//! \brief  Lowers the canonical assembly into a flat bytecode stream.
+
+#ifndef PEGASUS_BLOCKSCRIPT_BYTECODE_GENERATOR_H
+#define PEGASUS_BLOCKSCRIPT_BYTECODE_GENERATOR_H
+
+#include "Pegasus/BlockScript/BlockScriptBytecode.h"
+#include "Pegasus/BlockScript/TypeDesc.h"
+
+namespace Pegasus
+{
+
+//fwd declarations
+namespace Alloc
+{
+    class IAllocator;
+}
+
+namespace BlockScript
+{
+
+struct Assembly;
+
+namespace Ast
+{
+    class Exp;
+    class Idd;
+    class FunCall;
+}
+
+namespace Canon
+{
+    class CanonNode;
+}
+
+// Bytecode generator, runs after the canonizer.
+class BytecodeGenerator
+{
+public:
+
+    //! Constructor
+    BytecodeGenerator();
+
+    //! Destructor
+    ~BytecodeGenerator();
+
+    //! \param alloc the allocator to use for the bytecode buffers
+    void Initialize(Alloc::IAllocator* alloc);
+
+    //! resets the state, does not free memory
+    void Reset();
+
+    //! Lowers an assembly into bytecode.
+    //! \param assembly the canonical assembly
+    //! \return true if successful. If false the assembly contains constructs that the bytecode
+    //!         does not support, and the canonical tree must be used to run the script.
+    bool Generate(const Assembly& assembly);
+
+    //! \return the bytecode generated from the last call to Generate
+    const BytecodeAssembly* GetBytecode() const { return &mBytecode; }
+
+private:
+
+    //! destination of a value being saved
+    struct Destination
+    {
+        enum Kind
+        {
+            D_ADDR,    //memory operand, (frame, offset)
+            D_SCRATCH, //address stored in a scratch register
+            D_REGISTER, //canonical register
+            D_NATIVE   //native argument buffer, at offset
+        };
+        Kind mKind;
+        int mFrame;
+        int mOffset;
+        int mReg;
+    };
+
+    //! growable buffer of plain data
+    template<class T>
+    struct Buffer
+    {
+        T*  mData;
+        int mSize;
+        int mCapacity;
+        Buffer() : mData(nullptr), mSize(0), mCapacity(0) {}
+        T& Push(Alloc::IAllocator* alloc);
+        void Free(Alloc::IAllocator* alloc);
+    };
+
+    void EmitWord(int word) { mCode.Push(mAllocator) = word; }
+    void EmitAddr(const Ast::Idd* idd);
+    void EmitLabel(int label);
+    int  EmitConstant(const void* constant, Bytecode::ConstantKind kind);
+
+    bool EmitNode(const Canon::CanonNode* node);
+    bool EmitFunGo(const Canon::CanonNode* node);
+    bool EmitPureIntrinsic(Ast::FunCall* fc);
+    bool EmitValue(Ast::Exp* exp, TypeDesc::AluEngine engine, int reg);
+    bool EmitAddress(Ast::Exp* exp, int reg);
+    bool EmitSaveExpression(const Destination& dest, Ast::Exp* exp, int reg);
+    bool EmitStore(const Destination& dest, int reg, int byteSize);
+    bool EmitCopy(const Destination& dest, int addrReg, int byteSize);
+    void MakeDestination(Destination& dest, const Ast::Idd* idd);
+
+    Alloc::IAllocator* mAllocator;
+    BytecodeAssembly   mBytecode;
+
+    //! bias added to frame operands, used when evaluating arguments from inside a callee frame
+    int mFrameBias;
+
+    Buffer<int>         mCode;
+    Buffer<const void*> mConstants;
+    Buffer<int>         mConstantKinds;
+    Buffer<int>         mBlockOffsets;
+    Buffer<int>         mLabelPatches;
+    Buffer<Bytecode::LineEntry> mLines;
+};
+
+}
+}
+
+#endif
@@ -16,7 +16,7 @@
 #include "Pegasus/BlockScript/IVisitor.h"
 #include "Pegasus/BlockScript/Container.h"
 #include "Pegasus/BlockScript/BlockScriptCanon.h"
-#include "Pegasus/BlockScript/IddStrPool.h"
+#include "Pegasus/BlockScript/BlockScriptBytecode.h"
 #include "Pegasus/BlockScript/StackFrameInfo.h"
 #include "Pegasus/BlockScript/FunDesc.h"
 #include "Pegasus/Memory/BlockAllocator.h"
@@ -42,6 +42,7 @@ struct FunMapEntry
 {
     const FunDesc* mFunDesc;
     int mAssemblyBlock;
+    int mStackByteSize; //! stack used by a call to this function: its frame and the deepest chain of calls it makes. -1 if it can recurse
 };
 
 // extern globals map entry that contains function idd, and default value.
@@ -51,13 +52,28 @@ struct GlobalMapEntry
     const Ast::Imm* mDefaultVal;
 };
 
+class BsVmState;
+class BsJit;
+struct Assembly;
+
+//! Ahead of time translation of the bytecode of an assembly (see BsAot.h). Same contract as BsVm::RunBytecode:
+//! starts at the instruction stored in R_IP, \return true if execution was paused because the budget ran out, false if it finished
+typedef bool (*AotRunFunction)(const Assembly& assembly, BsVmState& state, int exitStackLevel, int budget);
+
 // structure that represents the assembly construction of blockscript
 struct Assembly
 {
     Container<Canon::Block>*    mBlocks;
     Container<FunMapEntry>*     mFunBlockMap;
     Container<GlobalMapEntry>*  mGlobalsMap;
-    Assembly() : mBlocks(nullptr), mFunBlockMap(nullptr), mGlobalsMap(nullptr) {}
+    const BytecodeAssembly*     mBytecode; //! flat bytecode lowered from mBlocks, null if lowering was not possible
+    int                         mStackByteSize;  //! stack needed by a run, or by a call to any function once the globals are set
+    bool                        mIsStackBounded; //! false if a function can recurse, the stack then grows past mStackByteSize
+    int                         mCheckedAccessCount; //! array accesses bounds checked in safe mode
+    int                         mProvenAccessCount;  //! array accesses proven in range by the compiler, never checked
+    AotRunFunction              mAot;            //! ahead of time translation of mBytecode, null if none is registered
+    BsJit*                      mJit;            //! jit of the hot functions of mBytecode, null if the jit is not available
+    Assembly() : mBlocks(nullptr), mFunBlockMap(nullptr), mGlobalsMap(nullptr), mBytecode(nullptr), mStackByteSize(0), mIsStackBounded(true), mCheckedAccessCount(0), mProvenAccessCount(0), mAot(nullptr), mJit(nullptr) {}
 };
 
 // Canonizer class
@@ -74,8 +90,13 @@ public:
         mCurrentStackFrame(nullptr),
         mCurrentFunDesc(nullptr),
         mCurrentBlock(0), 
+        mCurrentFunction(-1),
+        mCurrentLine(-1),
         mCurrentTempAllocationSize(0),
-        mNextLabel(0)
+        mNextLabel(0),
+        mStackByteSize(0),
+        mIsStackBounded(true),
+        mDropUnusedTemporaries(false)
     {
     }
 
@@ -98,6 +119,10 @@ public:
         SymbolTable*  symbolTable
     );
 
+    //! When set, function calls whose return value is never used do not allocate a temporal
+    //! to save the return register. Persists through Reset.
+    void SetDropUnusedTemporaries(bool dropUnusedTemporaries) { mDropUnusedTemporaries = dropUnusedTemporaries; }
+
     //! Gets the assembly generated from the canonizer step.
     //! \return the assembly generated from the assembly step.
     Assembly GetAssembly() 
@@ -105,6 +130,8 @@ public:
         Assembly a;
         a.mBlocks = &mBlocks;
         a.mFunBlockMap = &mFunBlockMap;
+        a.mStackByteSize = mStackByteSize;
+        a.mIsStackBounded = mIsStackBounded;
         return a;
     } 
 
@@ -138,6 +165,20 @@ private:
 
     void BuildFunctionAsm();
 
+    //! Computes the stack size of every function and of the whole assembly from the frame sizes
+    //! and the calls found in the blocks. Runs once all the blocks are built.
+    void ComputeStackSizes();
+
+    //! \param function entry in mFunBlockMap
+    //! \param marks visit state of every function: 0 not visited, 1 in the current call chain, 2 done
+    //! \return the stack used by a call to this function, -1 if it can recurse
+    int ComputeCallStackSize(int function, Container<int>& marks);
+
+    //! \param funGo a function call
+    //! \param marks visit state of every function, see ComputeCallStackSize
+    //! \return the stack used by this call, -1 if the callee can recurse
+    int ComputeFunGoStackSize(const Canon::FunGo* funGo, Container<int>& marks);
+
     bool IsContinuousSwizzle(Ast::Idd* swizzle) const;
 
     //! only saves the Ret register if the current context is a function greater than 4 bytes.
@@ -172,8 +213,13 @@ private:
     StackFrameInfo* mCurrentStackFrame;
     const FunDesc*  mCurrentFunDesc;
     int mCurrentBlock;
+    int mCurrentFunction; //! entry in mFunBlockMap of the function being canonized, -1 for global code
+    int mCurrentLine;     //! source line of the statement being canonized, stamped on every node pushed
     int mCurrentTempAllocationSize;
     int mNextLabel;
+    int mStackByteSize;
+    bool mIsStackBounded;
+    bool mDropUnusedTemporaries;
 
     Memory::BlockAllocator mAllocator;
     Container<Canon::Block> mBlocks;
@@ -186,7 +232,6 @@ private:
     };
 
     Container<FunDescIntPair> mLabelMap;
-    IddStrPool mStrPool;
 
 };
 
@@ -28,14 +28,21 @@ namespace Pegasus
 namespace BlockScript
 {
 
-//! class that interprets an expression tree
+//! class that interprets an expression tree.
+//! An engine holds the scratch state of a single evaluation, so it is created on the stack
+//! of the caller. This keeps the vm reentrant: different BsVmStates can evaluate concurrently.
 template<class IntrinsicType>
 class ExpressionEngine : public IVisitor
 {
 public:
-    explicit ExpressionEngine() : mState(nullptr) {}
+    explicit ExpressionEngine(BsVmState& state) : mState(&state) {}
     virtual ~ExpressionEngine(){}
-    IntrinsicType& Eval(Ast::Exp* exp, BsVmState& state);
+
+    //! Evaluates an expression tree
+    //! \param exp the expression to evaluate
+    //! \param state the vm state containing the memory to read from
+    //! \return the result of the expression
+    static IntrinsicType Eval(Ast::Exp* exp, BsVmState& state);
 
     
 #define BS_PROCESS(N) virtual void Visit(Ast::N* n);
@@ -44,6 +51,7 @@ public:
 
 private:
     IntrinsicType* GetArrayReference(Ast::Exp* lhs, Ast::Exp* rhs);
+    IntrinsicType& Run(Ast::Exp* exp);
     BsVmState* mState;
     IntrinsicType mResult;
 };
@@ -58,16 +66,6 @@ typedef ExpressionEngine<Pegasus::Math::Vec4> ExpressionEngine_Float4;
 typedef ExpressionEngine<Pegasus::Math::Vec3> ExpressionEngine_Float3;
 typedef ExpressionEngine<Pegasus::Math::Vec2> ExpressionEngine_Float2;
 
-//Singleton expression engines. 
-ExpressionEngine_Int    gIntExpEngine;
-ExpressionEngine_Float  gFloatExpEngine;
-ExpressionEngine_Float2 gFloat2ExpEngine;
-ExpressionEngine_Float3 gFloat3ExpEngine;
-ExpressionEngine_Float4 gFloat4ExpEngine;
-ExpressionEngine_Mat22 gMat22ExpEngine;
-ExpressionEngine_Mat33 gMat33ExpEngine;
-ExpressionEngine_Mat44 gMat44ExpEngine;
-
 
 }
 }
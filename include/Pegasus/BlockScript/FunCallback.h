@@ -30,6 +30,8 @@ typedef int (*PrintStringCallbackType)(const char *);
 typedef int (*PrintIntCallbackType)(int);
 typedef int (*PrintFloatCallbackType)(float);
 
+//! Print callbacks used by the echo intrinsics. These are shared by every vm state,
+//! so they must be thread safe if different states run concurrently.
 class SystemCallbacks
 {
 public:
@@ -169,6 +171,22 @@ const GlobalBindPoint GLOBAL_INVALID_BIND_POINT = -1;
 
 #define MAX_FUN_ARG_LIST 20
 
+//! Marks a callback as a pure intrinsic: a function with no side effects, whose return value only
+//! depends on its arguments. The compiler inlines calls to pure intrinsics as vm instructions,
+//! the callback is only used when the arguments can't be evaluated inline.
+enum PureIntrinsic
+{
+    PURE_NONE,      //! regular callback, always called
+    PURE_CONSTRUCT, //! returns the arguments concatenated. Int arguments are converted if the return type is float based
+    PURE_SPLAT,     //! returns its only argument replicated on every component of the return type
+    PURE_DOT,       //! dot product of two vectors
+    PURE_CROSS,     //! cross product of two float3
+    PURE_LERP,      //! linear interpolation (a, b, t)
+    PURE_MUL,       //! matrix times vector, or matrix times matrix
+    PURE_SIN,       //! sine of a float
+    PURE_COS        //! cosine of a float
+};
+
 struct FunctionDeclarationDesc
 {
     const char* functionName;
@@ -176,6 +194,7 @@ struct FunctionDeclarationDesc
     const char* argumentTypes[MAX_FUN_ARG_LIST];
     const char* argumentNames[MAX_FUN_ARG_LIST];
     FunCallback callback;
+    PureIntrinsic pureIntrinsic; //! optional, PURE_NONE if omitted from the initializer
 };
 
 #define MAX_OBJ_PROPERTY_LIST 20
@@ -247,6 +266,8 @@ FunBindPoint GetFunctionBindPoint(
 //! \param inputBufferSize - the size of the input argument buffer. If this size does not match the input buffer size of the function then this function returns false.
 //! \param outputBuffer - the output buffer to be used. 
 //! \param outputBufferSize - the size of the return buffer. If this size does not match the return value size, then this function returns false.
+//! \param budget - number of jumps / calls allowed before the call is suspended, -1 for no limit. If the call gets suspended
+//!                 (see BsVmState::IsSuspended), the output buffer is written by the ResumeFunction call it returns on.
 bool ExecuteFunction(
     FunBindPoint bindPoint,
     BlockScriptBuilder* builder, 
@@ -256,9 +277,32 @@ bool ExecuteFunction(
     const void* inputBuffer,
     int   inputBufferSize,
     void* outputBuffer,
-    int   outputBufferSize
+    int   outputBufferSize,
+    int   budget = -1
 );
 
+//! Continues a function call suspended on a state.
+//! \param assembly - the assembly instruction set, the one the call started on.
+//! \param bsVmState - the vm state, suspended in a function call.
+//! \param vm - the vm that will run the function.
+//! \param outputBuffer - the output buffer, written once the function returns.
+//! \param outputBufferSize - the size of the return buffer. If this size does not match the one passed to ExecuteFunction, then this function returns false.
+//! \param budget - number of jumps / calls allowed before the call is suspended again, -1 for no limit.
+//! \return false if the state is not suspended in a function call, true otherwise
+bool ResumeFunction(
+    const Assembly& assembly,
+    BsVmState& state,
+    BsVm& vm,
+    void* outputBuffer,
+    int   outputBufferSize,
+    int   budget = -1
+);
+
+//! Drops a function call suspended on a state. Its frames are unwound, the globals are kept
+//! and the state can run functions again.
+//! \param bsVmState - the vm state, suspended in a function call.
+void CancelFunction(BsVmState& state);
+
 //! Reads a global value from the VM state.
 //! \param bindPoint the bind point of the global value to read from
 //! \param assembly the assembly instruction set with global metadata
@@ -76,13 +76,21 @@ public:
     //! returns the callback for intrinsic functions
     FunCallback GetCallback() const { return mCallback; } 
 
+    //! sets the pure intrinsic this callback implements, see PureIntrinsic
+    void SetPureIntrinsic(PureIntrinsic pureIntrinsic) { mPureIntrinsic = pureIntrinsic; }
+
+    //! returns the pure intrinsic this callback implements, PURE_NONE if the callback has side effects
+    PureIntrinsic GetPureIntrinsic() const { return mPureIntrinsic; }
+
     //! returns the total size of the concatenated input arguments.
     int GetInputArgumentsByteSize() const { return mInputArgumentByteSize; }
 
     //! returns true if these type arg lists are equal, false otherwise
+    //! \param name the function name, interned in the identifier pool
     bool AreSignaturesEqual(const char* name, Ast::ArgList* argList) const;
 
     //! returns true if these type arg lists are equal, false otherwise
+    //! \param name the function name, interned in the identifier pool
     bool AreSignaturesEqual(const char* name, Ast::ExpList* argList) const;
 
     //! returns wether this function declaration is a method or not
@@ -98,6 +106,7 @@ private:
     bool mIsMethod;
 
     FunCallback mCallback;
+    PureIntrinsic mPureIntrinsic;
 };
 
 }
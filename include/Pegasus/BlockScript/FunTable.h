@@ -14,6 +14,7 @@
 
 #include "Pegasus/BlockScript/Container.h"
 #include "Pegasus/BlockScript/FunDesc.h"
+#include "Pegasus/BlockScript/NameIndex.h"
 
 namespace Pegasus
 {
@@ -48,6 +49,12 @@ public:
     //! \return the id of this function call
     FunDesc* Find(Ast::FunCall* funCall);
 
+    //! Finds a function declaration
+    //! \param funCall the function call to find a function description for
+    //! \param hash the hash of the function name, from IddStrPool::GetHash
+    //! \return the description of the function, null if not found
+    FunDesc* Find(Ast::FunCall* funCall, unsigned int hash);
+
     //! Returns enumeration of the current function.
     //! \param i the index
     //! \return the function description to extract
@@ -69,6 +76,9 @@ public:
 private:
     Container<FunDesc> mContainer;
 
+    //! index of the functions by name, overloads share a name
+    NameIndex mIndex;
+
 };
 
 }
@@ -7,15 +7,18 @@
 //! \file   IddStrPool.h
 //! \author Kleber Garcia
 //! \date   31th August 2014
-//! \brief  String pool allocator for identifiers.
+//! \brief  String interner for identifiers.
 
 #ifndef IDD_STR_POOL_H
 #define IDD_STR_POOL_H
 
+#include "Pegasus/BlockScript/Container.h"
+#include "Pegasus/BlockScript/NameIndex.h"
+#include <mutex>
+
 namespace Pegasus
 {
 
-//fwd declarations
 namespace Alloc
 {
     class IAllocator;
@@ -24,17 +27,18 @@ namespace Alloc
 namespace BlockScript
 {
 
-//! class that preallocates string pools, minimizing calls to malloc.
+//! Interns identifier strings. Every distinct string is stored once, in pages allocated on demand,
+//! and interning an equal string again returns the same pointer (handle). Handles stay valid until
+//! the pool is cleared, so two interned identifiers are equal if and only if their pointers are.
+//! A pool is shared by the libraries and scripts of a BlockScriptManager, so names can be compared
+//! across symbol tables. Interning and finding are thread safe, so scripts of a manager can be compiled
+//! concurrently. Handles are read without locking, since the pages never move.
 class IddStrPool
 {
 public:
 
-    static const int sMaxPages = 16;
-    static const int sMaxStringsPerPages = 64;
-    static const int sCharsPerString = 64;
-    static const int sPageByteSize = sCharsPerString * sMaxStringsPerPages;
-    static const int sMaxStrings = sMaxStringsPerPages * sMaxPages;
-    
+    //! size of a page of strings. Longer strings get a page of their own
+    static const int sPageByteSize = 4096;
 
     //! Constructor
     IddStrPool();
@@ -45,27 +49,45 @@ public:
     //! Initializes the identifier string pool
     void Initialize(Alloc::IAllocator * allocator);
 
-    //! Clears the identifier string pool
+    //! Clears the identifier string pool. Invalidates every handle
     void Clear();
 
-    //! Allocates a string in the cached pages
-    char* AllocateString();
+    //! Interns a string
+    //! \param str the string to intern, of any length
+    //! \return the handle of the string, a null terminated copy owned by the pool
+    const char* Intern(const char* str);
+
+    //! \param str the string to look for
+    //! \return the handle of the string, null if it has never been interned
+    const char* Find(const char* str) const;
+
+    //! \param handle a handle returned by Intern or Find
+    //! \return the hash of the handle (NameIndex::Hash of the string), without walking the string
+    static unsigned int GetHash(const char* handle) { return reinterpret_cast<const unsigned int*>(handle)[-1]; }
 
     //! Get page count
-    int GetPageCount() const { return mStringCount == 0 ? 0 : (mStringCount / sMaxStringsPerPages + 1); }
+    int GetPageCount() const { return mPages.Size(); }
 
     //! GetString count
-    int GetStringCount() const { return mStringCount; }
+    int GetStringCount() const { return mStrings.Size(); }
 
 private:
 
-    void AllocatePage();
-    
-    Alloc::IAllocator* mAllocator;
-    char* mPages[sMaxPages];
-    int   mStringCount;
+    //! \param byteSize bytes needed
+    //! \return memory for a string record, aligned to its hash
+    char* AllocateRecord(int byteSize);
+
+    //! \param str the string to look for
+    //! \param hash the hash of str
+    //! \return the handle of the string, null if not interned. The lock must be held.
+    const char* Find(const char* str, unsigned int hash) const;
 
-    
+    Alloc::IAllocator* mAllocator;
+    Container<char*>   mPages;
+    Container<const char*> mStrings; //! handles, by insertion order
+    NameIndex          mIndex;       //! hash of a string to its position in mStrings
+    int                mPageUsed;    //! bytes used on the last page
+    mutable std::mutex mLock;        //! guards the pages, the handles and the index
 };
 
 }
@@ -0,0 +1,95 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                       Pegasus                                        */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file   NameIndex.h
+//! \author agent
+//! \date   16th October 2026
+//! \brief  Hash index of names, used by the symbol tables to look up types, enums and functions.
+
+#ifndef PEGASUS_BLOCKSCRIPT_NAMEINDEX_H
+#define PEGASUS_BLOCKSCRIPT_NAMEINDEX_H
+
+namespace Pegasus
+{
+
+namespace Alloc
+{
+    class IAllocator;
+}
+
+namespace BlockScript
+{
+
+//! Maps the hash of a name to the values (table indices) registered with it.
+//! The index does not store the names: the owner compares them on the values found, to
+//! resolve collisions. Values with the same hash are visited in insertion order.
+//! To look up:
+//!     for (int c = index.Find(hash); c != -1; c = index.Next(c)) { int value = index.GetValue(c); ... }
+class NameIndex
+{
+public:
+    //! constructor
+    NameIndex();
+
+    //! destructor
+    ~NameIndex();
+
+    //! \param alloc the allocator for the buckets and the entries
+    void Initialize(Alloc::IAllocator* alloc);
+
+    //! removes all the values and frees the memory
+    void Reset();
+
+    //! \param name the name to hash, cannot be null
+    //! \return the hash of a name. Compute it once and pass it to every table looked up
+    static unsigned int Hash(const char* name);
+
+    //! Registers a value
+    //! \param hash the hash of the name, from Hash()
+    //! \param value the value to register
+    void Insert(unsigned int hash, int value);
+
+    //! \param hash the hash of the name, from Hash()
+    //! \return a cursor to the first value registered with this hash, -1 if none
+    int Find(unsigned int hash) const;
+
+    //! \param cursor a cursor from Find or Next
+    //! \return a cursor to the next value registered with the same hash, -1 if none
+    int Next(int cursor) const;
+
+    //! \param cursor a cursor from Find or Next
+    //! \return the value of the cursor
+    int GetValue(int cursor) const { return mEntries[cursor].mValue; }
+
+    //! \return the number of values registered
+    int Size() const { return mCount; }
+
+private:
+    struct Entry
+    {
+        unsigned int mHash;
+        int mValue;
+        int mNext; //! next entry of the same bucket, -1 if last
+    };
+
+    //! doubles the buckets and the entries
+    void Grow();
+
+    //! links an entry at the end of its bucket
+    void Link(int entry);
+
+    Alloc::IAllocator* mAllocator;
+    int*   mBuckets;  //! first entry of each bucket, -1 if empty
+    Entry* mEntries;
+    int    mBucketCount; //! power of two
+    int    mCapacity;
+    int    mCount;
+};
+
+}
+}
+
+#endif
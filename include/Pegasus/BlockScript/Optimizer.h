@@ -0,0 +1,130 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                       Pegasus                                        */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file   Optimizer.h
+//! \author agent
+//! \date   16th October 2026
+//! \brief  AST optimization pass, runs between the builder and the canonizer.
+//!         Folds constant expressions and removes dead code, rewriting the AST in place.
+
+#ifndef PEGASUS_BLOCKSCRIPT_OPTIMIZER_H
+#define PEGASUS_BLOCKSCRIPT_OPTIMIZER_H
+
+#include "Pegasus/BlockScript/IVisitor.h"
+
+namespace Pegasus
+{
+
+//fwd declarations
+namespace Alloc
+{
+    class IAllocator;
+}
+
+namespace BlockScript
+{
+
+class TypeDesc;
+
+namespace Ast
+{
+    union Variant;
+}
+
+// Optimizer class
+class Optimizer : private IVisitor
+{
+public:
+
+    //! optimization levels, each level includes the previous one
+    enum Level
+    {
+        LEVEL_NONE, //! the AST is canonized as it was built
+        LEVEL_FOLD, //! constant folding of operators, casts and vector constructors
+        LEVEL_FULL  //! folding, removal of unreachable code and of unused temporaries
+    };
+
+    //! Constructor
+    Optimizer();
+
+    //! Destructor
+    virtual ~Optimizer() {}
+
+    //! \param astAllocator the allocator used to create the folded AST nodes.
+    //!        Must be the same allocator that owns the AST being optimized.
+    void Initialize(Alloc::IAllocator* astAllocator);
+
+    //! resets the state, does not free memory
+    void Reset();
+
+    //! Optimizes a program. The AST is modified in place.
+    //! \param program the program to optimize
+    //! \param level the optimization level to apply
+    void Optimize(Ast::Program* program, Level level);
+
+private:
+    // visitor functions
+    #define BS_PROCESS(N) virtual void Visit(Ast::N*);
+    #include "Pegasus/BlockScript/Ast.inl"
+    #undef BS_PROCESS
+
+    //! what to do with the statement that has just been visited
+    enum StmtAction
+    {
+        STMT_KEEP,    //! leave the statement in place
+        STMT_REMOVE,  //! remove the statement from its list
+        STMT_REPLACE, //! replace the statement with mReplacementStmt
+        STMT_SPLICE   //! replace the statement with the statements in mReplacementList
+    };
+
+    //! folds an expression
+    //! \return the folded expression, or the same expression if nothing could be folded
+    Ast::Exp* Fold(Ast::Exp* exp);
+
+    //! optimizes all the statements of a list
+    //! \return the new head of the list. Never null, empty lists keep a single empty node
+    Ast::StmtList* OptimizeStmtList(Ast::StmtList* stmtList);
+
+    //! \return the folded immediate of a binary operation, null if it can't be folded
+    Ast::Exp* FoldBinop(Ast::Binop* binop, const Ast::Imm* lhs, const Ast::Imm* rhs);
+
+    //! \return the folded immediate of a cast, null if it can't be folded
+    Ast::Exp* FoldCast(Ast::Unop* cast, const Ast::Imm* imm);
+
+    //! \return the folded immediate of a float2, float3 or float4 constructor, null if it can't be folded
+    Ast::Exp* FoldVectorConstructor(Ast::FunCall* funCall);
+
+    //! creates a new immediate node
+    Ast::Imm* CreateImm(const Ast::Variant& v, const TypeDesc* type);
+
+    //! \param exp the condition expression
+    //! \param value output, the value of the condition if constant
+    //! \return true if the condition is a constant
+    static bool IsConstantCondition(const Ast::Exp* exp, bool& value);
+
+    //! removes the temporals of an expression whose value is never read
+    static void DiscardValue(Ast::Exp* exp);
+
+    Alloc::IAllocator* mAllocator;
+    Level mLevel;
+
+    Ast::Exp* mRebuiltExpression;
+
+    StmtAction mStmtAction;
+    Ast::Stmt* mReplacementStmt;
+    Ast::StmtList* mReplacementList;
+
+    //! true if the last statement visited always returns
+    bool mIsTerminal;
+
+    //! true if the last list optimized always returns
+    bool mListTerminates;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,155 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                       Pegasus                                        */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file   PrecompiledHeader.h
+//! \author agent
+//! \date   16th October 2026
+//! \brief  Precompiled blockscript headers. A header holding only type declarations (structs
+//!         and enums) is compiled once into its own symbol table, which every script including
+//!         it afterwards registers as a read only child instead of parsing the header again.
+
+#ifndef PEGASUS_BLOCKSCRIPT_PRECOMPILED_HEADER_H
+#define PEGASUS_BLOCKSCRIPT_PRECOMPILED_HEADER_H
+
+#include "Pegasus/BlockScript/BlockScriptBuilder.h"
+#include "Pegasus/BlockScript/AssemblyCache.h"
+#include "Pegasus/BlockScript/Container.h"
+#include "Pegasus/BlockScript/Preprocessor.h"
+#include "Pegasus/Core/Io.h"
+#include "Pegasus/Math/Types.h"
+#include <mutex>
+
+namespace Pegasus
+{
+
+//fwd declarations
+namespace Alloc
+{
+    class IAllocator;
+}
+
+namespace BlockScript
+{
+
+class SymbolTable;
+class IddStrPool;
+
+//! A header compiled on its own. Owns the symbol table with the types it declares, and the
+//! definitions it makes. Never modified once built, so scripts compiling concurrently can share it.
+//! \note Function definitions and declarations, globals and statements are not precompiled: their code
+//!       and global offsets belong to the assembly of each including script, and the compiler has no
+//!       step linking code compiled apart. A header holding any of them is parsed as text on every
+//!       include. Of the TestApp1 render system headers only ShUtil.bsh is type-only, so Core.bsh,
+//!       Frame.bsh, ShBaker.bsh and DeferredRenderer.bsh still cost a full parse per script.
+class PrecompiledHeader
+{
+public:
+    //! Constructor
+    //! \param allocator the allocator of the tables
+    //! \param strPool the identifier pool, shared with the scripts including the header
+    //! \param key the key of the header (see PrecompiledHeaderCache::ComputeKey)
+    //! \param path the path of the header, copied
+    PrecompiledHeader(Alloc::IAllocator* allocator, IddStrPool* strPool, Math::PUInt64 key, const char* path);
+
+    //! Destructor
+    ~PrecompiledHeader();
+
+    //! \return the key of this header
+    Math::PUInt64 GetKey() const { return mKey; }
+
+    //! \return the path of the header
+    const char* GetPath() const { return mPath; }
+
+    //! \return true if the header only declares types, and can be attached to the scripts including it.
+    //!         False if it has to be included as text (functions, globals, statements or errors).
+    bool IsValid() const { return mIsValid; }
+
+    //! \return the symbol table holding the types declared by the header
+    SymbolTable* GetSymbolTable() { return mBuilder.GetSymbolTable(); }
+
+    //! \return the definitions made by the header, to replay on the scripts including it
+    const Container<Preprocessor::Definition>& GetDefinitions() const { return mDefinitions; }
+
+    //! \return the headers included by this header, with the hash of their contents
+    const IncludeRecorder& GetIncludes() const { return mIncludes; }
+
+private:
+    friend class PrecompiledHeaderCache;
+
+    //! Compiles the header
+    //! \param source the header source
+    //! \param preprocessor the preprocessor of the including script, for its definitions and includer
+    //! \param includingTable the symbol table of the including script. Its children are visible to the header.
+    //! \param cache the cache the headers included by this header are looked up on
+    void Build(const Io::FileBuffer* source, const Preprocessor& preprocessor, const SymbolTable* includingTable, PrecompiledHeaderCache* cache);
+
+    BlockScriptBuilder                  mBuilder;
+    Container<Preprocessor::Definition> mDefinitions;
+    IncludeRecorder                     mIncludes;
+    Math::PUInt64                       mKey;
+    char                                mPath[Io::IOManager::MAX_FILEPATH_LENGTH];
+    bool                                mIsValid;
+};
+
+//! Set of precompiled headers shared by the scripts of a BlockScriptManager. A header is looked up by a key
+//! hashing its contents, the definitions visible where it is included and the symbol tables the including script
+//! sees, then revalidated against the contents of the headers it includes. Editing a header changes its key,
+//! so the stale entry is simply not found anymore.
+class PrecompiledHeaderCache
+{
+public:
+    //! Constructor
+    //! \param allocator the allocator of the headers
+    explicit PrecompiledHeaderCache(Alloc::IAllocator* allocator);
+
+    //! Destructor
+    ~PrecompiledHeaderCache();
+
+    //! Attaches a header to the script including it: its symbol table is registered as a child of the
+    //! script and its definitions are replayed. Compiles the header the first time it is seen.
+    //! \param path the path of the header
+    //! \param source the contents of the header, as opened by the includer of the preprocessor
+    //! \param sourceSize the size of the contents
+    //! \param preprocessor the preprocessor of the including script
+    //! \param includingTable the symbol table of the including script
+    //! \return true if the header was attached, false if it has to be parsed as text
+    bool Attach(const char* path, const char* source, int sourceSize, Preprocessor& preprocessor, SymbolTable* includingTable);
+
+    //! Destroys every header. The scripts compiled against them must be reset or destroyed beforehand.
+    void Clear();
+
+    //! \return the number of headers built (valid or not)
+    int GetHeaderCount() const { return mHeaders.Size(); }
+
+    //! \return the number of includes resolved by a header built beforehand
+    int GetHitCount() const { return mHitCount; }
+
+    //! \return the number of headers that had to be compiled
+    int GetMissCount() const { return mMissCount; }
+
+    //! Computes the key of a header
+    //! \param source the contents of the header
+    //! \param sourceSize the size of the contents
+    //! \param preprocessor the preprocessor of the including script
+    //! \param includingTable the symbol table of the including script
+    //! \return the key
+    static Math::PUInt64 ComputeKey(const char* source, int sourceSize, const Preprocessor& preprocessor, const SymbolTable* includingTable);
+
+private:
+    //! \return the header with this key whose includes still match the files, null if none
+    PrecompiledHeader* Find(Math::PUInt64 key, IFileIncluder* includer);
+
+    Alloc::IAllocator*             mAllocator;
+    Container<PrecompiledHeader*>  mHeaders;
+    int                            mHitCount;
+    int                            mMissCount;
+    std::recursive_mutex           mLock; //! serializes lookups and builds. Recursive, a header build attaches the headers it includes
+};
+
+}
+}
+
+#endif
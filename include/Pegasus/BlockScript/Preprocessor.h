@@ -26,6 +26,8 @@ namespace BlockScript
 {
 
 class IFileIncluder;
+class PrecompiledHeaderCache;
+class SymbolTable;
 
 //! Internal compiler preprocessor directive controller / parser
 class Preprocessor
@@ -100,6 +102,9 @@ public:
     //! get the number of defines 
     int GetDefinitionCount() const { return mDefinitions.GetSize(); }
 
+    //! get a definition
+    const Definition& GetDefinition(int i) const { return mDefinitions[i]; }
+
     //! insert a definition
     void InsertDefinition(const Definition& d) { mDefinitions.PushEmpty() = d; }
 
@@ -139,6 +144,11 @@ public:
     //! gets the file includer handler
     IFileIncluder* GetFileIncluder() const { return mFileIncluder; }
     
+    //! sets the cache of precompiled headers, null to always include headers as text
+    //! \param headerCache the cache headers are looked up on
+    //! \param symbolTable the symbol table of the script compiled, precompiled headers get attached to it
+    void SetHeaderCache(PrecompiledHeaderCache* headerCache, SymbolTable* symbolTable) { mHeaderCache = headerCache; mSymbolTable = symbolTable; }
+
     //! \return true if there is a buffer pending, false otherwise
     bool HasIncludeBuffer() const { return mHasInclude; }
 
@@ -173,6 +183,10 @@ private:
     //! includer callback
     IFileIncluder* mFileIncluder;
 
+    //! precompiled headers, and the symbol table they get attached to
+    PrecompiledHeaderCache* mHeaderCache;
+    SymbolTable* mSymbolTable;
+
     bool mHasInclude;
     Definition* mNextIncludeDefinition;
 };
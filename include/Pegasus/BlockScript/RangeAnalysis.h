@@ -0,0 +1,86 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                       Pegasus                                        */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file   RangeAnalysis.h
+//! \author agent
+//! \date   16th October 2026
+//! \brief  Range analysis of array indices, runs between the optimizer and the canonizer.
+//!         Marks the array accesses whose index is proven in range, so safe mode does not
+//!         check them at runtime.
+
+#ifndef PEGASUS_BLOCKSCRIPT_RANGE_ANALYSIS_H
+#define PEGASUS_BLOCKSCRIPT_RANGE_ANALYSIS_H
+
+#include "Pegasus/BlockScript/IVisitor.h"
+#include "Pegasus/Utils/Vector.h"
+
+namespace Pegasus
+{
+namespace BlockScript
+{
+
+//! Proves array indices in range. An index is in range if it is a constant, or an arithmetic
+//! expression of constants and induction variables of the enclosing for loops. A for loop has an
+//! induction variable when it has the form
+//!     for (i = start; i < end; ++i) (also i <= end, i++ and i = i + step)
+//! with start >= 0, a positive constant step and i never written by the body of the loop.
+//! Every other access keeps its bounds check.
+class RangeAnalysis : private IVisitor
+{
+public:
+    //! Constructor
+    RangeAnalysis();
+
+    //! Destructor
+    virtual ~RangeAnalysis() {}
+
+    //! resets the counters
+    void Reset();
+
+    //! Marks the array accesses of a program whose index is proven in range (see Ast::Binop::IsIndexInRange)
+    //! \param program the program, after optimization
+    void Analyze(Ast::Program* program);
+
+    //! \return the number of array accesses left with a bounds check by the last analysis
+    int GetCheckedCount() const { return mCheckedCount; }
+
+    //! \return the number of array accesses proven in range by the last analysis
+    int GetProvenCount() const { return mProvenCount; }
+
+private:
+    // visitor functions
+    #define BS_PROCESS(N) virtual void Visit(Ast::N*);
+    #include "Pegasus/BlockScript/Ast.inl"
+    #undef BS_PROCESS
+
+    //! values an induction variable takes in the body of its loop
+    struct Induction
+    {
+        const Ast::Idd* mVar;
+        int mMin;
+        int mMax;
+    };
+
+    //! \param exp an integer expression
+    //! \param outMin output, the smallest value of the expression
+    //! \param outMax output, the largest value of the expression
+    //! \return true if the range of the expression is known
+    bool GetRange(const Ast::Exp* exp, int& outMin, int& outMax) const;
+
+    //! \param loop a for loop
+    //! \param induction output, the induction variable of the loop and its range in the body
+    //! \return true if the loop has the form of a counted loop
+    bool MatchInduction(const Ast::StmtFor* loop, Induction& induction) const;
+
+    Utils::Vector<Induction> mInductions; //! induction variables of the loops enclosing the node visited
+    int mCheckedCount;
+    int mProvenCount;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,87 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                       Pegasus                                        */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file   ScriptSignature.h
+//! \author agent
+//! \date   16th October 2026
+//! \brief  Fingerprint of a compiled script, compared across recompilations of a script
+//!         being edited to find out whether its running states survive the edit.
+
+#ifndef PEGASUS_BLOCKSCRIPT_SCRIPT_SIGNATURE_H
+#define PEGASUS_BLOCKSCRIPT_SCRIPT_SIGNATURE_H
+
+#include "Pegasus/BlockScript/Container.h"
+#include "Pegasus/Math/Types.h"
+
+namespace Pegasus
+{
+
+//fwd declarations
+namespace Alloc
+{
+    class IAllocator;
+}
+
+namespace BlockScript
+{
+
+namespace Ast
+{
+    class Program;
+}
+
+//! Fingerprint of a program. Every function is hashed on its own, everything else (global variables,
+//! types and the statements of the global scope) is folded into a single layout key.
+//! Two compilations with the same layout key lay out their globals the same way and initialize them
+//! the same way, so a state set up by one can keep running on the functions of the other.
+class ScriptSignature
+{
+public:
+    //! Constructor
+    //! \param allocator the allocator of the function entries
+    explicit ScriptSignature(Alloc::IAllocator* allocator);
+
+    //! Destructor
+    ~ScriptSignature();
+
+    //! Fingerprints a program
+    //! \param program the program, as built by the compiler
+    void Build(Ast::Program* program);
+
+    //! Invalidates the signature. An invalid signature matches nothing.
+    void Reset();
+
+    //! \return true if the signature was built from a program
+    bool IsValid() const { return mIsValid; }
+
+    //! \return the hash of everything but the functions
+    Math::PUInt64 GetLayoutKey() const { return mLayoutKey; }
+
+    //! \return the number of functions of the program
+    int GetFunctionCount() const { return mFunctions.Size(); }
+
+    //! Compares this signature with the one of an earlier compilation of the same script
+    //! \param previous the signature of the earlier compilation
+    //! \return the number of functions added or edited since, -1 if the layouts differ or a signature is invalid
+    int CountChangedFunctions(const ScriptSignature& previous) const;
+
+private:
+    //! hashes of a function
+    struct FunctionEntry
+    {
+        Math::PUInt64 mName; //! name and argument types
+        Math::PUInt64 mBody; //! the whole declaration
+    };
+
+    Container<FunctionEntry> mFunctions;
+    Math::PUInt64            mLayoutKey;
+    bool                     mIsValid;
+};
+
+}
+}
+
+#endif
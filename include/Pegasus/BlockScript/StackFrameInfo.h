@@ -14,7 +14,6 @@
 #define STACK_FRAME_INFO_H
 
 #include "Pegasus/BlockScript/Container.h"
-#include "Pegasus/BlockScript/IddStrPool.h"
 #include "Pegasus/BlockScript/TypeDesc.h"
 
 namespace Pegasus
@@ -33,9 +32,9 @@ public:
     struct Entry
     {
     public:
-        Entry() : mOffset(-1), mType(nullptr), mIsArg(false) { mName[0] = '\0';}
+        Entry() : mName(nullptr), mOffset(-1), mType(nullptr), mIsArg(false) {}
         ~Entry(){}
-        char mName[IddStrPool::sCharsPerString];
+        const char* mName; //! interned in the identifier pool
         int  mOffset;
         const TypeDesc* mType;
         int  mIsArg;
@@ -52,6 +51,10 @@ public:
         STRUCT_DEF //to be used to determine offsets within this stack frame. This frame should have a null parent
     };
 
+    //! Alignment of the variables that hold a float4 or a matrix. Frames are padded to a multiple of it,
+    //! so these slots stay aligned at runtime and the vm can use sse loads and stores on them.
+    static const int sSlotAlignment = 16;
+
     //! Constructor
     StackFrameInfo();
 
@@ -72,19 +75,33 @@ public:
     //! \return gets the size in bytes of the total temporal space in memory
     int GetTempSize() const { return mTempSize; }
 
-    //! \return the total size of this frame plus the temporal space size
-    int GetTotalFrameSize() const { return mSize + mTempSize; }
+    //! \return the offset of the temporal space, the frame size padded to the slot alignment
+    int GetTempBase() const { return AlignSlot(mSize); }
+
+    //! \return the total size of this frame plus the temporal space size, padded to the slot alignment
+    int GetTotalFrameSize() const { return AlignSlot(GetTempBase() + mTempSize); }
+
+    //! \param type the type of a variable
+    //! \return true if variables of this type are placed in aligned slots
+    static bool IsAlignedSlot(const TypeDesc* type);
 
+    //! \return offset rounded up to the slot alignment
+    static int AlignSlot(int offset) { return (offset + sSlotAlignment - 1) & ~(sSlotAlignment - 1); }
+
+    //! Allocates a variable. Block scoped frames (if statements and loops) do not own memory, 
+    //! their variables are flattened into the storage frame (see GetStorageFrame). Function arguments
+    //! and struct members are always allocated in this frame.
+    //! \param name the name of the variable, interned in the identifier pool. The pointer is kept
     //! \param type sets the type id to allocate.
     //! \param typeTable type table containing all the type information
-    //! \return returns the byte offset for this allocation.
+    //! \return returns the byte offset for this allocation, relative to the storage frame.
     int Allocate(const char* name, const TypeDesc* type, bool isFunctionArgument = false);
 
     //! Allocates a temp variable
     //! \param the byte size to allocate
     int AllocateTemporal(int byteSize);
 
-    //! \param name the name for this allocation
+    //! \param name the name for this allocation, interned in the identifier pool
     //! \return null if not found, otherwise true.
     Entry* FindDeclaration(const char* name);
 
@@ -106,6 +123,13 @@ public:
     //! \return gets the parent stack frame id
     StackFrameInfo* GetParentStackFrame() const { return mParent; }
 
+    //! \return the frame that owns the memory of the variables of this frame. This is the closest
+    //!         function body or global frame. At runtime, only storage frames are pushed to the stack.
+    StackFrameInfo* GetStorageFrame();
+
+    //! \return true if this frame owns its memory
+    bool IsStorageFrame() const;
+
 private:
     int mSize; 
     int mTempSize;
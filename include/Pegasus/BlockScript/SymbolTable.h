@@ -57,7 +57,11 @@ public:
 
     //! Initialization of symbol table. Run only once to store allocator
     //! \param allocator - the allocator to use internally
-    void Initialize(Alloc::IAllocator* allocator);
+    //! \param strPool - the pool interning the names. Children must share it, names are compared by pointer
+    void Initialize(Alloc::IAllocator* allocator, IddStrPool* strPool);
+
+    //! \return the pool interning the names of this table
+    IddStrPool* GetStringPool() const { return mStrPool; }
 
     //! Registers a child symbol table (external library)
     //! \param symbolTable - the symbol table to have as a child
@@ -69,22 +73,43 @@ public:
     //!        into the same symbol table twice.
     void UnregisterChild(SymbolTable* symbolTable);
 
+    //! \return the number of child symbol tables registered
+    int GetChildCount() const { return mChildren.Size(); }
+
+    //! \param i the index of the child, in registration order
+    //! \return a child symbol table
+    SymbolTable* GetChild(int i) const { return mChildren[i]; }
+
     //! Call to go back to initial empty state and restart compilation (children need to be re-added)
     void Reset();
 
     //! \return gets the type description from the type name specified (non arrayd)
     const TypeDesc* GetTypeByName(const char* typeName) const;
 
+    //! \param typeName the type name, interned in the string pool
+    //! \param hash the hash of the type name, from IddStrPool::GetHash
+    //! \return gets the type description from the type name specified (non arrayd)
+    const TypeDesc* GetTypeByName(const char* typeName, unsigned int hash) const;
+
     //! \returns a writable type description for patching purposes
     //! \note use only this function for hacks
     TypeDesc* GetTypeForPatching(const char* typeName);
 
+    //! \param typeName the type name, interned in the string pool
+    //! \param hash the hash of the type name, from IddStrPool::GetHash
+    //! \returns a writable type description for patching purposes
+    TypeDesc* GetTypeForPatching(const char* typeName, unsigned int hash);
+
     //! \param name the name of the enumeration value
     //! \param outEnumNode a pointer to fill in with the enumeration node 
     //! \param outEnumType a pointer to fill in with the enumeration type
     //! \return true if found it, false otherwise
     bool FindEnumByName(const char* name, const EnumNode** outEnumNode, const TypeDesc** outEnumType) const;
 
+    //! \param name the name of the enumeration value, interned in the string pool
+    //! \param hash the hash of the name, from IddStrPool::GetHash
+    bool FindEnumByName(const char* name, unsigned int hash, const EnumNode** outEnumNode, const TypeDesc** outEnumType) const;
+
     //! creates a new node describing an enumeration element
     EnumNode* NewEnumNode();
 
@@ -136,10 +161,13 @@ public:
     TypeDesc* CreateArrayType(const char* name, TypeDesc* childType, int count);
 
     //! Returns a function description based on an AST function call. The FunDesc
-    //! \param functionCall - AST node with function call.
+    //! \param functionCall - AST node with function call. Its name must be interned in the string pool
     //! \return nullptr if not found, otherwise the description of such function
     FunDesc* FindFunctionDescription(Ast::FunCall* functionCall);
 
+    //! \param hash the hash of the function name, from IddStrPool::GetHash
+    FunDesc* FindFunctionDescription(Ast::FunCall* functionCall, unsigned int hash);
+
     //! Creates a new function description. Returns null if such function already exists
     //! \param funDec - AST with entire function definition
     //! \return funDesc - nullptr if hte function definition exists already.
@@ -192,6 +220,9 @@ private:
 
     //! allocator
     Alloc::IAllocator* mAllocator;
+
+    //! identifier pool, shared with the children
+    IddStrPool* mStrPool;
 };
 
 }
@@ -80,8 +80,6 @@ class TypeDesc
 {
 public:
 
-    static const int sMaxTypeName = 64;
-
     //! the constructor for the type descriptor.
     TypeDesc();
 
@@ -89,8 +87,8 @@ public:
     ~TypeDesc();
 
     //! Sets the name of this typedesc
-    //! \param typeName the actual name of the parameter
-    void SetName(const char * typeName);
+    //! \param typeName the actual name of the parameter, interned in the identifier pool. The pointer is kept
+    void SetName(const char * typeName) { mName = typeName; }
 
     //! Gets the name of this typedesc
     //! \return the name of this type
@@ -224,7 +222,7 @@ private:
     bool CmpStructProperty(const TypeDesc* other) const;
     bool CmpEnumProperty(const TypeDesc* other) const;
 
-    char       mName[sMaxTypeName];
+    const char* mName;
     Modifier   mModifier;
     AluEngine  mAluEngine;
     TypeDesc*  mChild;
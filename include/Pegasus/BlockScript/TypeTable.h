@@ -12,6 +12,8 @@
 #define PEGASUS_TYPETABLE_H
 #include "Pegasus/BlockScript/TypeDesc.h"
 #include "Pegasus/BlockScript/Container.h"
+#include "Pegasus/BlockScript/NameIndex.h"
+#include "Pegasus/BlockScript/IddStrPool.h"
 
 namespace Pegasus
 {
@@ -43,12 +45,14 @@ public:
 
     //! initializes the type table internally with default scalar / tree types
     //! \param alloc the allocator to be used internally
-    void Initialize(Alloc::IAllocator* alloc);
+    //! \param strPool the pool interning the names of the types, enumeration values and properties
+    void Initialize(Alloc::IAllocator* alloc, IddStrPool* strPool);
 
     //! shuts down the type and frees memory
     void Shutdown();
 
     //! Creates a new type if it does not exist. If the type exists already, it will find it and return it
+    //! The names of the type, of its enumeration values and of its properties are interned.
     //! \param modifier  the modifier to be using
     //! \param name the actual string name of this type
     //! \param child the child id of this type
@@ -71,17 +75,36 @@ public:
     //! \return the description struct 
 	const TypeDesc* GetTypeByName(const char* name) const;
 
+    //! Gets a type description structure
+    //! \param name unique name, interned in the identifier pool
+    //! \param hash the hash of the name, from IddStrPool::GetHash
+    //! \return the description struct 
+    const TypeDesc* GetTypeByName(const char* name, unsigned int hash) const;
+
     //! Gets a type description structure for writable purposes
     //! \param name unique name
     //! \return the description struct for modification
     TypeDesc* GetTypeForPatching(const char* name);
 
+    //! Gets a type description structure for writable purposes
+    //! \param name unique name, interned in the identifier pool
+    //! \param hash the hash of the name, from IddStrPool::GetHash
+    //! \return the description struct for modification
+    TypeDesc* GetTypeForPatching(const char* name, unsigned int hash);
+
     //! \param name the name of the enumeration value
     //! \param outEnumNode a pointer to fill in with the enumeration node 
     //! \param outEnumType a pointer to fill in with the enumeration type
     //! \return true if found it, false otherwise
     bool FindEnumByName(const char* name, const EnumNode** outEnumNode, const TypeDesc** outEnumType) const;
 
+    //! \param name the name of the enumeration value, interned in the identifier pool
+    //! \param hash the hash of the name, from IddStrPool::GetHash
+    //! \param outEnumNode a pointer to fill in with the enumeration node 
+    //! \param outEnumType a pointer to fill in with the enumeration type
+    //! \return true if found it, false otherwise
+    bool FindEnumByName(const char* name, unsigned int hash, const EnumNode** outEnumNode, const TypeDesc** outEnumType) const;
+
     //! \returns a new enum node
     EnumNode* NewEnumNode();
 
@@ -99,6 +122,13 @@ private:
     Container<TypeDesc> mTypeDescPool;
     Container<EnumNode> mEnumNodePool;
     Container<PropertyNode> mPropertyNodePool;
+    IddStrPool* mStrPool;
+
+    //! index of the types by name. Arrays are not indexed, they are never looked up by name
+    NameIndex mTypeIndex;
+
+    //! index of the enumeration values by name, to the index of their enumeration type
+    NameIndex mEnumIndex;
 };
 
 }
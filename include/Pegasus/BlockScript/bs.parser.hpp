@@ -1,21 +1,22 @@
-/* A Bison parser, made by GNU Bison 2.7.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison interface for Yacc-like parsers in C
-   
-      Copyright (C) 1984, 1989-1990, 2000-2012 Free Software Foundation, Inc.
-   
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
    the Free Software Foundation, either version 3 of the License, or
    (at your option) any later version.
-   
+
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
    GNU General Public License for more details.
-   
+
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -26,13 +27,17 @@
    special exception, which will cause the skeleton and the resulting
    Bison output files to be licensed under the GNU General Public
    License without this special exception.
-   
+
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 #ifndef YY_BS_BS_PARSER_HPP_INCLUDED
 # define YY_BS_BS_PARSER_HPP_INCLUDED
-/* Enabling traces.  */
+/* Debug traces.  */
 #ifndef YYDEBUG
 # define YYDEBUG 0
 #endif
@@ -40,76 +45,80 @@
 extern int BS_debug;
 #endif
 
-/* Tokens.  */
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     I_FLOAT = 258,
-     I_INT = 259,
-     IDENTIFIER = 260,
-     TYPE_IDENTIFIER = 261,
-     I_STRING = 262,
-     K_IF = 263,
-     K_ELSE_IF = 264,
-     K_ELSE = 265,
-     K_SEMICOLON = 266,
-     K_L_PAREN = 267,
-     K_R_PAREN = 268,
-     K_L_BRAC = 269,
-     K_R_BRAC = 270,
-     K_L_LACE = 271,
-     K_R_LACE = 272,
-     K_COMMA = 273,
-     K_COL = 274,
-     K_RETURN = 275,
-     K_WHILE = 276,
-     K_FOR = 277,
-     K_STRUCT = 278,
-     K_ENUM = 279,
-     K_STATIC_ARRAY = 280,
-     K_SIZE_OF = 281,
-     K_EXTERN = 282,
-     K_A_PAREN = 283,
-     O_PLUS = 284,
-     O_MINUS = 285,
-     O_MUL = 286,
-     O_DIV = 287,
-     O_MOD = 288,
-     O_EQ = 289,
-     O_NEQ = 290,
-     O_GT = 291,
-     O_LT = 292,
-     O_GTE = 293,
-     O_LTE = 294,
-     O_LAND = 295,
-     O_LOR = 296,
-     O_SET = 297,
-     O_DOT = 298,
-     O_ACCESS = 299,
-     O_INC = 300,
-     O_DEC = 301,
-     O_METHOD_CALL = 302,
-     O_IMPLICIT_CAST = 303,
-     O_EXPLICIT_CAST = 304,
-     ACCESS_PREC = 305,
-     CAST = 306,
-     NEG = 307
-   };
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    I_FLOAT = 258,                 /* I_FLOAT  */
+    I_INT = 259,                   /* I_INT  */
+    IDENTIFIER = 260,              /* IDENTIFIER  */
+    TYPE_IDENTIFIER = 261,         /* TYPE_IDENTIFIER  */
+    I_STRING = 262,                /* I_STRING  */
+    K_IF = 263,                    /* K_IF  */
+    K_ELSE_IF = 264,               /* K_ELSE_IF  */
+    K_ELSE = 265,                  /* K_ELSE  */
+    K_SEMICOLON = 266,             /* K_SEMICOLON  */
+    K_L_PAREN = 267,               /* K_L_PAREN  */
+    K_R_PAREN = 268,               /* K_R_PAREN  */
+    K_L_BRAC = 269,                /* K_L_BRAC  */
+    K_R_BRAC = 270,                /* K_R_BRAC  */
+    K_L_LACE = 271,                /* K_L_LACE  */
+    K_R_LACE = 272,                /* K_R_LACE  */
+    K_COMMA = 273,                 /* K_COMMA  */
+    K_COL = 274,                   /* K_COL  */
+    K_RETURN = 275,                /* K_RETURN  */
+    K_WHILE = 276,                 /* K_WHILE  */
+    K_FOR = 277,                   /* K_FOR  */
+    K_STRUCT = 278,                /* K_STRUCT  */
+    K_ENUM = 279,                  /* K_ENUM  */
+    K_STATIC_ARRAY = 280,          /* K_STATIC_ARRAY  */
+    K_SIZE_OF = 281,               /* K_SIZE_OF  */
+    K_EXTERN = 282,                /* K_EXTERN  */
+    K_A_PAREN = 283,               /* K_A_PAREN  */
+    O_PLUS = 284,                  /* O_PLUS  */
+    O_MINUS = 285,                 /* O_MINUS  */
+    O_MUL = 286,                   /* O_MUL  */
+    O_DIV = 287,                   /* O_DIV  */
+    O_MOD = 288,                   /* O_MOD  */
+    O_EQ = 289,                    /* O_EQ  */
+    O_NEQ = 290,                   /* O_NEQ  */
+    O_GT = 291,                    /* O_GT  */
+    O_LT = 292,                    /* O_LT  */
+    O_GTE = 293,                   /* O_GTE  */
+    O_LTE = 294,                   /* O_LTE  */
+    O_LAND = 295,                  /* O_LAND  */
+    O_LOR = 296,                   /* O_LOR  */
+    O_SET = 297,                   /* O_SET  */
+    O_DOT = 298,                   /* O_DOT  */
+    O_ACCESS = 299,                /* O_ACCESS  */
+    O_INC = 300,                   /* O_INC  */
+    O_DEC = 301,                   /* O_DEC  */
+    O_METHOD_CALL = 302,           /* O_METHOD_CALL  */
+    O_IMPLICIT_CAST = 303,         /* O_IMPLICIT_CAST  */
+    O_EXPLICIT_CAST = 304,         /* O_EXPLICIT_CAST  */
+    K_YIELD = 305,                 /* K_YIELD  */
+    ACCESS_PREC = 306,             /* ACCESS_PREC  */
+    NEG = 307,                     /* NEG  */
+    CAST = 308                     /* CAST  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
 
-
+/* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE
+union YYSTYPE
 {
-/* Line 2058 of yacc.c  */
 #line 86 "bs.y"
 
     int    token;
     int    integerValue;
     float  floatValue;
-    char*  identifierText;
+    const char*  identifierText;
     Pegasus::BlockScript::StackFrameInfo*      vFrameInfo;
     Pegasus::BlockScript::TypeDesc*            vTypeDesc;
     Pegasus::BlockScript::EnumNode*            vEnumNode;
@@ -117,28 +126,18 @@ typedef union YYSTYPE
     #include "Pegasus/BlockScript/Ast.inl"
     #undef BS_PROCESS
 
+#line 130 "bs.parser.hpp"
 
-/* Line 2058 of yacc.c  */
-#line 123 "bs.parser.hpp"
-} YYSTYPE;
+};
+typedef union YYSTYPE YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
 # define YYSTYPE_IS_DECLARED 1
 #endif
 
 
-#ifdef YYPARSE_PARAM
-#if defined __STDC__ || defined __cplusplus
-int BS_parse (void *YYPARSE_PARAM);
-#else
-int BS_parse ();
-#endif
-#else /* ! YYPARSE_PARAM */
-#if defined __STDC__ || defined __cplusplus
+
+
 int BS_parse (void* scanner);
-#else
-int BS_parse ();
-#endif
-#endif /* ! YYPARSE_PARAM */
+
 
 #endif /* !YY_BS_BS_PARSER_HPP_INCLUDED  */
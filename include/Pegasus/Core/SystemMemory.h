@@ -0,0 +1,42 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                       Pegasus                                        */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file	SystemMemory.h
+//! \author	agent
+//! \date	16th October 2026
+//! \brief	Memory taken directly from the operating system, bypassing the C runtime heap
+
+#ifndef PEGASUS_CORE_SYSTEMMEMORY_H
+#define PEGASUS_CORE_SYSTEMMEMORY_H
+
+#include <stddef.h>
+
+//! Alignment of the memory taken from the system, the allocation granularity of Windows
+#define PG_SYSTEM_MEMORY_ALIGNMENT (64 * 1024)
+
+namespace Pegasus {
+namespace Core {
+
+
+//! Allocates memory from the system
+//! \param byteSize Size of the memory, rounded up to the system pages
+//! \return Memory filled with zeros and aligned to PG_SYSTEM_MEMORY_ALIGNMENT, nullptr if out of memory
+void* AllocSystemMemory(size_t byteSize);
+
+//! Gives memory back to the system
+//! \param memory Memory returned by \a AllocSystemMemory()
+//! \param byteSize Size the memory was allocated with
+void FreeSystemMemory(void* memory, size_t byteSize);
+
+//! Get the largest memory the process held in physical memory so far
+//! \return Peak resident memory of the process, in bytes
+size_t GetPeakResidentByteSize();
+
+
+}   // namespace Core
+}   // namespace Pegasus
+
+#endif  // PEGASUS_CORE_SYSTEMMEMORY_H
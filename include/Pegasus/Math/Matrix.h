@@ -146,19 +146,19 @@ Mat44
         : m11(1.0f), m12(0.0f), m13(0.0f), m14(0.0f),
           m21(0.0f), m22(1.0f), m23(0.0f), m24(0.0f),
           m31(0.0f), m32(0.0f), m33(1.0f), m34(0.0f),
-          m41(0.0f), m42(0.0f), m43(0.0f), m44(1.0f) { };
+          m41(0.0f), m42(0.0f), m43(0.0f), m44(1.0f) { PG_MATH_CHECK_SIMD_ALIGNMENT(this); };
 
     Mat44(const Mat44 & m)            //!< Copy constructor
         : m11(m.m11), m12(m.m12), m13(m.m13), m14(m.m14),
           m21(m.m21), m22(m.m22), m23(m.m23), m24(m.m24),
           m31(m.m31), m32(m.m32), m33(m.m33), m34(m.m34),
-          m41(m.m41), m42(m.m42), m43(m.m43), m44(m.m44) { };
+          m41(m.m41), m42(m.m42), m43(m.m43), m44(m.m44) { PG_MATH_CHECK_SIMD_ALIGNMENT(this); };
 
     Mat44(const PFloat32 m[16])            //!< Constructor with an array (row-major)
         : m11(m[0 ]), m12(m[1 ]), m13(m[2 ]), m14(m[3 ]),
           m21(m[4 ]), m22(m[5 ]), m23(m[6 ]), m24(m[7 ]),
           m31(m[8 ]), m32(m[9 ]), m33(m[10]), m34(m[11]),
-          m41(m[12]), m42(m[13]), m43(m[14]), m44(m[15]) { };
+          m41(m[12]), m42(m[13]), m43(m[14]), m44(m[15]) { PG_MATH_CHECK_SIMD_ALIGNMENT(this); };
 
     Mat44(const Vec4 & v1,            //!< Constructor with vectors (columns)
           const Vec4 & v2,
@@ -167,7 +167,7 @@ Mat44
         : m11(v1.x), m12(v2.x), m13(v3.x), m14(v4.x),
           m21(v1.y), m22(v2.y), m23(v3.y), m24(v4.y),
           m31(v1.z), m32(v2.z), m33(v3.z), m34(v4.z),
-          m41(v1.w), m42(v2.w), m43(v3.w), m44(v4.w) { };
+          m41(v1.w), m42(v2.w), m43(v3.w), m44(v4.w) { PG_MATH_CHECK_SIMD_ALIGNMENT(this); };
 
     Mat44(PFloat32 m11, PFloat32 m12, PFloat32 m13, PFloat32 m14,    //!< Constructor
           PFloat32 m21, PFloat32 m22, PFloat32 m23, PFloat32 m24,    //!< with scalars
@@ -176,7 +176,7 @@ Mat44
         : m11(m11), m12(m12), m13(m13), m14(m14),
           m21(m21), m22(m22), m23(m23), m24(m24),
           m31(m31), m32(m32), m33(m33), m34(m34),
-          m41(m41), m42(m42), m43(m43), m44(m44) { };
+          m41(m41), m42(m42), m43(m43), m44(m44) { PG_MATH_CHECK_SIMD_ALIGNMENT(this); };
 
     Mat44(PFloat32 s)                    //!< Constructor with one scalar (identity
                                             //!< matrix multiplied by this scalar,
@@ -184,21 +184,21 @@ Mat44
         : m11(s   ), m12(0.0f), m13(0.0f), m14(0.0f),
           m21(0.0f), m22(s),    m23(0.0f), m24(0.0f),
           m31(0.0f), m32(0.0f), m33(s)   , m34(0.0f),
-          m41(0.0f), m42(0.0f), m43(0.0f), m44(1.0f) { };
+          m41(0.0f), m42(0.0f), m43(0.0f), m44(1.0f) { PG_MATH_CHECK_SIMD_ALIGNMENT(this); };
 
     Mat44(Mat22In m)            //!< Constructor that copies the upper left
                                             //!< corner and fills with the identity matrix
         : m11(m.m11), m12(m.m12), m13(0.0f ), m14(0.0f),
           m21(m.m21), m22(m.m22), m23(0.0f ), m24(0.0f),
           m31(0.0f ), m32(0.0f ), m33(1.0f ), m34(0.0f),
-          m41(0.0f ), m42(0.0f ), m43(0.0f ), m44(1.0f) { };
+          m41(0.0f ), m42(0.0f ), m43(0.0f ), m44(1.0f) { PG_MATH_CHECK_SIMD_ALIGNMENT(this); };
 
     Mat44(Mat33In m)            //!< Constructor that copies the upper left
                                             //!< corner and fills with the identity matrix
         : m11(m.m11), m12(m.m12), m13(m.m13), m14(0.0f),
           m21(m.m21), m22(m.m22), m23(m.m23), m24(0.0f),
           m31(m.m31), m32(m.m32), m33(m.m33), m34(0.0f),
-          m41(0.0f ), m42(0.0f ), m43(0.0f ), m44(1.0f) { };
+          m41(0.0f ), m42(0.0f ), m43(0.0f ), m44(1.0f) { PG_MATH_CHECK_SIMD_ALIGNMENT(this); };
 };
 
 //----------------------------------------------------------------------------------------
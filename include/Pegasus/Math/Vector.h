@@ -14,6 +14,27 @@
 
 #include "Pegasus/Math/Scalar.h"
 
+//! Vec4 and Mat44 are not declared 16 byte aligned, and the SSE code reads them with unaligned loads.
+//! Aligning them would pad StdVertex past its 36 byte vertex layout, break the blockscript vm which packs
+//! them in native call arguments and struct members, and break 32 bit MSVC which rejects aligned types
+//! passed by value.
+
+//! Detailed assert builds check at construction that Vec4 and Mat44 are 16 byte aligned, which flags the
+//! ones placed in memory that ignores the default alignment (raw buffers, allocators not honouring it).
+//! On by default on 64 bit platforms, whose stack is 16 byte aligned. Off on 32 bit platforms, where
+//! locals are only 4 byte aligned.
+#ifndef PEGASUS_MATH_CHECK_SIMD_ALIGNMENT
+#define PEGASUS_MATH_CHECK_SIMD_ALIGNMENT PEGASUS_POINTERSIZE_64BIT
+#endif
+
+//! Asserts that a SIMD math type is constructed at a 16 byte aligned address
+#if PEGASUS_MATH_CHECK_SIMD_ALIGNMENT && PEGASUS_ENABLE_DETAILED_ASSERT
+#include "Pegasus/Core/Assertion.h"
+#define PG_MATH_CHECK_SIMD_ALIGNMENT(ptr) PG_ASSERTSTR((reinterpret_cast<size_t>(ptr) & 15) == 0, "SIMD math type constructed at misaligned address %p.", static_cast<const void*>(ptr))
+#else
+#define PG_MATH_CHECK_SIMD_ALIGNMENT(ptr)
+#endif
+
 namespace Pegasus {
 namespace Math {
 
@@ -207,43 +228,43 @@ Vec4
     //struct { PFloat32 red; Vec3 gba;    };    //!< Colors
 
     Vec4()                                                  //!< Default constructor
-        : x(0.0f), y(0.0f), z(0.0f), w(0.0f) { };
+        : x(0.0f), y(0.0f), z(0.0f), w(0.0f) { PG_MATH_CHECK_SIMD_ALIGNMENT(this); };
 
     Vec4(const Vec4 & v)                                    //!< Copy constructor
-        : x(v.x), y(v.y), z(v.z), w(v.w) { };
+        : x(v.x), y(v.y), z(v.z), w(v.w) { PG_MATH_CHECK_SIMD_ALIGNMENT(this); };
 
     Vec4(const PFloat32 v[4])                               //!< Constructor with an array
-        : x(v[0]), y(v[1]), z(v[2]), w(v[3]) { };
+        : x(v[0]), y(v[1]), z(v[2]), w(v[3]) { PG_MATH_CHECK_SIMD_ALIGNMENT(this); };
 
     Vec4(PFloat32 x, PFloat32 y, PFloat32 z, PFloat32 w)    //!< Constructor with scalars
-        : x(x), y(y), z(z), w(w) { };
+        : x(x), y(y), z(z), w(w) { PG_MATH_CHECK_SIMD_ALIGNMENT(this); };
 
     Vec4(const Vec2 & xy, const Vec2 & zw)                  //!< Mixed constructor
-        : x(xy.x), y(xy.y), z(zw.x), w(zw.y) { };
+        : x(xy.x), y(xy.y), z(zw.x), w(zw.y) { PG_MATH_CHECK_SIMD_ALIGNMENT(this); };
 
     Vec4(const PFloat32 xy[2], const PFloat32 zw[2])        //!< Mixed constructor
-        : x(xy[0]), y(xy[1]), z(zw[0]), w(zw[1]) { };
+        : x(xy[0]), y(xy[1]), z(zw[0]), w(zw[1]) { PG_MATH_CHECK_SIMD_ALIGNMENT(this); };
 
     Vec4(PFloat32 x, const Vec2 & yz, PFloat32 w)           //!< Mixed constructor
-        : x(x), y(yz.x), z(yz.y), w(w) { };
+        : x(x), y(yz.x), z(yz.y), w(w) { PG_MATH_CHECK_SIMD_ALIGNMENT(this); };
 
     Vec4(PFloat32 x, const PFloat32 yz[2], PFloat32 w)      //!< Mixed constructor
-        : x(x), y(yz[0]), z(yz[1]), w(w) { };
+        : x(x), y(yz[0]), z(yz[1]), w(w) { PG_MATH_CHECK_SIMD_ALIGNMENT(this); };
 
     Vec4(const Vec3 & xyz, PFloat32 w)                      //!< Mixed constructor
-        : x(xyz.x), y(xyz.y), z(xyz.z), w(w) { };
+        : x(xyz.x), y(xyz.y), z(xyz.z), w(w) { PG_MATH_CHECK_SIMD_ALIGNMENT(this); };
 
     Vec4(const PFloat32 xyz[3], PFloat32 w)                 //!< Mixed constructor
-        : x(xyz[0]), y(xyz[1]), z(xyz[2]), w(w) { };
+        : x(xyz[0]), y(xyz[1]), z(xyz[2]), w(w) { PG_MATH_CHECK_SIMD_ALIGNMENT(this); };
 
     Vec4(PFloat32 x, const Vec3 & yzw)                      //!< Mixed constructor
-        : x(x), y(yzw.x), z(yzw.y), w(yzw.z) { };
+        : x(x), y(yzw.x), z(yzw.y), w(yzw.z) { PG_MATH_CHECK_SIMD_ALIGNMENT(this); };
 
     Vec4(PFloat32 x, const PFloat32 yzw[3])                 //!< Mixed constructor
-        : x(x), y(yzw[0]), z(yzw[1]), w(yzw[2]) { };
+        : x(x), y(yzw[0]), z(yzw[1]), w(yzw[2]) { PG_MATH_CHECK_SIMD_ALIGNMENT(this); };
 
     Vec4(PFloat32 s)                                        //!< Constructor with one scalar
-        : x(s), y(s), z(s), w(s) { };
+        : x(s), y(s), z(s), w(s) { PG_MATH_CHECK_SIMD_ALIGNMENT(this); };
 };
 
 //----------------------------------------------------------------------------------------
@@ -1099,32 +1120,26 @@ inline void Swap(Vec4InOut vec1, Vec4InOut vec2)
 //! \param v2 Second vector (for t = 1)
 //! \param t Interpolation coefficient (between 0 and 1 to be valid,
 //!          extrapolation occurs if outside these bounds)
-//! \return Linear interpolation of v1 and v2 (= (1-t)*v1 + t*v2)
+//! \return Linear interpolation of v1 and v2 (= v1 + t*(v2-v1), like the scalar Lerp)
 inline Vec2Return Lerp(Vec2In v1, Vec2In v2, PFloat32 t)
     {
-        //! \todo Use a different equation to reduce the number of operations?
-        const PFloat32 oneMinusT = 1.0f - t;
-        return Vec2(oneMinusT * v1.x + t * v2.x,
-                    oneMinusT * v1.y + t * v2.y);
+        return Vec2(v1.x + t * (v2.x - v1.x),
+                    v1.y + t * (v2.y - v1.y));
     }
 
 inline Vec3Return Lerp(Vec3In v1, Vec3In v2, PFloat32 t)
     {
-        //! \todo Use a different equation to reduce the number of operations?
-        const PFloat32 oneMinusT = 1.0f - t;
-        return Vec3(oneMinusT * v1.x + t * v2.x,
-                    oneMinusT * v1.y + t * v2.y,
-                    oneMinusT * v1.z + t * v2.z);
+        return Vec3(v1.x + t * (v2.x - v1.x),
+                    v1.y + t * (v2.y - v1.y),
+                    v1.z + t * (v2.z - v1.z));
     }
 
 inline Vec4Return Lerp(Vec4In v1, Vec4In v2, PFloat32 t)
     {
-        //! \todo Use a different equation to reduce the number of operations?
-        const PFloat32 oneMinusT = 1.0f - t;
-        return Vec4(oneMinusT * v1.x + t * v2.x,
-                    oneMinusT * v1.y + t * v2.y,
-                    oneMinusT * v1.z + t * v2.z,
-                    oneMinusT * v1.w + t * v2.w);
+        return Vec4(v1.x + t * (v2.x - v1.x),
+                    v1.y + t * (v2.y - v1.y),
+                    v1.z + t * (v2.z - v1.z),
+                    v1.w + t * (v2.w - v1.w));
     }
 //@}
 
@@ -50,9 +50,10 @@ public:
             unsigned int line = 0
     );
 
-    //! Allocate a block of memory, aligned
+    //! Allocate a block of memory, aligned. Alloc packs the blocks one after the other (containers index them),
+    //! so only the blocks allocated with this function are aligned.
     //! \param Size of the allocation, in bytes.
-    //! \param align Allocation alignment, in bytes.
+    //! \param align Allocation alignment, in bytes. A power of two.
     //! \param flags Allocation flags.
     //! \param category Allocation category.
     //! \param debugText Debug name for this allocation.
@@ -74,6 +75,9 @@ public:
     //! \param ptr Address of the memory.
     virtual void Delete(void* ptr);
 
+    //! \return 1, Alloc packs the blocks. Arrays of aligned types go through AllocAlign
+    virtual Alloc::Alignment GetAlignment() const { return 1; }
+
     //! Resets the memory counter, but does not destroy the allocated memory. Use this for iteration on recompilation of block scripts
     void Reset();
 
@@ -97,6 +101,9 @@ public:
 
     int GetPageSize() const { return mPageSize; }
 
+    //! \return true if ptr points inside one of the pages of this allocator
+    bool Owns(const void* ptr) const;
+
 private:
     static const int sPageIncrement; 
 
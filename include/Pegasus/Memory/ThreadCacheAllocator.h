@@ -0,0 +1,117 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                       Pegasus                                        */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file   ThreadCacheAllocator.h
+//! \author agent
+//! \date   16th October 2026
+//! \brief  Allocator with a cache per thread, for small allocations made from many threads.
+
+#ifndef PEGASUS_MEMORY_THREADCACHEALLOCATOR_H
+#define PEGASUS_MEMORY_THREADCACHEALLOCATOR_H
+
+#include "Pegasus/Allocator/IAllocator.h"
+#include <atomic>
+#include <mutex>
+
+//! size of the slab pages, a power of two. Pages are aligned to their size, so the page of a block
+//! is found by masking its address
+#define PG_THREAD_CACHE_PAGE_BYTESIZE (64 * 1024)
+
+//! largest allocation served from the slab pages, the bigger ones are allocated from the system
+#define PG_THREAD_CACHE_MAX_SMALL_BYTESIZE 8192
+
+//! number of thread cache allocators alive at the same time
+#define PG_THREAD_CACHE_MAX_ALLOCATORS 16
+
+namespace Pegasus {
+namespace Memory {
+
+//! Allocator handing out blocks of a few size classes from slab pages owned by the calling thread.
+//! Every thread allocating gets its own heap, so allocations and frees on the same thread take no lock.
+//! A block freed by another thread than its owner is pushed on a lock free list of its page, which
+//! the owner takes back the next time it runs out of blocks of that size.
+//! Empty pages go back to a pool shared by the threads and reused by any size class, which bounds
+//! the memory lost to fragmentation to a few pages per thread and size class.
+//! The heap of a thread that exits is adopted by the next thread allocating.
+//! \note Allocations above PG_THREAD_CACHE_MAX_SMALL_BYTESIZE are allocated from the system, aligned to the pages.
+class ThreadCacheAllocator : public Alloc::IAllocator
+{
+public:
+    //! Constructor
+    //! \param allocId ID to use for this allocator.  Should be "Unique"
+    ThreadCacheAllocator(unsigned int allocId);
+
+    //! Destructor, releases every page and large block. Blocks still allocated become invalid.
+    virtual ~ThreadCacheAllocator();
+
+
+    // IAllocator interface
+    virtual void* Alloc(size_t size, Alloc::Flags flags, Alloc::Category category = -1, const char* debugText = nullptr, const char* file = nullptr, unsigned int line = 0);
+    virtual void* AllocAlign(size_t size, Alloc::Alignment align, Alloc::Flags flags, Alloc::Category category = -1, const char* debugText = nullptr, const char* file = nullptr, unsigned int line = 0);
+    virtual void Delete(void* ptr);
+
+    //! \return the memory taken from the system, in bytes
+    size_t GetReservedByteSize() const { return mReservedByteSize.load(std::memory_order_relaxed); }
+
+    //! \return the largest memory taken from the system at once, in bytes
+    size_t GetPeakReservedByteSize() const { return mPeakReservedByteSize.load(std::memory_order_relaxed); }
+
+    // Internal structures, defined in the implementation
+    struct Page;
+    struct Chunk;
+    struct ThreadHeap;
+
+private:
+    // No copies allowed
+    PG_DISABLE_COPY(ThreadCacheAllocator);
+
+    friend struct ThreadHeapTable;
+
+    //! \return the heap of the calling thread, null if it has none yet
+    ThreadHeap* FindThreadHeap() const;
+
+    //! \return the heap of the calling thread, created or adopted on its first allocation
+    ThreadHeap* GetThreadHeap();
+
+    //! Gives up the heap of a thread that exits, for the next thread to adopt it
+    void AbandonThreadHeap(ThreadHeap* heap);
+
+    //! Allocates a block once the current page of its size class is full
+    void* AllocSlow(ThreadHeap* heap, unsigned int sizeClass);
+
+    //! Allocates a block directly from the system, with a page header in front of it
+    void* AllocLarge(size_t size, Alloc::Alignment align);
+
+    //! Gives a large block back to the system, once unlinked from the large blocks
+    void FreeLarge(Page* page);
+
+    //! \return an empty page, from the heap, the shared pool or a new chunk
+    Page* AcquirePage(ThreadHeap* heap);
+
+    //! Gives back an empty page of a heap
+    void ReleasePage(ThreadHeap* heap, Page* page);
+
+    //! Counts memory taken from the system
+    void AddReservedByteSize(size_t byteSize);
+
+    unsigned int mAllocId;                //!< "Unique" allocator ID
+    unsigned int mSlot;                   //!< index of the heap of this allocator in the table of each thread
+    unsigned int mUniqueId;               //!< never reused, tells the table entries of a destroyed allocator apart
+    const unsigned char* mClassOfSize;    //!< size class of each size, in steps of 16 bytes
+    std::mutex mLock;                     //!< guards the heaps, the chunks, the shared page pool and the large blocks
+    ThreadHeap* mHeaps;                   //!< every heap created, owned or abandoned
+    Chunk* mChunks;                       //!< memory the pages are carved from
+    Page* mFreePages;                     //!< empty pages shared by the threads
+    Page* mLargePages;                    //!< large blocks alive, released by the destructor
+    std::atomic<size_t> mReservedByteSize;
+    std::atomic<size_t> mPeakReservedByteSize;
+};
+
+
+}   // namespace Memory
+}   // namespace Pegasus
+
+#endif  // PEGASUS_MEMORY_THREADCACHEALLOCATOR_H
@@ -347,4 +347,9 @@
 // Enable blockscript safe mode, where invalid memory access will get reported, at the cost of performance.
 #define BLOCKSCRIPT_SAFEMODE PEGASUS_DEV
 
+// Enable the blockscript jit, compiling hot script functions to x86-64 machine code (see BsJit.h).
+#ifndef BLOCKSCRIPT_JIT
+#define BLOCKSCRIPT_JIT 0
+#endif
+
 #endif  // PEGASUS_PREPROCESSOR_H
@@ -15,6 +15,7 @@
 #if PEGASUS_ENABLE_PROXIES
 
 #include "Pegasus/Timeline/Shared/IBlockProxy.h"
+#include "Pegasus/Timeline/Proxy/ScriptProfilerProxy.h"
 #include "Pegasus/PropertyGrid/Shared/IPropertyGridObjectProxy.h"
 
 namespace Pegasus {
@@ -153,6 +154,10 @@ public:
     //! Clears blockscript if there is one.
     virtual void ClearScript();
 
+    //! Gets the profiler of the script
+    //! \return the script profiler proxy
+    virtual IScriptProfilerProxy* GetScriptProfiler() { return &mScriptProfilerProxy; }
+
     //! dumps the contents of a block to a single asset.
     //! Note- this is only supported for the use case of Undo/Redo, which serializes the entire state of an object as json
     //! \param assetProxy target asset to dump state into
@@ -174,6 +179,9 @@ private:
     //! Proxied timeline block object
     Block * const mBlock;
     PropertyFlusherPropertyGridObjectDecorator mPropertyGridDecorator;
+
+    //! Profiler of the script
+    ScriptProfilerProxy mScriptProfilerProxy;
 };
 
 
@@ -0,0 +1,65 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                       Pegasus                                        */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file	ScriptProfilerProxy.h
+//! \author	agent
+//! \date	16th October 2026
+//! \brief	Proxy object, used by the editor to profile the script of a block or a timeline
+
+#ifndef PEGASUS_TIMELINE_PROXY_SCRIPTPROFILERPROXY_H
+#define PEGASUS_TIMELINE_PROXY_SCRIPTPROFILERPROXY_H
+
+#if PEGASUS_ENABLE_PROXIES
+
+#include "Pegasus/Timeline/Shared/IScriptProfilerProxy.h"
+
+namespace Pegasus {
+    namespace Timeline {
+        class TimelineScriptRunner;
+    }
+}
+
+namespace Pegasus {
+namespace Timeline {
+
+
+//! Proxy object, used by the editor to profile the script of a script runner
+class ScriptProfilerProxy : public IScriptProfilerProxy
+{
+public:
+
+    //! Constructor
+    //! \param runner Proxied script runner, cannot be nullptr
+    ScriptProfilerProxy(TimelineScriptRunner * runner);
+
+    //! Destructor
+    virtual ~ScriptProfilerProxy();
+
+    virtual void SetEnabled(bool enabled);
+    virtual bool IsEnabled() const;
+    virtual void Clear();
+    virtual void Update();
+    virtual double GetTotalTime() const;
+    virtual unsigned long long GetInstructionCount() const;
+    virtual int GetFunctionCount() const;
+    virtual void GetFunction(int index, ScriptProfileFunction& function) const;
+    virtual int GetLineCount() const;
+    virtual void GetLine(int index, ScriptProfileLine& line) const;
+    virtual int GetStackCount() const;
+    virtual double GetStack(int index, char* buffer, int bufferSize) const;
+
+private:
+
+    //! Proxied script runner
+    TimelineScriptRunner * const mRunner;
+};
+
+
+}   // namespace Timeline
+}   // namespace Pegasus
+
+#endif  // PEGASUS_ENABLE_PROXIES
+#endif  // PEGASUS_TIMELINE_PROXY_SCRIPTPROFILERPROXY_H
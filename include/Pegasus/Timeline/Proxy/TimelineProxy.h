@@ -138,6 +138,10 @@ public:
     //! Clears blockscript if there is one.
     virtual void ClearScript();
 
+    //! Gets the profiler of the script
+    //! \return the script profiler proxy
+    virtual IScriptProfilerProxy* GetScriptProfiler() { return &mScriptProfilerProxy; }
+
     //! Sets a music file, were the string is the path.
     //! \param musicFileName - the path
     virtual void LoadMusic(const char* musicFileName);
@@ -171,6 +175,9 @@ private:
     // property grid decorator to pass arguments from editor to runtime for live editing
     PropertyFlusherPropertyGridObjectDecorator mPropertyGridDecorator;
 
+    //! Profiler of the script
+    ScriptProfilerProxy mScriptProfilerProxy;
+
 };
 
 
@@ -26,6 +26,7 @@ namespace Pegasus {
     }
     namespace Timeline {
         class ILaneProxy;
+        class IScriptProfilerProxy;
     }
     namespace AssetLib {
         class IAssetProxy;
@@ -99,6 +100,10 @@ public:
     //! Clears blockscript if there is one.
     virtual void ClearScript() = 0;
 
+    //! Gets the profiler of the script
+    //! \return the script profiler proxy
+    virtual IScriptProfilerProxy* GetScriptProfiler() = 0;
+
     //! Returns the guid of this proxy
     virtual unsigned GetGuid() const = 0;
 
@@ -0,0 +1,97 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                       Pegasus                                        */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file	IScriptProfilerProxy.h
+//! \author	agent
+//! \date	16th October 2026
+//! \brief	Proxy interface, used by the editor to profile the script of a block or a timeline
+
+#ifndef PEGASUS_TIMELINE_SHARED_ISCRIPTPROFILERPROXY_H
+#define PEGASUS_TIMELINE_SHARED_ISCRIPTPROFILERPROXY_H
+
+#if PEGASUS_ENABLE_PROXIES
+
+namespace Pegasus {
+namespace Timeline {
+
+//! Flat profile of a script function
+struct ScriptProfileFunction
+{
+    const char*        mName;         //!< name of the function, "<global>" for the global code
+    unsigned long long mCalls;        //!< calls from scripts
+    unsigned long long mInstructions; //!< bytecode instructions executed in the function body
+    double             mSelfTime;     //!< seconds spent in the function body
+    double             mTotalTime;    //!< seconds spent in the function and its callees
+};
+
+//! Flat profile of a script source line
+struct ScriptProfileLine
+{
+    const char*        mName;         //!< name of the function owning the line
+    int                mLine;         //!< source line, 1 based. 0 if unknown
+    unsigned long long mInstructions; //!< bytecode instructions executed
+    double             mTime;         //!< seconds spent
+};
+
+//! Proxy interface, used by the editor to profile the script of a block or a timeline.
+//! The results are a snapshot taken by the last call to Update.
+class IScriptProfilerProxy
+{
+public:
+
+    //! Destructor
+    virtual ~IScriptProfilerProxy() {};
+
+    //! Starts or stops recording. Recorded results are kept when stopping
+    //! \param enabled true to start recording
+    virtual void SetEnabled(bool enabled) = 0;
+
+    //! \return true if the script is being recorded
+    virtual bool IsEnabled() const = 0;
+
+    //! Drops everything recorded
+    virtual void Clear() = 0;
+
+    //! Takes a snapshot of the results recorded so far
+    virtual void Update() = 0;
+
+    //! \return the seconds spent running the script
+    virtual double GetTotalTime() const = 0;
+
+    //! \return the number of bytecode instructions executed
+    virtual unsigned long long GetInstructionCount() const = 0;
+
+    //! \return the number of functions in the snapshot, sorted by self time
+    virtual int GetFunctionCount() const = 0;
+
+    //! \param index index of the function, from 0 to GetFunctionCount() - 1
+    //! \param function output profile of the function
+    virtual void GetFunction(int index, ScriptProfileFunction& function) const = 0;
+
+    //! \return the number of source lines in the snapshot, sorted by time
+    virtual int GetLineCount() const = 0;
+
+    //! \param index index of the line, from 0 to GetLineCount() - 1
+    //! \param line output profile of the line
+    virtual void GetLine(int index, ScriptProfileLine& line) const = 0;
+
+    //! \return the number of distinct call stacks sampled
+    virtual int GetStackCount() const = 0;
+
+    //! Gets a call stack in the collapsed format of flame graphs: function names, outermost first, separated by ';'
+    //! \param index index of the stack, from 0 to GetStackCount() - 1
+    //! \param buffer output string, truncated to bufferSize
+    //! \param bufferSize size of the buffer in bytes
+    //! \return the seconds spent in this stack
+    virtual double GetStack(int index, char* buffer, int bufferSize) const = 0;
+};
+
+
+}   // namespace Timeline
+}   // namespace Pegasus
+
+#endif  // PEGASUS_ENABLE_PROXIES
+#endif  // PEGASUS_TIMELINE_SHARED_ISCRIPTPROFILERPROXY_H
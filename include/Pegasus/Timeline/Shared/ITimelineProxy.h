@@ -21,6 +21,7 @@ namespace Pegasus {
     namespace Timeline {
         class ILaneProxy;
         class IBlockProxy;
+        class IScriptProfilerProxy;
     }
 
     namespace Core {
@@ -125,6 +126,10 @@ public:
     //! Clears blockscript if there is one.
     virtual void ClearScript() = 0;
 
+    //! Gets the profiler of the script
+    //! \return the script profiler proxy
+    virtual IScriptProfilerProxy* GetScriptProfiler() = 0;
+
     //! Gets a block from a guid. 
     //! \param blockGuid the guid to query this block from
     //! \return the block proxy if found, nullptr otherwise
@@ -18,6 +18,7 @@
 #include "Pegasus/Timeline/Timeline.h"
 #include "Pegasus/Timeline/TimelineScript.h"
 #include "Pegasus/AssetLib/AssetRuntimeFactory.h"
+#include <mutex>
 
 namespace Pegasus {
 
@@ -190,6 +191,20 @@ public:
     //! \return the timeline script reference
     TimelineScriptReturn CreateScript();
 
+    //! Compiles a batch of scripts concurrently, on worker threads. Scripts that are not dirty are skipped.
+    //! Headers are loaded and compilation events dispatched by one script at a time, the rest of the
+    //! compilations run in parallel. Observers of the scripts are notified from the calling thread.
+    //! \param scripts the scripts to compile
+    //! \param count the number of scripts
+    void CompileScripts(TimelineScript* const* scripts, unsigned int count);
+
+    //! Sets the number of worker threads of CompileScripts
+    //! \param threadCount the number of threads, 0 for one per hardware thread
+    void SetCompileThreadCount(unsigned int threadCount) { mCompileThreadCount = threadCount; }
+
+    //! \return the number of worker threads of CompileScripts, 0 for one per hardware thread
+    unsigned int GetCompileThreadCount() const { return mCompileThreadCount; }
+
     //! Creates a new script header file.
     //! \return the timeline script reference
     TimelineSourceReturn CreateHeader();
@@ -300,6 +315,12 @@ private:
     Utils::Vector<BlockScript::BlockLib*> mExtraLibs;
 
     BlockScript::BlockLib* mTimelineLib;
+
+    //! number of worker threads compiling a batch of scripts, 0 for one per hardware thread
+    unsigned int mCompileThreadCount;
+
+    //! lock of what the scripts of a batch share while compiling
+    std::mutex mCompileLock;
     
 };
 
@@ -20,6 +20,7 @@
 #include "Pegasus/Core/Io.h"
 #include "Pegasus/Core/Ref.h"
 #include "Pegasus/AssetLib/RuntimeAssetObject.h"
+#include <mutex>
 
 #if PEGASUS_ENABLE_PROXIES
 #include "Pegasus/Timeline/Proxy/TimelineScriptProxy.h"
@@ -63,6 +64,11 @@ public:
     virtual void OnCompilationBegin() = 0; 
 
     virtual void OnCompilationEnd() = 0; 
+
+    //! Called instead of OnCompilationBegin / OnCompilationEnd when a live edit only changed functions.
+    //! The globals are laid out and initialized as before, so the states of the script can keep running once rebound.
+    //! \param previous the compilation the states ran on until now, destroyed when this call returns
+    virtual void OnFunctionsReloaded(BlockScript::BlockScript* previous) = 0;
 };
 #endif
 
@@ -88,7 +94,8 @@ public:
     //! Calls the script once, to call anything executing in the global scope
     //! \param state the state containing definitions
     //! \param propertyGrid the property grid that will fill in the state / or synchronize the state of this block
-    void CallGlobalScopeInit(BlockScript::BsVmState* state);
+    //! \param budget number of jumps / calls allowed before the global scope is suspended, -1 for no limit
+    void CallGlobalScopeInit(BlockScript::BsVmState* state, int budget = -1);
 
     //! Calls the destruction of a script
     void CallGlobalScopeDestroy(BlockScript::BsVmState* state);
@@ -98,12 +105,33 @@ public:
     //! set the version to a new one.
     //! \param update information.
     //! \param state virtual machine state.
-    void CallUpdate(const UpdateInfo& updateInfo, BlockScript::BsVmState* state);
+    //! \param budget number of jumps / calls allowed before the update is suspended, -1 for no limit
+    void CallUpdate(const UpdateInfo& updateInfo, BlockScript::BsVmState* state, int budget = -1);
+
+    //! Resumes the global scope or the update suspended on a state, by a yield statement or by running out of budget
+    //! \param state virtual machine state.
+    //! \param budget number of jumps / calls allowed before the execution is suspended again, -1 for no limit
+    void Resume(BlockScript::BsVmState* state, int budget = -1);
+
+    //! Drops the execution suspended on a state. The frames of a suspended update are unwound, a suspended
+    //! global scope resets the state.
+    //! \param state virtual machine state.
+    void Cancel(BlockScript::BsVmState* state);
 
     //! Call before update, this will reveal if the internal asset has changed. If so, the script gets recompiled, and
     //! the serial version is incremented.
     virtual void Compile();
 
+    //! Compiles the script if it is dirty, from a worker thread of a batch (see TimelineManager::CompileScripts).
+    //! Observers are not notified, the batch notifies them from the thread that started it.
+    //! \param sharedLock lock held while the script touches what the scripts of the batch share:
+    //!        the headers, the asset library and the compilation events
+    void CompileFromBatch(std::mutex& sharedLock);
+
+    //! Notifies the compilation observers. Compile does it around every compilation.
+    //! \param begin true when a compilation begins, false when it ends
+    void NotifyCompilationObservers(bool begin);
+
     //! Calls render on the script. If scripts does not implement Render, then this is a NOP
     //! \param render information used.
     //! \param state the virtual machine state.
@@ -173,11 +201,29 @@ private:
     //! \return true if successful, false otherwise
     bool CompileInternal();
 
+    //! Compiles the opened file into a block script
+    //! \param script the block script, reset
+    //! \param bindPoints output, the bind points of the script. Untouched if the compilation fails.
+    //! \return true if successful, false otherwise
+    bool CompileScript(BlockScript::BlockScript* script, BlockScript::FunBindPoint* bindPoints);
+
+    //! \return a new block script including the timeline libraries
+    BlockScript::BlockScript* CreateScript();
+
+#if PEGASUS_ENABLE_PROXIES
+    //! Recompiles an active script being edited. The new compilation replaces the running one once done:
+    //! if only functions changed the observers keep their states, otherwise they start over.
+    void HotReload();
+#endif
+
     void ClearBindPoints();
 
     //! internal script structure
     BlockScript::BlockScript* mScript;
 
+    //! script live edits are compiled into, swapped with mScript once compiled. Null until the first live edit
+    BlockScript::BlockScript* mReloadScript;
+
     //! status of last IO operation
     Io::IoError mIoStatus;
 
@@ -195,7 +241,7 @@ private:
     };
     //@}
 
-    void CallFunction(BlockScript::BsVmState* state, BindPoint funct, const void* inputBuffer, unsigned inputBufferSz, void* outputBuffer, unsigned outputBufferSz);
+    void CallFunction(BlockScript::BsVmState* state, BindPoint funct, const void* inputBuffer, unsigned inputBufferSz, void* outputBuffer, unsigned outputBufferSz, int budget = -1);
     bool IsValidBindPoint(BindPoint bp) const { return mScriptActive && mBindPoints[bp] != Pegasus::BlockScript::FUN_INVALID_BIND_POINT; }
 
     //! Set that contains bind points
@@ -220,6 +266,9 @@ private:
     //! list of headers
     Utils::Vector<TimelineSourceRef> mHeaders;
 
+    //! lock of the batch compiling this script, null when it is not compiled from a batch
+    std::mutex* mBatchLock;
+
 #if PEGASUS_ENABLE_PROXIES
     Utils::Vector<ITimelineObserver*> mCompilationObservers;
 #endif
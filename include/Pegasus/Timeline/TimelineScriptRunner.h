@@ -20,6 +20,7 @@
 #include "Pegasus/PropertyGrid/PropertyGridObject.h"
 #include "Pegasus/Timeline/BlockRuntimeScriptListener.h"
 #include "Pegasus/Application/RenderCollection.h"
+#include "Pegasus/Utils/Vector.h"
 
 namespace Pegasus {
 
@@ -38,6 +39,8 @@ namespace Pegasus {
     namespace BlockScript {
         class BlockScript;
         class BlockScriptManager;
+        class BsProfiler;
+        class BsVmSnapshot;
     }
 
     namespace PropertyGrid {
@@ -110,6 +113,18 @@ public:
     //! \param windowIndex - index of the window to destroy.
     void CallWindowDestroyed(int windowIndex);
 
+    //! Sets the time the script can run for on each update. Past it, the global scope or the update gets suspended
+    //! and resumed on the next update, so heavy setup code spreads over several frames. Scripts can also give
+    //! the rest of a frame back with a yield statement. Render and window calls are skipped while the script is suspended.
+    //! \param milliseconds the budget of a frame, 0 for no limit (the default)
+    void SetFrameBudget(float milliseconds) { mFrameBudget = milliseconds; }
+
+    //! \return the time the script can run for on each update in milliseconds, 0 for no limit
+    float GetFrameBudget() const { return mFrameBudget; }
+
+    //! \return true if the script is suspended, waiting for the next update to resume
+    bool IsSuspended() const { return mVmState != nullptr && mVmState->IsSuspended(); }
+
 
     //Gets the property grid that this runner is using to dispatch externs
     PropertyGrid::PropertyGridObject* GetPropertyGrid() { return mPropertyGrid; }
@@ -119,12 +134,57 @@ public:
     //! \param controlReset controls the reset of this global cache. Only one script runner is allowed to do this (the master script).
     void SetGlobalCache(Application::GlobalCache* globalCache, bool controlReset = false) { mGlobalCache = globalCache; mControlGlobalCacheReset = controlReset; }
 
+#if PEGASUS_ENABLE_PROXIES
+    //! Starts or stops profiling the script. The profiler and its results are kept when stopping
+    //! \param enable true to start profiling
+    void EnableProfiler(bool enable);
+
+    //! \return true if the script is being profiled
+    bool IsProfilerEnabled() const { return mProfilerEnabled; }
+
+    //! \return the profiler of this runner, null if profiling was never enabled
+    BlockScript::BsProfiler* GetProfiler() const { return mProfiler; }
+
+    //! Sets how often the state of the script is snapshot while the timeline plays. Seeking backwards restores the
+    //! snapshot nearest to the beat sought, and the update replays from there instead of the script running from its init.
+    //! \param beats number of beats in between snapshots, 0 to disable them
+    void SetSnapshotInterval(float beats);
+
+    //! \return the number of beats in between snapshots, 0 if disabled
+    float GetSnapshotInterval() const { return mSnapshotInterval; }
+
+    //! \return the number of snapshots kept
+    int GetSnapshotCount() const { return static_cast<int>(mSnapshots.GetSize()); }
+
+    //! \return the memory used by the snapshots in bytes
+    int GetSnapshotByteSize() const;
+
+    //! \return the time the last restore of a snapshot took in milliseconds, 0 if none was restored
+    double GetLastRestoreTime() const { return mLastRestoreTime; }
+#endif
+
 protected:
     //! callback from GlobalCache IListener
     virtual void OnGlobalCacheDirty();
 
 private:
 
+    //! Runs the global scope, or resumes it if it is suspended, with the permissions, listener and asset category of the initialization
+    //! \param useAssetCategories true to put the assets loaded in the asset category of this runner
+    void RunGlobalScope(bool useAssetCategories);
+
+    //! Keeps resuming the execution suspended on the state until it is done, it yields or the frame budget runs out
+    void ResumeOnBudget();
+
+    //! Drops the execution suspended on the state. Globals half initialized get initialized again.
+    void CancelExecution();
+
+    //! \return the number of jumps / calls the vm runs in between checks of the frame budget, -1 if there is no budget
+    int GetSliceBudget() const { return mFrameBudget > 0.0f ? FRAME_BUDGET_SLICE : -1; }
+
+    //! number of jumps / calls in between checks of the frame budget
+    static const int FRAME_BUDGET_SLICE = 256;
+
     //! Allocator used for all timeline allocations
     Alloc::IAllocator * mAllocator;
 
@@ -152,6 +212,12 @@ private:
     //! The global cache of this runner
     Application::GlobalCache* mGlobalCache;
 
+    //! time the script can run for on each update in milliseconds, 0 for no limit
+    float mFrameBudget;
+
+    //! time the current update started at, in seconds
+    double mFrameStartTime;
+
 #if PEGASUS_ASSETLIB_ENABLE_CATEGORIES
     AssetLib::Category* mCategory;
 #endif
@@ -165,11 +231,45 @@ private:
         virtual ~BlockScriptObserver(){}
         virtual void OnCompilationBegin(); 
         virtual void OnCompilationEnd(); 
+        virtual void OnFunctionsReloaded(BlockScript::BlockScript* previous);
     private:
         TimelineScriptRunner* mRunner;
     } mBlockScriptObserver;
 
+    //! Keeps the state running on a live edit that only changed functions
+    //! \param previous the compilation the state was set up by
+    void RebindState(BlockScript::BlockScript* previous);
+
     bool mWindowIsInitialized[PEGASUS_MAX_WORLD_WINDOW_COUNT];
+
+    //! profiler of the vm state, created the first time profiling is enabled
+    BlockScript::BsProfiler* mProfiler;
+    bool mProfilerEnabled;
+
+    //! snapshot of the vm state, taken before the update of a beat
+    struct StateSnapshot
+    {
+        float mBeat;
+        BlockScript::BsVmSnapshot* mSnapshot;
+    };
+
+    //! Snapshots the state before the update of a beat, if the last snapshot is older than the interval
+    //! \param beat the beat of the update
+    void CaptureSnapshot(float beat);
+
+    //! Restores the latest snapshot taken at or before a beat. Without one, resets the state
+    //! so the next update initializes the globals again
+    //! \param beat the beat sought
+    void RestoreSnapshot(float beat);
+
+    //! Releases the snapshots, once the globals they hold become stale
+    void ClearSnapshots();
+
+    //! snapshots, sorted by beat
+    Utils::Vector<StateSnapshot> mSnapshots;
+    float mSnapshotInterval;
+    float mLastUpdateBeat;
+    double mLastRestoreTime;
 #endif  // PEGASUS_ENABLE_PROXIES
 };
 
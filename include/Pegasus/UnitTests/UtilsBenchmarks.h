@@ -0,0 +1,41 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                    Pegasus Unit Tests                                */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file   UtilsBenchmarks.h
+//! \author agent
+//! \date   16th October 2026
+//! \brief  Pegasus microbenchmarks for the Utils package
+
+//! ADD HERE YOUR BENCHMARK NAMES
+//! benchmarks print their timings, run them with the -b argument of the unit tests,
+//! or a single one with -b followed by its name
+
+#ifndef PEGASUS_UTILS_BENCHMARKS_H
+#define PEGASUS_UTILS_BENCHMARKS_H
+
+void BENCHMARK_Memcpy();
+
+void BENCHMARK_Memmove();
+
+void BENCHMARK_Memset();
+
+void BENCHMARK_HashMapInts();
+
+void BENCHMARK_HashMapStrings();
+
+void BENCHMARK_VectorPush();
+
+void BENCHMARK_VectorInsert();
+
+void BENCHMARK_VectorDelete();
+
+void BENCHMARK_VectorCopy();
+
+void BENCHMARK_AllocatorMallocFree();
+
+void BENCHMARK_AllocatorThreadCache();
+
+#endif
@@ -21,6 +21,12 @@ bool UNIT_TEST_Memcpy2();
 
 bool UNIT_TEST_Memcpy3();
 
+bool UNIT_TEST_Memcpy4();
+
+bool UNIT_TEST_Memmove1();
+
+bool UNIT_TEST_Memmove2();
+
 bool UNIT_TEST_Memset1();
 
 bool UNIT_TEST_Memset2();
@@ -29,6 +35,10 @@ bool UNIT_TEST_Memset3();
 
 bool UNIT_TEST_Memset4();
 
+bool UNIT_TEST_Memset5();
+
+bool UNIT_TEST_Memset6();
+
 bool UNIT_TEST_Strcmp1();
 
 bool UNIT_TEST_Strcmp2();
@@ -97,6 +107,32 @@ bool UNIT_TEST_Vector1();
 
 bool UNIT_TEST_Vector2();
 
+bool UNIT_TEST_Vector3();
+
+bool UNIT_TEST_Vector4();
+
+bool UNIT_TEST_Vector5();
+
+bool UNIT_TEST_Vector6();
+
+bool UNIT_TEST_HashMap1();
+
+bool UNIT_TEST_HashMap2();
+
+bool UNIT_TEST_HashMap3();
+
+bool UNIT_TEST_HashMap4();
+
+bool UNIT_TEST_HashSet1();
+
+bool UNIT_TEST_ThreadCacheAllocator1();
+
+bool UNIT_TEST_ThreadCacheAllocator2();
+
+bool UNIT_TEST_AllocatorAlignment1();
+
+bool UNIT_TEST_AllocatorAlignment2();
+
 bool UNIT_TEST_ByteStream1();
 
 bool UNIT_TEST_ByteStream2();
@@ -0,0 +1,689 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                       Pegasus                                        */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file   HashMap.h
+//! \author agent
+//! \date   16th October 2026
+//! \brief  Open addressing hash map and hash set
+
+#ifndef PEGASUS_UTILS_HASHMAP_H
+#define PEGASUS_UTILS_HASHMAP_H
+
+#include "Pegasus/Allocator/IAllocator.h"
+#include "Pegasus/Core/Assertion.h"
+#include "Pegasus/Math/Types.h"
+#include "Pegasus/Memory/MemoryManager.h"
+#include "Pegasus/Utils/Simd.h"
+#include "Pegasus/Utils/String.h"
+#include <new>
+#include <utility>
+
+#if PEGASUS_SIMD_X86
+#include <emmintrin.h>
+#endif
+#if PEGASUS_COMPILER_MSVC
+#include <intrin.h>
+#endif
+
+//! number of slots whose control bytes are matched at once
+#define HASH_TABLE_GROUP_WIDTH 16
+
+namespace Pegasus
+{
+
+namespace Alloc
+{
+    class IAllocator;
+}
+
+namespace Utils
+{
+
+//! Hash of a key. Integers and enums are hashed by value, pointers by address.
+//! Specialize it for other key types, the table mixes the bits so the hash does not need to.
+template<class K>
+struct Hash
+{
+    static unsigned int Get(const K& key) { return static_cast<unsigned int>(static_cast<Math::PUInt64>(key) ^ (static_cast<Math::PUInt64>(key) >> 32)); }
+};
+
+template<class T>
+struct Hash<T*>
+{
+    static unsigned int Get(T* key) { return Hash<Math::PUInt64>::Get(reinterpret_cast<Math::PUInt64>(key)); }
+};
+
+//! Strings must be keyed with HashedString, this declaration makes a const char* key fail to compile
+//! instead of hashing the address of the string
+template<>
+struct Hash<const char*>;
+
+//! String key with its hash computed once, when built. Lookups compare the hashes before the strings.
+//! The string is not copied, it must live as long as the key.
+struct HashedString
+{
+    HashedString() : mString(nullptr), mHash(0) {}
+
+    //! Constructor, hashes the string
+    HashedString(const char* str) : mString(str), mHash(HashStr(str)) {}
+
+    //! Constructor, with a hash computed already by HashStr
+    HashedString(const char* str, unsigned int hash) : mString(str), mHash(hash) {}
+
+    bool operator==(const HashedString& other) const { return mHash == other.mHash && !Strcmp(mString, other.mString); }
+
+    const char* mString;
+    unsigned int mHash;
+};
+
+template<>
+struct Hash<HashedString>
+{
+    static unsigned int Get(const HashedString& key) { return key.mHash; }
+};
+
+//! Control bytes of a group of slots, matched with a single SSE2 comparison
+class HashTableGroup
+{
+public:
+    //! control byte of a slot never used
+    static const char EMPTY = -128;
+
+    //! control byte of a removed slot, so the probes continue past it
+    static const char DELETED = -2;
+
+    //! Constructor, loads the control bytes
+    //! \param ctrl the control byte of the first slot of the group
+    explicit HashTableGroup(const char* ctrl)
+    {
+#if PEGASUS_SIMD_X86
+        mCtrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+#else
+        mCtrl = ctrl;
+#endif
+    }
+
+    //! \param h2 the 7 bits of hash stored in the control byte of a used slot
+    //! \return a mask with a bit set for each slot of the group holding the hash
+    unsigned int Match(char h2) const
+    {
+#if PEGASUS_SIMD_X86
+        return static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(mCtrl, _mm_set1_epi8(h2))));
+#else
+        unsigned int mask = 0;
+        for (int i = 0; i < HASH_TABLE_GROUP_WIDTH; ++i)
+        {
+            mask |= (mCtrl[i] == h2 ? 1u : 0u) << i;
+        }
+        return mask;
+#endif
+    }
+
+    //! \return a mask with a bit set for each empty slot of the group
+    unsigned int MatchEmpty() const
+    {
+        return Match(EMPTY);
+    }
+
+    //! \return a mask with a bit set for each empty or deleted slot of the group
+    unsigned int MatchFree() const
+    {
+#if PEGASUS_SIMD_X86
+        //the free control bytes are the negative ones
+        return static_cast<unsigned int>(_mm_movemask_epi8(mCtrl));
+#else
+        unsigned int mask = 0;
+        for (int i = 0; i < HASH_TABLE_GROUP_WIDTH; ++i)
+        {
+            mask |= (mCtrl[i] < 0 ? 1u : 0u) << i;
+        }
+        return mask;
+#endif
+    }
+
+    //! \param mask a mask returned by a match, not zero
+    //! \return the index of the lowest slot of the mask
+    static unsigned int GetFirst(unsigned int mask)
+    {
+        PG_ASSERT(mask != 0);
+#if PEGASUS_COMPILER_MSVC
+        unsigned long index = 0;
+        _BitScanForward(&index, mask);
+        return static_cast<unsigned int>(index);
+#elif PEGASUS_COMPILER_GCC
+        return static_cast<unsigned int>(__builtin_ctz(mask));
+#else
+        unsigned int index = 0;
+        while ((mask & 1) == 0)
+        {
+            mask >>= 1;
+            ++index;
+        }
+        return index;
+#endif
+    }
+
+private:
+#if PEGASUS_SIMD_X86
+    __m128i mCtrl;
+#else
+    const char* mCtrl;
+#endif
+};
+
+class BaseHashTable;
+
+//! Moves the used slots of the old memory of a table to the table, after it grew
+//! \param table the table, with new memory and no keys
+//! \param oldSlots the old slots, to destroy
+//! \param oldCtrl the old control bytes
+//! \param oldCapacity the old number of slots
+typedef void (*HashTableRelocateFunc)(BaseHashTable& table, void* oldSlots, const char* oldCtrl, unsigned int oldCapacity);
+
+//! Memory and control bytes of a hash table, independent from the types of the slots.
+//! The slots are open addressed: a key goes to the first group of its probe sequence with a free slot.
+//! Each slot has a control byte, empty, deleted, or holding 7 bits of the hash of its key, so a probe
+//! compares the keys of the slots matching those bits only. The tables stay under 7/8 full.
+class BaseHashTable
+{
+public:
+    //! Constructor
+    //! \param allocator the allocator of the slots
+    //! \param category the memory category of the slots
+    //! \param flags the allocation flags of the slots
+    //! \param slotByteSize the size of a slot
+    BaseHashTable(Alloc::IAllocator* allocator, Alloc::Category category, Alloc::Flags flags, unsigned int slotByteSize);
+
+    //! Destructor. The slots must be destroyed already.
+    ~BaseHashTable();
+
+    //! \return the number of keys
+    unsigned int GetSize() const { return mSize; }
+
+    //! \return the number of slots, used or not
+    unsigned int GetCapacity() const { return mCapacity; }
+
+    //! \return the allocator
+    Alloc::IAllocator* GetAlloc() const { return mAlloc; }
+
+    //! \param slot a slot index, under the capacity
+    //! \return true if the slot holds a key
+    bool IsUsed(unsigned int slot) const { PG_ASSERT(slot < mCapacity); return mCtrl[slot] >= 0; }
+
+    //! \param slot a slot index, under the capacity
+    //! \return the memory of the slot
+    void* GetSlot(unsigned int slot) { return static_cast<char*>(mSlots) + slot * mSlotByteSize; }
+
+    //! \param slot a slot index, under the capacity
+    //! \return the memory of the slot
+    const void* GetSlot(unsigned int slot) const { return static_cast<const char*>(mSlots) + slot * mSlotByteSize; }
+
+    //! \param hash the hash of a key, from MixHash
+    //! \return the first slot of the probe sequence of the hash
+    unsigned int GetProbeStart(unsigned int hash) const { return (hash >> 7) & (mCapacity - 1); }
+
+    //! \param hash the hash of a key, from MixHash
+    //! \return the control byte of a slot holding the key
+    static char GetH2(unsigned int hash) { return static_cast<char>(hash & 0x7F); }
+
+    //! \param pos a slot of a probe sequence
+    //! \param step the number of groups probed already times the group width, updated
+    //! \return the next slot of the probe sequence. The sequence visits every group.
+    unsigned int GetProbeNext(unsigned int pos, unsigned int& step) const { step += HASH_TABLE_GROUP_WIDTH; return (pos + step) & (mCapacity - 1); }
+
+    //! \param pos a slot
+    //! \return the control bytes of the group starting at the slot
+    HashTableGroup GetGroup(unsigned int pos) const { return HashTableGroup(mCtrl + pos); }
+
+    //! \param pos the first slot of a group
+    //! \param index the index of a slot in the group
+    //! \return the slot
+    unsigned int GetGroupSlot(unsigned int pos, unsigned int index) const { return (pos + index) & (mCapacity - 1); }
+
+    //! Finds the slot a new key goes to, growing the table if it is full. The slot is marked used.
+    //! \param hash the hash of the key, from MixHash
+    //! \param relocate moves the slots if the table grows
+    //! \return the slot, to construct the key in
+    unsigned int Claim(unsigned int hash, HashTableRelocateFunc relocate);
+
+    //! Marks a used slot as removed. The slot must be destroyed already.
+    //! \param slot the slot
+    void Release(unsigned int slot);
+
+    //! Grows the table to hold a number of keys without rehashing
+    //! \param count the number of keys
+    //! \param relocate moves the slots if the table grows
+    void Reserve(unsigned int count, HashTableRelocateFunc relocate);
+
+    //! Finds a free slot for a key while relocating, marks it used and counts it
+    //! \param hash the hash of the key, from MixHash
+    //! \return the slot
+    unsigned int ClaimForRelocation(unsigned int hash);
+
+    //! Marks every slot empty. The slots must be destroyed already.
+    void Clear();
+
+    //! Frees the slots. They must be destroyed already.
+    void Reset();
+
+    //! Mixes the bits of a hash, so the probe start and the control bytes do not depend on its lowest bits only
+    //! \param hash the hash of a key
+    //! \return the mixed hash
+    static unsigned int MixHash(unsigned int hash)
+    {
+        hash ^= hash >> 16;
+        hash *= 0x85ebca6b;
+        hash ^= hash >> 13;
+        hash *= 0xc2b2ae35;
+        hash ^= hash >> 16;
+        return hash;
+    }
+
+private:
+    PG_DISABLE_COPY(BaseHashTable);
+
+    //! \param hash the hash of a key, from MixHash
+    //! \return the first free slot of the probe sequence of the hash
+    unsigned int FindFree(unsigned int hash) const;
+
+    //! Sets the control byte of a slot, and of its copy after the last slot
+    void SetCtrl(unsigned int slot, char ctrl);
+
+    //! Moves the slots to a table of a capacity
+    void Rehash(unsigned int capacity, HashTableRelocateFunc relocate);
+
+    //! Allocates the slots and the control bytes of a capacity, all empty
+    void Allocate(unsigned int capacity);
+
+    Alloc::IAllocator* mAlloc;
+    Alloc::Category mCategory;
+    Alloc::Flags mFlags;
+    unsigned int mSlotByteSize;
+
+    //! slots then control bytes, in one allocation
+    void* mSlots;
+
+    //! one control byte per slot, followed by a copy of the first group so groups can start at any slot
+    char* mCtrl;
+
+    //! number of slots, a power of two
+    unsigned int mCapacity;
+
+    //! number of keys
+    unsigned int mSize;
+
+    //! number of keys that can be added before the table grows. Deleted slots are not reused by it.
+    unsigned int mGrowthLeft;
+};
+
+//! Hash table of entries holding a key in mKey, base of HashMap and HashSet
+template<class K, class Entry>
+class HashTable
+{
+public:
+    explicit HashTable(Alloc::IAllocator* allocator, Alloc::Category category, Alloc::Flags flags)
+    : mBase(allocator, category, flags, sizeof(Entry))
+    {
+    }
+
+    ~HashTable()
+    {
+        Reset();
+    }
+
+    //! \return the number of keys
+    unsigned int GetSize() const { return mBase.GetSize(); }
+
+    //! \return the number of slots, used or not
+    unsigned int GetCapacity() const { return mBase.GetCapacity(); }
+
+    //! \param key the key
+    //! \return the entry of the key, null if there is none
+    Entry* Find(const K& key)
+    {
+        int slot = FindSlot(key, BaseHashTable::MixHash(Hash<K>::Get(key)));
+        return slot < 0 ? nullptr : GetEntry(slot);
+    }
+
+    //! \param key the key
+    //! \return the entry of the key, null if there is none
+    const Entry* Find(const K& key) const
+    {
+        int slot = FindSlot(key, BaseHashTable::MixHash(Hash<K>::Get(key)));
+        return slot < 0 ? nullptr : GetEntry(slot);
+    }
+
+    //! Finds the entry of a key, or adds a default constructed one
+    //! \param key the key
+    //! \param outAdded output, true if the entry was added
+    //! \return the entry of the key
+    Entry& FindOrAdd(const K& key, bool& outAdded)
+    {
+        const unsigned int hash = BaseHashTable::MixHash(Hash<K>::Get(key));
+        int slot = FindSlot(key, hash);
+        outAdded = slot < 0;
+        if (outAdded)
+        {
+            slot = static_cast<int>(mBase.Claim(hash, &HashTable<K, Entry>::Relocate));
+            Entry* entry = new (mBase.GetSlot(slot)) Entry();
+            entry->mKey = key;
+        }
+        return *GetEntry(slot);
+    }
+
+    //! Removes the entry of a key
+    //! \param key the key
+    //! \return true if the key was found
+    bool Remove(const K& key)
+    {
+        int slot = FindSlot(key, BaseHashTable::MixHash(Hash<K>::Get(key)));
+        if (slot < 0)
+        {
+            return false;
+        }
+        GetEntry(slot)->~Entry();
+        mBase.Release(slot);
+        return true;
+    }
+
+    //! Grows the table to hold a number of keys without rehashing
+    //! \param count the number of keys
+    void Reserve(unsigned int count)
+    {
+        mBase.Reserve(count, &HashTable<K, Entry>::Relocate);
+    }
+
+    //! Removes every entry, keeps the memory
+    void Clear()
+    {
+        DestroyEntries();
+        mBase.Clear();
+    }
+
+    //! Removes every entry and frees the memory
+    void Reset()
+    {
+        DestroyEntries();
+        mBase.Reset();
+    }
+
+    //! \param slot a slot index, under the capacity
+    //! \return the entry of the slot, null if it is not used
+    Entry* GetEntryAt(unsigned int slot) { return mBase.IsUsed(slot) ? GetEntry(slot) : nullptr; }
+
+    //! \param slot a slot index, under the capacity
+    //! \return the entry of the slot, null if it is not used
+    const Entry* GetEntryAt(unsigned int slot) const { return mBase.IsUsed(slot) ? GetEntry(slot) : nullptr; }
+
+private:
+    PG_DISABLE_COPY(HashTable);
+
+    Entry* GetEntry(unsigned int slot) { return static_cast<Entry*>(mBase.GetSlot(slot)); }
+    const Entry* GetEntry(unsigned int slot) const { return static_cast<const Entry*>(mBase.GetSlot(slot)); }
+
+    //! \return the slot of a key, -1 if there is none
+    int FindSlot(const K& key, unsigned int hash) const
+    {
+        if (mBase.GetCapacity() == 0)
+        {
+            return -1;
+        }
+        const char h2 = BaseHashTable::GetH2(hash);
+        unsigned int pos = mBase.GetProbeStart(hash);
+        unsigned int step = 0;
+        while (true)
+        {
+            const HashTableGroup group = mBase.GetGroup(pos);
+            for (unsigned int match = group.Match(h2); match != 0; match &= match - 1)
+            {
+                const unsigned int slot = mBase.GetGroupSlot(pos, HashTableGroup::GetFirst(match));
+                if (GetEntry(slot)->mKey == key)
+                {
+                    return static_cast<int>(slot);
+                }
+            }
+            //a key is always in the first group of its sequence with an empty slot, or before
+            if (group.MatchEmpty() != 0)
+            {
+                return -1;
+            }
+            pos = mBase.GetProbeNext(pos, step);
+        }
+    }
+
+    //! destroys the entries of the used slots
+    void DestroyEntries()
+    {
+        for (unsigned int slot = 0; slot < mBase.GetCapacity(); ++slot)
+        {
+            if (mBase.IsUsed(slot))
+            {
+                GetEntry(slot)->~Entry();
+            }
+        }
+    }
+
+    //! moves the entries of the old slots of a table to its new slots
+    static void Relocate(BaseHashTable& table, void* oldSlots, const char* oldCtrl, unsigned int oldCapacity)
+    {
+        Entry* entries = static_cast<Entry*>(oldSlots);
+        for (unsigned int oldSlot = 0; oldSlot < oldCapacity; ++oldSlot)
+        {
+            if (oldCtrl[oldSlot] >= 0)
+            {
+                const unsigned int hash = BaseHashTable::MixHash(Hash<K>::Get(entries[oldSlot].mKey));
+                const unsigned int slot = table.ClaimForRelocation(hash);
+                new (table.GetSlot(slot)) Entry(std::move(entries[oldSlot]));
+                entries[oldSlot].~Entry();
+            }
+        }
+    }
+
+    BaseHashTable mBase;
+};
+
+//! Entry of a HashMap
+template<class K, class V>
+struct HashMapEntry
+{
+    K mKey;
+    V mValue;
+};
+
+//! Entry of a HashSet
+template<class K>
+struct HashSetEntry
+{
+    K mKey;
+};
+
+//! Iterator over the entries of a hash table, in slot order
+template<class Table, class Entry>
+class HashTableIterator
+{
+public:
+    HashTableIterator(Table* table, unsigned int slot) : mTable(table), mSlot(slot) { SkipFree(); }
+
+    Entry& operator*() const { return *mTable->GetEntryAt(mSlot); }
+    Entry* operator->() const { return mTable->GetEntryAt(mSlot); }
+    HashTableIterator& operator++() { ++mSlot; SkipFree(); return *this; }
+    bool operator!=(const HashTableIterator& other) const { return mSlot != other.mSlot; }
+    bool operator==(const HashTableIterator& other) const { return mSlot == other.mSlot; }
+
+private:
+    void SkipFree()
+    {
+        while (mSlot < mTable->GetCapacity() && mTable->GetEntryAt(mSlot) == nullptr)
+        {
+            ++mSlot;
+        }
+    }
+
+    Table* mTable;
+    unsigned int mSlot;
+};
+
+//! Hash map of keys to values. Keys need a Hash specialization and operator==, strings use HashedString.
+//! Adding or removing keys invalidates the pointers and references to the values.
+template<class K, class V>
+class HashMap
+{
+public:
+    typedef HashMapEntry<K, V> Entry;
+    typedef HashTable<K, Entry> Table;
+    typedef HashTableIterator<Table, Entry> Iterator;
+    typedef HashTableIterator<const Table, const Entry> ConstIterator;
+
+    //! Constructor
+    //! \param allocator the allocator of the entries
+    //! \param category the memory category of the entries
+    //! \param flags the allocation flags of the entries
+    explicit HashMap(Alloc::IAllocator* allocator, Alloc::Category category = -1, Alloc::Flags flags = Alloc::PG_MEM_PERM)
+    : mTable(allocator, category, flags)
+    {
+    }
+
+    HashMap() : mTable(Memory::GetGlobalAllocator(), -1, Alloc::PG_MEM_PERM) {}
+
+    //! \return the number of keys
+    unsigned int GetSize() const { return mTable.GetSize(); }
+
+    //! \return the number of slots, used or not
+    unsigned int GetCapacity() const { return mTable.GetCapacity(); }
+
+    //! \param key the key
+    //! \return the value of the key, null if there is none
+    V* Find(const K& key)
+    {
+        Entry* entry = mTable.Find(key);
+        return entry == nullptr ? nullptr : &entry->mValue;
+    }
+
+    //! \param key the key
+    //! \return the value of the key, null if there is none
+    const V* Find(const K& key) const
+    {
+        const Entry* entry = mTable.Find(key);
+        return entry == nullptr ? nullptr : &entry->mValue;
+    }
+
+    //! \param key the key
+    //! \return true if the map holds the key
+    bool Contains(const K& key) const { return mTable.Find(key) != nullptr; }
+
+    //! Sets the value of a key, adding the key if needed
+    //! \param key the key
+    //! \param value the value
+    //! \return the value in the map
+    V& Insert(const K& key, const V& value)
+    {
+        V& v = (*this)[key];
+        v = value;
+        return v;
+    }
+
+    //! \param key the key
+    //! \return the value of the key, default constructed if the key is added
+    V& operator[](const K& key)
+    {
+        bool added = false;
+        return mTable.FindOrAdd(key, added).mValue;
+    }
+
+    //! Removes a key
+    //! \param key the key
+    //! \return true if the key was found
+    bool Remove(const K& key) { return mTable.Remove(key); }
+
+    //! Grows the map to hold a number of keys without rehashing
+    //! \param count the number of keys
+    void Reserve(unsigned int count) { mTable.Reserve(count); }
+
+    //! Removes every key, keeps the memory
+    void Clear() { mTable.Clear(); }
+
+    //! Removes every key and frees the memory
+    void Reset() { mTable.Reset(); }
+
+    Iterator begin() { return Iterator(&mTable, 0); }
+    Iterator end() { return Iterator(&mTable, mTable.GetCapacity()); }
+    ConstIterator begin() const { return ConstIterator(&mTable, 0); }
+    ConstIterator end() const { return ConstIterator(&mTable, mTable.GetCapacity()); }
+
+private:
+    PG_DISABLE_COPY(HashMap);
+
+    Table mTable;
+};
+
+//! Hash set of keys. Keys need a Hash specialization and operator==, strings use HashedString.
+template<class K>
+class HashSet
+{
+public:
+    typedef HashSetEntry<K> Entry;
+    typedef HashTable<K, Entry> Table;
+    typedef HashTableIterator<const Table, const Entry> ConstIterator;
+
+    //! Constructor
+    //! \param allocator the allocator of the keys
+    //! \param category the memory category of the keys
+    //! \param flags the allocation flags of the keys
+    explicit HashSet(Alloc::IAllocator* allocator, Alloc::Category category = -1, Alloc::Flags flags = Alloc::PG_MEM_PERM)
+    : mTable(allocator, category, flags)
+    {
+    }
+
+    HashSet() : mTable(Memory::GetGlobalAllocator(), -1, Alloc::PG_MEM_PERM) {}
+
+    //! \return the number of keys
+    unsigned int GetSize() const { return mTable.GetSize(); }
+
+    //! \return the number of slots, used or not
+    unsigned int GetCapacity() const { return mTable.GetCapacity(); }
+
+    //! \param key the key
+    //! \return true if the set holds the key
+    bool Contains(const K& key) const { return mTable.Find(key) != nullptr; }
+
+    //! Adds a key
+    //! \param key the key
+    //! \return true if the key was added, false if the set held it already
+    bool Insert(const K& key)
+    {
+        bool added = false;
+        mTable.FindOrAdd(key, added);
+        return added;
+    }
+
+    //! Removes a key
+    //! \param key the key
+    //! \return true if the key was found
+    bool Remove(const K& key) { return mTable.Remove(key); }
+
+    //! Grows the set to hold a number of keys without rehashing
+    //! \param count the number of keys
+    void Reserve(unsigned int count) { mTable.Reserve(count); }
+
+    //! Removes every key, keeps the memory
+    void Clear() { mTable.Clear(); }
+
+    //! Removes every key and frees the memory
+    void Reset() { mTable.Reset(); }
+
+    ConstIterator begin() const { return ConstIterator(&mTable, 0); }
+    ConstIterator end() const { return ConstIterator(&mTable, mTable.GetCapacity()); }
+
+private:
+    PG_DISABLE_COPY(HashSet);
+
+    Table mTable;
+};
+
+}
+}
+
+#endif
@@ -18,11 +18,16 @@ namespace Utils
 {
 
 //! Standard STD C based lite memcpy function
-//! \brief Does not support intersecting memory like the actual std function does
-//!        it also does not do memory alignment check, since recent processors handle this on
-//!        the medal.
+//! \brief Does not support intersecting memory like the actual std function does, use Memmove for that.
+//!        Copies of 16 bytes or more use the vector instructions of GetSimdLevel(), with unaligned
+//!        loads and aligned stores. Copies of several megabytes bypass the cache.
+//! \return destination
 void * Memcpy(void* destination, const void* source, unsigned count);
 
+//! Standard STD C based lite memmove function, copies in between intersecting memory
+//! \return destination
+void * Memmove(void* destination, const void* source, unsigned count);
+
 }
 }
 
@@ -0,0 +1,66 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                       Pegasus                                        */
+/*                                                                                      */
+/****************************************************************************************/
+
+//! \file   Simd.h
+//! \author agent
+//! \date   16th October 2026
+//! \brief  Detection of the SIMD instruction sets the utilities are vectorized with
+
+#ifndef PEGASUS_UTILS_SIMD_H
+#define PEGASUS_UTILS_SIMD_H
+
+//! 1 when compiling for an x86 processor, the only one with vectorized utilities
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define PEGASUS_SIMD_X86 1
+#else
+#define PEGASUS_SIMD_X86 0
+#endif
+
+//! Enables AVX2 intrinsics in a function. MSVC compiles them anywhere, the callers check GetSimdLevel()
+#if PEGASUS_COMPILER_GCC
+#define PG_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define PG_TARGET_AVX2
+#endif
+
+//! Copies and fills of this many bytes or more use non temporal stores:
+//! they would evict more of the cache than they could reuse
+#define PG_SIMD_NON_TEMPORAL_BYTESIZE (4 * 1024 * 1024)
+
+namespace Pegasus
+{
+namespace Utils
+{
+
+//! Instruction sets the utilities pick from, in increasing order
+enum SimdLevel
+{
+    SIMD_LEVEL_SCALAR, //! plain C++
+    SIMD_LEVEL_SSE2,   //! 16 byte vectors
+    SIMD_LEVEL_AVX2,   //! 32 byte vectors
+    SIMD_LEVEL_COUNT
+};
+
+//! \return the best instruction set of the processor, read with CPUID at startup
+SimdLevel GetSupportedSimdLevel();
+
+//! \return the instruction set the utilities use. It is the supported one unless forced by SetSimdLevel.
+//! \note Reads SIMD_LEVEL_SCALAR until the static initialization of the Utils library runs,
+//!       so utilities called by other static constructors are safe.
+SimdLevel GetSimdLevel();
+
+//! Forces the instruction set of the utilities, to test or benchmark each implementation
+//! \param level the instruction set, clamped to the supported one
+void SetSimdLevel(SimdLevel level);
+
+//! \param level an instruction set
+//! \return the name of the instruction set
+const char* GetSimdLevelName(SimdLevel level);
+
+}
+}
+
+#endif
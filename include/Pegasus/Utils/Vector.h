@@ -16,6 +16,9 @@
 #include "Pegasus/Core/Assertion.h"
 #include "Pegasus/Utils/TypeTraits.h"
 #include "Pegasus/Memory/MemoryManager.h"
+#include "Pegasus/Utils/Memcpy.h"
+#include <new>
+#include <utility>
 
 
 namespace Pegasus
@@ -29,7 +32,15 @@ namespace Alloc
 namespace Utils
 {
 
-//!The vector container class
+//! Moves elements between two buffers, constructing the destination elements and destroying the source ones.
+//! The buffers can overlap.
+//! \param dst the destination buffer
+//! \param src the source buffer
+//! \param count the number of elements to move
+typedef void (*RelocateFunc)(void* dst, void* src, unsigned int count);
+
+//!The vector container class. Grows geometrically, so pushing n elements copies O(n) bytes.
+//! Elements are relocated by a RelocateFunc of the typed vector, or by copying their bytes if there is none.
 class BaseVector
 {
 public:
@@ -42,6 +53,9 @@ public:
     //! \return size of elements
     unsigned int GetSize() const { return mDataSize; }
 
+    //! \return the number of elements that fit before the buffer grows
+    unsigned int GetCapacity() const { return mDataCount; }
+
     //! \return the allocator
     Alloc::IAllocator* GetAlloc() const { return mAlloc; }
 
@@ -57,15 +71,44 @@ public:
         return static_cast<void*>(static_cast<char*>(mData) + index * mElementByteSize); 
     }
 
-    //! deletes element at specified index
-    void Delete(unsigned int index);
+    //! Removes the element at specified index, shifting the elements after it. The element must be destroyed already.
+    //! \param relocate moves the elements after the index, null to copy their bytes
+    void Delete(unsigned int index, RelocateFunc relocate = nullptr);
+
+    //! Pushes an empty object and returns its pointer. The object is not constructed.
+    //! \param relocate moves the elements if the buffer grows, null to copy their bytes
+    void* PushEmpty(RelocateFunc relocate = nullptr);
+
+    //! Pushes several empty objects and returns the pointer to the first one. The objects are not constructed.
+    //! \param count the number of objects
+    //! \param relocate moves the elements if the buffer grows, null to copy their bytes
+    void* PushEmpty(unsigned int count, RelocateFunc relocate);
+
+    //! Inserts an empty object at an index, shifting the elements after it. The object is not constructed.
+    //! \param index the index of the object, up to the size of the vector
+    //! \param relocate moves the elements, null to copy their bytes
+    //! \return the object
+    void* Insert(unsigned int index, RelocateFunc relocate = nullptr);
+
+    //! Removes the last elements. They must be destroyed already.
+    //! \param count the number of elements removed
+    void Shrink(unsigned int count) { PG_ASSERT(count <= mDataSize); mDataSize -= count; }
 
-    //! Pushes an empty object and returns its pointer
-    void* PushEmpty();
+    //! Grows the buffer to hold at least a number of elements. Never shrinks it.
+    //! \param count the number of elements
+    //! \param relocate moves the elements to the new buffer, null to copy their bytes
+    void Reserve(unsigned int count, RelocateFunc relocate = nullptr);
 
-    //! Deletes all data
+    //! Shrinks the buffer to the size of the vector, frees it if the vector is empty
+    //! \param relocate moves the elements to the new buffer, null to copy their bytes
+    void ShrinkToFit(RelocateFunc relocate = nullptr);
+
+    //! Deletes all data. The elements must be destroyed already.
     void Clear();
 
+    //! Swaps the buffers and the allocators of two vectors of the same type
+    void Swap(BaseVector& other);
+
     //! \return gets the raw data pointer of this vector
     void* Data() { return mData; }
 
@@ -76,6 +119,9 @@ public:
     void SetAlloc(Alloc::IAllocator* other) { mAlloc = other; }
     
 private:
+    //! Moves the buffer to one of a capacity
+    void Reallocate(unsigned int count, RelocateFunc relocate);
+
     //! master data pointer
     void* mData;
 
@@ -92,7 +138,8 @@ private:
     Alloc::IAllocator* mAlloc;
 };
 
-//! The vector convenience template class
+//! The vector convenience template class.
+//! Plain old data is copied and relocated in bulk, other types are move constructed and destroyed one by one.
 template<class T>
 class Vector
 {
@@ -104,6 +151,9 @@ public:
 
     Vector(const Vector<T>& other) : mBase(nullptr, sizeof(T)) { *this = other; }
 
+    //! Move constructor, takes the buffer of the other vector, which is left empty
+    Vector(Vector<T>&& other) : mBase(other.mBase.GetAlloc(), sizeof(T)) { mBase.Swap(other.mBase); }
+
     //! Destructor
     ~Vector()
     {
@@ -114,6 +164,9 @@ public:
     //! Gets the size
     inline unsigned int GetSize() const { return mBase.GetSize(); }
 
+    //! \return the number of elements that fit before the vector grows
+    inline unsigned int GetCapacity() const { return mBase.GetCapacity(); }
+
     //! [] operator, just like an array
     inline T& operator[](unsigned int index) 
     {
@@ -131,28 +184,33 @@ public:
     //! creates and pushes a new element
     T& PushEmpty()
     {
-        T* v = static_cast<T*>(mBase.PushEmpty());
-        if (TypeTraits<T>::IsPOD)
-        {
-            // If the type T is plain old data, just call the standard initialization
-            new (v) T;
-        }
-        else
-        {
-#pragma warning(push)    
-#pragma warning(disable:4345)   // Behavior change: an object of POD type constructed with an initializer of the form () will be default-initialized
-                                // This is a VStudio 2005 to 2012 obsolete warning
-            // If the type T is complex and has a default constructor, call it
-            new (v) T();
-#pragma warning(pop)
-        }
+        T* v = static_cast<T*>(mBase.PushEmpty(GetRelocateFunc()));
+        Construct(v);
+        return *v;
+    }
+
+    //! constructs a new element at the end of the vector from arguments
+    //! \param args the arguments of the constructor of T
+    template<class... Args>
+    T& Emplace(Args&&... args)
+    {
+        T* v = static_cast<T*>(mBase.PushEmpty(GetRelocateFunc()));
+        new (v) T(std::forward<Args>(args)...);
+        return *v;
+    }
+
+    //! creates a new element at an index, shifting the elements after it
+    //! \param index the index of the element, up to the size of the vector
+    T& Insert(unsigned int index)
+    {
+        T* v = static_cast<T*>(mBase.Insert(index, GetRelocateFunc()));
+        Construct(v);
         return *v;
     }
 
     T Pop()
     {
-        // Use a reference to avoid creating a local copy, which then gets copied again when returned.
-        T& val = (*this)[GetSize() - 1];
+        T val(std::move((*this)[GetSize() - 1]));
         Delete(GetSize() - 1);
         return val;
     }
@@ -165,7 +223,46 @@ public:
             // Call the destructor only for complex types
             ((*this)[i]).~T();
         }
-        mBase.Delete(i);
+        mBase.Delete(i, GetRelocateFunc());
+    }
+
+    //! Grows the vector to hold a number of elements without moving them
+    //! \param count the number of elements
+    void Reserve(unsigned int count)
+    {
+        mBase.Reserve(count, GetRelocateFunc());
+    }
+
+    //! Creates or destroys elements at the end of the vector to reach a size
+    //! \param size the size of the vector
+    void Resize(unsigned int size)
+    {
+        const unsigned int oldSize = GetSize();
+        if (size > oldSize)
+        {
+            T* v = static_cast<T*>(mBase.PushEmpty(size - oldSize, GetRelocateFunc()));
+            for (unsigned int i = 0; i < size - oldSize; ++i)
+            {
+                Construct(v + i);
+            }
+        }
+        else
+        {
+            if (!TypeTraits<T>::IsPOD)
+            {
+                for (unsigned int i = size; i < oldSize; ++i)
+                {
+                    ((*this)[i]).~T();
+                }
+            }
+            mBase.Shrink(oldSize - size);
+        }
+    }
+
+    //! Releases the memory not used by the elements
+    void ShrinkToFit()
+    {
+        mBase.ShrinkToFit(GetRelocateFunc());
     }
 
     void Clear()
@@ -194,21 +291,92 @@ public:
 
     Vector<T>& operator=(const Vector<T>& other)
     {
+        if (this == &other)
+        {
+            return *this;
+        }
         Clear();
         mBase.SetAlloc(other.mBase.GetAlloc());
-        for (unsigned i = 0; i < other.GetSize(); ++i)
+        if (other.GetSize() > 0)
         {
-            PushEmpty() = other[i];
+            T* v = static_cast<T*>(mBase.PushEmpty(other.GetSize(), GetRelocateFunc()));
+            if (TypeTraits<T>::IsPOD)
+            {
+                Utils::Memcpy(v, other.Data(), other.GetSize() * sizeof(T));
+            }
+            else
+            {
+                for (unsigned int i = 0; i < other.GetSize(); ++i)
+                {
+                    new (v + i) T(other[i]);
+                }
+            }
+        }
+        return *this;
+    }
+
+    //! Move assignment, takes the buffer of the other vector, which is left empty
+    Vector<T>& operator=(Vector<T>&& other)
+    {
+        if (this != &other)
+        {
+            Clear();
+            mBase.Swap(other.mBase);
         }
         return *this;
     }
 
 private:
-    BaseVector mBase;
+    //! default constructs an element
+    static void Construct(T* v)
+    {
+        if (TypeTraits<T>::IsPOD)
+        {
+            // If the type T is plain old data, just call the standard initialization
+            new (v) T;
+        }
+        else
+        {
+#pragma warning(push)    
+#pragma warning(disable:4345)   // Behavior change: an object of POD type constructed with an initializer of the form () will be default-initialized
+                                // This is a VStudio 2005 to 2012 obsolete warning
+            // If the type T is complex and has a default constructor, call it
+            new (v) T();
+#pragma warning(pop)
+        }
+    }
 
-    
-};
+    //! move constructs the elements of a buffer into another one, and destroys the moved elements (see RelocateFunc)
+    static void Relocate(void* dst, void* src, unsigned int count)
+    {
+        T* d = static_cast<T*>(dst);
+        T* s = static_cast<T*>(src);
+        if (d < s)
+        {
+            for (unsigned int i = 0; i < count; ++i)
+            {
+                new (d + i) T(std::move(s[i]));
+                s[i].~T();
+            }
+        }
+        else
+        {
+            for (unsigned int i = count; i-- > 0;)
+            {
+                new (d + i) T(std::move(s[i]));
+                s[i].~T();
+            }
+        }
+    }
+
+    //! \return the function relocating the elements, null for plain old data, which is copied in bulk
+    static RelocateFunc GetRelocateFunc()
+    {
+        return TypeTraits<T>::IsPOD ? nullptr : &Vector<T>::Relocate;
+    }
 
+    BaseVector mBase;
+};
 
 }
 }